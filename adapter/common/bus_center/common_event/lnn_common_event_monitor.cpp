@@ -26,6 +26,11 @@
 
 static const int32_t DELAY_LEN = 1000;
 static const int32_t RETRY_MAX = 20;
+// keys and charge states published by the battery service with COMMON_EVENT_BATTERY_CHANGED
+static const char *BATTERY_KEY_CAPACITY = "soc";
+static const char *BATTERY_KEY_CHARGE_STATE = "chargeState";
+static const int32_t BATTERY_CHARGE_STATE_ENABLE = 1;
+static const int32_t BATTERY_CHARGE_STATE_FULL = 3;
 
 namespace OHOS {
 namespace EventFwk {
@@ -83,6 +88,16 @@ void CommonEventMonitor::OnReceiveEvent(const CommonEventData &data)
     if (action == CommonEventSupport::COMMON_EVENT_USER_SWITCHED) {
         LnnNotifyUserSwitchEvent(SOFTBUS_USER_SWITCHED);
     }
+
+    if (action == CommonEventSupport::COMMON_EVENT_BATTERY_CHANGED) {
+        const AAFwk::WantParams &wantParams = data.GetWant().GetParams();
+        int32_t level = wantParams.GetIntParam(BATTERY_KEY_CAPACITY, -1);
+        int32_t chargeState = wantParams.GetIntParam(BATTERY_KEY_CHARGE_STATE, -1);
+        if (level >= 0) {
+            LnnNotifyBatteryStateChangeEvent(level,
+                chargeState == BATTERY_CHARGE_STATE_ENABLE || chargeState == BATTERY_CHARGE_STATE_FULL);
+        }
+    }
 }
 
 class SubscribeEvent {
@@ -103,6 +118,7 @@ int32_t SubscribeEvent::SubscribeCommonEvent()
     matchingSkills.AddEvent(CommonEventSupport::COMMON_EVENT_SCREEN_UNLOCKED);
     matchingSkills.AddEvent(CommonEventSupport::COMMON_EVENT_USER_SWITCHED);
     matchingSkills.AddEvent(CommonEventSupport::COMMON_EVENT_DATA_SHARE_READY);
+    matchingSkills.AddEvent(CommonEventSupport::COMMON_EVENT_BATTERY_CHANGED);
     CommonEventSubscribeInfo subscriberInfo(matchingSkills);
     subscriber_ = std::make_shared<CommonEventMonitor>(subscriberInfo);
     if (!CommonEventManager::SubscribeCommonEvent(subscriber_)) {
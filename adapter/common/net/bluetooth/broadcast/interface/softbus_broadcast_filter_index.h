@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file softbus_broadcast_filter_index.h
+ * @brief Declare the compiled scan filter index used to dispatch scan results to scan managers.
+ *
+ * @since 4.1
+ * @version 1.0
+ */
+
+#ifndef SOFTBUS_BROADCAST_FILTER_INDEX_H
+#define SOFTBUS_BROADCAST_FILTER_INDEX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "softbus_broadcast_type.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+// every group owns one bit of the match result
+#define BC_FILTER_INDEX_GROUP_MAX    32
+#define BC_FILTER_INDEX_BUCKET_BITS  6
+#define BC_FILTER_INDEX_BUCKET_NUM   (1U << BC_FILTER_INDEX_BUCKET_BITS)
+#define BC_FILTER_INDEX_WORD_NUM     4
+
+/**
+ * @brief Defines one compiled filter pattern, the data and mask are packed into words and pre-masked.
+ *
+ * @since 4.1
+ * @version 1.0
+ */
+typedef struct {
+    uint32_t key; // broadcast data type and id {@link BroadcastDataType}
+    uint32_t groupMask; // groups which registered this pattern
+    uint8_t minLen; // payloads shorter than the filter never match
+    uint8_t wordNum; // words that hold at least one mask bit
+    uint64_t data[BC_FILTER_INDEX_WORD_NUM];
+    uint64_t mask[BC_FILTER_INDEX_WORD_NUM];
+} BcFilterIndexEntry;
+
+/**
+ * @brief Defines the scan filter index, entries are grouped by the bucket of their key.
+ *
+ * @since 4.1
+ * @version 1.0
+ */
+typedef struct {
+    bool isValid;
+    uint32_t entryNum;
+    BcFilterIndexEntry *entries;
+    uint16_t bucketStart[BC_FILTER_INDEX_BUCKET_NUM + 1];
+} BcScanFilterIndex;
+
+/**
+ * @brief Defines the filters registered by one group, usually one scan manager.
+ *
+ * @since 4.1
+ * @version 1.0
+ */
+typedef struct {
+    const BcScanFilter *filter;
+    uint8_t filterSize;
+} BcScanFilterGroup;
+
+/**
+ * @brief Compile the filters of all groups into the index, the previous content of the index is released.
+ *
+ * @param index Indicates the index to build.
+ * @param groups Indicates the filter groups, group i is reported as bit i of the match result.
+ * @param groupNum Indicates the number of groups, at most {@link BC_FILTER_INDEX_GROUP_MAX}.
+ *
+ * @return SOFTBUS_OK if the index is built, otherwise the index is left invalid.
+ *
+ * @since 4.1
+ * @version 1.0
+ */
+int32_t BuildBcScanFilterIndex(BcScanFilterIndex *index, const BcScanFilterGroup *groups, uint32_t groupNum);
+
+/**
+ * @brief Release the entries of the index and mark it invalid.
+ *
+ * @param index Indicates the index to release.
+ *
+ * @since 4.1
+ * @version 1.0
+ */
+void ReleaseBcScanFilterIndex(BcScanFilterIndex *index);
+
+/**
+ * @brief Match the payload against the index.
+ *
+ * @param index Indicates the index built by {@link BuildBcScanFilterIndex}.
+ * @param payload Indicates the broadcast payload of a scan result.
+ *
+ * @return Returns the mask of groups which own at least one matching filter.
+ *
+ * @since 4.1
+ * @version 1.0
+ */
+uint32_t MatchBcScanFilterIndex(const BcScanFilterIndex *index, const BroadcastPayload *payload);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* SOFTBUS_BROADCAST_FILTER_INDEX_H */
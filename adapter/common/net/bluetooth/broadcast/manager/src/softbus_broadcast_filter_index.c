@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "softbus_broadcast_filter_index.h"
+
+#include "securec.h"
+
+#include "disc_log.h"
+#include "softbus_adapter_mem.h"
+#include "softbus_error_code.h"
+
+#define FILTER_INDEX_DATA_MAX_LEN (BC_FILTER_INDEX_WORD_NUM * sizeof(uint64_t))
+#define FILTER_INDEX_KEY_TYPE_SHIFT 16
+#define FILTER_INDEX_HASH_FACTOR 2654435761U
+#define FILTER_INDEX_HASH_BITS 32
+#define FILTER_INDEX_ENTRY_MAX 0xFFFF
+#define FILTER_ENTRY_NUM_PER_FILTER 2
+
+static inline uint32_t GetFilterIndexKey(BroadcastDataType type, uint16_t id)
+{
+    return ((uint32_t)type << FILTER_INDEX_KEY_TYPE_SHIFT) | id;
+}
+
+static inline uint32_t GetFilterIndexBucket(uint32_t key)
+{
+    return (key * FILTER_INDEX_HASH_FACTOR) >> (FILTER_INDEX_HASH_BITS - BC_FILTER_INDEX_BUCKET_BITS);
+}
+
+static void PackFilterIndexWords(uint64_t *words, const uint8_t *bytes, uint32_t len)
+{
+    uint8_t buf[FILTER_INDEX_DATA_MAX_LEN] = { 0 };
+    if (bytes != NULL && len != 0) {
+        (void)memcpy_s(buf, sizeof(buf), bytes, len);
+    }
+    (void)memcpy_s(words, FILTER_INDEX_DATA_MAX_LEN, buf, sizeof(buf));
+}
+
+// A filter longer than any payload can never match, so it is left out of the index.
+static bool CompileFilterIndexEntry(BroadcastDataType type, uint16_t id, const uint8_t *data, const uint8_t *mask,
+    uint32_t len, BcFilterIndexEntry *entry)
+{
+    if (len > FILTER_INDEX_DATA_MAX_LEN) {
+        return false;
+    }
+    (void)memset_s(entry, sizeof(BcFilterIndexEntry), 0, sizeof(BcFilterIndexEntry));
+    entry->key = GetFilterIndexKey(type, id);
+    entry->minLen = (uint8_t)len;
+    if (data == NULL || mask == NULL) {
+        // nothing to compare, only the id and the payload length are checked
+        return true;
+    }
+    PackFilterIndexWords(entry->data, data, len);
+    PackFilterIndexWords(entry->mask, mask, len);
+    for (uint8_t i = 0; i < BC_FILTER_INDEX_WORD_NUM; i++) {
+        entry->data[i] &= entry->mask[i];
+        if (entry->mask[i] != 0) {
+            entry->wordNum = i + 1;
+        }
+    }
+    return true;
+}
+
+static uint32_t CompileFilterGroups(const BcScanFilterGroup *groups, uint32_t groupNum, BcFilterIndexEntry *entries)
+{
+    uint32_t entryNum = 0;
+    for (uint32_t groupId = 0; groupId < groupNum; groupId++) {
+        const BcScanFilter *filter = groups[groupId].filter;
+        for (uint8_t i = 0; filter != NULL && i < groups[groupId].filterSize; i++) {
+            BcFilterIndexEntry *entry = &entries[entryNum];
+            if (CompileFilterIndexEntry(BC_DATA_TYPE_SERVICE, filter[i].serviceUuid, filter[i].serviceData,
+                filter[i].serviceDataMask, filter[i].serviceDataLength, entry)) {
+                entry->groupMask = 1U << groupId;
+                entryNum++;
+            }
+            entry = &entries[entryNum];
+            if (CompileFilterIndexEntry(BC_DATA_TYPE_MANUFACTURER, filter[i].manufactureId, filter[i].manufactureData,
+                filter[i].manufactureDataMask, filter[i].manufactureDataLength, entry)) {
+                entry->groupMask = 1U << groupId;
+                entryNum++;
+            }
+        }
+    }
+    return entryNum;
+}
+
+static bool IsSameFilterIndexEntry(const BcFilterIndexEntry *left, const BcFilterIndexEntry *right)
+{
+    if (left->key != right->key || left->minLen != right->minLen || left->wordNum != right->wordNum) {
+        return false;
+    }
+    for (uint8_t i = 0; i < left->wordNum; i++) {
+        if (left->data[i] != right->data[i] || left->mask[i] != right->mask[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Places the entries bucket by bucket, filters shared by several groups collapse into one entry.
+static uint32_t PlaceFilterIndexEntries(BcScanFilterIndex *index, const BcFilterIndexEntry *compiled,
+    uint32_t compiledNum)
+{
+    uint32_t bucketEnd[BC_FILTER_INDEX_BUCKET_NUM] = { 0 };
+    for (uint32_t i = 0; i < compiledNum; i++) {
+        bucketEnd[GetFilterIndexBucket(compiled[i].key)]++;
+    }
+    uint32_t start = 0;
+    for (uint32_t bucket = 0; bucket < BC_FILTER_INDEX_BUCKET_NUM; bucket++) {
+        uint32_t count = bucketEnd[bucket];
+        bucketEnd[bucket] = start;
+        start += count;
+    }
+    uint32_t bucketBase[BC_FILTER_INDEX_BUCKET_NUM] = { 0 };
+    (void)memcpy_s(bucketBase, sizeof(bucketBase), bucketEnd, sizeof(bucketEnd));
+    for (uint32_t i = 0; i < compiledNum; i++) {
+        uint32_t bucket = GetFilterIndexBucket(compiled[i].key);
+        uint32_t pos = bucketBase[bucket];
+        for (; pos < bucketEnd[bucket]; pos++) {
+            if (IsSameFilterIndexEntry(&index->entries[pos], &compiled[i])) {
+                index->entries[pos].groupMask |= compiled[i].groupMask;
+                break;
+            }
+        }
+        if (pos == bucketEnd[bucket]) {
+            index->entries[pos] = compiled[i];
+            bucketEnd[bucket]++;
+        }
+    }
+    // close the gaps left by merged entries
+    uint32_t entryNum = 0;
+    for (uint32_t bucket = 0; bucket < BC_FILTER_INDEX_BUCKET_NUM; bucket++) {
+        index->bucketStart[bucket] = (uint16_t)entryNum;
+        for (uint32_t pos = bucketBase[bucket]; pos < bucketEnd[bucket]; pos++) {
+            index->entries[entryNum++] = index->entries[pos];
+        }
+    }
+    index->bucketStart[BC_FILTER_INDEX_BUCKET_NUM] = (uint16_t)entryNum;
+    return entryNum;
+}
+
+void ReleaseBcScanFilterIndex(BcScanFilterIndex *index)
+{
+    DISC_CHECK_AND_RETURN_LOGE(index != NULL, DISC_BROADCAST, "index is nullptr");
+    SoftBusFree(index->entries);
+    (void)memset_s(index, sizeof(BcScanFilterIndex), 0, sizeof(BcScanFilterIndex));
+}
+
+int32_t BuildBcScanFilterIndex(BcScanFilterIndex *index, const BcScanFilterGroup *groups, uint32_t groupNum)
+{
+    DISC_CHECK_AND_RETURN_RET_LOGE(index != NULL, SOFTBUS_INVALID_PARAM, DISC_BROADCAST, "index is nullptr");
+    ReleaseBcScanFilterIndex(index);
+    DISC_CHECK_AND_RETURN_RET_LOGE(groups != NULL && groupNum <= BC_FILTER_INDEX_GROUP_MAX, SOFTBUS_INVALID_PARAM,
+        DISC_BROADCAST, "invalid groups, groupNum=%{public}u", groupNum);
+
+    uint32_t filterNum = 0;
+    for (uint32_t groupId = 0; groupId < groupNum; groupId++) {
+        filterNum += (groups[groupId].filter == NULL) ? 0 : groups[groupId].filterSize;
+    }
+    uint32_t maxEntryNum = filterNum * FILTER_ENTRY_NUM_PER_FILTER;
+    DISC_CHECK_AND_RETURN_RET_LOGE(maxEntryNum <= FILTER_INDEX_ENTRY_MAX, SOFTBUS_INVALID_PARAM, DISC_BROADCAST,
+        "too many filters, filterNum=%{public}u", filterNum);
+    if (maxEntryNum == 0) {
+        index->isValid = true;
+        return SOFTBUS_OK;
+    }
+
+    BcFilterIndexEntry *compiled = (BcFilterIndexEntry *)SoftBusCalloc(maxEntryNum * sizeof(BcFilterIndexEntry));
+    DISC_CHECK_AND_RETURN_RET_LOGE(compiled != NULL, SOFTBUS_MALLOC_ERR, DISC_BROADCAST, "malloc compiled failed");
+    index->entries = (BcFilterIndexEntry *)SoftBusCalloc(maxEntryNum * sizeof(BcFilterIndexEntry));
+    if (index->entries == NULL) {
+        DISC_LOGE(DISC_BROADCAST, "malloc entries failed");
+        SoftBusFree(compiled);
+        return SOFTBUS_MALLOC_ERR;
+    }
+    uint32_t compiledNum = CompileFilterGroups(groups, groupNum, compiled);
+    index->entryNum = PlaceFilterIndexEntries(index, compiled, compiledNum);
+    index->isValid = true;
+    SoftBusFree(compiled);
+    DISC_LOGD(DISC_BROADCAST, "filterNum=%{public}u, entryNum=%{public}u", filterNum, index->entryNum);
+    return SOFTBUS_OK;
+}
+
+uint32_t MatchBcScanFilterIndex(const BcScanFilterIndex *index, const BroadcastPayload *payload)
+{
+    if (index == NULL || !index->isValid || payload == NULL || payload->payload == NULL) {
+        return 0;
+    }
+    uint32_t key = GetFilterIndexKey(payload->type, payload->id);
+    uint32_t bucket = GetFilterIndexBucket(key);
+    uint32_t end = index->bucketStart[bucket + 1];
+    uint32_t pos = index->bucketStart[bucket];
+    if (pos == end) {
+        return 0;
+    }
+
+    uint64_t words[BC_FILTER_INDEX_WORD_NUM];
+    uint32_t len = (payload->payloadLen > FILTER_INDEX_DATA_MAX_LEN) ? FILTER_INDEX_DATA_MAX_LEN :
+        payload->payloadLen;
+    PackFilterIndexWords(words, payload->payload, len);
+    uint32_t groupMask = 0;
+    for (; pos < end; pos++) {
+        const BcFilterIndexEntry *entry = &index->entries[pos];
+        if (entry->key != key || payload->payloadLen < entry->minLen || (groupMask | entry->groupMask) == groupMask) {
+            continue;
+        }
+        uint8_t i = 0;
+        while (i < entry->wordNum && (words[i] & entry->mask[i]) == entry->data[i]) {
+            i++;
+        }
+        if (i == entry->wordNum) {
+            groupMask |= entry->groupMask;
+        }
+    }
+    return groupMask;
+}
@@ -23,6 +23,7 @@
 #include "softbus_adapter_thread.h"
 #include "softbus_ble_gatt.h"
 #include "softbus_broadcast_adapter_interface.h"
+#include "softbus_broadcast_filter_index.h"
 #include "softbus_broadcast_manager.h"
 #include "softbus_broadcast_mgr_utils.h"
 #include "softbus_broadcast_utils.h"
@@ -105,6 +106,8 @@ static int32_t g_bcOverMaxNum = 0;
 static DiscEventExtra g_bcManagerExtra[BC_NUM_MAX] = { 0 };
 static BroadcastManager g_bcManager[BC_NUM_MAX];
 static ScanManager g_scanManager[SCAN_NUM_MAX];
+// compiled from the filters of g_scanManager, protected by g_scanLock
+static BcScanFilterIndex g_scanFilterIndex = { 0 };
 static bool g_firstSetIndex[MAX_FILTER_SIZE + 1] = {false};
 
 static AdapterScannerControl g_AdapterStatusControl[GATT_SCAN_MAX_NUM] = {
@@ -329,6 +332,7 @@ int32_t DeInitBroadcastMgr(void)
     if (CheckLockIsInit(&g_bcLock)) {
         (void)SoftBusMutexDestroy(&g_bcLock);
     }
+    ReleaseBcScanFilterIndex(&g_scanFilterIndex);
     if (CheckLockIsInit(&g_scanLock)) {
         (void)SoftBusMutexDestroy(&g_scanLock);
     }
@@ -829,36 +833,88 @@ static bool CheckScanResultDataIsMatchApproach(const uint32_t managerId, Broadca
     return false;
 }
 
-static void BcReportScanDataCallback(int32_t adapterScanId, const SoftBusBcScanResult *reportData)
+static void RebuildScanFilterIndex(void)
 {
-    DISC_LOGD(DISC_BROADCAST, "enter report scan cb");
-    DISC_CHECK_AND_RETURN_LOGE(reportData != NULL, DISC_BROADCAST, "reportData is nullptr");
+    BcScanFilterGroup groups[SCAN_NUM_MAX] = { 0 };
+    for (uint32_t managerId = 0; managerId < SCAN_NUM_MAX; managerId++) {
+        groups[managerId].filter = g_scanManager[managerId].filter;
+        groups[managerId].filterSize = g_scanManager[managerId].filterSize;
+    }
+    if (BuildBcScanFilterIndex(&g_scanFilterIndex, groups, SCAN_NUM_MAX) != SOFTBUS_OK) {
+        DISC_LOGW(DISC_BROADCAST, "build scan filter index failed, match filters one by one");
+    }
+}
 
-    BroadcastReportInfo bcInfo;
-    int32_t ret = BuildBroadcastReportInfo(reportData, &bcInfo);
-    DISC_CHECK_AND_RETURN_LOGE(ret == SOFTBUS_OK, DISC_BROADCAST, "build bc report info failed");
+static bool IsScanResultMatched(uint32_t managerId, BroadcastPacket *packet, uint32_t bcMatched,
+    uint32_t rspMatched)
+{
+    if (!g_scanFilterIndex.isValid) {
+        return CheckScanResultDataIsMatch(managerId, &(packet->bcData)) ||
+            (g_scanManager[managerId].srvType == SRV_TYPE_APPROACH &&
+            CheckScanResultDataIsMatchApproach(managerId, &(packet->rspData)));
+    }
+    uint32_t managerBit = 1U << managerId;
+    return (bcMatched & managerBit) != 0 ||
+        (g_scanManager[managerId].srvType == SRV_TYPE_APPROACH && (rspMatched & managerBit) != 0);
+}
 
-    for (uint32_t managerId = 0; managerId < SCAN_NUM_MAX; managerId++) {
-        if (SoftBusMutexLock(&g_scanLock) != 0) {
-            ReleaseBroadcastReportInfo(&bcInfo);
-            return;
+static uint32_t GetMatchedScanManagers(int32_t adapterScanId, BroadcastPacket *packet,
+    ScanCallback callbacks[SCAN_NUM_MAX])
+{
+    uint32_t bcMatched = 0;
+    uint32_t rspMatched = 0;
+    if (g_scanFilterIndex.isValid) {
+        if (packet->bcData.type != BC_DATA_TYPE_SERVICE && packet->bcData.type != BC_DATA_TYPE_MANUFACTURER) {
+            DISC_LOGE(DISC_BROADCAST, "not support type, type=%{public}d", packet->bcData.type);
+        } else {
+            bcMatched = MatchBcScanFilterIndex(&g_scanFilterIndex, &(packet->bcData));
+        }
+        if (packet->rspData.type == BC_DATA_TYPE_SERVICE) {
+            rspMatched = MatchBcScanFilterIndex(&g_scanFilterIndex, &(packet->rspData));
         }
+        if ((bcMatched | rspMatched) == 0) {
+            return 0;
+        }
+    }
+
+    uint32_t matched = 0;
+    for (uint32_t managerId = 0; managerId < SCAN_NUM_MAX; managerId++) {
         ScanManager *scanManager = &g_scanManager[managerId];
         if (!scanManager->isUsed || !scanManager->isScanning || scanManager->filter == NULL ||
             scanManager->scanCallback == NULL || scanManager->scanCallback->OnReportScanDataCallback == NULL ||
             scanManager->adapterScanId != adapterScanId ||
-            !(CheckScanResultDataIsMatch(managerId, &(bcInfo.packet.bcData)) ||
-            (scanManager->srvType == SRV_TYPE_APPROACH &&
-            CheckScanResultDataIsMatchApproach(managerId, &(bcInfo.packet.rspData))))) {
-            SoftBusMutexUnlock(&g_scanLock);
+            !IsScanResultMatched(managerId, packet, bcMatched, rspMatched)) {
             continue;
         }
-
         DISC_LOGD(DISC_BROADCAST, "srvType=%{public}s, managerId=%{public}u, adapterScanId=%{public}d",
             GetSrvType(scanManager->srvType), managerId, adapterScanId);
-        ScanCallback callback = *(scanManager->scanCallback);
-        SoftBusMutexUnlock(&g_scanLock);
-        callback.OnReportScanDataCallback((int32_t)managerId, &bcInfo);
+        callbacks[managerId] = *(scanManager->scanCallback);
+        matched |= 1U << managerId;
+    }
+    return matched;
+}
+
+static void BcReportScanDataCallback(int32_t adapterScanId, const SoftBusBcScanResult *reportData)
+{
+    DISC_LOGD(DISC_BROADCAST, "enter report scan cb");
+    DISC_CHECK_AND_RETURN_LOGE(reportData != NULL, DISC_BROADCAST, "reportData is nullptr");
+
+    BroadcastReportInfo bcInfo;
+    int32_t ret = BuildBroadcastReportInfo(reportData, &bcInfo);
+    DISC_CHECK_AND_RETURN_LOGE(ret == SOFTBUS_OK, DISC_BROADCAST, "build bc report info failed");
+
+    ScanCallback callbacks[SCAN_NUM_MAX];
+    if (SoftBusMutexLock(&g_scanLock) != SOFTBUS_OK) {
+        ReleaseBroadcastReportInfo(&bcInfo);
+        return;
+    }
+    uint32_t matched = GetMatchedScanManagers(adapterScanId, &(bcInfo.packet), callbacks);
+    SoftBusMutexUnlock(&g_scanLock);
+
+    for (uint32_t managerId = 0; managerId < SCAN_NUM_MAX; managerId++) {
+        if ((matched & (1U << managerId)) != 0) {
+            callbacks[managerId].OnReportScanDataCallback((int32_t)managerId, &bcInfo);
+        }
     }
     ReleaseBroadcastReportInfo(&bcInfo);
 }
@@ -1635,6 +1691,7 @@ int32_t UnRegisterScanListener(int32_t listenerId)
     }
     DISC_LOGD(DISC_BROADCAST, "srvType=%{public}s", GetSrvType(g_scanManager[listenerId].srvType));
     ReleaseBcScanFilter(listenerId);
+    RebuildScanFilterIndex();
     g_scanManager[listenerId].srvType = -1;
     g_scanManager[listenerId].adapterScanId = -1;
     g_scanManager[listenerId].isUsed = false;
@@ -2523,6 +2580,7 @@ int32_t SetScanFilter(int32_t listenerId, const BcScanFilter *scanFilter, uint8_
     ReleaseBcScanFilter(listenerId);
     g_scanManager[listenerId].filter = (BcScanFilter *)scanFilter;
     g_scanManager[listenerId].filterSize = filterNum;
+    RebuildScanFilterIndex();
     // Need to reset scanner when filter changed.
     g_scanManager[listenerId].isFliterChanged = true;
     DISC_LOGI(DISC_BROADCAST, "srvType=%{public}s, listenerId=%{public}d, adapterId=%{public}d",
@@ -60,6 +60,11 @@ typedef enum {
     SOFTBUS_INT_DISC_COAP_MAX_DEVICE_NUM, /* the default val is 20 */
     SOFTBUS_INT_AUTH_CAPACITY, /* the default val is 0x07 */
     SOFTBUS_INT_STATIC_NET_CAPABILITY, /* the default val is 63 */
+    SOFTBUS_INT_LANE_DETECT_EVIDENCE_TIME, /* the default val is 5000ms, 0 means always probe */
+    SOFTBUS_INT_LANE_DETECT_LIVE_LINK_TIME, /* the default val is 30000ms, 0 means lanes in use add no extra time */
+    SOFTBUS_INT_LNN_NOTIFY_BATCH_WINDOW, /* the default val is 50ms, 0 means notify every change at once */
+    SOFTBUS_BOOL_SDK_NODE_INFO_CACHE, /* cache online node info in sdk: true, always query server: false */
+    SOFTBUS_INT_DISC_FOUND_SUPPRESS_WINDOW, /* the default val is 1000ms, 0 means report every device found */
     SOFTBUS_CONFIG_TYPE_MAX,
 } ConfigType;
 
@@ -770,6 +770,12 @@ void FillpDebugSocketConfigRes(FILLP_CONST struct GlobalAppResource *resource)
     FILLP_SHOWDATABUTT("FillP EnlargePaxkInterval is (FT_CONF_ENLARGE_PACK_INTERVAL) = %u",
                        resource->common.enlargePackIntervalFlag);
 
+    FILLP_SHOWDATABUTT("FillP fec enable flag is (FT_CONF_USE_FEC) = %u",
+                       resource->common.fecEnable);
+
+    FILLP_SHOWDATABUTT("FillP fec redundancy level is (FT_CONF_FEC_REDUNDANCY_LEVEL) = %u",
+                       resource->common.fecRedundancyLevel);
+
     FILLP_SHOWDATABUTT("FillP max receive buffer size is (FT_CONF_RECV_BUFFER_SIZE) = %u",
                        resource->common.recvBufSize);
 
@@ -670,6 +670,37 @@ static FILLP_INT32 FtAppEnlargePackInterval(
     return FILLP_SUCCESS;
 }
 
+static FILLP_INT32 FtAppConfigSetUseFec(
+    IN FILLP_CONST void *value,
+    struct GlobalAppResource *resource,
+    FILLP_INT sockIndex)
+{
+    FILLP_BOOL configValue = *(FILLP_BOOL *)value;
+    if ((configValue != FILLP_TRUE) && (configValue != FILLP_FALSE)) {
+        FILLP_LOGERR("fillp_sock_id:%d fecEnable %u passed is invalid parameter!!!", sockIndex, configValue);
+        return ERR_FAILURE;
+    }
+
+    resource->common.fecEnable = configValue;
+    return FILLP_SUCCESS;
+}
+
+static FILLP_INT32 FtAppConfigSetFecRedundancyLevel(
+    IN FILLP_CONST void *value,
+    struct GlobalAppResource *resource,
+    FILLP_INT sockIndex)
+{
+    FILLP_UINT32 configValue = *(FILLP_UINT32 *)value;
+    if ((configValue <= FILLP_FEC_REDUNDANCY_LEVEL_INVLAID) || (configValue >= FILLP_FEC_REDUNDANCY_LEVEL_BUTT)) {
+        FILLP_LOGERR("fillp_sock_id:%d fecRedundancyLevel %u passed is invalid parameter!!!", sockIndex,
+            configValue);
+        return ERR_FAILURE;
+    }
+
+    resource->common.fecRedundancyLevel = (FILLP_UINT8)configValue;
+    return FILLP_SUCCESS;
+}
+
 FILLP_INT FtAppConfigInitNackDelayCfg(
     FILLP_INT sockIndex,
     struct GlobalAppResource *resource)
@@ -855,6 +886,12 @@ static FILLP_INT32 FtInnerAppConfigSetHelper(
         case FT_CONF_APP_PACK_INTERVAL:
             return FtAppConfigSetPackInterval(value, resource, sockIndex);
 
+        case FT_CONF_USE_FEC:
+            return FtAppConfigSetUseFec(value, resource, sockIndex);
+
+        case FT_CONF_FEC_REDUNDANCY_LEVEL:
+            return FtAppConfigSetFecRedundancyLevel(value, resource, sockIndex);
+
         default:
             FILLP_LOGERR("invalid name %u!!!", name);
             return ERR_FAILURE;
@@ -973,6 +1010,14 @@ static FILLP_INT32 FtInnerAppConfigGetHelper(FILLP_UINT32 name, void *value,
             *(FILLP_UINT32 *)value = resource->common.fcStasticsInterval;
             break;
 
+        case FT_CONF_USE_FEC:
+            *(FILLP_BOOL *)value = resource->common.fecEnable;
+            break;
+
+        case FT_CONF_FEC_REDUNDANCY_LEVEL:
+            *(FILLP_UINT32 *)value = resource->common.fecRedundancyLevel;
+            break;
+
         default:
             FILLP_LOGERR("invalid name %u!!!", name);
             return ERR_PARAM;
@@ -275,6 +275,11 @@ enum FillpPacketExt {
     FILLP_PKT_EXT_BUTT = 0xff
 };
 
+/* bits of FILLP_PKT_EXT_CONNECT_CARRY_CHARACTER, bit 0 and 1 are HRBB and PKT_IVAR */
+#define FILLP_CHARACTER_FEC (1u << 2) /* handles FILLP_PKT_TYPE_FEC parity packets */
+/* a peer gets fec parity only when both ends advertise it, an older peer would just drop it */
+#define FILLP_LOCAL_CHARACTERS ((FILLP_UINT32)FILLP_DEFAULT_SUPPORT_CHARACTERS | FILLP_CHARACTER_FEC)
+
 struct FillpPktConnConfirm {
     char head[FILLP_HLEN];
     FILLP_UINT16 tagCookie;    /* for align to 8 bytes */
@@ -308,6 +313,7 @@ typedef struct InnerfillpDataOption {
 #define FILLP_PKT_TYPE_CONN_CONFIRM 0XB
 #define FILLP_PKT_TYPE_CONN_CONFIRM_ACK 0XC
 #define FILLP_PKT_TYPE_HISTORY_NACK 0xD
+#define FILLP_PKT_TYPE_FEC 0x7
 
 /*
  * define fillp data option
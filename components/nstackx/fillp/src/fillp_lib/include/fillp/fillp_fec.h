@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FILLP_FEC_H
+#define FILLP_FEC_H
+
+#include "fillpinc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * XOR parity over groups of consecutive data packets. The parity packet of a group is sent as
+ * FILLP_PKT_TYPE_FEC right after the last packet of the group:
+ *   flag    - type FEC, protocol version, XOR of the data flags (option/last/first) and the packet count
+ *   dataLen - XOR of the dataLen of the group
+ *   pktNum  - pktNum of the first packet of the group, the group is [pktNum, pktNum + count)
+ *   seqNum  - XOR of the seqNum of the group
+ *   body    - XOR of the bodies (options and data) of the group, zero padded to the longest one
+ * It does not consume a pktNum, so the receiver does not count it in the loss rate. One lost packet
+ * per group is rebuilt without waiting for the retransmission. Parity is sent only when the socket enables
+ * FT_CONF_USE_FEC and the peer advertised FILLP_CHARACTER_FEC during the handshake.
+ */
+#define FILLP_FEC_GROUP_MIN 2
+#define FILLP_FEC_GROUP_MAX 16
+#define FILLP_FEC_PKT_CNT_MASK 0x1f
+#define FILLP_FEC_DATA_FLAG_MASK 0xe0
+
+#define FILLP_FEC_RECV_WINDOW 64 /* data packets kept to rebuild a lost one, covers several groups */
+#define FILLP_FEC_PENDING_PARITY_NUM 4 /* parity packets waiting for a reordered data packet */
+
+/* peer loss is smoothed in 1/FILLP_FEC_LOSS_SCALE percent */
+#define FILLP_FEC_LOSS_SCALE 100
+#define FILLP_FEC_LOSS_SMOOTH_FACTOR 8
+#define FILLP_FEC_AUTO_LOW_LOSS 50 /* 0.5% */
+#define FILLP_FEC_AUTO_MID_LOSS 200 /* 2% */
+#define FILLP_FEC_AUTO_HIGH_LOSS 500 /* 5% */
+
+struct FillpFecEncoder {
+    FILLP_CHAR *out; /* parity packet of the current group, header and body in network order */
+    FILLP_UINT32 bodySize;
+    FILLP_UINT32 basePktNum;
+    FILLP_UINT32 maxBodyLen;
+    FILLP_UINT32 lossAvg;
+    FILLP_UINT8 pktCnt;
+    FILLP_UINT8 groupSize;
+    FILLP_UINT8 level;
+    FILLP_UINT8 pad;
+    FILLP_ULLONG parityNum;
+};
+
+struct FillpFecPkt {
+    FILLP_UINT32 pktNum;
+    FILLP_UINT32 seqNum;
+    FILLP_UINT16 flag;
+    FILLP_UINT16 dataLen;
+    FILLP_UINT16 bodyLen;
+    FILLP_UINT8 pktCnt; /* only for parity */
+    FILLP_BOOL valid;
+    FILLP_CHAR *body;
+};
+
+struct FillpFecDecoder {
+    FILLP_CHAR *mem;
+    FILLP_CHAR *out; /* rebuilt data packet, header in host order as after FillpDoInput */
+    FILLP_UINT32 bodySize;
+    FILLP_UINT32 lastPktNum; /* newest pktNum in the window */
+    FILLP_BOOL lastPktNumValid;
+    FILLP_UINT32 nextParity;
+    FILLP_UINT32 periodRecovered; /* rebuilt since the last pack, taken by the pack timer */
+    FILLP_ULLONG recoveredNum;
+    struct FillpFecPkt slots[FILLP_FEC_RECV_WINDOW];
+    struct FillpFecPkt parity[FILLP_FEC_PENDING_PARITY_NUM];
+};
+
+struct FillpFecHandle {
+    struct FillpFecEncoder enc;
+    struct FillpFecDecoder dec;
+};
+
+struct FillpPktHead;
+
+void FillpFecInit(struct FillpFecHandle *h);
+void FillpFecDeinit(struct FillpFecHandle *h);
+
+FILLP_INT FillpFecEncoderInit(struct FillpFecEncoder *enc, FILLP_UINT32 bodySize);
+void FillpFecEncoderSetLevel(struct FillpFecEncoder *enc, FILLP_UINT8 level);
+void FillpFecEncoderUpdateLoss(struct FillpFecEncoder *enc, FILLP_UINT16 pktLoss);
+/* pkt is a data packet as sent, returns the length of the parity packet in enc->out once the group is full */
+FILLP_UINT32 FillpFecEncoderAdd(struct FillpFecEncoder *enc, FILLP_UINT32 pktNum,
+    FILLP_CONST FILLP_CHAR *pkt, FILLP_UINT32 pktLen);
+/* closes the group early when the sender runs out of data, the parity of a single packet is a copy of it */
+FILLP_UINT32 FillpFecEncoderFlush(struct FillpFecEncoder *enc);
+
+FILLP_INT FillpFecDecoderInit(struct FillpFecDecoder *dec, FILLP_UINT32 bodySize);
+/* head is in host order, body follows it */
+void FillpFecDecoderAddData(struct FillpFecDecoder *dec, FILLP_CONST struct FillpPktHead *head,
+    FILLP_CONST FILLP_CHAR *body, FILLP_UINT32 bodyLen);
+FILLP_INT FillpFecDecoderAddParity(struct FillpFecDecoder *dec, FILLP_CONST struct FillpPktHead *head,
+    FILLP_CONST FILLP_CHAR *body, FILLP_UINT32 bodyLen);
+/* returns the length of the packet rebuilt in dec->out, 0 when nothing more can be rebuilt */
+FILLP_UINT32 FillpFecDecoderRecover(struct FillpFecDecoder *dec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FILLP_FEC_H */
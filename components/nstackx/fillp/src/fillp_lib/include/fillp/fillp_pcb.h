@@ -20,6 +20,7 @@
 #include "timing_wheel.h"
 #include "fillp_algorithm.h"
 #include "fillp_frame.h"
+#include "fillp_fec.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -173,6 +174,7 @@ struct FillpPcb {
     FILLP_LLONG dataNullTimestamp;
 
     struct FillpFrameHandle frameHandle;
+    struct FillpFecHandle fecHandle;
 
     struct FillpTimingWheelTimerNode packTimerNode;
     struct FillpTimingWheelTimerNode FcTimerNode;
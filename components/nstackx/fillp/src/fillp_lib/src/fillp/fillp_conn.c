@@ -394,7 +394,7 @@ static FILLP_INT32 FillpDecodeConnReqAckClientPara(struct FillpPcb *pcb, FILLP_C
     FILLP_CONN_REQ_ACK_RX_LOG(FILLP_GET_SOCKET(pcb)->index, (struct FillpPktHead *)p->p, reqAck,
         (FILLP_UCHAR *)buf, p->len - len);
 
-    pcb->characters = conn->peerCharacters & (FILLP_UINT32)FILLP_DEFAULT_SUPPORT_CHARACTERS;
+    pcb->characters = conn->peerCharacters & FILLP_LOCAL_CHARACTERS;
     pcb->fcAlg = FillpConsultFcAlg(pcb->fcAlg, conn->peerFcAlgs);
 
     return FILLP_SUCCESS;
@@ -511,7 +511,7 @@ static FILLP_INT FillpInitNewPcbByNewConn(struct FtNetconn *newConn, FILLP_SIZE_
         fpcb->rtt = newConn->calcRttDuringConnect;
     }
 
-    newConn->pcb->fpcb.characters = newConn->peerCharacters & (FILLP_UINT32)FILLP_DEFAULT_SUPPORT_CHARACTERS;
+    newConn->pcb->fpcb.characters = newConn->peerCharacters & FILLP_LOCAL_CHARACTERS;
     newConn->pcb->fpcb.fcAlg = newConn->peerFcAlgs & (FILLP_UINT8)FILLP_SUPPORT_ALGS;
 
     if (FillpInitPcb(&newConn->pcb->fpcb, (FILLP_INT)maxSendCache, (FILLP_INT)maxRecvCache) != ERR_OK) {
@@ -1432,7 +1432,7 @@ static FILLP_UINT16 FillpSendConnReqAckBuild(FILLP_CONST struct FillpPcb *pcb,
     FILLP_CONST FillpCookieContent *stateCookie, FILLP_ULLONG timestamp)
 {
     FILLP_INT ret;
-    FILLP_UINT32 localCharacters = (FILLP_UINT32)FILLP_DEFAULT_SUPPORT_CHARACTERS;
+    FILLP_UINT32 localCharacters = FILLP_LOCAL_CHARACTERS;
     FILLP_UINT8 localAlg = (FILLP_UINT8)FILLP_SUPPORT_ALGS;
     FILLP_UINT16 dataLen = 0;
     struct FillpPktConnReqAck *reqAck = FILLP_NULL_PTR;
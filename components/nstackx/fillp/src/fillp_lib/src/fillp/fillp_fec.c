@@ -0,0 +1,364 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fillp_fec.h"
+#include "fillp.h"
+#include "log.h"
+#include "spunge_mem.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static void FillpFecXor(FILLP_CHAR *dst, FILLP_CONST FILLP_CHAR *src, FILLP_UINT32 len)
+{
+    FILLP_UINT32 i;
+    for (i = 0; i < len; i++) {
+        dst[i] ^= src[i];
+    }
+}
+
+void FillpFecInit(struct FillpFecHandle *h)
+{
+    if (h != FILLP_NULL_PTR) {
+        (void)memset_s(h, sizeof(struct FillpFecHandle), 0, sizeof(struct FillpFecHandle));
+    }
+}
+
+void FillpFecDeinit(struct FillpFecHandle *h)
+{
+    if (h == FILLP_NULL_PTR) {
+        return;
+    }
+    if (h->enc.out != FILLP_NULL_PTR) {
+        SpungeFree(h->enc.out, SPUNGE_ALLOC_TYPE_CALLOC);
+    }
+    if (h->dec.mem != FILLP_NULL_PTR) {
+        SpungeFree(h->dec.mem, SPUNGE_ALLOC_TYPE_CALLOC);
+    }
+    FillpFecInit(h);
+}
+
+FILLP_INT FillpFecEncoderInit(struct FillpFecEncoder *enc, FILLP_UINT32 bodySize)
+{
+    if (enc->out != FILLP_NULL_PTR) {
+        SpungeFree(enc->out, SPUNGE_ALLOC_TYPE_CALLOC);
+    }
+    (void)memset_s(enc, sizeof(struct FillpFecEncoder), 0, sizeof(struct FillpFecEncoder));
+    enc->out = (FILLP_CHAR *)SpungeAlloc(1, FILLP_HLEN + bodySize, SPUNGE_ALLOC_TYPE_CALLOC);
+    if (enc->out == FILLP_NULL_PTR) {
+        FILLP_LOGERR("alloc fec encoder failed, bodySize:%u", bodySize);
+        return ERR_NORES;
+    }
+    enc->bodySize = bodySize;
+    enc->groupSize = FILLP_FEC_GROUP_MAX;
+    return ERR_OK;
+}
+
+static FILLP_UINT8 FillpFecAutoGroupSize(FILLP_UINT32 lossAvg)
+{
+    if (lossAvg < FILLP_FEC_AUTO_LOW_LOSS) {
+        return FILLP_FEC_GROUP_MAX;
+    } else if (lossAvg < FILLP_FEC_AUTO_MID_LOSS) {
+        return FILLP_FEC_GROUP_MAX >> 1;
+    } else if (lossAvg < FILLP_FEC_AUTO_HIGH_LOSS) {
+        return FILLP_FEC_GROUP_MAX >> 2; /* 2: a quarter of the largest group */
+    }
+    return FILLP_FEC_GROUP_MIN;
+}
+
+void FillpFecEncoderSetLevel(struct FillpFecEncoder *enc, FILLP_UINT8 level)
+{
+    enc->level = level;
+    switch (level) {
+        case FILLP_FEC_REDUNDANCY_LEVEL_LOW:
+            enc->groupSize = FILLP_FEC_GROUP_MAX;
+            break;
+        case FILLP_FEC_REDUNDANCY_LEVEL_MID:
+            enc->groupSize = FILLP_FEC_GROUP_MAX >> 1;
+            break;
+        case FILLP_FEC_REDUNDANCY_LEVEL_HIGH:
+            enc->groupSize = FILLP_FEC_GROUP_MAX >> 2; /* 2: a quarter of the largest group */
+            break;
+        case FILLP_FEC_REDUNDANCY_LEVEL_REAL:
+            enc->groupSize = FILLP_FEC_GROUP_MIN;
+            break;
+        default:
+            enc->groupSize = FillpFecAutoGroupSize(enc->lossAvg);
+            break;
+    }
+}
+
+void FillpFecEncoderUpdateLoss(struct FillpFecEncoder *enc, FILLP_UINT16 pktLoss)
+{
+    FILLP_UINT32 loss = (FILLP_UINT32)pktLoss * FILLP_FEC_LOSS_SCALE;
+    enc->lossAvg = (enc->lossAvg * (FILLP_FEC_LOSS_SMOOTH_FACTOR - 1) + loss) / FILLP_FEC_LOSS_SMOOTH_FACTOR;
+    FillpFecEncoderSetLevel(enc, enc->level);
+}
+
+static FILLP_UINT32 FillpFecEncoderEmit(struct FillpFecEncoder *enc)
+{
+    struct FillpPktHead *head = (struct FillpPktHead *)(void *)enc->out;
+    FILLP_UINT16 flag = 0;
+
+    FILLP_HEADER_SET_PKT_TYPE(flag, FILLP_PKT_TYPE_FEC);
+    FILLP_HEADER_SET_PROTOCOL_VERSION(flag, FILLP_PROTOCOL_VERSION_NUMBER);
+    flag |= (FILLP_UINT16)(FILLP_NTOHS(head->flag) & FILLP_FEC_DATA_FLAG_MASK);
+    flag |= (FILLP_UINT16)(enc->pktCnt & FILLP_FEC_PKT_CNT_MASK);
+    head->flag = FILLP_HTONS(flag);
+    head->pktNum = FILLP_HTONL(enc->basePktNum);
+
+    enc->pktCnt = 0;
+    enc->parityNum++;
+    return FILLP_HLEN + enc->maxBodyLen;
+}
+
+FILLP_UINT32 FillpFecEncoderAdd(struct FillpFecEncoder *enc, FILLP_UINT32 pktNum,
+    FILLP_CONST FILLP_CHAR *pkt, FILLP_UINT32 pktLen)
+{
+    if (enc->out == FILLP_NULL_PTR || pktLen < FILLP_HLEN || pktLen > FILLP_HLEN + enc->bodySize) {
+        return 0;
+    }
+    /* pktNum is rolled back on a send failure, so a gap means packets were sent while fec was off */
+    if (enc->pktCnt != 0 && pktNum != enc->basePktNum + enc->pktCnt) {
+        enc->pktCnt = 0;
+    }
+    if (enc->pktCnt == 0) {
+        (void)memset_s(enc->out, FILLP_HLEN + enc->maxBodyLen, 0, FILLP_HLEN + enc->maxBodyLen);
+        enc->basePktNum = pktNum;
+        enc->maxBodyLen = 0;
+    }
+
+    FillpFecXor(enc->out, pkt, pktLen);
+    if (pktLen - FILLP_HLEN > enc->maxBodyLen) {
+        enc->maxBodyLen = pktLen - FILLP_HLEN;
+    }
+    enc->pktCnt++;
+    if (enc->pktCnt < enc->groupSize) {
+        return 0;
+    }
+    return FillpFecEncoderEmit(enc);
+}
+
+FILLP_UINT32 FillpFecEncoderFlush(struct FillpFecEncoder *enc)
+{
+    if (enc->out == FILLP_NULL_PTR || enc->pktCnt == 0) {
+        return 0;
+    }
+    return FillpFecEncoderEmit(enc);
+}
+
+FILLP_INT FillpFecDecoderInit(struct FillpFecDecoder *dec, FILLP_UINT32 bodySize)
+{
+    FILLP_UINT32 i;
+    FILLP_CHAR *body = FILLP_NULL_PTR;
+
+    if (dec->mem != FILLP_NULL_PTR) {
+        SpungeFree(dec->mem, SPUNGE_ALLOC_TYPE_CALLOC);
+    }
+    (void)memset_s(dec, sizeof(struct FillpFecDecoder), 0, sizeof(struct FillpFecDecoder));
+    /* one body per window slot and per pending parity, and the rebuilt packet */
+    dec->mem = (FILLP_CHAR *)SpungeAlloc(FILLP_FEC_RECV_WINDOW + FILLP_FEC_PENDING_PARITY_NUM + 1,
+        FILLP_HLEN + bodySize, SPUNGE_ALLOC_TYPE_CALLOC);
+    if (dec->mem == FILLP_NULL_PTR) {
+        FILLP_LOGERR("alloc fec decoder failed, bodySize:%u", bodySize);
+        return ERR_NORES;
+    }
+    dec->bodySize = bodySize;
+    body = dec->mem;
+    for (i = 0; i < FILLP_FEC_RECV_WINDOW; i++) {
+        dec->slots[i].body = body;
+        body += FILLP_HLEN + bodySize;
+    }
+    for (i = 0; i < FILLP_FEC_PENDING_PARITY_NUM; i++) {
+        dec->parity[i].body = body;
+        body += FILLP_HLEN + bodySize;
+    }
+    dec->out = body;
+    return ERR_OK;
+}
+
+static void FillpFecPktSet(struct FillpFecPkt *pkt, FILLP_CONST struct FillpPktHead *head,
+    FILLP_CONST FILLP_CHAR *body, FILLP_UINT32 bodyLen)
+{
+    pkt->pktNum = head->pktNum;
+    pkt->seqNum = head->seqNum;
+    pkt->flag = head->flag;
+    pkt->dataLen = head->dataLen;
+    pkt->bodyLen = (FILLP_UINT16)bodyLen;
+    if (bodyLen > 0) {
+        (void)memcpy_s(pkt->body, bodyLen, body, bodyLen);
+    }
+    pkt->valid = FILLP_TRUE;
+}
+
+void FillpFecDecoderAddData(struct FillpFecDecoder *dec, FILLP_CONST struct FillpPktHead *head,
+    FILLP_CONST FILLP_CHAR *body, FILLP_UINT32 bodyLen)
+{
+    struct FillpFecPkt *slot = FILLP_NULL_PTR;
+
+    if (dec->mem == FILLP_NULL_PTR) {
+        return;
+    }
+    slot = &dec->slots[head->pktNum % FILLP_FEC_RECV_WINDOW];
+    if (bodyLen > dec->bodySize) {
+        slot->valid = FILLP_FALSE;
+        return;
+    }
+    FillpFecPktSet(slot, head, body, bodyLen);
+    if (!dec->lastPktNumValid || FillpNumIsbigger(head->pktNum, dec->lastPktNum)) {
+        dec->lastPktNum = head->pktNum;
+        dec->lastPktNumValid = FILLP_TRUE;
+    }
+}
+
+FILLP_INT FillpFecDecoderAddParity(struct FillpFecDecoder *dec, FILLP_CONST struct FillpPktHead *head,
+    FILLP_CONST FILLP_CHAR *body, FILLP_UINT32 bodyLen)
+{
+    FILLP_UINT32 i;
+    FILLP_UINT8 pktCnt = (FILLP_UINT8)(FILLP_PKT_GET_FLAG(head->flag) & FILLP_FEC_PKT_CNT_MASK);
+    struct FillpFecPkt *parity = FILLP_NULL_PTR;
+
+    if (dec->mem == FILLP_NULL_PTR || pktCnt == 0 || pktCnt > FILLP_FEC_GROUP_MAX ||
+        bodyLen > dec->bodySize) {
+        return ERR_PARAM;
+    }
+    for (i = 0; i < FILLP_FEC_PENDING_PARITY_NUM; i++) {
+        if (!dec->parity[i].valid) {
+            parity = &dec->parity[i];
+            break;
+        }
+    }
+    if (parity == FILLP_NULL_PTR) {
+        parity = &dec->parity[dec->nextParity];
+        dec->nextParity = (dec->nextParity + 1) % FILLP_FEC_PENDING_PARITY_NUM;
+    }
+    FillpFecPktSet(parity, head, body, bodyLen);
+    parity->pktCnt = pktCnt;
+    return ERR_OK;
+}
+
+/* counts the packets of the group missing from the window and returns the last of them */
+static FILLP_UINT32 FillpFecFindMissing(FILLP_CONST struct FillpFecDecoder *dec,
+    FILLP_CONST struct FillpFecPkt *parity, FILLP_UINT32 *missingCnt)
+{
+    FILLP_UINT32 i;
+    FILLP_UINT32 missing = parity->pktNum;
+
+    *missingCnt = 0;
+    for (i = 0; i < parity->pktCnt; i++) {
+        FILLP_UINT32 pktNum = parity->pktNum + i;
+        FILLP_CONST struct FillpFecPkt *slot = &dec->slots[pktNum % FILLP_FEC_RECV_WINDOW];
+        if (!slot->valid || slot->pktNum != pktNum) {
+            missing = pktNum;
+            (*missingCnt)++;
+        }
+    }
+    return missing;
+}
+
+static FILLP_UINT32 FillpFecRebuild(struct FillpFecDecoder *dec, FILLP_CONST struct FillpFecPkt *parity,
+    FILLP_UINT32 missing)
+{
+    struct FillpPktHead *head = (struct FillpPktHead *)(void *)dec->out;
+    FILLP_CHAR *body = dec->out + FILLP_HLEN;
+    FILLP_UINT16 flag = parity->flag;
+    FILLP_UINT16 dataLen = parity->dataLen;
+    FILLP_UINT32 seqNum = parity->seqNum;
+    FILLP_UINT32 bodyLen;
+    FILLP_UINT32 i;
+
+    (void)memcpy_s(body, dec->bodySize, parity->body, parity->bodyLen);
+    for (i = 0; i < parity->pktCnt; i++) {
+        FILLP_CONST struct FillpFecPkt *slot = &dec->slots[(parity->pktNum + i) % FILLP_FEC_RECV_WINDOW];
+        if (parity->pktNum + i == missing) {
+            continue;
+        }
+        if (slot->bodyLen > parity->bodyLen) {
+            return 0;
+        }
+        flag ^= slot->flag;
+        dataLen ^= slot->dataLen;
+        seqNum ^= slot->seqNum;
+        FillpFecXor(body, slot->body, slot->bodyLen);
+    }
+
+    flag &= FILLP_FEC_DATA_FLAG_MASK;
+    bodyLen = dataLen;
+    if (FILLP_PKT_GET_DAT_WITH_OPTION(flag)) {
+        if (parity->bodyLen < FILLP_DATA_OFFSET_LEN) {
+            return 0;
+        }
+        bodyLen += (FILLP_UINT32)FILLP_NTOHS(*(FILLP_UINT16 *)(void *)body) + FILLP_DATA_OFFSET_LEN;
+    }
+    if (bodyLen > parity->bodyLen) {
+        return 0;
+    }
+
+    FILLP_HEADER_SET_PKT_TYPE(flag, FILLP_PKT_TYPE_DATA);
+    FILLP_HEADER_SET_PROTOCOL_VERSION(flag, FILLP_PROTOCOL_VERSION_NUMBER);
+    head->flag = flag;
+    head->dataLen = dataLen;
+    head->pktNum = missing;
+    head->seqNum = seqNum;
+    return bodyLen;
+}
+
+FILLP_UINT32 FillpFecDecoderRecover(struct FillpFecDecoder *dec)
+{
+    FILLP_UINT32 i;
+
+    if (dec->mem == FILLP_NULL_PTR) {
+        return 0;
+    }
+    for (i = 0; i < FILLP_FEC_PENDING_PARITY_NUM; i++) {
+        struct FillpFecPkt *parity = &dec->parity[i];
+        FILLP_UINT32 missingCnt;
+        FILLP_UINT32 missing;
+        FILLP_UINT32 bodyLen;
+
+        if (!parity->valid) {
+            continue;
+        }
+        /* the window no longer holds the whole group */
+        if (dec->lastPktNumValid && (FILLP_INT32)(dec->lastPktNum - parity->pktNum) >= FILLP_FEC_RECV_WINDOW) {
+            parity->valid = FILLP_FALSE;
+            continue;
+        }
+        missing = FillpFecFindMissing(dec, parity, &missingCnt);
+        if (missingCnt > 1) {
+            continue;
+        }
+        parity->valid = FILLP_FALSE;
+        if (missingCnt == 0) {
+            continue;
+        }
+        bodyLen = FillpFecRebuild(dec, parity, missing);
+        if (bodyLen == 0) {
+            FILLP_LOGDBG("fec parity of group %u inconsistent, drop it", parity->pktNum);
+            continue;
+        }
+        FillpFecDecoderAddData(dec, (FILLP_CONST struct FillpPktHead *)(void *)dec->out, dec->out + FILLP_HLEN,
+            bodyLen);
+        dec->periodRecovered++;
+        dec->recoveredNum++;
+        return FILLP_HLEN + bodyLen;
+    }
+    return 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -295,6 +295,59 @@ static void FillpHdlDataInput(struct FillpPcb *pcb, FILLP_CONST struct NetBuf *b
     ProcessPcbItem(pcb, buf, pcbBuf);
 }
 
+static void FillpFecRecoverInput(struct FillpPcb *pcb, FILLP_CONST struct NetBuf *buf)
+{
+    struct FillpFecDecoder *dec = &pcb->fecHandle.dec;
+    struct NetBuf rebuilt = *buf;
+    FILLP_UINT32 len = FillpFecDecoderRecover(dec);
+
+    while (len > 0) {
+        FILLP_LOGDBG("fillp_sock_id:%d rebuilt pktNum:%u from fec parity", FILLP_GET_SOCKET(pcb)->index,
+            ((struct FillpPktHead *)(void *)dec->out)->pktNum);
+        rebuilt.p = dec->out;
+        rebuilt.len = (FILLP_INT)(len - FILLP_HLEN);
+        FillpHdlDataInput(pcb, &rebuilt);
+        len = FillpFecDecoderRecover(dec);
+    }
+}
+
+static void FillpFecDataInput(struct FillpPcb *pcb, FILLP_CONST struct NetBuf *buf)
+{
+    struct FillpFecDecoder *dec = &pcb->fecHandle.dec;
+
+    FillpHdlDataInput(pcb, buf);
+    if (dec->mem == FILLP_NULL_PTR) {
+        return;
+    }
+    /* the item got a copy of the packet, the body here is still as sent */
+    FillpFecDecoderAddData(dec, (FILLP_CONST struct FillpPktHead *)(void *)buf->p, buf->p + FILLP_HLEN,
+        (FILLP_UINT32)buf->len);
+    /* a reordered data packet may complete a group whose parity came first */
+    FillpFecRecoverInput(pcb, buf);
+}
+
+static void FillpFecInput(struct FillpPcb *pcb, FILLP_CONST struct NetBuf *buf)
+{
+    struct FillpFecDecoder *dec = &pcb->fecHandle.dec;
+    int netconnState = NETCONN_GET_STATE(FILLP_GET_CONN(pcb));
+    if ((netconnState != CONN_STATE_CLOSING) && (netconnState != CONN_STATE_CONNECTED)) {
+        return;
+    }
+
+    /* only the sender decides whether to protect the stream, so start decoding on the first parity */
+    if (dec->mem == FILLP_NULL_PTR && FillpFecDecoderInit(dec, (FILLP_UINT32)pcb->pktSize) != ERR_OK) {
+        return;
+    }
+    if (FillpFecDecoderAddParity(dec, (FILLP_CONST struct FillpPktHead *)(void *)buf->p, buf->p + FILLP_HLEN,
+        (FILLP_UINT32)buf->len) != ERR_OK) {
+        FILLP_LOGDBG("fillp_sock_id:%d invalid fec parity, len:%d", FILLP_GET_SOCKET(pcb)->index, buf->len);
+        FillpDfxPktNotify(FILLP_GET_SOCKET(pcb)->index, FILLP_DFX_PKT_PARSE_FAIL, 1U);
+        return;
+    }
+    pcb->statistics.keepAlive.lastRecvTime = pcb->pcbInst->curTime;
+    FillpFecRecoverInput(pcb, buf);
+}
+
 static int FillpCheckNackPacket(FILLP_CONST struct FillpPcb *pcb, FILLP_CONST struct NetBuf *p)
 {
     /* We should check for minimum length because of optional parameter total length may be more, which can be added in
@@ -787,6 +840,7 @@ static void FillpPackInput(struct FillpPcb *pcb, FILLP_CONST struct NetBuf *p)
 
     FillpPackInputLog(pcb);
     FillpFcPackInput(pcb, pack);
+    FillpFecEncoderUpdateLoss(&pcb->fecHandle.enc, pack->pktLoss);
 }
 
 static void FillpHdlConnect(struct FillpPcb *pcb, FILLP_CONST struct NetBuf *buf, struct SpungeInstance *inst,
@@ -843,7 +897,7 @@ static void FillpDoInputPktType(struct FillpPcb *pcb, FILLP_CONST struct NetBuf
     FILLP_BOOL validPkt = FILLP_TRUE;
     switch (flag) {
         case FILLP_PKT_TYPE_DATA:
-            FillpHdlDataInput(pcb, buf);
+            FillpFecDataInput(pcb, buf);
             break;
         case FILLP_PKT_TYPE_NACK:
             FillpNackInput(pcb, buf);
@@ -915,6 +969,12 @@ void FillpDoInput(struct FillpPcb *pcb, FILLP_CONST struct NetBuf *buf, struct S
         return;
     }
 
+    /* dataLen of a parity packet is the XOR of the group, not its own length */
+    if (FILLP_PKT_GET_TYPE(head->flag) == FILLP_PKT_TYPE_FEC) {
+        FillpFecInput(pcb, buf);
+        return;
+    }
+
     if ((FILLP_INT)head->dataLen > buf->len) {
         FILLP_LOGINF("FillpDoInput: fillp_sock_id:%d protocol head incorrect. "
                      "dataLen = %u greater than buflen = %d, flag:%u, pktNum:%u, seqNum:%u",
@@ -126,7 +126,7 @@ static FILLP_INT FillpExtParaCharacterFormat(FILLP_CONST struct FtNetconn *conn,
     }
     size_t formatLen = (FILLP_UINT32)ret;
 
-    FILLP_CONST FILLP_CHAR *characterStr[] = { "HRBB", "PKT_IVAR" };
+    FILLP_CONST FILLP_CHAR *characterStr[] = { "HRBB", "PKT_IVAR", "FEC" };
     ret = FillpBitmapFormat(buf + formatLen, len - formatLen, conn->peerCharacters,
         characterStr, UTILS_ARRAY_LEN(characterStr));
     if (ret < 0) {
@@ -100,6 +100,39 @@ static FILLP_BOOL FillpIsAskMoreBuf(struct FillpSendPcb *sendPcb, struct FillpPc
     return FILLP_TRUE;
 }
 
+static void FillpFecSendParity(struct FillpPcb *pcb, FILLP_UINT32 parityLen)
+{
+    struct FillpFecEncoder *enc = &pcb->fecHandle.enc;
+    FILLP_INT sentBytes;
+
+    if (parityLen == 0) {
+        return;
+    }
+    /* parity is not paced by the flow control tokens, its overhead is bounded by the group size */
+    sentBytes = pcb->sendFunc(FILLP_GET_CONN(pcb), (void *)enc->out, (FILLP_INT)parityLen, pcb->spcb);
+    if (sentBytes <= 0) {
+        FILLP_LOGDBG("fillp_sock_id:%d send fec parity of group %u failed", FILLP_GET_SOCKET(pcb)->index,
+            enc->basePktNum);
+    }
+}
+
+static void FillpFecEncodeItem(struct FillpPcb *pcb, FILLP_CONST struct FillpPcbItem *item)
+{
+    struct FtSocket *sock = FILLP_GET_SOCKET(pcb);
+    struct FillpFecEncoder *enc = &pcb->fecHandle.enc;
+
+    if (!sock->resConf.common.fecEnable || !UTILS_FLAGS_CHECK(pcb->characters, FILLP_CHARACTER_FEC)) {
+        return;
+    }
+    if ((enc->out == FILLP_NULL_PTR || enc->bodySize < (FILLP_UINT32)item->buf.len) &&
+        FillpFecEncoderInit(enc, (FILLP_UINT32)pcb->pktSize) != ERR_OK) {
+        return;
+    }
+    FillpFecEncoderSetLevel(enc, sock->resConf.common.fecRedundancyLevel);
+    FillpFecSendParity(pcb, FillpFecEncoderAdd(enc, item->pktNum, item->buf.p,
+        (FILLP_UINT32)(item->buf.len + FILLP_HLEN)));
+}
+
 static void FillpDoneSendAllData(struct FillpSendPcb *sendPcb, struct FillpPcb *pcb,
     FILLP_UINT32 sentBytes, FILLP_UINT32 sendPktNum)
 {
@@ -122,6 +155,8 @@ static void FillpDoneSendAllData(struct FillpSendPcb *sendPcb, struct FillpPcb *
     sendPcb->flowControl.lastCycleNoEnoughData = FILLP_TRUE;
     sendPcb->flowControl.remainBytes = FILLP_NULL;
     sendPcb->flowControl.sendOneNoData = FILLP_TRUE;
+    /* do not hold the tail of a frame until the next one fills the group */
+    FillpFecSendParity(pcb, FillpFecEncoderFlush(&pcb->fecHandle.enc));
 #ifdef FILLP_SUPPORT_GSO
     if (g_gsoSupport == FILLP_TRUE && pcb->sendmsgEio == FILLP_FALSE) {
         pcb->sendmsgFunc(FILLP_NULL_PTR, FILLP_NULL_PTR, 0, pcb);
@@ -428,6 +463,7 @@ FILLP_INT FillpSendItem(struct FillpPcbItem *item, struct FillpPcb *fpcb)
         FillpEnableSendTimer(fpcb);
         return -1;
     }
+    FillpFecEncodeItem(fpcb, item);
     return FillpItemRetrans(item, fpcb, sendPcb);
 }
 
@@ -691,6 +691,7 @@ FILLP_INT FillpInitPcb(struct FillpPcb *pcb, FILLP_INT mpSendSize, FILLP_INT mpR
     pcb->adhocPackReplied = FILLP_FALSE;
 
     FillpFrameInit(&pcb->frameHandle);
+    FillpFecInit(&pcb->fecHandle);
 
     HLIST_INIT_NODE(&pcb->sendNode);
     if (FillpInitRecvpcb(pcb) != ERR_OK) {
@@ -727,6 +728,7 @@ void FillpRemovePcb(struct FillpPcb *pcb)
     FillpPcbRemoveSend(pcb);
     FillpPcbRemoveTimers(pcb);
     FillpFcDeinit(pcb);
+    FillpFecDeinit(&pcb->fecHandle);
 
     pcb->isFinAckReceived = FILLP_FALSE;
     pcb->resInited = FILLP_FALSE;
@@ -102,17 +102,22 @@ static void FillpCalRecvRate(struct FillpPcb *pcb)
 {
     struct FillpPackStastics *packStastics = &pcb->statistics.pack;
     FILLP_UINT32 recvRate;
+    /* packets rebuilt from fec parity were still lost on the link, the sender sizes its redundancy by that */
+    FILLP_UINT32 recvedOnes = packStastics->periodRecvedOnes;
+    FILLP_UINT32 fecRecovered = pcb->fecHandle.dec.periodRecovered;
+    recvedOnes = (recvedOnes > fecRecovered) ? (recvedOnes - fecRecovered) : 0;
+    pcb->fecHandle.dec.periodRecovered = 0;
 
     /* Cal Pkt loss and rate */
     FILLP_UINT32 pktData = pcb->recv.pktNum - packStastics->packPktNum;
     if (pktData == 0) {
         packStastics->periodRecvPktLoss = 0;
     } else {
-        if (pktData <= packStastics->periodRecvedOnes) {
+        if (pktData <= recvedOnes) {
             packStastics->periodRecvPktLoss = 0;
         } else {
             packStastics->periodRecvPktLoss = (FILLP_UINT16)(
-                (FILLP_ULLONG)(pktData - packStastics->periodRecvedOnes) * FILLP_RECV_PKT_LOSS_MAX / pktData);
+                (FILLP_ULLONG)(pktData - recvedOnes) * FILLP_RECV_PKT_LOSS_MAX / pktData);
         }
     }
     /*  kbps  */
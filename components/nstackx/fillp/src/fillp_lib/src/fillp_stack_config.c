@@ -458,7 +458,7 @@ FILLP_INT32 FtConfigGet(IN FILLP_UINT32 name,
     } else if (name == FT_CONF_INIT_STACK_EXT) {
         FtGetCopyPreinitConfigs((FillpGlobalPreinitExtConfigsSt *)value);
         return FILLP_SUCCESS;
-    } else if (name < FT_CONF_APP_CONFIG_BOUNDARY) {
+    } else if ((name < FT_CONF_APP_CONFIG_BOUNDARY) || (name == FT_CONF_USE_FEC)) {
         return FtGetConfigApp(name, value, param);
     } else {
         return FtGetConfigStack(name, value, param);
@@ -484,7 +484,8 @@ FILLP_INT32 FtConfigSet(IN FILLP_UINT32 name, IN FILLP_CONST void *value,
         return FtInitConfigSet((FILLP_CONST FillpGlobalConfigsSt *)value);
     } else if (name == FT_CONF_INIT_STACK_EXT) {
         return FtSetCopyPreinitConfigs((FILLP_CONST FillpGlobalPreinitExtConfigsSt *)value);
-    } else if (name < FT_CONF_APP_CONFIG_BOUNDARY) {
+    } else if ((name < FT_CONF_APP_CONFIG_BOUNDARY) || (name == FT_CONF_USE_FEC)) {
+        /* fec is enabled per stream, although its option sits among the stack ones */
         return FtSetConfigApp(name, value, param);
     } else {
         return FtSetConfigStack(name, value, param);
@@ -445,6 +445,14 @@ extern "C" {
 #define FILLP_DEFAULT_DAT_OPT_TIMESTAMP_ENABLE FILLP_FALSE
 #endif
 
+#ifndef FILLP_DEFAULT_FEC_ENABLE
+#define FILLP_DEFAULT_FEC_ENABLE FILLP_FALSE
+#endif
+
+#ifndef FILLP_DEFAULT_FEC_REDUNDANCY_LEVEL
+#define FILLP_DEFAULT_FEC_REDUNDANCY_LEVEL FILLP_FEC_REDUNDANCY_LEVEL_AUTO
+#endif
+
 #ifndef FILLP_MAXIMAL_ACK_NUM_LIMITATION
 #define FILLP_MAXIMAL_ACK_NUM_LIMITATION 0
 #endif
@@ -60,7 +60,9 @@ struct GlobalAppCommon {
     FILLP_BOOL enableNackDelay;
     FILLP_BOOL enlargePackIntervalFlag;
     FILLP_BOOL enableDateOptTimestamp;
-    FILLP_UCHAR pad[3];
+    FILLP_BOOL fecEnable;
+    FILLP_UINT8 fecRedundancyLevel;
+    FILLP_UCHAR pad[1];
     FILLP_LLONG nackDelayTimeout;
     FILLP_UINT32 fcStasticsInterval;
 };
@@ -107,9 +107,9 @@ struct GlobalAppResource g_appResource = {
         FILLP_DELAY_NACK_ENABLE,                       /* common.enableNackDelay */
         FILLP_DEFAULT_ENLARGE_PACK_INTERVAL,           /* common.enlargePackIntervalFlag */
         FILLP_DEFAULT_DAT_OPT_TIMESTAMP_ENABLE,        /* common.enableDateOptTimestamp */
+        FILLP_DEFAULT_FEC_ENABLE,                      /* common.fecEnable */
+        FILLP_DEFAULT_FEC_REDUNDANCY_LEVEL,            /* common.fecRedundancyLevel */
         {
-            0,
-            0,
             0
         },                                             /* common.pad[] */
         FILLP_DEFAULT_NACK_DELAY_TIME,                 /* common.nackDelayTimeout */
@@ -145,6 +145,8 @@ void InitGlobalAppResourceDefault(void)
     g_appResource.common.nackDelayTimeout = FILLP_DEFAULT_NACK_DELAY_TIME;
     g_appResource.common.enlargePackIntervalFlag = FILLP_DEFAULT_ENLARGE_PACK_INTERVAL;
     g_appResource.common.enableDateOptTimestamp = FILLP_DEFAULT_DAT_OPT_TIMESTAMP_ENABLE;
+    g_appResource.common.fecEnable = FILLP_DEFAULT_FEC_ENABLE;
+    g_appResource.common.fecRedundancyLevel = FILLP_DEFAULT_FEC_REDUNDANCY_LEVEL;
     g_appResource.common.fcStasticsInterval = FILLP_APP_FC_STASTICS_INTERVAL;
 
     g_appResource.flowControl.constRateEnbale = FILLP_DEFAULT_CONST_RATE_ENABLE;
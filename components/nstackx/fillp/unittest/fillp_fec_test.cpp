@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "fillp_fec.h"
+#include "fillp_os.h"
+#include "pdt_fc.h"
+#include "securec.h"
+
+using namespace testing::ext;
+
+// fillp.h does not build as C++, the header is the one declared there
+struct FillpPktHead {
+    FILLP_UINT16 flag;
+    FILLP_UINT16 dataLen;
+    FILLP_UINT32 pktNum;
+    FILLP_UINT32 seqNum;
+};
+
+namespace OHOS {
+namespace {
+constexpr uint32_t TEST_PKT_SIZE = 1300;
+constexpr uint32_t TEST_FIRST_PKT_NUM = 0xfffffff0; // groups wrap around the pktNum space
+constexpr uint32_t TEST_OPT_LEN = 8;
+constexpr uint32_t FRAME_NUM = 3000;
+constexpr uint32_t FRAME_PKT_MIN = 2;
+constexpr uint32_t FRAME_PKT_MAX = 12;
+constexpr double GOOD_LOSS = 0.005;
+constexpr double BAD_LOSS = 0.5;
+constexpr double GOOD_TO_BAD = 0.02;
+constexpr double BAD_TO_GOOD = 0.3;
+constexpr uint32_t TEST_SEED = 2025;
+
+// packet types and flags of fillp.h
+constexpr FILLP_UINT16 PKT_TYPE_DATA = 0x1;
+constexpr FILLP_UINT16 PKT_TYPE_FEC = 0x7;
+constexpr FILLP_UINT16 PKT_TYPE_SHIFT = 8;
+constexpr FILLP_UINT16 PKT_TYPE_MASK = 0x0f;
+constexpr FILLP_UINT16 DAT_WITH_OPTION = 0x80;
+constexpr FILLP_UINT16 DAT_WITH_FIRST_FLAG = 0x20;
+constexpr uint32_t DATA_OFFSET_LEN = 2;
+
+using Packet = std::vector<FILLP_CHAR>;
+
+FILLP_UINT32 CryptoRand()
+{
+    static std::mt19937 rng(TEST_SEED);
+    return rng();
+}
+
+// a data packet as FillpBuildDataPkt puts it on the wire
+Packet BuildDataPkt(uint32_t pktNum, uint32_t seqNum, uint16_t dataLen, bool withOption, std::mt19937 &rng)
+{
+    uint32_t optLen = withOption ? (TEST_OPT_LEN + DATA_OFFSET_LEN) : 0;
+    Packet pkt(FILLP_HLEN + optLen + dataLen);
+    auto *head = reinterpret_cast<struct FillpPktHead *>(pkt.data());
+    FILLP_UINT16 flag = PKT_TYPE_DATA << PKT_TYPE_SHIFT;
+    if (withOption) {
+        flag |= DAT_WITH_OPTION;
+        *reinterpret_cast<FILLP_UINT16 *>(pkt.data() + FILLP_HLEN) = FILLP_HTONS(TEST_OPT_LEN);
+    }
+    if (pktNum % 2 == 0) {
+        flag |= DAT_WITH_FIRST_FLAG;
+    }
+    head->flag = FILLP_HTONS(flag);
+    head->dataLen = FILLP_HTONS(dataLen);
+    head->pktNum = FILLP_HTONL(pktNum);
+    head->seqNum = FILLP_HTONL(seqNum);
+    for (uint32_t i = FILLP_HLEN + (withOption ? DATA_OFFSET_LEN : 0); i < pkt.size(); i++) {
+        pkt[i] = static_cast<FILLP_CHAR>(rng());
+    }
+    return pkt;
+}
+
+// what FillpDoInput leaves in the buffer: the header in host order
+Packet ToHostOrder(const Packet &pkt)
+{
+    Packet host(pkt);
+    auto *head = reinterpret_cast<struct FillpPktHead *>(host.data());
+    head->flag = FILLP_NTOHS(head->flag);
+    head->dataLen = FILLP_NTOHS(head->dataLen);
+    head->pktNum = FILLP_NTOHL(head->pktNum);
+    head->seqNum = FILLP_NTOHL(head->seqNum);
+    return host;
+}
+
+class FecLoopback {
+public:
+    explicit FecLoopback(FILLP_UINT8 level)
+    {
+        FillpFecInit(&handle_);
+        EXPECT_EQ(FillpFecEncoderInit(&handle_.enc, TEST_PKT_SIZE), ERR_OK);
+        EXPECT_EQ(FillpFecDecoderInit(&handle_.dec, TEST_PKT_SIZE), ERR_OK);
+        FillpFecEncoderSetLevel(&handle_.enc, level);
+    }
+    ~FecLoopback()
+    {
+        FillpFecDeinit(&handle_);
+    }
+
+    // returns the parity packet closing a group, empty when the group goes on
+    Packet Send(const Packet &pkt)
+    {
+        uint32_t pktNum = FILLP_NTOHL(reinterpret_cast<const struct FillpPktHead *>(pkt.data())->pktNum);
+        sent_[pktNum] = pkt;
+        FILLP_UINT32 len = FillpFecEncoderAdd(&handle_.enc, pktNum, pkt.data(), pkt.size());
+        return Packet(handle_.enc.out, handle_.enc.out + len);
+    }
+    Packet Flush()
+    {
+        FILLP_UINT32 len = FillpFecEncoderFlush(&handle_.enc);
+        return Packet(handle_.enc.out, handle_.enc.out + len);
+    }
+
+    void Receive(const Packet &wire)
+    {
+        Packet pkt = ToHostOrder(wire);
+        auto *head = reinterpret_cast<const struct FillpPktHead *>(pkt.data());
+        if (((head->flag >> PKT_TYPE_SHIFT) & PKT_TYPE_MASK) == PKT_TYPE_FEC) {
+            EXPECT_EQ(FillpFecDecoderAddParity(&handle_.dec, head, pkt.data() + FILLP_HLEN, pkt.size() - FILLP_HLEN),
+                ERR_OK);
+        } else {
+            received_.insert(head->pktNum);
+            FillpFecDecoderAddData(&handle_.dec, head, pkt.data() + FILLP_HLEN, pkt.size() - FILLP_HLEN);
+        }
+        FILLP_UINT32 len = FillpFecDecoderRecover(&handle_.dec);
+        while (len > 0) {
+            Packet rebuilt(handle_.dec.out, handle_.dec.out + len);
+            auto *rebuiltHead = reinterpret_cast<const struct FillpPktHead *>(rebuilt.data());
+            auto it = sent_.find(rebuiltHead->pktNum);
+            if (it == sent_.end() || ToHostOrder(it->second) != rebuilt) {
+                mismatched_++;
+            }
+            recovered_.insert(rebuiltHead->pktNum);
+            len = FillpFecDecoderRecover(&handle_.dec);
+        }
+    }
+
+    bool Arrived(uint32_t pktNum) const
+    {
+        return received_.count(pktNum) != 0 || recovered_.count(pktNum) != 0;
+    }
+
+    struct FillpFecHandle handle_;
+    std::map<uint32_t, Packet> sent_;
+    std::set<uint32_t> received_;
+    std::set<uint32_t> recovered_;
+    uint32_t mismatched_ = 0;
+};
+
+// two state burst loss, as seen on a busy P2P link. Only data packets move the link state and draw from
+// their own generator, so every run loses the same data packets whatever parity is sent between them.
+class GilbertElliott {
+public:
+    explicit GilbertElliott(uint32_t seed) : rng_(seed), parityRng_(seed + 1) {}
+    bool Drop(bool isParity)
+    {
+        if (isParity) {
+            return dist_(parityRng_) < (bad_ ? BAD_LOSS : GOOD_LOSS);
+        }
+        bad_ = bad_ ? (dist_(rng_) >= BAD_TO_GOOD) : (dist_(rng_) < GOOD_TO_BAD);
+        return dist_(rng_) < (bad_ ? BAD_LOSS : GOOD_LOSS);
+    }
+
+private:
+    std::mt19937 rng_;
+    std::mt19937 parityRng_;
+    std::uniform_real_distribution<double> dist_ { 0.0, 1.0 };
+    bool bad_ = false;
+};
+
+struct LossResult {
+    uint32_t completeFrames = 0;
+    uint32_t dataPkts = 0;
+    uint32_t parityPkts = 0;
+    uint32_t lostPkts = 0;
+    uint32_t recoveredPkts = 0;
+    uint32_t mismatched = 0;
+};
+
+// frames of a screen cast sent over a lossy link, a frame is on time when no packet waits for a retransmission
+LossResult RunLossInjection(bool fecEnable, FILLP_UINT8 level)
+{
+    FecLoopback loopback(level);
+    GilbertElliott link(TEST_SEED);
+    std::mt19937 rng(TEST_SEED);
+    LossResult result;
+    uint32_t pktNum = TEST_FIRST_PKT_NUM;
+    uint32_t seqNum = 0;
+    auto transmit = [&link, &loopback, &result](const Packet &pkt, bool isParity) {
+        if (pkt.empty()) {
+            return;
+        }
+        isParity ? result.parityPkts++ : result.dataPkts++;
+        if (link.Drop(isParity)) {
+            result.lostPkts += isParity ? 0 : 1;
+            return;
+        }
+        loopback.Receive(pkt);
+    };
+
+    for (uint32_t frame = 0; frame < FRAME_NUM; frame++) {
+        uint32_t pktCnt = FRAME_PKT_MIN + rng() % (FRAME_PKT_MAX - FRAME_PKT_MIN + 1);
+        uint32_t firstPktNum = pktNum;
+        for (uint32_t i = 0; i < pktCnt; i++) {
+            uint16_t dataLen = static_cast<uint16_t>(TEST_PKT_SIZE - TEST_OPT_LEN - DATA_OFFSET_LEN -
+                ((i + 1 == pktCnt) ? rng() % TEST_PKT_SIZE / 2 : 0)); // 2: the tail of a frame is shorter
+            seqNum += dataLen;
+            Packet pkt = BuildDataPkt(pktNum++, seqNum, dataLen, (i == 0), rng);
+            Packet parity = fecEnable ? loopback.Send(pkt) : Packet();
+            transmit(pkt, false);
+            transmit(parity, true);
+        }
+        // the sender runs out of data at the end of each frame
+        if (fecEnable) {
+            transmit(loopback.Flush(), true);
+        }
+        bool complete = true;
+        for (uint32_t num = firstPktNum; num != pktNum; num++) {
+            complete = complete && loopback.Arrived(num);
+        }
+        result.completeFrames += complete ? 1 : 0;
+    }
+    result.recoveredPkts = loopback.recovered_.size();
+    result.mismatched = loopback.mismatched_;
+    return result;
+}
+} // namespace
+
+class FillpFecTest : public testing::Test {
+public:
+    FillpFecTest()
+    {}
+    ~FillpFecTest()
+    {}
+    static void SetUpTestCase(void)
+    {
+        // the codec buffers come from the registered allocator
+        FillpSysLibCallbackFuncStruct adpLibSysFunc;
+        (void)memset_s(&adpLibSysFunc, sizeof(adpLibSysFunc), 0, sizeof(adpLibSysFunc));
+        adpLibSysFunc.sysLibBasicFunc.cryptoRand = CryptoRand;
+        (void)FillpApiRegLibSysFunc(&adpLibSysFunc, nullptr);
+    }
+    static void TearDownTestCase(void)
+    {}
+    void SetUp() override
+    {}
+    void TearDown() override
+    {}
+};
+
+/**
+ * @tc.name: FecRecoverOne001
+ * @tc.desc: one lost packet per group is rebuilt exactly as sent, two lost in a group are left to the
+ *           retransmission
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(FillpFecTest, FecRecoverOne001, TestSize.Level1)
+{
+    FecLoopback loopback(FILLP_FEC_REDUNDANCY_LEVEL_HIGH);
+    std::mt19937 rng(TEST_SEED);
+    uint32_t groupSize = loopback.handle_.enc.groupSize;
+    ASSERT_EQ(groupSize, FILLP_FEC_GROUP_MAX >> 2);
+
+    std::vector<Packet> parities;
+    std::vector<Packet> pkts;
+    for (uint32_t i = 0; i < groupSize * 2; i++) {
+        pkts.push_back(BuildDataPkt(TEST_FIRST_PKT_NUM + i, (i + 1) * TEST_PKT_SIZE,
+            static_cast<uint16_t>(TEST_PKT_SIZE / (i + 2)), (i % 3 == 0), rng));
+        Packet parity = loopback.Send(pkts.back());
+        if (!parity.empty()) {
+            parities.push_back(parity);
+        }
+    }
+    ASSERT_EQ(parities.size(), 2U);
+
+    // first group loses its second packet, second group loses two
+    for (uint32_t i = 0; i < groupSize * 2; i++) {
+        if (i != 1 && i != groupSize && i != groupSize + 1) {
+            loopback.Receive(pkts[i]);
+        }
+    }
+    loopback.Receive(parities[0]);
+    loopback.Receive(parities[1]);
+    EXPECT_EQ(loopback.recovered_, std::set<uint32_t>({ TEST_FIRST_PKT_NUM + 1 }));
+    EXPECT_EQ(loopback.mismatched_, 0U);
+    EXPECT_EQ(loopback.handle_.dec.periodRecovered, 1U);
+}
+
+/**
+ * @tc.name: FecReorder001
+ * @tc.desc: a parity arriving before the rest of its group waits for it, a short group is closed by a flush
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(FillpFecTest, FecReorder001, TestSize.Level1)
+{
+    FecLoopback loopback(FILLP_FEC_REDUNDANCY_LEVEL_LOW);
+    std::mt19937 rng(TEST_SEED);
+    std::vector<Packet> pkts;
+    for (uint32_t i = 0; i < FILLP_FEC_GROUP_MIN + 1; i++) {
+        pkts.push_back(BuildDataPkt(TEST_FIRST_PKT_NUM + i, (i + 1) * TEST_PKT_SIZE, TEST_PKT_SIZE / 2, false, rng));
+        EXPECT_TRUE(loopback.Send(pkts.back()).empty());
+    }
+    Packet parity = loopback.Flush();
+    ASSERT_FALSE(parity.empty());
+    EXPECT_TRUE(loopback.Flush().empty());
+
+    loopback.Receive(parity);
+    loopback.Receive(pkts[2]);
+    EXPECT_TRUE(loopback.recovered_.empty());
+    loopback.Receive(pkts[1]);
+    EXPECT_EQ(loopback.recovered_, std::set<uint32_t>({ TEST_FIRST_PKT_NUM }));
+    EXPECT_EQ(loopback.mismatched_, 0U);
+}
+
+/**
+ * @tc.name: FecAutoLevel001
+ * @tc.desc: the auto level follows the loss reported by the peer
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(FillpFecTest, FecAutoLevel001, TestSize.Level1)
+{
+    FecLoopback loopback(FILLP_FEC_REDUNDANCY_LEVEL_AUTO);
+    struct FillpFecEncoder *enc = &loopback.handle_.enc;
+    EXPECT_EQ(enc->groupSize, FILLP_FEC_GROUP_MAX);
+
+    const uint16_t highLoss = 10;
+    for (uint32_t i = 0; i < FILLP_FEC_LOSS_SMOOTH_FACTOR * 4; i++) { // 4: enough packs to converge
+        FillpFecEncoderUpdateLoss(enc, highLoss);
+    }
+    EXPECT_EQ(enc->groupSize, FILLP_FEC_GROUP_MIN);
+    for (uint32_t i = 0; i < FILLP_FEC_LOSS_SMOOTH_FACTOR * 8; i++) { // 8: the smoothed loss decays to zero
+        FillpFecEncoderUpdateLoss(enc, 0);
+    }
+    EXPECT_EQ(enc->groupSize, FILLP_FEC_GROUP_MAX);
+
+    // a fixed level ignores the reported loss
+    FillpFecEncoderSetLevel(enc, FILLP_FEC_REDUNDANCY_LEVEL_MID);
+    FillpFecEncoderUpdateLoss(enc, highLoss);
+    EXPECT_EQ(enc->groupSize, FILLP_FEC_GROUP_MAX >> 1);
+}
+
+/**
+ * @tc.name: FecLossInjection001
+ * @tc.desc: frames sent through a bursty lossy link complete without retransmission more often with fec,
+ *           a higher level rebuilds more packets for more overhead
+ * @tc.type: PERF
+ * @tc.require:
+ */
+HWTEST_F(FillpFecTest, FecLossInjection001, TestSize.Level1)
+{
+    LossResult plain = RunLossInjection(false, FILLP_FEC_REDUNDANCY_LEVEL_LOW);
+    printf("no fec: %u/%u frames on time, %u of %u packets lost\n", plain.completeFrames, FRAME_NUM,
+        plain.lostPkts, plain.dataPkts);
+
+    const FILLP_UINT8 levels[] = { FILLP_FEC_REDUNDANCY_LEVEL_LOW, FILLP_FEC_REDUNDANCY_LEVEL_MID,
+        FILLP_FEC_REDUNDANCY_LEVEL_HIGH, FILLP_FEC_REDUNDANCY_LEVEL_REAL };
+    double lastOverhead = 0;
+    uint32_t lastRecovered = 0;
+    for (FILLP_UINT8 level : levels) {
+        LossResult fec = RunLossInjection(true, level);
+        double overhead = static_cast<double>(fec.parityPkts) / fec.dataPkts;
+        printf("fec level %u: %u/%u frames on time, %u of %u lost packets rebuilt, overhead %.1f%%\n", level,
+            fec.completeFrames, FRAME_NUM, fec.recoveredPkts, fec.lostPkts, overhead * 100); // 100: percent
+        EXPECT_EQ(fec.mismatched, 0U);
+        EXPECT_EQ(fec.lostPkts, plain.lostPkts);
+        EXPECT_GT(fec.completeFrames, plain.completeFrames);
+        EXPECT_GT(fec.recoveredPkts, lastRecovered);
+        EXPECT_GT(overhead, lastOverhead);
+        lastRecovered = fec.recoveredPkts;
+        lastOverhead = overhead;
+    }
+}
+} // namespace OHOS
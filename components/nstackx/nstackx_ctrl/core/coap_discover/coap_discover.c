@@ -21,6 +21,7 @@
 
 #include "coap_app.h"
 #include "coap_client.h"
+#include "compact_payload.h"
 #include "nstackx_dfinder_log.h"
 #include "nstackx_dfinder_mgt_msg_log.h"
 #include "nstackx_util.h"
@@ -252,10 +253,30 @@ static int32_t CoapSetUri(uint8_t af, char *uri, size_t len, const char *ip, con
     return NSTACKX_EOK;
 }
 
-static int32_t CoapResponseService(CoapCtxType *ctx, const char *remoteUrl, uint8_t businessType)
+static char *PrepareServiceResponse(const CoapCtxType *ctx, uint8_t businessType, uint8_t payloadVersion,
+    size_t *dataLen)
 {
+#ifdef DFINDER_SUPPORT_COMPACT_PAYLOAD
+    if (payloadVersion >= COMPACT_PAYLOAD_VERSION) {
+        return PrepareCompactServiceDiscover(GetLocalIfaceIpStr(ctx->iface), businessType,
+            GetLocalIfaceServiceData(ctx->iface), dataLen);
+    }
+#else
+    (void)payloadVersion;
+#endif /* END OF DFINDER_SUPPORT_COMPACT_PAYLOAD */
     char *data = PrepareServiceDiscover(GetLocalIfaceAf(ctx->iface), GetLocalIfaceIpStr(ctx->iface),
         NSTACKX_FALSE, businessType, GetLocalIfaceServiceData(ctx->iface));
+    if (data != NULL) {
+        *dataLen = strlen(data) + 1;
+    }
+    return data;
+}
+
+static int32_t CoapResponseService(CoapCtxType *ctx, const char *remoteUrl, uint8_t businessType,
+    uint8_t payloadVersion)
+{
+    size_t dataLen = 0;
+    char *data = PrepareServiceResponse(ctx, businessType, payloadVersion, &dataLen);
     if (data == NULL) {
         DFINDER_LOGE(TAG, "prepare service discover data fail when send response");
         return NSTACKX_EFAILED;
@@ -264,9 +285,9 @@ static int32_t CoapResponseService(CoapCtxType *ctx, const char *remoteUrl, uint
     uint8_t coapMsgType = (ShouldAutoReplyUnicast(businessType) == NSTACKX_TRUE) ? COAP_MESSAGE_NON : COAP_MESSAGE_CON;
     // current multicast ipv6 only support NON type
     coapMsgType = GetLocalIfaceAf(ctx->iface) == AF_INET6 ? COAP_MESSAGE_NON : coapMsgType;
-    int32_t ret = CoapSendRequest(ctx, coapMsgType, remoteUrl, data, strlen(data) + 1);
+    int32_t ret = CoapSendRequest(ctx, coapMsgType, remoteUrl, data, dataLen);
 
-    cJSON_free(data);
+    free(data);
     return ret;
 }
 
@@ -313,13 +334,13 @@ static int32_t HndPostServiceDiscoverInner(const coap_pdu_t *request, char **rem
 }
 
 static void CoapResponseServiceDiscovery(const char *remoteUrl, const coap_context_t *currCtx,
-    coap_pdu_t *response, uint8_t businessType)
+    coap_pdu_t *response, const DeviceInfo *deviceInfo)
 {
     if (remoteUrl != NULL) {
-        if (ShouldAutoReplyUnicast(businessType) == NSTACKX_TRUE) {
+        if (ShouldAutoReplyUnicast(deviceInfo->businessType) == NSTACKX_TRUE) {
             CoapCtxType *ctx = CoapGetCoapCtxType(currCtx);
             if (ctx != NULL) {
-                (void)CoapResponseService(ctx, remoteUrl, businessType);
+                (void)CoapResponseService(ctx, remoteUrl, deviceInfo->businessType, deviceInfo->payloadVersion);
             } else {
                 DFINDER_LOGW(TAG, "can not get corresponding context to send coap response");
             }
@@ -374,7 +395,7 @@ static int32_t HndPostServiceDiscoverEx(coap_session_t *session, const coap_pdu_
         DFINDER_LOGD(TAG, "remote dev in mode %hhu, local dev will not reply", deviceInfo->mode);
         goto L_ERR;
     }
-    CoapResponseServiceDiscovery(remoteUrl, currCtx, response, deviceInfo->businessType);
+    CoapResponseServiceDiscovery(remoteUrl, currCtx, response, deviceInfo);
 
     ret = NSTACKX_EOK;
 L_ERR:
@@ -665,7 +686,7 @@ static int32_t CoapPostServiceDiscoverEx(CoapCtxType *ctx)
     }
 
     int ret = CoapSendRequest(ctx, COAP_MESSAGE_NON, discoverUri, data, strlen(data) + 1);
-    cJSON_free(data);
+    free(data);
     return ret;
 }
 
@@ -1360,7 +1381,8 @@ static int32_t SendDiscoveryRspEx(CoapCtxType *ctx, const NSTACKX_ResponseSettin
         return NSTACKX_EFAILED;
     }
     IncreaseSequenceNumber(NSTACKX_FALSE);
-    return CoapResponseService(ctx, remoteUrl, responseSettings->businessType);
+    // the peer is only known by its ip here, so stay with the payload every version understands
+    return CoapResponseService(ctx, remoteUrl, responseSettings->businessType, PAYLOAD_VERSION_JSON);
 }
 
 void SendDiscoveryRsp(const NSTACKX_ResponseSettings *responseSettings)
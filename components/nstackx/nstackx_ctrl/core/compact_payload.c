@@ -0,0 +1,351 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "compact_payload.h"
+#include <securec.h>
+
+#include "nstackx_dfinder_log.h"
+#include "nstackx_dfinder_mgt_msg_log.h"
+#include "nstackx_error.h"
+#include "nstackx_device.h"
+#include "nstackx_statistics.h"
+#include "nstackx_device_local.h"
+#include "nstackx_inet.h"
+
+#define TAG "nStackXCoAP"
+
+#define BYTE_BITS 8
+#define BYTE_MASK 0xFF
+#define UINT32_BYTES 4
+
+/* every field at its maximum length, the writer still checks each record against the buffer */
+#define COMPACT_PAYLOAD_MAX_LEN (COMPACT_PAYLOAD_HEADER_LEN + COMPACT_TYPE_MAX * COMPACT_PAYLOAD_TLV_HEADER_LEN + \
+    NSTACKX_MAX_DEVICE_ID_LEN + NSTACKX_MAX_DEVICE_NAME_LEN + DEVICE_HASH_LEN + NSTACKX_MAX_SERVICE_DATA_LEN + \
+    NSTACKX_MAX_EXTEND_SERVICE_DATA_LEN + NSTACKX_MAX_BUSINESS_DATA_LEN + sizeof(struct in6_addr) + \
+    UINT32_BYTES * (NSTACKX_MAX_CAPABILITY_NUM + 1) + sizeof(uint16_t) + sizeof(uint8_t) * 2)
+
+typedef struct {
+    uint8_t *buf;
+    size_t size;
+    size_t len;
+} CompactWriter;
+
+typedef struct {
+    const uint8_t *value;
+    uint16_t len;
+} CompactField;
+
+static int32_t PutRecord(CompactWriter *writer, uint8_t type, const void *value, size_t len)
+{
+    if (len > UINT16_MAX || writer->size - writer->len < COMPACT_PAYLOAD_TLV_HEADER_LEN + len) {
+        DFINDER_LOGE(TAG, "no room for record %hhu, len %zu", type, len);
+        return NSTACKX_EFAILED;
+    }
+    uint8_t *pos = writer->buf + writer->len;
+    pos[0] = type;
+    pos[1] = (uint8_t)(len >> BYTE_BITS);
+    pos[2] = (uint8_t)(len & BYTE_MASK);
+    if (len != 0 && memcpy_s(pos + COMPACT_PAYLOAD_TLV_HEADER_LEN, writer->size - writer->len -
+        COMPACT_PAYLOAD_TLV_HEADER_LEN, value, len) != EOK) {
+        return NSTACKX_EFAILED;
+    }
+    writer->len += COMPACT_PAYLOAD_TLV_HEADER_LEN + len;
+    return NSTACKX_EOK;
+}
+
+static int32_t PutString(CompactWriter *writer, uint8_t type, const char *str)
+{
+    return PutRecord(writer, type, str, strlen(str));
+}
+
+static void PackUint32(uint8_t *buf, uint32_t value)
+{
+    for (uint32_t i = 0; i < UINT32_BYTES; i++) {
+        buf[i] = (uint8_t)(value >> (BYTE_BITS * (UINT32_BYTES - 1 - i)));
+    }
+}
+
+static uint32_t UnpackUint32(const uint8_t *buf)
+{
+    uint32_t value = 0;
+    for (uint32_t i = 0; i < UINT32_BYTES; i++) {
+        value = (value << BYTE_BITS) | buf[i];
+    }
+    return value;
+}
+
+static int32_t PutUint32(CompactWriter *writer, uint8_t type, uint32_t value)
+{
+    uint8_t buf[UINT32_BYTES];
+    PackUint32(buf, value);
+    return PutRecord(writer, type, buf, sizeof(buf));
+}
+
+static int32_t PutUint16(CompactWriter *writer, uint8_t type, uint16_t value)
+{
+    uint8_t buf[sizeof(uint16_t)] = { (uint8_t)(value >> BYTE_BITS), (uint8_t)(value & BYTE_MASK) };
+    return PutRecord(writer, type, buf, sizeof(buf));
+}
+
+static int32_t PutDeviceData(CompactWriter *writer, const DeviceInfo *deviceInfo, const char *serviceData)
+{
+    const char *realServiceData = (serviceData == NULL || strlen(serviceData) == 0) ?
+        deviceInfo->serviceData : serviceData;
+    if (PutString(writer, COMPACT_TYPE_DEVICE_ID, deviceInfo->deviceId) != NSTACKX_EOK ||
+        PutString(writer, COMPACT_TYPE_DEVICE_NAME, deviceInfo->deviceName) != NSTACKX_EOK ||
+        PutUint32(writer, COMPACT_TYPE_DEVICE_TYPE, deviceInfo->deviceType) != NSTACKX_EOK ||
+        PutRecord(writer, COMPACT_TYPE_MODE, &deviceInfo->mode, sizeof(deviceInfo->mode)) != NSTACKX_EOK ||
+        PutString(writer, COMPACT_TYPE_DEVICE_HASH, deviceInfo->deviceHash) != NSTACKX_EOK ||
+        PutString(writer, COMPACT_TYPE_SERVICE_DATA, realServiceData) != NSTACKX_EOK) {
+        return NSTACKX_EFAILED;
+    }
+#ifndef DFINDER_USE_MINI_NSTACKX
+    if (PutString(writer, COMPACT_TYPE_EXTEND_SERVICE_DATA, deviceInfo->extendServiceData) != NSTACKX_EOK) {
+        return NSTACKX_EFAILED;
+    }
+#endif /* END OF DFINDER_USE_MINI_NSTACKX */
+    return NSTACKX_EOK;
+}
+
+static int32_t PutWlanIp(CompactWriter *writer, const char *localIpStr)
+{
+    union InetAddr addr;
+    uint8_t af = InetGetAfType(localIpStr, &addr);
+    if (af == AF_INET) {
+        return PutRecord(writer, COMPACT_TYPE_WLAN_IP, &addr.in, sizeof(addr.in));
+    }
+    if (af == AF_INET6) {
+        return PutRecord(writer, COMPACT_TYPE_WLAN_IP, &addr.in6, sizeof(addr.in6));
+    }
+    DFINDER_LOGW(TAG, "invalid local ip, leave it out");
+    return NSTACKX_EOK;
+}
+
+static int32_t PutCapabilityBitmap(CompactWriter *writer, const DeviceInfo *deviceInfo)
+{
+    if (deviceInfo->capabilityBitmapNum == 0 || deviceInfo->capabilityBitmapNum > NSTACKX_MAX_CAPABILITY_NUM) {
+        return NSTACKX_EOK;
+    }
+    uint8_t buf[UINT32_BYTES * NSTACKX_MAX_CAPABILITY_NUM];
+    for (uint32_t i = 0; i < deviceInfo->capabilityBitmapNum; i++) {
+        PackUint32(buf + i * UINT32_BYTES, deviceInfo->capabilityBitmap[i]);
+    }
+    return PutRecord(writer, COMPACT_TYPE_CAPABILITY_BITMAP, buf, deviceInfo->capabilityBitmapNum * UINT32_BYTES);
+}
+
+static char *PrepareCompactServiceDiscoverEx(const char *localIpStr, uint8_t businessType, const char *serviceData,
+    size_t *len)
+{
+    if (localIpStr == NULL || len == NULL) {
+        DFINDER_LOGE(TAG, "invalid params passed in");
+        return NULL;
+    }
+    CompactWriter writer = { NULL, COMPACT_PAYLOAD_MAX_LEN, COMPACT_PAYLOAD_HEADER_LEN };
+    writer.buf = (uint8_t *)malloc(writer.size);
+    if (writer.buf == NULL) {
+        DFINDER_LOGE(TAG, "malloc compact payload failed");
+        return NULL;
+    }
+    writer.buf[0] = COMPACT_PAYLOAD_MAGIC;
+    writer.buf[1] = COMPACT_PAYLOAD_VERSION;
+
+    const DeviceInfo *deviceInfo = GetLocalDeviceInfo();
+    if (PutDeviceData(&writer, deviceInfo, serviceData) != NSTACKX_EOK ||
+        PutWlanIp(&writer, localIpStr) != NSTACKX_EOK ||
+        PutCapabilityBitmap(&writer, deviceInfo) != NSTACKX_EOK ||
+        PutRecord(&writer, COMPACT_TYPE_BUSINESS_TYPE, &businessType, sizeof(businessType)) != NSTACKX_EOK ||
+        PutString(&writer, COMPACT_TYPE_BUSINESS_DATA, deviceInfo->businessData.businessDataUnicast) != NSTACKX_EOK ||
+        PutUint16(&writer, COMPACT_TYPE_SEQUENCE_NUMBER, GetSequenceNumber(NSTACKX_FALSE)) != NSTACKX_EOK) {
+        DFINDER_LOGE(TAG, "add compact data failed");
+        free(writer.buf);
+        return NULL;
+    }
+    *len = writer.len;
+    return (char *)writer.buf;
+}
+
+char *PrepareCompactServiceDiscover(const char *localIpStr, uint8_t businessType, const char *serviceData,
+    size_t *len)
+{
+    char *buf = PrepareCompactServiceDiscoverEx(localIpStr, businessType, serviceData, len);
+    if (buf == NULL) {
+        IncStatistics(STATS_PREPARE_SD_MSG_FAILED);
+    }
+    return buf;
+}
+
+/* only the implemented version is compact, any other payload takes the json path */
+bool IsCompactServiceDiscover(const uint8_t *buf, size_t size)
+{
+    return buf != NULL && size >= COMPACT_PAYLOAD_HEADER_LEN && buf[0] == COMPACT_PAYLOAD_MAGIC &&
+        buf[1] == COMPACT_PAYLOAD_VERSION;
+}
+
+/* records of unknown type come from a newer peer and are skipped, a later duplicate wins */
+static int32_t SplitCompactFields(const uint8_t *buf, size_t size, CompactField *fields)
+{
+    size_t offset = COMPACT_PAYLOAD_HEADER_LEN;
+    while (offset < size) {
+        if (size - offset < COMPACT_PAYLOAD_TLV_HEADER_LEN) {
+            DFINDER_LOGE(TAG, "truncated record header at %zu", offset);
+            return NSTACKX_EINVAL;
+        }
+        uint8_t type = buf[offset];
+        uint16_t len = (uint16_t)(((uint16_t)buf[offset + 1] << BYTE_BITS) | buf[offset + 2]);
+        offset += COMPACT_PAYLOAD_TLV_HEADER_LEN;
+        if (size - offset < len) {
+            DFINDER_LOGE(TAG, "truncated record %hhu, len %hu", type, len);
+            return NSTACKX_EINVAL;
+        }
+        if (type < COMPACT_TYPE_MAX) {
+            fields[type].value = buf + offset;
+            fields[type].len = len;
+        }
+        offset += len;
+    }
+    return NSTACKX_EOK;
+}
+
+static int32_t GetString(const CompactField *field, char *str, size_t size)
+{
+    if (field->value == NULL || field->len >= size) {
+        return NSTACKX_EINVAL;
+    }
+    if (field->len != 0 && memcpy_s(str, size, field->value, field->len) != EOK) {
+        return NSTACKX_EFAILED;
+    }
+    str[field->len] = '\0';
+    return NSTACKX_EOK;
+}
+
+static int32_t ParseCompactDeviceData(const CompactField *fields, DeviceInfo *dev)
+{
+    if (GetString(&fields[COMPACT_TYPE_DEVICE_ID], dev->deviceId, sizeof(dev->deviceId)) != NSTACKX_EOK ||
+        strlen(dev->deviceId) == 0) {
+        DFINDER_LOGE(TAG, "Cannot find device ID or invalid device ID");
+        return NSTACKX_EINVAL;
+    }
+    if (GetString(&fields[COMPACT_TYPE_DEVICE_NAME], dev->deviceName, sizeof(dev->deviceName)) != NSTACKX_EOK ||
+        strlen(dev->deviceName) == 0) {
+        DFINDER_LOGE(TAG, "Cannot find device name or invalid device name");
+        return NSTACKX_EINVAL;
+    }
+    const CompactField *field = &fields[COMPACT_TYPE_DEVICE_TYPE];
+    if (field->value == NULL || field->len != UINT32_BYTES) {
+        DFINDER_LOGE(TAG, "Cannot find device type or invalid device type");
+        return NSTACKX_EINVAL;
+    }
+    dev->deviceType = UnpackUint32(field->value);
+    return NSTACKX_EOK;
+}
+
+static void ParseCompactWifiApData(const CompactField *field, DeviceInfo *dev)
+{
+    if (field->value == NULL) {
+        return;
+    }
+    if (field->len == sizeof(struct in_addr)) {
+        (void)memcpy_s(&dev->netChannelInfo.wifiApInfo.addr.in, sizeof(struct in_addr), field->value, field->len);
+        dev->netChannelInfo.wifiApInfo.af = AF_INET;
+    } else if (field->len == sizeof(struct in6_addr)) {
+        (void)memcpy_s(&dev->netChannelInfo.wifiApInfo.addr.in6, sizeof(struct in6_addr), field->value, field->len);
+        dev->netChannelInfo.wifiApInfo.af = AF_INET6;
+    } else {
+        DFINDER_LOGW(TAG, "Invalid ip address");
+        return;
+    }
+    dev->netChannelInfo.wifiApInfo.state = NET_CHANNEL_STATE_CONNETED;
+}
+
+static void ParseCompactCapabilityBitmap(const CompactField *field, DeviceInfo *dev)
+{
+    uint32_t capabilityBitmapNum = 0;
+    if (field->value != NULL) {
+        for (uint32_t offset = 0; offset + UINT32_BYTES <= field->len; offset += UINT32_BYTES) {
+            if (capabilityBitmapNum >= NSTACKX_MAX_CAPABILITY_NUM) {
+                break;
+            }
+            dev->capabilityBitmap[capabilityBitmapNum++] = UnpackUint32(field->value + offset);
+        }
+    }
+    dev->capabilityBitmapNum = capabilityBitmapNum;
+}
+
+static void ParseCompactOptionalData(const CompactField *fields, DeviceInfo *dev)
+{
+    if (fields[COMPACT_TYPE_MODE].value != NULL && fields[COMPACT_TYPE_MODE].len == sizeof(uint8_t)) {
+        dev->mode = fields[COMPACT_TYPE_MODE].value[0];
+    }
+    if (GetString(&fields[COMPACT_TYPE_DEVICE_HASH], dev->deviceHash, sizeof(dev->deviceHash)) != NSTACKX_EOK) {
+        DFINDER_LOGD(TAG, "Cannot find device hash or invalid hash");
+    }
+    if (GetString(&fields[COMPACT_TYPE_SERVICE_DATA], dev->serviceData, sizeof(dev->serviceData)) != NSTACKX_EOK) {
+        DFINDER_LOGE(TAG, "Cannot find serviceData");
+    }
+#ifndef DFINDER_USE_MINI_NSTACKX
+    if (GetString(&fields[COMPACT_TYPE_EXTEND_SERVICE_DATA], dev->extendServiceData,
+        sizeof(dev->extendServiceData)) != NSTACKX_EOK) {
+        DFINDER_LOGD(TAG, "Cannot find extendServiceData");
+    }
+#endif /* END OF DFINDER_USE_MINI_NSTACKX */
+    dev->businessType = NSTACKX_BUSINESS_TYPE_NULL;
+    if (fields[COMPACT_TYPE_BUSINESS_TYPE].value != NULL && fields[COMPACT_TYPE_BUSINESS_TYPE].len == sizeof(uint8_t)) {
+        dev->businessType = fields[COMPACT_TYPE_BUSINESS_TYPE].value[0];
+    }
+    if (GetString(&fields[COMPACT_TYPE_BUSINESS_DATA], dev->businessData.businessDataUnicast,
+        sizeof(dev->businessData.businessDataUnicast)) != NSTACKX_EOK) {
+        DFINDER_LOGD(TAG, "Cannot find businessData");
+    }
+    const CompactField *field = &fields[COMPACT_TYPE_SEQUENCE_NUMBER];
+    if (field->value != NULL && field->len == sizeof(uint16_t)) {
+        dev->seq.seqUcast = (uint16_t)(((uint16_t)field->value[0] << BYTE_BITS) | field->value[1]);
+    }
+}
+
+static int32_t ParseCompactServiceDiscoverEx(const uint8_t *buf, size_t size, DeviceInfo *deviceInfo,
+    char **remoteUrlPtr)
+{
+    if (deviceInfo == NULL || remoteUrlPtr == NULL || !IsCompactServiceDiscover(buf, size)) {
+        DFINDER_LOGE(TAG, "invalid params passed in");
+        return NSTACKX_EINVAL;
+    }
+
+    CompactField fields[COMPACT_TYPE_MAX];
+    (void)memset_s(fields, sizeof(fields), 0, sizeof(fields));
+    if (SplitCompactFields(buf, size, fields) != NSTACKX_EOK ||
+        ParseCompactDeviceData(fields, deviceInfo) != NSTACKX_EOK) {
+        return NSTACKX_EINVAL;
+    }
+    ParseCompactWifiApData(&fields[COMPACT_TYPE_WLAN_IP], deviceInfo);
+    ParseCompactCapabilityBitmap(&fields[COMPACT_TYPE_CAPABILITY_BITMAP], deviceInfo);
+    ParseCompactOptionalData(fields, deviceInfo);
+    /* compact payloads are only sent as unicast replies */
+    deviceInfo->businessData.isBroadcast = NSTACKX_FALSE;
+    deviceInfo->seq.dealBcast = NSTACKX_FALSE;
+    deviceInfo->payloadVersion = buf[1];
+    *remoteUrlPtr = NULL;
+    DFINDER_MGT_UNPACK_LOG(deviceInfo);
+    return NSTACKX_EOK;
+}
+
+int32_t ParseCompactServiceDiscover(const uint8_t *buf, size_t size, struct DeviceInfo *deviceInfo,
+    char **remoteUrlPtr)
+{
+    int32_t ret = ParseCompactServiceDiscoverEx(buf, size, deviceInfo, remoteUrlPtr);
+    if (ret != NSTACKX_EOK) {
+        IncStatistics(STATS_PARSE_SD_MSG_FAILED);
+    }
+    return ret;
+}
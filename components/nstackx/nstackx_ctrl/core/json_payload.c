@@ -17,6 +17,7 @@
 #include <securec.h>
 
 #include "cJSON.h"
+#include "compact_payload.h"
 #ifndef DFINDER_USE_MINI_NSTACKX
 #include "coap_client.h"
 #endif /* END OF DFINDER_USE_MINI_NSTACKX */
@@ -30,6 +31,32 @@
 
 #define TAG "nStackXCoAP"
 
+#ifdef DFINDER_USE_MINI_NSTACKX
+#define SERVICE_DISCOVER_CACHE_NUM 1
+#else
+#define SERVICE_DISCOVER_CACHE_NUM 8 /* broadcast and unicast payload of a few local ifaces */
+#endif
+#define SEQUENCE_NUMBER_FIELD_MAX_LEN 32
+
+/*
+ * Everything but the sequence number only depends on the local info, the body is kept
+ * without its closing brace so the sequence number can be appended to it for every message.
+ * Only accessed from the main loop.
+ */
+typedef struct {
+    char *body;
+    size_t bodyLen;
+    uint32_t version;
+    uint8_t af;
+    uint8_t isBroadcast;
+    uint8_t businessType;
+    char localIpStr[NSTACKX_MAX_IP_STRING_LEN];
+    char serviceData[NSTACKX_MAX_SERVICE_DATA_LEN];
+} ServiceDiscoverCache;
+
+static ServiceDiscoverCache g_serviceDiscoverCache[SERVICE_DISCOVER_CACHE_NUM];
+static uint32_t g_serviceDiscoverCacheNext;
+
 static const int DEVICE_TYPE_DEFAULT = 0;
 
 static int32_t AddDeviceType(cJSON *data, const DeviceInfo *deviceInfo)
@@ -174,16 +201,19 @@ static int32_t AddBusinessJsonData(cJSON *data, const DeviceInfo *deviceInfo, ui
     return NSTACKX_EOK;
 }
 
-static int32_t AddSequenceNumber(cJSON *data, uint8_t sendBcast)
+#ifdef DFINDER_SUPPORT_COMPACT_PAYLOAD
+static int32_t AddPayloadVersion(cJSON *data)
 {
-    cJSON *item = cJSON_CreateNumber(GetSequenceNumber(sendBcast));
-    if (item == NULL || !cJSON_AddItemToObject(data, JSON_SEQUENCE_NUMBER, item)) {
+    cJSON *item = cJSON_CreateNumber(COMPACT_PAYLOAD_VERSION);
+    if (item == NULL || !cJSON_AddItemToObject(data, JSON_PAYLOAD_VERSION, item)) {
         cJSON_Delete(item);
-        DFINDER_LOGE(TAG, "cJSON_CreateNumber for sequence number failed");
+        DFINDER_LOGE(TAG, "cJSON_CreateNumber for payload version failed");
         return NSTACKX_EFAILED;
     }
+
     return NSTACKX_EOK;
 }
+#endif /* END OF DFINDER_SUPPORT_COMPACT_PAYLOAD */
 
 static int32_t ParseDeviceJsonData(const cJSON *data, DeviceInfo *dev)
 {
@@ -415,6 +445,21 @@ static void ParseSequenceNumber(const cJSON *data, DeviceInfo *dev, uint8_t isBr
     }
 }
 
+static void ParsePayloadVersion(const cJSON *data, DeviceInfo *dev)
+{
+    cJSON *item = cJSON_GetObjectItemCaseSensitive(data, JSON_PAYLOAD_VERSION);
+    if (item == NULL) {
+        dev->payloadVersion = PAYLOAD_VERSION_JSON;
+        return;
+    }
+    if (!cJSON_IsNumber(item) || (item->valuedouble < 0) || (item->valuedouble > UINT8_MAX)) {
+        DFINDER_LOGE(TAG, "invalid payload version");
+        dev->payloadVersion = PAYLOAD_VERSION_JSON;
+        return;
+    }
+    dev->payloadVersion = (uint8_t)item->valuedouble;
+}
+
 static int JsonAddStr(cJSON *data, const char *key, const char *value)
 {
     cJSON *item = cJSON_CreateString(value);
@@ -426,8 +471,8 @@ static int JsonAddStr(cJSON *data, const char *key, const char *value)
     return NSTACKX_EOK;
 }
 
-static char *PrepareServiceDiscoverEx(uint8_t af, const char *locaIpStr, uint8_t isBroadcast, uint8_t businessType,
-    const char *serviceData)
+static char *PrepareServiceDiscoverBody(uint8_t af, const char *locaIpStr, uint8_t isBroadcast,
+    uint8_t businessType, const char *serviceData)
 {
     cJSON *data = cJSON_CreateObject();
     if (data == NULL) {
@@ -440,8 +485,7 @@ static char *PrepareServiceDiscoverEx(uint8_t af, const char *locaIpStr, uint8_t
     if ((AddDeviceJsonData(data, deviceInfo, serviceData) != NSTACKX_EOK) ||
         (JsonAddStr(data, JSON_DEVICE_WLAN_IP, locaIpStr) != NSTACKX_EOK) ||
         (AddCapabilityBitmap(data, deviceInfo) != NSTACKX_EOK) ||
-        (AddBusinessJsonData(data, deviceInfo, isBroadcast, businessType) != NSTACKX_EOK) ||
-        (AddSequenceNumber(data, isBroadcast) != NSTACKX_EOK)) {
+        (AddBusinessJsonData(data, deviceInfo, isBroadcast, businessType) != NSTACKX_EOK)) {
         DFINDER_LOGE(TAG, "Add json data failed");
         goto L_END_JSON;
     }
@@ -465,6 +509,12 @@ static char *PrepareServiceDiscoverEx(uint8_t af, const char *locaIpStr, uint8_t
             DFINDER_LOGE(TAG, "cJSON_CreateString return null or cJSON_AddItemToObject failed");
             goto L_END_JSON;
         }
+#ifdef DFINDER_SUPPORT_COMPACT_PAYLOAD
+        /* tell the receivers they may reply with the compact payload */
+        if (AddPayloadVersion(data) != NSTACKX_EOK) {
+            goto L_END_JSON;
+        }
+#endif /* END OF DFINDER_SUPPORT_COMPACT_PAYLOAD */
     }
 
     formatString = cJSON_PrintUnformatted(data);
@@ -477,6 +527,91 @@ L_END_JSON:
     return formatString;
 }
 
+static bool IsServiceDiscoverCacheMatch(const ServiceDiscoverCache *cache, uint32_t version, uint8_t af,
+    const char *localIpStr, uint8_t isBroadcast, uint8_t businessType, const char *serviceData)
+{
+    return cache->body != NULL && cache->version == version && cache->af == af &&
+        cache->isBroadcast == isBroadcast && cache->businessType == businessType &&
+        strcmp(cache->localIpStr, localIpStr) == 0 && strcmp(cache->serviceData, serviceData) == 0;
+}
+
+static void ClearServiceDiscoverCache(ServiceDiscoverCache *cache)
+{
+    cJSON_free(cache->body);
+    (void)memset_s(cache, sizeof(ServiceDiscoverCache), 0, sizeof(ServiceDiscoverCache));
+}
+
+static const ServiceDiscoverCache *GetServiceDiscoverCache(uint8_t af, const char *localIpStr, uint8_t isBroadcast,
+    uint8_t businessType, const char *serviceData)
+{
+    uint32_t version = GetLocalDeviceInfoVersion();
+    for (uint32_t i = 0; i < SERVICE_DISCOVER_CACHE_NUM; i++) {
+        if (IsServiceDiscoverCacheMatch(&g_serviceDiscoverCache[i], version, af, localIpStr, isBroadcast,
+            businessType, serviceData)) {
+            return &g_serviceDiscoverCache[i];
+        }
+    }
+
+    ServiceDiscoverCache *cache = &g_serviceDiscoverCache[g_serviceDiscoverCacheNext];
+    g_serviceDiscoverCacheNext = (g_serviceDiscoverCacheNext + 1) % SERVICE_DISCOVER_CACHE_NUM;
+    ClearServiceDiscoverCache(cache);
+    if (strcpy_s(cache->localIpStr, sizeof(cache->localIpStr), localIpStr) != EOK ||
+        strcpy_s(cache->serviceData, sizeof(cache->serviceData), serviceData) != EOK) {
+        DFINDER_LOGE(TAG, "copy service discover cache key failed");
+        return NULL;
+    }
+    char *body = PrepareServiceDiscoverBody(af, localIpStr, isBroadcast, businessType, serviceData);
+    if (body == NULL) {
+        return NULL;
+    }
+    size_t bodyLen = strlen(body);
+    if (bodyLen == 0 || body[bodyLen - 1] != '}') {
+        DFINDER_LOGE(TAG, "unexpected service discover body");
+        cJSON_free(body);
+        return NULL;
+    }
+    body[bodyLen - 1] = '\0';
+    cache->body = body;
+    cache->bodyLen = bodyLen - 1;
+    cache->version = version;
+    cache->af = af;
+    cache->isBroadcast = isBroadcast;
+    cache->businessType = businessType;
+    return cache;
+}
+
+static char *PrepareServiceDiscoverEx(uint8_t af, const char *localIpStr, uint8_t isBroadcast, uint8_t businessType,
+    const char *serviceData)
+{
+    const ServiceDiscoverCache *cache = GetServiceDiscoverCache(af, localIpStr, isBroadcast, businessType,
+        (serviceData == NULL) ? "" : serviceData);
+    if (cache == NULL) {
+        return NULL;
+    }
+
+    size_t len = cache->bodyLen + SEQUENCE_NUMBER_FIELD_MAX_LEN;
+    char *str = (char *)malloc(len);
+    if (str == NULL) {
+        DFINDER_LOGE(TAG, "malloc service discover payload failed");
+        return NULL;
+    }
+    if (sprintf_s(str, len, "%s,\"" JSON_SEQUENCE_NUMBER "\":%hu}", cache->body,
+        GetSequenceNumber(isBroadcast)) < 0) {
+        DFINDER_LOGE(TAG, "format sequence number failed");
+        free(str);
+        return NULL;
+    }
+    return str;
+}
+
+void ClearServiceDiscoverPayloadCache(void)
+{
+    for (uint32_t i = 0; i < SERVICE_DISCOVER_CACHE_NUM; i++) {
+        ClearServiceDiscoverCache(&g_serviceDiscoverCache[i]);
+    }
+    g_serviceDiscoverCacheNext = 0;
+}
+
 char *PrepareServiceDiscover(uint8_t af, const char *localIpStr, uint8_t isBroadcast, uint8_t businessType,
     const char *serviceData)
 {
@@ -537,6 +672,7 @@ static int32_t ParseServiceDiscoverEx(const uint8_t *buf, DeviceInfo *deviceInfo
     ParseBusinessDataJsonData(data, deviceInfo, isBroadcast);
     deviceInfo->businessData.isBroadcast = isBroadcast;
     ParseSequenceNumber(data, deviceInfo, isBroadcast);
+    ParsePayloadVersion(data, deviceInfo);
     *remoteUrlPtr = remoteUrl;
     cJSON_Delete(data);
     DFINDER_MGT_UNPACK_LOG(deviceInfo);
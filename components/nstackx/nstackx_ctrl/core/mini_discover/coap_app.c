@@ -240,7 +240,7 @@ static int32_t CoapSendMessageEx(const CoapBuildParam *param, uint8_t isBroadcas
 
     ret = BuildCoapPkt(param, payload, &sndPktBuff, isAckMsg);
     if (payload != NULL) {
-        cJSON_free(payload);
+        free(payload);
         payload = NULL;
     }
     if (ret != DISCOVERY_ERR_SUCCESS) {
@@ -30,6 +30,7 @@
 
 #include "coap_app.h"
 #include "coap_discover.h"
+#include "compact_payload.h"
 #include "nstackx.h"
 #include "nstackx_device.h"
 #include "nstackx_epoll.h"
@@ -158,6 +159,15 @@ int32_t GetServiceDiscoverInfo(const uint8_t *buf, size_t size, struct DeviceInf
         DFINDER_LOGE(TAG, "buf size <= 0");
         return NSTACKX_EFAILED;
     }
+#ifdef DFINDER_SUPPORT_COMPACT_PAYLOAD
+    if (IsCompactServiceDiscover(buf, size)) {
+        if (ParseCompactServiceDiscover(buf, size, deviceInfo, remoteUrlPtr) != NSTACKX_EOK) {
+            DFINDER_LOGE(TAG, "parse compact service discover error");
+            return NSTACKX_EFAILED;
+        }
+        return NSTACKX_EOK;
+    }
+#endif /* END OF DFINDER_SUPPORT_COMPACT_PAYLOAD */
     if (buf[size - 1] != '\0') {
         newBuf = (uint8_t *)calloc(size + 1, 1U);
         if (newBuf == NULL) {
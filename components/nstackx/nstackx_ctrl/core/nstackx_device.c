@@ -468,6 +468,7 @@ void DeviceModuleClean(void)
 #endif /* END OF DFINDER_SAVE_DEVICE_LIST */
 
     LocalDeviceDeinit();
+    ClearServiceDiscoverPayloadCache();
 }
 
 static void GlobalInterfaceListInit(void)
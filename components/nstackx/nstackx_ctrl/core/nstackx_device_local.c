@@ -15,6 +15,7 @@
 
 #include "nstackx_device_local.h"
 #include <securec.h>
+#include <stdatomic.h>
 #include "nstackx_dfinder_hidump.h"
 #include "nstackx_error.h"
 #include "nstackx_dev.h"
@@ -62,6 +63,8 @@ typedef struct LocalDevice_ {
 } LocalDevice;
 
 static LocalDevice g_localDevice;
+/* bumped after every change of the advertised local info, lets the payload builder reuse its cache */
+static atomic_uint_fast32_t g_localDeviceInfoVersion;
 
 #define LOCAL_DEVICE_OFFLINE_DEFERRED_DURATION 5000 /* Defer local device offline event, 5 seconds */
 
@@ -77,6 +80,16 @@ static pthread_mutex_t g_businessDataLock = PTHREAD_MUTEX_INITIALIZER;
 static pthread_mutex_t g_extendServiceDataLock = PTHREAD_MUTEX_INITIALIZER;
 static pthread_mutex_t g_deviceInfoLock = PTHREAD_MUTEX_INITIALIZER;
 
+static inline void LocalDeviceInfoChanged(void)
+{
+    g_localDeviceInfoVersion++;
+}
+
+uint32_t GetLocalDeviceInfoVersion(void)
+{
+    return (uint32_t)g_localDeviceInfoVersion;
+}
+
 static void LocalDeviceTimeout(void *data)
 {
     (void)data;
@@ -459,6 +472,7 @@ static int CopyDeviceInfoV2(const NSTACKX_LocalDeviceInfoV2 *devInfo)
     if (devInfo->hasDeviceHash) {
         SetLocalDeviceHash(devInfo->deviceHash);
     }
+    LocalDeviceInfoChanged();
 
     return NSTACKX_EOK;
 }
@@ -514,6 +528,7 @@ void ConfigureLocalDeviceName(const char *localDeviceName)
             DFINDER_LOGE(TAG, "config device name failed and cannot restore!");
         }
     }
+    LocalDeviceInfoChanged();
 }
 
 void SetLocalDeviceHash(uint64_t deviceHash)
@@ -524,6 +539,7 @@ void SetLocalDeviceHash(uint64_t deviceHash)
         "%ju", deviceHash) == -1) {
         DFINDER_LOGE(TAG, "set device hash error");
     }
+    LocalDeviceInfoChanged();
 }
 
 int SetLocalDeviceCapability(uint32_t capabilityBitmapNum, uint32_t capabilityBitmap[])
@@ -548,6 +564,7 @@ int SetLocalDeviceCapability(uint32_t capabilityBitmapNum, uint32_t capabilityBi
     }
 
     g_localDevice.deviceInfo.capabilityBitmapNum = capabilityBitmapNum;
+    LocalDeviceInfoChanged();
     if (PthreadMutexUnlock(&g_capabilityLock) != 0) {
         DFINDER_LOGE(TAG, "failed to unlock");
         return NSTACKX_EFAILED;
@@ -568,6 +585,7 @@ int32_t SetLocalDeviceServiceData(const char *serviceData)
         }
         return NSTACKX_EFAILED;
     }
+    LocalDeviceInfoChanged();
     if (PthreadMutexUnlock(&g_serviceDataLock) != 0) {
         DFINDER_LOGE(TAG, "failed to unlock");
         return NSTACKX_EFAILED;
@@ -647,6 +665,7 @@ int32_t SetLocalDeviceServiceDataV2(const struct NSTACKX_ServiceData *param, uin
 void SetLocalDeviceBusinessType(uint8_t businessType)
 {
     g_localDevice.deviceInfo.businessType = businessType;
+    LocalDeviceInfoChanged();
 }
 
 uint8_t GetLocalDeviceBusinessType(void)
@@ -676,6 +695,7 @@ int SetLocalDeviceBusinessData(const char *data, bool unicast)
         }
         return NSTACKX_EFAILED;
     }
+    LocalDeviceInfoChanged();
 
     if (PthreadMutexUnlock(&g_businessDataLock) != 0) {
         DFINDER_LOGE(TAG, "failed to unlock");
@@ -702,6 +722,7 @@ uint8_t GetLocalDeviceMode(void)
 void SetLocalDeviceMode(uint8_t mode)
 {
     g_localDevice.deviceInfo.mode = mode;
+    LocalDeviceInfoChanged();
 }
 
 #ifndef DFINDER_USE_MINI_NSTACKX
@@ -719,6 +740,7 @@ int32_t SetLocalDeviceExtendServiceData(const char *extendServiceData)
         }
         return NSTACKX_EFAILED;
     }
+    LocalDeviceInfoChanged();
     if (PthreadMutexUnlock(&g_extendServiceDataLock) != 0) {
         DFINDER_LOGE(TAG, "failed to unlock");
         return NSTACKX_EFAILED;
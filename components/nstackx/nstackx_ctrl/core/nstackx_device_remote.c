@@ -31,10 +31,19 @@
 #define RX_IFACE_REMOTE_NODE_COUNT 4
 #endif
 
+#ifdef DFINDER_USE_MINI_NSTACKX
+#define REMOTE_DEVICE_BUCKET_NUM 1
+#else
+#define REMOTE_DEVICE_BUCKET_NUM 128 /* power of 2, keeps the chains short up to NSTACKX_MAX_DEVICE_NUM */
+#endif
+#define FNV_OFFSET_BASIS 2166136261U
+#define FNV_PRIME 16777619U
+
 #define TAG "REMOTEDEVICE"
 #define REPORT_INTERVAL 1000 /* 1 SECOND */
 struct RxIface_;
 struct RemoteDevice_;
+struct RemoteDeviceTable_;
 typedef struct RemoteNode_ {
     List node;
     List orderedNode;
@@ -42,6 +51,7 @@ typedef struct RemoteNode_ {
     struct RxIface_ *rxIface;
     UpdateState updateState;
     struct timespec updateTs;
+    uint64_t updateSeq;
 } RemoteNode;
 
 typedef struct RxIface_ {
@@ -55,62 +65,93 @@ typedef struct RxIface_ {
 
 typedef struct RemoteDevice_ {
     List node;
+    List hashNode;
     char deviceId[NSTACKX_MAX_DEVICE_ID_LEN];
     List rxIfaceList;
+    struct RemoteDeviceTable_ *table;
 } RemoteDevice;
 
-static List *g_remoteDeviceList;
-static List *g_remoteDeviceListBackup;
-static List *g_remoteDeviceOrderedList;
-static uint32_t g_remoteNodeCount;
+/*
+ * All nodes share one aging time, so the least recently updated node is always the first to age: the ordered
+ * list is kept in update order and both aging and capacity eviction only look at its front.
+ */
+typedef struct RemoteDeviceTable_ {
+    List deviceList;
+    List deviceBucket[REMOTE_DEVICE_BUCKET_NUM]; /* devices hashed by deviceId */
+    List orderedList; /* remote nodes from the least to the most recently updated */
+    uint32_t nodeCount;
+    uint64_t updateSeq;
+} RemoteDeviceTable;
+
+static RemoteDeviceTable *g_remoteDeviceTable;
+static RemoteDeviceTable *g_remoteDeviceTableBackup;
 static atomic_uint_fast32_t g_agingTime;
 static struct timespec g_lastReportedTime;
-int32_t RemoteDeviceListInit(void)
+static void RemoteDeviceTableInit(RemoteDeviceTable *table)
 {
-    g_remoteDeviceList = (List *)malloc(sizeof(List));
-    if (g_remoteDeviceList == NULL) {
-        DFINDER_LOGE(TAG, "malloc remote device list failed");
-        goto FAIL;
+    ListInitHead(&table->deviceList);
+    for (uint32_t i = 0; i < REMOTE_DEVICE_BUCKET_NUM; i++) {
+        ListInitHead(&table->deviceBucket[i]);
+    }
+    ListInitHead(&table->orderedList);
+    table->nodeCount = 0;
+    table->updateSeq = 0;
+}
+
+static uint32_t GetRemoteDeviceBucket(const char *deviceId)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+    for (const uint8_t *ch = (const uint8_t *)deviceId; *ch != '\0'; ch++) {
+        hash = (hash ^ *ch) * FNV_PRIME;
     }
-    g_remoteDeviceListBackup = (List *)malloc(sizeof(List));
-    if (g_remoteDeviceListBackup == NULL) {
-        DFINDER_LOGE(TAG, "malloc remote device backup list failed");
+    return hash & (REMOTE_DEVICE_BUCKET_NUM - 1);
+}
+
+static __inline RemoteDevice *HashNodeEntry(List *node)
+{
+    return (RemoteDevice *)((char *)(node) - (uintptr_t)(&(((RemoteDevice *)0)->hashNode)));
+}
+
+int32_t RemoteDeviceListInit(void)
+{
+    g_remoteDeviceTable = (RemoteDeviceTable *)malloc(sizeof(RemoteDeviceTable));
+    if (g_remoteDeviceTable == NULL) {
+        DFINDER_LOGE(TAG, "malloc remote device table failed");
         goto FAIL;
     }
-    g_remoteDeviceOrderedList = (List *)malloc(sizeof(List));
-    if (g_remoteDeviceOrderedList == NULL) {
-        DFINDER_LOGE(TAG, "malloc remote device ordered list failed");
+    g_remoteDeviceTableBackup = (RemoteDeviceTable *)malloc(sizeof(RemoteDeviceTable));
+    if (g_remoteDeviceTableBackup == NULL) {
+        DFINDER_LOGE(TAG, "malloc remote device backup table failed");
         goto FAIL;
     }
-    ListInitHead(g_remoteDeviceList);
-    ListInitHead(g_remoteDeviceListBackup);
-    ListInitHead(g_remoteDeviceOrderedList);
-    g_remoteNodeCount = 0;
+    RemoteDeviceTableInit(g_remoteDeviceTable);
+    RemoteDeviceTableInit(g_remoteDeviceTableBackup);
     return NSTACKX_EOK;
 
 FAIL:
-    free(g_remoteDeviceList);
-    g_remoteDeviceList = NULL;
+    free(g_remoteDeviceTable);
+    g_remoteDeviceTable = NULL;
 
-    free(g_remoteDeviceListBackup);
-    g_remoteDeviceListBackup = NULL;
+    free(g_remoteDeviceTableBackup);
+    g_remoteDeviceTableBackup = NULL;
 
     return NSTACKX_EFAILED;
 }
 
 static void DestroyRemoteNode(RxIface *rxIface, RemoteNode *node)
 {
+    RemoteDeviceTable *table = rxIface->device->table;
     ListRemoveNode(&node->node);
     ListRemoveNode(&node->orderedNode);
-    if (g_remoteNodeCount > 0) {
-        g_remoteNodeCount--;
+    if (table->nodeCount > 0) {
+        table->nodeCount--;
     }
     if (rxIface->remoteNodeCnt > 0) {
         rxIface->remoteNodeCnt--;
     }
     free(node);
     DFINDER_LOGD(TAG, "iface %s remove a node, node count: %u, total node count: %u",
-        rxIface->localIfInfo.networkName, rxIface->remoteNodeCnt, g_remoteNodeCount);
+        rxIface->localIfInfo.networkName, rxIface->remoteNodeCnt, table->nodeCount);
 }
 
 void DestroyRxIface(RxIface *rxIface)
@@ -134,6 +175,7 @@ void DestroyRemoteDevice(RemoteDevice *device)
         DestroyRxIface(rxIface);
     }
     ListRemoveNode(&device->node);
+    ListRemoveNode(&device->hashNode);
     free(device);
 }
 
@@ -145,15 +187,15 @@ static void DestroyRemoteNodeAndDevice(RxIface *rxIface, RemoteNode *node)
     }
 }
 
-static void ClearRemoteDeviceList(List *list)
+static void ClearRemoteDeviceList(RemoteDeviceTable *table)
 {
-    if (list == NULL) {
+    if (table == NULL) {
         return;
     }
     List *pos = NULL;
     List *tmp = NULL;
     RemoteDevice *device = NULL;
-    LIST_FOR_EACH_SAFE(pos, tmp, list) {
+    LIST_FOR_EACH_SAFE(pos, tmp, &table->deviceList) {
         device = (RemoteDevice *)pos;
         DestroyRemoteDevice(device);
     }
@@ -161,37 +203,33 @@ static void ClearRemoteDeviceList(List *list)
 
 void RemoteDeviceListDeinit(void)
 {
-    ClearRemoteDeviceList(g_remoteDeviceList);
-    free(g_remoteDeviceList);
-    g_remoteDeviceList = NULL;
-    ClearRemoteDeviceList(g_remoteDeviceListBackup);
-    free(g_remoteDeviceListBackup);
-    g_remoteDeviceListBackup = NULL;
-    free(g_remoteDeviceOrderedList);
-    g_remoteDeviceOrderedList = NULL;
-    g_remoteNodeCount = 0;
+    ClearRemoteDeviceList(g_remoteDeviceTable);
+    free(g_remoteDeviceTable);
+    g_remoteDeviceTable = NULL;
+    ClearRemoteDeviceList(g_remoteDeviceTableBackup);
+    free(g_remoteDeviceTableBackup);
+    g_remoteDeviceTableBackup = NULL;
 }
 
 void ClearRemoteDeviceListBackup(void)
 {
-    ClearRemoteDeviceList(g_remoteDeviceListBackup);
+    ClearRemoteDeviceList(g_remoteDeviceTableBackup);
 }
 
 void BackupRemoteDeviceList(void)
 {
-    ClearRemoteDeviceList(g_remoteDeviceListBackup);
-    List *tmp = g_remoteDeviceListBackup;
-    g_remoteDeviceListBackup = g_remoteDeviceList;
-    g_remoteDeviceList = tmp;
-    g_remoteNodeCount = 0;
+    ClearRemoteDeviceList(g_remoteDeviceTableBackup);
+    RemoteDeviceTable *tmp = g_remoteDeviceTableBackup;
+    g_remoteDeviceTableBackup = g_remoteDeviceTable;
+    g_remoteDeviceTable = tmp;
 }
 
-static RemoteDevice *FindRemoteDevice(List *list, const char *deviceId)
+static RemoteDevice *FindRemoteDevice(RemoteDeviceTable *table, const char *deviceId)
 {
     List *pos = NULL;
     RemoteDevice *device = NULL;
-    LIST_FOR_EACH(pos, list) {
-        device = (RemoteDevice *)pos;
+    LIST_FOR_EACH(pos, &table->deviceBucket[GetRemoteDeviceBucket(deviceId)]) {
+        device = HashNodeEntry(pos);
         if (strcmp(device->deviceId, deviceId) == 0) {
             return device;
         }
@@ -199,6 +237,13 @@ static RemoteDevice *FindRemoteDevice(List *list, const char *deviceId)
     return NULL;
 }
 
+static void InsertRemoteDevice(RemoteDeviceTable *table, RemoteDevice *device)
+{
+    device->table = table;
+    ListInsertTail(&table->deviceList, &device->node);
+    ListInsertTail(&table->deviceBucket[GetRemoteDeviceBucket(device->deviceId)], &device->hashNode);
+}
+
 static RxIface *FindRxIface(const RemoteDevice* device, const NSTACKX_InterfaceInfo *interfaceInfo)
 {
     List *pos = NULL;
@@ -517,11 +562,11 @@ static void DestroyOldestRemoteNode(RxIface *rxIface)
     DFINDER_LOGD(TAG, "rx iface %s release the oldest remote node",
         rxIface->localIfInfo.networkName);
     List *pos = NULL;
-    List *tmp = NULL;
     RemoteNode *oldestNode = NULL;
-    LIST_FOR_EACH_SAFE(pos, tmp, &rxIface->remoteNodeList) {
+    /* at most RX_IFACE_REMOTE_NODE_COUNT nodes, the update sequence orders them even within one millisecond */
+    LIST_FOR_EACH(pos, &rxIface->remoteNodeList) {
         RemoteNode *tmpNode = (RemoteNode *)pos;
-        if (oldestNode == NULL || GetTimeDiffMs(&tmpNode->updateTs, &oldestNode->updateTs) == 0) {
+        if (oldestNode == NULL || tmpNode->updateSeq < oldestNode->updateSeq) {
             oldestNode = tmpNode;
         }
     }
@@ -533,11 +578,22 @@ static void DestroyOldestRemoteNode(RxIface *rxIface)
 
 static void AddRemoteNodeToList(RxIface *rxIface, RemoteNode *remoteNode)
 {
+    RemoteDeviceTable *table = rxIface->device->table;
     ListInsertTail(&rxIface->remoteNodeList, &remoteNode->node);
+    ListInsertTail(&table->orderedList, &remoteNode->orderedNode);
     rxIface->remoteNodeCnt++;
-    g_remoteNodeCount++;
+    table->nodeCount++;
     DFINDER_LOGD(TAG, "iface %s add a node, iface node count: %u, total node count: %u",
-        rxIface->localIfInfo.networkName, rxIface->remoteNodeCnt, g_remoteNodeCount);
+        rxIface->localIfInfo.networkName, rxIface->remoteNodeCnt, table->nodeCount);
+}
+
+static void TouchRemoteNode(RemoteNode *remoteNode)
+{
+    RemoteDeviceTable *table = remoteNode->rxIface->device->table;
+    ListRemoveNode(&remoteNode->orderedNode);
+    ListInsertTail(&table->orderedList, &remoteNode->orderedNode);
+    remoteNode->updateSeq = ++table->updateSeq;
+    ClockGetTime(CLOCK_MONOTONIC, &remoteNode->updateTs);
 }
 
 void SetDeviceListAgingTime(uint32_t agingTime)
@@ -566,10 +622,13 @@ static __inline RemoteNode *OrderedNodeEntry(List *node)
 
 static int32_t CheckAndRemoveAgingNode(void)
 {
-    RemoteNode *oldestNode = OrderedNodeEntry(ListGetFront(g_remoteDeviceOrderedList));
+    if (ListIsEmpty(&g_remoteDeviceTable->orderedList)) {
+        return NSTACKX_EFAILED;
+    }
+    RemoteNode *oldestNode = OrderedNodeEntry(ListGetFront(&g_remoteDeviceTable->orderedList));
     if (!IsAllowToBeRemoved(oldestNode)) {
         DFINDER_LOGD(TAG, "remote node count %u reach the max device num, please reset the max value",
-            g_remoteNodeCount);
+            g_remoteDeviceTable->nodeCount);
         struct timespec now;
         ClockGetTime(CLOCK_MONOTONIC, &now);
         uint32_t measureElapse = GetTimeDiffMs(&now, &g_lastReportedTime);
@@ -586,10 +645,13 @@ static int32_t CheckAndRemoveAgingNode(void)
 
 void RemoveOldestNodesWithCount(uint32_t diffNum)
 {
+    if (g_remoteDeviceTable == NULL) {
+        return;
+    }
     RemoteNode *oldestNode = NULL;
     RxIface *rxIface = NULL;
-    for (uint32_t i = 0; i < diffNum; i++) {
-        oldestNode = OrderedNodeEntry(ListGetFront(g_remoteDeviceOrderedList));
+    for (uint32_t i = 0; i < diffNum && !ListIsEmpty(&g_remoteDeviceTable->orderedList); i++) {
+        oldestNode = OrderedNodeEntry(ListGetFront(&g_remoteDeviceTable->orderedList));
         rxIface = (RxIface *)oldestNode->rxIface;
         DestroyRemoteNodeAndDevice(rxIface, oldestNode);
     }
@@ -597,7 +659,7 @@ void RemoveOldestNodesWithCount(uint32_t diffNum)
 
 uint32_t GetRemoteNodeCount(void)
 {
-    return g_remoteNodeCount;
+    return (g_remoteDeviceTable == NULL) ? 0 : g_remoteDeviceTable->nodeCount;
 }
 
 static RemoteNode *CheckAndCreateRemoteNode(RxIface *rxIface, const DeviceInfo *deviceInfo)
@@ -611,35 +673,43 @@ static RemoteNode *CheckAndCreateRemoteNode(RxIface *rxIface, const DeviceInfo *
         return NULL;
     }
     AddRemoteNodeToList(rxIface, remoteNode);
-    ListInsertTail(g_remoteDeviceOrderedList, &remoteNode->orderedNode);
-
     return remoteNode;
 }
 
 static bool UpdateOldRemoteNode(void)
 {
-    if (g_remoteNodeCount == GetMaxDeviceNum() && CheckAndRemoveAgingNode() != NSTACKX_EOK) {
-        DFINDER_LOGE(TAG, "remote node count %u reach the max device num", g_remoteNodeCount);
+    if (g_remoteDeviceTable->nodeCount >= GetMaxDeviceNum() && CheckAndRemoveAgingNode() != NSTACKX_EOK) {
+        DFINDER_LOGE(TAG, "remote node count %u reach the max device num", g_remoteDeviceTable->nodeCount);
         IncStatistics(STATS_OVER_DEVICE_LIMIT);
         return false;
     }
     return true;
 }
 
-int32_t UpdateRemoteNodeByDeviceInfo(const char *deviceId, const NSTACKX_InterfaceInfo *interfaceInfo,
-    const DeviceInfo *deviceInfo, int8_t *updated)
+static RemoteNode *FindRemoteNode(RemoteDeviceTable *table, const char *deviceId,
+    const NSTACKX_InterfaceInfo *interfaceInfo, const DeviceInfo *deviceInfo)
 {
-    if (!UpdateOldRemoteNode()) {
-        return NSTACKX_EFAILED;
+    RemoteDevice *device = FindRemoteDevice(table, deviceId);
+    if (device == NULL) {
+        return NULL;
+    }
+    RxIface *rxIface = FindRxIface(device, interfaceInfo);
+    if (rxIface == NULL) {
+        return NULL;
     }
+    return FindRemoteNodeByRemoteIp(rxIface, deviceInfo);
+}
 
-    RemoteDevice *device = FindRemoteDevice(g_remoteDeviceList, deviceId);
+static RemoteNode *AddRemoteNode(const char *deviceId, const NSTACKX_InterfaceInfo *interfaceInfo,
+    const DeviceInfo *deviceInfo)
+{
+    RemoteDevice *device = FindRemoteDevice(g_remoteDeviceTable, deviceId);
     if (device == NULL) {
         device = CreateRemoteDevice(deviceId);
         if (device == NULL) {
-            return NSTACKX_EFAILED;
+            return NULL;
         }
-        ListInsertTail(g_remoteDeviceList, &(device->node));
+        InsertRemoteDevice(g_remoteDeviceTable, device);
     }
 
     RxIface *rxIface = FindRxIface(device, interfaceInfo);
@@ -648,31 +718,15 @@ int32_t UpdateRemoteNodeByDeviceInfo(const char *deviceId, const NSTACKX_Interfa
         if (rxIface == NULL) {
             goto FAIL_AND_FREE;
         }
-        ClockGetTime(CLOCK_MONOTONIC, &(rxIface->updateTime));
         ListInsertTail(&(device->rxIfaceList), &(rxIface->node));
     }
 
-    RemoteNode *remoteNode = FindRemoteNodeByRemoteIp(rxIface, deviceInfo);
+    RemoteNode *remoteNode = CheckAndCreateRemoteNode(rxIface, deviceInfo);
     if (remoteNode == NULL) {
-        remoteNode = CheckAndCreateRemoteNode(rxIface, deviceInfo);
-        if (remoteNode == NULL) {
-            goto FAIL_AND_FREE;
-        }
-        ClockGetTime(CLOCK_MONOTONIC, &(rxIface->updateTime));
-        *updated = NSTACKX_TRUE;
-    } else {
-        if (UpdateRemoteNode(remoteNode, rxIface, deviceInfo, updated) != NSTACKX_EOK) {
-            return NSTACKX_EFAILED;
-        }
-        ListRemoveNode(&remoteNode->orderedNode);
-        ListInsertTail(g_remoteDeviceOrderedList, &remoteNode->orderedNode);
+        goto FAIL_AND_FREE;
     }
-#ifdef DFINDER_DISTINGUISH_ACTIVE_PASSIVE_DISCOVERY
-    CheckAndUpdateRemoteNodeChangeState(remoteNode, deviceInfo, updated);
-#endif
-    remoteNode->deviceInfo.update = *updated;
-    ClockGetTime(CLOCK_MONOTONIC, &remoteNode->updateTs);
-    return NSTACKX_EOK;
+    ClockGetTime(CLOCK_MONOTONIC, &(rxIface->updateTime));
+    return remoteNode;
 
 FAIL_AND_FREE:
     if (rxIface != NULL && ListIsEmpty(&rxIface->remoteNodeList)) {
@@ -682,9 +736,37 @@ FAIL_AND_FREE:
 
     if (ListIsEmpty(&device->rxIfaceList)) {
         ListRemoveNode(&device->node);
+        ListRemoveNode(&device->hashNode);
         free(device);
     }
-    return NSTACKX_EFAILED;
+    return NULL;
+}
+
+int32_t UpdateRemoteNodeByDeviceInfo(const char *deviceId, const NSTACKX_InterfaceInfo *interfaceInfo,
+    const DeviceInfo *deviceInfo, int8_t *updated)
+{
+    RemoteNode *remoteNode = FindRemoteNode(g_remoteDeviceTable, deviceId, interfaceInfo, deviceInfo);
+    if (remoteNode != NULL) {
+        if (UpdateRemoteNode(remoteNode, remoteNode->rxIface, deviceInfo, updated) != NSTACKX_EOK) {
+            return NSTACKX_EFAILED;
+        }
+    } else {
+        /* only a new node needs room, the aging node it replaces may belong to the same device */
+        if (!UpdateOldRemoteNode()) {
+            return NSTACKX_EFAILED;
+        }
+        remoteNode = AddRemoteNode(deviceId, interfaceInfo, deviceInfo);
+        if (remoteNode == NULL) {
+            return NSTACKX_EFAILED;
+        }
+        *updated = NSTACKX_TRUE;
+    }
+#ifdef DFINDER_DISTINGUISH_ACTIVE_PASSIVE_DISCOVERY
+    CheckAndUpdateRemoteNodeChangeState(remoteNode, deviceInfo, updated);
+#endif
+    remoteNode->deviceInfo.update = *updated;
+    TouchRemoteNode(remoteNode);
+    return NSTACKX_EOK;
 }
 
 static int32_t CopyRemoteNodeToDeviceInfo(DeviceInfo *deviceInfo, NSTACKX_DeviceInfo *deviceList,
@@ -751,7 +833,7 @@ static int32_t CopyRemoteDeviceListToDeviceInfo(NSTACKX_DeviceInfo *deviceList,
 {
     List *pos = NULL;
     RemoteDevice *device = NULL;
-    LIST_FOR_EACH(pos, g_remoteDeviceList) {
+    LIST_FOR_EACH(pos, &g_remoteDeviceTable->deviceList) {
         device = (RemoteDevice *)pos;
         if (CopyRxIfaceListToDeviceInfo(&device->rxIfaceList, deviceList, maxDeviceNum,
             deviceCountPtr, doFilter) != NSTACKX_EOK) {
@@ -778,13 +860,13 @@ static void DestroyRxIfaceByIfnameInner(RemoteDevice *device, const char *ifName
 
 void DestroyRxIfaceByIfname(const char *ifName)
 {
-    if (g_remoteDeviceList == NULL) {
+    if (g_remoteDeviceTable == NULL) {
         return;
     }
     List *pos = NULL;
     List *tmp = NULL;
     RemoteDevice *device = NULL;
-    LIST_FOR_EACH_SAFE(pos, tmp, g_remoteDeviceList) {
+    LIST_FOR_EACH_SAFE(pos, tmp, &g_remoteDeviceTable->deviceList) {
         device = (RemoteDevice *)pos;
         DestroyRxIfaceByIfnameInner(device, ifName);
     }
@@ -821,9 +903,9 @@ static RxIface *GetRemoteDevcieFirstRxIface(RemoteDevice *device)
     return NULL;
 }
 
-const struct in_addr *GetRemoteDeviceIpInner(List *list, const char *deviceId)
+static const struct in_addr *GetRemoteDeviceIpInner(RemoteDeviceTable *table, const char *deviceId)
 {
-    RemoteDevice *device = FindRemoteDevice(list, deviceId);
+    RemoteDevice *device = FindRemoteDevice(table, deviceId);
     if (device == NULL || ListIsEmpty(&device->rxIfaceList)) {
         return NULL;
     }
@@ -844,11 +926,11 @@ const struct in_addr *GetRemoteDeviceIpInner(List *list, const char *deviceId)
 const struct in_addr *GetRemoteDeviceIp(const char *deviceId)
 {
     const struct in_addr *remoteIp;
-    remoteIp = GetRemoteDeviceIpInner(g_remoteDeviceList, deviceId);
+    remoteIp = GetRemoteDeviceIpInner(g_remoteDeviceTable, deviceId);
     if (remoteIp != NULL) {
         return remoteIp;
     }
-    return GetRemoteDeviceIpInner(g_remoteDeviceListBackup, deviceId);
+    return GetRemoteDeviceIpInner(g_remoteDeviceTableBackup, deviceId);
 }
 
 #ifdef NSTACKX_DFINDER_HIDUMP
@@ -878,7 +960,7 @@ int DumpRemoteDevice(char *buf, size_t len)
 {
     List *pos = NULL;
     size_t index = 0;
-    LIST_FOR_EACH(pos, g_remoteDeviceList) {
+    LIST_FOR_EACH(pos, &g_remoteDeviceTable->deviceList) {
         RemoteDevice *device = (RemoteDevice *)pos;
         int ret = DumpRemoteNode(device, buf + index, len - index);
         if (ret < 0 || (size_t)ret > len - index) {
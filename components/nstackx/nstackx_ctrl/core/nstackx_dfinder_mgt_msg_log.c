@@ -22,6 +22,7 @@
 #include "nstackx_dfinder_log.h"
 #include "nstackx_util.h"
 #include "json_payload.h"
+#include "compact_payload.h"
 
 #ifdef DFINDER_MGT_MSG_LOG
 
@@ -293,6 +294,11 @@ void DFinderMgtReqLog(CoapRequest *coapRequest)
     if (!g_mgtMsgLog) {
         return;
     }
+    if (IsCompactServiceDiscover((const uint8_t *)coapRequest->data, coapRequest->dataLength)) {
+        DFINDER_LOGI(TAG, "coap msg type: %s, compact req data len: %zu", GetCoapReqTypeStr(coapRequest->type),
+            coapRequest->dataLength);
+        return;
+    }
     char *coapReqData = ParseCoapRequestData(coapRequest->data, coapRequest->dataLength);
     if (coapReqData == NULL) {
         DFINDER_LOGE(TAG, "parse coap request data failed");
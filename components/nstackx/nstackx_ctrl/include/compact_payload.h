@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMPACT_PAYLOAD_H
+#define COMPACT_PAYLOAD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Compact service discover payload: a two byte header of magic and version followed by
+ * type(1 byte) | length(2 bytes, network order) | value records. The magic can never start
+ * a json payload, so both formats are told apart by the first byte. Only unicast replies to
+ * peers which announced the version in their json broadcast use it, broadcasts stay json.
+ */
+#define COMPACT_PAYLOAD_MAGIC 0xA5
+#define COMPACT_PAYLOAD_VERSION 1
+#define COMPACT_PAYLOAD_HEADER_LEN 2
+#define COMPACT_PAYLOAD_TLV_HEADER_LEN 3
+
+/* payloadVersion of a peer which only understands json */
+#define PAYLOAD_VERSION_JSON 0
+
+enum {
+    COMPACT_TYPE_DEVICE_ID = 1,
+    COMPACT_TYPE_DEVICE_NAME,
+    COMPACT_TYPE_DEVICE_TYPE,
+    COMPACT_TYPE_MODE,
+    COMPACT_TYPE_DEVICE_HASH,
+    COMPACT_TYPE_SERVICE_DATA,
+    COMPACT_TYPE_EXTEND_SERVICE_DATA,
+    COMPACT_TYPE_WLAN_IP,
+    COMPACT_TYPE_CAPABILITY_BITMAP,
+    COMPACT_TYPE_BUSINESS_TYPE,
+    COMPACT_TYPE_BUSINESS_DATA,
+    COMPACT_TYPE_SEQUENCE_NUMBER,
+    COMPACT_TYPE_MAX,
+};
+
+struct DeviceInfo;
+
+bool IsCompactServiceDiscover(const uint8_t *buf, size_t size);
+/* the payload is binary, its length is returned through len, release it with free */
+char *PrepareCompactServiceDiscover(const char *localIpStr, uint8_t businessType, const char *serviceData,
+    size_t *len);
+int32_t ParseCompactServiceDiscover(const uint8_t *buf, size_t size, struct DeviceInfo *deviceInfo,
+    char **remoteUrlPtr);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* #ifndef COMPACT_PAYLOAD_H */
@@ -39,6 +39,7 @@ extern "C" {
 #define JSON_EXTEND_SERVICE_DATA "extendServiceData"
 #define JSON_SEQUENCE_NUMBER "seqNo"
 #define JSON_NOTIFICATION "notify"
+#define JSON_PAYLOAD_VERSION "pVer"
 
 #ifdef DFINDER_USE_MINI_NSTACKX
 #define COAP_DEVICE_DISCOVER_URI "device_discover"
@@ -46,8 +47,10 @@ extern "C" {
 
 struct DeviceInfo;
 
+/* the payload is built from a cache that follows the local device info, release it with free */
 char *PrepareServiceDiscover(uint8_t af, const char *localIpStr,
     uint8_t isBroadcast, uint8_t businessType, const char *serviceData);
+void ClearServiceDiscoverPayloadCache(void);
 int32_t ParseServiceDiscover(const uint8_t *buf, struct DeviceInfo *deviceInfo, char **remoteUrlPtr);
 char *PrepareServiceNotification(void);
 int32_t ParseServiceNotification(const uint8_t *buf, NSTACKX_NotificationConfig *config);
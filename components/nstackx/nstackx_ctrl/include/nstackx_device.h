@@ -132,6 +132,7 @@ typedef struct DeviceInfo {
     uint32_t capabilityBitmap[NSTACKX_MAX_CAPABILITY_NUM];
     uint8_t mode;
     uint8_t discoveryType;
+    uint8_t payloadVersion; /* highest compact payload version the peer understands, 0 for json only */
     char deviceHash[DEVICE_HASH_LEN];
     char serviceData[NSTACKX_MAX_SERVICE_DATA_LEN];
     uint8_t businessType;
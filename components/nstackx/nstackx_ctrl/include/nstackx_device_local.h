@@ -47,6 +47,7 @@ int SetLocalDeviceBusinessData(const char *data, bool unicast);
 int32_t LocalizeNotificationMsg(const char *msg);
 uint8_t GetLocalDeviceMode(void);
 void SetLocalDeviceMode(uint8_t mode);
+uint32_t GetLocalDeviceInfoVersion(void);
 
 #ifndef DFINDER_USE_MINI_NSTACKX
 int32_t SetLocalDeviceExtendServiceData(const char *extendServiceData);
@@ -15,24 +15,573 @@
 
 #include "broadcast_scheduler.h"
 
+#include <securec.h>
+
+#include "disc_log.h"
+#include "message_handler.h"
+#include "softbus_adapter_mem.h"
+#include "softbus_adapter_thread.h"
+#include "softbus_adapter_timer.h"
+#include "softbus_broadcast_utils.h"
+#include "softbus_error_code.h"
+
+/*
+ * Advertising sets the scheduler may hold, kept in line with MAX_BLE_ADV_NUM of the broadcast manager. Neither the
+ * manager nor the adapter reports the free sets of the controller, so this assumes every soft bus advertisement goes
+ * through the scheduler and no other BLE user on the device holds a set. When that does not hold, the start of a
+ * rotated advertisement fails and it keeps waiting, it is retried on the next rotation.
+ */
+#define SCHEDULER_ADV_SLOT_NUM 7
+#define SCHEDULER_MIN_TICK_MS 100
+#define SCHEDULER_DEFAULT_LATENCY_MS 4000
+#define SCHEDULER_DEFAULT_DWELL_MS 1000
+#define MSG_SCHEDULER_ROTATE 1
+
+typedef struct {
+    BaseServiceType srvType;
+    uint8_t priority;
+    uint32_t latencyMs; // longest time the advertisement may stay off air
+    uint32_t dwellMs;   // shortest time the advertisement stays on air once started
+} SchedulerSrvPolicy;
+
+static const SchedulerSrvPolicy g_srvPolicy[] = {
+    { SRV_TYPE_HB,           3, 1000, 500  },
+    { SRV_TYPE_FAST_OFFLINE, 3, 1000, 500  },
+    { SRV_TYPE_APPROACH,     2, 1500, 500  },
+    { SRV_TYPE_OH_APPROACH,  2, 1500, 500  },
+    { SRV_TYPE_TOUCH,        2, 1500, 500  },
+    { SRV_TYPE_SHARE,        1, 2000, 1000 },
+    { SRV_TYPE_DIS,          1, 2000, 1000 },
+};
+
+typedef struct {
+    bool isUsed;
+    bool isActive;          // the service wants to advertise
+    bool isOnAir;           // the advertisement holds a hardware set
+    bool isStartNotified;   // the service has seen its start callback
+    bool suppressStartCb;   // start caused by rotation, hide it from the service
+    bool suppressStopCb;    // stop caused by rotation, hide it from the service
+    int32_t hostBcId;       // >= 0 when an identical advertisement on air serves this one
+    BaseServiceType srvType;
+    BroadcastContentType contentType;
+    BroadcastParam param;
+    BroadcastPacket packet;
+    uint64_t onAirTime;
+    uint64_t offAirTime;
+    BroadcastCallback cb;
+} SchedulerBroadcaster;
+
+typedef struct {
+    uint64_t (*getTime)(void);
+    void (*armTimer)(uint64_t delayMs);
+} SchedulerClock;
+
+typedef void (*SchedulerCallbackFunc)(int32_t bcId, int32_t status);
+
+typedef struct {
+    int32_t bcId;
+    int32_t status;
+    SchedulerCallbackFunc callback;
+} SchedulerNotify;
+
+/* service callbacks due while g_schedOpLock is held, fired once it is released */
+typedef struct {
+    uint32_t num;
+    SchedulerNotify notify[BC_NUM_MAX + 1];
+} SchedulerNotifyList;
+
+static void SchedulerArmRotateTimer(uint64_t delayMs);
+
+static SchedulerBroadcaster g_schedBc[BC_NUM_MAX];
+static SoftBusMutex g_schedOpLock;
+static SoftBusMutex g_schedCbLock;
+static bool g_schedInit = false;
+static uint32_t g_schedSlotNum = SCHEDULER_ADV_SLOT_NUM;
+static SchedulerClock g_schedClock = { SoftBusGetSysTimeMs, SchedulerArmRotateTimer };
+static SoftBusHandler g_schedHandler = { 0 };
+
+static const SchedulerSrvPolicy *GetSrvPolicy(BaseServiceType srvType)
+{
+    static const SchedulerSrvPolicy defaultPolicy = {
+        SRV_TYPE_BUTT, 0, SCHEDULER_DEFAULT_LATENCY_MS, SCHEDULER_DEFAULT_DWELL_MS
+    };
+    for (uint32_t i = 0; i < sizeof(g_srvPolicy) / sizeof(g_srvPolicy[0]); ++i) {
+        if (g_srvPolicy[i].srvType == srvType) {
+            return &g_srvPolicy[i];
+        }
+    }
+    return &defaultPolicy;
+}
+
+static bool IsBcIdValid(int32_t bcId)
+{
+    return bcId >= 0 && bcId < BC_NUM_MAX && g_schedBc[bcId].isUsed;
+}
+
+static void FreePayload(BroadcastPayload *payload)
+{
+    SoftBusFree(payload->payload);
+    payload->payload = NULL;
+    payload->payloadLen = 0;
+}
+
+static int32_t CopyPayload(BroadcastPayload *dst, const BroadcastPayload *src)
+{
+    *dst = *src;
+    dst->payload = NULL;
+    if (src->payload == NULL || src->payloadLen == 0) {
+        dst->payloadLen = 0;
+        return SOFTBUS_OK;
+    }
+    dst->payload = (uint8_t *)SoftBusCalloc(src->payloadLen);
+    if (dst->payload == NULL) {
+        return SOFTBUS_MALLOC_ERR;
+    }
+    if (memcpy_s(dst->payload, src->payloadLen, src->payload, src->payloadLen) != EOK) {
+        FreePayload(dst);
+        return SOFTBUS_MEM_ERR;
+    }
+    return SOFTBUS_OK;
+}
+
+static void FreePacket(BroadcastPacket *packet)
+{
+    FreePayload(&packet->bcData);
+    FreePayload(&packet->rspData);
+}
+
+static int32_t StorePacket(SchedulerBroadcaster *bc, const BroadcastPacket *packet)
+{
+    BroadcastPacket copy = *packet;
+    int32_t ret = CopyPayload(&copy.bcData, &packet->bcData);
+    if (ret != SOFTBUS_OK) {
+        return ret;
+    }
+    ret = CopyPayload(&copy.rspData, &packet->rspData);
+    if (ret != SOFTBUS_OK) {
+        FreePayload(&copy.bcData);
+        return ret;
+    }
+    FreePacket(&bc->packet);
+    bc->packet = copy;
+    return SOFTBUS_OK;
+}
+
+static bool IsPayloadEqual(const BroadcastPayload *a, const BroadcastPayload *b)
+{
+    if (a->id != b->id || a->type != b->type || a->payloadLen != b->payloadLen) {
+        return false;
+    }
+    return a->payloadLen == 0 || memcmp(a->payload, b->payload, a->payloadLen) == 0;
+}
+
+/* identical advertisements, e.g. two services publishing the same capability, share one hardware set */
+static bool IsCompatible(const SchedulerBroadcaster *a, const SchedulerBroadcaster *b)
+{
+    return a->contentType == b->contentType && a->param.advType == b->param.advType &&
+        a->param.minInterval == b->param.minInterval && a->param.maxInterval == b->param.maxInterval &&
+        a->param.txPower == b->param.txPower && a->packet.isSupportFlag == b->packet.isSupportFlag &&
+        a->packet.flag == b->packet.flag && IsPayloadEqual(&a->packet.bcData, &b->packet.bcData) &&
+        IsPayloadEqual(&a->packet.rspData, &b->packet.rspData);
+}
+
+static void ResolveMergedBroadcasters(void)
+{
+    for (int32_t i = 0; i < BC_NUM_MAX; ++i) {
+        g_schedBc[i].hostBcId = -1;
+        if (!g_schedBc[i].isActive) {
+            continue;
+        }
+        for (int32_t j = 0; j < i; ++j) {
+            if (g_schedBc[j].isActive && g_schedBc[j].hostBcId < 0 && IsCompatible(&g_schedBc[i], &g_schedBc[j])) {
+                g_schedBc[i].hostBcId = j;
+                break;
+            }
+        }
+    }
+}
+
+typedef enum {
+    SCHED_CLASS_DWELLING = 0, // on air and still inside its dwell time
+    SCHED_CLASS_OVERDUE,      // off air for longer than its latency target
+    SCHED_CLASS_NORMAL,
+} SchedulerClass;
+
+static SchedulerClass GetSchedClass(const SchedulerBroadcaster *bc, uint64_t now)
+{
+    const SchedulerSrvPolicy *policy = GetSrvPolicy(bc->srvType);
+    if (bc->isOnAir) {
+        return (now - bc->onAirTime < policy->dwellMs) ? SCHED_CLASS_DWELLING : SCHED_CLASS_NORMAL;
+    }
+    return (now - bc->offAirTime >= policy->latencyMs) ? SCHED_CLASS_OVERDUE : SCHED_CLASS_NORMAL;
+}
+
+/* returns true if a should get a hardware set before b */
+static bool IsPreferred(const SchedulerBroadcaster *a, const SchedulerBroadcaster *b, uint64_t now)
+{
+    SchedulerClass classA = GetSchedClass(a, now);
+    SchedulerClass classB = GetSchedClass(b, now);
+    if (classA != classB) {
+        return classA < classB;
+    }
+    uint64_t offA = a->isOnAir ? 0 : now - a->offAirTime;
+    uint64_t offB = b->isOnAir ? 0 : now - b->offAirTime;
+    if (classA == SCHED_CLASS_OVERDUE) {
+        return offA - GetSrvPolicy(a->srvType)->latencyMs > offB - GetSrvPolicy(b->srvType)->latencyMs;
+    }
+    uint8_t prioA = GetSrvPolicy(a->srvType)->priority;
+    uint8_t prioB = GetSrvPolicy(b->srvType)->priority;
+    if (prioA != prioB) {
+        return prioA > prioB;
+    }
+    if (offA != offB) {
+        return offA > offB;
+    }
+    if (a->isOnAir != b->isOnAir) {
+        return a->isOnAir;
+    }
+    // between two advertisements on air the one holding its set the longest yields first
+    return a->isOnAir && a->onAirTime > b->onAirTime;
+}
+
+static void SelectOnAirSet(bool *selected, uint64_t now)
+{
+    for (uint32_t slot = 0; slot < g_schedSlotNum; ++slot) {
+        int32_t best = -1;
+        for (int32_t i = 0; i < BC_NUM_MAX; ++i) {
+            if (!g_schedBc[i].isActive || g_schedBc[i].hostBcId >= 0 || selected[i]) {
+                continue;
+            }
+            if (best < 0 || IsPreferred(&g_schedBc[i], &g_schedBc[best], now)) {
+                best = i;
+            }
+        }
+        if (best < 0) {
+            return;
+        }
+        selected[best] = true;
+    }
+}
+
+static uint64_t GetNextRotateDelay(uint64_t now)
+{
+    uint32_t waiting = 0;
+    uint64_t delay = UINT64_MAX;
+    for (int32_t i = 0; i < BC_NUM_MAX; ++i) {
+        const SchedulerBroadcaster *bc = &g_schedBc[i];
+        if (!bc->isActive || bc->hostBcId >= 0) {
+            continue;
+        }
+        const SchedulerSrvPolicy *policy = GetSrvPolicy(bc->srvType);
+        uint64_t deadline = bc->isOnAir ? bc->onAirTime + policy->dwellMs : bc->offAirTime + policy->latencyMs;
+        delay = (deadline > now && deadline - now < delay) ? deadline - now : delay;
+        waiting += bc->isOnAir ? 0 : 1;
+    }
+    if (waiting == 0) {
+        return 0;
+    }
+    return (delay < SCHEDULER_MIN_TICK_MS || delay == UINT64_MAX) ? SCHEDULER_MIN_TICK_MS : delay;
+}
+
+static void SetSuppressFlag(int32_t bcId, bool isStart, bool suppress)
+{
+    if (SoftBusMutexLock(&g_schedCbLock) != SOFTBUS_OK) {
+        DISC_LOGE(DISC_BROADCAST, "lock failed");
+        return;
+    }
+    if (isStart) {
+        g_schedBc[bcId].suppressStartCb = suppress;
+    } else {
+        g_schedBc[bcId].suppressStopCb = suppress;
+    }
+    (void)SoftBusMutexUnlock(&g_schedCbLock);
+}
+
+static void TakeOffAir(int32_t bcId, uint64_t now)
+{
+    SetSuppressFlag(bcId, false, true);
+    int32_t ret = StopBroadcasting(bcId);
+    if (ret != SOFTBUS_OK) {
+        SetSuppressFlag(bcId, false, false);
+        DISC_LOGW(DISC_BROADCAST, "rotate out failed, bcId=%{public}d, ret=%{public}d", bcId, ret);
+    }
+    g_schedBc[bcId].isOnAir = false;
+    g_schedBc[bcId].offAirTime = now;
+}
+
+static int32_t PutOnAir(int32_t bcId, uint64_t now)
+{
+    SchedulerBroadcaster *bc = &g_schedBc[bcId];
+    SetSuppressFlag(bcId, true, bc->isStartNotified);
+    int32_t ret = StartBroadcasting(bcId, &bc->param, &bc->packet);
+    if (ret != SOFTBUS_OK) {
+        SetSuppressFlag(bcId, true, false);
+        DISC_LOGE(DISC_BROADCAST, "put on air failed, bcId=%{public}d, ret=%{public}d", bcId, ret);
+        return ret;
+    }
+    bc->isOnAir = true;
+    bc->isStartNotified = true;
+    bc->onAirTime = now;
+    return SOFTBUS_OK;
+}
+
+static void AddNotify(SchedulerNotifyList *list, int32_t bcId, SchedulerCallbackFunc callback)
+{
+    if (callback == NULL || list->num >= sizeof(list->notify) / sizeof(list->notify[0])) {
+        return;
+    }
+    list->notify[list->num].bcId = bcId;
+    list->notify[list->num].status = (int32_t)SOFTBUS_BC_STATUS_SUCCESS;
+    list->notify[list->num].callback = callback;
+    list->num++;
+}
+
+/* called without g_schedOpLock, a service may call back into the scheduler from its callback */
+static void FireNotify(const SchedulerNotifyList *list)
+{
+    for (uint32_t i = 0; i < list->num; ++i) {
+        list->notify[i].callback(list->notify[i].bcId, list->notify[i].status);
+    }
+}
+
+static void NotifyMergedStart(int32_t bcId, SchedulerNotifyList *notify)
+{
+    SchedulerBroadcaster *bc = &g_schedBc[bcId];
+    if (bc->isStartNotified || bc->hostBcId < 0 || !g_schedBc[bc->hostBcId].isOnAir) {
+        return;
+    }
+    bc->isStartNotified = true;
+    AddNotify(notify, bcId, bc->cb.OnStartBroadcastingCallback);
+}
+
+/*
+ * Picks the advertisements that own the hardware sets until the next rotation and applies the difference.
+ * Returns the start result of reqBcId when it was put on air in this round, SOFTBUS_OK otherwise.
+ * Called with g_schedOpLock held, the caller fires notify after releasing it.
+ */
+static int32_t ScheduleBroadcastLocked(int32_t reqBcId, SchedulerNotifyList *notify)
+{
+    uint64_t now = g_schedClock.getTime();
+    bool selected[BC_NUM_MAX] = { false };
+    int32_t reqRet = SOFTBUS_OK;
+    ResolveMergedBroadcasters();
+    SelectOnAirSet(selected, now);
+    for (int32_t i = 0; i < BC_NUM_MAX; ++i) {
+        if (g_schedBc[i].isOnAir && !selected[i]) {
+            TakeOffAir(i, now);
+        }
+    }
+    for (int32_t i = 0; i < BC_NUM_MAX; ++i) {
+        if (!selected[i] || g_schedBc[i].isOnAir) {
+            continue;
+        }
+        int32_t ret = PutOnAir(i, now);
+        if (ret != SOFTBUS_OK && !g_schedBc[i].isStartNotified) {
+            // a service only learns about the failure of its first start, rotations retry silently
+            g_schedBc[i].isActive = false;
+            reqRet = (i == reqBcId) ? ret : reqRet;
+        }
+    }
+    for (int32_t i = 0; i < BC_NUM_MAX; ++i) {
+        if (g_schedBc[i].isActive) {
+            NotifyMergedStart(i, notify);
+        }
+    }
+    uint64_t delay = GetNextRotateDelay(now);
+    if (delay != 0) {
+        g_schedClock.armTimer(delay);
+    }
+    return reqRet;
+}
+
+static void SchedulerRotate(void)
+{
+    SchedulerNotifyList notify = { 0 };
+    if (SoftBusMutexLock(&g_schedOpLock) != SOFTBUS_OK) {
+        DISC_LOGE(DISC_BROADCAST, "lock failed");
+        return;
+    }
+    (void)ScheduleBroadcastLocked(-1, &notify);
+    (void)SoftBusMutexUnlock(&g_schedOpLock);
+    FireNotify(&notify);
+}
+
+static void SchedulerMsgHandler(SoftBusMessage *msg)
+{
+    if (msg != NULL && msg->what == MSG_SCHEDULER_ROTATE) {
+        SchedulerRotate();
+    }
+}
+
+static void SchedulerArmRotateTimer(uint64_t delayMs)
+{
+    if (g_schedHandler.looper == NULL) {
+        return;
+    }
+    SoftBusMessage *msg = (SoftBusMessage *)SoftBusCalloc(sizeof(SoftBusMessage));
+    if (msg == NULL) {
+        DISC_LOGE(DISC_BROADCAST, "calloc rotate msg failed");
+        return;
+    }
+    msg->what = MSG_SCHEDULER_ROTATE;
+    msg->handler = &g_schedHandler;
+    g_schedHandler.looper->RemoveMessage(g_schedHandler.looper, &g_schedHandler, MSG_SCHEDULER_ROTATE);
+    g_schedHandler.looper->PostMessageDelay(g_schedHandler.looper, msg, delayMs);
+}
+
+static bool GetUserCallback(int32_t bcId, bool *suppress, BroadcastCallback *cb)
+{
+    if (!g_schedInit || bcId < 0 || bcId >= BC_NUM_MAX || SoftBusMutexLock(&g_schedCbLock) != SOFTBUS_OK) {
+        return false;
+    }
+    bool forward = g_schedBc[bcId].isUsed && (suppress == NULL || !*suppress);
+    if (suppress != NULL) {
+        *suppress = false;
+    }
+    *cb = g_schedBc[bcId].cb;
+    (void)SoftBusMutexUnlock(&g_schedCbLock);
+    return forward;
+}
+
+static void SchedOnStartBroadcasting(int32_t bcId, int32_t status)
+{
+    BroadcastCallback cb;
+    if (bcId >= 0 && bcId < BC_NUM_MAX && GetUserCallback(bcId, &g_schedBc[bcId].suppressStartCb, &cb) &&
+        cb.OnStartBroadcastingCallback != NULL) {
+        cb.OnStartBroadcastingCallback(bcId, status);
+    }
+}
+
+static void SchedOnStopBroadcasting(int32_t bcId, int32_t status)
+{
+    BroadcastCallback cb;
+    if (bcId >= 0 && bcId < BC_NUM_MAX && GetUserCallback(bcId, &g_schedBc[bcId].suppressStopCb, &cb) &&
+        cb.OnStopBroadcastingCallback != NULL) {
+        cb.OnStopBroadcastingCallback(bcId, status);
+    }
+}
+
+#define SCHED_FORWARD_CALLBACK(name, field)                                   \
+    static void name(int32_t bcId, int32_t status)                            \
+    {                                                                         \
+        BroadcastCallback cb;                                                 \
+        if (GetUserCallback(bcId, NULL, &cb) && cb.field != NULL) {           \
+            cb.field(bcId, status);                                           \
+        }                                                                     \
+    }
+
+SCHED_FORWARD_CALLBACK(SchedOnUpdateBroadcasting, OnUpdateBroadcastingCallback)
+SCHED_FORWARD_CALLBACK(SchedOnSetBroadcasting, OnSetBroadcastingCallback)
+SCHED_FORWARD_CALLBACK(SchedOnSetBroadcastingParam, OnSetBroadcastingParamCallback)
+SCHED_FORWARD_CALLBACK(SchedOnEnableBroadcasting, OnEnableBroadcastingCallback)
+SCHED_FORWARD_CALLBACK(SchedOnDisableBroadcasting, OnDisableBroadcastingCallback)
+
+static BroadcastCallback g_schedBcCallback = {
+    .OnStartBroadcastingCallback = SchedOnStartBroadcasting,
+    .OnStopBroadcastingCallback = SchedOnStopBroadcasting,
+    .OnUpdateBroadcastingCallback = SchedOnUpdateBroadcasting,
+    .OnSetBroadcastingCallback = SchedOnSetBroadcasting,
+    .OnSetBroadcastingParamCallback = SchedOnSetBroadcastingParam,
+    .OnEnableBroadcastingCallback = SchedOnEnableBroadcasting,
+    .OnDisableBroadcastingCallback = SchedOnDisableBroadcasting,
+};
+
+static void ResetBroadcaster(SchedulerBroadcaster *bc)
+{
+    FreePacket(&bc->packet);
+    (void)memset_s(bc, sizeof(SchedulerBroadcaster), 0, sizeof(SchedulerBroadcaster));
+    bc->hostBcId = -1;
+}
+
 int32_t SchedulerInitBroadcast(void)
 {
-    return InitBroadcastMgr();
+    int32_t ret = InitBroadcastMgr();
+    if (ret != SOFTBUS_OK || g_schedInit) {
+        return ret;
+    }
+    if (SoftBusMutexInit(&g_schedOpLock, NULL) != SOFTBUS_OK) {
+        DISC_LOGE(DISC_BROADCAST, "init op lock failed");
+        return SOFTBUS_NO_INIT;
+    }
+    if (SoftBusMutexInit(&g_schedCbLock, NULL) != SOFTBUS_OK) {
+        DISC_LOGE(DISC_BROADCAST, "init cb lock failed");
+        (void)SoftBusMutexDestroy(&g_schedOpLock);
+        return SOFTBUS_NO_INIT;
+    }
+    for (int32_t i = 0; i < BC_NUM_MAX; ++i) {
+        ResetBroadcaster(&g_schedBc[i]);
+    }
+    g_schedHandler.name = (char *)"bc_scheduler_handler";
+    g_schedHandler.looper = GetLooper(LOOP_TYPE_DEFAULT);
+    g_schedHandler.HandleMessage = SchedulerMsgHandler;
+    if (g_schedHandler.looper == NULL) {
+        DISC_LOGW(DISC_BROADCAST, "no looper, advertisements only rotate on service requests");
+    }
+    g_schedInit = true;
+    return SOFTBUS_OK;
 }
 
 int32_t SchedulerDeinitBroadcast(void)
 {
+    if (g_schedInit) {
+        if (g_schedHandler.looper != NULL) {
+            g_schedHandler.looper->RemoveMessage(g_schedHandler.looper, &g_schedHandler, MSG_SCHEDULER_ROTATE);
+        }
+        for (int32_t i = 0; i < BC_NUM_MAX; ++i) {
+            ResetBroadcaster(&g_schedBc[i]);
+        }
+        (void)SoftBusMutexDestroy(&g_schedCbLock);
+        (void)SoftBusMutexDestroy(&g_schedOpLock);
+        g_schedInit = false;
+    }
     return DeInitBroadcastMgr();
 }
 
 int32_t SchedulerRegisterBroadcaster(BaseServiceType type, int32_t *bcId, const BroadcastCallback *cb)
 {
-    return RegisterBroadcaster(type, bcId, cb);
+    if (!g_schedInit) {
+        return RegisterBroadcaster(type, bcId, cb);
+    }
+    DISC_CHECK_AND_RETURN_RET_LOGE(bcId != NULL && cb != NULL, SOFTBUS_INVALID_PARAM, DISC_BROADCAST,
+        "invalid param");
+    DISC_CHECK_AND_RETURN_RET_LOGE(SoftBusMutexLock(&g_schedOpLock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR,
+        DISC_BROADCAST, "lock failed");
+    int32_t ret = RegisterBroadcaster(type, bcId, &g_schedBcCallback);
+    if (ret != SOFTBUS_OK || *bcId < 0 || *bcId >= BC_NUM_MAX) {
+        (void)SoftBusMutexUnlock(&g_schedOpLock);
+        return ret != SOFTBUS_OK ? ret : SOFTBUS_BC_MGR_INVALID_BC_ID;
+    }
+    if (SoftBusMutexLock(&g_schedCbLock) == SOFTBUS_OK) {
+        ResetBroadcaster(&g_schedBc[*bcId]);
+        g_schedBc[*bcId].isUsed = true;
+        g_schedBc[*bcId].srvType = type;
+        g_schedBc[*bcId].cb = *cb;
+        (void)SoftBusMutexUnlock(&g_schedCbLock);
+    }
+    (void)SoftBusMutexUnlock(&g_schedOpLock);
+    return SOFTBUS_OK;
 }
 
 int32_t SchedulerUnregisterBroadcaster(int32_t bcId)
 {
-    return UnRegisterBroadcaster(bcId);
+    if (!g_schedInit) {
+        return UnRegisterBroadcaster(bcId);
+    }
+    SchedulerNotifyList notify = { 0 };
+    DISC_CHECK_AND_RETURN_RET_LOGE(SoftBusMutexLock(&g_schedOpLock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR,
+        DISC_BROADCAST, "lock failed");
+    int32_t ret = UnRegisterBroadcaster(bcId);
+    if (IsBcIdValid(bcId) && SoftBusMutexLock(&g_schedCbLock) == SOFTBUS_OK) {
+        bool wasActive = g_schedBc[bcId].isActive;
+        ResetBroadcaster(&g_schedBc[bcId]);
+        (void)SoftBusMutexUnlock(&g_schedCbLock);
+        if (wasActive) {
+            (void)ScheduleBroadcastLocked(-1, &notify);
+        }
+    }
+    (void)SoftBusMutexUnlock(&g_schedOpLock);
+    FireNotify(&notify);
+    return ret;
 }
 
 int32_t SchedulerRegisterScanListener(BaseServiceType type, int32_t *listenerId, const ScanCallback *cb)
@@ -48,28 +597,158 @@ int32_t SchedulerUnregisterListener(int32_t listenerId)
 int32_t SchedulerStartBroadcast(int32_t bcId, BroadcastContentType contentType, const BroadcastParam *param,
     const BroadcastPacket *packet)
 {
-    (void)contentType;
-    return StartBroadcasting(bcId, param, packet);
+    if (!g_schedInit) {
+        return StartBroadcasting(bcId, param, packet);
+    }
+    DISC_CHECK_AND_RETURN_RET_LOGE(param != NULL && packet != NULL, SOFTBUS_INVALID_PARAM, DISC_BROADCAST,
+        "invalid param");
+    DISC_CHECK_AND_RETURN_RET_LOGE(SoftBusMutexLock(&g_schedOpLock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR,
+        DISC_BROADCAST, "lock failed");
+    if (!IsBcIdValid(bcId)) {
+        (void)SoftBusMutexUnlock(&g_schedOpLock);
+        DISC_LOGE(DISC_BROADCAST, "invalid bcId=%{public}d", bcId);
+        return SOFTBUS_BC_MGR_INVALID_BC_ID;
+    }
+    SchedulerBroadcaster *bc = &g_schedBc[bcId];
+    int32_t ret = StorePacket(bc, packet);
+    if (ret != SOFTBUS_OK) {
+        (void)SoftBusMutexUnlock(&g_schedOpLock);
+        return ret;
+    }
+    bc->param = *param;
+    bc->contentType = contentType;
+    if (bc->isActive && bc->isOnAir) {
+        // restarting an advertisement on air keeps its set, as the broadcast manager did before
+        SetSuppressFlag(bcId, true, false);
+        ret = StartBroadcasting(bcId, param, packet);
+        (void)SoftBusMutexUnlock(&g_schedOpLock);
+        return ret;
+    }
+    if (!bc->isActive) {
+        bc->isActive = true;
+        bc->isStartNotified = false;
+        bc->offAirTime = g_schedClock.getTime();
+    }
+    SchedulerNotifyList notify = { 0 };
+    ret = ScheduleBroadcastLocked(bcId, &notify);
+    (void)SoftBusMutexUnlock(&g_schedOpLock);
+    FireNotify(&notify);
+    return ret;
+}
+
+typedef enum {
+    SCHED_UPDATE_ALL,
+    SCHED_UPDATE_DATA,
+    SCHED_UPDATE_PARAM,
+} SchedulerUpdateType;
+
+static int32_t UpdateOnAir(int32_t bcId, SchedulerUpdateType type, const BroadcastParam *param,
+    const BroadcastPacket *packet)
+{
+    switch (type) {
+        case SCHED_UPDATE_DATA:
+            return SetBroadcastingData(bcId, packet);
+        case SCHED_UPDATE_PARAM:
+            return SetBroadcastingParam(bcId, param);
+        default:
+            return UpdateBroadcasting(bcId, param, packet);
+    }
+}
+
+static SchedulerCallbackFunc GetUpdateCallback(const BroadcastCallback *cb, SchedulerUpdateType type)
+{
+    switch (type) {
+        case SCHED_UPDATE_DATA:
+            return cb->OnSetBroadcastingCallback;
+        case SCHED_UPDATE_PARAM:
+            return cb->OnSetBroadcastingParamCallback;
+        default:
+            return cb->OnUpdateBroadcastingCallback;
+    }
+}
+
+/*
+ * An advertisement waiting for a hardware set only records the change, it is applied when it goes on air.
+ * The service still gets the callback of its request, as it would from the broadcast manager.
+ */
+static int32_t SchedulerUpdate(int32_t bcId, SchedulerUpdateType type, const BroadcastParam *param,
+    const BroadcastPacket *packet)
+{
+    SchedulerNotifyList notify = { 0 };
+    DISC_CHECK_AND_RETURN_RET_LOGE(SoftBusMutexLock(&g_schedOpLock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR,
+        DISC_BROADCAST, "lock failed");
+    if (!IsBcIdValid(bcId) || !g_schedBc[bcId].isActive) {
+        (void)SoftBusMutexUnlock(&g_schedOpLock);
+        return UpdateOnAir(bcId, type, param, packet);
+    }
+    SchedulerBroadcaster *bc = &g_schedBc[bcId];
+    int32_t ret = (packet != NULL) ? StorePacket(bc, packet) : SOFTBUS_OK;
+    if (ret == SOFTBUS_OK && param != NULL) {
+        bc->param = *param;
+    }
+    if (ret == SOFTBUS_OK && bc->isOnAir) {
+        ret = UpdateOnAir(bcId, type, param, packet);
+    } else if (ret == SOFTBUS_OK) {
+        AddNotify(&notify, bcId, GetUpdateCallback(&bc->cb, type));
+    }
+    if (ret == SOFTBUS_OK) {
+        ret = ScheduleBroadcastLocked(-1, &notify);
+    }
+    (void)SoftBusMutexUnlock(&g_schedOpLock);
+    FireNotify(&notify);
+    return ret;
 }
 
 int32_t SchedulerUpdateBroadcast(int32_t bcId, const BroadcastParam *param, const BroadcastPacket *packet)
 {
-    return UpdateBroadcasting(bcId, param, packet);
+    if (!g_schedInit || param == NULL || packet == NULL) {
+        return UpdateBroadcasting(bcId, param, packet);
+    }
+    return SchedulerUpdate(bcId, SCHED_UPDATE_ALL, param, packet);
 }
 
 int32_t SchedulerSetBroadcastData(int32_t bcId, const BroadcastPacket *packet)
 {
-    return SetBroadcastingData(bcId, packet);
+    if (!g_schedInit || packet == NULL) {
+        return SetBroadcastingData(bcId, packet);
+    }
+    return SchedulerUpdate(bcId, SCHED_UPDATE_DATA, NULL, packet);
 }
 
 int32_t SchedulerSetBroadcastParam(int32_t bcId, const BroadcastParam *param)
 {
-    return SetBroadcastingParam(bcId, param);
+    if (!g_schedInit || param == NULL) {
+        return SetBroadcastingParam(bcId, param);
+    }
+    return SchedulerUpdate(bcId, SCHED_UPDATE_PARAM, param, NULL);
 }
 
 int32_t SchedulerStopBroadcast(int32_t bcId)
 {
-    return StopBroadcasting(bcId);
+    if (!g_schedInit) {
+        return StopBroadcasting(bcId);
+    }
+    DISC_CHECK_AND_RETURN_RET_LOGE(SoftBusMutexLock(&g_schedOpLock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR,
+        DISC_BROADCAST, "lock failed");
+    if (!IsBcIdValid(bcId) || !g_schedBc[bcId].isActive) {
+        (void)SoftBusMutexUnlock(&g_schedOpLock);
+        return StopBroadcasting(bcId);
+    }
+    SchedulerBroadcaster *bc = &g_schedBc[bcId];
+    SchedulerNotifyList notify = { 0 };
+    bc->isActive = false;
+    int32_t ret = SOFTBUS_OK;
+    if (bc->isOnAir) {
+        bc->isOnAir = false;
+        SetSuppressFlag(bcId, false, false);
+        ret = StopBroadcasting(bcId);
+    } else {
+        AddNotify(&notify, bcId, bc->cb.OnStopBroadcastingCallback);
+    }
+    (void)ScheduleBroadcastLocked(-1, &notify);
+    (void)SoftBusMutexUnlock(&g_schedOpLock);
+    FireNotify(&notify);
+    return ret;
 }
 
 int32_t SchedulerStartScan(int32_t listenerId, const BcScanParams *param)
@@ -21,6 +21,7 @@
 
 #include "ble_range.h"
 #include "data_level.h"
+#include "node_state_batch_inner.h"
 #include "softbus_bus_center.h"
 
 #ifdef __cplusplus
@@ -37,6 +38,7 @@ int32_t LnnIpcGetNodeKeyInfo(const char *pkgName, const char *networkId, int32_t
 int32_t LnnIpcSetNodeDataChangeFlag(const char *pkgName, const char *networkId, uint16_t dataChangeFlag);
 int32_t LnnIpcRegDataLevelChangeCb(const char *pkgName, int32_t callingPid);
 int32_t LnnIpcUnregDataLevelChangeCb(const char *pkgName, int32_t callingPid);
+int32_t LnnIpcRegNodeStateBatch(const char *pkgName, int32_t callingPid);
 int32_t LnnIpcSetDataLevel(const DataLevel *dataLevel);
 int32_t LnnIpcGetNodeKeyInfoLen(int32_t key);
 int32_t LnnIpcStartTimeSync(
@@ -54,6 +56,8 @@ int32_t LnnIpcNotifyJoinResult(void *addr, uint32_t addrTypeLen, const char *net
 int32_t LnnIpcNotifyLeaveResult(const char *networkId, int32_t retCode);
 int32_t LnnIpcNotifyOnlineState(bool isOnline, void *info, uint32_t infoTypeLen);
 int32_t LnnIpcNotifyBasicInfoChanged(void *info, uint32_t infoTypeLen, int32_t type);
+int32_t LnnIpcNotifyNodeStateBatch(const NodeStateBatchItem *items, uint32_t num);
+int32_t LnnIpcNotifyNodeStateNoBatch(const NodeStateBatchItem *item);
 int32_t LnnIpcNotifyNodeStatusChanged(void *info, uint32_t infoTypeLen, int32_t type);
 int32_t LnnIpcLocalNetworkIdChanged(void);
 int32_t LnnIpcNotifyDeviceTrustedChange(int32_t type, const char *msg, uint32_t msgLen);
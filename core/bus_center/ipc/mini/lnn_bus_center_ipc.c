@@ -183,6 +183,18 @@ int32_t LnnIpcNotifyBasicInfoChanged(void *info, uint32_t infoTypeLen, int32_t t
     return LnnOnNodeBasicInfoChanged("", info, type);
 }
 
+int32_t LnnIpcNotifyNodeStateBatch(const NodeStateBatchItem *items, uint32_t num)
+{
+    return LnnOnNodeStateBatch("", items, num);
+}
+
+int32_t LnnIpcNotifyNodeStateNoBatch(const NodeStateBatchItem *item)
+{
+    /* the only client shares the process and always takes batches */
+    (void)item;
+    return SOFTBUS_OK;
+}
+
 int32_t LnnIpcNotifyNodeStatusChanged(void *info, uint32_t infoTypeLen, int32_t type)
 {
     (void)info;
@@ -446,6 +446,26 @@ int32_t LnnIpcNotifyBasicInfoChanged(void *info, uint32_t infoTypeLen, int32_t t
     return ClinetOnNodeBasicInfoChanged(info, infoTypeLen, type);
 }
 
+int32_t LnnIpcNotifyNodeStateBatch(const NodeStateBatchItem *items, uint32_t num)
+{
+    /* no client can opt in to batches here, they all got the changes from LnnIpcNotifyNodeStateNoBatch */
+    (void)items;
+    (void)num;
+    return SOFTBUS_OK;
+}
+
+int32_t LnnIpcNotifyNodeStateNoBatch(const NodeStateBatchItem *item)
+{
+    if (item == NULL) {
+        return SOFTBUS_INVALID_PARAM;
+    }
+    NodeBasicInfo info = item->info;
+    if (item->event == NODE_STATE_BATCH_BASIC_INFO_CHANGED) {
+        return ClinetOnNodeBasicInfoChanged(&info, sizeof(NodeBasicInfo), item->type);
+    }
+    return ClinetOnNodeOnlineStateChanged(item->event == NODE_STATE_BATCH_ONLINE, &info, sizeof(NodeBasicInfo));
+}
+
 int32_t LnnIpcNotifyNodeStatusChanged(void *info, uint32_t infoTypeLen, int32_t type)
 {
     (void)info;
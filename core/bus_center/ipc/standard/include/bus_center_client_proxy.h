@@ -17,6 +17,7 @@
 #define BUS_CENTER_CLIENT_PROXY_H
 
 #include "data_level_inner.h"
+#include "node_state_batch_inner.h"
 
 #ifdef __cplusplus
 #if __cplusplus
@@ -31,11 +32,15 @@ typedef struct {
     int32_t pid;
 } PkgNameAndPidInfo;
 
+typedef bool (*IsNodeStateBatchPkgFunc)(const char *pkgName, int32_t pid);
+
 int32_t ClientOnJoinLNNResult(PkgNameAndPidInfo *info, void *addr, uint32_t addrTypeLen,
     const char *networkId, int32_t retCode);
 int32_t ClientOnLeaveLNNResult(const char *pkgName, int32_t pid, const char *networkId, int32_t retCode);
 int32_t ClinetOnNodeOnlineStateChanged(bool isOnline, void *info, uint32_t infoTypeLen);
 int32_t ClinetOnNodeBasicInfoChanged(void *info, uint32_t infoTypeLen, int32_t type);
+int32_t ClientOnNodeStateBatch(const NodeStateBatchItem *items, uint32_t num, IsNodeStateBatchPkgFunc isBatchPkg);
+int32_t ClientOnNodeStateNoBatch(const NodeStateBatchItem *item, IsNodeStateBatchPkgFunc isBatchPkg);
 int32_t ClientOnNodeStatusChanged(void *info, uint32_t infoTypeLen, int32_t type);
 int32_t ClinetOnLocalNetworkIdChanged(void);
 int32_t ClinetNotifyDeviceTrustedChange(int32_t type, const char *msg, uint32_t msgLen);
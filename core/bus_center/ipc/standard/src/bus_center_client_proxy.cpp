@@ -88,6 +88,66 @@ int32_t ClinetOnNodeBasicInfoChanged(void *info, uint32_t infoTypeLen, int32_t t
     return SOFTBUS_OK;
 }
 
+static void NotifyNodeStateOneByOne(const sptr<BusCenterClientProxy> &clientProxy, const char *pkgName,
+    const NodeStateBatchItem *items, uint32_t num)
+{
+    for (uint32_t i = 0; i < num; i++) {
+        NodeBasicInfo info = items[i].info;
+        if (items[i].event == NODE_STATE_BATCH_BASIC_INFO_CHANGED) {
+            clientProxy->OnNodeBasicInfoChanged(pkgName, &info, sizeof(NodeBasicInfo), items[i].type);
+        } else {
+            clientProxy->OnNodeOnlineStateChanged(pkgName, items[i].event == NODE_STATE_BATCH_ONLINE, &info,
+                sizeof(NodeBasicInfo));
+        }
+    }
+}
+
+int32_t ClientOnNodeStateBatch(const NodeStateBatchItem *items, uint32_t num, IsNodeStateBatchPkgFunc isBatchPkg)
+{
+    if (items == nullptr || num == 0 || num > NODE_STATE_BATCH_MAX_NUM || isBatchPkg == nullptr) {
+        LNN_LOGE(LNN_EVENT, "invalid param");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    std::multimap<std::string, std::pair<int32_t, sptr<IRemoteObject>>> proxyMap;
+    SoftbusClientInfoManager::GetInstance().GetSoftbusClientProxyMap(proxyMap);
+    for (auto proxy : proxyMap) {
+        if (!isBatchPkg(proxy.first.c_str(), proxy.second.first)) {
+            continue;
+        }
+        sptr<BusCenterClientProxy> clientProxy = new (std::nothrow) BusCenterClientProxy(proxy.second.second);
+        if (clientProxy == nullptr) {
+            LNN_LOGE(LNN_EVENT, "bus center client proxy is nullptr");
+            return SOFTBUS_NETWORK_GET_CLIENT_PROXY_NULL;
+        }
+        if (clientProxy->OnNodeStateBatch(proxy.first.c_str(), items, num) != SOFTBUS_OK) {
+            NotifyNodeStateOneByOne(clientProxy, proxy.first.c_str(), items, num);
+        }
+    }
+    return SOFTBUS_OK;
+}
+
+int32_t ClientOnNodeStateNoBatch(const NodeStateBatchItem *item, IsNodeStateBatchPkgFunc isBatchPkg)
+{
+    if (item == nullptr || isBatchPkg == nullptr) {
+        LNN_LOGE(LNN_EVENT, "invalid param");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    std::multimap<std::string, std::pair<int32_t, sptr<IRemoteObject>>> proxyMap;
+    SoftbusClientInfoManager::GetInstance().GetSoftbusClientProxyMap(proxyMap);
+    for (auto proxy : proxyMap) {
+        if (isBatchPkg(proxy.first.c_str(), proxy.second.first)) {
+            continue;
+        }
+        sptr<BusCenterClientProxy> clientProxy = new (std::nothrow) BusCenterClientProxy(proxy.second.second);
+        if (clientProxy == nullptr) {
+            LNN_LOGE(LNN_EVENT, "bus center client proxy is nullptr");
+            return SOFTBUS_NETWORK_GET_CLIENT_PROXY_NULL;
+        }
+        NotifyNodeStateOneByOne(clientProxy, proxy.first.c_str(), item, 1);
+    }
+    return SOFTBUS_OK;
+}
+
 int32_t ClientOnNodeStatusChanged(void *info, uint32_t infoTypeLen, int32_t type)
 {
     std::multimap<std::string, sptr<IRemoteObject>> proxyMap;
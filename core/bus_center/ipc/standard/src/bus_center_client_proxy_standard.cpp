@@ -312,6 +312,49 @@ int32_t BusCenterClientProxy::OnNodeBasicInfoChanged(const char *pkgName, void *
     return SOFTBUS_OK;
 }
 
+int32_t BusCenterClientProxy::OnNodeStateBatch(const char *pkgName, const NodeStateBatchItem *items, uint32_t num)
+{
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        LNN_LOGE(LNN_EVENT, "remote is nullptr");
+        return SOFTBUS_NETWORK_REMOTE_NULL;
+    }
+    if (pkgName == nullptr || items == nullptr || num == 0 || num > NODE_STATE_BATCH_MAX_NUM) {
+        LNN_LOGE(LNN_EVENT, "invalid parameters");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    MessageParcel data;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        LNN_LOGE(LNN_EVENT, "write InterfaceToken failed!");
+        return SOFTBUS_NETWORK_WRITETOKEN_FAILED;
+    }
+    if (!data.WriteCString(pkgName)) {
+        LNN_LOGE(LNN_EVENT, "write pkgName failed");
+        return SOFTBUS_NETWORK_WRITECSTRING_FAILED;
+    }
+    if (!data.WriteUint32(num)) {
+        LNN_LOGE(LNN_EVENT, "write num failed");
+        return SOFTBUS_NETWORK_WRITEINT32_FAILED;
+    }
+    if (!data.WriteRawData(items, sizeof(NodeStateBatchItem) * num)) {
+        LNN_LOGE(LNN_EVENT, "write node state items failed");
+        return SOFTBUS_NETWORK_WRITERAWDATA_FAILED;
+    }
+    MessageParcel reply;
+    MessageOption option;
+    int ret = remote->SendRequest(CLIENT_ON_NODE_STATE_BATCH, data, reply, option);
+    if (ret != 0) {
+        LNN_LOGE(LNN_EVENT, "send request failed, ret=%{public}d", ret);
+        return SOFTBUS_NETWORK_SEND_REQUEST_FAILED;
+    }
+    int32_t serverRet;
+    if (!reply.ReadInt32(serverRet)) {
+        LNN_LOGE(LNN_EVENT, "read serverRet failed");
+        return SOFTBUS_NETWORK_READINT32_FAILED;
+    }
+    return serverRet;
+}
+
 int32_t BusCenterClientProxy::OnNodeStatusChanged(const char *pkgName, void *info,
     uint32_t infoTypeLen, int32_t type)
 {
@@ -62,12 +62,18 @@ struct MsdpRangeReqInfo {
     int32_t pid;
 };
 
+struct NodeStateBatchReqInfo {
+    char pkgName[PKG_NAME_SIZE_MAX];
+    int32_t pid;
+};
+
 static std::mutex g_lock;
 static std::vector<JoinLnnRequestInfo *> g_joinLNNRequestInfo;
 static std::vector<LeaveLnnRequestInfo *> g_leaveLNNRequestInfo;
 static std::vector<RefreshLnnRequestInfo *> g_refreshLnnRequestInfo;
 static std::vector<DataLevelChangeReqInfo *> g_dataLevelChangeRequestInfo;
 static std::vector<MsdpRangeReqInfo *> g_msdpRangeReqInfo;
+static std::vector<NodeStateBatchReqInfo *> g_nodeStateBatchReqInfo;
 
 static int32_t OnRefreshDeviceFound(const char *pkgName, const DeviceInfo *device,
     const InnerDeviceInfoAddtions *additions);
@@ -340,6 +346,32 @@ int32_t LnnIpcUnregDataLevelChangeCb(const char *pkgName, int32_t callingPid)
     return SOFTBUS_OK;
 }
 
+int32_t LnnIpcRegNodeStateBatch(const char *pkgName, int32_t callingPid)
+{
+    if (pkgName == nullptr) {
+        return SOFTBUS_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> autoLock(g_lock);
+    for (const auto &iter : g_nodeStateBatchReqInfo) {
+        if (strcmp(pkgName, iter->pkgName) == 0 && callingPid == iter->pid) {
+            return SOFTBUS_OK;
+        }
+    }
+    NodeStateBatchReqInfo *info = new (std::nothrow) NodeStateBatchReqInfo();
+    if (info == nullptr) {
+        COMM_LOGE(COMM_SVC, "NodeStateBatchReqInfo object is nullptr");
+        return SOFTBUS_NETWORK_REG_CB_FAILED;
+    }
+    if (strcpy_s(info->pkgName, PKG_NAME_SIZE_MAX, pkgName) != EOK) {
+        LNN_LOGE(LNN_EVENT, "copy pkgName fail");
+        delete info;
+        return SOFTBUS_STRCPY_ERR;
+    }
+    info->pid = callingPid;
+    g_nodeStateBatchReqInfo.push_back(info);
+    return SOFTBUS_OK;
+}
+
 int32_t LnnIpcSetDataLevel(const DataLevel *dataLevel)
 {
     bool isSwitchLevelChanged = false;
@@ -659,6 +691,27 @@ int32_t LnnIpcNotifyBasicInfoChanged(void *info, uint32_t infoTypeLen, int32_t t
     return ClinetOnNodeBasicInfoChanged(info, infoTypeLen, type);
 }
 
+static bool IsNodeStateBatchPkg(const char *pkgName, int32_t pid)
+{
+    std::lock_guard<std::mutex> autoLock(g_lock);
+    for (const auto &iter : g_nodeStateBatchReqInfo) {
+        if (strcmp(pkgName, iter->pkgName) == 0 && pid == iter->pid) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int32_t LnnIpcNotifyNodeStateBatch(const NodeStateBatchItem *items, uint32_t num)
+{
+    return ClientOnNodeStateBatch(items, num, IsNodeStateBatchPkg);
+}
+
+int32_t LnnIpcNotifyNodeStateNoBatch(const NodeStateBatchItem *item)
+{
+    return ClientOnNodeStateNoBatch(item, IsNodeStateBatchPkg);
+}
+
 int32_t LnnIpcNotifyNodeStatusChanged(void *info, uint32_t infoTypeLen, int32_t type)
 {
     return ClientOnNodeStatusChanged(info, infoTypeLen, type);
@@ -728,6 +781,20 @@ static void RemoveRefreshRequestInfoByPkgName(const char *pkgName)
     }
 }
 
+static void RemoveNodeStateBatchInfoByPkgName(const char *pkgName)
+{
+    std::lock_guard<std::mutex> autoLock(g_lock);
+    std::vector<NodeStateBatchReqInfo *>::iterator iter;
+    for (iter = g_nodeStateBatchReqInfo.begin(); iter != g_nodeStateBatchReqInfo.end();) {
+        if (strncmp(pkgName, (*iter)->pkgName, strlen(pkgName)) != 0) {
+            ++iter;
+            continue;
+        }
+        delete *iter;
+        iter = g_nodeStateBatchReqInfo.erase(iter);
+    }
+}
+
 void BusCenterServerDeathCallback(const char *pkgName)
 {
     if (pkgName == nullptr) {
@@ -736,4 +803,5 @@ void BusCenterServerDeathCallback(const char *pkgName)
     RemoveJoinRequestInfoByPkgName(pkgName);
     RemoveLeaveRequestInfoByPkgName(pkgName);
     RemoveRefreshRequestInfoByPkgName(pkgName);
+    RemoveNodeStateBatchInfoByPkgName(pkgName);
 }
@@ -27,6 +27,7 @@ int32_t LaneDetectFload(const LaneResource *resourceItem);
 int32_t InitLaneReliability(void);
 void DeinitLaneReliability(void);
 void NotifyDetectTimeout(uint32_t detectId);
+void NotifyDetectEvidence(uint32_t detectId);
 
 #ifdef __cplusplus
 }
@@ -22,6 +22,9 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "lnn_lane_interface.h"
+#include "softbus_common.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -37,6 +40,26 @@ typedef struct {
     int32_t score;
 } LnnChannelScore;
 
+#define LNN_LINK_SCORE_UNKNOWN 0
+#define LNN_LINK_SCORE_MAX 100
+#define LNN_SCORE_INVALID_CHANNEL (-1)
+
+#define LNN_QUALITY_SAMPLE_RTT        (1 << 0)
+#define LNN_QUALITY_SAMPLE_THROUGHPUT (1 << 1)
+#define LNN_QUALITY_SAMPLE_LOSS       (1 << 2)
+
+/* one measurement of a link, sampleMask tells which of rtt/throughput/loss are valid */
+typedef struct {
+    char peerUdid[UDID_BUF_LEN];
+    LaneLinkType linkType;
+    int32_t channelId;
+    uint32_t sampleMask;
+    uint32_t rttMs;
+    uint32_t throughputKbps;
+    uint32_t lossPermille;
+    uint64_t timestamp;
+} LnnLinkQualitySample;
+
 int32_t LnnInitScore(void);
 void LnnDeinitScore(void);
 int32_t LnnGetCurrChannelScore(int32_t channelId);
@@ -44,6 +67,8 @@ int32_t LnnStartScoring(int32_t interval);
 int32_t LnnStopScoring(void);
 int32_t LnnGetWlanLinkedInfo(LnnWlanLinkedInfo *info);
 int32_t LnnGetAllChannelScore(LnnChannelScore **scoreList, uint32_t *listSize);
+int32_t LnnAddLinkQualitySample(const LnnLinkQualitySample *sample);
+int32_t LnnGetLinkScore(const char *networkId, LaneLinkType linkType);
 
 #ifdef __cplusplus
 }
@@ -49,6 +49,7 @@ int32_t GetTransReqInfoByLaneReqId(uint32_t laneReqId, TransReqInfo *reqInfo);
 int32_t PostDelayDestroyMessage(uint32_t laneReqId, uint64_t laneId, uint64_t delayMillis);
 int32_t PostDetectTimeoutMessage(uint32_t detectId, uint64_t delayMillis);
 void RemoveDetectTimeoutMessage(uint32_t detectId);
+int32_t PostDetectEvidenceMessage(uint32_t detectId);
 int32_t PostLaneStateChangeMessage(LaneState state, const char *peerUdid, const LaneLinkInfo *laneLinkInfo);
 int32_t PostNotifyFreeLaneResult(uint32_t laneReqId, int32_t errCode, uint64_t delayMillis);
 void RemoveDelayDestroyMessage(uint64_t laneId);
@@ -20,15 +20,22 @@
 #include "bus_center_manager.h"
 #include "lnn_lane_dfx.h"
 #include "lnn_lane_link.h"
+#include "lnn_lane_score.h"
 #include "lnn_log.h"
 #include "lnn_trans_lane.h"
 #include "softbus_adapter_mem.h"
 #include "softbus_base_listener.h"
 #include "softbus_conn_interface.h"
 #include "softbus_error_code.h"
+#include "softbus_feature_config.h"
 #include "softbus_socket.h"
+#include "trans_network_statistics.h"
 
 #define WLAN_DETECT_TIMEOUT 3000
+#define LNN_DETECT_LOSS_PERMILLE 1000
+#define DEFAULT_DETECT_EVIDENCE_TIME 5000
+#define DEFAULT_DETECT_LIVE_LINK_TIME 30000
+#define MAX_DETECT_EVIDENCE_NUM 32
 
 typedef struct {
     uint32_t laneReqId;
@@ -40,9 +47,18 @@ typedef struct {
     LaneLinkInfo link;
     ListNode node;
     LaneLinkCb cb;
+    bool isByEvidence;
 } LaneDetectInfo;
 
+typedef struct {
+    char addr[MAX_SOCKET_ADDR_LEN];
+    int32_t port;
+    uint64_t succTime;
+    ListNode node;
+} LaneDetectEvidence;
+
 static SoftBusList g_laneDetectList;
+static SoftBusList g_detectEvidenceList;
 
 static int32_t GetSameLaneDetectInfo(LaneDetectInfo *infoItem)
 {
@@ -52,6 +68,9 @@ static int32_t GetSameLaneDetectInfo(LaneDetectInfo *infoItem)
     LaneDetectInfo *item = NULL;
     LaneDetectInfo *next = NULL;
     LIST_FOR_EACH_ENTRY_SAFE(item, next, &g_laneDetectList.list, LaneDetectInfo, node) {
+        if (item->isByEvidence) {
+            continue;
+        }
         switch (infoItem->link.type) {
             case LANE_WLAN_2P4G:
             case LANE_WLAN_5G:
@@ -281,6 +300,26 @@ static void UpdateLaneEventWithDetectInfo(uint32_t laneReqId, uint64_t startTime
     }
 }
 
+static void ReportWlanDetectSample(const LaneDetectInfo *item, bool isSuccess)
+{
+    LnnLinkQualitySample sample;
+    (void)memset_s(&sample, sizeof(LnnLinkQualitySample), 0, sizeof(LnnLinkQualitySample));
+    if (strcpy_s(sample.peerUdid, UDID_BUF_LEN, item->link.peerUdid) != EOK) {
+        LNN_LOGE(LNN_LANE, "copy peerUdid fail");
+        return;
+    }
+    sample.linkType = item->link.type;
+    sample.channelId = item->link.linkInfo.wlan.channel;
+    sample.sampleMask = LNN_QUALITY_SAMPLE_LOSS;
+    sample.lossPermille = isSuccess ? 0 : LNN_DETECT_LOSS_PERMILLE;
+    if (isSuccess) {
+        /* tcp connect completes after one round trip, so the detect time bounds the rtt */
+        sample.sampleMask |= LNN_QUALITY_SAMPLE_RTT;
+        sample.rttMs = (uint32_t)GetDetectTime(item->laneDetectTime);
+    }
+    (void)LnnAddLinkQualitySample(&sample);
+}
+
 static int32_t NotifyWlanDetectResult(LaneDetectInfo *requestItem, bool isSendSuc)
 {
     ListNode detectInfoList;
@@ -292,6 +331,12 @@ static int32_t NotifyWlanDetectResult(LaneDetectInfo *requestItem, bool isSendSu
     }
     LaneDetectInfo *item = NULL;
     LaneDetectInfo *next = NULL;
+    LIST_FOR_EACH_ENTRY(item, &detectInfoList, LaneDetectInfo, node) {
+        if (item->laneDetectTime != 0 && !item->isByEvidence) {
+            ReportWlanDetectSample(item, isSendSuc);
+            break;
+        }
+    }
     LIST_FOR_EACH_ENTRY_SAFE(item, next, &detectInfoList, LaneDetectInfo, node) {
         UpdateLaneEventWithDetectInfo(item->laneReqId, item->laneDetectTime, isSendSuc);
         if (!isSendSuc) {
@@ -317,6 +362,175 @@ static int32_t NotifyWlanDetectResult(LaneDetectInfo *requestItem, bool isSendSu
     return SOFTBUS_OK;
 }
 
+static bool IsSameDetectAddr(const LaneDetectEvidence *evidence, const LaneLinkInfo *link)
+{
+    return strncmp(evidence->addr, link->linkInfo.wlan.connInfo.addr, MAX_SOCKET_ADDR_LEN) == 0 &&
+        evidence->port == link->linkInfo.wlan.connInfo.port;
+}
+
+static void DeleteOldestDetectEvidence(void)
+{
+    LaneDetectEvidence *item = NULL;
+    LaneDetectEvidence *oldest = NULL;
+    LIST_FOR_EACH_ENTRY(item, &g_detectEvidenceList.list, LaneDetectEvidence, node) {
+        if (oldest == NULL || item->succTime < oldest->succTime) {
+            oldest = item;
+        }
+    }
+    if (oldest != NULL) {
+        ListDelete(&oldest->node);
+        g_detectEvidenceList.cnt--;
+        SoftBusFree(oldest);
+    }
+}
+
+static void RecordDetectEvidence(const LaneLinkInfo *link)
+{
+    if (link->linkInfo.wlan.connInfo.addr[0] == '\0') {
+        return;
+    }
+    uint64_t now = SoftBusGetSysTimeMs();
+    if (SoftBusMutexLock(&g_detectEvidenceList.lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "lock fail");
+        return;
+    }
+    LaneDetectEvidence *item = NULL;
+    LIST_FOR_EACH_ENTRY(item, &g_detectEvidenceList.list, LaneDetectEvidence, node) {
+        if (IsSameDetectAddr(item, link)) {
+            item->succTime = now;
+            SoftBusMutexUnlock(&g_detectEvidenceList.lock);
+            return;
+        }
+    }
+    if (g_detectEvidenceList.cnt >= MAX_DETECT_EVIDENCE_NUM) {
+        DeleteOldestDetectEvidence();
+    }
+    item = (LaneDetectEvidence *)SoftBusCalloc(sizeof(LaneDetectEvidence));
+    if (item == NULL) {
+        SoftBusMutexUnlock(&g_detectEvidenceList.lock);
+        return;
+    }
+    if (strcpy_s(item->addr, MAX_SOCKET_ADDR_LEN, link->linkInfo.wlan.connInfo.addr) != EOK) {
+        SoftBusMutexUnlock(&g_detectEvidenceList.lock);
+        SoftBusFree(item);
+        return;
+    }
+    item->port = link->linkInfo.wlan.connInfo.port;
+    item->succTime = now;
+    ListTailInsert(&g_detectEvidenceList.list, &item->node);
+    g_detectEvidenceList.cnt++;
+    SoftBusMutexUnlock(&g_detectEvidenceList.lock);
+}
+
+static uint64_t GetDetectEvidenceTime(const LaneLinkInfo *link)
+{
+    if (SoftBusMutexLock(&g_detectEvidenceList.lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "lock fail");
+        return 0;
+    }
+    uint64_t succTime = 0;
+    LaneDetectEvidence *item = NULL;
+    LIST_FOR_EACH_ENTRY(item, &g_detectEvidenceList.list, LaneDetectEvidence, node) {
+        if (IsSameDetectAddr(item, link)) {
+            succTime = item->succTime;
+            break;
+        }
+    }
+    SoftBusMutexUnlock(&g_detectEvidenceList.lock);
+    return succTime;
+}
+
+static uint32_t GetDetectFreshTime(ConfigType type, uint32_t defaultTime)
+{
+    uint32_t freshTime = 0;
+    if (SoftbusGetConfig(type, (unsigned char *)&freshTime, sizeof(freshTime)) != SOFTBUS_OK) {
+        LNN_LOGW(LNN_LANE, "get detect fresh time fail, type=%{public}d", type);
+        return defaultTime;
+    }
+    return freshTime;
+}
+
+static bool IsLaneInUse(const LaneLinkInfo *link)
+{
+    LaneResource resource;
+    (void)memset_s(&resource, sizeof(LaneResource), 0, sizeof(LaneResource));
+    if (FindLaneResourceByLinkAddr(link, &resource) != SOFTBUS_OK) {
+        return false;
+    }
+    return resource.clientRef > 0;
+}
+
+/*
+ * A recent successful probe or transfer to the same address proves reachability on its own. A lane that is
+ * still in use over the same address extends the trust window, since its traffic would have broken otherwise.
+ */
+static bool IsWlanDetectEvidenceFresh(const LaneLinkInfo *link)
+{
+    uint64_t succTime = GetDetectEvidenceTime(link);
+    if (succTime == 0) {
+        return false;
+    }
+    uint64_t elapsed = GetDetectTime(succTime);
+    if (elapsed < GetDetectFreshTime(SOFTBUS_INT_LANE_DETECT_EVIDENCE_TIME, DEFAULT_DETECT_EVIDENCE_TIME)) {
+        return true;
+    }
+    if (elapsed >= GetDetectFreshTime(SOFTBUS_INT_LANE_DETECT_LIVE_LINK_TIME, DEFAULT_DETECT_LIVE_LINK_TIME)) {
+        return false;
+    }
+    return IsLaneInUse(link);
+}
+
+static void OnTransferStatistics(uint64_t laneId, int32_t laneLinkType, int64_t traffic, int64_t duration)
+{
+    (void)duration;
+    if (traffic <= 0 || (laneLinkType != LANE_WLAN_2P4G && laneLinkType != LANE_WLAN_5G)) {
+        return;
+    }
+    LaneResource resource;
+    (void)memset_s(&resource, sizeof(LaneResource), 0, sizeof(LaneResource));
+    if (FindLaneResourceByLaneId(laneId, &resource) != SOFTBUS_OK) {
+        return;
+    }
+    RecordDetectEvidence(&resource.link);
+}
+
+static int32_t NotifyDetectSuccessByEvidence(uint32_t laneReqId, const LaneLinkInfo *linkInfo,
+    const LaneLinkCb *callback)
+{
+    LaneDetectInfo *infoItem = (LaneDetectInfo *)SoftBusCalloc(sizeof(LaneDetectInfo));
+    if (infoItem == NULL) {
+        return SOFTBUS_MALLOC_ERR;
+    }
+    infoItem->laneReqId = laneReqId;
+    if (memcpy_s(&infoItem->cb, sizeof(LaneLinkCb), callback, sizeof(LaneLinkCb)) != EOK ||
+        memcpy_s(&(infoItem->link), sizeof(LaneLinkInfo), linkInfo, sizeof(LaneLinkInfo)) != EOK) {
+        LNN_LOGE(LNN_LANE, "memcpy linkinfo failed, laneReqId=%{public}u", laneReqId);
+        SoftBusFree(infoItem);
+        return SOFTBUS_MEM_ERR;
+    }
+    infoItem->connId.wlanFd = (uint32_t)SOFTBUS_INVALID_FD;
+    infoItem->isByEvidence = true;
+    infoItem->laneDetectTime = SoftBusGetSysTimeMs();
+    if (SoftBusMutexLock(&g_laneDetectList.lock) != SOFTBUS_OK) {
+        SoftBusFree(infoItem);
+        return SOFTBUS_LOCK_ERR;
+    }
+    uint32_t detectId = GetLaneDetectIdWithoutLock();
+    infoItem->laneDetectId = detectId;
+    ListTailInsert(&g_laneDetectList.list, &infoItem->node);
+    SoftBusMutexUnlock(&g_laneDetectList.lock);
+    /* the result goes through the lane looper like a probe result, never back into the caller's stack */
+    int32_t ret = PostDetectEvidenceMessage(detectId);
+    if (ret != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "post detect evidence message fail, laneReqId=%{public}u", laneReqId);
+        DelLaneDetectInfo(detectId);
+        return ret;
+    }
+    LNN_LOGI(LNN_LANE, "wlan detect skipped by fresh evidence, detectId=%{public}u, laneReqId=%{public}u",
+        detectId, laneReqId);
+    return SOFTBUS_OK;
+}
+
 static int32_t LaneDetectOnDataEvent(ListenerModule module, int32_t events, int32_t fd)
 {
     if (module != LANE) {
@@ -331,14 +545,18 @@ static int32_t LaneDetectOnDataEvent(ListenerModule module, int32_t events, int3
             ConnShutdownSocket(fd);
             return SOFTBUS_LANE_NOT_FOUND;
         }
-        LNN_LOGI(LNN_LANE, "wlan connect success, detectId=%{public}u, fd=%{public}d", requestItem.laneDetectId, fd);
         (void)DelTrigger(LANE, fd, WRITE_TRIGGER);
-        char buf[] = "lanedetect";
-        ssize_t len = ConnSendSocketData(fd, buf, sizeof(buf), 0);
-        bool isSendSuc = (len == sizeof(buf)) ? true : false;
+        /* a writable socket without pending error means the handshake completed, no payload is needed */
+        int32_t sockErr = ConnGetSocketError(fd);
+        bool isConnSuc = (sockErr == SOFTBUS_OK);
+        LNN_LOGI(LNN_LANE, "wlan connect result, detectId=%{public}u, fd=%{public}d, sockErr=%{public}d",
+            requestItem.laneDetectId, fd, sockErr);
         ConnShutdownSocket(fd);
         RemoveDetectTimeoutMessage(requestItem.laneDetectId);
-        int32_t ret = NotifyWlanDetectResult(&requestItem, isSendSuc);
+        if (isConnSuc) {
+            RecordDetectEvidence(&requestItem.link);
+        }
+        int32_t ret = NotifyWlanDetectResult(&requestItem, isConnSuc);
         if (ret != SOFTBUS_OK) {
             LNN_LOGE(LNN_LANE, "wlan notify detect result fail, detectId=%{public}u", requestItem.laneDetectId);
             return ret;
@@ -363,6 +581,10 @@ int32_t LaneDetectReliability(uint32_t laneReqId, const LaneLinkInfo *linkInfo,
     switch (linkInfo->type) {
         case LANE_WLAN_2P4G:
         case LANE_WLAN_5G:
+            if (IsWlanDetectEvidenceFresh(linkInfo)) {
+                result = NotifyDetectSuccessByEvidence(laneReqId, linkInfo, callback);
+                break;
+            }
             result = WlanDetectReliability(laneReqId, linkInfo, callback);
             break;
         default:
@@ -384,6 +606,12 @@ void NotifyDetectTimeout(uint32_t detectId)
     }
     LaneDetectInfo *item = NULL;
     LaneDetectInfo *next = NULL;
+    LIST_FOR_EACH_ENTRY(item, &detectInfoList, LaneDetectInfo, node) {
+        if (item->laneDetectTime != 0) {
+            ReportWlanDetectSample(item, false);
+            break;
+        }
+    }
     LIST_FOR_EACH_ENTRY_SAFE(item, next, &detectInfoList, LaneDetectInfo, node) {
         LNN_LOGI(LNN_LANE, "detect timeout, link=%{public}d, laneReqId=%{public}u, detectId=%{public}u",
             item->link.type, item->laneReqId, item->laneDetectId);
@@ -393,6 +621,16 @@ void NotifyDetectTimeout(uint32_t detectId)
     }
 }
 
+void NotifyDetectEvidence(uint32_t detectId)
+{
+    LaneDetectInfo requestItem;
+    (void)memset_s(&requestItem, sizeof(LaneDetectInfo), 0, sizeof(LaneDetectInfo));
+    requestItem.laneDetectId = detectId;
+    if (NotifyWlanDetectResult(&requestItem, true) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "notify detect evidence fail, detectId=%{public}u", detectId);
+    }
+}
+
 int32_t InitLaneReliability(void)
 {
     SoftbusBaseListener listener = {
@@ -409,6 +647,15 @@ int32_t InitLaneReliability(void)
     }
     ListInit(&g_laneDetectList.list);
     g_laneDetectList.cnt = 0;
+    if (SoftBusMutexInit(&g_detectEvidenceList.lock, NULL) != SOFTBUS_OK) {
+        (void)SoftBusMutexDestroy(&g_laneDetectList.lock);
+        return SOFTBUS_NO_INIT;
+    }
+    ListInit(&g_detectEvidenceList.list);
+    g_detectEvidenceList.cnt = 0;
+    if (RegisterNetworkStatisticsListener(OnTransferStatistics) != SOFTBUS_OK) {
+        LNN_LOGW(LNN_LANE, "register transfer statistics listener fail");
+    }
     return SOFTBUS_OK;
 }
 
@@ -426,4 +673,17 @@ void DeinitLaneReliability(void)
     g_laneDetectList.cnt = 0;
     SoftBusMutexUnlock(&g_laneDetectList.lock);
     (void)SoftBusMutexDestroy(&g_laneDetectList.lock);
+    UnregisterNetworkStatisticsListener(OnTransferStatistics);
+    if (SoftBusMutexLock(&g_detectEvidenceList.lock) != SOFTBUS_OK) {
+        return;
+    }
+    LaneDetectEvidence *evidence = NULL;
+    LaneDetectEvidence *nextEvidence = NULL;
+    LIST_FOR_EACH_ENTRY_SAFE(evidence, nextEvidence, &g_detectEvidenceList.list, LaneDetectEvidence, node) {
+        ListDelete(&evidence->node);
+        SoftBusFree(evidence);
+    }
+    g_detectEvidenceList.cnt = 0;
+    SoftBusMutexUnlock(&g_detectEvidenceList.lock);
+    (void)SoftBusMutexDestroy(&g_detectEvidenceList.lock);
 }
\ No newline at end of file
@@ -0,0 +1,591 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "lnn_lane_score.h"
+
+#include <securec.h>
+
+#include "bus_center_manager.h"
+#include "common_list.h"
+#include "lnn_async_callback_utils.h"
+#include "lnn_lane_link.h"
+#include "lnn_log.h"
+#include "message_handler.h"
+#include "softbus_adapter_mem.h"
+#include "softbus_adapter_thread.h"
+#include "softbus_adapter_timer.h"
+#include "softbus_error_code.h"
+#include "softbus_network_utils.h"
+#include "softbus_utils.h"
+#include "softbus_wifi_api_adapter.h"
+#include "trans_network_statistics.h"
+
+#define LINK_SCORE_DEFAULT 60
+#define LINK_SCORE_MIN 1
+#define CHANNEL_SCORE_TABLE_LEN CHAN_5G_LIST_LEN
+#define MAX_LINK_SCORE_NUM 64
+
+#define SCORE_HALF_LIFE_MS (60 * 1000)
+#define SCORE_EXPIRE_MS (30 * 60 * 1000)
+#define SCORE_MAX_DECAY_SHIFT 8
+#define EWMA_WEIGHT_BASE 16
+#define EWMA_OLD_WEIGHT 12
+
+#define RTT_GOOD_MS 20
+#define RTT_BAD_MS 400
+#define LOSS_BAD_PERMILLE 200
+#define PERMILLE 1000
+#define RTT_WEIGHT 40
+#define THROUGHPUT_WEIGHT 30
+#define LOSS_WEIGHT 30
+
+#define MIN_STATISTICS_TRAFFIC (512 * 1024)
+#define MIN_STATISTICS_DURATION 1000
+#define BITS_PER_BYTE 8
+#define DEFAULT_REF_THROUGHPUT_KBPS 10000
+#define SECOND_TO_MSEC 1000
+
+typedef struct {
+    uint32_t rttMs;
+    uint32_t throughputKbps;
+    uint32_t lossPermille;
+    uint32_t sampleMask;
+    uint32_t sampleCnt;
+    uint64_t updateTime;
+} QualityStat;
+
+typedef struct {
+    ListNode node;
+    char peerUdid[UDID_BUF_LEN];
+    LaneLinkType linkType;
+    QualityStat stat;
+} LinkScoreItem;
+
+/* throughput at which a link type is considered fully healthy */
+static const uint32_t g_refThroughputKbps[LANE_LINK_TYPE_BUTT] = {
+    [LANE_BR] = 2000,
+    [LANE_BLE] = 1000,
+    [LANE_P2P] = 160000,
+    [LANE_HML] = 400000,
+    [LANE_WLAN_2P4G] = 80000,
+    [LANE_WLAN_5G] = 300000,
+    [LANE_ETH] = 500000,
+    [LANE_P2P_REUSE] = 160000,
+    [LANE_BLE_DIRECT] = 1000,
+    [LANE_COC] = 1000,
+    [LANE_COC_DIRECT] = 1000,
+    [LANE_USB] = 500000,
+};
+
+static SoftBusList g_linkScoreList;
+static QualityStat g_channelStat[CHANNEL_SCORE_TABLE_LEN];
+static bool g_isScoreInit = false;
+/* scoring state is guarded by the score lock, timers run on the default looper */
+static bool g_isScoring = false;
+static uint32_t g_scoringGen = 0;
+static uint64_t g_scoringIntervalMs = 0;
+
+static int32_t ScoreLock(void)
+{
+    return SoftBusMutexLock(&g_linkScoreList.lock);
+}
+
+static void ScoreUnlock(void)
+{
+    (void)SoftBusMutexUnlock(&g_linkScoreList.lock);
+}
+
+static bool IsChannelValid(int32_t channelId)
+{
+    return channelId > 0 && channelId < CHANNEL_SCORE_TABLE_LEN;
+}
+
+static bool IsChannelLinkType(LaneLinkType linkType)
+{
+    return linkType == LANE_WLAN_2P4G || linkType == LANE_WLAN_5G || linkType == LANE_P2P ||
+        linkType == LANE_HML || linkType == LANE_P2P_REUSE;
+}
+
+static uint32_t GetRefThroughput(LaneLinkType linkType)
+{
+    if (linkType < 0 || linkType >= LANE_LINK_TYPE_BUTT || g_refThroughputKbps[linkType] == 0) {
+        return DEFAULT_REF_THROUGHPUT_KBPS;
+    }
+    return g_refThroughputKbps[linkType];
+}
+
+static uint64_t GetElapsedTime(uint64_t updateTime, uint64_t now)
+{
+    return (now > updateTime) ? (now - updateTime) : 0;
+}
+
+static uint32_t GetDecayShift(uint64_t updateTime, uint64_t now)
+{
+    uint64_t shift = GetElapsedTime(updateTime, now) / SCORE_HALF_LIFE_MS;
+    return shift > SCORE_MAX_DECAY_SHIFT ? SCORE_MAX_DECAY_SHIFT : (uint32_t)shift;
+}
+
+/* the weight of history halves for every half-life elapsed since the last sample */
+static uint32_t UpdateEwma(uint32_t oldValue, uint32_t sample, uint32_t decayShift, bool isFirst)
+{
+    if (isFirst) {
+        return sample;
+    }
+    uint64_t oldWeight = EWMA_OLD_WEIGHT >> decayShift;
+    uint64_t value = ((uint64_t)oldValue * oldWeight + (uint64_t)sample * (EWMA_WEIGHT_BASE - oldWeight)) /
+        EWMA_WEIGHT_BASE;
+    return (uint32_t)value;
+}
+
+static void UpdateQualityStat(QualityStat *stat, const LnnLinkQualitySample *sample, uint64_t now)
+{
+    uint32_t shift = GetDecayShift(stat->updateTime, now);
+    if ((sample->sampleMask & LNN_QUALITY_SAMPLE_RTT) != 0) {
+        stat->rttMs = UpdateEwma(stat->rttMs, sample->rttMs, shift,
+            (stat->sampleMask & LNN_QUALITY_SAMPLE_RTT) == 0);
+    }
+    if ((sample->sampleMask & LNN_QUALITY_SAMPLE_THROUGHPUT) != 0) {
+        stat->throughputKbps = UpdateEwma(stat->throughputKbps, sample->throughputKbps, shift,
+            (stat->sampleMask & LNN_QUALITY_SAMPLE_THROUGHPUT) == 0);
+    }
+    if ((sample->sampleMask & LNN_QUALITY_SAMPLE_LOSS) != 0) {
+        uint32_t loss = sample->lossPermille > PERMILLE ? PERMILLE : sample->lossPermille;
+        stat->lossPermille = UpdateEwma(stat->lossPermille, loss, shift,
+            (stat->sampleMask & LNN_QUALITY_SAMPLE_LOSS) == 0);
+    }
+    stat->sampleMask |= sample->sampleMask;
+    stat->sampleCnt++;
+    stat->updateTime = now;
+}
+
+static int32_t GetRttScore(uint32_t rttMs)
+{
+    if (rttMs <= RTT_GOOD_MS) {
+        return LNN_LINK_SCORE_MAX;
+    }
+    if (rttMs >= RTT_BAD_MS) {
+        return 0;
+    }
+    return (int32_t)((RTT_BAD_MS - rttMs) * LNN_LINK_SCORE_MAX / (RTT_BAD_MS - RTT_GOOD_MS));
+}
+
+static int32_t GetThroughputScore(uint32_t throughputKbps, LaneLinkType linkType)
+{
+    uint64_t score = (uint64_t)throughputKbps * LNN_LINK_SCORE_MAX / GetRefThroughput(linkType);
+    return score > LNN_LINK_SCORE_MAX ? LNN_LINK_SCORE_MAX : (int32_t)score;
+}
+
+static int32_t GetLossScore(uint32_t lossPermille)
+{
+    if (lossPermille >= LOSS_BAD_PERMILLE) {
+        return 0;
+    }
+    return (int32_t)((LOSS_BAD_PERMILLE - lossPermille) * LNN_LINK_SCORE_MAX / LOSS_BAD_PERMILLE);
+}
+
+static int32_t CalcQualityScore(const QualityStat *stat, LaneLinkType linkType, uint64_t now)
+{
+    if (stat->sampleCnt == 0 || GetElapsedTime(stat->updateTime, now) >= SCORE_EXPIRE_MS) {
+        return LNN_LINK_SCORE_UNKNOWN;
+    }
+    int32_t weightSum = 0;
+    int32_t scoreSum = 0;
+    if ((stat->sampleMask & LNN_QUALITY_SAMPLE_RTT) != 0) {
+        scoreSum += GetRttScore(stat->rttMs) * RTT_WEIGHT;
+        weightSum += RTT_WEIGHT;
+    }
+    if ((stat->sampleMask & LNN_QUALITY_SAMPLE_THROUGHPUT) != 0) {
+        scoreSum += GetThroughputScore(stat->throughputKbps, linkType) * THROUGHPUT_WEIGHT;
+        weightSum += THROUGHPUT_WEIGHT;
+    }
+    if ((stat->sampleMask & LNN_QUALITY_SAMPLE_LOSS) != 0) {
+        scoreSum += GetLossScore(stat->lossPermille) * LOSS_WEIGHT;
+        weightSum += LOSS_WEIGHT;
+    }
+    if (weightSum == 0) {
+        return LNN_LINK_SCORE_UNKNOWN;
+    }
+    /* old measurements fade towards the default score instead of being trusted forever */
+    int32_t raw = scoreSum / weightSum;
+    int32_t score = LINK_SCORE_DEFAULT + (raw - LINK_SCORE_DEFAULT) / (1 << GetDecayShift(stat->updateTime, now));
+    return score < LINK_SCORE_MIN ? LINK_SCORE_MIN : score;
+}
+
+static LinkScoreItem *FindLinkScoreItem(const char *peerUdid, LaneLinkType linkType)
+{
+    LinkScoreItem *item = NULL;
+    LIST_FOR_EACH_ENTRY(item, &g_linkScoreList.list, LinkScoreItem, node) {
+        if (item->linkType == linkType && strcmp(item->peerUdid, peerUdid) == 0) {
+            return item;
+        }
+    }
+    return NULL;
+}
+
+static void DeleteOldestLinkScoreItem(void)
+{
+    LinkScoreItem *item = NULL;
+    LinkScoreItem *oldest = NULL;
+    LIST_FOR_EACH_ENTRY(item, &g_linkScoreList.list, LinkScoreItem, node) {
+        if (oldest == NULL || item->stat.updateTime < oldest->stat.updateTime) {
+            oldest = item;
+        }
+    }
+    if (oldest == NULL) {
+        return;
+    }
+    ListDelete(&oldest->node);
+    g_linkScoreList.cnt--;
+    SoftBusFree(oldest);
+}
+
+static LinkScoreItem *GetOrCreateLinkScoreItem(const char *peerUdid, LaneLinkType linkType)
+{
+    LinkScoreItem *item = FindLinkScoreItem(peerUdid, linkType);
+    if (item != NULL) {
+        return item;
+    }
+    if (g_linkScoreList.cnt >= MAX_LINK_SCORE_NUM) {
+        DeleteOldestLinkScoreItem();
+    }
+    item = (LinkScoreItem *)SoftBusCalloc(sizeof(LinkScoreItem));
+    if (item == NULL) {
+        LNN_LOGE(LNN_LANE, "calloc link score item fail");
+        return NULL;
+    }
+    if (strcpy_s(item->peerUdid, UDID_BUF_LEN, peerUdid) != EOK) {
+        LNN_LOGE(LNN_LANE, "copy peerUdid fail");
+        SoftBusFree(item);
+        return NULL;
+    }
+    item->linkType = linkType;
+    ListTailInsert(&g_linkScoreList.list, &item->node);
+    g_linkScoreList.cnt++;
+    return item;
+}
+
+int32_t LnnAddLinkQualitySample(const LnnLinkQualitySample *sample)
+{
+    if (sample == NULL || sample->linkType < 0 || sample->linkType >= LANE_LINK_TYPE_BUTT ||
+        (sample->sampleMask & (LNN_QUALITY_SAMPLE_RTT | LNN_QUALITY_SAMPLE_THROUGHPUT |
+        LNN_QUALITY_SAMPLE_LOSS)) == 0) {
+        LNN_LOGE(LNN_LANE, "invalid param");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    if (!g_isScoreInit) {
+        return SOFTBUS_NO_INIT;
+    }
+    uint64_t now = (sample->timestamp != 0) ? sample->timestamp : SoftBusGetSysTimeMs();
+    if (ScoreLock() != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "lock fail");
+        return SOFTBUS_LOCK_ERR;
+    }
+    if (IsChannelValid(sample->channelId) && IsChannelLinkType(sample->linkType)) {
+        UpdateQualityStat(&g_channelStat[sample->channelId], sample, now);
+    }
+    if (sample->peerUdid[0] != '\0') {
+        LinkScoreItem *item = GetOrCreateLinkScoreItem(sample->peerUdid, sample->linkType);
+        if (item == NULL) {
+            ScoreUnlock();
+            return SOFTBUS_MALLOC_ERR;
+        }
+        UpdateQualityStat(&item->stat, sample, now);
+    }
+    ScoreUnlock();
+    return SOFTBUS_OK;
+}
+
+int32_t LnnGetLinkScore(const char *networkId, LaneLinkType linkType)
+{
+    if (networkId == NULL || linkType < 0 || linkType >= LANE_LINK_TYPE_BUTT) {
+        LNN_LOGE(LNN_LANE, "invalid param");
+        return LNN_LINK_SCORE_UNKNOWN;
+    }
+    if (!g_isScoreInit) {
+        return LNN_LINK_SCORE_UNKNOWN;
+    }
+    char peerUdid[UDID_BUF_LEN] = {0};
+    if (LnnGetRemoteStrInfo(networkId, STRING_KEY_DEV_UDID, peerUdid, UDID_BUF_LEN) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "get peer udid fail");
+        return LNN_LINK_SCORE_UNKNOWN;
+    }
+    uint64_t now = SoftBusGetSysTimeMs();
+    if (ScoreLock() != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "lock fail");
+        return LNN_LINK_SCORE_UNKNOWN;
+    }
+    int32_t score = LNN_LINK_SCORE_UNKNOWN;
+    LinkScoreItem *item = FindLinkScoreItem(peerUdid, linkType);
+    if (item != NULL) {
+        score = CalcQualityScore(&item->stat, linkType, now);
+    }
+    ScoreUnlock();
+    return score;
+}
+
+static LaneLinkType GetChannelLinkType(int32_t channelId)
+{
+    return SoftBusIs2GBand(SoftBusChannelToFrequency(channelId)) ? LANE_WLAN_2P4G : LANE_WLAN_5G;
+}
+
+int32_t LnnGetCurrChannelScore(int32_t channelId)
+{
+    if (!IsChannelValid(channelId) || !g_isScoreInit) {
+        return LINK_SCORE_DEFAULT;
+    }
+    LaneLinkType linkType = GetChannelLinkType(channelId);
+    uint64_t now = SoftBusGetSysTimeMs();
+    if (ScoreLock() != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "lock fail");
+        return LINK_SCORE_DEFAULT;
+    }
+    int32_t score = CalcQualityScore(&g_channelStat[channelId], linkType, now);
+    ScoreUnlock();
+    return (score == LNN_LINK_SCORE_UNKNOWN) ? LINK_SCORE_DEFAULT : score;
+}
+
+/* caller owns *scoreList and releases it with SoftBusFree */
+int32_t LnnGetAllChannelScore(LnnChannelScore **scoreList, uint32_t *listSize)
+{
+    if (scoreList == NULL || listSize == NULL) {
+        LNN_LOGE(LNN_LANE, "invalid param");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    *scoreList = NULL;
+    *listSize = 0;
+    if (!g_isScoreInit) {
+        return SOFTBUS_OK;
+    }
+    LnnChannelScore *list = (LnnChannelScore *)SoftBusCalloc(sizeof(LnnChannelScore) * CHANNEL_SCORE_TABLE_LEN);
+    if (list == NULL) {
+        LNN_LOGE(LNN_LANE, "calloc channel score list fail");
+        return SOFTBUS_MALLOC_ERR;
+    }
+    uint64_t now = SoftBusGetSysTimeMs();
+    if (ScoreLock() != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "lock fail");
+        SoftBusFree(list);
+        return SOFTBUS_LOCK_ERR;
+    }
+    uint32_t num = 0;
+    for (int32_t channel = 1; channel < CHANNEL_SCORE_TABLE_LEN; channel++) {
+        int32_t score = CalcQualityScore(&g_channelStat[channel], GetChannelLinkType(channel), now);
+        if (score == LNN_LINK_SCORE_UNKNOWN) {
+            continue;
+        }
+        list[num].channelId = channel;
+        list[num].score = score;
+        num++;
+    }
+    ScoreUnlock();
+    if (num == 0) {
+        SoftBusFree(list);
+        return SOFTBUS_OK;
+    }
+    *scoreList = list;
+    *listSize = num;
+    return SOFTBUS_OK;
+}
+
+int32_t LnnGetWlanLinkedInfo(LnnWlanLinkedInfo *info)
+{
+    if (info == NULL) {
+        LNN_LOGE(LNN_LANE, "invalid param");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    SoftBusWifiLinkedInfo linkedInfo;
+    (void)memset_s(&linkedInfo, sizeof(SoftBusWifiLinkedInfo), 0, sizeof(SoftBusWifiLinkedInfo));
+    int32_t ret = SoftBusGetLinkedInfo(&linkedInfo);
+    if (ret != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "get wifi linked info fail, ret=%{public}d", ret);
+        return SOFTBUS_LANE_SELECT_FAIL;
+    }
+    info->frequency = linkedInfo.frequency;
+    info->band = linkedInfo.band;
+    info->isConnected = (linkedInfo.connState == SOFTBUS_API_WIFI_CONNECTED);
+    return SOFTBUS_OK;
+}
+
+static void OnNetworkStatistics(uint64_t laneId, int32_t laneLinkType, int64_t traffic, int64_t duration)
+{
+    /* short or idle channels say nothing about link capacity */
+    if (traffic < MIN_STATISTICS_TRAFFIC || duration < MIN_STATISTICS_DURATION) {
+        return;
+    }
+    LaneResource resource;
+    (void)memset_s(&resource, sizeof(LaneResource), 0, sizeof(LaneResource));
+    if (FindLaneResourceByLaneId(laneId, &resource) != SOFTBUS_OK) {
+        LNN_LOGD(LNN_LANE, "lane resource not found, laneId=%{public}" PRIu64, laneId);
+        return;
+    }
+    LnnLinkQualitySample sample;
+    (void)memset_s(&sample, sizeof(LnnLinkQualitySample), 0, sizeof(LnnLinkQualitySample));
+    if (strcpy_s(sample.peerUdid, UDID_BUF_LEN, resource.link.peerUdid) != EOK) {
+        LNN_LOGE(LNN_LANE, "copy peerUdid fail");
+        return;
+    }
+    sample.linkType = (LaneLinkType)laneLinkType;
+    sample.channelId = (laneLinkType == LANE_P2P || laneLinkType == LANE_HML) ?
+        resource.link.linkInfo.p2p.channel : LNN_SCORE_INVALID_CHANNEL;
+    sample.sampleMask = LNN_QUALITY_SAMPLE_THROUGHPUT;
+    sample.throughputKbps = (uint32_t)((uint64_t)traffic * BITS_PER_BYTE / (uint64_t)duration);
+    (void)LnnAddLinkQualitySample(&sample);
+}
+
+static void ClearExpiredScore(uint64_t now)
+{
+    if (ScoreLock() != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "lock fail");
+        return;
+    }
+    LinkScoreItem *item = NULL;
+    LinkScoreItem *next = NULL;
+    LIST_FOR_EACH_ENTRY_SAFE(item, next, &g_linkScoreList.list, LinkScoreItem, node) {
+        if (GetElapsedTime(item->stat.updateTime, now) >= SCORE_EXPIRE_MS) {
+            ListDelete(&item->node);
+            g_linkScoreList.cnt--;
+            SoftBusFree(item);
+        }
+    }
+    for (int32_t channel = 0; channel < CHANNEL_SCORE_TABLE_LEN; channel++) {
+        if (g_channelStat[channel].sampleCnt != 0 &&
+            GetElapsedTime(g_channelStat[channel].updateTime, now) >= SCORE_EXPIRE_MS) {
+            (void)memset_s(&g_channelStat[channel], sizeof(QualityStat), 0, sizeof(QualityStat));
+        }
+    }
+    ScoreUnlock();
+}
+
+/* a timer of an older generation must not stop the scoring started after it */
+static void StopScoringGen(uint32_t gen)
+{
+    if (ScoreLock() != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "lock fail");
+        return;
+    }
+    if (gen == g_scoringGen) {
+        g_isScoring = false;
+    }
+    ScoreUnlock();
+}
+
+static void ScoringTimerProc(void *para)
+{
+    uint32_t gen = (uint32_t)(uintptr_t)para;
+    if (ScoreLock() != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "lock fail");
+        return;
+    }
+    bool isCurrent = g_isScoring && gen == g_scoringGen;
+    uint64_t intervalMs = g_scoringIntervalMs;
+    ScoreUnlock();
+    if (!isCurrent) {
+        return;
+    }
+    ClearExpiredScore(SoftBusGetSysTimeMs());
+    int32_t ret = LnnAsyncCallbackDelayHelper(GetLooper(LOOP_TYPE_DEFAULT), ScoringTimerProc,
+        (void *)(uintptr_t)gen, intervalMs);
+    if (ret != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "post scoring timer fail, ret=%{public}d", ret);
+        StopScoringGen(gen);
+    }
+}
+
+int32_t LnnStartScoring(int32_t interval)
+{
+    if (interval <= 0) {
+        LNN_LOGE(LNN_LANE, "invalid interval=%{public}d", interval);
+        return SOFTBUS_INVALID_PARAM;
+    }
+    if (!g_isScoreInit) {
+        return SOFTBUS_NO_INIT;
+    }
+    if (ScoreLock() != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "lock fail");
+        return SOFTBUS_LOCK_ERR;
+    }
+    uint64_t intervalMs = (uint64_t)interval * SECOND_TO_MSEC;
+    g_scoringIntervalMs = intervalMs;
+    uint32_t gen = ++g_scoringGen;
+    g_isScoring = true;
+    ScoreUnlock();
+    int32_t ret = LnnAsyncCallbackDelayHelper(GetLooper(LOOP_TYPE_DEFAULT), ScoringTimerProc,
+        (void *)(uintptr_t)gen, intervalMs);
+    if (ret != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "post scoring timer fail, ret=%{public}d", ret);
+        StopScoringGen(gen);
+        return ret;
+    }
+    LNN_LOGI(LNN_LANE, "start lane scoring, interval=%{public}d", interval);
+    return SOFTBUS_OK;
+}
+
+int32_t LnnStopScoring(void)
+{
+    if (!g_isScoreInit) {
+        return SOFTBUS_OK;
+    }
+    if (ScoreLock() != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "lock fail");
+        return SOFTBUS_LOCK_ERR;
+    }
+    g_isScoring = false;
+    g_scoringGen++;
+    ScoreUnlock();
+    return SOFTBUS_OK;
+}
+
+int32_t LnnInitScore(void)
+{
+    if (g_isScoreInit) {
+        return SOFTBUS_OK;
+    }
+    if (SoftBusMutexInit(&g_linkScoreList.lock, NULL) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "init score lock fail");
+        return SOFTBUS_NO_INIT;
+    }
+    ListInit(&g_linkScoreList.list);
+    g_linkScoreList.cnt = 0;
+    (void)memset_s(g_channelStat, sizeof(g_channelStat), 0, sizeof(g_channelStat));
+    g_isScoreInit = true;
+    if (RegisterNetworkStatisticsListener(OnNetworkStatistics) != SOFTBUS_OK) {
+        LNN_LOGW(LNN_LANE, "register network statistics listener fail");
+    }
+    LNN_LOGI(LNN_INIT, "init laneScore success");
+    return SOFTBUS_OK;
+}
+
+void LnnDeinitScore(void)
+{
+    if (!g_isScoreInit) {
+        return;
+    }
+    UnregisterNetworkStatisticsListener(OnNetworkStatistics);
+    (void)LnnStopScoring();
+    if (ScoreLock() != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "lock fail");
+        return;
+    }
+    g_isScoreInit = false;
+    LinkScoreItem *item = NULL;
+    LinkScoreItem *next = NULL;
+    LIST_FOR_EACH_ENTRY_SAFE(item, next, &g_linkScoreList.list, LinkScoreItem, node) {
+        ListDelete(&item->node);
+        SoftBusFree(item);
+    }
+    g_linkScoreList.cnt = 0;
+    ScoreUnlock();
+    (void)SoftBusMutexDestroy(&g_linkScoreList.lock);
+}
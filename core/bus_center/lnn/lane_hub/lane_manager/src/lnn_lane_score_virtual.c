@@ -58,4 +58,17 @@ int32_t LnnGetAllChannelScore(LnnChannelScore **scoreList, uint32_t *listSize)
     (void)scoreList;
     (void)listSize;
     return SOFTBUS_OK;
+}
+
+int32_t LnnAddLinkQualitySample(const LnnLinkQualitySample *sample)
+{
+    (void)sample;
+    return SOFTBUS_OK;
+}
+
+int32_t LnnGetLinkScore(const char *networkId, LaneLinkType linkType)
+{
+    (void)networkId;
+    (void)linkType;
+    return LNN_LINK_SCORE_UNKNOWN;
 }
\ No newline at end of file
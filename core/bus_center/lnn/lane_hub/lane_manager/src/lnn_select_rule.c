@@ -308,37 +308,47 @@ static int32_t CocDirectFeatureCheck(const char *networkId)
     return SOFTBUS_OK;
 }
 
+static int32_t GetPeerLinkScore(const char *networkId, LaneLinkType linkType)
+{
+    int32_t score = LnnGetLinkScore(networkId, linkType);
+    if (score <= LNN_LINK_SCORE_UNKNOWN) {
+        score = LNN_LINK_DEFAULT_SCORE;
+    }
+    return score;
+}
+
 static int32_t GetBrScore(const char *networkId, uint32_t expectedBw)
 {
-    (void)networkId;
     (void)expectedBw;
-    return LNN_LINK_DEFAULT_SCORE;
+    return GetPeerLinkScore(networkId, LANE_BR);
 }
 
 static int32_t GetBleScore(const char *networkId, uint32_t expectedBw)
 {
-    (void)networkId;
     (void)expectedBw;
-    return LNN_LINK_DEFAULT_SCORE;
+    return GetPeerLinkScore(networkId, LANE_BLE);
 }
 
 static int32_t GetP2pScore(const char *networkId, uint32_t expectedBw)
 {
-    (void)networkId;
     (void)expectedBw;
-    return LNN_LINK_DEFAULT_SCORE;
+    return GetPeerLinkScore(networkId, LANE_P2P);
 }
 
 static int32_t GetHmlScore(const char *networkId, uint32_t expectedBw)
 {
-    (void)networkId;
     (void)expectedBw;
-    return LNN_LINK_DEFAULT_SCORE;
+    return GetPeerLinkScore(networkId, LANE_HML);
 }
 
 static int32_t GetLinkedChannelScore(void)
 {
     int32_t channel = 0;
+    LnnWlanLinkedInfo info;
+    (void)memset_s(&info, sizeof(LnnWlanLinkedInfo), 0, sizeof(LnnWlanLinkedInfo));
+    if (LnnGetWlanLinkedInfo(&info) == SOFTBUS_OK && info.isConnected) {
+        channel = SoftBusFrequencyToChannel(info.frequency);
+    }
     int32_t score = LnnGetCurrChannelScore(channel);
     LNN_LOGI(LNN_LANE, "current channel=%{public}d, score=%{public}d", channel, score);
     if (score <= 0) {
@@ -347,18 +357,27 @@ static int32_t GetLinkedChannelScore(void)
     return score;
 }
 
+static int32_t GetWlanScore(const char *networkId, LaneLinkType linkType)
+{
+    int32_t channelScore = GetLinkedChannelScore();
+    int32_t linkScore = LnnGetLinkScore(networkId, linkType);
+    if (linkScore <= LNN_LINK_SCORE_UNKNOWN) {
+        return channelScore;
+    }
+    /* a clean channel does not help when the path to this peer is poor, and vice versa */
+    return (linkScore < channelScore) ? linkScore : channelScore;
+}
+
 static int32_t GetWlan2P4GScore(const char *networkId, uint32_t expectedBw)
 {
-    (void)networkId;
     (void)expectedBw;
-    return GetLinkedChannelScore();
+    return GetWlanScore(networkId, LANE_WLAN_2P4G);
 }
 
 static int32_t GetWlan5GScore(const char *networkId, uint32_t expectedBw)
 {
-    (void)networkId;
     (void)expectedBw;
-    return GetLinkedChannelScore();
+    return GetWlanScore(networkId, LANE_WLAN_5G);
 }
 
 static int32_t GetCocScore(const char *networkId, uint32_t expectedBw)
@@ -59,6 +59,7 @@ typedef enum {
     MSG_TYPE_LANE_DETECT_TIMEOUT,
     MSG_TYPE_LANE_LINK_TIMEOUT,
     MSG_TYPE_NOTIFY_FREE_LANE_RESULT,
+    MSG_TYPE_LANE_DETECT_EVIDENCE,
 } LaneMsgType;
 
 typedef struct {
@@ -1576,6 +1577,13 @@ static void HandleDetectTimeout(SoftBusMessage *msg)
     NotifyDetectTimeout(detectId);
 }
 
+static void HandleDetectEvidence(SoftBusMessage *msg)
+{
+    uint32_t detectId = (uint32_t)msg->arg1;
+    LNN_LOGI(LNN_LANE, "lane detect by evidence. detectId=%{public}u", detectId);
+    NotifyDetectEvidence(detectId);
+}
+
 static void HandleLinkTimeout(SoftBusMessage *msg)
 {
     uint32_t laneReqId = (uint32_t)msg->arg1;
@@ -1651,6 +1659,9 @@ static void MsgHandler(SoftBusMessage *msg)
         case MSG_TYPE_NOTIFY_FREE_LANE_RESULT:
             HandelNotifyFreeLaneResult(msg);
             break;
+        case MSG_TYPE_LANE_DETECT_EVIDENCE:
+            HandleDetectEvidence(msg);
+            break;
         default:
             LNN_LOGE(LNN_LANE, "msg type=%{public}d cannot found", msg->what);
             break;
@@ -1791,6 +1802,12 @@ void RemoveDetectTimeoutMessage(uint32_t detectId)
         RemoveDetectTimeout, &detectId);
 }
 
+int32_t PostDetectEvidenceMessage(uint32_t detectId)
+{
+    LNN_LOGI(LNN_LANE, "post detect evidence message, detectId=%{public}u", detectId);
+    return LnnLanePostMsgToHandler(MSG_TYPE_LANE_DETECT_EVIDENCE, detectId, 0, NULL, 0);
+}
+
 int32_t PostDelayDestroyMessage(uint32_t laneReqId, uint64_t laneId, uint64_t delayMillis)
 {
     LNN_LOGI(LNN_LANE, "post delay destroy message. laneReqId=%{public}u, laneId=%{public}" PRIu64 "",
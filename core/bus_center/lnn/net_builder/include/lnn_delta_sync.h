@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LNN_DELTA_SYNC_H
+#define LNN_DELTA_SYNC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    DELTA_FIELD_BATTERY_LEVEL = 0,
+    DELTA_FIELD_BATTERY_CHARGING,
+    DELTA_FIELD_NET_CAPABILITY,
+    DELTA_FIELD_BUTT,
+} DeltaSyncField;
+
+#define DELTA_FIELD_MASK(field) (1U << (uint32_t)(field))
+
+typedef struct {
+    /* called without any delta sync lock held, so it may loop straight back into LnnDeltaSyncOnRecv */
+    int32_t (*sendMsg)(void *owner, const char *networkId, const uint8_t *msg, uint32_t len);
+    /* values holds the whole peer field table, changedMask the fields updated by this message */
+    void (*applyFields)(void *owner, const char *networkId, const int32_t *values, uint32_t changedMask);
+    void *owner;
+} DeltaSyncTransport;
+
+typedef struct DeltaSyncCtx DeltaSyncCtx;
+
+/* values holds the whole peer field table, changedMask the fields updated by this message */
+typedef void (*DeltaSyncFieldHandler)(const char *networkId, const int32_t *values, uint32_t changedMask);
+
+/*
+ * Every local change bumps the context version; a peer is sent the fields changed since the version it last
+ * acknowledged, and a full table whenever it has not acknowledged anything yet or reports a version mismatch.
+ * The epoch identifies one context lifetime so that a restarted peer is detected and resynchronized.
+ */
+DeltaSyncCtx *LnnCreateDeltaSyncCtx(const DeltaSyncTransport *transport, uint32_t epoch);
+void LnnDestroyDeltaSyncCtx(DeltaSyncCtx *ctx);
+int32_t LnnDeltaSyncSetField(DeltaSyncCtx *ctx, DeltaSyncField field, int32_t value);
+int32_t LnnDeltaSyncFlush(DeltaSyncCtx *ctx, const char *networkId);
+int32_t LnnDeltaSyncOnRecv(DeltaSyncCtx *ctx, const char *networkId, const uint8_t *msg, uint32_t len);
+bool LnnDeltaSyncIsPeerCapable(DeltaSyncCtx *ctx, const char *networkId);
+void LnnDeltaSyncRemovePeer(DeltaSyncCtx *ctx, const char *networkId);
+
+int32_t LnnInitDeltaSync(void);
+void LnnDeinitDeltaSync(void);
+int32_t LnnRegDeltaSyncFieldHandler(DeltaSyncField field, DeltaSyncFieldHandler handler);
+void LnnUnregDeltaSyncFieldHandler(DeltaSyncField field, DeltaSyncFieldHandler handler);
+/*
+ * Sets the local fields and syncs them to one peer. Returns SOFTBUS_FUNC_NOT_SUPPORT if the peer does not
+ * advertise delta sync, the caller then sends its legacy message instead.
+ */
+int32_t LnnDeltaSyncLocalFields(const char *networkId, const DeltaSyncField *fields, const int32_t *values,
+    uint32_t num);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LNN_DELTA_SYNC_H */
@@ -44,6 +44,7 @@ typedef enum {
     LNN_INFO_TYPE_PTK,
     LNN_INFO_TYPE_USERID,
     LNN_INFO_TYPE_SYNC_BROADCASTLINKKEY,
+    LNN_INFO_TYPE_DELTA_INFO,
     LNN_INFO_TYPE_COUNT,
     //LNN_INFO_TYPE_P2P_ROLE = 256,
 } LnnSyncInfoType;
@@ -15,9 +15,14 @@
 
 #define JSON_KEY_BATTERY_LEAVEL "BatteryLeavel"
 #define JSON_KEY_IS_CHARGING "IsCharging"
+#define BATTERY_SYNC_LEVEL_STEP 5
 
 #include <securec.h>
+#include <stdlib.h>
+#include "bus_center_event.h"
+#include "bus_center_manager.h"
 #include "lnn_battery_info.h"
+#include "lnn_delta_sync.h"
 #include "lnn_distributed_net_ledger.h"
 #include "lnn_log.h"
 #include "lnn_sync_info_manager.h"
@@ -25,7 +30,7 @@
 #include "softbus_json_utils.h"
 #include "softbus_error_code.h"
 
-int32_t LnnSyncBatteryInfo(const char *udid, int32_t level, bool isCharging)
+static int32_t SendLegacyBatteryInfo(const char *networkId, int32_t level, bool isCharging)
 {
     cJSON *json = cJSON_CreateObject();
     if (json == NULL) {
@@ -44,18 +49,68 @@ int32_t LnnSyncBatteryInfo(const char *udid, int32_t level, bool isCharging)
         LNN_LOGE(LNN_LANE, "format elect packet fail");
         return SOFTBUS_CREATE_JSON_ERR;
     }
+    int32_t rc = LnnSendSyncInfoMsg(LNN_INFO_TYPE_BATTERY_INFO, networkId, (uint8_t *)data, strlen(data) + 1, NULL);
+    cJSON_free(data);
+    return rc;
+}
+
+static int32_t SyncBatteryInfoByNetworkId(const char *networkId, int32_t level, bool isCharging)
+{
+    DeltaSyncField fields[] = { DELTA_FIELD_BATTERY_LEVEL, DELTA_FIELD_BATTERY_CHARGING };
+    int32_t values[] = { level, isCharging ? 1 : 0 };
+    int32_t ret = LnnDeltaSyncLocalFields(networkId, fields, values, sizeof(fields) / sizeof(fields[0]));
+    if (ret != SOFTBUS_FUNC_NOT_SUPPORT) {
+        return ret;
+    }
+    return SendLegacyBatteryInfo(networkId, level, isCharging);
+}
+
+int32_t LnnSyncBatteryInfo(const char *udid, int32_t level, bool isCharging)
+{
     NodeInfo nodeInfo;
     (void)memset_s(&nodeInfo, sizeof(NodeInfo), 0, sizeof(NodeInfo));
     int ret = LnnGetRemoteNodeInfoById(udid, CATEGORY_UDID, &nodeInfo);
     if (ret != SOFTBUS_OK) {
         LNN_LOGE(LNN_LANE, "not target node");
-        cJSON_free(data);
         return SOFTBUS_NETWORK_GET_NODE_INFO_ERR;
     }
-    int32_t rc = LnnSendSyncInfoMsg(LNN_INFO_TYPE_BATTERY_INFO,
-    nodeInfo.networkId, (uint8_t *)data, strlen(data) + 1, NULL);
-    cJSON_free(data);
-    return rc;
+    return SyncBatteryInfoByNetworkId(nodeInfo.networkId, level, isCharging);
+}
+
+static int32_t g_lastBatteryLevel = -1;
+static bool g_lastIsCharging = false;
+
+static void OnBatteryStateChanged(const LnnEventBasicInfo *info)
+{
+    if (info == NULL || info->event != LNN_EVENT_BATTERY_STATE_CHANGED) {
+        return;
+    }
+    const LnnMonitorBatteryStateChangedEvent *event = (const LnnMonitorBatteryStateChangedEvent *)info;
+    /*
+     * the battery service reports every percent as well as voltage and temperature changes, peers are only
+     * updated when charging flips or the level moved by a whole step since the last sync
+     */
+    if (event->isCharging == g_lastIsCharging && g_lastBatteryLevel >= 0 &&
+        abs(event->level - g_lastBatteryLevel) < BATTERY_SYNC_LEVEL_STEP) {
+        return;
+    }
+    g_lastBatteryLevel = event->level;
+    g_lastIsCharging = event->isCharging;
+    int32_t infoNum = 0;
+    NodeBasicInfo *netInfo = NULL;
+    if (LnnGetAllOnlineNodeInfo(&netInfo, &infoNum) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "get all online node info fail");
+        return;
+    }
+    for (int32_t i = 0; i < infoNum; i++) {
+        if (LnnIsLSANode(&netInfo[i])) {
+            continue;
+        }
+        if (SyncBatteryInfoByNetworkId(netInfo[i].networkId, event->level, event->isCharging) != SOFTBUS_OK) {
+            LNN_LOGW(LNN_LANE, "sync battery info fail");
+        }
+    }
+    SoftBusFree(netInfo);
 }
 
 static void OnReceiveBatteryInfo(LnnSyncInfoType type, const char *networkId, const uint8_t *msg, uint32_t len)
@@ -85,12 +140,47 @@ static void OnReceiveBatteryInfo(LnnSyncInfoType type, const char *networkId, co
     LNN_LOGD(LNN_LANE, "update battery info");
 }
 
+static void OnReceiveBatteryDeltaInfo(const char *networkId, const int32_t *values, uint32_t changedMask)
+{
+    if (networkId == NULL || values == NULL || (changedMask & (DELTA_FIELD_MASK(DELTA_FIELD_BATTERY_LEVEL) |
+        DELTA_FIELD_MASK(DELTA_FIELD_BATTERY_CHARGING))) == 0) {
+        return;
+    }
+    BatteryInfo battery;
+    battery.batteryLevel = values[DELTA_FIELD_BATTERY_LEVEL];
+    battery.isCharging = (values[DELTA_FIELD_BATTERY_CHARGING] != 0);
+    if (LnnSetDLBatteryInfo(networkId, &battery) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "set peer battery info fail");
+    }
+}
+
 int32_t  LnnInitBatteryInfo(void)
 {
-    return LnnRegSyncInfoHandler(LNN_INFO_TYPE_BATTERY_INFO, OnReceiveBatteryInfo);
+    int32_t ret = LnnRegSyncInfoHandler(LNN_INFO_TYPE_BATTERY_INFO, OnReceiveBatteryInfo);
+    if (ret != SOFTBUS_OK) {
+        return ret;
+    }
+    if (LnnRegDeltaSyncFieldHandler(DELTA_FIELD_BATTERY_LEVEL, OnReceiveBatteryDeltaInfo) != SOFTBUS_OK ||
+        LnnRegDeltaSyncFieldHandler(DELTA_FIELD_BATTERY_CHARGING, OnReceiveBatteryDeltaInfo) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "reg battery delta handler fail");
+        LnnUnregDeltaSyncFieldHandler(DELTA_FIELD_BATTERY_LEVEL, OnReceiveBatteryDeltaInfo);
+        (void)LnnUnregSyncInfoHandler(LNN_INFO_TYPE_BATTERY_INFO, OnReceiveBatteryInfo);
+        return SOFTBUS_NETWORK_REG_EVENT_HANDLER_ERR;
+    }
+    ret = LnnRegisterEventHandler(LNN_EVENT_BATTERY_STATE_CHANGED, OnBatteryStateChanged);
+    if (ret != SOFTBUS_OK) {
+        LNN_LOGE(LNN_LANE, "reg battery state change handler fail, ret=%{public}d", ret);
+        LnnUnregDeltaSyncFieldHandler(DELTA_FIELD_BATTERY_LEVEL, OnReceiveBatteryDeltaInfo);
+        LnnUnregDeltaSyncFieldHandler(DELTA_FIELD_BATTERY_CHARGING, OnReceiveBatteryDeltaInfo);
+        (void)LnnUnregSyncInfoHandler(LNN_INFO_TYPE_BATTERY_INFO, OnReceiveBatteryInfo);
+    }
+    return ret;
 }
 
 void LnnDeinitBatteryInfo(void)
 {
+    LnnUnregisterEventHandler(LNN_EVENT_BATTERY_STATE_CHANGED, OnBatteryStateChanged);
+    LnnUnregDeltaSyncFieldHandler(DELTA_FIELD_BATTERY_LEVEL, OnReceiveBatteryDeltaInfo);
+    LnnUnregDeltaSyncFieldHandler(DELTA_FIELD_BATTERY_CHARGING, OnReceiveBatteryDeltaInfo);
     (void)LnnUnregSyncInfoHandler(LNN_INFO_TYPE_BATTERY_INFO, OnReceiveBatteryInfo);
 }
\ No newline at end of file
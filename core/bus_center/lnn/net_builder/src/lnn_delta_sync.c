@@ -0,0 +1,609 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "lnn_delta_sync.h"
+
+#include <securec.h>
+
+#include "anonymizer.h"
+#include "bus_center_event.h"
+#include "bus_center_manager.h"
+#include "common_list.h"
+#include "lnn_distributed_net_ledger.h"
+#include "lnn_feature_capability.h"
+#include "lnn_log.h"
+#include "lnn_sync_info_manager.h"
+#include "softbus_adapter_mem.h"
+#include "softbus_adapter_thread.h"
+#include "softbus_adapter_timer.h"
+#include "softbus_def.h"
+#include "softbus_error_code.h"
+
+#define DELTA_SYNC_MAX_PEER_NUM 32
+#define DELTA_MSG_HEAD_LEN 16
+#define DELTA_MSG_FIELD_LEN 5
+#define DELTA_MSG_MAX_LEN (DELTA_MSG_HEAD_LEN + DELTA_MSG_FIELD_LEN * DELTA_FIELD_BUTT)
+#define BYTE_BITS 8
+#define BYTE_MASK 0xFF
+
+typedef enum {
+    DELTA_MSG_DELTA = 0,
+    DELTA_MSG_FULL,
+    DELTA_MSG_ACK,
+    DELTA_MSG_RESYNC,
+    DELTA_MSG_BUTT,
+} DeltaMsgType;
+
+/* wire layout, little endian: type(1) fieldNum(1) reserved(2) epoch(4) base(4) version(4) {id(1) value(4)}* */
+typedef struct {
+    uint8_t type;
+    uint8_t fieldNum;
+    uint32_t epoch;
+    uint32_t baseVersion;
+    uint32_t version;
+} DeltaMsgHead;
+
+typedef struct {
+    ListNode node;
+    char networkId[NETWORK_ID_BUF_LEN];
+    bool isCapable;
+    uint32_t ackedVersion;
+    uint32_t peerEpoch;
+    uint32_t recvVersion;
+    int32_t values[DELTA_FIELD_BUTT];
+} DeltaSyncPeer;
+
+struct DeltaSyncCtx {
+    SoftBusMutex lock;
+    uint32_t epoch;
+    uint32_t version;
+    int32_t values[DELTA_FIELD_BUTT];
+    uint32_t fieldVersion[DELTA_FIELD_BUTT];
+    ListNode peerList;
+    uint32_t peerNum;
+    DeltaSyncTransport transport;
+};
+
+typedef struct {
+    uint8_t buf[DELTA_MSG_MAX_LEN];
+    uint32_t len;
+} DeltaMsgBuf;
+
+static DeltaSyncCtx *g_deltaSyncCtx = NULL;
+static DeltaSyncFieldHandler g_deltaFieldHandler[DELTA_FIELD_BUTT];
+
+static void PutU32(uint8_t *buf, uint32_t value)
+{
+    for (uint32_t i = 0; i < sizeof(uint32_t); ++i) {
+        buf[i] = (uint8_t)((value >> (i * BYTE_BITS)) & BYTE_MASK);
+    }
+}
+
+static uint32_t GetU32(const uint8_t *buf)
+{
+    uint32_t value = 0;
+    for (uint32_t i = 0; i < sizeof(uint32_t); ++i) {
+        value |= (uint32_t)buf[i] << (i * BYTE_BITS);
+    }
+    return value;
+}
+
+static void PackMsg(DeltaMsgBuf *out, const DeltaMsgHead *head, const int32_t *values, uint32_t fieldMask)
+{
+    uint8_t fieldNum = 0;
+    uint32_t offset = DELTA_MSG_HEAD_LEN;
+    (void)memset_s(out->buf, sizeof(out->buf), 0, sizeof(out->buf));
+    for (uint32_t i = 0; values != NULL && i < DELTA_FIELD_BUTT; ++i) {
+        if ((fieldMask & DELTA_FIELD_MASK(i)) == 0) {
+            continue;
+        }
+        out->buf[offset] = (uint8_t)i;
+        PutU32(out->buf + offset + 1, (uint32_t)values[i]);
+        offset += DELTA_MSG_FIELD_LEN;
+        fieldNum++;
+    }
+    out->buf[0] = head->type;
+    out->buf[1] = fieldNum;
+    PutU32(out->buf + sizeof(uint32_t), head->epoch);
+    PutU32(out->buf + sizeof(uint32_t) * 2, head->baseVersion);
+    PutU32(out->buf + sizeof(uint32_t) * 3, head->version);
+    out->len = offset;
+}
+
+static int32_t UnpackHead(const uint8_t *msg, uint32_t len, DeltaMsgHead *head)
+{
+    if (len < DELTA_MSG_HEAD_LEN) {
+        return SOFTBUS_INVALID_DATA_HEAD;
+    }
+    head->type = msg[0];
+    head->fieldNum = msg[1];
+    head->epoch = GetU32(msg + sizeof(uint32_t));
+    head->baseVersion = GetU32(msg + sizeof(uint32_t) * 2);
+    head->version = GetU32(msg + sizeof(uint32_t) * 3);
+    if (head->type >= DELTA_MSG_BUTT || head->fieldNum > DELTA_FIELD_BUTT ||
+        len < DELTA_MSG_HEAD_LEN + (uint32_t)head->fieldNum * DELTA_MSG_FIELD_LEN) {
+        return SOFTBUS_INVALID_DATA_HEAD;
+    }
+    return SOFTBUS_OK;
+}
+
+static DeltaSyncPeer *FindPeer(DeltaSyncCtx *ctx, const char *networkId)
+{
+    DeltaSyncPeer *item = NULL;
+    LIST_FOR_EACH_ENTRY(item, &ctx->peerList, DeltaSyncPeer, node) {
+        if (strcmp(item->networkId, networkId) == 0) {
+            return item;
+        }
+    }
+    return NULL;
+}
+
+/* peers are kept in least recently used order, so a departed peer is evicted once the table is full */
+static DeltaSyncPeer *GetOrCreatePeer(DeltaSyncCtx *ctx, const char *networkId)
+{
+    DeltaSyncPeer *peer = FindPeer(ctx, networkId);
+    if (peer != NULL) {
+        ListDelete(&peer->node);
+        ListTailInsert(&ctx->peerList, &peer->node);
+        return peer;
+    }
+    if (ctx->peerNum >= DELTA_SYNC_MAX_PEER_NUM) {
+        peer = LIST_ENTRY(ctx->peerList.next, DeltaSyncPeer, node);
+        ListDelete(&peer->node);
+        ctx->peerNum--;
+        (void)memset_s(peer, sizeof(DeltaSyncPeer), 0, sizeof(DeltaSyncPeer));
+    } else {
+        peer = (DeltaSyncPeer *)SoftBusCalloc(sizeof(DeltaSyncPeer));
+        if (peer == NULL) {
+            LNN_LOGE(LNN_BUILDER, "calloc delta sync peer fail");
+            return NULL;
+        }
+    }
+    if (strcpy_s(peer->networkId, NETWORK_ID_BUF_LEN, networkId) != EOK) {
+        LNN_LOGE(LNN_BUILDER, "copy networkId fail");
+        SoftBusFree(peer);
+        return NULL;
+    }
+    ListInit(&peer->node);
+    ListTailInsert(&ctx->peerList, &peer->node);
+    ctx->peerNum++;
+    return peer;
+}
+
+DeltaSyncCtx *LnnCreateDeltaSyncCtx(const DeltaSyncTransport *transport, uint32_t epoch)
+{
+    if (transport == NULL || transport->sendMsg == NULL || epoch == 0) {
+        LNN_LOGE(LNN_BUILDER, "invalid param");
+        return NULL;
+    }
+    DeltaSyncCtx *ctx = (DeltaSyncCtx *)SoftBusCalloc(sizeof(DeltaSyncCtx));
+    if (ctx == NULL) {
+        LNN_LOGE(LNN_BUILDER, "calloc delta sync ctx fail");
+        return NULL;
+    }
+    if (SoftBusMutexInit(&ctx->lock, NULL) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_BUILDER, "init delta sync lock fail");
+        SoftBusFree(ctx);
+        return NULL;
+    }
+    ctx->epoch = epoch;
+    ctx->transport = *transport;
+    ListInit(&ctx->peerList);
+    return ctx;
+}
+
+void LnnDestroyDeltaSyncCtx(DeltaSyncCtx *ctx)
+{
+    if (ctx == NULL) {
+        return;
+    }
+    DeltaSyncPeer *item = NULL;
+    DeltaSyncPeer *next = NULL;
+    LIST_FOR_EACH_ENTRY_SAFE(item, next, &ctx->peerList, DeltaSyncPeer, node) {
+        ListDelete(&item->node);
+        SoftBusFree(item);
+    }
+    (void)SoftBusMutexDestroy(&ctx->lock);
+    SoftBusFree(ctx);
+}
+
+int32_t LnnDeltaSyncSetField(DeltaSyncCtx *ctx, DeltaSyncField field, int32_t value)
+{
+    if (ctx == NULL || field < 0 || field >= DELTA_FIELD_BUTT) {
+        return SOFTBUS_INVALID_PARAM;
+    }
+    if (SoftBusMutexLock(&ctx->lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_BUILDER, "lock fail");
+        return SOFTBUS_LOCK_ERR;
+    }
+    if (ctx->fieldVersion[field] == 0 || ctx->values[field] != value) {
+        ctx->values[field] = value;
+        ctx->fieldVersion[field] = ++ctx->version;
+    }
+    (void)SoftBusMutexUnlock(&ctx->lock);
+    return SOFTBUS_OK;
+}
+
+/* builds the message for one peer under ctx lock; len stays 0 if the peer is up to date */
+static void BuildSyncMsgLocked(DeltaSyncCtx *ctx, DeltaSyncPeer *peer, DeltaMsgBuf *out)
+{
+    DeltaMsgHead head = { .epoch = ctx->epoch, .version = ctx->version };
+    out->len = 0;
+    /* the full table only carries fields that were set, an unset field must not overwrite the peer ledger */
+    uint32_t baseVersion = 0;
+    if (!peer->isCapable || peer->ackedVersion == 0) {
+        head.type = DELTA_MSG_FULL;
+    } else if (peer->ackedVersion >= ctx->version) {
+        return;
+    } else {
+        head.type = DELTA_MSG_DELTA;
+        head.baseVersion = peer->ackedVersion;
+        baseVersion = peer->ackedVersion;
+    }
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < DELTA_FIELD_BUTT; ++i) {
+        if (ctx->fieldVersion[i] > baseVersion) {
+            mask |= DELTA_FIELD_MASK(i);
+        }
+    }
+    PackMsg(out, &head, ctx->values, mask);
+}
+
+static int32_t SendMsg(DeltaSyncCtx *ctx, const char *networkId, const DeltaMsgBuf *msg)
+{
+    if (msg->len == 0) {
+        return SOFTBUS_OK;
+    }
+    return ctx->transport.sendMsg(ctx->transport.owner, networkId, msg->buf, msg->len);
+}
+
+int32_t LnnDeltaSyncFlush(DeltaSyncCtx *ctx, const char *networkId)
+{
+    if (ctx == NULL || networkId == NULL) {
+        return SOFTBUS_INVALID_PARAM;
+    }
+    DeltaMsgBuf msg = { .len = 0 };
+    if (SoftBusMutexLock(&ctx->lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_BUILDER, "lock fail");
+        return SOFTBUS_LOCK_ERR;
+    }
+    DeltaSyncPeer *peer = GetOrCreatePeer(ctx, networkId);
+    if (peer == NULL) {
+        (void)SoftBusMutexUnlock(&ctx->lock);
+        return SOFTBUS_MALLOC_ERR;
+    }
+    BuildSyncMsgLocked(ctx, peer, &msg);
+    (void)SoftBusMutexUnlock(&ctx->lock);
+    return SendMsg(ctx, networkId, &msg);
+}
+
+static uint32_t ApplyFieldsLocked(DeltaSyncPeer *peer, const uint8_t *fields, uint8_t fieldNum)
+{
+    uint32_t changedMask = 0;
+    for (uint8_t i = 0; i < fieldNum; ++i) {
+        const uint8_t *field = fields + (uint32_t)i * DELTA_MSG_FIELD_LEN;
+        if (field[0] >= DELTA_FIELD_BUTT) {
+            /* fields added by a newer peer are skipped */
+            continue;
+        }
+        int32_t value = (int32_t)GetU32(field + 1);
+        if (peer->values[field[0]] != value || peer->recvVersion == 0) {
+            peer->values[field[0]] = value;
+            changedMask |= DELTA_FIELD_MASK(field[0]);
+        }
+    }
+    return changedMask;
+}
+
+static void ProcessUpdateLocked(DeltaSyncCtx *ctx, DeltaSyncPeer *peer, const DeltaMsgHead *head,
+    const uint8_t *fields, DeltaMsgBuf *reply, uint32_t *changedMask)
+{
+    DeltaMsgHead replyHead = { .type = DELTA_MSG_ACK, .epoch = head->epoch };
+    if (head->type == DELTA_MSG_FULL && peer->recvVersion != 0 && peer->peerEpoch == head->epoch &&
+        head->version < peer->recvVersion) {
+        /* a reordered full table must not roll back fields a later delta already updated */
+        LNN_LOGI(LNN_BUILDER, "ignore stale full table, version=%{public}u, recv=%{public}u",
+            head->version, peer->recvVersion);
+    } else if (head->type == DELTA_MSG_FULL) {
+        peer->peerEpoch = head->epoch;
+        peer->recvVersion = 0;
+        *changedMask = ApplyFieldsLocked(peer, fields, head->fieldNum);
+        peer->recvVersion = head->version;
+    } else if (peer->peerEpoch != head->epoch || head->baseVersion > peer->recvVersion) {
+        LNN_LOGI(LNN_BUILDER, "delta base mismatch, base=%{public}u, recv=%{public}u, request full sync",
+            head->baseVersion, peer->recvVersion);
+        replyHead.type = DELTA_MSG_RESYNC;
+        replyHead.epoch = ctx->epoch;
+        PackMsg(reply, &replyHead, NULL, 0);
+        return;
+    } else if (head->version > peer->recvVersion) {
+        *changedMask = ApplyFieldsLocked(peer, fields, head->fieldNum);
+        peer->recvVersion = head->version;
+    }
+    /* a duplicate or reordered delta is only acknowledged again */
+    replyHead.version = peer->recvVersion;
+    PackMsg(reply, &replyHead, NULL, 0);
+}
+
+static void ProcessAckLocked(DeltaSyncCtx *ctx, DeltaSyncPeer *peer, const DeltaMsgHead *head)
+{
+    if (head->epoch != ctx->epoch || head->version > ctx->version) {
+        LNN_LOGW(LNN_BUILDER, "ignore stale delta ack, version=%{public}u", head->version);
+        return;
+    }
+    peer->isCapable = true;
+    if (head->version > peer->ackedVersion) {
+        peer->ackedVersion = head->version;
+    }
+}
+
+int32_t LnnDeltaSyncOnRecv(DeltaSyncCtx *ctx, const char *networkId, const uint8_t *msg, uint32_t len)
+{
+    if (ctx == NULL || networkId == NULL || msg == NULL) {
+        return SOFTBUS_INVALID_PARAM;
+    }
+    DeltaMsgHead head;
+    int32_t ret = UnpackHead(msg, len, &head);
+    if (ret != SOFTBUS_OK) {
+        LNN_LOGE(LNN_BUILDER, "invalid delta sync msg, len=%{public}u", len);
+        return ret;
+    }
+    DeltaMsgBuf reply = { .len = 0 };
+    int32_t values[DELTA_FIELD_BUTT] = { 0 };
+    uint32_t changedMask = 0;
+    if (SoftBusMutexLock(&ctx->lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_BUILDER, "lock fail");
+        return SOFTBUS_LOCK_ERR;
+    }
+    DeltaSyncPeer *peer = GetOrCreatePeer(ctx, networkId);
+    if (peer == NULL) {
+        (void)SoftBusMutexUnlock(&ctx->lock);
+        return SOFTBUS_MALLOC_ERR;
+    }
+    switch (head.type) {
+        case DELTA_MSG_DELTA:
+        case DELTA_MSG_FULL:
+            ProcessUpdateLocked(ctx, peer, &head, msg + DELTA_MSG_HEAD_LEN, &reply, &changedMask);
+            (void)memcpy_s(values, sizeof(values), peer->values, sizeof(peer->values));
+            break;
+        case DELTA_MSG_ACK:
+            ProcessAckLocked(ctx, peer, &head);
+            break;
+        case DELTA_MSG_RESYNC:
+            peer->isCapable = true;
+            peer->ackedVersion = 0;
+            BuildSyncMsgLocked(ctx, peer, &reply);
+            break;
+        default:
+            break;
+    }
+    (void)SoftBusMutexUnlock(&ctx->lock);
+    if (changedMask != 0 && ctx->transport.applyFields != NULL) {
+        ctx->transport.applyFields(ctx->transport.owner, networkId, values, changedMask);
+    }
+    return SendMsg(ctx, networkId, &reply);
+}
+
+bool LnnDeltaSyncIsPeerCapable(DeltaSyncCtx *ctx, const char *networkId)
+{
+    if (ctx == NULL || networkId == NULL) {
+        return false;
+    }
+    if (SoftBusMutexLock(&ctx->lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_BUILDER, "lock fail");
+        return false;
+    }
+    DeltaSyncPeer *peer = FindPeer(ctx, networkId);
+    bool isCapable = (peer != NULL && peer->isCapable);
+    (void)SoftBusMutexUnlock(&ctx->lock);
+    return isCapable;
+}
+
+void LnnDeltaSyncRemovePeer(DeltaSyncCtx *ctx, const char *networkId)
+{
+    if (ctx == NULL || networkId == NULL) {
+        return;
+    }
+    if (SoftBusMutexLock(&ctx->lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_BUILDER, "lock fail");
+        return;
+    }
+    DeltaSyncPeer *peer = FindPeer(ctx, networkId);
+    if (peer != NULL) {
+        ListDelete(&peer->node);
+        ctx->peerNum--;
+        SoftBusFree(peer);
+    }
+    (void)SoftBusMutexUnlock(&ctx->lock);
+}
+
+static int32_t SendDeltaSyncMsg(void *owner, const char *networkId, const uint8_t *msg, uint32_t len)
+{
+    (void)owner;
+    return LnnSendSyncInfoMsg(LNN_INFO_TYPE_DELTA_INFO, networkId, msg, len, NULL);
+}
+
+static void ApplyDeltaSyncFields(void *owner, const char *networkId, const int32_t *values, uint32_t changedMask)
+{
+    DeltaSyncCtx *ctx = (DeltaSyncCtx *)owner;
+    DeltaSyncFieldHandler handlers[DELTA_FIELD_BUTT] = { NULL };
+    if (SoftBusMutexLock(&ctx->lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_BUILDER, "lock fail");
+        return;
+    }
+    (void)memcpy_s(handlers, sizeof(handlers), g_deltaFieldHandler, sizeof(g_deltaFieldHandler));
+    (void)SoftBusMutexUnlock(&ctx->lock);
+    /* a handler registered for several fields is called once per message */
+    uint32_t pendingMask = changedMask;
+    for (uint32_t i = 0; i < DELTA_FIELD_BUTT; ++i) {
+        if ((pendingMask & DELTA_FIELD_MASK(i)) == 0 || handlers[i] == NULL) {
+            continue;
+        }
+        for (uint32_t j = i; j < DELTA_FIELD_BUTT; ++j) {
+            if (handlers[j] == handlers[i]) {
+                pendingMask &= ~DELTA_FIELD_MASK(j);
+            }
+        }
+        handlers[i](networkId, values, changedMask);
+    }
+}
+
+static void OnDeltaSyncOnlineStateChange(const LnnEventBasicInfo *info)
+{
+    if (info == NULL || info->event != LNN_EVENT_NODE_ONLINE_STATE_CHANGED) {
+        return;
+    }
+    const LnnOnlineStateEventInfo *onlineStateInfo = (const LnnOnlineStateEventInfo *)info;
+    /* peer state is keyed by networkId, a node coming back under the same id must start from a full table */
+    if (!onlineStateInfo->isOnline && onlineStateInfo->networkId != NULL) {
+        LnnDeltaSyncRemovePeer(g_deltaSyncCtx, onlineStateInfo->networkId);
+    }
+}
+
+static void OnReceiveDeltaInfo(LnnSyncInfoType type, const char *networkId, const uint8_t *msg, uint32_t len)
+{
+    if (type != LNN_INFO_TYPE_DELTA_INFO || networkId == NULL || msg == NULL) {
+        LNN_LOGE(LNN_BUILDER, "invalid param, SyncInfoType=%{public}d", type);
+        return;
+    }
+    int32_t ret = LnnDeltaSyncOnRecv(g_deltaSyncCtx, networkId, msg, len);
+    if (ret != SOFTBUS_OK) {
+        char *anonyNetworkId = NULL;
+        Anonymize(networkId, &anonyNetworkId);
+        LNN_LOGE(LNN_BUILDER, "process delta info fail, networkId=%{public}s, ret=%{public}d",
+            AnonymizeWrapper(anonyNetworkId), ret);
+        AnonymizeFree(anonyNetworkId);
+    }
+}
+
+static bool IsPeerSupportDeltaSync(const char *networkId)
+{
+    uint64_t localFeature = 0;
+    if (LnnGetLocalNumU64Info(NUM_KEY_FEATURE_CAPA, &localFeature) != SOFTBUS_OK ||
+        !IsFeatureSupport(localFeature, BIT_SUPPORT_DELTA_SYNC_INFO)) {
+        return false;
+    }
+    NodeInfo nodeInfo;
+    (void)memset_s(&nodeInfo, sizeof(NodeInfo), 0, sizeof(NodeInfo));
+    if (LnnGetRemoteNodeInfoById(networkId, CATEGORY_NETWORK_ID, &nodeInfo) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_BUILDER, "get node info fail");
+        return false;
+    }
+    return IsFeatureSupport(nodeInfo.feature, BIT_SUPPORT_DELTA_SYNC_INFO);
+}
+
+int32_t LnnDeltaSyncLocalFields(const char *networkId, const DeltaSyncField *fields, const int32_t *values,
+    uint32_t num)
+{
+    if (networkId == NULL || fields == NULL || values == NULL || num == 0) {
+        return SOFTBUS_INVALID_PARAM;
+    }
+    DeltaSyncCtx *ctx = g_deltaSyncCtx;
+    if (ctx == NULL || !IsPeerSupportDeltaSync(networkId)) {
+        return SOFTBUS_FUNC_NOT_SUPPORT;
+    }
+    for (uint32_t i = 0; i < num; ++i) {
+        if (LnnDeltaSyncSetField(ctx, fields[i], values[i]) != SOFTBUS_OK) {
+            return SOFTBUS_NETWORK_SET_NODE_INFO_ERR;
+        }
+    }
+    return LnnDeltaSyncFlush(ctx, networkId);
+}
+
+int32_t LnnRegDeltaSyncFieldHandler(DeltaSyncField field, DeltaSyncFieldHandler handler)
+{
+    if (field < 0 || field >= DELTA_FIELD_BUTT || handler == NULL) {
+        LNN_LOGE(LNN_BUILDER, "invalid delta sync handler reg param. field=%{public}d", field);
+        return SOFTBUS_INVALID_PARAM;
+    }
+    DeltaSyncCtx *ctx = g_deltaSyncCtx;
+    if (ctx == NULL) {
+        LNN_LOGE(LNN_BUILDER, "delta sync not init");
+        return SOFTBUS_NO_INIT;
+    }
+    if (SoftBusMutexLock(&ctx->lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_BUILDER, "lock fail");
+        return SOFTBUS_LOCK_ERR;
+    }
+    if (g_deltaFieldHandler[field] != NULL) {
+        LNN_LOGE(LNN_BUILDER, "delta sync field already have handler. field=%{public}d", field);
+        (void)SoftBusMutexUnlock(&ctx->lock);
+        return SOFTBUS_INVALID_PARAM;
+    }
+    g_deltaFieldHandler[field] = handler;
+    (void)SoftBusMutexUnlock(&ctx->lock);
+    return SOFTBUS_OK;
+}
+
+void LnnUnregDeltaSyncFieldHandler(DeltaSyncField field, DeltaSyncFieldHandler handler)
+{
+    DeltaSyncCtx *ctx = g_deltaSyncCtx;
+    if (field < 0 || field >= DELTA_FIELD_BUTT || ctx == NULL) {
+        return;
+    }
+    if (SoftBusMutexLock(&ctx->lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_BUILDER, "lock fail");
+        return;
+    }
+    if (g_deltaFieldHandler[field] == handler) {
+        g_deltaFieldHandler[field] = NULL;
+    }
+    (void)SoftBusMutexUnlock(&ctx->lock);
+}
+
+int32_t LnnInitDeltaSync(void)
+{
+    if (g_deltaSyncCtx != NULL) {
+        return SOFTBUS_OK;
+    }
+    DeltaSyncTransport transport = {
+        .sendMsg = SendDeltaSyncMsg,
+        .applyFields = ApplyDeltaSyncFields,
+        .owner = NULL,
+    };
+    /* the low bit keeps the epoch non zero, which marks a peer that never sent anything */
+    DeltaSyncCtx *ctx = LnnCreateDeltaSyncCtx(&transport, (uint32_t)SoftBusGetSysTimeMs() | 1U);
+    if (ctx == NULL) {
+        return SOFTBUS_MALLOC_ERR;
+    }
+    ctx->transport.owner = ctx;
+    int32_t ret = LnnRegSyncInfoHandler(LNN_INFO_TYPE_DELTA_INFO, OnReceiveDeltaInfo);
+    if (ret != SOFTBUS_OK) {
+        LNN_LOGE(LNN_BUILDER, "reg delta info handler fail, ret=%{public}d", ret);
+        LnnDestroyDeltaSyncCtx(ctx);
+        return ret;
+    }
+    ret = LnnRegisterEventHandler(LNN_EVENT_NODE_ONLINE_STATE_CHANGED, OnDeltaSyncOnlineStateChange);
+    if (ret != SOFTBUS_OK) {
+        LNN_LOGE(LNN_BUILDER, "reg online state handler fail, ret=%{public}d", ret);
+        (void)LnnUnregSyncInfoHandler(LNN_INFO_TYPE_DELTA_INFO, OnReceiveDeltaInfo);
+        LnnDestroyDeltaSyncCtx(ctx);
+        return ret;
+    }
+    g_deltaSyncCtx = ctx;
+    return SOFTBUS_OK;
+}
+
+void LnnDeinitDeltaSync(void)
+{
+    if (g_deltaSyncCtx == NULL) {
+        return;
+    }
+    LnnUnregisterEventHandler(LNN_EVENT_NODE_ONLINE_STATE_CHANGED, OnDeltaSyncOnlineStateChange);
+    (void)LnnUnregSyncInfoHandler(LNN_INFO_TYPE_DELTA_INFO, OnReceiveDeltaInfo);
+    LnnDestroyDeltaSyncCtx(g_deltaSyncCtx);
+    g_deltaSyncCtx = NULL;
+    (void)memset_s(g_deltaFieldHandler, sizeof(g_deltaFieldHandler), 0, sizeof(g_deltaFieldHandler));
+}
@@ -21,6 +21,7 @@
 #include "bus_center_event.h"
 #include "bus_center_manager.h"
 #include "lnn_async_callback_utils.h"
+#include "lnn_delta_sync.h"
 #include "lnn_distributed_net_ledger.h"
 #include "lnn_deviceinfo_to_profile.h"
 #include "lnn_feature_capability.h"
@@ -102,23 +103,8 @@ static void UpdateNetworkInfo(const char *udid)
     LnnNotifyBasicInfoChanged(&basic, TYPE_NETWORK_INFO);
 }
 
-static void OnReceiveCapaSyncInfoMsg(LnnSyncInfoType type, const char *networkId, const uint8_t *msg, uint32_t len)
+static void ProcessPeerCapability(const char *networkId, uint32_t capability)
 {
-    LNN_LOGI(LNN_BUILDER, "Recv capability info. type=%{public}d, len=%{public}d", type, len);
-    if (type != LNN_INFO_TYPE_CAPABILITY) {
-        return;
-    }
-    if (networkId == NULL) {
-        return;
-    }
-    if (msg == NULL || len == 0) {
-        return;
-    }
-    uint32_t capability = 0;
-    if (ConvertMsgToCapability(&capability, msg, len) != SOFTBUS_OK) {
-        LNN_LOGE(LNN_BUILDER, "convert msg to capability fail");
-        return;
-    }
     char *anonyNetworkId = NULL;
     Anonymize(networkId, &anonyNetworkId);
     LNN_LOGI(LNN_BUILDER, "recv capability change=%{public}d, networkId=%{public}s",
@@ -143,6 +129,35 @@ static void OnReceiveCapaSyncInfoMsg(LnnSyncInfoType type, const char *networkId
     HandlePeerNetCapchanged(networkId, capability);
 }
 
+static void OnReceiveCapaSyncInfoMsg(LnnSyncInfoType type, const char *networkId, const uint8_t *msg, uint32_t len)
+{
+    LNN_LOGI(LNN_BUILDER, "Recv capability info. type=%{public}d, len=%{public}d", type, len);
+    if (type != LNN_INFO_TYPE_CAPABILITY) {
+        return;
+    }
+    if (networkId == NULL) {
+        return;
+    }
+    if (msg == NULL || len == 0) {
+        return;
+    }
+    uint32_t capability = 0;
+    if (ConvertMsgToCapability(&capability, msg, len) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_BUILDER, "convert msg to capability fail");
+        return;
+    }
+    ProcessPeerCapability(networkId, capability);
+}
+
+static void OnReceiveCapaDeltaInfo(const char *networkId, const int32_t *values, uint32_t changedMask)
+{
+    if (networkId == NULL || values == NULL || (changedMask & DELTA_FIELD_MASK(DELTA_FIELD_NET_CAPABILITY)) == 0) {
+        return;
+    }
+    LNN_LOGI(LNN_BUILDER, "Recv capability delta info");
+    ProcessPeerCapability(networkId, (uint32_t)values[DELTA_FIELD_NET_CAPABILITY]);
+}
+
 static uint32_t ConvertMsgToUserId(int32_t *userId, const uint8_t *msg, uint32_t len)
 {
     if (userId == NULL || msg == NULL || len < BITLEN) {
@@ -218,18 +233,29 @@ static bool IsNeedToSend(NodeInfo *nodeInfo, uint32_t type)
     }
 }
 
+static int32_t SendCapabilitySyncMsg(const char *networkId, uint8_t *msg, uint32_t netCapability)
+{
+    DeltaSyncField field = DELTA_FIELD_NET_CAPABILITY;
+    int32_t value = (int32_t)netCapability;
+    int32_t ret = LnnDeltaSyncLocalFields(networkId, &field, &value, 1);
+    if (ret != SOFTBUS_FUNC_NOT_SUPPORT) {
+        return ret;
+    }
+    return LnnSendSyncInfoMsg(LNN_INFO_TYPE_CAPABILITY, networkId, msg, MSG_LEN, NULL);
+}
+
 static void DoSendCapability(NodeInfo nodeInfo, NodeBasicInfo netInfo, uint8_t *msg, uint32_t netCapability,
     uint32_t type)
 {
     int32_t ret = SOFTBUS_OK;
     if (IsNeedToSend(&nodeInfo, type)) {
         if (!IsFeatureSupport(nodeInfo.feature, BIT_CLOUD_SYNC_DEVICE_INFO)) {
-            ret = LnnSendSyncInfoMsg(LNN_INFO_TYPE_CAPABILITY, netInfo.networkId, msg, MSG_LEN, NULL);
+            ret = SendCapabilitySyncMsg(netInfo.networkId, msg, netCapability);
         } else {
             if (type == ((1 << (uint32_t)DISCOVERY_TYPE_BLE) | (1 << (uint32_t)DISCOVERY_TYPE_BR))) {
                 ret = LnnStartHbByTypeAndStrategy(HEARTBEAT_TYPE_BLE_V0, STRATEGY_HB_SEND_SINGLE, false);
             } else {
-                ret = LnnSendSyncInfoMsg(LNN_INFO_TYPE_CAPABILITY, netInfo.networkId, msg, MSG_LEN, NULL);
+                ret = SendCapabilitySyncMsg(netInfo.networkId, msg, netCapability);
             }
         }
         char *anonyNetworkId = NULL;
@@ -626,6 +652,10 @@ int32_t LnnInitNetworkInfo(void)
     if (ret != SOFTBUS_OK) {
         return ret;
     }
+    ret = LnnRegDeltaSyncFieldHandler(DELTA_FIELD_NET_CAPABILITY, OnReceiveCapaDeltaInfo);
+    if (ret != SOFTBUS_OK) {
+        return ret;
+    }
     LNN_LOGE(LNN_BUILDER, "lnn init network info sync done");
     return SOFTBUS_OK;
 }
@@ -636,6 +666,7 @@ void LnnDeinitNetworkInfo(void)
     (void)LnnUnregisterEventHandler(LNN_EVENT_WIFI_STATE_CHANGED, WifiStateEventHandler);
     (void)LnnUnregSyncInfoHandler(LNN_INFO_TYPE_CAPABILITY, OnReceiveCapaSyncInfoMsg);
     (void)LnnUnregSyncInfoHandler(LNN_INFO_TYPE_USERID, OnReceiveUserIdSyncInfoMsg);
+    LnnUnregDeltaSyncFieldHandler(DELTA_FIELD_NET_CAPABILITY, OnReceiveCapaDeltaInfo);
     (void)LnnUnregisterEventHandler(LNN_EVENT_WIFI_SERVICE_START, WifiServiceOnStartHandle);
 }
 
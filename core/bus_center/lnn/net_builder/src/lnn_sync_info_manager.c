@@ -24,6 +24,7 @@
 #include "bus_center_manager.h"
 #include "common_list.h"
 #include "lnn_async_callback_utils.h"
+#include "lnn_delta_sync.h"
 #include "lnn_distributed_net_ledger.h"
 #include "lnn_feature_capability.h"
 #include "lnn_net_builder.h"
@@ -896,12 +897,18 @@ int32_t LnnInitSyncInfoManager(void)
         LNN_LOGE(LNN_INIT, "p2p networking sync set cb fail");
         return ret;
     }
+    ret = LnnInitDeltaSync();
+    if (ret != SOFTBUS_OK) {
+        LNN_LOGE(LNN_INIT, "init delta sync fail");
+        return ret;
+    }
     return SOFTBUS_OK;
 }
 
 void LnnDeinitSyncInfoManager(void)
 {
     int32_t i;
+    LnnDeinitDeltaSync();
     for (i = 0; i < LNN_INFO_TYPE_COUNT; ++i) {
         g_syncInfoManager.handlers[i] = NULL;
     }
@@ -40,6 +40,7 @@ typedef enum {
     BIT_WIFI_DIRECT_ENHANCE_CAPABILITY,
     BIT_SUPPORT_THREE_STATE,
     BIT_CLOUD_SYNC_DEVICE_INFO,
+    BIT_SUPPORT_DELTA_SYNC_INFO,
     BIT_FEATURE_COUNT,
 } FeatureCapability;
 
@@ -73,6 +73,7 @@ uint64_t LnnGetFeatureCapabilty(void)
     LnnClearFeatureCapability(&configValue, BIT_SUPPORT_NEGO_P2P_BY_CHANNEL_CAPABILITY);
     LNN_LOGI(LNN_LEDGER, "clear feature CONN_BLE_DIRECT configValue=%{public}" PRIu64, configValue);
 #endif
+    LnnSetFeatureCapability(&configValue, BIT_SUPPORT_DELTA_SYNC_INFO);
     LNN_LOGI(LNN_LEDGER, "lnn feature configValue=%{public}" PRIu64, configValue);
     return configValue;
 }
\ No newline at end of file
@@ -58,6 +58,7 @@ typedef enum {
     /* event from sa monitor */
     LNN_EVENT_WIFI_SERVICE_START,
     LNN_EVENT_NOTIFY_RAW_ENHANCE_P2P,
+    LNN_EVENT_BATTERY_STATE_CHANGED,
     LNN_EVENT_TYPE_MAX,
 } LnnEventType;
 
@@ -196,6 +197,12 @@ typedef struct {
     uint8_t status;
 } LnnMonitorScreenStateChangedEvent;
 
+typedef struct {
+    LnnEventBasicInfo basic;
+    int32_t level;
+    bool isCharging;
+} LnnMonitorBatteryStateChangedEvent;
+
 typedef struct {
     LnnEventBasicInfo basic;
     uint8_t status;
@@ -340,6 +347,7 @@ void LnnNotifyHBRepeat(void);
 void LnnNotifyUserSwitchEvent(SoftBusUserSwitchState state);
 
 void LnnNotifyDataShareStateChangeEvent(SoftBusDataShareState state);
+void LnnNotifyBatteryStateChangeEvent(int32_t level, bool isCharging);
 
 void LnnNotifyVapInfoChangeEvent(int32_t preferChannel);
 
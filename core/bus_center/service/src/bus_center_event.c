@@ -36,6 +36,7 @@
 #include "softbus_adapter_thread.h"
 #include "softbus_def.h"
 #include "softbus_error_code.h"
+#include "softbus_feature_config.h"
 #include "softbus_qos.h"
 
 typedef struct {
@@ -49,6 +50,18 @@ typedef struct {
     SoftBusMutex lock;
 } BusCenterEventCtrl;
 
+typedef struct {
+    ListNode node;
+    NodeStateBatchItem item;
+} PendingNodeStateItem;
+
+/* only touched on the notify looper, so it needs no lock */
+typedef struct {
+    ListNode list;
+    uint32_t cnt;
+    bool isFlushPosted;
+} PendingNodeStateCtrl;
+
 typedef enum {
     NOTIFY_ONLINE_STATE_CHANGED = 0,
     NOTIFY_NODE_BASIC_INFO_CHANGED,
@@ -57,13 +70,20 @@ typedef enum {
     NOTIFY_LOCAL_NETWORKID_UPDATE,
     NOTIFY_DEVICE_TRUSTED_CHANGED,
     NOTIFY_STATE_SESSION,
+    NOTIFY_NODE_STATE_BATCH_FLUSH,
 } NotifyType;
 
 #define NETWORK_ID_UPDATE_DELAY_TIME (60 * 60 * 1000 * 24) // 24 hour
 #define NETWORK_ID_MAX_TTL (7 * 60 * 60 * 1000 * 24) // 7 * 24 hour
 #define NETWORK_ID_MIN_UPDATE_DELAY_TIME (5 * 60 * 1000) // 5min
+#define DEFAULT_NOTIFY_BATCH_WINDOW 50 // ms
 
 static BusCenterEventCtrl g_eventCtrl;
+static PendingNodeStateCtrl g_pendingNodeState = {
+    .list = { &g_pendingNodeState.list, &g_pendingNodeState.list },
+    .cnt = 0,
+    .isFlushPosted = false,
+};
 static SoftBusHandler g_notifyHandler = {"NotifyHandler", NULL, NULL};
 
 static int32_t PostMessageToHandlerDelay(SoftBusMessage *msg, uint64_t delayMillis)
@@ -99,6 +119,145 @@ static void RemoveNotifyMessage(int32_t what)
     g_notifyHandler.looper->RemoveMessage(g_notifyHandler.looper, &g_notifyHandler, what);
 }
 
+static int32_t PostNotifyMessageDelay(int32_t what, uint64_t delayMillis);
+
+static uint32_t GetNotifyBatchWindow(void)
+{
+    uint32_t window = 0;
+    if (SoftbusGetConfig(SOFTBUS_INT_LNN_NOTIFY_BATCH_WINDOW, (unsigned char *)&window, sizeof(window)) != SOFTBUS_OK) {
+        LNN_LOGW(LNN_EVENT, "get notify batch window fail, use default");
+        return DEFAULT_NOTIFY_BATCH_WINDOW;
+    }
+    return window;
+}
+
+static void NotifyNodeStateImmediately(const NodeStateBatchItem *item)
+{
+    if (item->event == NODE_STATE_BATCH_BASIC_INFO_CHANGED) {
+        (void)LnnIpcNotifyBasicInfoChanged((void *)&item->info, sizeof(NodeBasicInfo), item->type);
+        return;
+    }
+    (void)LnnIpcNotifyOnlineState(item->event == NODE_STATE_BATCH_ONLINE, (void *)&item->info, sizeof(NodeBasicInfo));
+}
+
+/*
+ * Only a repeat of the same state is coalesced, the pending entry takes the newest info and keeps its place, so an
+ * offline followed by an online of a node reaches the client as both events in order. An info change replaces a
+ * pending one of the same type that came after the last state change of the node.
+ */
+static PendingNodeStateItem *FindDuplicateNodeState(const NodeStateBatchItem *item)
+{
+    PendingNodeStateItem *lastState = NULL;
+    PendingNodeStateItem *lastInfo = NULL;
+    PendingNodeStateItem *pending = NULL;
+    LIST_FOR_EACH_ENTRY(pending, &g_pendingNodeState.list, PendingNodeStateItem, node) {
+        if (strcmp(pending->item.info.networkId, item->info.networkId) != 0) {
+            continue;
+        }
+        if (pending->item.event != NODE_STATE_BATCH_BASIC_INFO_CHANGED) {
+            lastState = pending;
+            lastInfo = NULL;
+        } else if (pending->item.type == item->type) {
+            lastInfo = pending;
+        }
+    }
+    if (item->event == NODE_STATE_BATCH_BASIC_INFO_CHANGED) {
+        return lastInfo;
+    }
+    return (lastState != NULL && lastState->item.event == item->event) ? lastState : NULL;
+}
+
+static int32_t AddPendingNodeState(const NodeStateBatchItem *item)
+{
+    PendingNodeStateItem *pending = FindDuplicateNodeState(item);
+    if (pending != NULL) {
+        pending->item = *item;
+        return SOFTBUS_OK;
+    }
+    pending = (PendingNodeStateItem *)SoftBusCalloc(sizeof(PendingNodeStateItem));
+    if (pending == NULL) {
+        LNN_LOGE(LNN_EVENT, "malloc pending node state fail");
+        return SOFTBUS_MALLOC_ERR;
+    }
+    pending->item = *item;
+    ListTailInsert(&g_pendingNodeState.list, &pending->node);
+    g_pendingNodeState.cnt++;
+    return SOFTBUS_OK;
+}
+
+static void ClearPendingNodeState(void)
+{
+    PendingNodeStateItem *pending = NULL;
+    PendingNodeStateItem *next = NULL;
+    LIST_FOR_EACH_ENTRY_SAFE(pending, next, &g_pendingNodeState.list, PendingNodeStateItem, node) {
+        ListDelete(&pending->node);
+        SoftBusFree(pending);
+    }
+    g_pendingNodeState.cnt = 0;
+    g_pendingNodeState.isFlushPosted = false;
+}
+
+static void FlushPendingNodeState(void)
+{
+    g_pendingNodeState.isFlushPosted = false;
+    if (g_pendingNodeState.cnt == 0) {
+        return;
+    }
+    uint32_t num = 0;
+    PendingNodeStateItem *pending = NULL;
+    NodeStateBatchItem *items =
+        (NodeStateBatchItem *)SoftBusCalloc(sizeof(NodeStateBatchItem) * g_pendingNodeState.cnt);
+    if (items == NULL) {
+        LNN_LOGE(LNN_EVENT, "malloc node state batch fail, notify one by one");
+        LIST_FOR_EACH_ENTRY(pending, &g_pendingNodeState.list, PendingNodeStateItem, node) {
+            (void)LnnIpcNotifyNodeStateBatch(&pending->item, 1);
+        }
+        ClearPendingNodeState();
+        return;
+    }
+    LIST_FOR_EACH_ENTRY(pending, &g_pendingNodeState.list, PendingNodeStateItem, node) {
+        items[num++] = pending->item;
+    }
+    ClearPendingNodeState();
+    LNN_LOGI(LNN_EVENT, "flush node state batch, num=%{public}u", num);
+    (void)LnnIpcNotifyNodeStateBatch(items, num);
+    SoftBusFree(items);
+}
+
+static void NotifyNodeState(int32_t event, int32_t type, const NodeBasicInfo *info)
+{
+    NodeStateBatchItem item = {
+        .event = event,
+        .type = type,
+        .info = *info,
+    };
+    uint32_t window = GetNotifyBatchWindow();
+    if (window == 0) {
+        NotifyNodeStateImmediately(&item);
+        return;
+    }
+    // only clients that registered for batches wait for the window, the others are notified right away
+    (void)LnnIpcNotifyNodeStateNoBatch(&item);
+    if (AddPendingNodeState(&item) != SOFTBUS_OK) {
+        FlushPendingNodeState();
+        (void)LnnIpcNotifyNodeStateBatch(&item, 1);
+        return;
+    }
+    if (g_pendingNodeState.cnt >= NODE_STATE_BATCH_MAX_NUM) {
+        RemoveNotifyMessage(NOTIFY_NODE_STATE_BATCH_FLUSH);
+        FlushPendingNodeState();
+        return;
+    }
+    if (g_pendingNodeState.isFlushPosted) {
+        return;
+    }
+    if (PostNotifyMessageDelay(NOTIFY_NODE_STATE_BATCH_FLUSH, window) != SOFTBUS_OK) {
+        FlushPendingNodeState();
+        return;
+    }
+    g_pendingNodeState.isFlushPosted = true;
+}
+
 static void HandleOnlineStateChangedMessage(SoftBusMessage *msg)
 {
     if (msg->obj == NULL) {
@@ -106,7 +265,7 @@ static void HandleOnlineStateChangedMessage(SoftBusMessage *msg)
         return;
     }
     bool isOnline = (bool)msg->arg1;
-    LnnIpcNotifyOnlineState(isOnline, msg->obj, sizeof(NodeBasicInfo));
+    NotifyNodeState(isOnline ? NODE_STATE_BATCH_ONLINE : NODE_STATE_BATCH_OFFLINE, 0, (NodeBasicInfo *)msg->obj);
     LnnDCProcessOnlineState(isOnline, (NodeBasicInfo *)msg->obj);
 }
 
@@ -128,7 +287,7 @@ static void HandleNodeBasicInfoChangedMessage(SoftBusMessage *msg)
         return;
     }
     int32_t type = (int32_t)msg->arg1;
-    LnnIpcNotifyBasicInfoChanged(msg->obj, sizeof(NodeBasicInfo), type);
+    NotifyNodeState(NODE_STATE_BATCH_BASIC_INFO_CHANGED, type, (NodeBasicInfo *)msg->obj);
 }
 
 static void HandleNodeStatusChangedMessage(SoftBusMessage *msg)
@@ -200,6 +359,9 @@ static void HandleNotifyMessage(SoftBusMessage *msg)
         case NOTIFY_STATE_SESSION:
             HandleStateSessionMessage(msg);
             break;
+        case NOTIFY_NODE_STATE_BATCH_FLUSH:
+            FlushPendingNodeState();
+            break;
         default:
             LNN_LOGE(LNN_EVENT, "unknown notify msgType=%{public}d", msg->what);
             break;
@@ -690,6 +852,16 @@ void LnnNotifyDataShareStateChangeEvent(SoftBusDataShareState state)
     NotifyEvent((const LnnEventBasicInfo *)&event);
 }
 
+void LnnNotifyBatteryStateChangeEvent(int32_t level, bool isCharging)
+{
+    LnnMonitorBatteryStateChangedEvent event = {
+        .basic.event = LNN_EVENT_BATTERY_STATE_CHANGED,
+        .level = level,
+        .isCharging = isCharging,
+    };
+    NotifyEvent((const LnnEventBasicInfo *)&event);
+}
+
 void LnnNotifyAccountStateChangeEvent(SoftBusAccountState state)
 {
     if (state < SOFTBUS_ACCOUNT_LOG_IN || state >= SOFTBUS_ACCOUNT_UNKNOWN) {
@@ -984,6 +1156,7 @@ void LnnDeinitBusCenterEvent(void)
         g_notifyHandler.looper = NULL;
         g_notifyHandler.HandleMessage = NULL;
     }
+    ClearPendingNodeState();
     SoftBusMutexDestroy(&g_eventCtrl.lock);
 }
 
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NODE_STATE_BATCH_INNER_H
+#define NODE_STATE_BATCH_INNER_H
+
+#include <stdint.h>
+#include "softbus_bus_center.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif
+#endif
+
+#define NODE_STATE_BATCH_MAX_NUM 64
+
+typedef enum {
+    NODE_STATE_BATCH_OFFLINE = 0,
+    NODE_STATE_BATCH_ONLINE,
+    NODE_STATE_BATCH_BASIC_INFO_CHANGED,
+    NODE_STATE_BATCH_EVENT_BUTT,
+} NodeStateBatchEvent;
+
+typedef struct {
+    int32_t event;
+    int32_t type; /* NodeBasicInfoType, only valid for NODE_STATE_BATCH_BASIC_INFO_CHANGED */
+    NodeBasicInfo info;
+} NodeStateBatchItem;
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* __cplusplus */
+#endif /* NODE_STATE_BATCH_INNER_H */
@@ -90,6 +90,7 @@ enum SoftBusFuncId {
     SERVER_PROCESS_INNER_EVENT,
     SERVER_PRIVILEGE_CLOSE_CHANNEL,
     SERVER_SET_DISPLAY_NAME,
+    SERVER_REG_NODE_STATE_BATCH,
 
     CLIENT_ON_CHANNEL_OPENED = 256,
     CLIENT_ON_CHANNEL_OPENFAILED,
@@ -120,6 +121,7 @@ enum SoftBusFuncId {
     CLIENT_ON_CHANNEL_BIND,
     CLIENT_CHANNEL_ON_QOS,
     CLIENT_CHECK_COLLAB_RELATION,
+    CLIENT_ON_NODE_STATE_BATCH,
     SOFTBUS_FUNC_ID_BUIT,
 };
 
@@ -65,6 +65,10 @@
 #define DEFAULT_DISC_FREQ_SUPER_HIGH ((10 << 16) | 48)
 #define DEFAULT_DISC_FREQ_EXTREME_HIGH ((10 << 16) | 48)
 #define DEFAULT_DISC_COAP_MAX_DEVICE_NUM 20
+#define LANE_DETECT_EVIDENCE_TIME 5000
+#define LANE_DETECT_LIVE_LINK_TIME 30000
+#define LNN_NOTIFY_BATCH_WINDOW 50
+#define DISC_FOUND_SUPPRESS_WINDOW 1000
 
 #ifdef SOFTBUS_LINUX
 #define DEFAULT_NEW_BYTES_LEN (4 * 1024 * 1024)
@@ -126,6 +130,11 @@ typedef struct {
     int32_t connBleCloseDelayTime;
     int32_t bleMacAutoRefreshSwitch;
     uint32_t staticCapability;
+    uint32_t laneDetectEvidenceTime;
+    uint32_t laneDetectLiveLinkTime;
+    uint32_t lnnNotifyBatchWindow;
+    bool isSdkNodeInfoCache;
+    uint32_t discFoundSuppressWindow;
 } ConfigItem;
 
 typedef struct {
@@ -159,6 +168,11 @@ ConfigItem g_config = {
     CONN_BLE_CLOSE_DELAY,
     DEFAULT_BLE_MAC_AUTO_REFRESH,
     LNN_STATIC_CAPABILITY,
+    LANE_DETECT_EVIDENCE_TIME,
+    LANE_DETECT_LIVE_LINK_TIME,
+    LNN_NOTIFY_BATCH_WINDOW,
+    true,
+    DISC_FOUND_SUPPRESS_WINDOW,
 };
 
 typedef struct {
@@ -367,6 +381,31 @@ ConfigVal g_configItems[SOFTBUS_CONFIG_TYPE_MAX] = {
         (unsigned char *)&(g_config.staticCapability),
         sizeof(g_config.staticCapability)
     },
+    {
+        SOFTBUS_INT_LANE_DETECT_EVIDENCE_TIME,
+        (unsigned char *)&(g_config.laneDetectEvidenceTime),
+        sizeof(g_config.laneDetectEvidenceTime)
+    },
+    {
+        SOFTBUS_INT_LANE_DETECT_LIVE_LINK_TIME,
+        (unsigned char *)&(g_config.laneDetectLiveLinkTime),
+        sizeof(g_config.laneDetectLiveLinkTime)
+    },
+    {
+        SOFTBUS_INT_LNN_NOTIFY_BATCH_WINDOW,
+        (unsigned char *)&(g_config.lnnNotifyBatchWindow),
+        sizeof(g_config.lnnNotifyBatchWindow)
+    },
+    {
+        SOFTBUS_BOOL_SDK_NODE_INFO_CACHE,
+        (unsigned char *)&(g_config.isSdkNodeInfoCache),
+        sizeof(g_config.isSdkNodeInfoCache)
+    },
+    {
+        SOFTBUS_INT_DISC_FOUND_SUPPRESS_WINDOW,
+        (unsigned char *)&(g_config.discFoundSuppressWindow),
+        sizeof(g_config.discFoundSuppressWindow)
+    },
 };
 
 int SoftbusSetConfig(ConfigType type, const unsigned char *val, uint32_t len)
@@ -16,30 +16,295 @@
 #ifndef INFO_CONTAINER_H
 #define INFO_CONTAINER_H
 
+#include <any>
+#include <array>
+#include <bitset>
 #include <map>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
 
+#include "conn_log.h"
 #include "serializable.h"
 
 namespace OHOS::SoftBus {
+/*
+ * Maps a key to its slot in the flat storage of InfoContainer. Keys are dense from 0 by default, a key enum with
+ * holes or more values specializes it next to its definition. Every key enum asserts next to its definition that
+ * its last key has a slot, a key without one is dropped by Set.
+ */
+template<typename Key>
+struct InfoContainerKeyTraits {
+    static constexpr size_t SLOT_NUM = 32;
+
+    static constexpr size_t ToSlot(Key key)
+    {
+        return static_cast<size_t>(key);
+    }
+    static constexpr Key ToKey(size_t slot)
+    {
+        return static_cast<Key>(slot);
+    }
+};
+
+/*
+ * One field of an InfoContainer. Values up to INLINE_SIZE bytes, which covers the scalars, strings and vectors
+ * carried by the messages, live in the slot itself; only nested containers such as LinkInfo go to the heap.
+ */
+class InfoValue {
+public:
+    static constexpr size_t INLINE_SIZE = 32;
+
+    InfoValue() = default;
+    InfoValue(const InfoValue &other)
+    {
+        CopyFrom(other);
+    }
+    InfoValue(InfoValue &&other) noexcept
+    {
+        MoveFrom(other);
+    }
+    InfoValue &operator=(const InfoValue &other)
+    {
+        if (this != &other) {
+            Reset();
+            CopyFrom(other);
+        }
+        return *this;
+    }
+    InfoValue &operator=(InfoValue &&other) noexcept
+    {
+        if (this != &other) {
+            Reset();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+    ~InfoValue()
+    {
+        Reset();
+    }
+
+    template<typename T>
+    void Emplace(T &&value)
+    {
+        using V = std::decay_t<T>;
+        static_assert(!std::is_same_v<V, std::any>, "store the value itself, not an std::any");
+        Reset();
+        Ops<V>::Construct(storage_, std::forward<T>(value));
+        ops_ = &Ops<V>::TABLE;
+    }
+
+    void Reset()
+    {
+        if (ops_ != nullptr) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+    bool HasValue() const
+    {
+        return ops_ != nullptr;
+    }
+
+    // throws std::bad_any_cast on a type mismatch, as the std::any based storage did
+    template<typename T>
+    const std::remove_cv_t<std::remove_reference_t<T>> &As() const
+    {
+        using V = std::remove_cv_t<std::remove_reference_t<T>>;
+        if (ops_ != &Ops<V>::TABLE && (ops_ == nullptr || ops_->type() != typeid(V))) {
+            throw std::bad_any_cast();
+        }
+        return *Ops<V>::Get(storage_);
+    }
+
+private:
+    struct OpTable {
+        const std::type_info &(*type)();
+        void (*copy)(void *dst, const void *src);
+        void (*move)(void *dst, void *src);
+        void (*destroy)(void *data);
+    };
+
+    template<typename V>
+    struct Ops {
+        static constexpr bool IS_INLINE = sizeof(V) <= INLINE_SIZE && alignof(V) <= alignof(uint64_t) &&
+            std::is_nothrow_move_constructible_v<V>;
+
+        template<typename T>
+        static void Construct(void *data, T &&value)
+        {
+            if constexpr (IS_INLINE) {
+                new (data) V(std::forward<T>(value));
+            } else {
+                *static_cast<V **>(data) = new V(std::forward<T>(value));
+            }
+        }
+        static V *Get(void *data)
+        {
+            if constexpr (IS_INLINE) {
+                return std::launder(static_cast<V *>(data));
+            } else {
+                return *static_cast<V **>(data);
+            }
+        }
+        static const V *Get(const void *data)
+        {
+            return Get(const_cast<void *>(data));
+        }
+        static const std::type_info &Type()
+        {
+            return typeid(V);
+        }
+        static void Copy(void *dst, const void *src)
+        {
+            Construct(dst, *Get(src));
+        }
+        static void Move(void *dst, void *src)
+        {
+            if constexpr (IS_INLINE) {
+                new (dst) V(std::move(*Get(src)));
+                Get(src)->~V();
+            } else {
+                *static_cast<V **>(dst) = Get(src);
+            }
+        }
+        static void Destroy(void *data)
+        {
+            if constexpr (IS_INLINE) {
+                Get(data)->~V();
+            } else {
+                delete Get(data);
+            }
+        }
+
+        static constexpr OpTable TABLE = { Type, Copy, Move, Destroy };
+    };
+
+    void CopyFrom(const InfoValue &other)
+    {
+        if (other.ops_ != nullptr) {
+            other.ops_->copy(storage_, other.storage_);
+            ops_ = other.ops_;
+        }
+    }
+    void MoveFrom(InfoValue &other)
+    {
+        if (other.ops_ != nullptr) {
+            other.ops_->move(storage_, other.storage_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    alignas(uint64_t) unsigned char storage_[INLINE_SIZE] {};
+    const OpTable *ops_ = nullptr;
+};
+
+/*
+ * Flat storage indexed by key with a presence bit per slot. Iterating it visits the present fields in key order,
+ * so marshalling writes them in the same order as before.
+ */
+template<typename Key>
+class InfoValueTable {
+public:
+    using Traits = InfoContainerKeyTraits<Key>;
+    static constexpr size_t SLOT_NUM = Traits::SLOT_NUM;
+
+    class Iterator {
+    public:
+        Iterator(const InfoValueTable *table, size_t slot) : table_(table), slot_(slot)
+        {
+            Skip();
+        }
+        std::pair<Key, const InfoValue &> operator*() const
+        {
+            return { Traits::ToKey(slot_), table_->slots_[slot_] };
+        }
+        Iterator &operator++()
+        {
+            slot_++;
+            Skip();
+            return *this;
+        }
+        bool operator!=(const Iterator &other) const
+        {
+            return slot_ != other.slot_;
+        }
+
+    private:
+        void Skip()
+        {
+            while (slot_ < SLOT_NUM && !table_->present_.test(slot_)) {
+                slot_++;
+            }
+        }
+
+        const InfoValueTable *table_;
+        size_t slot_;
+    };
+
+    static constexpr bool HasSlot(Key key)
+    {
+        return Traits::ToSlot(key) < SLOT_NUM;
+    }
+
+    template<typename T>
+    bool Set(Key key, T &&value)
+    {
+        size_t slot = Traits::ToSlot(key);
+        if (slot >= SLOT_NUM) {
+            return false;
+        }
+        slots_[slot].Emplace(std::forward<T>(value));
+        present_.set(slot);
+        return true;
+    }
+
+    const InfoValue *Find(Key key) const
+    {
+        size_t slot = Traits::ToSlot(key);
+        return slot < SLOT_NUM && present_.test(slot) ? &slots_[slot] : nullptr;
+    }
+
+    Iterator begin() const
+    {
+        return Iterator(this, 0);
+    }
+    Iterator end() const
+    {
+        return Iterator(this, SLOT_NUM);
+    }
+
+private:
+    std::array<InfoValue, SLOT_NUM> slots_;
+    std::bitset<SLOT_NUM> present_;
+};
+
 template<typename Key>
 class InfoContainer {
 protected:
-    void Set(Key key, const std::any &value)
+    template<typename T>
+    void Set(Key key, T &&value)
     {
-        values_[key] = value;
+        if (!values_.Set(key, std::forward<T>(value))) {
+            CONN_LOGW(CONN_WIFI_DIRECT, "no slot for key=%{public}d, drop it", static_cast<int>(key));
+        }
     }
 
     template<typename T>
     T Get(Key key, const T &defaultValue) const
     {
-        const auto it = values_.find(key);
-        return it != values_.end() ? std::any_cast<T>(it->second) : defaultValue;
+        const InfoValue *value = values_.Find(key);
+        return value != nullptr ? value->As<T>() : defaultValue;
     }
 
     using KeyTypeTable = std::map<Key, Serializable::ValueType>;
 
     static KeyTypeTable keyTypeTable_;
-    std::map<Key, std::any> values_;
+    InfoValueTable<Key> values_;
 };
 }
 #endif
@@ -56,6 +56,8 @@ enum class InnerLinKey {
     IS_LEGACY_REUSED = 26,
     REMOTE_PORT = 27,
 };
+static_assert(InfoValueTable<InnerLinKey>::HasSlot(InnerLinKey::REMOTE_PORT),
+    "InnerLinKey outgrows the InfoContainer slots");
 
 struct LinkIdStruct {
     int id;
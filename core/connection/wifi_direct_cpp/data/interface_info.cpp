@@ -59,8 +59,7 @@ void InterfaceInfo::MarshallingString(
     WifiDirectProtocol &protocol, InterfaceInfoKey key, Serializable::ValueType type, const std::string &value)
 {
     if (key == InterfaceInfoKey::DYNAMIC_MAC || key == InterfaceInfoKey::BASE_MAC) {
-        auto macString = std::any_cast<const std::string>(value);
-        auto macArray = WifiDirectUtils::MacStringToArray(macString);
+        auto macArray = WifiDirectUtils::MacStringToArray(value);
         if (!macArray.empty()) {
             protocol.Write(static_cast<int>(key), type, macArray.data(), macArray.size());
         }
@@ -76,7 +75,7 @@ int InterfaceInfo::Marshalling(WifiDirectProtocol &protocol, std::vector<uint8_t
         auto type = keyTypeTable_[key];
         if (protocolType == ProtocolType::TLV &&
             (key == InterfaceInfoKey::DYNAMIC_MAC || key == InterfaceInfoKey::BASE_MAC)) {
-            auto macString = std::any_cast<const std::string>(value);
+            const auto &macString = value.As<std::string>();
             auto macArray = WifiDirectUtils::MacStringToArray(macString);
             if (!macArray.empty()) {
                 protocol.Write(static_cast<int>(key), type, macArray.data(), macArray.size());
@@ -86,27 +85,27 @@ int InterfaceInfo::Marshalling(WifiDirectProtocol &protocol, std::vector<uint8_t
 
         switch (type) {
             case Serializable::ValueType::BOOL: {
-                uint8_t data = std::any_cast<bool>(value);
+                uint8_t data = value.As<bool>();
                 protocol.Write(static_cast<int>(key), type, &data, sizeof(data));
                 break;
             }
             case Serializable::ValueType::INT: {
                 std::vector<uint8_t> data;
-                WifiDirectUtils::IntToBytes(std::any_cast<int>(value), sizeof(int), data);
+                WifiDirectUtils::IntToBytes(value.As<int>(), sizeof(int), data);
                 protocol.Write(static_cast<int>(key), type, data.data(), data.size());
                 break;
             }
             case Serializable::ValueType::BYTE_ARRAY: {
-                const auto &data = std::any_cast<const std::vector<uint8_t> &>(value);
+                const auto &data = value.As<const std::vector<uint8_t> &>();
                 protocol.Write(static_cast<int>(key), type, data.data(), data.size());
                 break;
             }
             case Serializable::ValueType::STRING: {
-                MarshallingString(protocol, key, type, std::any_cast<const std::string>(value));
+                MarshallingString(protocol, key, type, value.As<std::string>());
                 break;
             }
             case Serializable::ValueType::IPV4_INFO: {
-                const auto &ipv4Info = std::any_cast<const Ipv4Info &>(value);
+                const auto &ipv4Info = value.As<const Ipv4Info &>();
                 std::vector<uint8_t> ipv4InfoOutput;
                 ipv4Info.Marshalling(ipv4InfoOutput);
                 protocol.Write(static_cast<int>(key), type, ipv4InfoOutput.data(), ipv4InfoOutput.size());
@@ -55,6 +55,8 @@ enum class InterfaceInfoKey {
     LINK_MODE = 28,
     LISTEN_MODULE = 29,
 };
+static_assert(InfoValueTable<InterfaceInfoKey>::HasSlot(InterfaceInfoKey::LISTEN_MODULE),
+    "InterfaceInfoKey outgrows the InfoContainer slots");
 
 class InterfaceInfo : public Serializable, public InfoContainer<InterfaceInfoKey> {
 public:
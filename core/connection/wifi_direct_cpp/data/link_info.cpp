@@ -61,23 +61,23 @@ int LinkInfo::Marshalling(WifiDirectProtocol &protocol, std::vector<uint8_t> &ou
         auto type = keyTypeTable_[key];
         switch (type) {
             case Serializable::ValueType::BOOL: {
-                uint8_t data = std::any_cast<bool>(value);
+                uint8_t data = value.As<bool>();
                 protocol.Write(static_cast<int>(key), type, &data, sizeof(data));
             }
                 break;
             case Serializable::ValueType::INT: {
                 std::vector<uint8_t> data;
-                WifiDirectUtils::IntToBytes(std::any_cast<int>(value), sizeof(int), data);
+                WifiDirectUtils::IntToBytes(value.As<int>(), sizeof(int), data);
                 protocol.Write(static_cast<int>(key), type, data.data(), data.size());
             }
                 break;
             case Serializable::ValueType::STRING: {
-                const auto &data = std::any_cast<const std::string &>(value);
+                const auto &data = value.As<const std::string &>();
                 protocol.Write(static_cast<int>(key), type, (uint8_t *)data.c_str(), data.length());
             }
                 break;
             case Serializable::ValueType::IPV4_INFO: {
-                const auto &ipv4Info = std::any_cast<const Ipv4Info &>(value);
+                const auto &ipv4Info = value.As<const Ipv4Info &>();
                 std::vector<uint8_t> ipv4InfoOutput;
                 ipv4Info.Marshalling(ipv4InfoOutput);
                 protocol.Write(static_cast<int>(key), type, ipv4InfoOutput.data(), ipv4InfoOutput.size());
@@ -257,7 +257,7 @@ bool LinkInfo::GetIsDhcp() const
 
 void LinkInfo::SetLocalIpv4Info(const Ipv4Info &ipv4Info)
 {
-    Set(LinkInfoKey::LOCAL_IPV4, (const std::any &)ipv4Info);
+    Set(LinkInfoKey::LOCAL_IPV4, ipv4Info);
 }
 
 Ipv4Info LinkInfo::GetLocalIpv4Info() const
@@ -267,7 +267,7 @@ Ipv4Info LinkInfo::GetLocalIpv4Info() const
 
 void LinkInfo::SetRemoteIpv4Info(const Ipv4Info &ipv4Info)
 {
-    Set(LinkInfoKey::REMOTE_IPV4, (const std::any &)ipv4Info);
+    Set(LinkInfoKey::REMOTE_IPV4, ipv4Info);
 }
 
 Ipv4Info LinkInfo::GetRemoteIpv4Info() const
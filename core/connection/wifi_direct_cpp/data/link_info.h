@@ -51,6 +51,8 @@ enum class LinkInfoKey {
     CUSTOM_PORT = 23,
     IPADDR_TYPE = 24,
 };
+static_assert(InfoValueTable<LinkInfoKey>::HasSlot(LinkInfoKey::IPADDR_TYPE),
+    "LinkInfoKey outgrows the InfoContainer slots");
 
 class LinkInfo : public Serializable, public InfoContainer<LinkInfoKey> {
 public:
@@ -163,29 +163,29 @@ int NegotiateMessage::Marshalling(WifiDirectProtocol &protocol, std::vector<uint
         auto type = keyTypeTable_[key];
         switch (type) {
             case Serializable::ValueType::BOOL: {
-                uint8_t data = std::any_cast<bool>(value);
+                uint8_t data = value.As<bool>();
                 protocol.Write(static_cast<int>(key), type, &data, sizeof(data));
             }
                 break;
             case Serializable::ValueType::INT: {
                 std::vector<uint8_t> data;
-                WifiDirectUtils::IntToBytes(std::any_cast<int>(value), sizeof(int), data);
+                WifiDirectUtils::IntToBytes(value.As<int>(), sizeof(int), data);
                 protocol.Write(static_cast<int>(key), type, data.data(), data.size());
             }
                 break;
             case Serializable::ValueType::UINT: {
                 std::vector<uint8_t> data;
-                WifiDirectUtils::IntToBytes(std::any_cast<uint32_t>(value), sizeof(uint32_t), data);
+                WifiDirectUtils::IntToBytes(value.As<uint32_t>(), sizeof(uint32_t), data);
                 protocol.Write(static_cast<int>(key), type, data.data(), data.size());
             }
                 break;
             case Serializable::ValueType::STRING: {
-                auto data = std::any_cast<std::string>(value);
+                const auto &data = value.As<std::string>();
                 protocol.Write(static_cast<int>(key), type, (uint8_t *)data.c_str(), data.length());
             }
                 break;
             case Serializable::ValueType::BYTE_ARRAY: {
-                const auto &data = std::any_cast<const std::vector<uint8_t> &>(value);
+                const auto &data = value.As<const std::vector<uint8_t> &>();
                 protocol.Write(static_cast<int>(key), type, data.data(), data.size());
             }
                 break;
@@ -258,6 +258,10 @@ int NegotiateMessage::Unmarshalling(WifiDirectProtocol &protocol, const std::vec
 
     protocol.SetInput(input);
     while (protocol.Read(key, data, size)) {
+        // a key added by a newer peer has no slot here, skip it quietly
+        if (!InfoValueTable<NegotiateMessageKey>::HasSlot(NegotiateMessageKey(key))) {
+            continue;
+        }
         auto type = keyTypeTable_[static_cast<NegotiateMessageKey>(key)];
         switch (Serializable::ValueType(type)) {
             case Serializable::ValueType::BOOL: {
@@ -132,6 +132,31 @@ enum class NegotiateMessageKey {
     INTERFACE_NAME = 220,
 };
 
+// the old p2p keys follow the new ones in the flat storage, keys in neither range are dropped
+template<>
+struct InfoContainerKeyTraits<NegotiateMessageKey> {
+    static constexpr size_t NEW_KEY_NUM = static_cast<size_t>(NegotiateMessageKey::REMOTE_NETWORK_ID) + 1;
+    static constexpr size_t OLD_KEY_BASE = static_cast<size_t>(NegotiateMessageKey::GC_CHANNEL_LIST);
+    static constexpr size_t OLD_KEY_NUM = static_cast<size_t>(NegotiateMessageKey::INTERFACE_NAME) - OLD_KEY_BASE + 1;
+    static constexpr size_t SLOT_NUM = NEW_KEY_NUM + OLD_KEY_NUM;
+
+    static constexpr size_t ToSlot(NegotiateMessageKey key)
+    {
+        auto value = static_cast<size_t>(key);
+        if (value < NEW_KEY_NUM) {
+            return value;
+        }
+        if (value >= OLD_KEY_BASE && value < OLD_KEY_BASE + OLD_KEY_NUM) {
+            return value - OLD_KEY_BASE + NEW_KEY_NUM;
+        }
+        return SLOT_NUM;
+    }
+    static constexpr NegotiateMessageKey ToKey(size_t slot)
+    {
+        return static_cast<NegotiateMessageKey>(slot < NEW_KEY_NUM ? slot : slot - NEW_KEY_NUM + OLD_KEY_BASE);
+    }
+};
+
 class NegotiateMessage : public Serializable, public InfoContainer<NegotiateMessageKey> {
 public:
     NegotiateMessage();
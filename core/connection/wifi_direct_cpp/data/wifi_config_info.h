@@ -43,6 +43,8 @@ enum class WifiConfigInfoKey {
     INTERFACE_INFO_ARRAY = 20,
     WC_KEY_MAX,
 };
+static_assert(static_cast<size_t>(WifiConfigInfoKey::WC_KEY_MAX) <= InfoValueTable<WifiConfigInfoKey>::SLOT_NUM,
+    "WifiConfigInfoKey outgrows the InfoContainer slots");
 
 class WifiConfigInfo : public Serializable, public InfoContainer<WifiConfigInfoKey> {
 public:
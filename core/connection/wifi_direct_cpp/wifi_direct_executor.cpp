@@ -39,17 +39,22 @@ WifiDirectExecutor::~WifiDirectExecutor()
     CONN_LOGI(CONN_WIFI_DIRECT, "remoteDeviceId=%{public}s", WifiDirectAnonymizeDeviceId(remoteDeviceId_).c_str());
 }
 
-void WifiDirectExecutor::Start()
+bool WifiDirectExecutor::Start()
 {
     if (started_) {
         CONN_LOGI(CONN_WIFI_DIRECT, "remoteDeviceId=%{public}s repeat start, ignore",
             WifiDirectAnonymizeDeviceId(remoteDeviceId_).c_str());
-        return;
+        return true;
+    }
+    // the task drains this executor's events until the scheduler has no next command for it
+    std::shared_ptr<WifiDirectProcessor> processor = processor_;
+    if (!scheduler_.SubmitExecutorTask([this, processor]() { Run(processor); })) {
+        CONN_LOGE(CONN_WIFI_DIRECT, "remoteDeviceId=%{public}s submit failed",
+            WifiDirectAnonymizeDeviceId(remoteDeviceId_).c_str());
+        return false;
     }
     started_ = true;
-    std::thread thread(&WifiDirectExecutor::Run, this, processor_);
-    thread_.swap(thread);
-    thread_.detach();
+    return true;
 }
 
 void WifiDirectExecutor::Run(std::shared_ptr<WifiDirectProcessor> processor)
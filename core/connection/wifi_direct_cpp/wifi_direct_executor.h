@@ -18,8 +18,8 @@
 #include <condition_variable>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <queue>
-#include <thread>
 
 #include "dfx/wifi_direct_trace.h"
 #include "event/wifi_direct_event_receiver.h"
@@ -34,7 +34,7 @@ public:
                                 std::shared_ptr<WifiDirectProcessor> &processor, bool active);
     virtual ~WifiDirectExecutor();
 
-    void Start();
+    bool Start();
     void Run(std::shared_ptr<WifiDirectProcessor> processor);
     std::string GetRemoteDeviceId();
     void SetRemoteDeviceId(const std::string &remoteDeviceId);
@@ -68,7 +68,6 @@ protected:
     WifiDirectScheduler &scheduler_;
     std::recursive_mutex processorLock_;
     std::shared_ptr<WifiDirectProcessor> processor_;
-    std::thread thread_;
 
     bool active_;
 
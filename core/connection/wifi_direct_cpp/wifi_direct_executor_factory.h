@@ -36,11 +36,9 @@ public:
     std::shared_ptr<WifiDirectExecutor> NewExecutor(const std::string &remoteDeviceId, WifiDirectScheduler &scheduler,
         std::shared_ptr<WifiDirectProcessor> &processor, bool active)
     {
-        std::shared_ptr<WifiDirectExecutor> executor = (executorGenerator_ == nullptr) ?
+        return (executorGenerator_ == nullptr) ?
             std::make_shared<WifiDirectExecutor>(remoteDeviceId, scheduler, processor, active) :
             executorGenerator_(remoteDeviceId, scheduler, processor, active);
-        executor->Start();
-        return executor;
     }
 
     void Register(ExecutorGenerator generator)
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "wifi_direct_executor_pool.h"
+
+#include <pthread.h>
+
+#include "conn_log.h"
+
+namespace OHOS::SoftBus {
+WifiDirectExecutorPool::WifiDirectExecutorPool(size_t maxWorkerNum)
+    : maxWorkerNum_(maxWorkerNum), state_(std::make_shared<State>())
+{
+}
+
+WifiDirectExecutorPool::~WifiDirectExecutorPool()
+{
+    std::unique_lock lock(state_->lock);
+    state_->stopped = true;
+    state_->cv.notify_all();
+    if (state_->workers.size() == state_->idleNum && state_->tasks.empty()) {
+        lock.unlock();
+        Stop();
+        return;
+    }
+    // a processor waiting for its peer cannot be interrupted, do not hold the process exit on it; the detached
+    // workers keep the state alive and exit after their current task instead of starting the queued ones
+    CONN_LOGW(CONN_WIFI_DIRECT,
+        "detach busy workers, workerNum=%{public}zu, idleNum=%{public}zu, taskNum=%{public}zu",
+        state_->workers.size(), state_->idleNum, state_->tasks.size());
+    state_->tasks.clear();
+    for (auto &worker : state_->workers) {
+        worker.detach();
+    }
+    state_->workers.clear();
+}
+
+bool WifiDirectExecutorPool::Submit(Task task)
+{
+    std::lock_guard lock(state_->lock);
+    if (state_->stopped) {
+        CONN_LOGE(CONN_WIFI_DIRECT, "executor pool stopped");
+        return false;
+    }
+    state_->tasks.push_back(std::move(task));
+    if (state_->tasks.size() > state_->idleNum && state_->workers.size() < maxWorkerNum_) {
+        state_->workers.emplace_back(&WifiDirectExecutorPool::WorkerLoop, state_);
+        CONN_LOGI(CONN_WIFI_DIRECT, "add worker, workerNum=%{public}zu", state_->workers.size());
+    }
+    state_->cv.notify_one();
+    return true;
+}
+
+void WifiDirectExecutorPool::WorkerLoop(std::shared_ptr<State> state)
+{
+    const std::string threadName = "OS_wdExecutor";
+    pthread_setname_np(pthread_self(), threadName.c_str());
+    std::unique_lock lock(state->lock);
+    while (true) {
+        state->idleNum++;
+        state->cv.wait(lock, [&state]() { return state->stopped || !state->tasks.empty(); });
+        state->idleNum--;
+        if (state->tasks.empty()) {
+            break;
+        }
+        Task task = std::move(state->tasks.front());
+        state->tasks.pop_front();
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+void WifiDirectExecutorPool::Stop()
+{
+    std::vector<std::thread> workers;
+    {
+        std::lock_guard lock(state_->lock);
+        state_->stopped = true;
+        workers.swap(state_->workers);
+    }
+    state_->cv.notify_all();
+    for (auto &worker : workers) {
+        if (worker.get_id() == std::this_thread::get_id()) {
+            worker.detach();
+            continue;
+        }
+        worker.join();
+    }
+}
+
+size_t WifiDirectExecutorPool::GetWorkerNum()
+{
+    std::lock_guard lock(state_->lock);
+    return state_->workers.size();
+}
+} // namespace OHOS::SoftBus
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIFI_DIRECT_EXECUTOR_POOL_H
+#define WIFI_DIRECT_EXECUTOR_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OHOS::SoftBus {
+/*
+ * Worker threads running executors. A worker is created when a task finds no idle one, up to maxWorkerNum, and
+ * stays for the next negotiation instead of exiting with its executor.
+ */
+class WifiDirectExecutorPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit WifiDirectExecutorPool(size_t maxWorkerNum);
+    ~WifiDirectExecutorPool();
+
+    WifiDirectExecutorPool(const WifiDirectExecutorPool &) = delete;
+    WifiDirectExecutorPool &operator=(const WifiDirectExecutorPool &) = delete;
+
+    bool Submit(Task task);
+    // runs the queued tasks to the end and joins every worker
+    void Stop();
+    size_t GetWorkerNum();
+
+private:
+    // owned by the pool and by every worker, so a worker detached by the destructor never outlives it
+    struct State {
+        std::mutex lock;
+        std::condition_variable cv;
+        std::deque<Task> tasks;
+        std::vector<std::thread> workers;
+        size_t idleNum = 0;
+        bool stopped = false;
+    };
+
+    static void WorkerLoop(std::shared_ptr<State> state);
+
+    const size_t maxWorkerNum_;
+    std::shared_ptr<State> state_;
+};
+} // namespace OHOS::SoftBus
+#endif
@@ -176,6 +176,11 @@ int WifiDirectScheduler::ScheduleActiveCommand(const std::shared_ptr<WifiDirectC
     }
 
     executorManager_.Insert(remoteDeviceId, executor);
+    if (!executor->Start()) {
+        executorManager_.Erase(remoteDeviceId);
+        executor = nullptr;
+        return SOFTBUS_PTHREAD_ERR;
+    }
     return SOFTBUS_OK;
 }
 
@@ -31,6 +31,7 @@
 #include "wifi_direct_executor_factory.h"
 #include "wifi_direct_types.h"
 #include "wifi_direct_executor_manager.h"
+#include "wifi_direct_executor_pool.h"
 
 namespace OHOS::SoftBus {
 class WifiDirectSchedulerFactory;
@@ -82,6 +83,11 @@ public:
             return;
         }
         executorManager_.Insert(remoteDeviceId, executor);
+        if (!executor->Start()) {
+            executorManager_.Erase(remoteDeviceId);
+            CONN_LOGE(CONN_WIFI_DIRECT, "start executor failed, drop commandId=%{public}u", command.GetId());
+            return;
+        }
         CONN_LOGI(CONN_WIFI_DIRECT, "send command to executor=%{public}s, commandId=%{public}d",
                   aDeviceId.c_str(), command.GetId());
         executor->SendEvent(std::make_shared<Command>(command));
@@ -162,6 +168,11 @@ public:
 
     void Dump(std::list<std::shared_ptr<ProcessorSnapshot>> &snapshots);
 
+    bool SubmitExecutorTask(WifiDirectExecutorPool::Task task)
+    {
+        return executorPool_.Submit(std::move(task));
+    }
+
 protected:
     int ScheduleActiveCommand(const std::shared_ptr<WifiDirectCommand> &command,
                               std::shared_ptr<WifiDirectExecutor> &executor);
@@ -172,6 +183,9 @@ protected:
     WifiDirectExecutorManager executorManager_;
     std::recursive_mutex commandLock_;
     std::list<std::shared_ptr<WifiDirectCommand>> commandList_;
+    // at most MAX_EXECUTOR executors exist at a time, so each one gets a worker; declared last so the workers
+    // are joined before the executors they run are released
+    WifiDirectExecutorPool executorPool_ { MAX_EXECUTOR };
 
 private:
     friend WifiDirectSchedulerFactory;
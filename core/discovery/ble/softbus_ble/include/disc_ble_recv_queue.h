@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISC_BLE_RECV_QUEUE_H
+#define DISC_BLE_RECV_QUEUE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "softbus_broadcast_type.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif
+#endif
+
+#define DISC_BLE_RECV_SLOT_NUM 64
+// large enough for a legacy advertisement, discovery packets never exceed it
+#define DISC_BLE_RECV_PAYLOAD_MAX_LEN 32
+
+/*
+ * Hands scan results from the bluetooth callback thread to a worker. Push only copies the report
+ * into a preallocated slot and links it into a lock free ring, the worker drains the ring. When
+ * the ring is half full, advertisements seen recently are shed before anything else is dropped.
+ */
+typedef struct DiscBleRecvQueue DiscBleRecvQueue;
+
+typedef struct {
+    uint32_t pushed;
+    uint32_t processed;
+    uint32_t droppedDuplicate;
+    uint32_t droppedFull;
+    uint32_t droppedInvalid;
+} DiscBleRecvQueueStats;
+
+typedef void (*DiscBleRecvHandler)(const BroadcastReportInfo *reportInfo);
+
+DiscBleRecvQueue *DiscBleCreateRecvQueue(uint32_t slotNum);
+void DiscBleDestroyRecvQueue(DiscBleRecvQueue *queue);
+// called on the callback thread, needWake is set when the worker has to be scheduled
+int32_t DiscBleRecvQueuePush(DiscBleRecvQueue *queue, const BroadcastReportInfo *reportInfo, bool *needWake);
+// called on the worker, returns the number of reports handled
+uint32_t DiscBleRecvQueueDrain(DiscBleRecvQueue *queue, DiscBleRecvHandler handler);
+void DiscBleRecvQueueGetStats(const DiscBleRecvQueue *queue, DiscBleRecvQueueStats *stats);
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* __cplusplus */
+#endif /* DISC_BLE_RECV_QUEUE_H */
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISC_BLE_SCAN_POLICY_H
+#define DISC_BLE_SCAN_POLICY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif
+#endif
+
+// length of one evaluation period of the scan policy
+#define SCAN_POLICY_EPOCH_MS 2000
+#define SCAN_POLICY_SEEN_NUM 32
+// new devices within one epoch which make the scanner jump straight to the upper bound
+#define SCAN_POLICY_BURST_NEW_DEVICES 3
+// quiet epochs needed before the duty cycle is lowered by one level
+#define SCAN_POLICY_HOLD_EPOCHS 3
+#define SCAN_POLICY_MAX_EXTRA_HOLD 4
+
+typedef struct {
+    int32_t minFreq;
+    int32_t maxFreq;
+} ScanFreqBound;
+
+/*
+ * Picks the scan duty cycle, an ExchangeFreq level, inside the bound given by the subscribers.
+ * A new subscriber or new devices raise the level at once; when nothing new is heard the level
+ * is lowered one step after a number of quiet epochs, which grows with the subscriber count.
+ */
+typedef struct {
+    ScanFreqBound bound;
+    int32_t curFreq;
+    uint32_t subscriberCnt;
+    uint32_t epochResults;
+    uint32_t epochNewDevices;
+    uint32_t quietScore;
+    uint32_t seen[SCAN_POLICY_SEEN_NUM];
+    uint32_t seenPos;
+} DiscBleScanPolicy;
+
+void DiscBleScanPolicyInit(DiscBleScanPolicy *policy);
+// returns true when the scan level changed and the scanner needs new parameters
+bool DiscBleScanPolicySetBound(DiscBleScanPolicy *policy, const ScanFreqBound *bound, uint32_t subscriberCnt);
+void DiscBleScanPolicyOnResult(DiscBleScanPolicy *policy, const uint8_t *devKey, uint32_t keyLen);
+// called once per SCAN_POLICY_EPOCH_MS, returns true when the scan level changed
+bool DiscBleScanPolicyOnEpoch(DiscBleScanPolicy *policy);
+int32_t DiscBleScanPolicyGetFreq(const DiscBleScanPolicy *policy);
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* __cplusplus */
+#endif /* DISC_BLE_SCAN_POLICY_H */
@@ -23,6 +23,8 @@
 #include "broadcast_dfx_event.h"
 #include "common_list.h"
 #include "disc_ble_constant.h"
+#include "disc_ble_recv_queue.h"
+#include "disc_ble_scan_policy.h"
 #include "disc_ble_utils.h"
 #include "disc_event.h"
 #include "disc_log.h"
@@ -72,6 +74,9 @@
 #define BIT_CON 0x80
 #define BIT_CON_POS 7
 
+#define BLE_RECV_LOOPER_NAME "BleDiscRecv_Lp"
+#define DRAIN_RECV_QUEUE 0
+
 #define BLE_INFO_MANAGER "bleInfoManager"
 #define BlE_ADVERTISER "bleAdvertiser"
 #define RECV_MESSAGE_INFO "recvMessageInfo"
@@ -96,6 +101,7 @@ typedef enum {
     DFX_DELAY_RECORD,
     BR_STATE_CHANGED,
     HANDLE_REPORT,
+    SCAN_POLICY_EPOCH,
 } DiscBleMessage;
 
 typedef enum {
@@ -195,12 +201,24 @@ static ScanSetting g_scanTable[FREQ_BUTT] = {
     {SOFTBUS_BC_SCAN_WINDOW_P100, SOFTBUS_BC_SCAN_INTERVAL_P100}
 };
 
+// how many levels below the requested freq the adaptive scan may go, indexed like g_bleInfoManager
+static const int32_t g_scanFreqFloorSteps[BLE_INFO_COUNT] = {
+    FREQ_BUTT,  // BLE_PUBLISH | BLE_ACTIVE, does not scan so never holds the scan freq up
+    0,          // BLE_PUBLISH | BLE_PASSIVE, has to answer active discovery in time
+    2,          // BLE_SUBSCRIBE | BLE_ACTIVE
+    FREQ_BUTT,  // BLE_SUBSCRIBE | BLE_PASSIVE
+};
+
 static DiscInnerCallback *g_discBleInnerCb = NULL;
 static DiscBleInfo g_bleInfoManager[BLE_INFO_COUNT];
 static SoftBusMutex g_bleInfoLock = {0};
 static DiscBleAdvertiser g_bleAdvertiser[NUM_ADVERTISER];
 static bool g_isScanning = false;
+static DiscBleScanPolicy g_scanPolicy;
+static bool g_scanEpochPending = false;
 static SoftBusHandler g_discBleHandler = {};
+static SoftBusHandler g_discBleRecvHandler = {};
+static DiscBleRecvQueue *g_recvQueue = NULL;
 static RecvMessageInfo g_recvMessageInfo = {};
 static DiscBleListener g_bleListener = {
     .stateListenerId = -1,
@@ -576,6 +594,10 @@ static void ProcessDistributePacket(const BroadcastReportInfo *reportInfo)
     if ((advData[POS_BUSINESS_EXTENSION] & BIT_HEART_BIT) != 0) {
         return;
     }
+    if (SoftBusMutexLock(&g_bleInfoLock) == SOFTBUS_OK) {
+        DiscBleScanPolicyOnResult(&g_scanPolicy, reportInfo->addr.addr, BC_ADDR_MAC_LEN);
+        (void)SoftBusMutexUnlock(&g_bleInfoLock);
+    }
     if ((advData[POS_BUSINESS_EXTENSION] & BIT_CON) != 0) {
         ProcessDisConPacket(reportInfo, &foundInfo);
     } else {
@@ -598,11 +620,8 @@ static void AccumulateBleScanNum(uint32_t capabilityBitmap)
     }
 }
 
-static void BleScanResultCallback(int listenerId, const BroadcastReportInfo *reportInfo)
+static void ProcessScanResult(const BroadcastReportInfo *reportInfo)
 {
-    (void)listenerId;
-    DISC_CHECK_AND_RETURN_LOGE(listenerId == g_bleListener.scanListenerId, DISC_BLE, "listenerId not match");
-    DISC_CHECK_AND_RETURN_LOGE(reportInfo != NULL, DISC_BLE, "scan result is null");
     DISC_CHECK_AND_RETURN_LOGD(ScanFilter(reportInfo) == SOFTBUS_OK, DISC_BLE, "scan filter failed");
 
     uint8_t *advData = reportInfo->packet.bcData.payload;
@@ -615,6 +634,29 @@ static void BleScanResultCallback(int listenerId, const BroadcastReportInfo *rep
     }
 }
 
+static void BleRecvMsgHandler(SoftBusMessage *msg)
+{
+    if (msg->what == DRAIN_RECV_QUEUE) {
+        (void)DiscBleRecvQueueDrain(g_recvQueue, ProcessScanResult);
+    }
+}
+
+// runs on the bluetooth callback thread, only queues the result for the receive looper
+static void BleScanResultCallback(int listenerId, const BroadcastReportInfo *reportInfo)
+{
+    DISC_CHECK_AND_RETURN_LOGE(listenerId == g_bleListener.scanListenerId, DISC_BLE, "listenerId not match");
+    DISC_CHECK_AND_RETURN_LOGE(reportInfo != NULL, DISC_BLE, "scan result is null");
+    bool needWake = false;
+    if (DiscBleRecvQueuePush(g_recvQueue, reportInfo, &needWake) != SOFTBUS_OK || !needWake) {
+        return;
+    }
+    SoftBusMessage *msg = (SoftBusMessage *)SoftBusCalloc(sizeof(SoftBusMessage));
+    DISC_CHECK_AND_RETURN_LOGE(msg != NULL, DISC_BLE, "malloc msg failed");
+    msg->what = DRAIN_RECV_QUEUE;
+    msg->handler = &g_discBleRecvHandler;
+    g_discBleRecvHandler.looper->PostMessage(g_discBleRecvHandler.looper, msg);
+}
+
 static void BleOnScanStart(int listenerId, int status)
 {
     DISC_CHECK_AND_RETURN_LOGE(listenerId == g_bleListener.scanListenerId, DISC_BLE,
@@ -1213,6 +1255,8 @@ static int32_t UpdateAdvertiser(int32_t adv)
 static void InitScanner(void)
 {
     g_isScanning = false;
+    g_scanEpochPending = false;
+    DiscBleScanPolicyInit(&g_scanPolicy);
 }
 
 static int32_t GetScannerParam(int32_t freq, BcScanParams *scanParam)
@@ -1244,18 +1288,95 @@ static void UpdateScannerFilter(bool isStopScan)
     DiscBleSetScanFilter(g_bleListener.scanListenerId);
 }
 
+static void PostScanPolicyEpoch(void)
+{
+    if (g_scanEpochPending) {
+        return;
+    }
+    SoftBusMessage *msg = CreateBleHandlerMsg(SCAN_POLICY_EPOCH, 0, 0, NULL);
+    DISC_CHECK_AND_RETURN_LOGE(msg != NULL, DISC_BLE, "create msg failed");
+    g_discBleHandler.looper->PostMessageDelay(g_discBleHandler.looper, msg, SCAN_POLICY_EPOCH_MS);
+    g_scanEpochPending = true;
+}
+
+static void GetScanFreqBound(ScanFreqBound *bound, uint32_t *subscriberCnt)
+{
+    bound->maxFreq = GetMaxExchangeFreq();
+    bound->minFreq = LOW;
+    *subscriberCnt = 0;
+    for (uint32_t index = 0; index < BLE_INFO_COUNT; index++) {
+        for (uint32_t pos = 0; pos < CAPABILITY_MAX_BITNUM; pos++) {
+            int32_t freq = g_bleInfoManager[index].freq[pos];
+            if (freq < 0) {
+                continue;
+            }
+            int32_t floor = freq - g_scanFreqFloorSteps[index];
+            bound->minFreq = (bound->minFreq > floor) ? bound->minFreq : floor;
+            if ((index & BLE_SUBSCRIBE) != 0 && g_bleInfoManager[index].capCount[pos] > 0) {
+                *subscriberCnt += (uint32_t)g_bleInfoManager[index].capCount[pos];
+            }
+        }
+    }
+}
+
+// returns true when the scan freq has to be applied to a running scanner
+static bool UpdateScanPolicyBound(int32_t *freq)
+{
+    ScanFreqBound bound;
+    uint32_t subscriberCnt = 0;
+    DISC_CHECK_AND_RETURN_RET_LOGE(SoftBusMutexLock(&g_bleInfoLock) == SOFTBUS_OK, false, DISC_BLE, "lock failed");
+    GetScanFreqBound(&bound, &subscriberCnt);
+    bool changed = DiscBleScanPolicySetBound(&g_scanPolicy, &bound, subscriberCnt);
+    *freq = DiscBleScanPolicyGetFreq(&g_scanPolicy);
+    (void)SoftBusMutexUnlock(&g_bleInfoLock);
+    return changed;
+}
+
+static void ResetScanPolicy(void)
+{
+    DISC_CHECK_AND_RETURN_LOGE(SoftBusMutexLock(&g_bleInfoLock) == SOFTBUS_OK, DISC_BLE, "lock failed");
+    DiscBleScanPolicyInit(&g_scanPolicy);
+    (void)SoftBusMutexUnlock(&g_bleInfoLock);
+}
+
+static void ScanPolicyEpoch(SoftBusMessage *msg)
+{
+    (void)msg;
+    g_scanEpochPending = false;
+    if (!g_isScanning || !CheckScanner()) {
+        return;
+    }
+    DISC_CHECK_AND_RETURN_LOGE(SoftBusMutexLock(&g_bleInfoLock) == SOFTBUS_OK, DISC_BLE, "lock failed");
+    bool changed = DiscBleScanPolicyOnEpoch(&g_scanPolicy);
+    int32_t freq = DiscBleScanPolicyGetFreq(&g_scanPolicy);
+    (void)SoftBusMutexUnlock(&g_bleInfoLock);
+    if (changed) {
+        BcScanParams scanParam;
+        (void)GetScannerParam(freq, &scanParam);
+        // the broadcast manager applies new parameters to a running scan in place
+        int32_t ret = SchedulerStartScan(g_bleListener.scanListenerId, &scanParam);
+        if (ret != SOFTBUS_OK) {
+            DISC_LOGE(DISC_BLE, "update scan param failed, ret=%{public}d", ret);
+        }
+    }
+    PostScanPolicyEpoch();
+}
+
 static void StartScaner()
 {
     if (!CheckScanner()) {
         DISC_LOGI(DISC_BLE, "no need to start scanner");
         (void)StopScaner();
+        ResetScanPolicy();
         return;
     }
 
+    int32_t freq = LOW;
+    bool freqChanged = UpdateScanPolicyBound(&freq);
     if (g_isScanning) {
         if (GetNeedUpdateScanner()) {
             UpdateScannerFilter(true);
-        } else {
+        } else if (!freqChanged) {
             DISC_LOGI(DISC_BLE, "scanner already start, no need start again");
             return;
         }
@@ -1268,8 +1389,7 @@ static void StartScaner()
     }
 
     BcScanParams scanParam;
-    int32_t maxFreq = GetMaxExchangeFreq();
-    int32_t ret = GetScannerParam(maxFreq, &scanParam);
+    int32_t ret = GetScannerParam(freq, &scanParam);
     DISC_CHECK_AND_RETURN_LOGE(ret == SOFTBUS_OK, DISC_BLE, "GetScannerParam failed");
     ret = SchedulerStartScan(g_bleListener.scanListenerId, &scanParam);
     if (ret != SOFTBUS_OK) {
@@ -1278,6 +1398,7 @@ static void StartScaner()
         return;
     }
     UpdateScannerInfoManager(false);
+    PostScanPolicyEpoch();
     DfxRecordScanEnd(SOFTBUS_OK);
     DISC_LOGD(DISC_BLE, "StartScanner success");
 }
@@ -2025,6 +2146,9 @@ static void DiscBleMsgHandlerExt(SoftBusMessage *msg)
         case HANDLE_REPORT:
             ReportHandle(msg);
             break;
+        case SCAN_POLICY_EPOCH:
+            ScanPolicyEpoch(msg);
+            break;
         default:
             DISC_LOGW(DISC_BLE, "wrong msg what=%{public}d", msg->what);
             break;
@@ -2076,9 +2200,32 @@ static int32_t DiscBleLooperInit(void)
 
     g_discBleHandler.name = (char *)"ble_disc_handler";
     g_discBleHandler.HandleMessage = DiscBleMsgHandler;
+
+    g_recvQueue = DiscBleCreateRecvQueue(DISC_BLE_RECV_SLOT_NUM);
+    DISC_CHECK_AND_RETURN_RET_LOGE(g_recvQueue != NULL, SOFTBUS_MALLOC_ERR, DISC_INIT, "create recv queue fail");
+    g_discBleRecvHandler.looper = CreateNewLooper(BLE_RECV_LOOPER_NAME);
+    if (g_discBleRecvHandler.looper == NULL) {
+        DISC_LOGE(DISC_INIT, "create recv looper fail");
+        DiscBleDestroyRecvQueue(g_recvQueue);
+        g_recvQueue = NULL;
+        return SOFTBUS_LOOPER_ERR;
+    }
+    g_discBleRecvHandler.name = (char *)"ble_disc_recv_handler";
+    g_discBleRecvHandler.HandleMessage = BleRecvMsgHandler;
     return SOFTBUS_OK;
 }
 
+static void DiscBleRecvDeinit(void)
+{
+    if (g_discBleRecvHandler.looper != NULL) {
+        DestroyLooper(g_discBleRecvHandler.looper);
+        g_discBleRecvHandler.looper = NULL;
+        g_discBleRecvHandler.HandleMessage = NULL;
+    }
+    DiscBleDestroyRecvQueue(g_recvQueue);
+    g_recvQueue = NULL;
+}
+
 static void DiscFreeBleScanFilter(BcScanFilter *filter, uint8_t filterSize)
 {
     if (filter == NULL || filterSize == 0) {
@@ -2348,6 +2495,7 @@ void DiscSoftBusBleDeinit(void)
     }
     g_discBleInnerCb = NULL;
     BleListenerDeinit();
+    DiscBleRecvDeinit();
     RecvMessageDeinit();
     DiscBleInfoDeinit();
     AdvertiserDeinit();
@@ -2370,6 +2518,9 @@ static int32_t BleInfoDump(int fd)
         SOFTBUS_DPRINTF(fd, "BleInfo freq                            : %d\n", *(g_bleInfoManager[i].freq));
         SOFTBUS_DPRINTF(fd, "BleInfo rangingRefCnt                   : %d\n", g_bleInfoManager[i].rangingRefCnt);
     }
+    SOFTBUS_DPRINTF(fd, "ScanPolicy freq                         : %d\n", g_scanPolicy.curFreq);
+    SOFTBUS_DPRINTF(fd, "ScanPolicy bound                        : [%d, %d]\n",
+        g_scanPolicy.bound.minFreq, g_scanPolicy.bound.maxFreq);
     (void)SoftBusMutexUnlock(&g_bleInfoLock);
     return SOFTBUS_OK;
 }
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "disc_ble_recv_queue.h"
+
+#include "disc_log.h"
+#include "securec.h"
+#include "softbus_adapter_mem.h"
+#include "softbus_error_code.h"
+#include "softbus_queue.h"
+
+#define FNV_OFFSET_BASIS 2166136261U
+#define FNV_PRIME 16777619U
+#define RECENT_ADV_NUM 128
+#define RECENT_ADV_MASK (RECENT_ADV_NUM - 1)
+#define SHED_WATERMARK_DIVISOR 2
+// a lock free ring of unitNum holds unitNum - 1 nodes, double it so every slot always fits
+#define RING_UNIT_MULTIPLE 2
+
+typedef struct {
+    BroadcastReportInfo reportInfo;
+    uint8_t bcPayload[DISC_BLE_RECV_PAYLOAD_MAX_LEN];
+    uint8_t rspPayload[DISC_BLE_RECV_PAYLOAD_MAX_LEN];
+} DiscBleRecvSlot;
+
+struct DiscBleRecvQueue {
+    LockFreeQueue *readyRing;
+    LockFreeQueue *freeRing;
+    DiscBleRecvSlot *slots;
+    uint32_t slotNum;
+    uint32_t shedWatermark;
+    volatile uint32_t drainPending;
+    // fingerprints of recently queued advertisements, written racily, only used as a hint
+    volatile uint32_t recent[RECENT_ADV_NUM];
+    volatile DiscBleRecvQueueStats stats;
+};
+
+static uint32_t HashBytes(uint32_t hash, const uint8_t *data, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static uint32_t GetAdvFingerprint(const BroadcastReportInfo *reportInfo)
+{
+    uint32_t hash = HashBytes(FNV_OFFSET_BASIS, reportInfo->addr.addr, BC_ADDR_MAC_LEN);
+    if (reportInfo->packet.bcData.payload != NULL) {
+        hash = HashBytes(hash, reportInfo->packet.bcData.payload, reportInfo->packet.bcData.payloadLen);
+    }
+    if (reportInfo->packet.rspData.payload != NULL) {
+        hash = HashBytes(hash, reportInfo->packet.rspData.payload, reportInfo->packet.rspData.payloadLen);
+    }
+    return (hash == 0) ? 1 : hash;
+}
+
+static bool IsPayloadValid(const BroadcastPayload *payload)
+{
+    return payload->payloadLen <= DISC_BLE_RECV_PAYLOAD_MAX_LEN &&
+        (payload->payload != NULL || payload->payloadLen == 0);
+}
+
+static void CopyPayload(BroadcastPayload *dst, uint8_t *buf, const BroadcastPayload *src)
+{
+    *dst = *src;
+    if (src->payload == NULL || src->payloadLen == 0) {
+        dst->payload = NULL;
+        dst->payloadLen = 0;
+        return;
+    }
+    (void)memcpy_s(buf, DISC_BLE_RECV_PAYLOAD_MAX_LEN, src->payload, src->payloadLen);
+    dst->payload = buf;
+}
+
+static void CopyReport(DiscBleRecvSlot *slot, const BroadcastReportInfo *reportInfo)
+{
+    slot->reportInfo = *reportInfo;
+    // the name points into the caller's buffer and is not used by discovery
+    slot->reportInfo.deviceName = NULL;
+    CopyPayload(&slot->reportInfo.packet.bcData, slot->bcPayload, &reportInfo->packet.bcData);
+    CopyPayload(&slot->reportInfo.packet.rspData, slot->rspPayload, &reportInfo->packet.rspData);
+}
+
+DiscBleRecvQueue *DiscBleCreateRecvQueue(uint32_t slotNum)
+{
+    DISC_CHECK_AND_RETURN_RET_LOGE(slotNum > 1 && (slotNum & (slotNum - 1)) == 0, NULL, DISC_BLE,
+        "slotNum must be a power of 2, slotNum=%{public}u", slotNum);
+    DiscBleRecvQueue *queue = (DiscBleRecvQueue *)SoftBusCalloc(sizeof(DiscBleRecvQueue));
+    DISC_CHECK_AND_RETURN_RET_LOGE(queue != NULL, NULL, DISC_BLE, "malloc queue failed");
+    queue->slots = (DiscBleRecvSlot *)SoftBusCalloc(sizeof(DiscBleRecvSlot) * slotNum);
+    queue->readyRing = CreateQueue(slotNum * RING_UNIT_MULTIPLE);
+    queue->freeRing = CreateQueue(slotNum * RING_UNIT_MULTIPLE);
+    if (queue->slots == NULL || queue->readyRing == NULL || queue->freeRing == NULL) {
+        DISC_LOGE(DISC_BLE, "malloc recv queue failed");
+        DiscBleDestroyRecvQueue(queue);
+        return NULL;
+    }
+    queue->slotNum = slotNum;
+    queue->shedWatermark = slotNum / SHED_WATERMARK_DIVISOR;
+    for (uint32_t i = 0; i < slotNum; i++) {
+        (void)QueueSingleProducerEnqueue(queue->freeRing, &queue->slots[i]);
+    }
+    return queue;
+}
+
+void DiscBleDestroyRecvQueue(DiscBleRecvQueue *queue)
+{
+    if (queue == NULL) {
+        return;
+    }
+    SoftBusFree(queue->readyRing);
+    SoftBusFree(queue->freeRing);
+    SoftBusFree(queue->slots);
+    SoftBusFree(queue);
+}
+
+static bool IsRecentAdv(const DiscBleRecvQueue *queue, uint32_t fingerprint)
+{
+    return queue->recent[fingerprint & RECENT_ADV_MASK] == fingerprint;
+}
+
+int32_t DiscBleRecvQueuePush(DiscBleRecvQueue *queue, const BroadcastReportInfo *reportInfo, bool *needWake)
+{
+    DISC_CHECK_AND_RETURN_RET_LOGE(queue != NULL && reportInfo != NULL && needWake != NULL,
+        SOFTBUS_INVALID_PARAM, DISC_BLE, "invalid param");
+    *needWake = false;
+    if (!IsPayloadValid(&reportInfo->packet.bcData) || !IsPayloadValid(&reportInfo->packet.rspData)) {
+        SoftBusAtomicAdd32(&queue->stats.droppedInvalid, 1);
+        return SOFTBUS_INVALID_PARAM;
+    }
+    uint32_t fingerprint = GetAdvFingerprint(reportInfo);
+    uint32_t depth = 0;
+    (void)QueueCountGet(queue->readyRing, &depth);
+    if (depth >= queue->shedWatermark && IsRecentAdv(queue, fingerprint)) {
+        SoftBusAtomicAdd32(&queue->stats.droppedDuplicate, 1);
+        return SOFTBUS_DISCOVER_BLE_RECV_QUEUE_FULL;
+    }
+    void *node = NULL;
+    if (QueueMultiConsumerDequeue(queue->freeRing, &node) != 0) {
+        SoftBusAtomicAdd32(&queue->stats.droppedFull, 1);
+        return SOFTBUS_DISCOVER_BLE_RECV_QUEUE_FULL;
+    }
+    DiscBleRecvSlot *slot = (DiscBleRecvSlot *)node;
+    CopyReport(slot, reportInfo);
+    // every slot fits in the ready ring, it can not be full here
+    (void)QueueMultiProducerEnqueue(queue->readyRing, slot);
+    queue->recent[fingerprint & RECENT_ADV_MASK] = fingerprint;
+    SoftBusAtomicAdd32(&queue->stats.pushed, 1);
+    *needWake = SoftBusAtomicCmpAndSwap32(&queue->drainPending, 0, 1);
+    return SOFTBUS_OK;
+}
+
+uint32_t DiscBleRecvQueueDrain(DiscBleRecvQueue *queue, DiscBleRecvHandler handler)
+{
+    DISC_CHECK_AND_RETURN_RET_LOGE(queue != NULL && handler != NULL, 0, DISC_BLE, "invalid param");
+    // cleared before draining, a push racing with the last dequeue schedules one more drain
+    (void)SoftBusAtomicCmpAndSwap32(&queue->drainPending, 1, 0);
+    uint32_t count = 0;
+    void *node = NULL;
+    while (QueueSingleConsumerDequeue(queue->readyRing, &node) == 0) {
+        DiscBleRecvSlot *slot = (DiscBleRecvSlot *)node;
+        handler(&slot->reportInfo);
+        (void)QueueSingleProducerEnqueue(queue->freeRing, slot);
+        count++;
+    }
+    SoftBusAtomicAdd32(&queue->stats.processed, count);
+    return count;
+}
+
+void DiscBleRecvQueueGetStats(const DiscBleRecvQueue *queue, DiscBleRecvQueueStats *stats)
+{
+    DISC_CHECK_AND_RETURN_LOGE(queue != NULL && stats != NULL, DISC_BLE, "invalid param");
+    stats->pushed = queue->stats.pushed;
+    stats->processed = queue->stats.processed;
+    stats->droppedDuplicate = queue->stats.droppedDuplicate;
+    stats->droppedFull = queue->stats.droppedFull;
+    stats->droppedInvalid = queue->stats.droppedInvalid;
+}
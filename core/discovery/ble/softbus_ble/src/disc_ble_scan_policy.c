@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "disc_ble_scan_policy.h"
+
+#include "disc_log.h"
+#include "securec.h"
+#include "softbus_common.h"
+
+#define FNV_OFFSET_BASIS 2166136261U
+#define FNV_PRIME 16777619U
+#define QUIET_SCORE_NO_RESULT 2
+#define QUIET_SCORE_NO_NEW_DEVICE 1
+
+static int32_t ClampFreq(int32_t freq, int32_t minFreq, int32_t maxFreq)
+{
+    if (freq < minFreq) {
+        return minFreq;
+    }
+    return (freq > maxFreq) ? maxFreq : freq;
+}
+
+static uint32_t HashDevKey(const uint8_t *devKey, uint32_t keyLen)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+    for (uint32_t i = 0; i < keyLen; i++) {
+        hash ^= devKey[i];
+        hash *= FNV_PRIME;
+    }
+    // 0 marks an empty slot of the seen table
+    return (hash == 0) ? 1 : hash;
+}
+
+void DiscBleScanPolicyInit(DiscBleScanPolicy *policy)
+{
+    DISC_CHECK_AND_RETURN_LOGE(policy != NULL, DISC_BLE, "policy is null");
+    (void)memset_s(policy, sizeof(DiscBleScanPolicy), 0, sizeof(DiscBleScanPolicy));
+    policy->bound.minFreq = LOW;
+    policy->bound.maxFreq = LOW;
+    policy->curFreq = LOW;
+}
+
+bool DiscBleScanPolicySetBound(DiscBleScanPolicy *policy, const ScanFreqBound *bound, uint32_t subscriberCnt)
+{
+    DISC_CHECK_AND_RETURN_RET_LOGE(policy != NULL && bound != NULL, false, DISC_BLE, "invalid param");
+    int32_t maxFreq = ClampFreq(bound->maxFreq, LOW, FREQ_BUTT - 1);
+    int32_t minFreq = ClampFreq(bound->minFreq, LOW, maxFreq);
+    int32_t oldFreq = policy->curFreq;
+    // a new subscriber wants its first results quickly, start it at the top of its range
+    bool needRaise = subscriberCnt > policy->subscriberCnt || maxFreq > policy->bound.maxFreq;
+
+    policy->bound.minFreq = minFreq;
+    policy->bound.maxFreq = maxFreq;
+    policy->subscriberCnt = subscriberCnt;
+    if (needRaise) {
+        policy->curFreq = maxFreq;
+        policy->quietScore = 0;
+    } else {
+        policy->curFreq = ClampFreq(policy->curFreq, minFreq, maxFreq);
+    }
+    DISC_LOGD(DISC_BLE, "scan bound min=%{public}d, max=%{public}d, subscriberCnt=%{public}u, freq=%{public}d",
+        minFreq, maxFreq, subscriberCnt, policy->curFreq);
+    return policy->curFreq != oldFreq;
+}
+
+void DiscBleScanPolicyOnResult(DiscBleScanPolicy *policy, const uint8_t *devKey, uint32_t keyLen)
+{
+    DISC_CHECK_AND_RETURN_LOGE(policy != NULL && devKey != NULL, DISC_BLE, "invalid param");
+    uint32_t hash = HashDevKey(devKey, keyLen);
+    policy->epochResults++;
+    for (uint32_t i = 0; i < SCAN_POLICY_SEEN_NUM; i++) {
+        if (policy->seen[i] == hash) {
+            return;
+        }
+    }
+    policy->seen[policy->seenPos] = hash;
+    policy->seenPos = (policy->seenPos + 1) % SCAN_POLICY_SEEN_NUM;
+    policy->epochNewDevices++;
+}
+
+bool DiscBleScanPolicyOnEpoch(DiscBleScanPolicy *policy)
+{
+    DISC_CHECK_AND_RETURN_RET_LOGE(policy != NULL, false, DISC_BLE, "policy is null");
+    int32_t oldFreq = policy->curFreq;
+    if (policy->epochNewDevices >= SCAN_POLICY_BURST_NEW_DEVICES) {
+        policy->curFreq = policy->bound.maxFreq;
+        policy->quietScore = 0;
+    } else if (policy->epochNewDevices > 0) {
+        policy->curFreq = ClampFreq(policy->curFreq + 1, policy->bound.minFreq, policy->bound.maxFreq);
+        policy->quietScore = 0;
+    } else {
+        // known devices still answering decay slower than silence
+        policy->quietScore += (policy->epochResults == 0) ? QUIET_SCORE_NO_RESULT : QUIET_SCORE_NO_NEW_DEVICE;
+        uint32_t extraHold = (policy->subscriberCnt > SCAN_POLICY_MAX_EXTRA_HOLD) ?
+            SCAN_POLICY_MAX_EXTRA_HOLD : policy->subscriberCnt;
+        if (policy->quietScore >= SCAN_POLICY_HOLD_EPOCHS + extraHold) {
+            policy->curFreq = ClampFreq(policy->curFreq - 1, policy->bound.minFreq, policy->bound.maxFreq);
+            policy->quietScore = 0;
+        }
+    }
+    policy->epochResults = 0;
+    policy->epochNewDevices = 0;
+    if (policy->curFreq != oldFreq) {
+        DISC_LOGI(DISC_BLE, "scan freq changed, old=%{public}d, new=%{public}d", oldFreq, policy->curFreq);
+        return true;
+    }
+    return false;
+}
+
+int32_t DiscBleScanPolicyGetFreq(const DiscBleScanPolicy *policy)
+{
+    DISC_CHECK_AND_RETURN_RET_LOGE(policy != NULL, LOW, DISC_BLE, "policy is null");
+    return policy->curFreq;
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISC_CAP_INDEX_H
+#define DISC_CAP_INDEX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common_list.h"
+#include "disc_manager.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif
+#endif
+
+/*
+ * Subscribers indexed by capability bit. Every bit keeps its subscriber list and count, the
+ * aggregate bitmap holds the bits with at least one subscriber. All of it is updated when a
+ * subscription is added or removed, so nothing has to walk the subscriptions to rebuild it.
+ * The caller serializes access.
+ */
+typedef struct {
+    ListNode subscribers[CAPABILITY_MAX_BITNUM];
+    uint32_t subscriberCnt[CAPABILITY_MAX_BITNUM];
+    uint32_t allCap[CAPABILITY_NUM];
+    uint32_t totalCnt;
+} DiscCapIndex;
+
+void DiscCapIndexInit(DiscCapIndex *index);
+// returns true when capBit had no subscriber before
+bool DiscCapIndexAdd(DiscCapIndex *index, uint32_t capBit, ListNode *node, bool isPriority);
+// returns true when the last subscriber of capBit is gone, a node not in the index is ignored
+bool DiscCapIndexRemove(DiscCapIndex *index, uint32_t capBit, ListNode *node);
+bool DiscCapIndexIsMatch(const DiscCapIndex *index, const uint32_t *capBitmap, uint32_t bitmapNum);
+uint32_t DiscCapIndexGetSubscriberNum(const DiscCapIndex *index, const uint32_t *capBitmap, uint32_t bitmapNum);
+ListNode *DiscCapIndexGetSubscribers(DiscCapIndex *index, uint32_t capBit);
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* __cplusplus */
+#endif /* DISC_CAP_INDEX_H */
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "disc_cap_index.h"
+
+#include "disc_log.h"
+#include "securec.h"
+
+#define CAP_BITS_PER_WORD 32
+
+static bool IsCapBitSet(const uint32_t *capBitmap, uint32_t bitmapNum, uint32_t capBit)
+{
+    uint32_t word = capBit / CAP_BITS_PER_WORD;
+    return word < bitmapNum && (capBitmap[word] & (1U << (capBit % CAP_BITS_PER_WORD))) != 0;
+}
+
+void DiscCapIndexInit(DiscCapIndex *index)
+{
+    DISC_CHECK_AND_RETURN_LOGE(index != NULL, DISC_CONTROL, "index is null");
+    (void)memset_s(index, sizeof(DiscCapIndex), 0, sizeof(DiscCapIndex));
+    for (uint32_t i = 0; i < CAPABILITY_MAX_BITNUM; i++) {
+        ListInit(&index->subscribers[i]);
+    }
+}
+
+bool DiscCapIndexAdd(DiscCapIndex *index, uint32_t capBit, ListNode *node, bool isPriority)
+{
+    DISC_CHECK_AND_RETURN_RET_LOGE(index != NULL && node != NULL && capBit < CAPABILITY_MAX_BITNUM, false,
+        DISC_CONTROL, "invalid param");
+    if (isPriority) {
+        ListNodeInsert(&index->subscribers[capBit], node);
+    } else {
+        ListTailInsert(&index->subscribers[capBit], node);
+    }
+    index->totalCnt++;
+    if (index->subscriberCnt[capBit]++ != 0) {
+        return false;
+    }
+    index->allCap[capBit / CAP_BITS_PER_WORD] |= 1U << (capBit % CAP_BITS_PER_WORD);
+    return true;
+}
+
+bool DiscCapIndexRemove(DiscCapIndex *index, uint32_t capBit, ListNode *node)
+{
+    DISC_CHECK_AND_RETURN_RET_LOGE(index != NULL && node != NULL && capBit < CAPABILITY_MAX_BITNUM, false,
+        DISC_CONTROL, "invalid param");
+    // a removed node points to itself, removing it twice must not touch the counts
+    if (IsListEmpty(node) || index->subscriberCnt[capBit] == 0) {
+        return false;
+    }
+    ListDelete(node);
+    index->totalCnt--;
+    if (--index->subscriberCnt[capBit] != 0) {
+        return false;
+    }
+    index->allCap[capBit / CAP_BITS_PER_WORD] &= ~(1U << (capBit % CAP_BITS_PER_WORD));
+    return true;
+}
+
+bool DiscCapIndexIsMatch(const DiscCapIndex *index, const uint32_t *capBitmap, uint32_t bitmapNum)
+{
+    DISC_CHECK_AND_RETURN_RET_LOGE(index != NULL && capBitmap != NULL, false, DISC_CONTROL, "invalid param");
+    uint32_t num = (bitmapNum < CAPABILITY_NUM) ? bitmapNum : CAPABILITY_NUM;
+    for (uint32_t i = 0; i < num; i++) {
+        if ((capBitmap[i] & index->allCap[i]) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t DiscCapIndexGetSubscriberNum(const DiscCapIndex *index, const uint32_t *capBitmap, uint32_t bitmapNum)
+{
+    DISC_CHECK_AND_RETURN_RET_LOGE(index != NULL && capBitmap != NULL, 0, DISC_CONTROL, "invalid param");
+    uint32_t num = 0;
+    for (uint32_t capBit = 0; capBit < CAPABILITY_MAX_BITNUM; capBit++) {
+        if (IsCapBitSet(capBitmap, bitmapNum, capBit)) {
+            num += index->subscriberCnt[capBit];
+        }
+    }
+    return num;
+}
+
+ListNode *DiscCapIndexGetSubscribers(DiscCapIndex *index, uint32_t capBit)
+{
+    DISC_CHECK_AND_RETURN_RET_LOGE(index != NULL && capBit < CAPABILITY_MAX_BITNUM, NULL, DISC_CONTROL,
+        "invalid param");
+    return &index->subscribers[capBit];
+}
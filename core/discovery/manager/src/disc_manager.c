@@ -19,6 +19,7 @@
 #include "bus_center_event.h"
 #include "common_list.h"
 #include "disc_ble_dispatcher.h"
+#include "disc_cap_index.h"
 #include "disc_coap.h"
 #include "disc_event.h"
 #include "disc_log.h"
@@ -29,6 +30,7 @@
 #include "softbus_adapter_timer.h"
 #include "softbus_def.h"
 #include "softbus_error_code.h"
+#include "softbus_feature_config.h"
 #include "softbus_json_utils.h"
 #include "legacy/softbus_hisysevt_discreporter.h"
 #include "lnn_devicename_info.h"
@@ -46,6 +48,10 @@
 #define JSON_KEY_NAME_LEN_24     "name24"
 #define JSON_KEY_NAME_LEN_21     "name21"
 #define JSON_KEY_NAME_LEN_18     "name18"
+#define FOUND_CACHE_SIZE 32
+#define DEFAULT_FOUND_SUPPRESS_WINDOW 1000 // ms
+#define FOUND_HASH_OFFSET_BASIS 0xCBF29CE484222325ULL
+#define FOUND_HASH_PRIME 0x100000001B3ULL
 
 static bool g_isInited = false;
 
@@ -58,7 +64,9 @@ static DiscoveryFuncInterface *g_discUsbInterface = NULL;
 
 static DiscInnerCallback g_discMgrMediumCb;
 
-static ListNode g_capabilityList[CAPABILITY_MAX_BITNUM];
+static DiscCapIndex g_capIndex;
+
+static uint32_t g_foundSuppressWindow = DEFAULT_FOUND_SUPPRESS_WINDOW;
 
 typedef struct {
     char raw[DISPLAY_NAME_BUF_LEN];
@@ -101,6 +109,19 @@ typedef struct {
     ListNode InfoList;
 } DiscItem;
 
+typedef struct {
+    uint64_t devIdHash;
+    uint64_t fingerprint;
+    uint64_t reportTime;
+    ExchangeMedium medium;
+} FoundRecord;
+
+// devices recently reported to one subscriber, the oldest record is replaced when full
+typedef struct {
+    uint32_t num;
+    FoundRecord records[FOUND_CACHE_SIZE];
+} FoundCache;
+
 typedef struct {
     ListNode node;
     int32_t id;
@@ -111,8 +132,15 @@ typedef struct {
     DiscoveryStatistics statistics;
     InnerOption option;
     int32_t pid;
+    FoundCache *foundCache;
 } DiscInfo;
 
+typedef struct {
+    bool isInner;
+    InnerCallback callback;
+    char packageName[PKG_NAME_SIZE_MAX];
+} FoundNotify;
+
 typedef struct {
     ListNode node;
     int32_t id;
@@ -186,7 +214,8 @@ static void UpdateDdmpStartDiscoveryTime(DiscInfo *info)
     }
 
     DiscInfo *infoNode = NULL;
-    LIST_FOR_EACH_ENTRY(infoNode, &(g_capabilityList[DDMP_CAPABILITY_BITMAP]), DiscInfo, capNode) {
+    ListNode *subscribers = DiscCapIndexGetSubscribers(&g_capIndex, DDMP_CAPABILITY_BITMAP);
+    LIST_FOR_EACH_ENTRY(infoNode, subscribers, DiscInfo, capNode) {
         if (infoNode->statistics.repTimes == 0) {
             DISC_LOGD(DISC_CONTROL, "update ddmp callback id=%{public}d", infoNode->id);
             infoNode->statistics.startTime = info->statistics.startTime;
@@ -331,6 +360,18 @@ static int32_t TransferStringCapToBitmap(const char *capability)
     return SOFTBUS_DISCOVER_MANAGER_CAPABILITY_INVALID;
 }
 
+// a subscription carries exactly one capability
+static uint32_t GetSubscribeCapBit(const DiscInfo *info)
+{
+    uint32_t tmp = 0;
+    for (; tmp < CAPABILITY_MAX_BITNUM; tmp++) {
+        if (IsBitmapSet(&(info->option.subscribeOption.capabilityBitmap[0]), tmp)) {
+            break;
+        }
+    }
+    return tmp;
+}
+
 static void AddDiscInfoToCapabilityList(DiscInfo *info, const ServiceType type)
 {
     if (type != SUBSCRIBE_SERVICE && type != SUBSCRIBE_INNER_SERVICE) {
@@ -338,15 +379,14 @@ static void AddDiscInfoToCapabilityList(DiscInfo *info, const ServiceType type)
         return;
     }
 
-    for (uint32_t tmp = 0; tmp < CAPABILITY_MAX_BITNUM; tmp++) {
-        if (IsBitmapSet(&(info->option.subscribeOption.capabilityBitmap[0]), tmp) == true) {
-            if (type == SUBSCRIBE_SERVICE) {
-                ListTailInsert(&(g_capabilityList[tmp]), &(info->capNode));
-            } else {
-                ListNodeInsert(&(g_capabilityList[tmp]), &(info->capNode));
-            }
-            break;
-        }
+    uint32_t capBit = GetSubscribeCapBit(info);
+    if (capBit >= CAPABILITY_MAX_BITNUM) {
+        return;
+    }
+    // inner modules are notified before applications
+    if (DiscCapIndexAdd(&g_capIndex, capBit, &(info->capNode), type == SUBSCRIBE_INNER_SERVICE)) {
+        DISC_LOGD(DISC_CONTROL, "first subscriber of capability, capBit=%{public}u, allCap=%{public}u",
+            capBit, g_capIndex.allCap[0]);
     }
 }
 
@@ -356,7 +396,14 @@ static void RemoveDiscInfoFromCapabilityList(DiscInfo *info, const ServiceType t
         DISC_LOGD(DISC_CONTROL, "publish no need to delete");
         return;
     }
-    ListDelete(&(info->capNode));
+    uint32_t capBit = GetSubscribeCapBit(info);
+    if (capBit >= CAPABILITY_MAX_BITNUM) {
+        return;
+    }
+    if (DiscCapIndexRemove(&g_capIndex, capBit, &(info->capNode))) {
+        DISC_LOGD(DISC_CONTROL, "last subscriber of capability gone, capBit=%{public}u, allCap=%{public}u",
+            capBit, g_capIndex.allCap[0]);
+    }
 }
 
 static void FreeDiscInfo(DiscInfo *info, const ServiceType type)
@@ -370,6 +417,8 @@ static void FreeDiscInfo(DiscInfo *info, const ServiceType type)
         SoftBusFree(info->option.subscribeOption.capabilityData);
         info->option.subscribeOption.capabilityData = NULL;
     }
+    SoftBusFree(info->foundCache);
+    info->foundCache = NULL;
     SoftBusFree(info);
     info = NULL;
 }
@@ -387,46 +436,164 @@ static bool IsInnerModule(const DiscInfo *infoNode)
     return false;
 }
 
-static void InnerDeviceFound(DiscInfo *infoNode, const DeviceInfo *device,
-                                                const InnerDeviceInfoAddtions *additions)
+static uint64_t FoundHashBytes(uint64_t hash, const void *data, uint32_t len)
 {
-    if (infoNode->item != NULL && infoNode->item->callback.serverCb.OnServerDeviceFound != NULL &&
-        !IsInnerModule(infoNode)) {
-        (void)infoNode->item->callback.serverCb.OnServerDeviceFound(infoNode->item->packageName, device, additions);
-        return;
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (uint32_t i = 0; i < len; i++) {
+        hash = (hash ^ bytes[i]) * FOUND_HASH_PRIME;
     }
+    return hash;
+}
+
+static uint64_t FoundHashString(uint64_t hash, const char *str, uint32_t maxLen)
+{
+    return FoundHashBytes(hash, str, strnlen(str, maxLen));
+}
+
+// everything a subscriber can observe, so that any change of the device is reported again
+static uint64_t GetDeviceFingerprint(const DeviceInfo *device)
+{
+    uint64_t hash = FOUND_HASH_OFFSET_BASIS;
+    hash = FoundHashString(hash, device->accountHash, MAX_ACCOUNT_HASH_LEN);
+    hash = FoundHashBytes(hash, &device->devType, sizeof(device->devType));
+    hash = FoundHashString(hash, device->devName, DISC_MAX_DEVICE_NAME_LEN);
+    hash = FoundHashBytes(hash, &device->isOnline, sizeof(device->isOnline));
+    uint32_t addrNum = device->addrNum < CONNECTION_ADDR_MAX ? device->addrNum : CONNECTION_ADDR_MAX;
+    hash = FoundHashBytes(hash, &addrNum, sizeof(addrNum));
+    hash = FoundHashBytes(hash, device->addr, addrNum * sizeof(ConnectionAddr));
+    uint32_t capNum = device->capabilityBitmapNum < DISC_MAX_CAPABILITY_NUM ?
+        device->capabilityBitmapNum : DISC_MAX_CAPABILITY_NUM;
+    hash = FoundHashBytes(hash, device->capabilityBitmap, capNum * sizeof(device->capabilityBitmap[0]));
+    hash = FoundHashString(hash, device->custData, DISC_MAX_CUST_DATA_LEN);
+    return FoundHashBytes(hash, &device->range, sizeof(device->range));
+}
+
+static void BuildFoundRecord(const DeviceInfo *device, const InnerDeviceInfoAddtions *additions, FoundRecord *record)
+{
+    record->devIdHash = FoundHashString(FOUND_HASH_OFFSET_BASIS, device->devId, DISC_MAX_DEVICE_ID_LEN);
+    record->fingerprint = GetDeviceFingerprint(device);
+    record->reportTime = SoftBusGetSysTimeMs();
+    record->medium = additions->medium;
+}
 
-    DISC_LOGD(DISC_CONTROL, "call from inner module.");
-    if (infoNode->item != NULL && infoNode->item->callback.innerCb.OnDeviceFound != NULL) {
+// The same device found again over the same medium is reported once per window unless it changed.
+static bool IsDeviceFoundSuppressed(DiscInfo *infoNode, const FoundRecord *record)
+{
+    if (g_foundSuppressWindow == 0) {
+        return false;
+    }
+    if (infoNode->foundCache == NULL) {
+        infoNode->foundCache = (FoundCache *)SoftBusCalloc(sizeof(FoundCache));
+        DISC_CHECK_AND_RETURN_RET_LOGW(infoNode->foundCache != NULL, false, DISC_CONTROL, "calloc found cache failed");
+    }
+    FoundCache *cache = infoNode->foundCache;
+    FoundRecord *oldest = NULL;
+    for (uint32_t i = 0; i < cache->num; i++) {
+        FoundRecord *cached = &cache->records[i];
+        if (cached->devIdHash == record->devIdHash && cached->medium == record->medium) {
+            bool isSuppressed = cached->fingerprint == record->fingerprint &&
+                record->reportTime >= cached->reportTime &&
+                record->reportTime - cached->reportTime < g_foundSuppressWindow;
+            if (!isSuppressed) {
+                *cached = *record;
+            }
+            return isSuppressed;
+        }
+        if (oldest == NULL || cached->reportTime < oldest->reportTime) {
+            oldest = cached;
+        }
+    }
+    FoundRecord *target = (cache->num < FOUND_CACHE_SIZE) ? &cache->records[cache->num++] : oldest;
+    *target = *record;
+    return false;
+}
+
+static bool BuildFoundNotify(DiscInfo *infoNode, const DeviceInfo *device, const InnerDeviceInfoAddtions *additions,
+    const FoundRecord *record, FoundNotify *notify)
+{
+    if (infoNode->item == NULL) {
+        return false;
+    }
+    if (infoNode->item->callback.serverCb.OnServerDeviceFound != NULL && !IsInnerModule(infoNode)) {
+        // only applications are spared the repeated reports, inner modules keep every report
+        if (IsDeviceFoundSuppressed(infoNode, record)) {
+            DISC_LOGD(DISC_CONTROL, "suppress device found, id=%{public}d", infoNode->id);
+            return false;
+        }
+        notify->isInner = false;
+    } else {
+        DISC_LOGD(DISC_CONTROL, "call from inner module.");
+        if (infoNode->item->callback.innerCb.OnDeviceFound == NULL) {
+            return false;
+        }
         DfxRecordDeviceFound(infoNode, device, additions);
-        infoNode->item->callback.innerCb.OnDeviceFound(device, additions);
+        notify->isInner = true;
     }
+    notify->callback = infoNode->item->callback;
+    if (strcpy_s(notify->packageName, PKG_NAME_SIZE_MAX, infoNode->item->packageName) != EOK) {
+        DISC_LOGE(DISC_CONTROL, "copy packageName failed");
+        return false;
+    }
+    return true;
 }
 
-static void DiscOnDeviceFound(const DeviceInfo *device, const InnerDeviceInfoAddtions *additions)
+// Decides who is notified under the list lock, the callbacks run afterwards so a slow one never blocks discovery.
+static uint32_t CollectFoundNotifies(const DeviceInfo *device, const InnerDeviceInfoAddtions *additions,
+    FoundNotify **notifies)
 {
-    DISC_CHECK_AND_RETURN_LOGE(device != NULL, DISC_CONTROL, "device is null");
-    DISC_CHECK_AND_RETURN_LOGE(additions != NULL, DISC_CONTROL, "additions is null");
+    if (!DiscCapIndexIsMatch(&g_capIndex, device->capabilityBitmap, CAPABILITY_NUM)) {
+        return 0;
+    }
+    uint32_t num = DiscCapIndexGetSubscriberNum(&g_capIndex, device->capabilityBitmap, CAPABILITY_NUM);
+    if (num == 0) {
+        return 0;
+    }
+    *notifies = (FoundNotify *)SoftBusCalloc(num * sizeof(FoundNotify));
+    DISC_CHECK_AND_RETURN_RET_LOGE(*notifies != NULL, 0, DISC_CONTROL, "calloc notifies failed");
 
-    DISC_LOGD(DISC_CONTROL,
-        "capabilityBitmap=%{public}d, medium=%{public}d", device->capabilityBitmap[0], additions->medium);
+    FoundRecord record = { 0 };
+    BuildFoundRecord(device, additions, &record);
+    uint32_t notifyNum = 0;
     for (uint32_t tmp = 0; tmp < CAPABILITY_MAX_BITNUM; tmp++) {
-        if (IsBitmapSet((uint32_t *)device->capabilityBitmap, tmp) == false) {
+        if (!IsBitmapSet((uint32_t *)device->capabilityBitmap, tmp) || g_capIndex.subscriberCnt[tmp] == 0) {
             continue;
         }
-
-        if (SoftBusMutexLock(&(g_discoveryInfoList->lock)) != SOFTBUS_OK) {
-            DISC_LOGE(DISC_CONTROL, "lock failed");
-            return;
-        }
         DiscInfo *infoNode = NULL;
-        LIST_FOR_EACH_ENTRY(infoNode, &(g_capabilityList[tmp]), DiscInfo, capNode) {
+        ListNode *subscribers = DiscCapIndexGetSubscribers(&g_capIndex, tmp);
+        LIST_FOR_EACH_ENTRY(infoNode, subscribers, DiscInfo, capNode) {
             DISC_LOGD(DISC_CONTROL, "find callback id=%{public}d", infoNode->id);
             infoNode->statistics.discTimes++;
-            InnerDeviceFound(infoNode, device, additions);
+            if (notifyNum < num && BuildFoundNotify(infoNode, device, additions, &record, &(*notifies)[notifyNum])) {
+                notifyNum++;
+            }
+        }
+    }
+    return notifyNum;
+}
+
+static void DiscOnDeviceFound(const DeviceInfo *device, const InnerDeviceInfoAddtions *additions)
+{
+    DISC_CHECK_AND_RETURN_LOGE(device != NULL, DISC_CONTROL, "device is null");
+    DISC_CHECK_AND_RETURN_LOGE(additions != NULL, DISC_CONTROL, "additions is null");
+
+    DISC_LOGD(DISC_CONTROL,
+        "capabilityBitmap=%{public}d, medium=%{public}d", device->capabilityBitmap[0], additions->medium);
+    if (SoftBusMutexLock(&(g_discoveryInfoList->lock)) != SOFTBUS_OK) {
+        DISC_LOGE(DISC_CONTROL, "lock failed");
+        return;
+    }
+    FoundNotify *notifies = NULL;
+    uint32_t notifyNum = CollectFoundNotifies(device, additions, &notifies);
+    (void)SoftBusMutexUnlock(&(g_discoveryInfoList->lock));
+
+    for (uint32_t i = 0; i < notifyNum; i++) {
+        if (notifies[i].isInner) {
+            notifies[i].callback.innerCb.OnDeviceFound(device, additions);
+        } else {
+            (void)notifies[i].callback.serverCb.OnServerDeviceFound(notifies[i].packageName, device, additions);
         }
-        (void)SoftBusMutexUnlock(&(g_discoveryInfoList->lock));
     }
+    SoftBusFree(notifies);
 }
 
 static int32_t CheckPublishInfo(const PublishInfo *info)
@@ -1333,8 +1500,12 @@ int32_t DiscMgrInit(void)
         return SOFTBUS_DISCOVER_MANAGER_INIT_FAIL;
     }
 
-    for (int32_t i = 0; i < CAPABILITY_MAX_BITNUM; i++) {
-        ListInit(&g_capabilityList[i]);
+    DiscCapIndexInit(&g_capIndex);
+
+    if (SoftbusGetConfig(SOFTBUS_INT_DISC_FOUND_SUPPRESS_WINDOW, (unsigned char *)&g_foundSuppressWindow,
+        sizeof(g_foundSuppressWindow)) != SOFTBUS_OK) {
+        DISC_LOGW(DISC_INIT, "get found suppress window failed, use default");
+        g_foundSuppressWindow = DEFAULT_FOUND_SUPPRESS_WINDOW;
     }
 
     g_isInited = true;
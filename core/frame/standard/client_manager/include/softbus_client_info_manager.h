@@ -35,6 +35,8 @@ public:
     sptr<IRemoteObject> GetSoftbusClientProxy(const std::string &pkgName);
     sptr<IRemoteObject> GetSoftbusClientProxy(const std::string &pkgName, int32_t pid);
     void GetSoftbusClientProxyMap(std::multimap<std::string, sptr<IRemoteObject>> &softbusClientMap);
+    void GetSoftbusClientProxyMap(
+        std::multimap<std::string, std::pair<int32_t, sptr<IRemoteObject>>> &softbusClientMap);
     bool SoftbusClientIsExist(const std::string &pkgName, int32_t pid);
 
 private:
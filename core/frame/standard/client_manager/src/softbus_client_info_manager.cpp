@@ -148,6 +148,15 @@ void SoftbusClientInfoManager::GetSoftbusClientProxyMap(std::multimap<std::strin
     }
 }
 
+void SoftbusClientInfoManager::GetSoftbusClientProxyMap(
+    std::multimap<std::string, std::pair<int32_t, sptr<IRemoteObject>>> &softbusClientMap)
+{
+    std::lock_guard<std::recursive_mutex> autoLock(clientObjectMapLock_);
+    for (auto iter = clientObjectMap_.begin(); iter != clientObjectMap_.end(); ++iter) {
+        softbusClientMap.emplace(iter->first, std::make_pair(iter->second.first, iter->second.second.first));
+    }
+}
+
 bool SoftbusClientInfoManager::SoftbusClientIsExist(const std::string &pkgName, int32_t pid)
 {
     std::lock_guard<std::recursive_mutex> autoLock(clientObjectMapLock_);
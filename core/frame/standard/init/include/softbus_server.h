@@ -79,6 +79,7 @@ public:
     int32_t ProcessInnerEvent(int32_t eventType, uint8_t *buf, uint32_t len) override;
     int32_t PrivilegeCloseChannel(uint64_t tokenId, int32_t pid, const char *peerNetworkId) override;
     int32_t SetDisplayName(const char *pkgName, const char *nameData, uint32_t len) override;
+    int32_t RegNodeStateBatch(const char *pkgName) override;
 
 protected:
     void OnStart() override;
@@ -79,6 +79,7 @@ private:
     int32_t GetSoftbusSpecObjectInner(MessageParcel &data, MessageParcel &reply);
     int32_t GetBusCenterExObjInner(MessageParcel &data, MessageParcel &reply);
     int32_t SetDisplayNameInner(MessageParcel &data, MessageParcel &reply);
+    int32_t RegNodeStateBatchInner(MessageParcel &data, MessageParcel &reply);
 
     void InitMemberFuncMap();
     void InitMemberPermissionMap();
@@ -146,4 +146,11 @@ int32_t ISoftBusServer::SetDisplayName(const char *pkgName, const char *nameData
     COMM_LOGE(COMM_SVC, "ipc default impl");
     return SOFTBUS_FUNC_NOT_SUPPORT;
 }
+
+int32_t ISoftBusServer::RegNodeStateBatch(const char *pkgName)
+{
+    (void)pkgName;
+    COMM_LOGE(COMM_SVC, "ipc default impl");
+    return SOFTBUS_FUNC_NOT_SUPPORT;
+}
 } // namespace OHOS
\ No newline at end of file
@@ -483,4 +483,10 @@ int32_t SoftBusServer::SetDisplayName(const char *pkgName, const char *nameData,
 {
     return LnnIpcSetDisplayName(pkgName, nameData, len);
 }
+
+int32_t SoftBusServer::RegNodeStateBatch(const char *pkgName)
+{
+    int32_t callingPid = (int32_t)OHOS::IPCSkeleton::GetCallingPid();
+    return LnnIpcRegNodeStateBatch(pkgName, callingPid);
+}
 } // namespace OHOS
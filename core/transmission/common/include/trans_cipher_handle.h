@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRANS_CIPHER_HANDLE_H
+#define TRANS_CIPHER_HANDLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common_list.h"
+#include "softbus_adapter_thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRANS_CIPHER_TABLE_BUCKET_NUM 64
+
+/*
+ * Reference counted session cipher of one channel. The key is loaded once when the channel is
+ * opened, encrypt and decrypt run on it directly, and it is wiped when the last reference goes.
+ * It also hands out the send sequence of the channel, starting at 0.
+ */
+typedef struct TransCipherHandle TransCipherHandle;
+
+TransCipherHandle *TransCipherHandleCreate(const char *sessionKey, uint32_t keyLen);
+void TransCipherHandleRef(TransCipherHandle *handle);
+void TransCipherHandleUnref(TransCipherHandle *handle);
+int32_t TransCipherHandleNextSeq(TransCipherHandle *handle);
+int32_t TransCipherHandleEncrypt(TransCipherHandle *handle, const uint8_t *in, uint32_t inLen,
+    uint8_t *out, uint32_t *outLen, int32_t seq);
+int32_t TransCipherHandleDecrypt(TransCipherHandle *handle, const uint8_t *in, uint32_t inLen,
+    uint8_t *out, uint32_t *outLen, int32_t seq);
+
+typedef struct {
+    SoftBusMutex lock;
+    ListNode list;
+} TransCipherBucket;
+
+/*
+ * Cipher handles by channelId. Buckets are locked one by one, so the data path of a channel
+ * never waits on the channel list lock or on traffic of channels in other buckets.
+ */
+typedef struct {
+    bool isInited;
+    TransCipherBucket bucket[TRANS_CIPHER_TABLE_BUCKET_NUM];
+} TransCipherTable;
+
+int32_t TransCipherTableInit(TransCipherTable *table);
+void TransCipherTableDeinit(TransCipherTable *table);
+// the table takes over the reference of the caller, on failure the caller still owns it
+int32_t TransCipherTableAdd(TransCipherTable *table, int32_t channelId, TransCipherHandle *handle);
+void TransCipherTableRemove(TransCipherTable *table, int32_t channelId);
+// returns a referenced handle the caller drops with TransCipherHandleUnref
+TransCipherHandle *TransCipherTableAcquire(TransCipherTable *table, int32_t channelId);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif // TRANS_CIPHER_HANDLE_H
@@ -16,11 +16,14 @@
 #ifndef TRANS_PROXY_PROCESS_DATA_H
 #define TRANS_PROXY_PROCESS_DATA_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "common_list.h"
+#include "softbus_adapter_thread.h"
 #include "softbus_app_info.h"
 #include "softbus_def.h"
+#include "trans_cipher_handle.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -85,17 +88,80 @@ typedef struct {
     SliceProcessor processor[PROXY_CHANNEL_PRORITY_BUTT];
 } ChannelSliceProcessor;
 
+#define TRANS_SLICE_BUF_CLASS_NUM 15
+#define TRANS_SLICE_TABLE_BUCKET_NUM 64
+
+/*
+ * Reassembly buffers sized in classes of slice counts. A released buffer waits on the free list of
+ * its class for the next message of that size, up to a bounded number of cached bytes. Not locked,
+ * the owner serializes access.
+ */
+typedef struct {
+    uint32_t cachedBytes;
+    uint32_t freeNum[TRANS_SLICE_BUF_CLASS_NUM];
+    ListNode freeList[TRANS_SLICE_BUF_CLASS_NUM];
+} TransSliceBufPool;
+
+typedef struct {
+    SliceProcessor processor;
+    ListNode expiryNode;
+    uint64_t deadline;
+} TransSliceEntry;
+
+typedef struct {
+    ListNode node;
+    int32_t channelId;
+    TransSliceEntry entry[PROXY_CHANNEL_PRORITY_BUTT];
+} TransSliceChannel;
+
+/*
+ * Reassembly state by channelId and priority. A reassembly in progress sits on the expiry list in
+ * deadline order, every slice it receives moves it back to the tail, so expiring only looks at the
+ * head. Everything but init and deinit is called with lock held.
+ */
+typedef struct {
+    bool isInited;
+    SoftBusMutex lock;
+    uint32_t cnt;
+    uint32_t timeoutMs;
+    ListNode bucket[TRANS_SLICE_TABLE_BUCKET_NUM];
+    ListNode expiryList;
+    TransSliceBufPool pool;
+} TransSliceTable;
+
+/*
+ * Walks the slices of a packed message. Every slice after the first is framed in place: its
+ * SliceHead overwrites the tail of the slice before it, so a slice must be sent before the next
+ * one is asked for, and outData is only good for freeing once the walk has started.
+ */
+typedef struct {
+    ProxyDataInfo *dataInfo;
+    SessionPktType pktType;
+    uint32_t sliceNum;
+    uint32_t sliceSeq;
+    uint8_t *firstSlice;
+} ProxySliceIterator;
+
 void TransGetProxyDataBufMaxSize(void);
 int32_t TransProxyPackBytes(
     int32_t channelId, ProxyDataInfo *dataInfo, const char *sessionKey, SessionPktType flag, int32_t seq);
 int32_t TransProxyPackTlvBytes(
     ProxyDataInfo *dataInfo, const char *sessionKey, SessionPktType flag, int32_t seq, DataHeadTlvPacketHead *info);
+int32_t TransProxyPackBytesByCipher(
+    int32_t channelId, ProxyDataInfo *dataInfo, TransCipherHandle *cipher, SessionPktType flag, int32_t seq);
+int32_t TransProxyPackTlvBytesByCipher(ProxyDataInfo *dataInfo, TransCipherHandle *cipher, SessionPktType flag,
+    int32_t seq, DataHeadTlvPacketHead *info);
 uint8_t *TransProxyPackData(
     ProxyDataInfo *dataInfo, uint32_t sliceNum, SessionPktType pktType, uint32_t cnt, uint32_t *dataLen);
+int32_t TransProxySliceIterInit(ProxySliceIterator *iter, ProxyDataInfo *dataInfo, SessionPktType pktType);
+// returns the next slice with its SliceHead, *sliceLen counts both, NULL once all slices are out
+uint8_t *TransProxySliceIterNext(ProxySliceIterator *iter, uint32_t *sliceLen);
+void TransProxySliceIterDeinit(ProxySliceIterator *iter);
 int32_t TransProxyCheckSliceHead(const SliceHead *head);
 int32_t TransProxyNoSubPacketProc(PacketHead *head, uint32_t len, const char *data, int32_t channelId);
 int32_t TransProxyProcessSessionData(ProxyDataInfo *dataInfo, const PacketHead *dataHead, const char *data);
 int32_t TransProxyDecryptPacketData(int32_t seq, ProxyDataInfo *dataInfo, const char *sessionKey);
+int32_t TransProxyDecryptPacketDataByCipher(int32_t seq, ProxyDataInfo *dataInfo, TransCipherHandle *cipher);
 int32_t TransProxyFirstSliceProcess(
     SliceProcessor *processor, const SliceHead *head, const char *data, uint32_t len, bool supportTlv);
 int32_t TransProxyNormalSliceProcess(SliceProcessor *processor, const SliceHead *head, const char *data, uint32_t len);
@@ -110,6 +176,27 @@ int32_t TransProxyNoSubPacketTlvProc(
     int32_t channelId, const char *data, uint32_t len, DataHeadTlvPacketHead *pktHead, uint32_t newPktHeadSize);
 int32_t TransProxyProcData(ProxyDataInfo *dataInfo, const DataHeadTlvPacketHead *pktHead, const char *data);
 
+void TransSliceBufPoolInit(TransSliceBufPool *pool);
+void TransSliceBufPoolDeinit(TransSliceBufPool *pool);
+char *TransSliceBufPoolAlloc(TransSliceBufPool *pool, int32_t sliceNum, int32_t *bufLen);
+void TransSliceBufPoolFree(TransSliceBufPool *pool, char *buf, int32_t bufLen);
+
+int32_t TransSliceTableInit(TransSliceTable *table, uint32_t timeoutMs);
+void TransSliceTableDeinit(TransSliceTable *table);
+TransSliceEntry *TransSliceTableGetEntry(TransSliceTable *table, int32_t channelId, int32_t priority);
+bool TransSliceTableHasChannel(TransSliceTable *table, int32_t channelId);
+void TransSliceTableDelChannel(TransSliceTable *table, int32_t channelId);
+int32_t TransSliceTableFirstSlice(
+    TransSliceTable *table, TransSliceEntry *entry, const SliceHead *head, const char *data, uint32_t len);
+int32_t TransSliceTableNormalSlice(
+    TransSliceTable *table, TransSliceEntry *entry, const SliceHead *head, const char *data, uint32_t len);
+// appends the last slice and stops the expiry clock, the caller consumes the message and clears the entry
+int32_t TransSliceTableLastSlice(
+    TransSliceTable *table, TransSliceEntry *entry, const SliceHead *head, const char *data, uint32_t len);
+void TransSliceTableClearEntry(TransSliceTable *table, TransSliceEntry *entry);
+// drops the reassemblies whose deadline is not after nowMs, returns how many were dropped
+uint32_t TransSliceTableExpire(TransSliceTable *table, uint64_t nowMs);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "trans_cipher_handle.h"
+
+#include <securec.h>
+
+#include "softbus_adapter_atomic.h"
+#include "softbus_adapter_crypto.h"
+#include "softbus_adapter_mem.h"
+#include "softbus_error_code.h"
+#include "trans_log.h"
+
+// the adapter writes the iv of every message into the key it is given, so each caller needs a key of its own
+#define TRANS_CIPHER_LANE_NUM 4
+
+typedef int32_t (*CipherFunc)(AesGcmCipherKey *cipherKey, const unsigned char *input, uint32_t inLen,
+    unsigned char *output, uint32_t *outLen, int32_t seqNum);
+
+typedef struct {
+    volatile uint32_t busy;
+    AesGcmCipherKey cipherKey;
+} TransCipherLane;
+
+struct TransCipherHandle {
+    volatile uint32_t refCount;
+    volatile uint32_t sequence;
+    TransCipherLane lane[TRANS_CIPHER_LANE_NUM];
+};
+
+typedef struct {
+    ListNode node;
+    int32_t channelId;
+    TransCipherHandle *handle;
+} TransCipherEntry;
+
+TransCipherHandle *TransCipherHandleCreate(const char *sessionKey, uint32_t keyLen)
+{
+    if (sessionKey == NULL || keyLen == 0 || keyLen > SESSION_KEY_LENGTH) {
+        TRANS_LOGE(TRANS_CTRL, "invalid param");
+        return NULL;
+    }
+    TransCipherHandle *handle = (TransCipherHandle *)SoftBusCalloc(sizeof(TransCipherHandle));
+    if (handle == NULL) {
+        TRANS_LOGE(TRANS_CTRL, "malloc cipher handle failed");
+        return NULL;
+    }
+    for (uint32_t i = 0; i < TRANS_CIPHER_LANE_NUM; i++) {
+        handle->lane[i].cipherKey.keyLen = keyLen;
+        if (memcpy_s(handle->lane[i].cipherKey.key, SESSION_KEY_LENGTH, sessionKey, keyLen) != EOK) {
+            TRANS_LOGE(TRANS_CTRL, "memcpy key failed");
+            (void)memset_s(handle, sizeof(TransCipherHandle), 0, sizeof(TransCipherHandle));
+            SoftBusFree(handle);
+            return NULL;
+        }
+    }
+    handle->refCount = 1;
+    return handle;
+}
+
+void TransCipherHandleRef(TransCipherHandle *handle)
+{
+    TRANS_CHECK_AND_RETURN_LOGE(handle != NULL, TRANS_CTRL, "handle is null");
+    SoftBusAtomicAdd32(&handle->refCount, 1);
+}
+
+void TransCipherHandleUnref(TransCipherHandle *handle)
+{
+    TRANS_CHECK_AND_RETURN_LOGE(handle != NULL, TRANS_CTRL, "handle is null");
+    if (SoftBusAtomicAddAndFetch32(&handle->refCount, -1) != 0) {
+        return;
+    }
+    (void)memset_s(handle, sizeof(TransCipherHandle), 0, sizeof(TransCipherHandle));
+    SoftBusFree(handle);
+}
+
+int32_t TransCipherHandleNextSeq(TransCipherHandle *handle)
+{
+    TRANS_CHECK_AND_RETURN_RET_LOGE(handle != NULL, 0, TRANS_CTRL, "handle is null");
+    return (int32_t)(SoftBusAtomicAddAndFetch32(&handle->sequence, 1) - 1);
+}
+
+static int32_t TransCipherHandleRun(TransCipherHandle *handle, CipherFunc func, const uint8_t *in, uint32_t inLen,
+    uint8_t *out, uint32_t *outLen, int32_t seq)
+{
+    for (uint32_t i = 0; i < TRANS_CIPHER_LANE_NUM; i++) {
+        TransCipherLane *lane = &handle->lane[i];
+        if (!SoftBusAtomicCmpAndSwap32(&lane->busy, 0, 1)) {
+            continue;
+        }
+        int32_t ret = func(&lane->cipherKey, in, inLen, out, outLen, seq);
+        (void)SoftBusAtomicCmpAndSwap32(&lane->busy, 1, 0);
+        return ret;
+    }
+    // more callers than lanes on this channel, the key itself is never written so a private copy is safe
+    AesGcmCipherKey cipherKey = { 0 };
+    cipherKey.keyLen = handle->lane[0].cipherKey.keyLen;
+    if (memcpy_s(cipherKey.key, SESSION_KEY_LENGTH, handle->lane[0].cipherKey.key, cipherKey.keyLen) != EOK) {
+        TRANS_LOGE(TRANS_CTRL, "memcpy key failed");
+        (void)memset_s(&cipherKey, sizeof(AesGcmCipherKey), 0, sizeof(AesGcmCipherKey));
+        return SOFTBUS_MEM_ERR;
+    }
+    int32_t ret = func(&cipherKey, in, inLen, out, outLen, seq);
+    (void)memset_s(&cipherKey, sizeof(AesGcmCipherKey), 0, sizeof(AesGcmCipherKey));
+    return ret;
+}
+
+int32_t TransCipherHandleEncrypt(TransCipherHandle *handle, const uint8_t *in, uint32_t inLen,
+    uint8_t *out, uint32_t *outLen, int32_t seq)
+{
+    if (handle == NULL || in == NULL || out == NULL || outLen == NULL) {
+        TRANS_LOGE(TRANS_CTRL, "invalid param");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    return TransCipherHandleRun(handle, SoftBusEncryptDataWithSeq, in, inLen, out, outLen, seq);
+}
+
+int32_t TransCipherHandleDecrypt(TransCipherHandle *handle, const uint8_t *in, uint32_t inLen,
+    uint8_t *out, uint32_t *outLen, int32_t seq)
+{
+    if (handle == NULL || in == NULL || out == NULL || outLen == NULL) {
+        TRANS_LOGE(TRANS_CTRL, "invalid param");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    return TransCipherHandleRun(handle, SoftBusDecryptDataWithSeq, in, inLen, out, outLen, seq);
+}
+
+static TransCipherBucket *TransCipherTableGetBucket(TransCipherTable *table, int32_t channelId)
+{
+    return &table->bucket[(uint32_t)channelId % TRANS_CIPHER_TABLE_BUCKET_NUM];
+}
+
+static TransCipherEntry *TransCipherBucketFind(TransCipherBucket *bucket, int32_t channelId)
+{
+    TransCipherEntry *entry = NULL;
+    LIST_FOR_EACH_ENTRY(entry, &bucket->list, TransCipherEntry, node) {
+        if (entry->channelId == channelId) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+int32_t TransCipherTableInit(TransCipherTable *table)
+{
+    TRANS_CHECK_AND_RETURN_RET_LOGE(table != NULL, SOFTBUS_INVALID_PARAM, TRANS_INIT, "table is null");
+    if (table->isInited) {
+        return SOFTBUS_OK;
+    }
+    for (uint32_t i = 0; i < TRANS_CIPHER_TABLE_BUCKET_NUM; i++) {
+        if (SoftBusMutexInit(&table->bucket[i].lock, NULL) != SOFTBUS_OK) {
+            TRANS_LOGE(TRANS_INIT, "init bucket lock failed");
+            for (uint32_t j = 0; j < i; j++) {
+                (void)SoftBusMutexDestroy(&table->bucket[j].lock);
+            }
+            return SOFTBUS_NO_INIT;
+        }
+        ListInit(&table->bucket[i].list);
+    }
+    table->isInited = true;
+    return SOFTBUS_OK;
+}
+
+void TransCipherTableDeinit(TransCipherTable *table)
+{
+    if (table == NULL || !table->isInited) {
+        return;
+    }
+    table->isInited = false;
+    for (uint32_t i = 0; i < TRANS_CIPHER_TABLE_BUCKET_NUM; i++) {
+        TransCipherBucket *bucket = &table->bucket[i];
+        if (SoftBusMutexLock(&bucket->lock) != SOFTBUS_OK) {
+            TRANS_LOGE(TRANS_INIT, "lock failed");
+            continue;
+        }
+        TransCipherEntry *entry = NULL;
+        TransCipherEntry *next = NULL;
+        LIST_FOR_EACH_ENTRY_SAFE(entry, next, &bucket->list, TransCipherEntry, node) {
+            ListDelete(&entry->node);
+            TransCipherHandleUnref(entry->handle);
+            SoftBusFree(entry);
+        }
+        (void)SoftBusMutexUnlock(&bucket->lock);
+        (void)SoftBusMutexDestroy(&bucket->lock);
+    }
+}
+
+int32_t TransCipherTableAdd(TransCipherTable *table, int32_t channelId, TransCipherHandle *handle)
+{
+    if (table == NULL || !table->isInited || handle == NULL) {
+        TRANS_LOGE(TRANS_CTRL, "invalid param");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    TransCipherEntry *entry = (TransCipherEntry *)SoftBusCalloc(sizeof(TransCipherEntry));
+    TRANS_CHECK_AND_RETURN_RET_LOGE(entry != NULL, SOFTBUS_MALLOC_ERR, TRANS_CTRL, "malloc entry failed");
+    entry->channelId = channelId;
+    entry->handle = handle;
+    TransCipherBucket *bucket = TransCipherTableGetBucket(table, channelId);
+    if (SoftBusMutexLock(&bucket->lock) != SOFTBUS_OK) {
+        TRANS_LOGE(TRANS_CTRL, "lock failed");
+        SoftBusFree(entry);
+        return SOFTBUS_LOCK_ERR;
+    }
+    if (TransCipherBucketFind(bucket, channelId) != NULL) {
+        (void)SoftBusMutexUnlock(&bucket->lock);
+        TRANS_LOGE(TRANS_CTRL, "cipher already exists, channelId=%{public}d", channelId);
+        SoftBusFree(entry);
+        return SOFTBUS_ALREADY_EXISTED;
+    }
+    ListAdd(&bucket->list, &entry->node);
+    (void)SoftBusMutexUnlock(&bucket->lock);
+    return SOFTBUS_OK;
+}
+
+void TransCipherTableRemove(TransCipherTable *table, int32_t channelId)
+{
+    if (table == NULL || !table->isInited) {
+        TRANS_LOGE(TRANS_CTRL, "invalid param");
+        return;
+    }
+    TransCipherBucket *bucket = TransCipherTableGetBucket(table, channelId);
+    if (SoftBusMutexLock(&bucket->lock) != SOFTBUS_OK) {
+        TRANS_LOGE(TRANS_CTRL, "lock failed");
+        return;
+    }
+    TransCipherEntry *entry = TransCipherBucketFind(bucket, channelId);
+    if (entry != NULL) {
+        ListDelete(&entry->node);
+    }
+    (void)SoftBusMutexUnlock(&bucket->lock);
+    if (entry == NULL) {
+        return;
+    }
+    // senders still holding the handle keep it alive, the key is wiped by the last of them
+    TransCipherHandleUnref(entry->handle);
+    SoftBusFree(entry);
+}
+
+TransCipherHandle *TransCipherTableAcquire(TransCipherTable *table, int32_t channelId)
+{
+    if (table == NULL || !table->isInited) {
+        TRANS_LOGE(TRANS_CTRL, "invalid param");
+        return NULL;
+    }
+    TransCipherBucket *bucket = TransCipherTableGetBucket(table, channelId);
+    if (SoftBusMutexLock(&bucket->lock) != SOFTBUS_OK) {
+        TRANS_LOGE(TRANS_CTRL, "lock failed");
+        return NULL;
+    }
+    TransCipherHandle *handle = NULL;
+    TransCipherEntry *entry = TransCipherBucketFind(bucket, channelId);
+    if (entry != NULL) {
+        handle = entry->handle;
+        TransCipherHandleRef(handle);
+    }
+    (void)SoftBusMutexUnlock(&bucket->lock);
+    return handle;
+}
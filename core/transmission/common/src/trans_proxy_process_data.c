@@ -21,11 +21,13 @@
 #include "softbus_adapter_mem.h"
 #include "softbus_adapter_socket.h"
 #include "softbus_adapter_thread.h"
+#include "softbus_adapter_timer.h"
 #include "softbus_error_code.h"
 #include "softbus_feature_config.h"
 #include "softbus_socket.h"
 #include "softbus_utils.h"
 #include "trans_assemble_tlv.h"
+#include "trans_cipher_handle.h"
 #include "trans_log.h"
 
 #define SLICE_LEN (4 * 1024)
@@ -34,6 +36,10 @@
 #define PROXY_TLV_PKT_HEAD 32
 #define MAGICNUM_SIZE sizeof(uint32_t)
 #define TLVCOUNT_SIZE sizeof(uint8_t)
+// room for the larger of the two packet heads plus the cipher overhead
+#define SLICE_BUF_HEAD_ROOM (PROXY_TLV_PKT_HEAD + OVERHEAD_LEN)
+#define SLICE_BUF_CACHE_NUM 4
+#define SLICE_BUF_CACHE_BYTES (2 * 1024 * 1024)
 static uint32_t g_proxyMaxByteBufSize = 0;
 static uint32_t g_proxyMaxMessageBufSize = 0;
 
@@ -100,33 +106,37 @@ static void TransUnPackPacketHead(PacketHead *data)
     data->dataLen = (int32_t)SoftBusLtoHl((uint32_t)data->dataLen);
 }
 
-int32_t TransProxyPackBytes(
-    int32_t channelId, ProxyDataInfo *dataInfo, const char *sessionKey, SessionPktType flag, int32_t seq)
+static int32_t TransProxyEncryptPayload(const char *sessionKey, TransCipherHandle *cipher,
+    const ProxyDataInfo *dataInfo, char *outData, uint32_t *outLen, int32_t seq)
 {
-    if (dataInfo == NULL || sessionKey == NULL) {
-        TRANS_LOGE(TRANS_CTRL, "invalid para");
-        return SOFTBUS_INVALID_PARAM;
+    if (cipher != NULL) {
+        return TransCipherHandleEncrypt(cipher, dataInfo->inData, dataInfo->inLen, (uint8_t *)outData, outLen, seq);
     }
-    dataInfo->outLen = dataInfo->inLen + OVERHEAD_LEN + sizeof(PacketHead);
-    dataInfo->outData = (uint8_t *)SoftBusCalloc(dataInfo->outLen);
-    if (dataInfo->outData == NULL) {
-        TRANS_LOGE(TRANS_CTRL, "malloc failed");
-        return SOFTBUS_MEM_ERR;
-    }
-
-    uint32_t outLen = 0;
     AesGcmCipherKey cipherKey = { 0 };
     cipherKey.keyLen = SESSION_KEY_LENGTH;
     if (memcpy_s(cipherKey.key, SESSION_KEY_LENGTH, sessionKey, SESSION_KEY_LENGTH) != EOK) {
         TRANS_LOGE(TRANS_CTRL, "memcpy key failed");
-        SoftBusFree(dataInfo->outData);
         return SOFTBUS_MEM_ERR;
     }
-    char *outData = (char *)dataInfo->outData + sizeof(PacketHead);
     int32_t ret = SoftBusEncryptDataWithSeq(&cipherKey, (const unsigned char *)dataInfo->inData,
-        dataInfo->inLen, (unsigned char *)outData, &outLen, seq);
+        dataInfo->inLen, (unsigned char *)outData, outLen, seq);
     (void)memset_s(cipherKey.key, SESSION_KEY_LENGTH, 0, SESSION_KEY_LENGTH);
+    return ret;
+}
 
+static int32_t TransProxyPackBytesInner(int32_t channelId, ProxyDataInfo *dataInfo, const char *sessionKey,
+    TransCipherHandle *cipher, SessionPktType flag, int32_t seq)
+{
+    dataInfo->outLen = dataInfo->inLen + OVERHEAD_LEN + sizeof(PacketHead);
+    dataInfo->outData = (uint8_t *)SoftBusCalloc(dataInfo->outLen);
+    if (dataInfo->outData == NULL) {
+        TRANS_LOGE(TRANS_CTRL, "malloc failed");
+        return SOFTBUS_MEM_ERR;
+    }
+
+    uint32_t outLen = 0;
+    char *outData = (char *)dataInfo->outData + sizeof(PacketHead);
+    int32_t ret = TransProxyEncryptPayload(sessionKey, cipher, dataInfo, outData, &outLen, seq);
     if (ret != SOFTBUS_OK || outLen != dataInfo->inLen + OVERHEAD_LEN) {
         outData = NULL;
         SoftBusFree(dataInfo->outData);
@@ -142,6 +152,26 @@ int32_t TransProxyPackBytes(
     return SOFTBUS_OK;
 }
 
+int32_t TransProxyPackBytes(
+    int32_t channelId, ProxyDataInfo *dataInfo, const char *sessionKey, SessionPktType flag, int32_t seq)
+{
+    if (dataInfo == NULL || sessionKey == NULL) {
+        TRANS_LOGE(TRANS_CTRL, "invalid para");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    return TransProxyPackBytesInner(channelId, dataInfo, sessionKey, NULL, flag, seq);
+}
+
+int32_t TransProxyPackBytesByCipher(
+    int32_t channelId, ProxyDataInfo *dataInfo, TransCipherHandle *cipher, SessionPktType flag, int32_t seq)
+{
+    if (dataInfo == NULL || cipher == NULL) {
+        TRANS_LOGE(TRANS_CTRL, "invalid para");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    return TransProxyPackBytesInner(channelId, dataInfo, NULL, cipher, flag, seq);
+}
+
 static uint8_t *TransProxyPackTlvData(DataHead *pktHead, int32_t tlvBufferSize, uint32_t dataLen)
 {
     int32_t newDataHeadSize = MAGICNUM_SIZE + TLVCOUNT_SIZE + tlvBufferSize;
@@ -254,13 +284,9 @@ static int32_t ProxyBuildNeedAckTlvData(DataHead *pktHead, bool needAck, uint32_
     return SOFTBUS_OK;
 }
 
-int32_t TransProxyPackTlvBytes(
-    ProxyDataInfo *dataInfo, const char *sessionKey, SessionPktType flag, int32_t seq, DataHeadTlvPacketHead *info)
+static int32_t TransProxyPackTlvBytesInner(ProxyDataInfo *dataInfo, const char *sessionKey,
+    TransCipherHandle *cipher, SessionPktType flag, int32_t seq, DataHeadTlvPacketHead *info)
 {
-    if (dataInfo == NULL || sessionKey == NULL || info == NULL) {
-        TRANS_LOGE(TRANS_CTRL, "param invalid");
-        return SOFTBUS_INVALID_PARAM;
-    }
     uint32_t dataLen = dataInfo->inLen + OVERHEAD_LEN;
     DataHead pktHead = { 0 };
     int32_t tlvBufferSize = 0;
@@ -281,17 +307,8 @@ int32_t TransProxyPackTlvBytes(
     dataInfo->outLen = dataInfo->inLen + OVERHEAD_LEN + (uint32_t)newDataHeadSize;
 
     uint32_t outLen = 0;
-    AesGcmCipherKey cipherKey = { 0 };
-    cipherKey.keyLen = SESSION_KEY_LENGTH;
-    if (memcpy_s(cipherKey.key, SESSION_KEY_LENGTH, sessionKey, SESSION_KEY_LENGTH) != SOFTBUS_OK) {
-        TRANS_LOGE(TRANS_CTRL, "memcpy key failed");
-        SoftBusFree(dataInfo->outData);
-        return SOFTBUS_MEM_ERR;
-    }
     char *outData = (char *)dataInfo->outData + newDataHeadSize;
-    ret = SoftBusEncryptDataWithSeq(&cipherKey, (const unsigned char*)dataInfo->inData,
-        dataInfo->inLen, (unsigned char*)outData, &outLen, seq);
-    (void)memset_s(cipherKey.key, SESSION_KEY_LENGTH, 0, SESSION_KEY_LENGTH);
+    ret = TransProxyEncryptPayload(sessionKey, cipher, dataInfo, outData, &outLen, seq);
     if (ret != SOFTBUS_OK || outLen != dataInfo->inLen + OVERHEAD_LEN) {
         TRANS_LOGE(TRANS_CTRL, "encrypt failed, ret=%{public}d", ret);
         outData = NULL;
@@ -302,6 +319,26 @@ int32_t TransProxyPackTlvBytes(
     return SOFTBUS_OK;
 }
 
+int32_t TransProxyPackTlvBytes(
+    ProxyDataInfo *dataInfo, const char *sessionKey, SessionPktType flag, int32_t seq, DataHeadTlvPacketHead *info)
+{
+    if (dataInfo == NULL || sessionKey == NULL || info == NULL) {
+        TRANS_LOGE(TRANS_CTRL, "param invalid");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    return TransProxyPackTlvBytesInner(dataInfo, sessionKey, NULL, flag, seq, info);
+}
+
+int32_t TransProxyPackTlvBytesByCipher(ProxyDataInfo *dataInfo, TransCipherHandle *cipher, SessionPktType flag,
+    int32_t seq, DataHeadTlvPacketHead *info)
+{
+    if (dataInfo == NULL || cipher == NULL || info == NULL) {
+        TRANS_LOGE(TRANS_CTRL, "param invalid");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    return TransProxyPackTlvBytesInner(dataInfo, NULL, cipher, flag, seq, info);
+}
+
 static int32_t SessionPktTypeToProxyIndex(SessionPktType packetType)
 {
     switch (packetType) {
@@ -344,6 +381,66 @@ uint8_t *TransProxyPackData(
     return sliceData;
 }
 
+int32_t TransProxySliceIterInit(ProxySliceIterator *iter, ProxyDataInfo *dataInfo, SessionPktType pktType)
+{
+    if (iter == NULL || dataInfo == NULL || dataInfo->outData == NULL || dataInfo->outLen == 0) {
+        TRANS_LOGE(TRANS_CTRL, "param invalid");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    uint32_t sliceNum = (dataInfo->outLen + (uint32_t)(SLICE_LEN - 1)) / (uint32_t)SLICE_LEN;
+    if (sliceNum > INT32_MAX) {
+        TRANS_LOGE(TRANS_CTRL, "data overflow, sliceNum=%{public}u", sliceNum);
+        return SOFTBUS_INVALID_NUM;
+    }
+    iter->dataInfo = dataInfo;
+    iter->pktType = pktType;
+    iter->sliceNum = sliceNum;
+    iter->sliceSeq = 0;
+    iter->firstSlice = NULL;
+    return SOFTBUS_OK;
+}
+
+uint8_t *TransProxySliceIterNext(ProxySliceIterator *iter, uint32_t *sliceLen)
+{
+    if (iter == NULL || sliceLen == NULL || iter->dataInfo == NULL || iter->sliceSeq >= iter->sliceNum) {
+        return NULL;
+    }
+    uint32_t cnt = iter->sliceSeq;
+    uint32_t dataLen = 0;
+    uint8_t *slice = NULL;
+    if (cnt == 0) {
+        // nothing sits in front of the first slice, it is the only one that needs a buffer of its own
+        slice = TransProxyPackData(iter->dataInfo, iter->sliceNum, iter->pktType, cnt, &dataLen);
+        if (slice == NULL) {
+            return NULL;
+        }
+        iter->firstSlice = slice;
+    } else {
+        dataLen = (cnt == (iter->sliceNum - 1)) ? (iter->dataInfo->outLen - cnt * SLICE_LEN) : SLICE_LEN;
+        slice = iter->dataInfo->outData + cnt * SLICE_LEN - sizeof(SliceHead);
+        SliceHead *sliceHead = (SliceHead *)slice;
+        sliceHead->priority = SessionPktTypeToProxyIndex(iter->pktType);
+        sliceHead->sliceNum = (int32_t)iter->sliceNum;
+        sliceHead->sliceSeq = (int32_t)cnt;
+        TransPackSliceHead(sliceHead);
+    }
+    iter->sliceSeq++;
+    *sliceLen = dataLen + sizeof(SliceHead);
+    return slice;
+}
+
+void TransProxySliceIterDeinit(ProxySliceIterator *iter)
+{
+    if (iter == NULL) {
+        return;
+    }
+    if (iter->firstSlice != NULL) {
+        SoftBusFree(iter->firstSlice);
+        iter->firstSlice = NULL;
+    }
+    iter->dataInfo = NULL;
+}
+
 int32_t TransProxyCheckSliceHead(const SliceHead *head)
 {
     if (head == NULL) {
@@ -458,6 +555,21 @@ int32_t TransProxyDecryptPacketData(int32_t seq, ProxyDataInfo *dataInfo, const
     return SOFTBUS_OK;
 }
 
+int32_t TransProxyDecryptPacketDataByCipher(int32_t seq, ProxyDataInfo *dataInfo, TransCipherHandle *cipher)
+{
+    if (dataInfo == NULL || cipher == NULL) {
+        TRANS_LOGE(TRANS_CTRL, "invalid param");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    int32_t ret = TransCipherHandleDecrypt(
+        cipher, dataInfo->inData, dataInfo->inLen, dataInfo->outData, &(dataInfo->outLen), seq);
+    if (ret != SOFTBUS_OK) {
+        TRANS_LOGE(TRANS_CTRL, "trans proxy Decrypt Data fail. ret=%{public}d", ret);
+        return SOFTBUS_DECRYPT_ERR;
+    }
+    return SOFTBUS_OK;
+}
+
 int32_t TransProxySessionDataLenCheck(uint32_t dataLen, SessionPktType type)
 {
     switch (type) {
@@ -711,3 +823,300 @@ int32_t TransProxyProcData(ProxyDataInfo *dataInfo, const DataHeadTlvPacketHead
     dataInfo->outLen = outLen;
     return SOFTBUS_OK;
 }
+
+// slice counts of the pooled buffer classes, larger messages get a buffer of their own
+static const int32_t g_sliceBufClass[TRANS_SLICE_BUF_CLASS_NUM] = {
+    2, 3, 4, 6, 8, 12, 16, 24, 32, 48, 64, 96, 128, 192, 256
+};
+
+static int32_t TransSliceBufClassLen(int32_t classIndex)
+{
+    return g_sliceBufClass[classIndex] * SLICE_LEN + SLICE_BUF_HEAD_ROOM;
+}
+
+void TransSliceBufPoolInit(TransSliceBufPool *pool)
+{
+    TRANS_CHECK_AND_RETURN_LOGE(pool != NULL, TRANS_INIT, "pool is null");
+    pool->cachedBytes = 0;
+    for (int32_t i = 0; i < TRANS_SLICE_BUF_CLASS_NUM; i++) {
+        pool->freeNum[i] = 0;
+        ListInit(&pool->freeList[i]);
+    }
+}
+
+void TransSliceBufPoolDeinit(TransSliceBufPool *pool)
+{
+    TRANS_CHECK_AND_RETURN_LOGE(pool != NULL, TRANS_INIT, "pool is null");
+    for (int32_t i = 0; i < TRANS_SLICE_BUF_CLASS_NUM; i++) {
+        while (!IsListEmpty(&pool->freeList[i])) {
+            ListNode *buf = GET_LIST_HEAD(&pool->freeList[i]);
+            ListDelete(buf);
+            SoftBusFree(buf);
+        }
+        pool->freeNum[i] = 0;
+    }
+    pool->cachedBytes = 0;
+}
+
+char *TransSliceBufPoolAlloc(TransSliceBufPool *pool, int32_t sliceNum, int32_t *bufLen)
+{
+    if (pool == NULL || sliceNum <= 0 || bufLen == NULL) {
+        TRANS_LOGE(TRANS_CTRL, "invalid param");
+        return NULL;
+    }
+    int32_t classIndex = 0;
+    while (classIndex < TRANS_SLICE_BUF_CLASS_NUM && g_sliceBufClass[classIndex] < sliceNum) {
+        classIndex++;
+    }
+    if (classIndex == TRANS_SLICE_BUF_CLASS_NUM) {
+        *bufLen = sliceNum * SLICE_LEN + SLICE_BUF_HEAD_ROOM;
+        return (char *)SoftBusMalloc(*bufLen);
+    }
+    *bufLen = TransSliceBufClassLen(classIndex);
+    if (IsListEmpty(&pool->freeList[classIndex])) {
+        return (char *)SoftBusMalloc(*bufLen);
+    }
+    ListNode *buf = GET_LIST_HEAD(&pool->freeList[classIndex]);
+    ListDelete(buf);
+    pool->freeNum[classIndex]--;
+    pool->cachedBytes -= (uint32_t)*bufLen;
+    return (char *)buf;
+}
+
+void TransSliceBufPoolFree(TransSliceBufPool *pool, char *buf, int32_t bufLen)
+{
+    if (pool == NULL || buf == NULL) {
+        SoftBusFree(buf);
+        return;
+    }
+    for (int32_t i = 0; i < TRANS_SLICE_BUF_CLASS_NUM; i++) {
+        if (TransSliceBufClassLen(i) != bufLen) {
+            continue;
+        }
+        if (pool->freeNum[i] >= SLICE_BUF_CACHE_NUM || pool->cachedBytes + (uint32_t)bufLen > SLICE_BUF_CACHE_BYTES) {
+            break;
+        }
+        // an idle buffer links itself into the free list with its first bytes
+        ListTailInsert(&pool->freeList[i], (ListNode *)buf);
+        pool->freeNum[i]++;
+        pool->cachedBytes += (uint32_t)bufLen;
+        return;
+    }
+    SoftBusFree(buf);
+}
+
+static ListNode *TransSliceTableGetBucket(TransSliceTable *table, int32_t channelId)
+{
+    return &table->bucket[(uint32_t)channelId % TRANS_SLICE_TABLE_BUCKET_NUM];
+}
+
+static TransSliceChannel *TransSliceTableFindChannel(TransSliceTable *table, int32_t channelId)
+{
+    TransSliceChannel *channel = NULL;
+    LIST_FOR_EACH_ENTRY(channel, TransSliceTableGetBucket(table, channelId), TransSliceChannel, node) {
+        if (channel->channelId == channelId) {
+            return channel;
+        }
+    }
+    return NULL;
+}
+
+static void TransSliceTableArmEntry(TransSliceTable *table, TransSliceEntry *entry)
+{
+    entry->deadline = SoftBusGetSysTimeMs() + table->timeoutMs;
+    ListDelete(&entry->expiryNode);
+    ListTailInsert(&table->expiryList, &entry->expiryNode);
+}
+
+int32_t TransSliceTableInit(TransSliceTable *table, uint32_t timeoutMs)
+{
+    TRANS_CHECK_AND_RETURN_RET_LOGE(table != NULL, SOFTBUS_INVALID_PARAM, TRANS_INIT, "table is null");
+    if (table->isInited) {
+        return SOFTBUS_OK;
+    }
+    // the last slice is delivered with the lock held, a receive callback closing the channel takes it again
+    SoftBusMutexAttr mutexAttr = {
+        .type = SOFTBUS_MUTEX_RECURSIVE,
+    };
+    if (SoftBusMutexInit(&table->lock, &mutexAttr) != SOFTBUS_OK) {
+        TRANS_LOGE(TRANS_INIT, "init slice table lock failed");
+        return SOFTBUS_NO_INIT;
+    }
+    for (uint32_t i = 0; i < TRANS_SLICE_TABLE_BUCKET_NUM; i++) {
+        ListInit(&table->bucket[i]);
+    }
+    ListInit(&table->expiryList);
+    TransSliceBufPoolInit(&table->pool);
+    table->cnt = 0;
+    table->timeoutMs = timeoutMs;
+    table->isInited = true;
+    return SOFTBUS_OK;
+}
+
+void TransSliceTableDeinit(TransSliceTable *table)
+{
+    if (table == NULL || !table->isInited) {
+        return;
+    }
+    if (SoftBusMutexLock(&table->lock) != SOFTBUS_OK) {
+        TRANS_LOGE(TRANS_INIT, "lock failed");
+        return;
+    }
+    table->isInited = false;
+    for (uint32_t i = 0; i < TRANS_SLICE_TABLE_BUCKET_NUM; i++) {
+        TransSliceChannel *channel = NULL;
+        TransSliceChannel *next = NULL;
+        LIST_FOR_EACH_ENTRY_SAFE(channel, next, &table->bucket[i], TransSliceChannel, node) {
+            TransSliceTableDelChannel(table, channel->channelId);
+        }
+    }
+    TransSliceBufPoolDeinit(&table->pool);
+    (void)SoftBusMutexUnlock(&table->lock);
+    (void)SoftBusMutexDestroy(&table->lock);
+}
+
+TransSliceEntry *TransSliceTableGetEntry(TransSliceTable *table, int32_t channelId, int32_t priority)
+{
+    if (table == NULL || priority < PROXY_CHANNEL_PRORITY_MESSAGE || priority >= PROXY_CHANNEL_PRORITY_BUTT) {
+        TRANS_LOGE(TRANS_CTRL, "invalid param");
+        return NULL;
+    }
+    TransSliceChannel *channel = TransSliceTableFindChannel(table, channelId);
+    if (channel != NULL) {
+        return &channel->entry[priority];
+    }
+    channel = (TransSliceChannel *)SoftBusCalloc(sizeof(TransSliceChannel));
+    if (channel == NULL) {
+        TRANS_LOGE(TRANS_CTRL, "calloc slice channel failed");
+        return NULL;
+    }
+    channel->channelId = channelId;
+    for (int32_t i = PROXY_CHANNEL_PRORITY_MESSAGE; i < PROXY_CHANNEL_PRORITY_BUTT; i++) {
+        ListInit(&channel->entry[i].expiryNode);
+    }
+    ListAdd(TransSliceTableGetBucket(table, channelId), &channel->node);
+    table->cnt++;
+    TRANS_LOGI(TRANS_CTRL, "add slice channel, channelId=%{public}d", channelId);
+    return &channel->entry[priority];
+}
+
+bool TransSliceTableHasChannel(TransSliceTable *table, int32_t channelId)
+{
+    if (table == NULL || !table->isInited) {
+        return false;
+    }
+    return TransSliceTableFindChannel(table, channelId) != NULL;
+}
+
+void TransSliceTableDelChannel(TransSliceTable *table, int32_t channelId)
+{
+    TRANS_CHECK_AND_RETURN_LOGE(table != NULL, TRANS_CTRL, "table is null");
+    TransSliceChannel *channel = TransSliceTableFindChannel(table, channelId);
+    if (channel == NULL) {
+        return;
+    }
+    for (int32_t i = PROXY_CHANNEL_PRORITY_MESSAGE; i < PROXY_CHANNEL_PRORITY_BUTT; i++) {
+        TransSliceTableClearEntry(table, &channel->entry[i]);
+    }
+    ListDelete(&channel->node);
+    SoftBusFree(channel);
+    table->cnt--;
+    TRANS_LOGI(TRANS_CTRL, "delete slice channel, channelId=%{public}d", channelId);
+}
+
+int32_t TransSliceTableFirstSlice(
+    TransSliceTable *table, TransSliceEntry *entry, const SliceHead *head, const char *data, uint32_t len)
+{
+    if (table == NULL || entry == NULL || head == NULL || data == NULL) {
+        TRANS_LOGE(TRANS_CTRL, "invalid param");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    // a new first slice abandons whatever was being assembled at this priority
+    TransSliceTableClearEntry(table, entry);
+    uint32_t actualDataLen = 0;
+    int32_t ret = TransGetActualDataLen(head, &actualDataLen);
+    if (ret != SOFTBUS_OK) {
+        return ret;
+    }
+    SliceProcessor *processor = &entry->processor;
+    int32_t bufLen = 0;
+    char *buf = TransSliceBufPoolAlloc(&table->pool, head->sliceNum, &bufLen);
+    if (buf == NULL) {
+        TRANS_LOGE(TRANS_CTRL, "malloc fail when proc first slice package");
+        return SOFTBUS_MALLOC_ERR;
+    }
+    if (memcpy_s(buf, (uint32_t)bufLen, data, len) != EOK) {
+        TRANS_LOGE(TRANS_CTRL, "memcpy fail when proc first slice package");
+        TransSliceBufPoolFree(&table->pool, buf, bufLen);
+        return SOFTBUS_MEM_ERR;
+    }
+    processor->data = buf;
+    processor->bufLen = bufLen;
+    processor->sliceNumber = head->sliceNum;
+    processor->expectedSeq = 1;
+    processor->dataLen = (int32_t)len;
+    processor->active = true;
+    processor->timeout = 0;
+    TransSliceTableArmEntry(table, entry);
+    return SOFTBUS_OK;
+}
+
+int32_t TransSliceTableNormalSlice(
+    TransSliceTable *table, TransSliceEntry *entry, const SliceHead *head, const char *data, uint32_t len)
+{
+    if (table == NULL || entry == NULL) {
+        TRANS_LOGE(TRANS_CTRL, "invalid param");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    int32_t ret = TransProxyNormalSliceProcess(&entry->processor, head, data, len);
+    if (ret != SOFTBUS_OK) {
+        return ret;
+    }
+    TransSliceTableArmEntry(table, entry);
+    return SOFTBUS_OK;
+}
+
+int32_t TransSliceTableLastSlice(
+    TransSliceTable *table, TransSliceEntry *entry, const SliceHead *head, const char *data, uint32_t len)
+{
+    if (table == NULL || entry == NULL) {
+        TRANS_LOGE(TRANS_CTRL, "invalid param");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    int32_t ret = TransProxyNormalSliceProcess(&entry->processor, head, data, len);
+    if (ret != SOFTBUS_OK) {
+        return ret;
+    }
+    ListDelete(&entry->expiryNode);
+    return SOFTBUS_OK;
+}
+
+void TransSliceTableClearEntry(TransSliceTable *table, TransSliceEntry *entry)
+{
+    if (table == NULL || entry == NULL) {
+        TRANS_LOGE(TRANS_CTRL, "invalid param");
+        return;
+    }
+    ListDelete(&entry->expiryNode);
+    SliceProcessor *processor = &entry->processor;
+    TransSliceBufPoolFree(&table->pool, processor->data, processor->bufLen);
+    processor->data = NULL;
+    TransProxyClearProcessor(processor);
+}
+
+uint32_t TransSliceTableExpire(TransSliceTable *table, uint64_t nowMs)
+{
+    TRANS_CHECK_AND_RETURN_RET_LOGE(table != NULL, 0, TRANS_CTRL, "table is null");
+    uint32_t expiredNum = 0;
+    while (!IsListEmpty(&table->expiryList)) {
+        TransSliceEntry *entry = LIST_ENTRY(GET_LIST_HEAD(&table->expiryList), TransSliceEntry, expiryNode);
+        if (entry->deadline > nowMs) {
+            break;
+        }
+        TRANS_LOGE(TRANS_CTRL, "slice reassembly timeout, sliceNumber=%{public}d, expectedSeq=%{public}d",
+            entry->processor.sliceNumber, entry->processor.expectedSeq);
+        TransSliceTableClearEntry(table, entry);
+        expiredNum++;
+    }
+    return expiredNum;
+}
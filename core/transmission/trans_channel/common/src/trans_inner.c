@@ -23,6 +23,7 @@
 #include "softbus_common.h"
 #include "softbus_error_code.h"
 #include "softbus_proxychannel_manager.h"
+#include "softbus_proxychannel_session.h"
 #include "softbus_socket.h"
 #include "softbus_tcp_socket.h"
 #include "softbus_utils.h"
@@ -49,7 +50,6 @@ typedef struct {
     ListNode node;
 } TransInnerSessionInfo;
 
-#define SLICE_LEN (4 * 1024)
 #define DATA_BUF_MAX 4194304
 #ifndef MAGIC_NUMBER
 #define MAGIC_NUMBER 0xBABEFACE
@@ -943,7 +943,7 @@ static int32_t ClientTransProxyLastSliceProcess(
     return ret;
 }
 
-static int32_t TransProxyDelSliceProcessorByChannelId(int32_t channelId)
+static int32_t TransInnerDelSliceProcessorByChannelId(int32_t channelId)
 {
     ChannelSliceProcessor *node = NULL;
     ChannelSliceProcessor *next = NULL;
@@ -1057,32 +1057,12 @@ static int32_t ProxySendData(int32_t channelId, const void *data, uint32_t len,
         TRANS_LOGI(TRANS_CTRL, "proxy inner session pack bytes failed, channelId=%{public}d", channelId);
         return ret;
     }
-    uint32_t dataLen = 1;
-
-    uint32_t sliceNum = (dataInfo.outLen + (uint32_t)(SLICE_LEN - 1)) / (uint32_t)SLICE_LEN;
-    if (sliceNum > INT32_MAX) {
-        TRANS_LOGI(TRANS_CTRL, "data overflow");
-        SoftBusFree(dataInfo.outData);
-        return SOFTBUS_INVALID_NUM;
-    }
-    for (uint32_t cnt = 0; cnt < sliceNum; cnt++) {
-        uint8_t *sliceData = TransProxyPackData(&dataInfo, sliceNum, TRANS_SESSION_BYTES, cnt, &dataLen);
-        if (sliceData == NULL) {
-            TRANS_LOGE(TRANS_CTRL, "pack data failed, channelId=%{public}d", channelId);
-            SoftBusFree(dataInfo.outData);
-            return SOFTBUS_MALLOC_ERR;
-        }
-        ret = TransSendMsg(channelId, CHANNEL_TYPE_PROXY, sliceData, dataLen + sizeof(SliceHead), TRANS_SESSION_BYTES);
-        if (ret != SOFTBUS_OK) {
-            TRANS_LOGE(TRANS_CTRL, "send msg error, channelId=%{public}d, ret=%{public}d", channelId, ret);
-            SoftBusFree(sliceData);
-            SoftBusFree(dataInfo.outData);
-            return ret;
-        }
-
-        SoftBusFree(sliceData);
-    }
+    ret = TransProxyPostSessionSlices(channelId, &dataInfo, TRANS_SESSION_BYTES);
     SoftBusFree(dataInfo.outData);
+    if (ret != SOFTBUS_OK) {
+        TRANS_LOGE(TRANS_CTRL, "send msg error, channelId=%{public}d, ret=%{public}d", channelId, ret);
+        return ret;
+    }
 
     TRANS_LOGI(TRANS_CTRL, "send data success, channelId=%{public}d", channelId);
     return SOFTBUS_OK;
@@ -1117,7 +1097,7 @@ void CloseSessionInner(int32_t channelId)
         DirectChannelCloseSocket(info.fd);
         TransSrvDelInnerDataBufNode(channelId);
     } else {
-        (void)TransProxyDelSliceProcessorByChannelId(channelId);
+        (void)TransInnerDelSliceProcessorByChannelId(channelId);
         (void)TransLaneMgrDelLane(channelId, info.channelType, true);
         ret = TransProxyCloseProxyChannel(channelId);
         TRANS_LOGI(TRANS_CTRL, "ret=%{public}d, channelId=%{public}d", ret, channelId);
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SOFTBUS_PROXYCHANNEL_INDEX_H
+#define SOFTBUS_PROXYCHANNEL_INDEX_H
+
+#include <stdint.h>
+
+#include "common_list.h"
+#include "softbus_proxychannel_message.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PROXY_CHANNEL_INDEX_BUCKET_BITS 7
+#define PROXY_CHANNEL_INDEX_BUCKET_NUM  (1U << PROXY_CHANNEL_INDEX_BUCKET_BITS)
+
+/*
+ * Hash buckets over the proxy channel list, keyed by channelId, myId and connId. A channel is
+ * linked into one bucket of each through chanIdNode, myIdNode and connIdNode for as long as it
+ * is in the list. Channels sharing a key are kept newest first, the same order as the list.
+ * The caller holds the proxy channel list lock.
+ */
+typedef struct {
+    ListNode chanIdBucket[PROXY_CHANNEL_INDEX_BUCKET_NUM];
+    ListNode myIdBucket[PROXY_CHANNEL_INDEX_BUCKET_NUM];
+    ListNode connIdBucket[PROXY_CHANNEL_INDEX_BUCKET_NUM];
+} ProxyChannelIndex;
+
+void TransProxyChanIndexInit(ProxyChannelIndex *index);
+void TransProxyChanIndexAdd(ProxyChannelIndex *index, ProxyChannelInfo *chan);
+void TransProxyChanIndexRemove(ProxyChannelInfo *chan);
+// connId is the only indexed key that changes while the channel is listed
+void TransProxyChanIndexSetConnId(ProxyChannelIndex *index, ProxyChannelInfo *chan, uint32_t connId);
+ProxyChannelInfo *TransProxyChanIndexFindByChanId(ProxyChannelIndex *index, int32_t channelId);
+// walk the bucket with LIST_FOR_EACH_ENTRY over myIdNode and compare the key, the bucket is shared
+ListNode *TransProxyChanIndexGetMyIdBucket(ProxyChannelIndex *index, int16_t myId);
+// walk the bucket with LIST_FOR_EACH_ENTRY over connIdNode and compare the key, the bucket is shared
+ListNode *TransProxyChanIndexGetConnIdBucket(ProxyChannelIndex *index, uint32_t connId);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* SOFTBUS_PROXYCHANNEL_INDEX_H */
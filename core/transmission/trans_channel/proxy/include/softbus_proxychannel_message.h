@@ -136,6 +136,9 @@ typedef struct {
     int32_t seq;
     UkIdInfo ukIdInfo;
     ListNode node;
+    ListNode chanIdNode; /* links below are owned by the proxy channel index */
+    ListNode myIdNode;
+    ListNode connIdNode;
     AuthHandle authHandle; /* for cipher */
     AppInfo appInfo;
 } ProxyChannelInfo;
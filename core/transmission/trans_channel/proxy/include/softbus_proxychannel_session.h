@@ -18,6 +18,7 @@
 
 #include "softbus_trans_def.h"
 #include "softbus_proxychannel_message.h"
+#include "trans_proxy_process_data.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,6 +41,11 @@ typedef enum {
 } ProxyPacketType;
 
 int32_t TransProxyPostSessionData(int32_t channelId, const unsigned char *data, uint32_t len, SessionPktType flags);
+/*
+ * Sends a packed message slice by slice with a single channel lookup. Slices are framed in place,
+ * so dataInfo->outData is consumed by the call but still freed by the caller.
+ */
+int32_t TransProxyPostSessionSlices(int32_t channelId, ProxyDataInfo *dataInfo, SessionPktType flags);
 int32_t TransOnNormalMsgReceived(const char *pkgName, int32_t pid, int32_t channelId, const char *data, uint32_t len);
 int32_t TransProxyDelSliceProcessorByChannelId(int32_t channelId);
 int32_t NotifyClientMsgReceived(const char *pkgName, int32_t pid, int32_t channelId, TransReceiveData *receiveData);
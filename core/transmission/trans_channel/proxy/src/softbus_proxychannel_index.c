@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "softbus_proxychannel_index.h"
+
+#include "trans_log.h"
+
+#define PROXY_CHANNEL_INDEX_BUCKET_MASK (PROXY_CHANNEL_INDEX_BUCKET_NUM - 1)
+#define GOLDEN_RATIO_32                 0x9E3779B9U
+
+// channel ids are handed out sequentially, so the low bits already spread them
+static uint32_t ChanIdHash(int32_t channelId)
+{
+    return (uint32_t)channelId & PROXY_CHANNEL_INDEX_BUCKET_MASK;
+}
+
+static uint32_t MyIdHash(int16_t myId)
+{
+    return (uint32_t)(uint16_t)myId & PROXY_CHANNEL_INDEX_BUCKET_MASK;
+}
+
+// connection ids carry the connection type in the high bits, mix them all into the bucket
+static uint32_t ConnIdHash(uint32_t connId)
+{
+    return (connId * GOLDEN_RATIO_32) >> (32 - PROXY_CHANNEL_INDEX_BUCKET_BITS);
+}
+
+void TransProxyChanIndexInit(ProxyChannelIndex *index)
+{
+    TRANS_CHECK_AND_RETURN_LOGE(index != NULL, TRANS_CTRL, "index is null");
+    for (uint32_t i = 0; i < PROXY_CHANNEL_INDEX_BUCKET_NUM; i++) {
+        ListInit(&index->chanIdBucket[i]);
+        ListInit(&index->myIdBucket[i]);
+        ListInit(&index->connIdBucket[i]);
+    }
+}
+
+void TransProxyChanIndexAdd(ProxyChannelIndex *index, ProxyChannelInfo *chan)
+{
+    TRANS_CHECK_AND_RETURN_LOGE(index != NULL && chan != NULL, TRANS_CTRL, "invalid param");
+    ListAdd(&index->chanIdBucket[ChanIdHash(chan->channelId)], &chan->chanIdNode);
+    ListAdd(&index->myIdBucket[MyIdHash(chan->myId)], &chan->myIdNode);
+    ListAdd(&index->connIdBucket[ConnIdHash(chan->connId)], &chan->connIdNode);
+}
+
+void TransProxyChanIndexRemove(ProxyChannelInfo *chan)
+{
+    TRANS_CHECK_AND_RETURN_LOGE(chan != NULL, TRANS_CTRL, "chan is null");
+    ListDelete(&chan->chanIdNode);
+    ListDelete(&chan->myIdNode);
+    ListDelete(&chan->connIdNode);
+}
+
+void TransProxyChanIndexSetConnId(ProxyChannelIndex *index, ProxyChannelInfo *chan, uint32_t connId)
+{
+    TRANS_CHECK_AND_RETURN_LOGE(index != NULL && chan != NULL, TRANS_CTRL, "invalid param");
+    chan->connId = connId;
+    ListDelete(&chan->connIdNode);
+    ListAdd(&index->connIdBucket[ConnIdHash(connId)], &chan->connIdNode);
+}
+
+ProxyChannelInfo *TransProxyChanIndexFindByChanId(ProxyChannelIndex *index, int32_t channelId)
+{
+    TRANS_CHECK_AND_RETURN_RET_LOGE(index != NULL, NULL, TRANS_CTRL, "index is null");
+    ProxyChannelInfo *item = NULL;
+    LIST_FOR_EACH_ENTRY(item, &index->chanIdBucket[ChanIdHash(channelId)], ProxyChannelInfo, chanIdNode) {
+        if (item->channelId == channelId) {
+            return item;
+        }
+    }
+    return NULL;
+}
+
+ListNode *TransProxyChanIndexGetMyIdBucket(ProxyChannelIndex *index, int16_t myId)
+{
+    TRANS_CHECK_AND_RETURN_RET_LOGE(index != NULL, NULL, TRANS_CTRL, "index is null");
+    return &index->myIdBucket[MyIdHash(myId)];
+}
+
+ListNode *TransProxyChanIndexGetConnIdBucket(ProxyChannelIndex *index, uint32_t connId)
+{
+    TRANS_CHECK_AND_RETURN_RET_LOGE(index != NULL, NULL, TRANS_CTRL, "index is null");
+    return &index->connIdBucket[ConnIdHash(connId)];
+}
@@ -39,6 +39,7 @@
 #include "softbus_feature_config.h"
 #include "softbus_proxychannel_callback.h"
 #include "softbus_proxychannel_control.h"
+#include "softbus_proxychannel_index.h"
 #include "softbus_proxychannel_listener.h"
 #include "softbus_proxychannel_message.h"
 #include "softbus_proxychannel_session.h"
@@ -63,6 +64,7 @@
 #define PROXY_CHANNEL_CLIENT           0
 #define PROXY_CHANNEL_SERVER           1
 static SoftBusList *g_proxyChannelList = NULL;
+static ProxyChannelIndex g_proxyChannelIndex;
 
 typedef struct {
     int32_t channelType;
@@ -127,7 +129,8 @@ int32_t TransProxyGetAppInfoType(int16_t myId, const char *identity, AppType *ap
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "fail to lock mutex!");
     ProxyChannelInfo *item = NULL;
-    LIST_FOR_EACH_ENTRY(item, &g_proxyChannelList->list, ProxyChannelInfo, node) {
+    ListNode *bucket = TransProxyChanIndexGetMyIdBucket(&g_proxyChannelIndex, myId);
+    LIST_FOR_EACH_ENTRY(item, bucket, ProxyChannelInfo, myIdNode) {
         if ((item->myId == myId) && (strcmp(item->identity, identity) == 0)) {
             *appType = item->appInfo.appType;
             (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
@@ -145,7 +148,8 @@ static int32_t TransProxyUpdateAckInfo(ProxyChannelInfo *info)
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
     ProxyChannelInfo *item = NULL;
-    LIST_FOR_EACH_ENTRY(item, &g_proxyChannelList->list, ProxyChannelInfo, node) {
+    ListNode *bucket = TransProxyChanIndexGetMyIdBucket(&g_proxyChannelIndex, info->myId);
+    LIST_FOR_EACH_ENTRY(item, bucket, ProxyChannelInfo, myIdNode) {
         if ((item->myId == info->myId) && (strncmp(item->identity, info->identity, sizeof(item->identity)) == 0)) {
             item->peerId = info->peerId;
             item->status = PROXY_CHANNEL_STATUS_COMPLETED;
@@ -180,7 +184,8 @@ int32_t TransRefreshProxyTimesNative(int32_t channelId)
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
 
     ProxyChannelInfo *item = NULL;
-    LIST_FOR_EACH_ENTRY(item, &g_proxyChannelList->list, ProxyChannelInfo, node) {
+    ListNode *bucket = TransProxyChanIndexGetMyIdBucket(&g_proxyChannelIndex, (int16_t)channelId);
+    LIST_FOR_EACH_ENTRY(item, bucket, ProxyChannelInfo, myIdNode) {
         if (item->myId == channelId) {
             item->timeout = 0;
             (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
@@ -191,6 +196,14 @@ int32_t TransRefreshProxyTimesNative(int32_t channelId)
     return SOFTBUS_TRANS_NODE_NOT_FOUND;
 }
 
+// the caller holds the list lock and still owns chan afterwards
+static void TransProxyUnlinkChanItem(ProxyChannelInfo *chan)
+{
+    ListDelete(&(chan->node));
+    TransProxyChanIndexRemove(chan);
+    g_proxyChannelList->cnt--;
+}
+
 static int32_t TransProxyAddChanItem(ProxyChannelInfo *chan)
 {
     TRANS_CHECK_AND_RETURN_RET_LOGE((g_proxyChannelList != NULL && chan != NULL), SOFTBUS_INVALID_PARAM, TRANS_CTRL,
@@ -199,6 +212,7 @@ static int32_t TransProxyAddChanItem(ProxyChannelInfo *chan)
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
 
     ListAdd(&(g_proxyChannelList->list), &(chan->node));
+    TransProxyChanIndexAdd(&g_proxyChannelIndex, chan);
     g_proxyChannelList->cnt++;
     (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
     return SOFTBUS_OK;
@@ -211,28 +225,25 @@ int32_t TransProxySpecialUpdateChanInfo(ProxyChannelInfo *channelInfo)
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
 
-    ProxyChannelInfo *item = NULL;
-    ProxyChannelInfo *nextNode = NULL;
-    LIST_FOR_EACH_ENTRY_SAFE(item, nextNode, &g_proxyChannelList->list, ProxyChannelInfo, node) {
-        if (item->channelId == channelInfo->channelId) {
-            if (channelInfo->reqId != -1) {
-                item->reqId = channelInfo->reqId;
-            }
-            if (channelInfo->isServer != -1) {
-                item->isServer = channelInfo->isServer;
-            }
-            if (channelInfo->type != CONNECT_TYPE_MAX) {
-                item->type = channelInfo->type;
-            }
-            if (channelInfo->status != -1) {
-                item->status = channelInfo->status;
-            }
-            if (channelInfo->status == PROXY_CHANNEL_STATUS_HANDSHAKEING) {
-                item->connId = channelInfo->connId;
-            }
-            (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-            return SOFTBUS_OK;
+    ProxyChannelInfo *item = TransProxyChanIndexFindByChanId(&g_proxyChannelIndex, channelInfo->channelId);
+    if (item != NULL) {
+        if (channelInfo->reqId != -1) {
+            item->reqId = channelInfo->reqId;
+        }
+        if (channelInfo->isServer != -1) {
+            item->isServer = channelInfo->isServer;
+        }
+        if (channelInfo->type != CONNECT_TYPE_MAX) {
+            item->type = channelInfo->type;
         }
+        if (channelInfo->status != -1) {
+            item->status = channelInfo->status;
+        }
+        if (channelInfo->status == PROXY_CHANNEL_STATUS_HANDSHAKEING) {
+            TransProxyChanIndexSetConnId(&g_proxyChannelIndex, item, channelInfo->connId);
+        }
+        (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
+        return SOFTBUS_OK;
     }
     (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
     return SOFTBUS_TRANS_NODE_NOT_FOUND;
@@ -245,19 +256,15 @@ int32_t TransProxyGetChanByChanId(int32_t chanId, ProxyChannelInfo *chan)
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
 
-    ProxyChannelInfo *item = NULL;
-    ProxyChannelInfo *nextNode = NULL;
-
-    LIST_FOR_EACH_ENTRY_SAFE(item, nextNode, &g_proxyChannelList->list, ProxyChannelInfo, node) {
-        if (item->channelId == chanId) {
-            if (memcpy_s(chan, sizeof(ProxyChannelInfo), item, sizeof(ProxyChannelInfo)) != EOK) {
-                (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-                TRANS_LOGE(TRANS_SVC, "memcpy_s failed");
-                return SOFTBUS_MEM_ERR;
-            }
+    ProxyChannelInfo *item = TransProxyChanIndexFindByChanId(&g_proxyChannelIndex, chanId);
+    if (item != NULL) {
+        if (memcpy_s(chan, sizeof(ProxyChannelInfo), item, sizeof(ProxyChannelInfo)) != EOK) {
             (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-            return SOFTBUS_OK;
+            TRANS_LOGE(TRANS_SVC, "memcpy_s failed");
+            return SOFTBUS_MEM_ERR;
         }
+        (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
+        return SOFTBUS_OK;
     }
     (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
     TRANS_LOGE(TRANS_CTRL, "proxy channel not found by chanId. chanId=%{public}d", chanId);
@@ -272,14 +279,12 @@ int32_t TransProxySetUkInfoByChanId(int32_t chanId, const UkIdInfo *ukIdInfo)
         "uk info param nullptr!");
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
-    ProxyChannelInfo *item = NULL;
-    LIST_FOR_EACH_ENTRY(item, &g_proxyChannelList->list, ProxyChannelInfo, node) {
-        if (item->channelId == chanId) {
-            item->ukIdInfo.myId = ukIdInfo->myId;
-            item->ukIdInfo.peerId = ukIdInfo->peerId;
-            (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-            return SOFTBUS_OK;
-        }
+    ProxyChannelInfo *item = TransProxyChanIndexFindByChanId(&g_proxyChannelIndex, chanId);
+    if (item != NULL) {
+        item->ukIdInfo.myId = ukIdInfo->myId;
+        item->ukIdInfo.peerId = ukIdInfo->peerId;
+        (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
+        return SOFTBUS_OK;
     }
     (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
     TRANS_LOGE(TRANS_CTRL, "proxy channel not found by chanId. chanId=%{public}d", chanId);
@@ -294,14 +299,12 @@ int32_t TransProxyGetUkInfoByChanId(int32_t chanId, UkIdInfo *ukIdInfo)
         "uk info param nullptr!");
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
-    ProxyChannelInfo *item = NULL;
-    LIST_FOR_EACH_ENTRY(item, &g_proxyChannelList->list, ProxyChannelInfo, node) {
-        if (item->channelId == chanId) {
-            ukIdInfo->myId = item->ukIdInfo.myId;
-            ukIdInfo->peerId = item->ukIdInfo.peerId;
-            (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-            return SOFTBUS_OK;
-        }
+    ProxyChannelInfo *item = TransProxyChanIndexFindByChanId(&g_proxyChannelIndex, chanId);
+    if (item != NULL) {
+        ukIdInfo->myId = item->ukIdInfo.myId;
+        ukIdInfo->peerId = item->ukIdInfo.peerId;
+        (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
+        return SOFTBUS_OK;
     }
     (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
     TRANS_LOGE(TRANS_CTRL, "proxy channel not found by chanId. chanId=%{public}d", chanId);
@@ -340,8 +343,7 @@ void TransProxyDelChanByReqId(int32_t reqId, int32_t errCode)
         if ((item->reqId == reqId) &&
             (item->status == PROXY_CHANNEL_STATUS_PYH_CONNECTING)) {
             ReleaseProxyChannelId(item->channelId);
-            ListDelete(&(item->node));
-            g_proxyChannelList->cnt--;
+            TransProxyUnlinkChanItem(item);
             TRANS_LOGI(TRANS_CTRL, "del channelId by reqId. channelId=%{public}d", item->channelId);
             SoftBusFree((void *)item->appInfo.fastTransData);
             item->appInfo.fastTransData = NULL;
@@ -355,26 +357,22 @@ void TransProxyDelChanByReqId(int32_t reqId, int32_t errCode)
 void TransProxyDelChanByChanId(int32_t chanlId)
 {
     ProxyChannelInfo *item = NULL;
-    ProxyChannelInfo *nextNode = NULL;
 
     TRANS_CHECK_AND_RETURN_LOGE(
         g_proxyChannelList != NULL, TRANS_CTRL, "g_proxyChannelList is null");
     TRANS_CHECK_AND_RETURN_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, TRANS_CTRL, "lock mutex fail!");
 
-    LIST_FOR_EACH_ENTRY_SAFE(item, nextNode, &g_proxyChannelList->list, ProxyChannelInfo, node) {
-        if (item->channelId == chanlId) {
-            ReleaseProxyChannelId(item->channelId);
-            ListDelete(&(item->node));
-            if (item->appInfo.fastTransData != NULL) {
-                SoftBusFree((void *)item->appInfo.fastTransData);
-            }
-            (void)memset_s(item->appInfo.sessionKey, sizeof(item->appInfo.sessionKey), 0,
-                sizeof(item->appInfo.sessionKey));
-            SoftBusFree(item);
-            g_proxyChannelList->cnt--;
-            break;
+    item = TransProxyChanIndexFindByChanId(&g_proxyChannelIndex, chanlId);
+    if (item != NULL) {
+        ReleaseProxyChannelId(item->channelId);
+        TransProxyUnlinkChanItem(item);
+        if (item->appInfo.fastTransData != NULL) {
+            SoftBusFree((void *)item->appInfo.fastTransData);
         }
+        (void)memset_s(item->appInfo.sessionKey, sizeof(item->appInfo.sessionKey), 0,
+            sizeof(item->appInfo.sessionKey));
+        SoftBusFree(item);
     }
     (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
     TRANS_LOGE(TRANS_CTRL, "del channelId by chanId! channelId=%{public}d", chanlId);
@@ -393,7 +391,7 @@ void TransProxyChanProcessByReqId(int32_t reqId, uint32_t connId, int32_t errCod
     LIST_FOR_EACH_ENTRY(item, &g_proxyChannelList->list, ProxyChannelInfo, node) {
         if (item->reqId == reqId && item->status == PROXY_CHANNEL_STATUS_PYH_CONNECTING) {
             item->status = PROXY_CHANNEL_STATUS_HANDSHAKEING;
-            item->connId = connId;
+            TransProxyChanIndexSetConnId(&g_proxyChannelIndex, item, connId);
             isUsing = true;
             TransAddConnRefByConnId(connId, (bool)item->isServer);
             TransProxyPostHandshakeMsgToLoop(item->channelId);
@@ -439,11 +437,11 @@ void TransProxyDelByConnId(uint32_t connId)
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, TRANS_CTRL, "lock mutex fail!");
 
     ListInit(&proxyChannelList);
-    LIST_FOR_EACH_ENTRY_SAFE(removeNode, nextNode, &g_proxyChannelList->list, ProxyChannelInfo, node) {
+    ListNode *bucket = TransProxyChanIndexGetConnIdBucket(&g_proxyChannelIndex, connId);
+    LIST_FOR_EACH_ENTRY_SAFE(removeNode, nextNode, bucket, ProxyChannelInfo, connIdNode) {
         if (removeNode->connId == connId) {
             ReleaseProxyChannelId(removeNode->channelId);
-            ListDelete(&(removeNode->node));
-            g_proxyChannelList->cnt--;
+            TransProxyUnlinkChanItem(removeNode);
             ListAdd(&proxyChannelList, &removeNode->node);
             TRANS_LOGI(TRANS_CTRL, "trans proxy del channel by connId=%{public}d", connId);
         }
@@ -454,30 +452,25 @@ void TransProxyDelByConnId(uint32_t connId)
 
 static int32_t TransProxyDelByChannelId(int32_t channelId, ProxyChannelInfo *channelInfo)
 {
-    ProxyChannelInfo *removeNode = NULL;
-    ProxyChannelInfo *nextNode = NULL;
-
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         g_proxyChannelList != NULL, SOFTBUS_NO_INIT, TRANS_CTRL, "g_proxyChannelList is null");
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
 
-    LIST_FOR_EACH_ENTRY_SAFE(removeNode, nextNode, &g_proxyChannelList->list, ProxyChannelInfo, node) {
-        if (removeNode->channelId == channelId) {
-            if (channelInfo != NULL) {
-                (void)memcpy_s(channelInfo, sizeof(ProxyChannelInfo), removeNode, sizeof(ProxyChannelInfo));
-            }
-            ReleaseProxyChannelId(removeNode->channelId);
-            if (removeNode->appInfo.fastTransData != NULL) {
-                SoftBusFree((void *)removeNode->appInfo.fastTransData);
-            }
-            ListDelete(&(removeNode->node));
-            SoftBusFree(removeNode);
-            g_proxyChannelList->cnt--;
-            (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-            TRANS_LOGI(TRANS_CTRL, "trans proxy del channel by channelId=%{public}d", channelId);
-            return SOFTBUS_OK;
+    ProxyChannelInfo *removeNode = TransProxyChanIndexFindByChanId(&g_proxyChannelIndex, channelId);
+    if (removeNode != NULL) {
+        if (channelInfo != NULL) {
+            (void)memcpy_s(channelInfo, sizeof(ProxyChannelInfo), removeNode, sizeof(ProxyChannelInfo));
+        }
+        ReleaseProxyChannelId(removeNode->channelId);
+        if (removeNode->appInfo.fastTransData != NULL) {
+            SoftBusFree((void *)removeNode->appInfo.fastTransData);
         }
+        TransProxyUnlinkChanItem(removeNode);
+        SoftBusFree(removeNode);
+        (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
+        TRANS_LOGI(TRANS_CTRL, "trans proxy del channel by channelId=%{public}d", channelId);
+        return SOFTBUS_OK;
     }
     (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
     return SOFTBUS_TRANS_NODE_NOT_FOUND;
@@ -493,7 +486,8 @@ static int32_t TransProxyResetChan(ProxyChannelInfo *chanInfo)
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
 
-    LIST_FOR_EACH_ENTRY_SAFE(removeNode, nextNode, &g_proxyChannelList->list, ProxyChannelInfo, node) {
+    ListNode *bucket = TransProxyChanIndexGetMyIdBucket(&g_proxyChannelIndex, chanInfo->myId);
+    LIST_FOR_EACH_ENTRY_SAFE(removeNode, nextNode, bucket, ProxyChannelInfo, myIdNode) {
         if (ResetChanIsEqual(removeNode->status, removeNode, chanInfo)) {
             if (memcpy_s(chanInfo, sizeof(ProxyChannelInfo), removeNode, sizeof(ProxyChannelInfo)) != EOK) {
                 (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
@@ -504,9 +498,8 @@ static int32_t TransProxyResetChan(ProxyChannelInfo *chanInfo)
             if (removeNode->appInfo.fastTransData != NULL) {
                 SoftBusFree((void *)removeNode->appInfo.fastTransData);
             }
-            ListDelete(&(removeNode->node));
+            TransProxyUnlinkChanItem(removeNode);
             SoftBusFree(removeNode);
-            g_proxyChannelList->cnt--;
             (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
             TRANS_LOGI(TRANS_CTRL, "trans proxy reset channelId=%{public}d", chanInfo->channelId);
             return SOFTBUS_OK;
@@ -526,7 +519,8 @@ static int32_t TransProxyGetRecvMsgChanInfo(int16_t myId, int16_t peerId, ProxyC
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
 
-    LIST_FOR_EACH_ENTRY(item, &g_proxyChannelList->list, ProxyChannelInfo, node) {
+    ListNode *bucket = TransProxyChanIndexGetMyIdBucket(&g_proxyChannelIndex, myId);
+    LIST_FOR_EACH_ENTRY(item, bucket, ProxyChannelInfo, myIdNode) {
         if ((item->myId == myId) && (item->peerId == peerId)) {
             if (item->status == PROXY_CHANNEL_STATUS_COMPLETED) {
                 item->timeout = 0;
@@ -553,7 +547,8 @@ static int32_t TransProxyKeepAliveChan(ProxyChannelInfo *chanInfo)
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
 
-    LIST_FOR_EACH_ENTRY(item, &g_proxyChannelList->list, ProxyChannelInfo, node) {
+    ListNode *bucket = TransProxyChanIndexGetMyIdBucket(&g_proxyChannelIndex, chanInfo->myId);
+    LIST_FOR_EACH_ENTRY(item, bucket, ProxyChannelInfo, myIdNode) {
         if (ChanIsEqual(item, chanInfo)) {
             if (item->status == PROXY_CHANNEL_STATUS_KEEPLIVEING || item->status == PROXY_CHANNEL_STATUS_COMPLETED) {
                 item->timeout = 0;
@@ -581,19 +576,18 @@ int32_t TransProxyGetSendMsgChanInfo(int32_t channelId, ProxyChannelInfo *chanIn
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
 
-    LIST_FOR_EACH_ENTRY(item, &g_proxyChannelList->list, ProxyChannelInfo, node) {
-        if (item->channelId == channelId) {
-            if (item->status == PROXY_CHANNEL_STATUS_COMPLETED) {
-                item->timeout = 0;
-            }
-            if (memcpy_s(chanInfo, sizeof(ProxyChannelInfo), item, sizeof(ProxyChannelInfo)) != EOK) {
-                (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-                TRANS_LOGE(TRANS_SVC, "memcpy_s failed");
-                return SOFTBUS_MEM_ERR;
-            }
+    item = TransProxyChanIndexFindByChanId(&g_proxyChannelIndex, channelId);
+    if (item != NULL) {
+        if (item->status == PROXY_CHANNEL_STATUS_COMPLETED) {
+            item->timeout = 0;
+        }
+        if (memcpy_s(chanInfo, sizeof(ProxyChannelInfo), item, sizeof(ProxyChannelInfo)) != EOK) {
             (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-            return SOFTBUS_OK;
+            TRANS_LOGE(TRANS_SVC, "memcpy_s failed");
+            return SOFTBUS_MEM_ERR;
         }
+        (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
+        return SOFTBUS_OK;
     }
     (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
     return SOFTBUS_TRANS_NODE_NOT_FOUND;
@@ -609,13 +603,12 @@ int32_t TransProxyGetNewChanSeq(int32_t channelId)
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, seq, TRANS_CTRL, "lock mutex fail!");
 
-    LIST_FOR_EACH_ENTRY(item, &g_proxyChannelList->list, ProxyChannelInfo, node) {
-        if (item->channelId == channelId) {
-            seq = item->seq;
-            item->seq++;
-            (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-            return seq;
-        }
+    item = TransProxyChanIndexFindByChanId(&g_proxyChannelIndex, channelId);
+    if (item != NULL) {
+        seq = item->seq;
+        item->seq++;
+        (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
+        return seq;
     }
     (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
     return seq;
@@ -630,12 +623,11 @@ int32_t TransProxyGetAuthId(int32_t channelId, AuthHandle *authHandle)
         g_proxyChannelList != NULL, SOFTBUS_NO_INIT, TRANS_CTRL, "g_proxyChannelList is null");
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
-    LIST_FOR_EACH_ENTRY(item, &g_proxyChannelList->list, ProxyChannelInfo, node) {
-        if (item->channelId == channelId) {
-            *authHandle = item->authHandle;
-            (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-            return SOFTBUS_OK;
-        }
+    item = TransProxyChanIndexFindByChanId(&g_proxyChannelIndex, channelId);
+    if (item != NULL) {
+        *authHandle = item->authHandle;
+        (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
+        return SOFTBUS_OK;
     }
     (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
     return SOFTBUS_TRANS_NODE_NOT_FOUND;
@@ -650,20 +642,19 @@ int32_t TransProxyGetSessionKeyByChanId(int32_t channelId, char *sessionKey, uin
         g_proxyChannelList != NULL, SOFTBUS_NO_INIT, TRANS_CTRL, "g_proxyChannelList is null");
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
-    LIST_FOR_EACH_ENTRY(item, &g_proxyChannelList->list, ProxyChannelInfo, node) {
-        if (item->channelId == channelId) {
-            if (item->status == PROXY_CHANNEL_STATUS_COMPLETED) {
-                item->timeout = 0;
-            }
-            if (memcpy_s(sessionKey, sessionKeySize, item->appInfo.sessionKey,
-                sizeof(item->appInfo.sessionKey)) != EOK) {
-                TRANS_LOGE(TRANS_CTRL, "memcpy_s fail!");
-                (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-                return SOFTBUS_MEM_ERR;
-            }
+    item = TransProxyChanIndexFindByChanId(&g_proxyChannelIndex, channelId);
+    if (item != NULL) {
+        if (item->status == PROXY_CHANNEL_STATUS_COMPLETED) {
+            item->timeout = 0;
+        }
+        if (memcpy_s(sessionKey, sessionKeySize, item->appInfo.sessionKey,
+            sizeof(item->appInfo.sessionKey)) != EOK) {
+            TRANS_LOGE(TRANS_CTRL, "memcpy_s fail!");
             (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-            return SOFTBUS_OK;
+            return SOFTBUS_MEM_ERR;
         }
+        (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
+        return SOFTBUS_OK;
     }
     (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
     TRANS_LOGE(TRANS_CTRL, "not found ChannelInfo by channelId=%{public}d", channelId);
@@ -690,7 +681,8 @@ int32_t TransProxyGetAppInfoById(int16_t channelId, AppInfo *appInfo)
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
 
-    LIST_FOR_EACH_ENTRY(item, &g_proxyChannelList->list, ProxyChannelInfo, node) {
+    ListNode *bucket = TransProxyChanIndexGetMyIdBucket(&g_proxyChannelIndex, channelId);
+    LIST_FOR_EACH_ENTRY(item, bucket, ProxyChannelInfo, myIdNode) {
         if (item->myId == channelId) {
             if (memcpy_s(appInfo, sizeof(AppInfo), &(item->appInfo), sizeof(item->appInfo)) != EOK) {
                 (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
@@ -713,7 +705,8 @@ static int32_t TransProxyGetReqIdAndStatus(int32_t myId, int32_t *reqId, int8_t
     int32_t ret = SoftBusMutexLock(&g_proxyChannelList->lock);
     TRANS_CHECK_AND_RETURN_RET_LOGE(ret == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
     ProxyChannelInfo *item = NULL;
-    LIST_FOR_EACH_ENTRY(item, &g_proxyChannelList->list, ProxyChannelInfo, node) {
+    ListNode *bucket = TransProxyChanIndexGetMyIdBucket(&g_proxyChannelIndex, (int16_t)myId);
+    LIST_FOR_EACH_ENTRY(item, bucket, ProxyChannelInfo, myIdNode) {
         if (item->myId == myId) {
             *reqId = item->reqId;
             *status = item->status;
@@ -1429,13 +1422,11 @@ static int32_t TransProxyUpdateReplyCnt(int32_t channelId)
         g_proxyChannelList != NULL, SOFTBUS_NO_INIT, TRANS_CTRL, "g_proxyChannelList is null");
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
-    ProxyChannelInfo *item = NULL;
-    LIST_FOR_EACH_ENTRY(item, &g_proxyChannelList->list, ProxyChannelInfo, node) {
-        if (item->channelId == channelId) {
-            item->appInfo.waitOpenReplyCnt = CHANNEL_OPEN_SUCCESS;
-            (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-            return SOFTBUS_OK;
-        }
+    ProxyChannelInfo *item = TransProxyChanIndexFindByChanId(&g_proxyChannelIndex, channelId);
+    if (item != NULL) {
+        item->appInfo.waitOpenReplyCnt = CHANNEL_OPEN_SUCCESS;
+        (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
+        return SOFTBUS_OK;
     }
     (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
     TRANS_LOGE(TRANS_CTRL, "proxy channel not found by channelId. channelId=%{public}d", channelId);
@@ -1490,16 +1481,14 @@ static int32_t TransCheckProxyChannelOpenStatus(int32_t channelId, int32_t *curC
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
     
-    ProxyChannelInfo *item = NULL;
-    LIST_FOR_EACH_ENTRY(item, &g_proxyChannelList->list, ProxyChannelInfo, node) {
-        if (item->channelId == channelId) {
-            if (item->appInfo.waitOpenReplyCnt != CHANNEL_OPEN_SUCCESS) {
-                item->appInfo.waitOpenReplyCnt++;
-            }
-            *curCount = item->appInfo.waitOpenReplyCnt;
-            (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-            return SOFTBUS_OK;
+    ProxyChannelInfo *item = TransProxyChanIndexFindByChanId(&g_proxyChannelIndex, channelId);
+    if (item != NULL) {
+        if (item->appInfo.waitOpenReplyCnt != CHANNEL_OPEN_SUCCESS) {
+            item->appInfo.waitOpenReplyCnt++;
         }
+        *curCount = item->appInfo.waitOpenReplyCnt;
+        (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
+        return SOFTBUS_OK;
     }
     (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
     TRANS_LOGE(TRANS_CTRL, "proxy channel not found by channelId. channelId=%{public}d", channelId);
@@ -2027,9 +2016,8 @@ void TransProxyTimerProc(void)
                     PROXY_CHANNEL_STATUS_HANDSHAKE_TIMEOUT : PROXY_CHANNEL_STATUS_CONNECTING_TIMEOUT;
                 TRANS_LOGE(TRANS_CTRL, "handshake is timeout. channelId=%{public}d", removeNode->myId);
                 ReleaseProxyChannelId(removeNode->channelId);
-                ListDelete(&(removeNode->node));
+                TransProxyUnlinkChanItem(removeNode);
                 ListAdd(&proxyProcList, &(removeNode->node));
-                g_proxyChannelList->cnt--;
             }
         }
         if (removeNode->status == PROXY_CHANNEL_STATUS_KEEPLIVEING) {
@@ -2037,9 +2025,8 @@ void TransProxyTimerProc(void)
                 removeNode->status = PROXY_CHANNEL_STATUS_TIMEOUT;
                 TRANS_LOGE(TRANS_CTRL, "keepalvie is timeout. channelId=%{public}d", removeNode->myId);
                 ReleaseProxyChannelId(removeNode->channelId);
-                ListDelete(&(removeNode->node));
+                TransProxyUnlinkChanItem(removeNode);
                 ListAdd(&proxyProcList, &(removeNode->node));
-                g_proxyChannelList->cnt--;
             }
         }
     }
@@ -2154,6 +2141,7 @@ static int32_t TransProxyManagerInitInner(const IServerChannelCallBack *cb)
         TRANS_LOGE(TRANS_INIT, "proxy manager init inner failed");
         return SOFTBUS_MALLOC_ERR;
     }
+    TransProxyChanIndexInit(&g_proxyChannelIndex);
     return SOFTBUS_OK;
 }
 
@@ -2228,7 +2216,7 @@ static void TransProxyManagerDeinitInner(void)
     ProxyChannelInfo *nextNode = NULL;
     LIST_FOR_EACH_ENTRY_SAFE(item, nextNode, &g_proxyChannelList->list, ProxyChannelInfo, node) {
         ReleaseProxyChannelId(item->channelId);
-        ListDelete(&(item->node));
+        TransProxyUnlinkChanItem(item);
         if (item->appInfo.fastTransData != NULL) {
             SoftBusFree((void *)item->appInfo.fastTransData);
         }
@@ -2288,8 +2276,7 @@ void TransProxyDeathCallback(const char *pkgName, int32_t pid)
     LIST_FOR_EACH_ENTRY_SAFE(item, nextNode, &g_proxyChannelList->list, ProxyChannelInfo, node) {
         if ((strcmp(item->appInfo.myData.pkgName, pkgName) == 0) && (item->appInfo.myData.pid == pid)) {
             ReleaseProxyChannelId(item->channelId);
-            ListDelete(&(item->node));
-            g_proxyChannelList->cnt--;
+            TransProxyUnlinkChanItem(item);
             ListAdd(&destroyList, &(item->node));
             TRANS_LOGI(TRANS_CTRL, "add channelId=%{public}d", item->channelId);
         }
@@ -2305,23 +2292,21 @@ int32_t TransProxyGetAppInfoByChanId(int32_t chanId, AppInfo *appInfo)
         "invalid param");
 
     ProxyChannelInfo *item = NULL;
-    ProxyChannelInfo *nextNode = NULL;
 
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         g_proxyChannelList != NULL, SOFTBUS_NO_INIT, TRANS_CTRL, "g_proxyChannelList is null");
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
 
-    LIST_FOR_EACH_ENTRY_SAFE(item, nextNode, &g_proxyChannelList->list, ProxyChannelInfo, node) {
-        if (item->channelId == chanId) {
-            if (memcpy_s(appInfo, sizeof(AppInfo), &item->appInfo, sizeof(AppInfo)) != EOK) {
-                (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-                TRANS_LOGE(TRANS_SVC, "memcpy_s failed");
-                return SOFTBUS_MEM_ERR;
-            }
+    item = TransProxyChanIndexFindByChanId(&g_proxyChannelIndex, chanId);
+    if (item != NULL) {
+        if (memcpy_s(appInfo, sizeof(AppInfo), &item->appInfo, sizeof(AppInfo)) != EOK) {
             (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-            return SOFTBUS_OK;
+            TRANS_LOGE(TRANS_SVC, "memcpy_s failed");
+            return SOFTBUS_MEM_ERR;
         }
+        (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
+        return SOFTBUS_OK;
     }
     (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
     TRANS_LOGE(TRANS_CTRL, "Proxy channel not find: channelId=%{public}d", chanId);
@@ -2339,18 +2324,17 @@ int32_t TransProxyGetConnIdByChanId(int32_t channelId, int32_t *connId)
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
 
-    LIST_FOR_EACH_ENTRY(item, &g_proxyChannelList->list, ProxyChannelInfo, node) {
-        if (item->channelId == channelId) {
-            if (item->status == PROXY_CHANNEL_STATUS_COMPLETED ||
-                item->status == PROXY_CHANNEL_STATUS_KEEPLIVEING) {
-                *connId = (int32_t)item->connId;
-                (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-                return SOFTBUS_OK;
-            } else {
-                TRANS_LOGE(TRANS_CTRL, "g_proxyChannel status error");
-                (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-                return SOFTBUS_TRANS_PROXY_CHANNLE_STATUS_INVALID;
-            }
+    item = TransProxyChanIndexFindByChanId(&g_proxyChannelIndex, channelId);
+    if (item != NULL) {
+        if (item->status == PROXY_CHANNEL_STATUS_COMPLETED ||
+            item->status == PROXY_CHANNEL_STATUS_KEEPLIVEING) {
+            *connId = (int32_t)item->connId;
+            (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
+            return SOFTBUS_OK;
+        } else {
+            TRANS_LOGE(TRANS_CTRL, "g_proxyChannel status error");
+            (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
+            return SOFTBUS_TRANS_PROXY_CHANNLE_STATUS_INVALID;
         }
     }
     (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
@@ -2369,22 +2353,20 @@ int32_t TransProxyGetProxyChannelInfoByChannelId(int32_t channelId, ProxyChannel
         TRANS_LOGE(TRANS_CTRL, "lock mutex fail!");
         return SOFTBUS_LOCK_ERR;
     }
-    ProxyChannelInfo *item = NULL;
-    LIST_FOR_EACH_ENTRY(item, &g_proxyChannelList->list, ProxyChannelInfo, node) {
-        if (item->channelId == channelId) {
-            if (item->status != PROXY_CHANNEL_STATUS_COMPLETED && item->status != PROXY_CHANNEL_STATUS_KEEPLIVEING) {
-                TRANS_LOGE(TRANS_CTRL, "invalid status=%{public}d, channelId=%{public}d", item->status, channelId);
-                (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-                return SOFTBUS_TRANS_PROXY_CHANNLE_STATUS_INVALID;
-            }
-            if (memcpy_s(chan, sizeof(ProxyChannelInfo), item, sizeof(ProxyChannelInfo)) != EOK) {
-                (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-                TRANS_LOGE(TRANS_CTRL, "memcpy_s failed");
-                return SOFTBUS_MEM_ERR;
-            }
+    ProxyChannelInfo *item = TransProxyChanIndexFindByChanId(&g_proxyChannelIndex, channelId);
+    if (item != NULL) {
+        if (item->status != PROXY_CHANNEL_STATUS_COMPLETED && item->status != PROXY_CHANNEL_STATUS_KEEPLIVEING) {
+            TRANS_LOGE(TRANS_CTRL, "invalid status=%{public}d, channelId=%{public}d", item->status, channelId);
             (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-            return SOFTBUS_OK;
+            return SOFTBUS_TRANS_PROXY_CHANNLE_STATUS_INVALID;
+        }
+        if (memcpy_s(chan, sizeof(ProxyChannelInfo), item, sizeof(ProxyChannelInfo)) != EOK) {
+            (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
+            TRANS_LOGE(TRANS_CTRL, "memcpy_s failed");
+            return SOFTBUS_MEM_ERR;
         }
+        (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
+        return SOFTBUS_OK;
     }
     (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
     TRANS_LOGE(TRANS_CTRL, "not found proxy channel info by channelId=%{public}d", channelId);
@@ -2394,20 +2376,18 @@ int32_t TransProxyGetProxyChannelInfoByChannelId(int32_t channelId, ProxyChannel
 int32_t TransProxySetAuthHandleByChanId(int32_t channelId, AuthHandle authHandle)
 {
     ProxyChannelInfo *item = NULL;
-    ProxyChannelInfo *nextNode = NULL;
 
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         g_proxyChannelList != NULL, SOFTBUS_NO_INIT, TRANS_CTRL, "g_proxyChannelList is null");
     TRANS_CHECK_AND_RETURN_RET_LOGE(
         SoftBusMutexLock(&g_proxyChannelList->lock) == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
 
-    LIST_FOR_EACH_ENTRY_SAFE(item, nextNode, &g_proxyChannelList->list, ProxyChannelInfo, node) {
-        if (item->channelId == channelId) {
-            item->authHandle.authId = authHandle.authId;
-            item->authHandle.type = authHandle.type;
-            (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-            return SOFTBUS_OK;
-        }
+    item = TransProxyChanIndexFindByChanId(&g_proxyChannelIndex, channelId);
+    if (item != NULL) {
+        item->authHandle.authId = authHandle.authId;
+        item->authHandle.type = authHandle.type;
+        (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
+        return SOFTBUS_OK;
     }
     (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
     TRANS_LOGE(TRANS_CTRL, "proxy channel not found by chanId, chanId=%{public}d", channelId);
@@ -2440,13 +2420,11 @@ static int32_t TransProxyResetReplyCnt(int32_t channelId)
         g_proxyChannelList != NULL, SOFTBUS_NO_INIT, TRANS_CTRL, "g_proxyChannelList is null.");
     int32_t ret = SoftBusMutexLock(&g_proxyChannelList->lock);
     TRANS_CHECK_AND_RETURN_RET_LOGE(ret == SOFTBUS_OK, SOFTBUS_LOCK_ERR, TRANS_CTRL, "lock mutex fail!");
-    ProxyChannelInfo *item = NULL;
-    LIST_FOR_EACH_ENTRY(item, &g_proxyChannelList->list, ProxyChannelInfo, node) {
-        if (item->channelId == channelId) {
-            item->appInfo.waitOpenReplyCnt = 0;
-            (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
-            return SOFTBUS_OK;
-        }
+    ProxyChannelInfo *item = TransProxyChanIndexFindByChanId(&g_proxyChannelIndex, channelId);
+    if (item != NULL) {
+        item->appInfo.waitOpenReplyCnt = 0;
+        (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
+        return SOFTBUS_OK;
     }
     (void)SoftBusMutexUnlock(&g_proxyChannelList->lock);
     TRANS_LOGE(TRANS_CTRL, "proxy channel not found by channelId=%{public}d", channelId);
@@ -187,13 +187,8 @@ static int32_t TransProxyTransNormalMsg(const ProxyChannelInfo *info, const char
     return SOFTBUS_OK;
 }
 
-int32_t TransProxyTransDataSendMsg(ProxyChannelInfo *info, const unsigned char *payLoad,
-    int32_t payLoadLen, ProxyPacketType flag)
+static int32_t TransProxyCheckSendChanInfo(const ProxyChannelInfo *info)
 {
-    if (info == NULL || payLoad == NULL) {
-        TRANS_LOGE(TRANS_MSG, "param invalid");
-        return SOFTBUS_INVALID_PARAM;
-    }
     if ((info->status != PROXY_CHANNEL_STATUS_COMPLETED && info->status != PROXY_CHANNEL_STATUS_KEEPLIVEING)) {
         TRANS_LOGE(TRANS_MSG, "status is err status=%{public}d", info->status);
         return SOFTBUS_TRANS_PROXY_CHANNLE_STATUS_INVALID;
@@ -202,10 +197,68 @@ int32_t TransProxyTransDataSendMsg(ProxyChannelInfo *info, const unsigned char *
         TRANS_LOGE(TRANS_MSG, "err app type Inner");
         return SOFTBUS_TRANS_PROXY_ERROR_APP_TYPE;
     }
+    return SOFTBUS_OK;
+}
+
+int32_t TransProxyTransDataSendMsg(ProxyChannelInfo *info, const unsigned char *payLoad,
+    int32_t payLoadLen, ProxyPacketType flag)
+{
+    if (info == NULL || payLoad == NULL) {
+        TRANS_LOGE(TRANS_MSG, "param invalid");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    int32_t ret = TransProxyCheckSendChanInfo(info);
+    if (ret != SOFTBUS_OK) {
+        return ret;
+    }
 
     return TransProxyTransNormalMsg(info, (const char *)payLoad, payLoadLen, flag);
 }
 
+int32_t TransProxyPostSessionSlices(int32_t channelId, ProxyDataInfo *dataInfo, SessionPktType flags)
+{
+    if (dataInfo == NULL || dataInfo->outData == NULL || dataInfo->outLen == 0) {
+        TRANS_LOGE(TRANS_MSG, "invalid param");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    ProxyChannelInfo *chanInfo = (ProxyChannelInfo *)SoftBusCalloc(sizeof(ProxyChannelInfo));
+    if (chanInfo == NULL) {
+        TRANS_LOGE(TRANS_MSG, "malloc in channelId=%{public}d", channelId);
+        return SOFTBUS_MALLOC_ERR;
+    }
+    if (TransProxyGetSendMsgChanInfo(channelId, chanInfo) != SOFTBUS_OK) {
+        SoftBusFree(chanInfo);
+        TRANS_LOGE(TRANS_MSG, "can not find proxy channel channelId=%{public}d", channelId);
+        return SOFTBUS_TRANS_PROXY_CHANNEL_NOT_FOUND;
+    }
+    (void)memset_s(chanInfo->appInfo.sessionKey, sizeof(chanInfo->appInfo.sessionKey), 0,
+        sizeof(chanInfo->appInfo.sessionKey));
+    ProxySliceIterator iter;
+    int32_t ret = TransProxyCheckSendChanInfo(chanInfo);
+    if (ret != SOFTBUS_OK || (ret = TransProxySliceIterInit(&iter, dataInfo, flags)) != SOFTBUS_OK) {
+        SoftBusFree(chanInfo);
+        return ret;
+    }
+    ProxyPacketType type = SessionTypeToPacketType(flags);
+    for (uint32_t cnt = 0; cnt < iter.sliceNum; cnt++) {
+        uint32_t sliceLen = 0;
+        uint8_t *slice = TransProxySliceIterNext(&iter, &sliceLen);
+        if (slice == NULL) {
+            ret = SOFTBUS_MALLOC_ERR;
+            break;
+        }
+        ret = TransProxyTransNormalMsg(chanInfo, (const char *)slice, (int32_t)sliceLen, type);
+        if (ret != SOFTBUS_OK) {
+            TRANS_LOGE(TRANS_MSG, "send slice fail, channelId=%{public}d, sliceSeq=%{public}u, ret=%{public}d",
+                channelId, cnt, ret);
+            break;
+        }
+    }
+    TransProxySliceIterDeinit(&iter);
+    SoftBusFree(chanInfo);
+    return ret;
+}
+
 int32_t TransOnNormalMsgReceived(const char *pkgName, int32_t pid, int32_t channelId, const char *data, uint32_t len)
 {
     if (data == NULL || pkgName == NULL) {
@@ -27,6 +27,7 @@ extern "C" {
 #define MAX_SOCKET_RESOURCE_NUM 128
 #define MAX_NETWORK_RESOURCE_NUM 128
 #define MAX_CHANNEL_INFO_NUM 128
+#define MAX_NETWORK_STATISTICS_LISTENER_NUM 4
 #define MAX_SOCKET_RESOURCE_LEN 1024
 
 typedef struct {
@@ -48,6 +49,9 @@ typedef struct {
     int32_t laneLinkType;
 } NetworkResource;
 
+typedef void (*NetworkStatisticsListener)(uint64_t laneId, int32_t laneLinkType, int64_t traffic,
+    int64_t duration);
+
 void AddChannelStatisticsInfo(int32_t channelId, int32_t channelType);
 
 void AddNetworkResource(NetworkResource *networkResource);
@@ -57,6 +61,10 @@ void UpdateNetworkResourceByLaneId(int32_t channelId, int32_t channelType, uint6
 
 void DeleteNetworkResourceByLaneId(uint64_t laneId);
 
+int32_t RegisterNetworkStatisticsListener(NetworkStatisticsListener listener);
+
+void UnregisterNetworkStatisticsListener(NetworkStatisticsListener listener);
+
 int32_t TransNetworkStatisticsInit(void);
 
 void TransNetworkStatisticsDeinit(void);
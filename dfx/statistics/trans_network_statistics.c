@@ -49,6 +49,73 @@ static SoftBusList *g_networkResourceList = NULL;
 
 static SoftBusList *g_channelDfxInfoList = NULL;
 
+/* created by the first register, the lane module registers before TransNetworkStatisticsInit runs */
+static SoftBusMutex g_networkStatisticsListenerLock = 0;
+static NetworkStatisticsListener g_networkStatisticsListener[MAX_NETWORK_STATISTICS_LISTENER_NUM] = {0};
+
+int32_t RegisterNetworkStatisticsListener(NetworkStatisticsListener listener)
+{
+    if (listener == NULL) {
+        COMM_LOGE(COMM_DFX, "invalid param");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    if (SoftBusMutexInit(&g_networkStatisticsListenerLock, NULL) != SOFTBUS_OK) {
+        COMM_LOGE(COMM_DFX, "listener lock init fail");
+        return SOFTBUS_NO_INIT;
+    }
+    if (SoftBusMutexLock(&g_networkStatisticsListenerLock) != SOFTBUS_OK) {
+        COMM_LOGE(COMM_DFX, "listener lock fail");
+        return SOFTBUS_LOCK_ERR;
+    }
+    int32_t freeIdx = -1;
+    for (int32_t i = 0; i < MAX_NETWORK_STATISTICS_LISTENER_NUM; i++) {
+        if (g_networkStatisticsListener[i] == listener) {
+            (void)SoftBusMutexUnlock(&g_networkStatisticsListenerLock);
+            return SOFTBUS_OK;
+        }
+        if (g_networkStatisticsListener[i] == NULL && freeIdx < 0) {
+            freeIdx = i;
+        }
+    }
+    if (freeIdx < 0) {
+        COMM_LOGE(COMM_DFX, "network statistics listener is full");
+        (void)SoftBusMutexUnlock(&g_networkStatisticsListenerLock);
+        return SOFTBUS_TRANS_OBSERVER_EXCEED_LIMIT;
+    }
+    g_networkStatisticsListener[freeIdx] = listener;
+    (void)SoftBusMutexUnlock(&g_networkStatisticsListenerLock);
+    return SOFTBUS_OK;
+}
+
+void UnregisterNetworkStatisticsListener(NetworkStatisticsListener listener)
+{
+    if (SoftBusMutexLock(&g_networkStatisticsListenerLock) != SOFTBUS_OK) {
+        COMM_LOGE(COMM_DFX, "listener lock fail");
+        return;
+    }
+    for (int32_t i = 0; i < MAX_NETWORK_STATISTICS_LISTENER_NUM; i++) {
+        if (g_networkStatisticsListener[i] == listener) {
+            g_networkStatisticsListener[i] = NULL;
+        }
+    }
+    (void)SoftBusMutexUnlock(&g_networkStatisticsListenerLock);
+}
+
+static bool GetNetworkStatisticsListeners(NetworkStatisticsListener *listeners)
+{
+    /* the lock is not created until a listener registers */
+    if (SoftBusMutexLock(&g_networkStatisticsListenerLock) != SOFTBUS_OK) {
+        return false;
+    }
+    bool hasListener = false;
+    for (int32_t i = 0; i < MAX_NETWORK_STATISTICS_LISTENER_NUM; i++) {
+        listeners[i] = g_networkStatisticsListener[i];
+        hasListener = hasListener || (listeners[i] != NULL);
+    }
+    (void)SoftBusMutexUnlock(&g_networkStatisticsListenerLock);
+    return hasListener;
+}
+
 void AddChannelStatisticsInfo(int32_t channelId, int32_t channelType)
 {
     if (channelId < 0) {
@@ -215,6 +282,37 @@ static int32_t ChannelStatisticsInfoInit(ChannelStatisticsInfo *info, int32_t ch
     return SOFTBUS_OK;
 }
 
+static void NotifyChannelStatistics(uint64_t laneId, int32_t laneLinkType, const char *channelInfo, uint32_t len)
+{
+    NetworkStatisticsListener listeners[MAX_NETWORK_STATISTICS_LISTENER_NUM] = {0};
+    if (!GetNetworkStatisticsListeners(listeners)) {
+        return;
+    }
+    cJSON *json = cJSON_ParseWithLength(channelInfo, len);
+    if (json == NULL) {
+        COMM_LOGW(COMM_DFX, "parse channel statistics fail");
+        return;
+    }
+    int64_t traffic = 0;
+    int64_t startTime = 0;
+    int64_t endTime = 0;
+    if (!GetJsonObjectNumber64Item(json, "traffic", &traffic) ||
+        !GetJsonObjectNumber64Item(json, "startTime", &startTime) ||
+        !GetJsonObjectNumber64Item(json, "endTime", &endTime)) {
+        cJSON_Delete(json);
+        return;
+    }
+    cJSON_Delete(json);
+    if (endTime <= startTime || traffic <= 0) {
+        return;
+    }
+    for (int32_t i = 0; i < MAX_NETWORK_STATISTICS_LISTENER_NUM; i++) {
+        if (listeners[i] != NULL) {
+            listeners[i](laneId, laneLinkType, traffic, endTime - startTime);
+        }
+    }
+}
+
 void UpdateNetworkResourceByLaneId(int32_t channelId, int32_t channelType, uint64_t laneId,
     const void *dataInfo, uint32_t len)
 {
@@ -259,7 +357,9 @@ void UpdateNetworkResourceByLaneId(int32_t channelId, int32_t channelType, uint6
         }
         ListInit(&info->node);
         ListAdd(&temp->channels, &info->node);
+        int32_t laneLinkType = temp->resource.laneLinkType;
         (void)SoftBusMutexUnlock(&g_networkResourceList->lock);
+        NotifyChannelStatistics(laneId, laneLinkType, (const char *)dataInfo, len);
         return;
     }
     (void)SoftBusMutexUnlock(&g_networkResourceList->lock);
@@ -1465,6 +1465,7 @@ enum SoftBusErrNo {
     SOFTBUS_DISCOVER_BLE_CONVERT_BYTES_FAILED,
     SOFTBUS_DISCOVER_BLE_NEED_TRIGGER,
     SOFTBUS_DISCOVER_BLE_SET_SCAN_PARAM_FAIL,
+    SOFTBUS_DISCOVER_BLE_RECV_QUEUE_FULL,
     /* errno begin: -((203 << 21) | (1 << 16) | (4 << 12) | 0x0FFF) */
     SOFTBUS_DISCOVER_COAP_ERR_BASE = SOFTBUS_SUB_ERRNO(DISC_SUB_MODULE_CODE, DISC_COAP_SUB_MODULE_CODE),
     SOFTBUS_DISCOVER_COAP_NOT_INIT,
@@ -838,4 +838,10 @@ int32_t ServerIpcSetDisplayName(const char *pkgName, const char *nameData, uint3
     (void)nameData;
     (void)len;
     return SOFTBUS_FUNC_NOT_SUPPORT;
-}
\ No newline at end of file
+}
+
+int32_t ServerIpcRegNodeStateBatch(const char *pkgName)
+{
+    (void)pkgName;
+    return SOFTBUS_FUNC_NOT_SUPPORT;
+}
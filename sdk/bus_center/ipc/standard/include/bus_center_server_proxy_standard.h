@@ -71,6 +71,7 @@ public:
     int32_t UnregisterRangeCallbackForMsdp(const char *pkgName) override;
     int32_t SyncTrustedRelationShip(const char *pkgName, const char *msg, uint32_t msgLen) override;
     int32_t SetDisplayName(const char *pkgName, const char *nameData, uint32_t len) override;
+    int32_t RegNodeStateBatch(const char *pkgName) override;
     int32_t GetBusCenterExObj(sptr<IRemoteObject> &object) override;
     int32_t EvaluateQos(const char *peerNetworkId, TransDataType dataType, const QosTV *qos,
         uint32_t qosCount) override;
@@ -377,4 +377,20 @@ int32_t ServerIpcSetDisplayName(const char *pkgName, const char *nameData, uint3
         LNN_LOGE(LNN_EVENT, "set failed");
     }
     return ret;
-}
\ No newline at end of file
+}
+
+int32_t ServerIpcRegNodeStateBatch(const char *pkgName)
+{
+    if (g_serverProxy == nullptr) {
+        int32_t ret = BusCenterServerProxyInit();
+        if (ret != SOFTBUS_OK) {
+            LNN_LOGE(LNN_EVENT, "BusCenterServerProxyInit failed, ret=%{public}d", ret);
+            return SOFTBUS_SERVER_NOT_INIT;
+        }
+    }
+    int32_t ret = g_serverProxy->RegNodeStateBatch(pkgName);
+    if (ret != 0) {
+        LNN_LOGE(LNN_EVENT, "reg node state batch failed, ret=%{public}d", ret);
+    }
+    return ret;
+}
@@ -22,6 +22,7 @@
 #include "ble_range.h"
 #include "data_level.h"
 #include "data_level_inner.h"
+#include "node_state_batch_inner.h"
 #include "softbus_bus_center.h"
 
 #ifdef __cplusplus
@@ -44,6 +45,7 @@ int32_t RegDataLevelChangeCbInner(const char *pkgName, IDataLevelCb *callback);
 int32_t UnregDataLevelChangeCbInner(const char *pkgName);
 int32_t SetDataLevelInner(const DataLevel *dataLevel);
 void RestartRegDataLevelChange(void);
+void RestartRegNodeStateBatch(void);
 int32_t RegRangeCbForMsdpInner(const char *pkgName, IRangeCallback *callback);
 int32_t UnregRangeCbForMsdpInner(const char *pkgName);
 
@@ -68,6 +70,7 @@ int32_t LnnOnJoinResult(void *addr, const char *networkId, int32_t retCode);
 int32_t LnnOnLeaveResult(const char *networkId, int32_t retCode);
 int32_t LnnOnNodeOnlineStateChanged(const char *pkgName, bool isOnline, void *info);
 int32_t LnnOnNodeBasicInfoChanged(const char *pkgName, void *info, int32_t type);
+int32_t LnnOnNodeStateBatch(const char *pkgName, const NodeStateBatchItem *items, uint32_t num);
 int32_t LnnOnNodeStatusChanged(const char *pkgName, void *info, int32_t type);
 int32_t LnnOnLocalNetworkIdChanged(const char *pkgName);
 int32_t LnnOnNodeDeviceTrustedChange(const char *pkgName, int32_t type, const char *msg, uint32_t msgLen);
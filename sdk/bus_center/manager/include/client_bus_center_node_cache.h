@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CLIENT_BUS_CENTER_NODE_CACHE_H
+#define CLIENT_BUS_CENTER_NODE_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "softbus_bus_center.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int32_t NodeInfoCacheInit(void);
+void NodeInfoCacheDeinit(void);
+void InvalidateNodeInfoCache(void);
+void SetNodeInfoCacheBypass(bool isBypass);
+
+/*
+ * Lookups return SOFTBUS_NOT_FIND on a miss together with the cache version; the result of the following
+ * server query is only stored by the fill functions if no node state change arrived in the meantime.
+ */
+int32_t NodeInfoCacheGetAllOnline(NodeBasicInfo **info, int32_t *infoNum, uint32_t *version);
+void NodeInfoCacheFillAllOnline(uint32_t version, const NodeBasicInfo *info, int32_t infoNum);
+int32_t NodeInfoCacheGetKeyInfo(const char *networkId, NodeDeviceInfoKey key, uint8_t *info, int32_t infoLen,
+    uint32_t *version);
+void NodeInfoCacheFillKeyInfo(uint32_t version, const char *networkId, NodeDeviceInfoKey key,
+    const uint8_t *info, int32_t infoLen);
+
+void NodeInfoCacheOnlineStateChanged(bool isOnline, const NodeBasicInfo *info);
+void NodeInfoCacheBasicInfoChanged(const NodeBasicInfo *info);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // CLIENT_BUS_CENTER_NODE_CACHE_H
@@ -20,6 +20,7 @@
 
 #include "anonymizer.h"
 #include "bus_center_server_proxy.h"
+#include "client_bus_center_node_cache.h"
 #include "common_list.h"
 #include "lnn_log.h"
 #include "softbus_adapter_mem.h"
@@ -38,6 +39,7 @@ static SoftBusList *g_discoveryMsgList = NULL;
 static bool g_isInited = false;
 static SoftBusMutex g_isInitedLock;
 static char g_regDataLevelChangePkgName[PKG_NAME_SIZE_MAX] = {0};
+static char g_regNodeStateBatchPkgName[PKG_NAME_SIZE_MAX] = {0};
 
 typedef struct {
     ListNode node;
@@ -600,6 +602,7 @@ void BusCenterClientDeinit(void)
     g_busCenterClient.rangeCb.onRangeResult = NULL;
     g_busCenterClient.rangeCb.onRangeStateChange = NULL;
     SoftBusMutexDestroy(&g_busCenterClient.lock);
+    NodeInfoCacheDeinit();
     BusCenterServerProxyDeInit();
 }
 
@@ -620,6 +623,9 @@ int32_t BusCenterClientInit(void)
         LNN_LOGE(LNN_INIT, "DiscoveryMsgListInit fail");
         return SOFTBUS_MALLOC_ERR;
     }
+    if (NodeInfoCacheInit() != SOFTBUS_OK) {
+        LNN_LOGW(LNN_INIT, "node info cache init fail, always query server");
+    }
 
     ListInit(&g_busCenterClient.joinLNNCbList);
     ListInit(&g_busCenterClient.leaveLNNCbList);
@@ -637,11 +643,19 @@ int32_t BusCenterClientInit(void)
 
 int32_t GetAllNodeDeviceInfoInner(const char *pkgName, NodeBasicInfo **info, int32_t *infoNum)
 {
+    uint32_t version = 0;
+    if (NodeInfoCacheGetAllOnline(info, infoNum, &version) == SOFTBUS_OK) {
+        return SOFTBUS_OK;
+    }
     int32_t ret = ServerIpcGetAllOnlineNodeInfo(pkgName, (void **)info, sizeof(NodeBasicInfo), infoNum);
     if (ret != SOFTBUS_OK) {
         LNN_LOGE(LNN_STATE, "Server GetAllOnlineNodeInfo failed, ret=%{public}d", ret);
+        return ret;
     }
-    return ret;
+    if (info != NULL && infoNum != NULL) {
+        NodeInfoCacheFillAllOnline(version, *info, *infoNum);
+    }
+    return SOFTBUS_OK;
 }
 
 int32_t GetLocalNodeDeviceInfoInner(const char *pkgName, NodeBasicInfo *info)
@@ -656,11 +670,17 @@ int32_t GetLocalNodeDeviceInfoInner(const char *pkgName, NodeBasicInfo *info)
 int32_t GetNodeKeyInfoInner(const char *pkgName, const char *networkId, NodeDeviceInfoKey key,
     uint8_t *info, int32_t infoLen)
 {
+    uint32_t version = 0;
+    if (NodeInfoCacheGetKeyInfo(networkId, key, info, infoLen, &version) == SOFTBUS_OK) {
+        return SOFTBUS_OK;
+    }
     int32_t ret = ServerIpcGetNodeKeyInfo(pkgName, networkId, key, info, infoLen);
     if (ret != SOFTBUS_OK) {
         LNN_LOGE(LNN_STATE, "Server GetNodeKeyInfo failed, ret=%{public}d", ret);
+        return ret;
     }
-    return ret;
+    NodeInfoCacheFillKeyInfo(version, networkId, key, info, infoLen);
+    return SOFTBUS_OK;
 }
 
 int32_t SetNodeDataChangeFlagInner(const char *pkgName, const char *networkId, uint16_t dataChangeFlag)
@@ -843,6 +863,32 @@ static bool IsSameNodeStateCb(const INodeStateCb *callback1, const INodeStateCb
     return true;
 }
 
+static void RegNodeStateBatch(const char *pkgName)
+{
+    if (g_regNodeStateBatchPkgName[0] != '\0') {
+        return;
+    }
+    if (strcpy_s(g_regNodeStateBatchPkgName, PKG_NAME_SIZE_MAX, pkgName) != EOK) {
+        LNN_LOGE(LNN_STATE, "copy pkgName fail");
+        return;
+    }
+    int32_t ret = ServerIpcRegNodeStateBatch(pkgName);
+    if (ret != SOFTBUS_OK) {
+        LNN_LOGW(LNN_STATE, "node state batch not enabled, ret=%{public}d", ret);
+    }
+}
+
+void RestartRegNodeStateBatch(void)
+{
+    if (g_regNodeStateBatchPkgName[0] == '\0') {
+        return;
+    }
+    int32_t ret = ServerIpcRegNodeStateBatch(g_regNodeStateBatchPkgName);
+    if (ret != SOFTBUS_OK) {
+        LNN_LOGW(LNN_STATE, "node state batch not enabled, ret=%{public}d", ret);
+    }
+}
+
 int32_t RegNodeDeviceStateCbInner(const char *pkgName, INodeStateCb *callback)
 {
     if (callback == NULL) {
@@ -890,6 +936,9 @@ int32_t RegNodeDeviceStateCbInner(const char *pkgName, INodeStateCb *callback)
     if (SoftBusMutexUnlock(&g_busCenterClient.lock) != SOFTBUS_OK) {
         LNN_LOGE(LNN_STATE, "unlock node state cb list");
     }
+    if (rc == SOFTBUS_OK) {
+        RegNodeStateBatch(pkgName);
+    }
     return rc;
 }
 
@@ -1166,6 +1215,7 @@ int32_t LnnOnNodeOnlineStateChanged(const char *pkgName, bool isOnline, void *in
         LNN_LOGE(LNN_STATE, "buscenter client not init");
         return SOFTBUS_NETWORK_CLIENT_NOT_INIT;
     }
+    NodeInfoCacheOnlineStateChanged(isOnline, basicInfo);
 
     if (SoftBusMutexLock(&g_busCenterClient.lock) != SOFTBUS_OK) {
         LNN_LOGE(LNN_STATE, "lock node state cb list in notify");
@@ -1212,6 +1262,7 @@ int32_t LnnOnNodeBasicInfoChanged(const char *pkgName, void *info, int32_t type)
         LNN_LOGE(LNN_STATE, "OnNodeBasicInfoChanged invalid type. type=%{public}d", type);
         return SOFTBUS_INVALID_PARAM;
     }
+    NodeInfoCacheBasicInfoChanged(basicInfo);
 
     if (SoftBusMutexLock(&g_busCenterClient.lock) != SOFTBUS_OK) {
         LNN_LOGE(LNN_STATE, "lock node basic info cb list in notify");
@@ -1232,6 +1283,72 @@ int32_t LnnOnNodeBasicInfoChanged(const char *pkgName, void *info, int32_t type)
     return SOFTBUS_OK;
 }
 
+static void DispatchNodeStateItem(const NodeStateCallbackItem *item, const NodeStateBatchItem *stateItem)
+{
+    NodeBasicInfo basicInfo = stateItem->info;
+    switch (stateItem->event) {
+        case NODE_STATE_BATCH_ONLINE:
+            if ((item->cb.events & EVENT_NODE_STATE_ONLINE) != 0) {
+                item->cb.onNodeOnline(&basicInfo);
+            }
+            break;
+        case NODE_STATE_BATCH_OFFLINE:
+            if ((item->cb.events & EVENT_NODE_STATE_OFFLINE) != 0) {
+                item->cb.onNodeOffline(&basicInfo);
+            }
+            break;
+        case NODE_STATE_BATCH_BASIC_INFO_CHANGED:
+            if ((item->cb.events & EVENT_NODE_STATE_INFO_CHANGED) != 0 && stateItem->type >= 0 &&
+                stateItem->type <= TYPE_NETWORK_INFO) {
+                item->cb.onNodeBasicInfoChanged((NodeBasicInfoType)stateItem->type, &basicInfo);
+            }
+            break;
+        default:
+            LNN_LOGW(LNN_STATE, "unknown node state event=%{public}d", stateItem->event);
+            break;
+    }
+}
+
+int32_t LnnOnNodeStateBatch(const char *pkgName, const NodeStateBatchItem *items, uint32_t num)
+{
+    NodeStateCallbackItem *item = NULL;
+    ListNode dupList;
+
+    if (pkgName == NULL || items == NULL || num == 0 || num > NODE_STATE_BATCH_MAX_NUM) {
+        LNN_LOGE(LNN_STATE, "invalid node state batch param");
+        return SOFTBUS_INVALID_PARAM;
+    }
+    if (!g_busCenterClient.isInit) {
+        LNN_LOGE(LNN_STATE, "buscenter client not init");
+        return SOFTBUS_NETWORK_CLIENT_NOT_INIT;
+    }
+    for (uint32_t i = 0; i < num; i++) {
+        if (items[i].event == NODE_STATE_BATCH_BASIC_INFO_CHANGED) {
+            NodeInfoCacheBasicInfoChanged(&items[i].info);
+        } else {
+            NodeInfoCacheOnlineStateChanged(items[i].event == NODE_STATE_BATCH_ONLINE, &items[i].info);
+        }
+    }
+    if (SoftBusMutexLock(&g_busCenterClient.lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_STATE, "lock node state cb list in batch notify");
+        return SOFTBUS_LOCK_ERR;
+    }
+    ListInit(&dupList);
+    DuplicateNodeStateCbList(&dupList);
+    if (SoftBusMutexUnlock(&g_busCenterClient.lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_STATE, "unlock node state cb list in batch notify");
+    }
+    for (uint32_t i = 0; i < num; i++) {
+        LIST_FOR_EACH_ENTRY(item, &dupList, NodeStateCallbackItem, node) {
+            if ((strcmp(item->pkgName, pkgName) == 0) || (strlen(pkgName) == 0)) {
+                DispatchNodeStateItem(item, &items[i]);
+            }
+        }
+    }
+    ClearNodeStateCbList(&dupList);
+    return SOFTBUS_OK;
+}
+
 int32_t LnnOnNodeStatusChanged(const char *pkgName, void *info, int32_t type)
 {
     if (pkgName == NULL || info == NULL) {
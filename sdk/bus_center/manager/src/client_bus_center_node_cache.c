@@ -0,0 +1,406 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "client_bus_center_node_cache.h"
+
+#include <securec.h>
+#include <string.h>
+
+#include "lnn_log.h"
+#include "softbus_adapter_mem.h"
+#include "softbus_adapter_thread.h"
+#include "softbus_def.h"
+#include "softbus_error_code.h"
+#include "softbus_feature_config.h"
+
+#define NODE_KEY_CACHE_MAX_NUM 64
+#define NODE_KEY_CACHE_DATA_LEN DEVICE_NAME_BUF_LEN
+
+typedef struct {
+    char networkId[NETWORK_ID_BUF_LEN];
+    int32_t key;
+    uint32_t len;
+    uint8_t data[NODE_KEY_CACHE_DATA_LEN];
+} NodeKeyCacheItem;
+
+typedef struct {
+    NodeBasicInfo *nodes;
+    int32_t nodeNum;
+    int32_t nodeCap;
+    bool isValid;
+    bool isBypass;
+    bool isInit;
+    uint32_t version;
+    NodeKeyCacheItem keys[NODE_KEY_CACHE_MAX_NUM];
+    uint32_t keyNum;
+    uint32_t keyEvictIdx;
+    SoftBusMutex lock;
+} NodeInfoCache;
+
+static NodeInfoCache g_nodeInfoCache = {
+    .nodes = NULL,
+    .nodeNum = 0,
+    .nodeCap = 0,
+    .isValid = false,
+    .isBypass = false,
+    .isInit = false,
+    .version = 0,
+    .keyNum = 0,
+    .keyEvictIdx = 0,
+};
+
+/* only keys that stay the same while a node is online, or change together with its basic info */
+static bool IsCacheableKey(NodeDeviceInfoKey key)
+{
+    return key == NODE_KEY_UDID || key == NODE_KEY_UUID || key == NODE_KEY_DEV_NAME;
+}
+
+static void ClearNodeInfoCache(void)
+{
+    SoftBusFree(g_nodeInfoCache.nodes);
+    g_nodeInfoCache.nodes = NULL;
+    g_nodeInfoCache.nodeNum = 0;
+    g_nodeInfoCache.nodeCap = 0;
+    g_nodeInfoCache.isValid = false;
+    g_nodeInfoCache.keyNum = 0;
+    g_nodeInfoCache.keyEvictIdx = 0;
+    g_nodeInfoCache.version++;
+}
+
+static int32_t FindCachedNode(const char *networkId)
+{
+    for (int32_t i = 0; i < g_nodeInfoCache.nodeNum; i++) {
+        if (strcmp(g_nodeInfoCache.nodes[i].networkId, networkId) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void RemoveCachedKeys(const char *networkId)
+{
+    uint32_t i = 0;
+    while (i < g_nodeInfoCache.keyNum) {
+        if (strcmp(g_nodeInfoCache.keys[i].networkId, networkId) != 0) {
+            i++;
+            continue;
+        }
+        g_nodeInfoCache.keyNum--;
+        if (i != g_nodeInfoCache.keyNum) {
+            g_nodeInfoCache.keys[i] = g_nodeInfoCache.keys[g_nodeInfoCache.keyNum];
+        }
+    }
+}
+
+static int32_t ReserveCachedNodes(int32_t num)
+{
+    if (num <= g_nodeInfoCache.nodeCap) {
+        return SOFTBUS_OK;
+    }
+    int32_t cap = (g_nodeInfoCache.nodeCap == 0) ? num : g_nodeInfoCache.nodeCap;
+    while (cap < num) {
+        cap *= 2; // grow by doubling
+    }
+    NodeBasicInfo *nodes = (NodeBasicInfo *)SoftBusCalloc(sizeof(NodeBasicInfo) * cap);
+    if (nodes == NULL) {
+        LNN_LOGE(LNN_STATE, "malloc node info cache fail");
+        return SOFTBUS_MALLOC_ERR;
+    }
+    if (g_nodeInfoCache.nodeNum > 0 && memcpy_s(nodes, sizeof(NodeBasicInfo) * cap, g_nodeInfoCache.nodes,
+        sizeof(NodeBasicInfo) * g_nodeInfoCache.nodeNum) != EOK) {
+        LNN_LOGE(LNN_STATE, "copy node info cache fail");
+        SoftBusFree(nodes);
+        return SOFTBUS_MEM_ERR;
+    }
+    SoftBusFree(g_nodeInfoCache.nodes);
+    g_nodeInfoCache.nodes = nodes;
+    g_nodeInfoCache.nodeCap = cap;
+    return SOFTBUS_OK;
+}
+
+int32_t NodeInfoCacheInit(void)
+{
+    if (g_nodeInfoCache.isInit) {
+        return SOFTBUS_OK;
+    }
+    bool isEnable = true;
+    if (SoftbusGetConfig(SOFTBUS_BOOL_SDK_NODE_INFO_CACHE, (unsigned char *)&isEnable, sizeof(isEnable)) !=
+        SOFTBUS_OK) {
+        LNN_LOGW(LNN_INIT, "get node info cache config fail, enable it by default");
+        isEnable = true;
+    }
+    if (SoftBusMutexInit(&g_nodeInfoCache.lock, NULL) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_INIT, "node info cache lock init fail");
+        return SOFTBUS_LOCK_ERR;
+    }
+    g_nodeInfoCache.isBypass = !isEnable;
+    g_nodeInfoCache.isInit = true;
+    LNN_LOGI(LNN_INIT, "node info cache init, isBypass=%{public}d", g_nodeInfoCache.isBypass);
+    return SOFTBUS_OK;
+}
+
+void NodeInfoCacheDeinit(void)
+{
+    if (!g_nodeInfoCache.isInit) {
+        return;
+    }
+    if (SoftBusMutexLock(&g_nodeInfoCache.lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_INIT, "lock node info cache fail");
+        return;
+    }
+    ClearNodeInfoCache();
+    g_nodeInfoCache.isInit = false;
+    (void)SoftBusMutexUnlock(&g_nodeInfoCache.lock);
+    SoftBusMutexDestroy(&g_nodeInfoCache.lock);
+}
+
+void InvalidateNodeInfoCache(void)
+{
+    if (!g_nodeInfoCache.isInit) {
+        return;
+    }
+    if (SoftBusMutexLock(&g_nodeInfoCache.lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_STATE, "lock node info cache fail");
+        return;
+    }
+    ClearNodeInfoCache();
+    (void)SoftBusMutexUnlock(&g_nodeInfoCache.lock);
+}
+
+void SetNodeInfoCacheBypass(bool isBypass)
+{
+    if (!g_nodeInfoCache.isInit) {
+        return;
+    }
+    if (SoftBusMutexLock(&g_nodeInfoCache.lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_STATE, "lock node info cache fail");
+        return;
+    }
+    if (isBypass) {
+        ClearNodeInfoCache();
+    }
+    g_nodeInfoCache.isBypass = isBypass;
+    (void)SoftBusMutexUnlock(&g_nodeInfoCache.lock);
+    LNN_LOGI(LNN_STATE, "set node info cache bypass=%{public}d", isBypass);
+}
+
+static int32_t CopyCachedOnlineNodes(NodeBasicInfo **info, int32_t *infoNum)
+{
+    *info = NULL;
+    *infoNum = 0;
+    if (g_nodeInfoCache.nodeNum == 0) {
+        return SOFTBUS_OK;
+    }
+    uint32_t infoSize = sizeof(NodeBasicInfo) * (uint32_t)g_nodeInfoCache.nodeNum;
+    NodeBasicInfo *nodes = (NodeBasicInfo *)SoftBusMalloc(infoSize);
+    if (nodes == NULL) {
+        LNN_LOGE(LNN_STATE, "malloc online node info fail");
+        return SOFTBUS_MALLOC_ERR;
+    }
+    if (memcpy_s(nodes, infoSize, g_nodeInfoCache.nodes, infoSize) != EOK) {
+        LNN_LOGE(LNN_STATE, "copy online node info fail");
+        SoftBusFree(nodes);
+        return SOFTBUS_MEM_ERR;
+    }
+    *info = nodes;
+    *infoNum = g_nodeInfoCache.nodeNum;
+    return SOFTBUS_OK;
+}
+
+int32_t NodeInfoCacheGetAllOnline(NodeBasicInfo **info, int32_t *infoNum, uint32_t *version)
+{
+    if (info == NULL || infoNum == NULL || version == NULL) {
+        return SOFTBUS_INVALID_PARAM;
+    }
+    if (!g_nodeInfoCache.isInit) {
+        return SOFTBUS_NO_INIT;
+    }
+    if (SoftBusMutexLock(&g_nodeInfoCache.lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_STATE, "lock node info cache fail");
+        return SOFTBUS_LOCK_ERR;
+    }
+    *version = g_nodeInfoCache.version;
+    if (g_nodeInfoCache.isBypass || !g_nodeInfoCache.isValid) {
+        (void)SoftBusMutexUnlock(&g_nodeInfoCache.lock);
+        return SOFTBUS_NOT_FIND;
+    }
+    int32_t ret = CopyCachedOnlineNodes(info, infoNum);
+    (void)SoftBusMutexUnlock(&g_nodeInfoCache.lock);
+    return ret;
+}
+
+void NodeInfoCacheFillAllOnline(uint32_t version, const NodeBasicInfo *info, int32_t infoNum)
+{
+    if (infoNum < 0 || (infoNum > 0 && info == NULL) || !g_nodeInfoCache.isInit) {
+        return;
+    }
+    if (SoftBusMutexLock(&g_nodeInfoCache.lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_STATE, "lock node info cache fail");
+        return;
+    }
+    if (g_nodeInfoCache.isBypass || g_nodeInfoCache.version != version) {
+        (void)SoftBusMutexUnlock(&g_nodeInfoCache.lock);
+        return;
+    }
+    if (ReserveCachedNodes(infoNum) != SOFTBUS_OK) {
+        (void)SoftBusMutexUnlock(&g_nodeInfoCache.lock);
+        return;
+    }
+    if (infoNum > 0 && memcpy_s(g_nodeInfoCache.nodes, sizeof(NodeBasicInfo) * g_nodeInfoCache.nodeCap, info,
+        sizeof(NodeBasicInfo) * infoNum) != EOK) {
+        LNN_LOGE(LNN_STATE, "fill node info cache fail");
+        (void)SoftBusMutexUnlock(&g_nodeInfoCache.lock);
+        return;
+    }
+    g_nodeInfoCache.nodeNum = infoNum;
+    g_nodeInfoCache.keyNum = 0;
+    g_nodeInfoCache.isValid = true;
+    (void)SoftBusMutexUnlock(&g_nodeInfoCache.lock);
+}
+
+static NodeKeyCacheItem *FindCachedKey(const char *networkId, NodeDeviceInfoKey key)
+{
+    for (uint32_t i = 0; i < g_nodeInfoCache.keyNum; i++) {
+        if (g_nodeInfoCache.keys[i].key == (int32_t)key &&
+            strcmp(g_nodeInfoCache.keys[i].networkId, networkId) == 0) {
+            return &g_nodeInfoCache.keys[i];
+        }
+    }
+    return NULL;
+}
+
+int32_t NodeInfoCacheGetKeyInfo(const char *networkId, NodeDeviceInfoKey key, uint8_t *info, int32_t infoLen,
+    uint32_t *version)
+{
+    if (networkId == NULL || info == NULL || infoLen <= 0 || version == NULL) {
+        return SOFTBUS_INVALID_PARAM;
+    }
+    if (!g_nodeInfoCache.isInit) {
+        return SOFTBUS_NO_INIT;
+    }
+    if (SoftBusMutexLock(&g_nodeInfoCache.lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_STATE, "lock node info cache fail");
+        return SOFTBUS_LOCK_ERR;
+    }
+    *version = g_nodeInfoCache.version;
+    NodeKeyCacheItem *item = NULL;
+    if (!g_nodeInfoCache.isBypass && g_nodeInfoCache.isValid && IsCacheableKey(key)) {
+        item = FindCachedKey(networkId, key);
+    }
+    if (item == NULL || item->len > (uint32_t)infoLen ||
+        memcpy_s(info, infoLen, item->data, item->len) != EOK) {
+        (void)SoftBusMutexUnlock(&g_nodeInfoCache.lock);
+        return SOFTBUS_NOT_FIND;
+    }
+    (void)SoftBusMutexUnlock(&g_nodeInfoCache.lock);
+    return SOFTBUS_OK;
+}
+
+void NodeInfoCacheFillKeyInfo(uint32_t version, const char *networkId, NodeDeviceInfoKey key,
+    const uint8_t *info, int32_t infoLen)
+{
+    if (networkId == NULL || info == NULL || infoLen <= 0 || !IsCacheableKey(key) || !g_nodeInfoCache.isInit) {
+        return;
+    }
+    /* cacheable keys are strings, keep the terminator so a hit returns exactly what the server wrote */
+    uint32_t len = strnlen((const char *)info, infoLen) + 1;
+    if (len > (uint32_t)infoLen || len > NODE_KEY_CACHE_DATA_LEN) {
+        return;
+    }
+    NodeKeyCacheItem keyItem = {
+        .key = (int32_t)key,
+        .len = len,
+    };
+    if (strcpy_s(keyItem.networkId, sizeof(keyItem.networkId), networkId) != EOK ||
+        memcpy_s(keyItem.data, sizeof(keyItem.data), info, len) != EOK) {
+        LNN_LOGE(LNN_STATE, "copy node key info fail");
+        return;
+    }
+    if (SoftBusMutexLock(&g_nodeInfoCache.lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_STATE, "lock node info cache fail");
+        return;
+    }
+    /* keys are only cached for nodes known online, so that their offline event drops them again */
+    if (g_nodeInfoCache.isBypass || !g_nodeInfoCache.isValid || g_nodeInfoCache.version != version ||
+        FindCachedNode(networkId) < 0 || FindCachedKey(networkId, key) != NULL) {
+        (void)SoftBusMutexUnlock(&g_nodeInfoCache.lock);
+        return;
+    }
+    if (g_nodeInfoCache.keyNum < NODE_KEY_CACHE_MAX_NUM) {
+        g_nodeInfoCache.keys[g_nodeInfoCache.keyNum++] = keyItem;
+    } else {
+        g_nodeInfoCache.keys[g_nodeInfoCache.keyEvictIdx] = keyItem;
+        g_nodeInfoCache.keyEvictIdx = (g_nodeInfoCache.keyEvictIdx + 1) % NODE_KEY_CACHE_MAX_NUM;
+    }
+    (void)SoftBusMutexUnlock(&g_nodeInfoCache.lock);
+}
+
+static void UpdateCachedNode(bool isOnline, const NodeBasicInfo *info)
+{
+    int32_t idx = FindCachedNode(info->networkId);
+    RemoveCachedKeys(info->networkId);
+    if (!isOnline) {
+        if (idx >= 0) {
+            g_nodeInfoCache.nodeNum--;
+            g_nodeInfoCache.nodes[idx] = g_nodeInfoCache.nodes[g_nodeInfoCache.nodeNum];
+        }
+        return;
+    }
+    if (idx >= 0) {
+        g_nodeInfoCache.nodes[idx] = *info;
+        return;
+    }
+    if (ReserveCachedNodes(g_nodeInfoCache.nodeNum + 1) != SOFTBUS_OK) {
+        ClearNodeInfoCache();
+        return;
+    }
+    g_nodeInfoCache.nodes[g_nodeInfoCache.nodeNum++] = *info;
+}
+
+void NodeInfoCacheOnlineStateChanged(bool isOnline, const NodeBasicInfo *info)
+{
+    if (info == NULL || !g_nodeInfoCache.isInit) {
+        return;
+    }
+    if (SoftBusMutexLock(&g_nodeInfoCache.lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_STATE, "lock node info cache fail");
+        return;
+    }
+    g_nodeInfoCache.version++;
+    if (g_nodeInfoCache.isValid) {
+        UpdateCachedNode(isOnline, info);
+    }
+    (void)SoftBusMutexUnlock(&g_nodeInfoCache.lock);
+}
+
+void NodeInfoCacheBasicInfoChanged(const NodeBasicInfo *info)
+{
+    if (info == NULL || !g_nodeInfoCache.isInit) {
+        return;
+    }
+    if (SoftBusMutexLock(&g_nodeInfoCache.lock) != SOFTBUS_OK) {
+        LNN_LOGE(LNN_STATE, "lock node info cache fail");
+        return;
+    }
+    g_nodeInfoCache.version++;
+    if (g_nodeInfoCache.isValid) {
+        RemoveCachedKeys(info->networkId);
+        int32_t idx = FindCachedNode(info->networkId);
+        if (idx >= 0) {
+            g_nodeInfoCache.nodes[idx] = *info;
+        }
+    }
+    (void)SoftBusMutexUnlock(&g_nodeInfoCache.lock);
+}
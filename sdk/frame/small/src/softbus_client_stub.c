@@ -16,6 +16,7 @@
 #include "bus_center_client_stub.h"
 #include "bus_center_server_proxy.h"
 #include "client_bus_center_manager.h"
+#include "client_bus_center_node_cache.h"
 #include "client_trans_session_manager.h"
 #include "comm_log.h"
 #include "iproxy_client.h"
@@ -128,6 +129,7 @@ static void *DeathProcTask(void *arg)
     ServerProxyDeInit();
     TransServerProxyClear();
     BusCenterServerProxyDeInit();
+    InvalidateNodeInfoCache();
 
     ListNode sessionServerInfoList;
     ListInit(&sessionServerInfoList);
@@ -155,6 +157,7 @@ static void *DeathProcTask(void *arg)
 
     TransServerProxyInit();
     BusCenterServerProxyInit();
+    InvalidateNodeInfoCache();
     DiscRecoveryPublish();
     DiscRecoverySubscribe();
 
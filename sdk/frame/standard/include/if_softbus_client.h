@@ -18,6 +18,7 @@
 
 #include "data_level_inner.h"
 #include "iremote_proxy.h"
+#include "node_state_batch_inner.h"
 #include "session.h"
 #include "socket.h"
 #include "softbus_def.h"
@@ -55,6 +56,8 @@ public:
 
     virtual int32_t OnNodeBasicInfoChanged(const char *pkgName, void *info, uint32_t infoTypeLen, int32_t type);
 
+    virtual int32_t OnNodeStateBatch(const char *pkgName, const NodeStateBatchItem *items, uint32_t num);
+
     virtual int32_t OnNodeStatusChanged(const char *pkgName, void *info, uint32_t infoTypeLen, int32_t type);
 
     virtual int32_t OnLocalNetworkIdChanged(const char *pkgName);
@@ -47,6 +47,7 @@ public:
     int32_t OnLeaveLNNResult(const char *networkId, int retCode) override;
     int32_t OnNodeOnlineStateChanged(const char *pkgName, bool isOnline, void *info, uint32_t infoTypeLen) override;
     int32_t OnNodeBasicInfoChanged(const char *pkgName, void *info, uint32_t infoTypeLen, int32_t type) override;
+    int32_t OnNodeStateBatch(const char *pkgName, const NodeStateBatchItem *items, uint32_t num) override;
     int32_t OnNodeStatusChanged(const char *pkgName, void *info, uint32_t infoTypeLen, int32_t type) override;
     int32_t OnLocalNetworkIdChanged(const char *pkgName) override;
     int32_t OnNodeDeviceTrustedChange(const char *pkgName, int32_t type, const char *msg, uint32_t msgLen) override;
@@ -77,6 +78,7 @@ private:
     int32_t OnLeaveLNNResultInner(MessageParcel &data, MessageParcel &reply);
     int32_t OnNodeOnlineStateChangedInner(MessageParcel &data, MessageParcel &reply);
     int32_t OnNodeBasicInfoChangedInner(MessageParcel &data, MessageParcel &reply);
+    int32_t OnNodeStateBatchInner(MessageParcel &data, MessageParcel &reply);
     int32_t OnNodeStatusChangedInner(MessageParcel &data, MessageParcel &reply);
     int32_t OnLocalNetworkIdChangedInner(MessageParcel &data, MessageParcel &reply);
     int32_t OnNodeDeviceTrustedChangeInner(MessageParcel &data, MessageParcel &reply);
@@ -99,6 +99,15 @@ int32_t ISoftBusClient::OnNodeBasicInfoChanged(const char *pkgName, void *info,
     return SOFTBUS_OK;
 }
 
+int32_t ISoftBusClient::OnNodeStateBatch(const char *pkgName, const NodeStateBatchItem *items, uint32_t num)
+{
+    (void)pkgName;
+    (void)items;
+    (void)num;
+    COMM_LOGI(COMM_EVENT, "ipc default impl");
+    return SOFTBUS_FUNC_NOT_SUPPORT;
+}
+
 int32_t ISoftBusClient::OnNodeStatusChanged(const char *pkgName, void *info, uint32_t infoTypeLen, int32_t type)
 {
     (void)pkgName;
@@ -40,6 +40,7 @@ SoftBusClientStub::SoftBusClientStub()
     memberFuncMap_[CLIENT_ON_LEAVE_RESULT] = &SoftBusClientStub::OnLeaveLNNResultInner;
     memberFuncMap_[CLIENT_ON_NODE_ONLINE_STATE_CHANGED] = &SoftBusClientStub::OnNodeOnlineStateChangedInner;
     memberFuncMap_[CLIENT_ON_NODE_BASIC_INFO_CHANGED] = &SoftBusClientStub::OnNodeBasicInfoChangedInner;
+    memberFuncMap_[CLIENT_ON_NODE_STATE_BATCH] = &SoftBusClientStub::OnNodeStateBatchInner;
     memberFuncMap_[CLIENT_ON_NODE_STATUS_CHANGED] = &SoftBusClientStub::OnNodeStatusChangedInner;
     memberFuncMap_[CLIENT_ON_LOCAL_NETWORK_ID_CHANGED] = &SoftBusClientStub::OnLocalNetworkIdChangedInner;
     memberFuncMap_[CLIENT_ON_NODE_DEVICE_TRUST_CHANGED] = &SoftBusClientStub::OnNodeDeviceTrustedChangeInner;
@@ -519,6 +520,32 @@ int32_t SoftBusClientStub::OnNodeBasicInfoChangedInner(MessageParcel &data, Mess
     return SOFTBUS_OK;
 }
 
+int32_t SoftBusClientStub::OnNodeStateBatchInner(MessageParcel &data, MessageParcel &reply)
+{
+    const char *pkgName = data.ReadCString();
+    if (pkgName == nullptr || strlen(pkgName) == 0) {
+        COMM_LOGE(COMM_SDK, "Invalid package name, or length is zero");
+        return SOFTBUS_TRANS_PROXY_READCSTRING_FAILED;
+    }
+    uint32_t num;
+    if (!data.ReadUint32(num) || num == 0 || num > NODE_STATE_BATCH_MAX_NUM) {
+        COMM_LOGE(COMM_SDK, "OnNodeStateBatchInner read num failed! num=%{public}u", num);
+        return SOFTBUS_TRANS_PROXY_READUINT_FAILED;
+    }
+    const NodeStateBatchItem *items =
+        (const NodeStateBatchItem *)data.ReadRawData(sizeof(NodeStateBatchItem) * num);
+    if (items == nullptr) {
+        COMM_LOGE(COMM_SDK, "OnNodeStateBatchInner read items failed!");
+        return SOFTBUS_TRANS_PROXY_READRAWDATA_FAILED;
+    }
+    int32_t retReply = OnNodeStateBatch(pkgName, items, num);
+    if (!reply.WriteInt32(retReply)) {
+        COMM_LOGE(COMM_SDK, "OnNodeStateBatchInner write reply failed!");
+        return SOFTBUS_TRANS_PROXY_WRITEINT_FAILED;
+    }
+    return SOFTBUS_OK;
+}
+
 int32_t SoftBusClientStub::OnNodeStatusChangedInner(MessageParcel &data, MessageParcel &reply)
 {
     const char *pkgName = data.ReadCString();
@@ -854,6 +881,11 @@ int32_t SoftBusClientStub::OnNodeBasicInfoChanged(const char *pkgName, void *inf
     return LnnOnNodeBasicInfoChanged(pkgName, info, type);
 }
 
+int32_t SoftBusClientStub::OnNodeStateBatch(const char *pkgName, const NodeStateBatchItem *items, uint32_t num)
+{
+    return LnnOnNodeStateBatch(pkgName, items, num);
+}
+
 int32_t SoftBusClientStub::OnNodeStatusChanged(const char *pkgName, void *info, uint32_t infoTypeLen, int32_t type)
 {
     (void)infoTypeLen;
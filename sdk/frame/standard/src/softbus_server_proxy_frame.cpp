@@ -17,6 +17,7 @@
 
 #include <thread>
 #include "client_bus_center_manager.h"
+#include "client_bus_center_node_cache.h"
 #include "client_trans_socket_manager.h"
 #include "bus_center_server_proxy.h"
 #include "ipc_skeleton.h"
@@ -165,6 +166,7 @@ void ClientDeathProcTask(void)
     }
     TransServerProxyClear();
     BusCenterServerProxyDeInit();
+    InvalidateNodeInfoCache();
 
     ListNode sessionServerInfoList;
     ListInit(&sessionServerInfoList);
@@ -184,11 +186,14 @@ void ClientDeathProcTask(void)
     TransServerProxyInit();
     BusCenterServerProxyInit();
     InnerRegisterService(&sessionServerInfoList);
+    // node changes before the registration above never reached us, drop what was filled meanwhile
+    InvalidateNodeInfoCache();
     RestartAuthParaNotify();
     DiscRecoveryPublish();
     DiscRecoverySubscribe();
     DiscRecoveryPolicy();
     RestartRegDataLevelChange();
+    RestartRegNodeStateBatch();
 }
 
 void RestartAuthParaCallbackUnregister(void)
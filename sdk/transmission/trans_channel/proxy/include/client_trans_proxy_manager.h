@@ -26,7 +26,6 @@ extern "C" {
 typedef struct {
     int32_t isEncrypted;
     int32_t sequence;
-    char sessionKey[SESSION_KEY_LENGTH];
     int32_t linkType;
     int32_t osType;
 }ProxyChannelInfoDetail;
@@ -26,11 +26,13 @@
 #include "softbus_adapter_crypto.h"
 #include "softbus_adapter_mem.h"
 #include "softbus_adapter_socket.h"
+#include "softbus_adapter_timer.h"
 #include "softbus_def.h"
 #include "softbus_error_code.h"
 #include "softbus_feature_config.h"
 #include "softbus_utils.h"
 #include "trans_assemble_tlv.h"
+#include "trans_cipher_handle.h"
 #include "trans_log.h"
 #include "trans_pending_pkt.h"
 #include "trans_server_proxy.h"
@@ -39,11 +41,15 @@
 #define PROXY_ACK_SIZE 4
 #define OH_TYPE 10
 #define TLV_TYPE_AND_LENTH 2
+#define SLICE_PACKET_TIMEOUT_MS (10 * 1000)
 
 static IClientSessionCallBack g_sessionCb;
 
 static SoftBusList *g_proxyChannelInfoList = NULL;
-static SoftBusList *g_channelSliceProcessorList = NULL;
+// reassemblies in progress by channelId and priority, each with its own expiry deadline
+static TransSliceTable g_proxySliceTable;
+// session ciphers by channelId, looked up by the data path without g_proxyChannelInfoList->lock
+static TransCipherTable g_proxyCipherTable;
 
 static void ClientTransProxySliceTimerProc(void);
 
@@ -53,15 +59,22 @@ static int32_t ClientTransProxyListInit()
     if (g_proxyChannelInfoList == NULL) {
         return SOFTBUS_NO_INIT;
     }
-    g_channelSliceProcessorList = CreateSoftBusList();
-    if (g_channelSliceProcessorList == NULL) {
+    if (TransSliceTableInit(&g_proxySliceTable, SLICE_PACKET_TIMEOUT_MS) != SOFTBUS_OK) {
+        TRANS_LOGE(TRANS_INIT, "init slice table fail");
         DestroySoftBusList(g_proxyChannelInfoList);
         return SOFTBUS_NO_INIT;
     }
+    if (TransCipherTableInit(&g_proxyCipherTable) != SOFTBUS_OK) {
+        TRANS_LOGE(TRANS_INIT, "init cipher table fail");
+        DestroySoftBusList(g_proxyChannelInfoList);
+        TransSliceTableDeinit(&g_proxySliceTable);
+        return SOFTBUS_NO_INIT;
+    }
     if (RegisterTimeoutCallback(SOFTBUS_PROXYSLICE_TIMER_FUN, ClientTransProxySliceTimerProc) != SOFTBUS_OK) {
         TRANS_LOGE(TRANS_INIT, "register timeout fail");
         DestroySoftBusList(g_proxyChannelInfoList);
-        DestroySoftBusList(g_channelSliceProcessorList);
+        TransSliceTableDeinit(&g_proxySliceTable);
+        TransCipherTableDeinit(&g_proxyCipherTable);
         return SOFTBUS_TIMOUT;
     }
     return SOFTBUS_OK;
@@ -76,10 +89,8 @@ static void ClientTransProxyListDeinit(void)
         DestroySoftBusList(g_proxyChannelInfoList);
         g_proxyChannelInfoList = NULL;
     }
-    if (g_channelSliceProcessorList != NULL) {
-        DestroySoftBusList(g_channelSliceProcessorList);
-        g_channelSliceProcessorList = NULL;
-    }
+    TransSliceTableDeinit(&g_proxySliceTable);
+    TransCipherTableDeinit(&g_proxyCipherTable);
 }
 
 int32_t ClientTransProxyInit(const IClientSessionCallBack *cb)
@@ -115,6 +126,20 @@ void ClientTransProxyDeinit(void)
     ClientTransProxyListDeinit();
 }
 
+// the send sequence is kept by the cipher of an encrypted channel, plain channels do not use it
+static void ClientTransProxyFillSequence(int32_t channelId, ProxyChannelInfoDetail *info)
+{
+    if (!info->isEncrypted) {
+        return;
+    }
+    TransCipherHandle *cipher = TransCipherTableAcquire(&g_proxyCipherTable, channelId);
+    if (cipher == NULL) {
+        return;
+    }
+    info->sequence = TransCipherHandleNextSeq(cipher);
+    TransCipherHandleUnref(cipher);
+}
+
 int32_t ClientTransProxyGetInfoByChannelId(int32_t channelId, ProxyChannelInfoDetail *info)
 {
     if (info == NULL) {
@@ -130,8 +155,8 @@ int32_t ClientTransProxyGetInfoByChannelId(int32_t channelId, ProxyChannelInfoDe
     LIST_FOR_EACH_ENTRY(item, &(g_proxyChannelInfoList->list), ClientProxyChannelInfo, node) {
         if (item->channelId == channelId) {
             (void)memcpy_s(info, sizeof(ProxyChannelInfoDetail), &item->detail, sizeof(ProxyChannelInfoDetail));
-            item->detail.sequence++;
             (void)SoftBusMutexUnlock(&g_proxyChannelInfoList->lock);
+            ClientTransProxyFillSequence(channelId, info);
             return SOFTBUS_OK;
         }
     }
@@ -228,6 +253,7 @@ int32_t ClientTransProxyDelChannelInfo(int32_t channelId)
             ListDelete(&item->node);
             TRANS_LOGI(TRANS_SDK, "delete channelId=%{public}d", channelId);
             SoftBusFree(item);
+            TransCipherTableRemove(&g_proxyCipherTable, channelId);
             DelPendingPacket(channelId, PENDING_TYPE_PROXY);
             (void)SoftBusMutexUnlock(&g_proxyChannelInfoList->lock);
             return SOFTBUS_OK;
@@ -246,11 +272,6 @@ static ClientProxyChannelInfo *ClientTransProxyCreateChannelInfo(const ChannelIn
         TRANS_LOGE(TRANS_SDK, "info is null");
         return NULL;
     }
-    if (memcpy_s(info->detail.sessionKey, SESSION_KEY_LENGTH, channel->sessionKey, SESSION_KEY_LENGTH) != EOK) {
-        SoftBusFree(info);
-        TRANS_LOGE(TRANS_SDK, "sessionKey memcpy fail");
-        return NULL;
-    }
     info->channelId = channel->channelId;
     info->detail.isEncrypted = channel->isEncrypt;
     info->detail.sequence = 0;
@@ -259,6 +280,26 @@ static ClientProxyChannelInfo *ClientTransProxyCreateChannelInfo(const ChannelIn
     return info;
 }
 
+// only encrypted channels get a cipher, it goes in before the channel info, a sender finding the info finds it
+static int32_t ClientTransProxyAddCipher(const ChannelInfo *channel)
+{
+    if (!channel->isEncrypt) {
+        return SOFTBUS_OK;
+    }
+    TransCipherHandle *cipher = TransCipherHandleCreate(channel->sessionKey, SESSION_KEY_LENGTH);
+    if (cipher == NULL) {
+        TRANS_LOGE(TRANS_SDK, "create cipher fail, channelId=%{public}d", channel->channelId);
+        return SOFTBUS_MEM_ERR;
+    }
+    int32_t ret = TransCipherTableAdd(&g_proxyCipherTable, channel->channelId, cipher);
+    if (ret != SOFTBUS_OK) {
+        TRANS_LOGE(TRANS_SDK, "add cipher fail channelId=%{public}d", channel->channelId);
+        TransCipherHandleUnref(cipher);
+        return ret;
+    }
+    return SOFTBUS_OK;
+}
+
 int32_t ClientTransProxyOnChannelOpened(const char *sessionName, const ChannelInfo *channel)
 {
     if (sessionName == NULL || channel == NULL) {
@@ -266,16 +307,21 @@ int32_t ClientTransProxyOnChannelOpened(const char *sessionName, const ChannelIn
         return SOFTBUS_INVALID_PARAM;
     }
 
+    int32_t ret = ClientTransProxyAddCipher(channel);
+    if (ret != SOFTBUS_OK) {
+        return ret;
+    }
     ClientProxyChannelInfo *info = ClientTransProxyCreateChannelInfo(channel);
     if (info == NULL) {
         TRANS_LOGE(TRANS_SDK, "create channel info fail, channelId=%{public}d", channel->channelId);
+        TransCipherTableRemove(&g_proxyCipherTable, channel->channelId);
         return SOFTBUS_MEM_ERR;
     }
 
-    int32_t ret = ClientTransProxyAddChannelInfo(info);
+    ret = ClientTransProxyAddChannelInfo(info);
     if (ret != SOFTBUS_OK) {
         TRANS_LOGE(TRANS_SDK, "ClientTransProxyAddChannelInfo fail channelId=%{public}d", channel->channelId);
-        (void)memset_s(info->detail.sessionKey, SESSION_KEY_LENGTH, 0, SESSION_KEY_LENGTH);
+        TransCipherTableRemove(&g_proxyCipherTable, channel->channelId);
         SoftBusFree(info);
         return ret;
     }
@@ -333,13 +379,14 @@ int32_t ClientTransProxyOnChannelOpenFailed(int32_t channelId, int32_t errCode)
 
 static int32_t ClientTransProxyDecryptPacketData(int32_t channelId, int32_t seq, ProxyDataInfo *dataInfo)
 {
-    ProxyChannelInfoDetail info;
-    int32_t ret = ClientTransProxyGetInfoByChannelId(channelId, &info);
-    if (ret != SOFTBUS_OK) {
-        TRANS_LOGE(TRANS_SDK, "get channel Info by channelId=%{public}d failed, ret=%{public}d", channelId, ret);
-        return ret;
+    TransCipherHandle *cipher = TransCipherTableAcquire(&g_proxyCipherTable, channelId);
+    if (cipher == NULL) {
+        TRANS_LOGE(TRANS_SDK, "get cipher by channelId=%{public}d failed", channelId);
+        return SOFTBUS_TRANS_PROXY_CHANNEL_NOT_FOUND;
     }
-    return TransProxyDecryptPacketData(seq, dataInfo, info.sessionKey);
+    int32_t ret = TransProxyDecryptPacketDataByCipher(seq, dataInfo, cipher);
+    TransCipherHandleUnref(cipher);
+    return ret;
 }
 
 int32_t ClientTransProxyPackAndSendData(
@@ -349,12 +396,12 @@ static void ClientTransProxySendSessionAck(int32_t channelId, int32_t seq)
 {
     unsigned char ack[PROXY_ACK_SIZE] = { 0 };
     int32_t tmpSeq = 0;
-    ProxyChannelInfoDetail info;
-    if (ClientTransProxyGetInfoByChannelId(channelId, &info) != SOFTBUS_OK) {
+    int32_t osType = 0;
+    if (ClientTransProxyGetOsTypeByChannelId(channelId, &osType) != SOFTBUS_OK) {
         TRANS_LOGE(TRANS_SDK, "get proxy info err, channelId=%{public}d", channelId);
         return;
     }
-    if (info.osType == OH_TYPE) {
+    if (osType == OH_TYPE) {
         tmpSeq = (int32_t)SoftBusHtoLl((uint32_t)seq);
     } else {
         tmpSeq = (int32_t)SoftBusHtoNl((uint32_t)seq); // convet host order to net order
@@ -363,7 +410,7 @@ static void ClientTransProxySendSessionAck(int32_t channelId, int32_t seq)
         TRANS_LOGE(TRANS_SDK, "memcpy seq err");
         return;
     }
-    info.sequence = seq;
+    ProxyChannelInfoDetail info = { .sequence = seq };
     if (ClientTransProxyPackAndSendData(channelId, ack, PROXY_ACK_SIZE, &info, TRANS_SESSION_ACK) != SOFTBUS_OK) {
         TRANS_LOGE(TRANS_SDK, "send ack err, seq=%{public}d", seq);
     }
@@ -421,12 +468,12 @@ static void ClientTransProxySendBytesAck(int32_t channelId, int32_t seq, uint32_
         TRANS_LOGI(TRANS_SDK, "proxy channel server send ack to client");
         unsigned char ack[PROXY_ACK_SIZE] = { 0 };
         int32_t tmpSeq = 0;
-        ProxyChannelInfoDetail info;
-        if (ClientTransProxyGetInfoByChannelId(channelId, &info) != SOFTBUS_OK) {
+        int32_t osType = 0;
+        if (ClientTransProxyGetOsTypeByChannelId(channelId, &osType) != SOFTBUS_OK) {
             TRANS_LOGE(TRANS_SDK, "get proxy info err, channelId=%{public}d", channelId);
             return;
         }
-        if (info.osType == OH_TYPE) {
+        if (osType == OH_TYPE) {
             tmpSeq = (int32_t)SoftBusHtoLl((uint32_t)seq);
         } else {
             tmpSeq = (int32_t)SoftBusHtoNl((uint32_t)seq);
@@ -435,7 +482,6 @@ static void ClientTransProxySendBytesAck(int32_t channelId, int32_t seq, uint32_
             TRANS_LOGE(TRANS_SDK, "memcpy seq err");
             return;
         }
-        info.sequence = seq;
         if (TransProxyAsyncPackAndSendData(channelId, ack, PROXY_ACK_SIZE, dataSeq, TRANS_SESSION_ACK) != SOFTBUS_OK) {
             TRANS_LOGE(TRANS_SDK, "send ack err, seq=%{public}d", seq);
             return;
@@ -618,84 +664,25 @@ static int32_t ClientTransProxyNoSubPacketProc(int32_t channelId, const char *da
     return SOFTBUS_OK;
 }
 
-static ChannelSliceProcessor *ClientTransProxyGetChannelSliceProcessor(int32_t channelId)
-{
-    ChannelSliceProcessor *processor = NULL;
-    LIST_FOR_EACH_ENTRY(processor, &g_channelSliceProcessorList->list, ChannelSliceProcessor, head) {
-        if (processor->channelId == channelId) {
-            return processor;
-        }
-    }
-
-    ChannelSliceProcessor *node = (ChannelSliceProcessor *)SoftBusCalloc(sizeof(ChannelSliceProcessor));
-    if (node == NULL) {
-        TRANS_LOGE(TRANS_SDK, "calloc err");
-        return NULL;
-    }
-    node->channelId = channelId;
-    ListInit(&(node->head));
-    ListAdd(&(g_channelSliceProcessorList->list), &(node->head));
-    g_channelSliceProcessorList->cnt++;
-    TRANS_LOGI(TRANS_SDK, "add new node, channelId=%{public}d", channelId);
-    return node;
-}
-
 int32_t TransProxyDelSliceProcessorByChannelId(int32_t channelId)
 {
-    ChannelSliceProcessor *node = NULL;
-    ChannelSliceProcessor *next = NULL;
-
-    if (g_channelSliceProcessorList == NULL) {
+    if (!g_proxySliceTable.isInited) {
         TRANS_LOGE(TRANS_INIT, "not init");
         return SOFTBUS_NO_INIT;
     }
-    if (SoftBusMutexLock(&g_channelSliceProcessorList->lock) != SOFTBUS_OK) {
+    if (SoftBusMutexLock(&g_proxySliceTable.lock) != SOFTBUS_OK) {
         TRANS_LOGE(TRANS_SDK, "lock err");
         return SOFTBUS_LOCK_ERR;
     }
-    LIST_FOR_EACH_ENTRY_SAFE(node, next, &g_channelSliceProcessorList->list, ChannelSliceProcessor, head) {
-        if (node->channelId == channelId) {
-            for (int i = PROXY_CHANNEL_PRORITY_MESSAGE; i < PROXY_CHANNEL_PRORITY_BUTT; i++) {
-                TransProxyClearProcessor(&(node->processor[i]));
-            }
-            ListDelete(&(node->head));
-            TRANS_LOGI(TRANS_SDK, "delete channelId=%{public}d", channelId);
-            SoftBusFree(node);
-            g_channelSliceProcessorList->cnt--;
-            (void)SoftBusMutexUnlock(&g_channelSliceProcessorList->lock);
-            return SOFTBUS_OK;
-        }
-    }
-    (void)SoftBusMutexUnlock(&g_channelSliceProcessorList->lock);
+    TransSliceTableDelChannel(&g_proxySliceTable, channelId);
+    (void)SoftBusMutexUnlock(&g_proxySliceTable.lock);
     return SOFTBUS_OK;
 }
 
-static int32_t ClientTransProxyFirstSliceProcess(
-    SliceProcessor *processor, const SliceHead *head, const char *data, uint32_t len, int32_t channelId)
-{
-    TransProxyClearProcessor(processor);
-    bool supportTlv = false;
-    int32_t ret = GetSupportTlvAndNeedAckById(channelId, CHANNEL_TYPE_PROXY, &supportTlv, NULL);
-    if (ret != SOFTBUS_OK) {
-        TRANS_LOGE(TRANS_SDK, "get support tlv failed, channelId=%{public}d", channelId);
-        return ret;
-    }
-    uint32_t actualDataLen = 0;
-    ret = TransGetActualDataLen(head, &actualDataLen);
-    if (ret != SOFTBUS_OK) {
-        TRANS_LOGE(TRANS_SDK, "get actual datalen failed, channelId=%{public}d", channelId);
-        return ret;
-    }
-    return TransProxyFirstSliceProcess(processor, head, data, len, supportTlv);
-}
-
 static bool IsValidCheckoutProcess(int32_t channelId)
 {
-    ChannelSliceProcessor *processor = NULL;
-    LIST_FOR_EACH_ENTRY(processor, &g_channelSliceProcessorList->list, ChannelSliceProcessor, head) {
-        if (processor->channelId == channelId) {
-            return true;
-        }
+    if (TransSliceTableHasChannel(&g_proxySliceTable, channelId)) {
+        return true;
     }
 
     TRANS_LOGE(TRANS_SDK, "Process not exist.");
@@ -703,28 +690,21 @@ static bool IsValidCheckoutProcess(int32_t channelId)
 }
 
 static int32_t ClientTransProxyLastSliceProcess(
-    SliceProcessor *processor, const SliceHead *head, const char *data, uint32_t len, int32_t channelId)
+    TransSliceEntry *entry, const SliceHead *head, const char *data, uint32_t len, int32_t channelId)
 {
-    int32_t ret = TransProxySliceProcessChkPkgIsValid(processor, head, data, len);
+    int32_t ret = TransSliceTableLastSlice(&g_proxySliceTable, entry, head, data, len);
     if (ret != SOFTBUS_OK) {
         return ret;
     }
-    if (memcpy_s(processor->data + processor->dataLen, (uint32_t)(processor->bufLen - processor->dataLen), data, len) !=
-        EOK) {
-        TRANS_LOGE(TRANS_SDK, "memcpy fail when proc last slice");
-        return SOFTBUS_MEM_ERR;
-    }
-    processor->expectedSeq++;
-    processor->dataLen += (int32_t)len;
 
-    ret = ClientTransProxyNoSubPacketProc(channelId, processor->data, (uint32_t)processor->dataLen);
+    ret = ClientTransProxyNoSubPacketProc(channelId, entry->processor.data, (uint32_t)entry->processor.dataLen);
     if (ret != SOFTBUS_OK) {
         TRANS_LOGE(TRANS_SDK, "process packets err");
         return ret;
     }
 
     if (IsValidCheckoutProcess(channelId)) {
-        TransProxyClearProcessor(processor);
+        TransSliceTableClearEntry(&g_proxySliceTable, entry);
     }
 
     TRANS_LOGI(TRANS_SDK, "LastSliceProcess ok");
@@ -733,36 +713,34 @@ static int32_t ClientTransProxyLastSliceProcess(
 
 static int ClientTransProxySubPacketProc(int32_t channelId, const SliceHead *head, const char *data, uint32_t len)
 {
-    if (g_channelSliceProcessorList == NULL) {
+    if (!g_proxySliceTable.isInited) {
         TRANS_LOGE(TRANS_SDK, "TransProxySubPacketProc not init");
         return SOFTBUS_NO_INIT;
     }
-    if (SoftBusMutexLock(&g_channelSliceProcessorList->lock) != SOFTBUS_OK) {
+    if (SoftBusMutexLock(&g_proxySliceTable.lock) != SOFTBUS_OK) {
         TRANS_LOGE(TRANS_SDK, "lock err");
         return SOFTBUS_LOCK_ERR;
     }
 
-    ChannelSliceProcessor *channelProcessor = ClientTransProxyGetChannelSliceProcessor(channelId);
-    if (channelProcessor == NULL) {
-        SoftBusMutexUnlock(&g_channelSliceProcessorList->lock);
+    TransSliceEntry *entry = TransSliceTableGetEntry(&g_proxySliceTable, channelId, head->priority);
+    if (entry == NULL) {
+        SoftBusMutexUnlock(&g_proxySliceTable.lock);
         return SOFTBUS_TRANS_GET_CLIENT_PROXY_NULL;
     }
 
     int ret;
-    int32_t index = head->priority;
-    SliceProcessor *processor = &(channelProcessor->processor[index]);
     if (head->sliceSeq == 0) {
-        ret = ClientTransProxyFirstSliceProcess(processor, head, data, len, channelId);
+        ret = TransSliceTableFirstSlice(&g_proxySliceTable, entry, head, data, len);
     } else if (head->sliceNum == head->sliceSeq + 1) {
-        ret = ClientTransProxyLastSliceProcess(processor, head, data, len, channelId);
+        ret = ClientTransProxyLastSliceProcess(entry, head, data, len, channelId);
     } else {
-        ret = TransProxyNormalSliceProcess(processor, head, data, len);
+        ret = TransSliceTableNormalSlice(&g_proxySliceTable, entry, head, data, len);
     }
-
-    SoftBusMutexUnlock(&g_channelSliceProcessorList->lock);
-    if (ret != SOFTBUS_OK) {
-        TransProxyClearProcessor(processor);
+    // an out of order slice drops the whole message, its buffer goes back to the pool
+    if (ret != SOFTBUS_OK && IsValidCheckoutProcess(channelId)) {
+        TransSliceTableClearEntry(&g_proxySliceTable, entry);
     }
+    SoftBusMutexUnlock(&g_proxySliceTable.lock);
     return ret;
 }
 
@@ -792,31 +770,15 @@ static int32_t ClientTransProxySliceProc(int32_t channelId, const char *data, ui
 
 static void ClientTransProxySliceTimerProc(void)
 {
-#define SLICE_PACKET_TIMEOUT 10 // 10s
-    ChannelSliceProcessor *removeNode = NULL;
-    ChannelSliceProcessor *nextNode = NULL;
-
-    if (g_channelSliceProcessorList == NULL || g_channelSliceProcessorList->cnt == 0) {
+    if (!g_proxySliceTable.isInited || g_proxySliceTable.cnt == 0) {
         return;
     }
-    if (SoftBusMutexLock(&g_channelSliceProcessorList->lock) != SOFTBUS_OK) {
+    if (SoftBusMutexLock(&g_proxySliceTable.lock) != SOFTBUS_OK) {
         TRANS_LOGE(TRANS_SDK, "TransProxySliceTimerProc lock mutex fail!");
         return;
     }
-
-    LIST_FOR_EACH_ENTRY_SAFE(removeNode, nextNode, &g_channelSliceProcessorList->list, ChannelSliceProcessor, head) {
-        for (int i = PROXY_CHANNEL_PRORITY_MESSAGE; i < PROXY_CHANNEL_PRORITY_BUTT; i++) {
-            if (removeNode->processor[i].active == true) {
-                removeNode->processor[i].timeout++;
-                if (removeNode->processor[i].timeout >= SLICE_PACKET_TIMEOUT) {
-                    TRANS_LOGE(TRANS_SDK, "timeout=%{public}d", removeNode->processor[i].timeout);
-                    TransProxyClearProcessor(&removeNode->processor[i]);
-                }
-            }
-        }
-    }
-    (void)SoftBusMutexUnlock(&g_channelSliceProcessorList->lock);
-    return;
+    (void)TransSliceTableExpire(&g_proxySliceTable, SoftBusGetSysTimeMs());
+    (void)SoftBusMutexUnlock(&g_proxySliceTable.lock);
 }
 
 int32_t ClientTransProxyOnDataReceived(int32_t channelId, const void *data, uint32_t len, SessionPktType type)
@@ -849,9 +811,9 @@ void ClientTransProxyCloseChannel(int32_t channelId)
 }
 
 static int32_t ClientTransProxyPackTlvBytes(int32_t channelId, ProxyDataInfo *dataInfo,
-    ProxyChannelInfoDetail *info, SessionPktType flag, uint32_t dataSeq)
+    TransCipherHandle *cipher, int32_t seq, SessionPktType flag, uint32_t dataSeq)
 {
-    if (dataInfo == NULL || info == NULL) {
+    if (dataInfo == NULL || cipher == NULL) {
         return SOFTBUS_INVALID_PARAM;
     }
     bool needAck = false;
@@ -861,13 +823,13 @@ static int32_t ClientTransProxyPackTlvBytes(int32_t channelId, ProxyDataInfo *da
         .needAck = needAck,
         .dataSeq = dataSeq,
     };
-    return TransProxyPackTlvBytes(dataInfo, info->sessionKey, flag, info->sequence, &headInfo);
+    return TransProxyPackTlvBytesByCipher(dataInfo, cipher, flag, seq, &headInfo);
 }
 
 static int32_t ClientTransProxyPackBytes(int32_t channelId, ProxyDataInfo *dataInfo,
-    ProxyChannelInfoDetail *info, SessionPktType flag)
+    TransCipherHandle *cipher, int32_t seq, SessionPktType flag)
 {
-    if (dataInfo == NULL || info == NULL) {
+    if (dataInfo == NULL || cipher == NULL) {
         TRANS_LOGE(TRANS_SDK, "invalid param, channelId=%{public}d", channelId);
         return SOFTBUS_INVALID_PARAM;
     }
@@ -876,148 +838,170 @@ static int32_t ClientTransProxyPackBytes(int32_t channelId, ProxyDataInfo *dataI
     int32_t res = GetSupportTlvAndNeedAckById(channelId, CHANNEL_TYPE_PROXY, &supportTlv, NULL);
     TRANS_CHECK_AND_RETURN_RET_LOGE(res == SOFTBUS_OK, res, TRANS_SDK, "get support tlv fail");
     if (supportTlv) {
-        return ClientTransProxyPackTlvBytes(channelId, dataInfo, info, flag, dataSeq);
+        return ClientTransProxyPackTlvBytes(channelId, dataInfo, cipher, seq, flag, dataSeq);
     }
-    return TransProxyPackBytes(channelId, dataInfo, info->sessionKey, flag, info->sequence);
+    return TransProxyPackBytesByCipher(channelId, dataInfo, cipher, flag, seq);
 }
 
-int32_t ClientTransProxyPackAndSendData(
-    int32_t channelId, const void *data, uint32_t len, ProxyChannelInfoDetail *info, SessionPktType pktType)
+// slices go out straight from the packed buffer, dataInfo->outData is freed on return
+static int32_t ClientTransProxySendSlices(int32_t channelId, ProxyDataInfo *dataInfo, SessionPktType pktType)
 {
-    if (data == NULL || info == NULL) {
-        return SOFTBUS_INVALID_PARAM;
-    }
-    ProxyDataInfo dataInfo = { (uint8_t *)data, len, (uint8_t *)data, len };
-    int32_t ret = ClientTransProxyPackBytes(channelId, &dataInfo, info, pktType);
+    ProxySliceIterator iter;
+    int32_t ret = TransProxySliceIterInit(&iter, dataInfo, pktType);
     if (ret != SOFTBUS_OK) {
-        TRANS_LOGE(TRANS_SDK, "ClientTransProxyPackBytes error, channelId=%{public}d", channelId);
+        TRANS_LOGE(TRANS_SDK, "init slice iterator failed, channelId=%{public}d", channelId);
+        SoftBusFree(dataInfo->outData);
         return ret;
     }
-    uint32_t dataLen = 1;
-
-    uint32_t sliceNum = (dataInfo.outLen + (uint32_t)(SLICE_LEN - 1)) / (uint32_t)SLICE_LEN;
-    if (sliceNum > INT32_MAX) {
-        TRANS_LOGE(TRANS_SDK, "Data overflow");
-        SoftBusFree(dataInfo.outData);
-        return SOFTBUS_INVALID_NUM;
-    }
-    for (uint32_t cnt = 0; cnt < sliceNum; cnt++) {
-        uint8_t *sliceData = TransProxyPackData(&dataInfo, sliceNum, pktType, cnt, &dataLen);
+    for (uint32_t cnt = 0; cnt < iter.sliceNum; cnt++) {
+        uint32_t sliceLen = 0;
+        uint8_t *sliceData = TransProxySliceIterNext(&iter, &sliceLen);
         if (sliceData == NULL) {
             TRANS_LOGE(TRANS_SDK, "pack data failed, channelId=%{public}d", channelId);
-            SoftBusFree(dataInfo.outData);
-            return SOFTBUS_MALLOC_ERR;
+            ret = SOFTBUS_MALLOC_ERR;
+            break;
         }
-        ret = ServerIpcSendMessage(channelId, CHANNEL_TYPE_PROXY, sliceData, dataLen + sizeof(SliceHead), pktType);
+        ret = ServerIpcSendMessage(channelId, CHANNEL_TYPE_PROXY, sliceData, sliceLen, pktType);
         if (ret != SOFTBUS_OK) {
             TRANS_LOGE(TRANS_SDK, "ServerIpcSendMessage error, channelId=%{public}d, ret=%{public}d", channelId, ret);
-            SoftBusFree(sliceData);
-            SoftBusFree(dataInfo.outData);
-            return ret;
+            break;
         }
-
-        SoftBusFree(sliceData);
     }
-    SoftBusFree(dataInfo.outData);
+    TransProxySliceIterDeinit(&iter);
+    SoftBusFree(dataInfo->outData);
+    return ret;
+}
 
+static int32_t ClientTransProxyPackAndSendByCipher(int32_t channelId, const void *data, uint32_t len,
+    TransCipherHandle *cipher, int32_t seq, SessionPktType pktType)
+{
+    ProxyDataInfo dataInfo = { (uint8_t *)data, len, (uint8_t *)data, len };
+    int32_t ret = ClientTransProxyPackBytes(channelId, &dataInfo, cipher, seq, pktType);
+    if (ret != SOFTBUS_OK) {
+        TRANS_LOGE(TRANS_SDK, "ClientTransProxyPackBytes error, channelId=%{public}d", channelId);
+        return ret;
+    }
+    ret = ClientTransProxySendSlices(channelId, &dataInfo, pktType);
+    if (ret != SOFTBUS_OK) {
+        return ret;
+    }
     TRANS_LOGI(TRANS_SDK, "TransProxyPackAndSendData success, channelId=%{public}d", channelId);
     return SOFTBUS_OK;
 }
 
-int32_t TransProxyChannelSendBytes(int32_t channelId, const void *data, uint32_t len, bool needAck)
+int32_t ClientTransProxyPackAndSendData(
+    int32_t channelId, const void *data, uint32_t len, ProxyChannelInfoDetail *info, SessionPktType pktType)
 {
-    if (data == NULL) {
+    if (data == NULL || info == NULL) {
         return SOFTBUS_INVALID_PARAM;
     }
+    TransCipherHandle *cipher = TransCipherTableAcquire(&g_proxyCipherTable, channelId);
+    TRANS_CHECK_AND_RETURN_RET_LOGE(
+        cipher != NULL, SOFTBUS_TRANS_PROXY_CHANNEL_NOT_FOUND, TRANS_SDK, "get cipher fail");
+    int32_t ret = ClientTransProxyPackAndSendByCipher(channelId, data, len, cipher, info->sequence, pktType);
+    TransCipherHandleUnref(cipher);
+    return ret;
+}
+
+// a channel without a cipher is not encrypted, its data goes to the server as is
+static int32_t ClientTransProxySendPlainData(int32_t channelId, const void *data, uint32_t len)
+{
     ProxyChannelInfoDetail info;
     int32_t ret = ClientTransProxyGetInfoByChannelId(channelId, &info);
     TRANS_CHECK_AND_RETURN_RET_LOGE(ret == SOFTBUS_OK, ret, TRANS_SDK, "get info fail!");
+    if (info.isEncrypted) {
+        // the cipher is removed together with the channel info, the channel is being closed
+        TRANS_LOGE(TRANS_SDK, "cipher already removed, channelId=%{public}d", channelId);
+        return SOFTBUS_TRANS_PROXY_CHANNEL_NOT_FOUND;
+    }
+    ret = ServerIpcSendMessage(channelId, CHANNEL_TYPE_PROXY, data, len, TRANS_SESSION_BYTES);
+    TRANS_LOGI(TRANS_SDK, "send bytes: channelId=%{public}d, ret=%{public}d", channelId, ret);
+    return ret;
+}
 
-    if (!info.isEncrypted) {
-        ret = ServerIpcSendMessage(channelId, CHANNEL_TYPE_PROXY, data, len, TRANS_SESSION_BYTES);
-        TRANS_LOGI(TRANS_SDK, "send bytes: channelId=%{public}d, ret=%{public}d", channelId, ret);
+// takes over the cipher reference of the caller, the message sequence comes from it as well
+static int32_t ClientTransProxySendWithAck(
+    int32_t channelId, const void *data, uint32_t len, TransCipherHandle *cipher, SessionPktType pktType)
+{
+    int32_t seq = TransCipherHandleNextSeq(cipher);
+    int32_t ret = AddPendingPacket(channelId, seq, PENDING_TYPE_PROXY);
+    if (ret != SOFTBUS_OK) {
+        TRANS_LOGE(TRANS_SDK, "add pending packet failed, channelId=%{public}d.", channelId);
+        TransCipherHandleUnref(cipher);
         return ret;
     }
-    if (needAck) {
-        ret = AddPendingPacket(channelId, info.sequence, PENDING_TYPE_PROXY);
-        if (ret != SOFTBUS_OK) {
-            TRANS_LOGE(TRANS_SDK, "add pending packet failed, channelId=%{public}d.", channelId);
-            return ret;
-        }
-        ret = ClientTransProxyPackAndSendData(channelId, data, len, &info, TRANS_SESSION_BYTES);
-        if (ret != SOFTBUS_OK) {
-            DelPendingPacketbyChannelId(channelId, info.sequence, PENDING_TYPE_PROXY);
-            return ret;
-        }
-        TRANS_LOGI(TRANS_SDK, "send msg: channelId=%{public}d, seq=%{public}d", channelId, info.sequence);
-        return ProcPendingPacket(channelId, info.sequence, PENDING_TYPE_PROXY);
+    ret = ClientTransProxyPackAndSendByCipher(channelId, data, len, cipher, seq, pktType);
+    TransCipherHandleUnref(cipher);
+    if (ret != SOFTBUS_OK) {
+        DelPendingPacketbyChannelId(channelId, seq, PENDING_TYPE_PROXY);
+        return ret;
     }
-    return ClientTransProxyPackAndSendData(channelId, data, len, &info, TRANS_SESSION_BYTES);
+    TRANS_LOGI(TRANS_SDK, "send msg: channelId=%{public}d, seq=%{public}d", channelId, seq);
+    return ProcPendingPacket(channelId, seq, PENDING_TYPE_PROXY);
 }
 
-int32_t TransProxyAsyncPackAndSendData(
-    int32_t channelId, const void *data, uint32_t len, uint32_t dataSeq, SessionPktType pktType)
+int32_t TransProxyChannelSendBytes(int32_t channelId, const void *data, uint32_t len, bool needAck)
 {
     if (data == NULL) {
         return SOFTBUS_INVALID_PARAM;
     }
-    ProxyChannelInfoDetail info;
-    int32_t ret = ClientTransProxyGetInfoByChannelId(channelId, &info);
-    TRANS_CHECK_AND_RETURN_RET_LOGE(ret == SOFTBUS_OK, ret, TRANS_SDK, "get info fail");
+    TransCipherHandle *cipher = TransCipherTableAcquire(&g_proxyCipherTable, channelId);
+    if (cipher == NULL) {
+        return ClientTransProxySendPlainData(channelId, data, len);
+    }
+    if (needAck) {
+        return ClientTransProxySendWithAck(channelId, data, len, cipher, TRANS_SESSION_BYTES);
+    }
+    int32_t ret = ClientTransProxyPackAndSendByCipher(
+        channelId, data, len, cipher, TransCipherHandleNextSeq(cipher), TRANS_SESSION_BYTES);
+    TransCipherHandleUnref(cipher);
+    return ret;
+}
 
+static int32_t ClientTransProxyAsyncPackAndSendByCipher(int32_t channelId, const void *data, uint32_t len,
+    TransCipherHandle *cipher, uint32_t dataSeq, SessionPktType pktType)
+{
     ProxyDataInfo dataInfo = { (uint8_t *)data, len, (uint8_t *)data, len };
-    ret = ClientTransProxyPackTlvBytes(channelId, &dataInfo, &info, pktType, dataSeq);
+    int32_t ret = ClientTransProxyPackTlvBytes(
+        channelId, &dataInfo, cipher, TransCipherHandleNextSeq(cipher), pktType, dataSeq);
     if (ret != SOFTBUS_OK) {
         TRANS_LOGE(TRANS_SDK, "ClientTransProxyPackTlvBytes error, channelId=%{public}d", channelId);
         return ret;
     }
-    uint32_t dataLen = 1;
-
-    uint32_t sliceNum = (dataInfo.outLen + (uint32_t)(SLICE_LEN - 1)) / (uint32_t)SLICE_LEN;
-    if (sliceNum > INT32_MAX) {
-        SoftBusFree(dataInfo.outData);
-        TRANS_LOGE(TRANS_FILE, "Data overflow, sliceNum=%{public}u, channelId=%{public}d", sliceNum, channelId);
-        return SOFTBUS_INVALID_NUM;
-    }
-    for (uint32_t cnt = 0; cnt < sliceNum; cnt++) {
-        uint8_t *sliceData = TransProxyPackData(&dataInfo, sliceNum, pktType, cnt, &dataLen);
-        if (sliceData == NULL) {
-            TRANS_LOGE(TRANS_SDK, "pack data failed, channelId=%{public}d", channelId);
-            SoftBusFree(dataInfo.outData);
-            return SOFTBUS_MALLOC_ERR;
-        }
-
-        int ret = ServerIpcSendMessage(channelId, CHANNEL_TYPE_PROXY, sliceData, dataLen + sizeof(SliceHead), pktType);
-        if (ret != SOFTBUS_OK) {
-            TRANS_LOGE(TRANS_SDK, "ServerIpcSendMessage error, channelId=%{public}d, ret=%{public}d", channelId, ret);
-            SoftBusFree(sliceData);
-            SoftBusFree(dataInfo.outData);
-            return ret;
-        }
-
-        SoftBusFree(sliceData);
+    ret = ClientTransProxySendSlices(channelId, &dataInfo, pktType);
+    if (ret != SOFTBUS_OK) {
+        return ret;
     }
-    SoftBusFree(dataInfo.outData);
     TRANS_LOGI(TRANS_SDK, "TransProxyAsyncPackAndSendData success, channelId=%{public}d", channelId);
     return SOFTBUS_OK;
 }
 
-int32_t TransProxyChannelAsyncSendBytes(int32_t channelId, const void *data, uint32_t len, uint32_t dataSeq)
+int32_t TransProxyAsyncPackAndSendData(
+    int32_t channelId, const void *data, uint32_t len, uint32_t dataSeq, SessionPktType pktType)
 {
     if (data == NULL) {
         return SOFTBUS_INVALID_PARAM;
     }
-    ProxyChannelInfoDetail info;
-    int32_t ret = ClientTransProxyGetInfoByChannelId(channelId, &info);
-    TRANS_CHECK_AND_RETURN_RET_LOGE(ret == SOFTBUS_OK, ret, TRANS_SDK, "get info fail!");
+    TransCipherHandle *cipher = TransCipherTableAcquire(&g_proxyCipherTable, channelId);
+    TRANS_CHECK_AND_RETURN_RET_LOGE(
+        cipher != NULL, SOFTBUS_TRANS_PROXY_CHANNEL_NOT_FOUND, TRANS_SDK, "get cipher fail");
+    int32_t ret = ClientTransProxyAsyncPackAndSendByCipher(channelId, data, len, cipher, dataSeq, pktType);
+    TransCipherHandleUnref(cipher);
+    return ret;
+}
 
-    if (!info.isEncrypted) {
-        ret = ServerIpcSendMessage(channelId, CHANNEL_TYPE_PROXY, data, len, TRANS_SESSION_BYTES);
-        TRANS_LOGI(TRANS_SDK, "send bytes: channelId=%{public}d, ret=%{public}d", channelId, ret);
-        return ret;
+int32_t TransProxyChannelAsyncSendBytes(int32_t channelId, const void *data, uint32_t len, uint32_t dataSeq)
+{
+    if (data == NULL) {
+        return SOFTBUS_INVALID_PARAM;
     }
-
-    ret = TransProxyAsyncPackAndSendData(channelId, data, len, dataSeq, TRANS_SESSION_BYTES);
+    TransCipherHandle *cipher = TransCipherTableAcquire(&g_proxyCipherTable, channelId);
+    if (cipher == NULL) {
+        return ClientTransProxySendPlainData(channelId, data, len);
+    }
+    int32_t ret =
+        ClientTransProxyAsyncPackAndSendByCipher(channelId, data, len, cipher, dataSeq, TRANS_SESSION_BYTES);
+    TransCipherHandleUnref(cipher);
     TRANS_CHECK_AND_RETURN_RET_LOGE(ret == SOFTBUS_OK, ret, TRANS_SDK, "proxy async send data fail!");
     int32_t socketId = 0;
     ret = ClientGetSessionIdByChannelId(channelId, CHANNEL_TYPE_PROXY, &socketId, false);
@@ -1035,29 +1019,12 @@ int32_t TransProxyChannelAsyncSendBytes(int32_t channelId, const void *data, uin
 
 int32_t TransProxyChannelSendMessage(int32_t channelId, const void *data, uint32_t len)
 {
-    ProxyChannelInfoDetail info;
-    int32_t ret = ClientTransProxyGetInfoByChannelId(channelId, &info);
-    TRANS_CHECK_AND_RETURN_RET_LOGE(ret == SOFTBUS_OK, ret, TRANS_SDK, "get info fail!");
-
-    if (!info.isEncrypted) {
+    TransCipherHandle *cipher = TransCipherTableAcquire(&g_proxyCipherTable, channelId);
+    if (cipher == NULL) {
         // auth channel only can send bytes
-        ret = ServerIpcSendMessage(channelId, CHANNEL_TYPE_PROXY, data, len, TRANS_SESSION_BYTES);
-        TRANS_LOGI(TRANS_SDK, "send msg: channelId=%{public}d, ret=%{public}d", channelId, ret);
-        return ret;
-    }
-
-    ret = AddPendingPacket(channelId, info.sequence, PENDING_TYPE_PROXY);
-    if (ret != SOFTBUS_OK) {
-        TRANS_LOGE(TRANS_SDK, "add pending packet failed, channelId=%{public}d.", channelId);
-        return ret;
-    }
-    ret = ClientTransProxyPackAndSendData(channelId, data, len, &info, TRANS_SESSION_MESSAGE);
-    if (ret != SOFTBUS_OK) {
-        DelPendingPacketbyChannelId(channelId, info.sequence, PENDING_TYPE_PROXY);
-        return ret;
+        return ClientTransProxySendPlainData(channelId, data, len);
     }
-    TRANS_LOGI(TRANS_SDK, "send msg: channelId=%{public}d, seq=%{public}d", channelId, info.sequence);
-    return ProcPendingPacket(channelId, info.sequence, PENDING_TYPE_PROXY);
+    return ClientTransProxySendWithAck(channelId, data, len, cipher, TRANS_SESSION_MESSAGE);
 }
 
 int32_t ClientTransProxyOnChannelBind(int32_t channelId, int32_t channelType)
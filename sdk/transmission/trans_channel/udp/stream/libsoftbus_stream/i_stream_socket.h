@@ -111,12 +111,30 @@ protected:
         return nullptr;
     }
 
+    // takes every queued stream at once, waits only while nothing is queued
+    virtual bool TakeStreams(std::queue<std::unique_ptr<IStream>> &streams)
+    {
+        std::unique_lock<std::mutex> lock(streamReceiveLock_);
+        while (isStreamRecv_) {
+            if (!streamReceiveBuffer_.empty()) {
+                streamReceiveBuffer_.swap(streams);
+                return true;
+            }
+            streamReceiveCv_.wait(lock);
+        }
+        return false;
+    }
+
     virtual void PutStream(std::unique_ptr<IStream> stream)
     {
         std::lock_guard<std::mutex> lock(streamReceiveLock_);
         if (isStreamRecv_) {
+            // the taker only sleeps on an empty queue, so it needs waking for the first stream alone
+            bool isEmpty = streamReceiveBuffer_.empty();
             streamReceiveBuffer_.push(std::move(stream));
-            streamReceiveCv_.notify_all();
+            if (isEmpty) {
+                streamReceiveCv_.notify_all();
+            }
         }
     }
 
@@ -32,7 +32,10 @@ public:
     ssize_t CalculateHeaderSize() const;
     ssize_t CalculateExtSize(ssize_t extSize) const;
 
+    ssize_t CalculatePacketLen();
     std::unique_ptr<char[]> PacketizeStream();
+    // writes the packet into a buffer of at least CalculatePacketLen() bytes owned by the caller
+    bool PacketizeStream(char *buf, ssize_t bufLen);
     ssize_t GetPacketLen() const
     {
         return hdrSize_ + dataSize_ + extSize_;
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stream_send_queue.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+#include "common_inner.h"
+
+namespace Communication {
+namespace SoftBus {
+namespace {
+// a late key frame still resyncs the decoder, a late dependent frame only shows stale content
+const int64_t KEY_FRAME_DEADLINE_FACTOR = 2;
+} // namespace
+
+StreamSendQueue::StreamSendQueue(SendFunc send, uint32_t capacity, int64_t deadlineMs)
+    : send_(std::move(send)), capacity_(std::max(capacity, 1U)), deadline_(deadlineMs)
+{
+}
+
+StreamSendQueue::~StreamSendQueue()
+{
+    Stop();
+}
+
+StreamSendQueue::FrameClass StreamSendQueue::GetFrameClass(FrameType frameType)
+{
+    if (frameType == VIDEO_I) {
+        return KEY_FRAME;
+    }
+    if (frameType > VIDEO_I && frameType <= VIDEO_MAX) {
+        return DEPENDENT_FRAME;
+    }
+    return INDEPENDENT_FRAME;
+}
+
+bool StreamSendQueue::IsBroken(const Entry &entry) const
+{
+    return entry.frameClass == DEPENDENT_FRAME && entry.level >= brokenLevel_;
+}
+
+void StreamSendQueue::DropDependent(std::deque<Entry>::iterator from, uint32_t level, uint64_t &counter)
+{
+    auto it = from;
+    while (it != queue_.end() && it->frameClass != KEY_FRAME) {
+        if (it->frameClass == DEPENDENT_FRAME && it->level >= level) {
+            it = queue_.erase(it);
+            counter++;
+            continue;
+        }
+        ++it;
+    }
+    // no queued key frame to resync on, so the next frames pushed reference what was dropped
+    if (it == queue_.end()) {
+        brokenLevel_ = std::min(brokenLevel_, level);
+    }
+}
+
+void StreamSendQueue::MakeRoom()
+{
+    // the newest frame of the highest level is referenced by the fewest others
+    auto victim = queue_.end();
+    for (auto it = queue_.begin(); it != queue_.end(); ++it) {
+        if (it->frameClass == DEPENDENT_FRAME && (victim == queue_.end() || it->level >= victim->level)) {
+            victim = it;
+        }
+    }
+    if (victim != queue_.end()) {
+        TRANS_LOGD(TRANS_STREAM, "queue full, drop dependent frames from level=%{public}u", victim->level);
+        DropDependent(victim, victim->level, stats_.overflowNum);
+        return;
+    }
+    auto oldest = std::find_if(queue_.begin(), queue_.end(),
+        [](const Entry &entry) { return entry.frameClass == INDEPENDENT_FRAME; });
+    if (oldest == queue_.end()) {
+        TRANS_LOGW(TRANS_STREAM, "queue full of key frames, drop the oldest");
+        oldest = queue_.begin();
+    }
+    if (oldest != queue_.end()) {
+        queue_.erase(oldest);
+        stats_.overflowNum++;
+    }
+}
+
+void StreamSendQueue::DropExpired(Clock::time_point now)
+{
+    auto it = queue_.begin();
+    while (it != queue_.end()) {
+        if (it->deadline >= now) {
+            ++it;
+            continue;
+        }
+        FrameClass frameClass = it->frameClass;
+        uint32_t level = it->level;
+        it = queue_.erase(it);
+        stats_.expiredNum++;
+        if (frameClass == KEY_FRAME) {
+            TRANS_LOGW(TRANS_STREAM, "key frame expired");
+            DropDependent(it, 0, stats_.brokenNum);
+        } else if (frameClass == DEPENDENT_FRAME) {
+            DropDependent(it, level, stats_.brokenNum);
+        }
+        // everything dropped so far lay behind the expired frame, so restart from the front
+        it = queue_.begin();
+    }
+}
+
+bool StreamSendQueue::Push(std::unique_ptr<IStream> stream)
+{
+    if (stream == nullptr || stream->GetStreamFrameInfo() == nullptr) {
+        TRANS_LOGE(TRANS_STREAM, "invalid stream");
+        return false;
+    }
+    const StreamFrameInfo *info = stream->GetStreamFrameInfo();
+    Entry entry = { nullptr, GetFrameClass(info->frameType), info->level, Clock::now() };
+
+    std::lock_guard<std::mutex> guard(lock_);
+    if (isStopped_) {
+        TRANS_LOGE(TRANS_STREAM, "send queue stopped");
+        return false;
+    }
+    entry.deadline += (entry.frameClass == KEY_FRAME) ? deadline_ * KEY_FRAME_DEADLINE_FACTOR : deadline_;
+    DropExpired(Clock::now());
+    if (entry.frameClass == KEY_FRAME) {
+        // the decoder resyncs on this frame, the dependent frames still queued before it only delay it
+        auto end = std::remove_if(queue_.begin(), queue_.end(),
+            [](const Entry &queued) { return queued.frameClass == DEPENDENT_FRAME; });
+        stats_.supersededNum += static_cast<uint64_t>(queue_.end() - end);
+        queue_.erase(end, queue_.end());
+        brokenLevel_ = UINT32_MAX;
+    } else if (IsBroken(entry)) {
+        TRANS_LOGD(TRANS_STREAM, "reference dropped, drop seqNum=%{public}u", info->seqNum);
+        stats_.brokenNum++;
+        return false;
+    }
+    const IStream *pushed = stream.get();
+    entry.stream = std::move(stream);
+    queue_.push_back(std::move(entry));
+    while (queue_.size() > capacity_) {
+        MakeRoom();
+    }
+    if (!sender_.joinable()) {
+        sender_ = std::thread(&StreamSendQueue::Run, this);
+    }
+    cv_.notify_one();
+    return !queue_.empty() && queue_.back().stream.get() == pushed;
+}
+
+void StreamSendQueue::Run()
+{
+    const std::string threadName = "OS_stmSendQue";
+    pthread_setname_np(pthread_self(), threadName.c_str());
+    std::unique_lock<std::mutex> lock(lock_);
+    while (true) {
+        cv_.wait(lock, [this]() { return isStopped_ || !queue_.empty(); });
+        if (isStopped_) {
+            break;
+        }
+        DropExpired(Clock::now());
+        if (queue_.empty()) {
+            idleCv_.notify_all();
+            continue;
+        }
+        Entry entry = std::move(queue_.front());
+        queue_.pop_front();
+        isSending_ = true;
+        lock.unlock();
+        bool isSent = send_(std::move(entry.stream));
+        lock.lock();
+        isSending_ = false;
+        if (isSent) {
+            stats_.sentNum++;
+        } else {
+            stats_.failedNum++;
+            if (entry.frameClass != INDEPENDENT_FRAME) {
+                DropDependent(queue_.begin(), (entry.frameClass == KEY_FRAME) ? 0 : entry.level, stats_.brokenNum);
+            }
+        }
+        if (queue_.empty()) {
+            idleCv_.notify_all();
+        }
+    }
+    TRANS_LOGI(TRANS_STREAM, "send queue exit, sent=%{public}" PRIu64 ", failed=%{public}" PRIu64
+        ", superseded=%{public}" PRIu64 ", broken=%{public}" PRIu64 ", expired=%{public}" PRIu64
+        ", overflow=%{public}" PRIu64, stats_.sentNum, stats_.failedNum, stats_.supersededNum, stats_.brokenNum,
+        stats_.expiredNum, stats_.overflowNum);
+}
+
+void StreamSendQueue::Quit()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        isStopped_ = true;
+        queue_.clear();
+    }
+    cv_.notify_all();
+    idleCv_.notify_all();
+}
+
+void StreamSendQueue::Stop()
+{
+    Quit();
+    if (!sender_.joinable()) {
+        return;
+    }
+    if (sender_.get_id() == std::this_thread::get_id()) {
+        sender_.detach();
+        return;
+    }
+    sender_.join();
+}
+
+bool StreamSendQueue::WaitIdle(int64_t timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(lock_);
+    return idleCv_.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+        [this]() { return isStopped_ || (queue_.empty() && !isSending_); });
+}
+
+void StreamSendQueue::SetDeadline(int64_t deadlineMs)
+{
+    std::lock_guard<std::mutex> guard(lock_);
+    deadline_ = std::chrono::milliseconds(deadlineMs);
+}
+
+StreamSendQueueStats StreamSendQueue::GetStats()
+{
+    std::lock_guard<std::mutex> guard(lock_);
+    return stats_;
+}
+} // namespace SoftBus
+} // namespace Communication
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STREAM_SEND_QUEUE_H
+#define STREAM_SEND_QUEUE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "i_stream.h"
+
+namespace Communication {
+namespace SoftBus {
+struct StreamSendQueueStats {
+    uint64_t sentNum = 0;
+    uint64_t failedNum = 0;
+    uint64_t supersededNum = 0; // dependent frames made useless by a newer key frame
+    uint64_t brokenNum = 0;     // dependent frames whose reference was dropped
+    uint64_t expiredNum = 0;
+    uint64_t overflowNum = 0;
+};
+
+/*
+ * Frames of one stream waiting for the transport. A sender thread of its own hands them over one
+ * by one, so a congested transport blocks that thread instead of the application. While frames
+ * wait, the queue drops what the decoder cannot use anyway: dependent frames before a newer key
+ * frame, frames referencing a dropped frame, and frames past their deadline. When the queue is
+ * full, enhancement levels go first and key frames last.
+ */
+class StreamSendQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+    using SendFunc = std::function<bool(std::unique_ptr<IStream> stream)>;
+
+    static constexpr uint32_t DEFAULT_CAPACITY = 32;
+    static constexpr int64_t DEFAULT_DEADLINE_MS = 200;
+
+    explicit StreamSendQueue(SendFunc send, uint32_t capacity = DEFAULT_CAPACITY,
+        int64_t deadlineMs = DEFAULT_DEADLINE_MS);
+    ~StreamSendQueue();
+
+    // false when the frame is dropped right away or the queue is stopped
+    bool Push(std::unique_ptr<IStream> stream);
+    // drops the queued frames and lets no new send start, a send in progress still runs to its end
+    void Quit();
+    // Quit and wait for the sender thread to exit
+    void Stop();
+    // waits until every pushed frame is sent or dropped
+    bool WaitIdle(int64_t timeoutMs);
+    void SetDeadline(int64_t deadlineMs);
+    StreamSendQueueStats GetStats();
+
+private:
+    enum FrameClass {
+        KEY_FRAME,
+        DEPENDENT_FRAME,
+        INDEPENDENT_FRAME,
+    };
+
+    struct Entry {
+        std::unique_ptr<IStream> stream;
+        FrameClass frameClass;
+        uint32_t level;
+        Clock::time_point deadline;
+    };
+
+    static FrameClass GetFrameClass(FrameType frameType);
+    bool IsBroken(const Entry &entry) const;
+    void DropDependent(std::deque<Entry>::iterator from, uint32_t level, uint64_t &counter);
+    void MakeRoom();
+    void DropExpired(Clock::time_point now);
+    void Run();
+
+    SendFunc send_;
+    uint32_t capacity_;
+    std::chrono::milliseconds deadline_;
+    std::deque<Entry> queue_;
+    // dependent frames at or above this level reference a dropped frame until the next key frame
+    uint32_t brokenLevel_ = UINT32_MAX;
+    bool isSending_ = false;
+    bool isStopped_ = false;
+    StreamSendQueueStats stats_ {};
+    std::mutex lock_;
+    std::condition_variable cv_;
+    std::condition_variable idleCv_;
+    std::thread sender_;
+};
+} // namespace SoftBus
+} // namespace Communication
+
+#endif // STREAM_SEND_QUEUE_H
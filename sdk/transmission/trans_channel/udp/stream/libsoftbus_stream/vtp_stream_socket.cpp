@@ -15,6 +15,7 @@
 
 #include "vtp_stream_socket.h"
 
+#include <algorithm>
 #include <ifaddrs.h>
 #include <thread>
 
@@ -31,6 +32,9 @@ bool g_logOn = false;
 const int FEED_BACK_PERIOD = 1;  /* feedback period of fillp stream traffic statistics is 1s */
 const int MS_PER_SECOND = 1000;
 const int US_PER_MS = 1000;
+const ssize_t FRAME_BUFFER_STEP = 16 * 1024; /* send and receive buffers grow in steps of 16KB */
+const uint32_t FRAME_BUFFER_SHRINK_WINDOW = 64; /* frames after which an oversized buffer is given back */
+const ssize_t FRAME_BUFFER_SHRINK_RATIO = 2;
 
 namespace {
 void PrintOptionInfo(int type, const StreamAttr &value)
@@ -53,6 +57,44 @@ void PrintOptionInfo(int type, const StreamAttr &value)
             (void)type;
     }
 }
+
+ssize_t RoundUpFrameBufferLen(ssize_t len)
+{
+    return (len + FRAME_BUFFER_STEP - 1) / FRAME_BUFFER_STEP * FRAME_BUFFER_STEP;
+}
+
+// grows in whole steps so frames of a slowly rising bitrate do not reallocate one after another, and shrinks back
+// once a whole window of frames fits in half of it so a single large frame does not pin its memory for the session
+char *GetFrameBuffer(FrameBuffer &buffer, ssize_t len)
+{
+    buffer.peakLen = std::max(buffer.peakLen, len);
+    if (++buffer.frameCnt >= FRAME_BUFFER_SHRINK_WINDOW) {
+        ssize_t peakLen = RoundUpFrameBufferLen(buffer.peakLen);
+        buffer.peakLen = 0;
+        buffer.frameCnt = 0;
+        if (peakLen <= buffer.len / FRAME_BUFFER_SHRINK_RATIO) {
+            buffer.data = std::make_unique<char[]>(peakLen);
+            buffer.len = peakLen;
+            TRANS_LOGI(TRANS_STREAM, "shrink frame buffer, len=%{public}zd", peakLen);
+            return buffer.data.get();
+        }
+    }
+    if (len <= buffer.len) {
+        return buffer.data.get();
+    }
+    ssize_t newLen = RoundUpFrameBufferLen(len);
+    buffer.data = std::make_unique<char[]>(newLen);
+    buffer.len = newLen;
+    TRANS_LOGI(TRANS_STREAM, "grow frame buffer, len=%{public}zd", newLen);
+    return buffer.data.get();
+}
+
+// a congested transport fails single frames, after these errors every later frame fails as well
+bool IsConnectionBroken(int sendErrno)
+{
+    return sendErrno == FILLP_EPIPE || sendErrno == FILLP_ENOTCONN || sendErrno == FILLP_ECONNRESET ||
+        sendErrno == FILLP_EBADF;
+}
 } // namespace
 std::shared_ptr<VtpInstance> VtpStreamSocket::vtpInstance_ = VtpInstance::GetVtpInstance();
 
@@ -507,6 +549,17 @@ void VtpStreamSocket::DestroyStreamSocket()
         listenFd_ = -1;
     }
 
+    // frames still queued go out before streamFd_ closes, and the sender thread is gone once it does
+    if (!sendQueue_.WaitIdle(StreamSendQueue::DEFAULT_DEADLINE_MS)) {
+        TRANS_LOGW(TRANS_STREAM, "send queue not drained, drop the remaining frames");
+    }
+    sendQueue_.Quit();
+    if (streamFd_ != -1) {
+        // wakes a send blocked on a congested transport, the fd stays valid until the sender is joined
+        (void)FtShutDown(streamFd_, SPUNGE_SHUT_WR);
+    }
+    sendQueue_.Stop();
+
     if (streamFd_ != -1) {
         RemoveStreamSocketLock(streamFd_); /* remove the socket lock from the map */
         RemoveStreamSocketListener(streamFd_); /* remove the socket listener from the map */
@@ -528,6 +581,10 @@ void VtpStreamSocket::DestroyStreamSocket()
     }
 
     QuitStreamBuffer();
+    {
+        std::lock_guard<std::mutex> sendGuard(sendBufferLock_);
+        sendBuffer_ = FrameBuffer();
+    }
     vtpInstance_->UpdateSocketStreamCount(false);
     isDestroyed_ = true;
     TRANS_LOGD(TRANS_STREAM, "ok");
@@ -576,25 +633,37 @@ bool VtpStreamSocket::Connect(const IpAndPort &remote)
     return true;
 }
 
-bool VtpStreamSocket::EncryptStreamPacket(std::unique_ptr<IStream> stream, std::unique_ptr<char[]> &data, ssize_t &len)
+char *VtpStreamSocket::GetSendBuffer(ssize_t len)
+{
+    return GetFrameBuffer(sendBuffer_, len);
+}
+
+char *VtpStreamSocket::GetRecvBuffer(ssize_t len)
+{
+    return GetFrameBuffer(recvBuffer_, len);
+}
+
+bool VtpStreamSocket::EncryptStreamPacket(std::unique_ptr<IStream> stream, char *&data, ssize_t &len)
 {
     StreamPacketizer packet(streamType_, std::move(stream));
-    auto plainData = packet.PacketizeStream();
-    if (plainData == nullptr) {
+    ssize_t packetLen = packet.CalculatePacketLen();
+    len = packetLen + GetEncryptOverhead();
+    TRANS_LOGD(TRANS_STREAM, "packetLen=%{public}zd, encryptOverhead=%{public}zd", packetLen, GetEncryptOverhead());
+    char *frame = GetSendBuffer(len + FRAME_HEADER_LEN);
+    // | frame length | iv | packet, encrypted in place | tag |
+    char *plainData = frame + FRAME_HEADER_LEN + GCM_IV_LEN;
+    if (!packet.PacketizeStream(plainData, packetLen)) {
         TRANS_LOGE(TRANS_STREAM, "PacketizeStream failed");
         return false;
     }
-    len = packet.GetPacketLen() + GetEncryptOverhead();
-    TRANS_LOGD(TRANS_STREAM, "packetLen=%{public}zd, encryptOverhead=%{public}zd",
-        packet.GetPacketLen(), GetEncryptOverhead());
-    data = std::make_unique<char[]>(len + FRAME_HEADER_LEN);
-    ssize_t encLen = Encrypt(plainData.get(), packet.GetPacketLen(), data.get() + FRAME_HEADER_LEN, len);
+    ssize_t encLen = Encrypt(plainData, packetLen, frame + FRAME_HEADER_LEN, len);
     if (encLen != len) {
         TRANS_LOGE(TRANS_STREAM, "encrypted failed, dataLen=%{public}zd, encLen=%{public}zd", len, encLen);
         return false;
     }
-    InsertBufferLength(len, FRAME_HEADER_LEN, reinterpret_cast<uint8_t *>(data.get()));
+    InsertBufferLength(len, FRAME_HEADER_LEN, reinterpret_cast<uint8_t *>(frame));
     len += FRAME_HEADER_LEN;
+    data = frame;
 
     return true;
 }
@@ -612,15 +681,28 @@ bool VtpStreamSocket::Send(std::unique_ptr<IStream> stream)
         }
     }
 
-    int32_t ret = -1;
-    std::unique_ptr<char[]> data = nullptr;
-    ssize_t len = 0;
-
     const Communication::SoftBus::StreamFrameInfo *streamFrameInfo = stream->GetStreamFrameInfo();
     if (streamFrameInfo == nullptr) {
         TRANS_LOGE(TRANS_STREAM, "streamFrameInfo is null");
         return false;
     }
+    if (streamType_ == COMMON_VIDEO_STREAM || streamType_ == COMMON_AUDIO_STREAM) {
+        // a queued frame is sent later, a failure to send it is reported by the next Send
+        int sendErrno = queuedSendErrno_.exchange(NO_SEND_ERRNO);
+        if (sendErrno != NO_SEND_ERRNO) {
+            TRANS_LOGE(TRANS_STREAM, "queued send failed, errno=%{public}d", sendErrno);
+        }
+        if (isSendBroken_.load()) {
+            TRANS_LOGE(TRANS_STREAM, "connection broken, refuse the frame");
+            return false;
+        }
+        // whole frames wait in the send queue, which drops what the peer cannot decode under congestion
+        return sendQueue_.Push(std::move(stream));
+    }
+
+    int32_t ret = -1;
+    std::unique_ptr<char[]> data = nullptr;
+    ssize_t len = 0;
     FrameInfo frameInfo;
     ConvertStreamFrameInfo2FrameInfo(&frameInfo, streamFrameInfo);
 
@@ -628,11 +710,6 @@ bool VtpStreamSocket::Send(std::unique_ptr<IStream> stream)
         data = stream->GetBuffer();
         len = stream->GetBufferLen();
 
-        ret = FtSendFrame(streamFd_, data.get(), len, 0, &frameInfo);
-    } else if (streamType_ == COMMON_VIDEO_STREAM || streamType_ == COMMON_AUDIO_STREAM) {
-        if (!EncryptStreamPacket(std::move(stream), data, len)) {
-            return false;
-        }
         ret = FtSendFrame(streamFd_, data.get(), len, 0, &frameInfo);
     }
 
@@ -645,6 +722,29 @@ bool VtpStreamSocket::Send(std::unique_ptr<IStream> stream)
     return true;
 }
 
+bool VtpStreamSocket::SendCommonFrame(std::unique_ptr<IStream> stream)
+{
+    FrameInfo frameInfo;
+    ConvertStreamFrameInfo2FrameInfo(&frameInfo, stream->GetStreamFrameInfo());
+    std::lock_guard<std::mutex> guard(sendBufferLock_);
+    char *frame = nullptr;
+    ssize_t len = 0;
+    if (!EncryptStreamPacket(std::move(stream), frame, len)) {
+        return false;
+    }
+    if (FtSendFrame(streamFd_, frame, len, 0, &frameInfo) == -1) {
+        int sendErrno = FtGetErrno();
+        TRANS_LOGE(TRANS_STREAM, "send failed, errno=%{public}d", sendErrno);
+        queuedSendErrno_.store(sendErrno);
+        if (IsConnectionBroken(sendErrno)) {
+            isSendBroken_.store(true);
+        }
+        return false;
+    }
+    TRANS_LOGD(TRANS_STREAM, "send out..., streamType=%{public}d, len=%{public}zd", streamType_, len);
+    return true;
+}
+
 bool VtpStreamSocket::SetOption(int type, const StreamAttr &value)
 {
     PrintOptionInfo(type, value);
@@ -1050,10 +1150,17 @@ int32_t VtpStreamSocket::RecvStreamLen()
 
     int32_t len = -1;
     int32_t timeout = -1;
-    auto buffer = std::make_unique<char[]>(hdrSize);
+    // only the compatible raw stream hands its header over, every other header is read on the stack
+    char frameHeader[FRAME_HEADER_LEN] = { 0 };
+    std::unique_ptr<char[]> buffer = nullptr;
+    char *header = frameHeader;
+    if (hdrSize != FRAME_HEADER_LEN) {
+        buffer = std::make_unique<char[]>(hdrSize);
+        header = buffer.get();
+    }
     if (EpollTimeout(streamFd_, timeout) == 0) {
         do {
-            len = FtRecv(streamFd_, buffer.get(), hdrSize, 0);
+            len = FtRecv(streamFd_, header, hdrSize, 0);
         } while (len <= 0 && (FtGetErrno() == EINTR || FtGetErrno() == FILLP_EAGAIN));
     }
     TRANS_LOGD(TRANS_STREAM, "recv frame header, len=%{public}d, scene=%{public}d", len, scene_);
@@ -1066,33 +1173,50 @@ int32_t VtpStreamSocket::RecvStreamLen()
     if (streamType_ == RAW_STREAM && scene_ == COMPATIBLE_SCENE) {
         std::lock_guard<std::mutex> guard(streamSocketLock_);
         if (streamReceiver_ != nullptr) {
+            if (buffer == nullptr) {
+                buffer = std::make_unique<char[]>(hdrSize);
+                if (memcpy_s(buffer.get(), hdrSize, header, hdrSize) != EOK) {
+                    TRANS_LOGE(TRANS_STREAM, "memcpy header failed");
+                    return -1;
+                }
+            }
             return streamReceiver_->OnStreamHdrReceived(std::move(buffer), hdrSize);
         }
     }
 
-    return ntohl(*reinterpret_cast<int *>(buffer.get()));
+    return ntohl(*reinterpret_cast<int *>(header));
 }
 
 bool VtpStreamSocket::ProcessCommonDataStream(std::unique_ptr<char[]> &dataBuffer,
     int32_t &dataLength, std::unique_ptr<char[]> &extBuffer, int32_t &extLen, StreamFrameInfo &info)
+{
+    auto frame = std::move(dataBuffer);
+    if (frame == nullptr) {
+        TRANS_LOGE(TRANS_STREAM, "frame is null");
+        return false;
+    }
+    return DecodeCommonFrame(frame.get(), dataLength, extBuffer, extLen, info, dataBuffer);
+}
+
+bool VtpStreamSocket::DecodeCommonFrame(char *frame, int32_t &dataLength, std::unique_ptr<char[]> &extBuffer,
+    int32_t &extLen, StreamFrameInfo &info, std::unique_ptr<char[]> &dataBuffer)
 {
     TRANS_LOGD(TRANS_STREAM, "recv common stream");
     int32_t decryptedLength = dataLength;
-    auto decryptedBuffer = std::move(dataBuffer);
-
     int32_t plainDataLength = decryptedLength - GetEncryptOverhead();
     if (plainDataLength <= 0) {
         TRANS_LOGE(TRANS_STREAM, "Decrypt failed, invalid decryptedLen=%{public}d", decryptedLength);
         return false;
     }
-    std::unique_ptr<char[]> plainData = std::make_unique<char[]>(plainDataLength);
-    ssize_t decLen = Decrypt(decryptedBuffer.get(), decryptedLength, plainData.get(), plainDataLength);
+    // | iv | cipher text, decrypted in place | tag |
+    char *plainData = frame + GCM_IV_LEN;
+    ssize_t decLen = Decrypt(frame, decryptedLength, plainData, plainDataLength);
     if (decLen != plainDataLength) {
         TRANS_LOGE(TRANS_STREAM,
             "Decrypt failed, dataLen=%{public}d, decryptedLen=%{public}zd", plainDataLength, decLen);
         return false;
     }
-    auto header = plainData.get();
+    auto header = plainData;
     StreamDepacketizer decode(streamType_);
     if (plainDataLength < static_cast<int32_t>(sizeof(CommonHeader))) {
         TRANS_LOGE(TRANS_STREAM,
@@ -1101,7 +1225,7 @@ bool VtpStreamSocket::ProcessCommonDataStream(std::unique_ptr<char[]> &dataBuffe
     }
     decode.DepacketizeHeader(header);
 
-    auto buffer = plainData.get() + sizeof(CommonHeader);
+    auto buffer = plainData + sizeof(CommonHeader);
     decode.DepacketizeBuffer(buffer, plainDataLength - sizeof(CommonHeader));
 
     extBuffer = decode.GetUserExt();
@@ -1149,12 +1273,15 @@ void VtpStreamSocket::DoStreamRecv()
         }
         TRANS_LOGD(TRANS_STREAM,
             "recv a new frame, dataLen=%{public}d, streamType=%{public}d", dataLength, streamType_);
-        dataBuffer = VtpStreamSocket::RecvStream(dataLength);
-
         if (streamType_ == COMMON_VIDEO_STREAM || streamType_ == COMMON_AUDIO_STREAM) {
-            if (!ProcessCommonDataStream(dataBuffer, dataLength, extBuffer, extLen, info)) {
+            // received and decrypted in the reused receive buffer, only the payload gets a buffer of its own
+            char *frame = GetRecvBuffer(dataLength);
+            if (!RecvStreamData(frame, dataLength) ||
+                !DecodeCommonFrame(frame, dataLength, extBuffer, extLen, info, dataBuffer)) {
                 break;
             }
+        } else {
+            dataBuffer = VtpStreamSocket::RecvStream(dataLength);
         }
 
         StreamData data = { std::move(dataBuffer), dataLength, std::move(extBuffer), extLen };
@@ -1184,6 +1311,14 @@ void VtpStreamSocket::DoStreamRecv()
 std::unique_ptr<char[]> VtpStreamSocket::RecvStream(int32_t dataLength)
 {
     auto buffer = std::make_unique<char[]>(dataLength);
+    if (!RecvStreamData(buffer.get(), dataLength)) {
+        return nullptr;
+    }
+    return buffer;
+}
+
+bool VtpStreamSocket::RecvStreamData(char *buffer, int32_t dataLength)
+{
     int32_t recvLen = 0;
     while (recvLen < dataLength) {
         int32_t ret = -1;
@@ -1191,18 +1326,18 @@ std::unique_ptr<char[]> VtpStreamSocket::RecvStream(int32_t dataLength)
 
         if (EpollTimeout(streamFd_, timeout) == 0) {
             do {
-                ret = FtRecv(streamFd_, (buffer.get() + recvLen), dataLength - recvLen, 0);
+                ret = FtRecv(streamFd_, (buffer + recvLen), dataLength - recvLen, 0);
             } while (ret < 0 && (FtGetErrno() == EINTR || FtGetErrno() == FILLP_EAGAIN));
         }
 
         if (ret == -1) {
             TRANS_LOGE(TRANS_STREAM, "read frame failed, errno=%{public}d", FtGetErrno());
-            return nullptr;
+            return false;
         }
 
         recvLen += ret;
     }
-    return std::unique_ptr<char[]>(buffer.release());
+    return true;
 }
 
 void VtpStreamSocket::SetDefaultConfig(int fd)
@@ -1513,23 +1648,27 @@ bool VtpStreamSocket::SetStreamHeaderSize(int type, const StreamAttr &value)
 
 void VtpStreamSocket::NotifyStreamListener()
 {
+    std::queue<std::unique_ptr<IStream>> streams;
     while (isStreamRecv_) {
-        int streamNum = GetStreamNum();
-        if (streamNum >= STREAM_BUFFER_THRESHOLD) {
-            TRANS_LOGW(TRANS_STREAM, "Too many data in receiver, streamNum=%{public}d", streamNum);
-        }
-
-        auto stream = TakeStream();
-        if (stream == nullptr) {
+        // every frame queued so far is delivered as one batch, a frame never waits for the ones after it
+        if (!TakeStreams(streams)) {
             TRANS_LOGE(TRANS_STREAM, "Pop stream failed");
             break;
         }
+        int streamNum = static_cast<int>(streams.size());
+        if (streamNum >= STREAM_BUFFER_THRESHOLD) {
+            TRANS_LOGW(TRANS_STREAM, "Too many data in receiver, streamNum=%{public}d", streamNum);
+        }
 
         std::lock_guard<std::mutex> guard(streamSocketLock_);
-        if (streamReceiver_ != nullptr) {
-            TRANS_LOGD(TRANS_STREAM, "notify listener");
-            streamReceiver_->OnStreamReceived(std::move(stream));
-            TRANS_LOGD(TRANS_STREAM, "notify listener done.");
+        while (!streams.empty()) {
+            auto stream = std::move(streams.front());
+            streams.pop();
+            if (streamReceiver_ != nullptr) {
+                TRANS_LOGD(TRANS_STREAM, "notify listener");
+                streamReceiver_->OnStreamReceived(std::move(stream));
+                TRANS_LOGD(TRANS_STREAM, "notify listener done.");
+            }
         }
     }
     TRANS_LOGI(TRANS_STREAM, "notify thread exit");
@@ -16,7 +16,10 @@
 #ifndef VTP_STREAM_SOCKET_H
 #define VTP_STREAM_SOCKET_H
 
+#include <atomic>
+
 #include "common_inner.h"
+#include "stream_send_queue.h"
 #include "vtp_instance.h"
 #include "vtp_stream_opt.h"
 
@@ -32,6 +35,13 @@ struct ConnectStatus {
     int status = UNCONNECTED;
 };
 
+struct FrameBuffer {
+    std::unique_ptr<char[]> data = nullptr;
+    ssize_t len = 0;
+    ssize_t peakLen = 0;    /* largest frame asked for in the current window */
+    uint32_t frameCnt = 0;  /* frames asked for in the current window */
+};
+
 class VtpStreamSocket : public std::enable_shared_from_this<VtpStreamSocket>, public IStreamSocket {
 public:
     static constexpr int FILLP_VTP_SEND_CACHE_SIZE = 500;
@@ -69,6 +79,8 @@ public:
     ssize_t Decrypt(const void *in, ssize_t inLen, void *out, ssize_t outLen) const;
 
 private:
+    static constexpr int NO_SEND_ERRNO = -1;
+
     using MySetFunc = bool (VtpStreamSocket::*)(int, const StreamAttr &);
     using MyGetFunc = StreamAttr (VtpStreamSocket::*)(int) const;
     struct OptionFunc {
@@ -92,9 +104,14 @@ private:
         { PKT_STATISTICS, FT_CONF_APP_FC_STATISTICS },
         { PKT_LOSS, FT_CONF_APP_FC_RECV_PKT_LOSS },
     };
-    bool EncryptStreamPacket(std::unique_ptr<IStream> stream, std::unique_ptr<char[]> &data, ssize_t &len);
+    char *GetSendBuffer(ssize_t len);
+    char *GetRecvBuffer(ssize_t len);
+    bool EncryptStreamPacket(std::unique_ptr<IStream> stream, char *&data, ssize_t &len);
+    bool SendCommonFrame(std::unique_ptr<IStream> stream);
     bool ProcessCommonDataStream(std::unique_ptr<char[]> &dataBuffer, int32_t &dataLength,
         std::unique_ptr<char[]> &extBuffer, int32_t &extLen, StreamFrameInfo &info);
+    bool DecodeCommonFrame(char *frame, int32_t &dataLength, std::unique_ptr<char[]> &extBuffer,
+        int32_t &extLen, StreamFrameInfo &info, std::unique_ptr<char[]> &dataBuffer);
     void InsertElementToFuncMap(int type, ValueType valueType, MySetFunc set, MyGetFunc get);
     int CreateAndBindSocket(IpAndPort &local, bool isServer) override;
     bool Accept() override;
@@ -107,6 +124,7 @@ private:
     int32_t RecvStreamLen();
     void DoStreamRecv();
     std::unique_ptr<char[]> RecvStream(int32_t dataLength) override;
+    bool RecvStreamData(char *buffer, int32_t dataLength);
 
     void SetDefaultConfig(int fd);
     bool SetIpTos(int fd, const StreamAttr &tos);
@@ -197,10 +215,23 @@ private:
     static std::shared_ptr<VtpInstance> vtpInstance_;
     std::condition_variable configCv_;
     std::mutex streamSocketLock_;
+    // common stream frames are packetized and encrypted in place here and handed to FillP from it
+    std::mutex sendBufferLock_;
+    FrameBuffer sendBuffer_;
+    // common stream frames are received and decrypted in place here, only the receive thread touches it
+    FrameBuffer recvBuffer_;
     int scene_ = UNKNOWN_SCENE;
     int streamHdrSize_ = 0;
     bool isDestroyed_ = false;
     OnFrameEvt onStreamEvtCb_ = nullptr;
+    // errno of the last failed send from the send queue, not yet reported by Send
+    std::atomic<int> queuedSendErrno_ { NO_SEND_ERRNO };
+    // the transport reported the connection gone, no later frame can be sent either
+    std::atomic<bool> isSendBroken_ { false };
+    // declared last so its sender thread stops before the members it sends through go away
+    StreamSendQueue sendQueue_ { [this](std::unique_ptr<IStream> stream) {
+        return SendCommonFrame(std::move(stream));
+    } };
 };
 } // namespace SoftBus
 } // namespace Communication
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <vector>
+
+#include "softbus_broadcast_filter_index.h"
+#include "softbus_broadcast_utils.h"
+#include "softbus_error_code.h"
+
+namespace OHOS {
+static constexpr uint16_t SOFTBUS_SERVICE_UUID = 0xFDEE;
+static constexpr uint16_t SHARE_SERVICE_UUID = 0xFE35;
+static constexpr uint16_t SOFTBUS_COMPANY_ID = 0x027D;
+static constexpr uint16_t FOREIGN_IDS[] = { 0x004C, 0x0006, 0x0075, 0xFE9F, 0xFD6F, 0x00E0 };
+static constexpr uint32_t FILTER_PER_MANAGER = 4;
+static constexpr uint32_t FILTER_DATA_LEN = 8;
+static constexpr uint32_t TRACE_LEN = 4096;
+// share of the trace which comes from softbus devices, the rest is foreign advertisements
+static constexpr uint32_t SOFTBUS_ADV_PERCENT = 20;
+static constexpr uint32_t PERCENT = 100;
+static constexpr unsigned int TRACE_SEED = 2024;
+
+struct AdvTrace {
+    std::vector<std::vector<uint8_t>> data;
+    std::vector<BroadcastPayload> payloads;
+};
+
+static uint8_t g_filterData[SCAN_NUM_MAX][FILTER_PER_MANAGER][FILTER_DATA_LEN];
+static uint8_t g_filterMask[SCAN_NUM_MAX][FILTER_PER_MANAGER][FILTER_DATA_LEN];
+static BcScanFilter g_filters[SCAN_NUM_MAX][FILTER_PER_MANAGER];
+static BcScanFilterGroup g_groups[SCAN_NUM_MAX];
+static AdvTrace g_trace;
+
+// every manager listens to the softbus service uuid with its own header, like the discovery and heartbeat scanners
+static void BuildFilters(void)
+{
+    for (uint32_t managerId = 0; managerId < SCAN_NUM_MAX; managerId++) {
+        for (uint32_t i = 0; i < FILTER_PER_MANAGER; i++) {
+            BcScanFilter *filter = &g_filters[managerId][i];
+            uint8_t *data = g_filterData[managerId][i];
+            uint8_t *mask = g_filterMask[managerId][i];
+            data[0] = (uint8_t)(managerId + 1);
+            data[1] = (uint8_t)i;
+            mask[0] = BC_BYTE_MASK;
+            mask[1] = BC_BYTE_MASK;
+            *filter = {};
+            if (i % 2 == 0) {
+                filter->serviceUuid = (i == 0) ? SOFTBUS_SERVICE_UUID : SHARE_SERVICE_UUID;
+                filter->serviceData = data;
+                filter->serviceDataMask = mask;
+                filter->serviceDataLength = FILTER_DATA_LEN;
+                filter->manufactureId = SOFTBUS_COMPANY_ID + 1;
+            } else {
+                filter->manufactureId = SOFTBUS_COMPANY_ID;
+                filter->manufactureData = data;
+                filter->manufactureDataMask = mask;
+                filter->manufactureDataLength = FILTER_DATA_LEN;
+                filter->serviceUuid = SOFTBUS_SERVICE_UUID + 1;
+            }
+        }
+        g_groups[managerId].filter = g_filters[managerId];
+        g_groups[managerId].filterSize = FILTER_PER_MANAGER;
+    }
+}
+
+static void BuildTrace(void)
+{
+    unsigned int seed = TRACE_SEED;
+    g_trace.data.assign(TRACE_LEN, std::vector<uint8_t>(BC_DATA_MAX_LEN));
+    g_trace.payloads.resize(TRACE_LEN);
+    for (uint32_t i = 0; i < TRACE_LEN; i++) {
+        std::vector<uint8_t> &data = g_trace.data[i];
+        for (uint8_t &byte : data) {
+            byte = (uint8_t)rand_r(&seed);
+        }
+        BroadcastPayload &payload = g_trace.payloads[i];
+        payload.payload = data.data();
+        payload.payloadLen = BC_DATA_MAX_LEN;
+        if ((uint32_t)rand_r(&seed) % PERCENT < SOFTBUS_ADV_PERCENT) {
+            const BcScanFilter *filter = &g_filters[rand_r(&seed) % SCAN_NUM_MAX][rand_r(&seed) % FILTER_PER_MANAGER];
+            bool isService = filter->serviceData != nullptr;
+            payload.type = isService ? BC_DATA_TYPE_SERVICE : BC_DATA_TYPE_MANUFACTURER;
+            payload.id = isService ? filter->serviceUuid : filter->manufactureId;
+            data[0] = isService ? filter->serviceData[0] : filter->manufactureData[0];
+            data[1] = isService ? filter->serviceData[1] : filter->manufactureData[1];
+        } else {
+            payload.type = (rand_r(&seed) % 2 == 0) ? BC_DATA_TYPE_SERVICE : BC_DATA_TYPE_MANUFACTURER;
+            payload.id = FOREIGN_IDS[rand_r(&seed) % (sizeof(FOREIGN_IDS) / sizeof(FOREIGN_IDS[0]))];
+        }
+    }
+}
+
+static bool IsBytesMatch(const uint8_t *filterData, const uint8_t *filterMask, uint32_t filterLen,
+    const BroadcastPayload *payload)
+{
+    if (payload->payloadLen < filterLen) {
+        return false;
+    }
+    for (uint32_t i = 0; i < filterLen; i++) {
+        if ((filterData[i] & filterMask[i]) != (payload->payload[i] & filterMask[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// the per manager filter walk the broadcast manager did before the index
+static uint32_t MatchLinear(const BroadcastPayload *payload)
+{
+    uint32_t matched = 0;
+    for (uint32_t managerId = 0; managerId < SCAN_NUM_MAX; managerId++) {
+        for (uint32_t i = 0; i < g_groups[managerId].filterSize; i++) {
+            BcScanFilter filter = g_groups[managerId].filter[i];
+            bool isMatch = (payload->type == BC_DATA_TYPE_SERVICE) ?
+                (filter.serviceUuid == payload->id &&
+                IsBytesMatch(filter.serviceData, filter.serviceDataMask, filter.serviceDataLength, payload)) :
+                (filter.manufactureId == payload->id &&
+                IsBytesMatch(filter.manufactureData, filter.manufactureDataMask, filter.manufactureDataLength, payload));
+            if (isMatch) {
+                matched |= 1U << managerId;
+                break;
+            }
+        }
+    }
+    return matched;
+}
+
+class BroadcastFilterIndexTest : public benchmark::Fixture {
+public:
+    BroadcastFilterIndexTest()
+    {
+        Iterations(iterations);
+        Repetitions(repetitions);
+        ReportAggregatesOnly();
+    }
+    ~BroadcastFilterIndexTest() override = default;
+    void SetUp(const ::benchmark::State &state) override
+    {
+        BuildFilters();
+        BuildTrace();
+        index_ = {};
+        if (BuildBcScanFilterIndex(&index_, g_groups, SCAN_NUM_MAX) != SOFTBUS_OK) {
+            index_ = {};
+        }
+    }
+    void TearDown(const ::benchmark::State &state) override
+    {
+        ReleaseBcScanFilterIndex(&index_);
+    }
+
+protected:
+    const int32_t repetitions = 3;
+    const int32_t iterations = 1000;
+    BcScanFilterIndex index_;
+};
+
+/**
+ * @tc.name: LinearMatchTestCase
+ * @tc.desc: Replay the advertisement trace against every filter of every scan manager
+ * @tc.type: PERF
+ * @tc.require: baseline of the scan result dispatch
+ */
+BENCHMARK_F(BroadcastFilterIndexTest, LinearMatchTestCase)(benchmark::State &state)
+{
+    while (state.KeepRunning()) {
+        uint32_t matched = 0;
+        for (const BroadcastPayload &payload : g_trace.payloads) {
+            matched |= MatchLinear(&payload);
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+    state.SetItemsProcessed(state.iterations() * TRACE_LEN);
+}
+BENCHMARK_REGISTER_F(BroadcastFilterIndexTest, LinearMatchTestCase);
+
+/**
+ * @tc.name: IndexMatchTestCase
+ * @tc.desc: Replay the advertisement trace against the compiled filter index
+ * @tc.type: PERF
+ * @tc.require: MatchBcScanFilterIndex reports the same managers as the linear match
+ */
+BENCHMARK_F(BroadcastFilterIndexTest, IndexMatchTestCase)(benchmark::State &state)
+{
+    if (!index_.isValid) {
+        state.SkipWithError("BuildBcScanFilterIndex failed.");
+    }
+    for (const BroadcastPayload &payload : g_trace.payloads) {
+        if (MatchBcScanFilterIndex(&index_, &payload) != MatchLinear(&payload)) {
+            state.SkipWithError("MatchBcScanFilterIndex mismatch.");
+            break;
+        }
+    }
+    while (state.KeepRunning()) {
+        uint32_t matched = 0;
+        for (const BroadcastPayload &payload : g_trace.payloads) {
+            matched |= MatchBcScanFilterIndex(&index_, &payload);
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+    state.SetItemsProcessed(state.iterations() * TRACE_LEN);
+}
+BENCHMARK_REGISTER_F(BroadcastFilterIndexTest, IndexMatchTestCase);
+
+/**
+ * @tc.name: IndexBuildTestCase
+ * @tc.desc: Rebuild the filter index as done on every filter registration
+ * @tc.type: PERF
+ * @tc.require: BuildBcScanFilterIndex normal operation
+ */
+BENCHMARK_F(BroadcastFilterIndexTest, IndexBuildTestCase)(benchmark::State &state)
+{
+    while (state.KeepRunning()) {
+        if (BuildBcScanFilterIndex(&index_, g_groups, SCAN_NUM_MAX) != SOFTBUS_OK) {
+            state.SkipWithError("BuildBcScanFilterIndex failed.");
+        }
+    }
+}
+BENCHMARK_REGISTER_F(BroadcastFilterIndexTest, IndexBuildTestCase);
+}
+
+// Run the benchmark
+BENCHMARK_MAIN();
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+#include "disc_log.h"
+#include "softbus_broadcast_filter_index.h"
+#include "softbus_error_code.h"
+
+using namespace testing::ext;
+
+#define MANUFACTURE_COMPANY_ID 0x027D
+#define SERVICE_UUID           0xFDEE
+#define OTHER_SERVICE_UUID     0xFE35
+#define FILTER_DATA_LEN        3
+#define RANDOM_FILTER_NUM      8
+#define RANDOM_PAYLOAD_NUM     2000
+#define RANDOM_DATA_MAX_LEN    8
+#define RANDOM_ID_NUM          3
+#define RANDOM_BYTES_NUM       4
+
+namespace OHOS {
+class SoftbusBroadcastFilterIndexTest : public testing::Test {
+public:
+    static void SetUpTestCase() { }
+    static void TearDownTestCase() { }
+
+    void SetUp() override
+    {
+        index_ = {};
+    }
+
+    void TearDown() override
+    {
+        ReleaseBcScanFilterIndex(&index_);
+    }
+
+    BcScanFilterIndex index_;
+};
+
+static BcScanFilter BuildServiceFilter(uint16_t uuid, uint8_t *data, uint8_t *mask, uint32_t len)
+{
+    BcScanFilter filter = {};
+    filter.serviceUuid = uuid;
+    filter.serviceData = data;
+    filter.serviceDataMask = mask;
+    filter.serviceDataLength = len;
+    // a pure service filter, keep the manufacturer side impossible to satisfy
+    filter.manufactureId = MANUFACTURE_COMPANY_ID + 1;
+    return filter;
+}
+
+static BroadcastPayload BuildPayload(BroadcastDataType type, uint16_t id, uint8_t *data, uint16_t len)
+{
+    BroadcastPayload payload = {};
+    payload.type = type;
+    payload.id = id;
+    payload.payload = data;
+    payload.payloadLen = len;
+    return payload;
+}
+
+static bool IsBytesMatch(const uint8_t *filterData, const uint8_t *filterMask, uint32_t filterLen,
+    const BroadcastPayload *payload)
+{
+    if (payload->payloadLen < filterLen) {
+        return false;
+    }
+    for (uint32_t i = 0; i < filterLen; i++) {
+        if ((filterData[i] & filterMask[i]) != (payload->payload[i] & filterMask[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// the linear match done by the broadcast manager before the index existed
+static uint32_t MatchLinear(const BcScanFilterGroup *groups, uint32_t groupNum, const BroadcastPayload *payload)
+{
+    uint32_t matched = 0;
+    for (uint32_t groupId = 0; groupId < groupNum; groupId++) {
+        for (uint8_t i = 0; i < groups[groupId].filterSize; i++) {
+            const BcScanFilter *filter = &groups[groupId].filter[i];
+            bool isMatch = (payload->type == BC_DATA_TYPE_SERVICE) ?
+                (filter->serviceUuid == payload->id &&
+                IsBytesMatch(filter->serviceData, filter->serviceDataMask, filter->serviceDataLength, payload)) :
+                (filter->manufactureId == payload->id && IsBytesMatch(filter->manufactureData,
+                filter->manufactureDataMask, filter->manufactureDataLength, payload));
+            if (isMatch) {
+                matched |= 1U << groupId;
+                break;
+            }
+        }
+    }
+    return matched;
+}
+
+/*
+ * @tc.name: SoftbusBroadcastFilterIndexMatch001
+ * @tc.desc: Service filter matches by uuid, masked prefix and payload length.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SoftbusBroadcastFilterIndexTest, SoftbusBroadcastFilterIndexMatch001, TestSize.Level1)
+{
+    DISC_LOGI(DISC_TEST, "SoftbusBroadcastFilterIndexMatch001 begin ----");
+    uint8_t data[FILTER_DATA_LEN] = { 0x04, 0x05, 0x90 };
+    uint8_t mask[FILTER_DATA_LEN] = { 0xFF, 0xFF, 0xF0 };
+    BcScanFilter filter = BuildServiceFilter(SERVICE_UUID, data, mask, FILTER_DATA_LEN);
+    BcScanFilterGroup groups[] = { { nullptr, 0 }, { &filter, 1 } };
+    EXPECT_EQ(SOFTBUS_OK, BuildBcScanFilterIndex(&index_, groups, sizeof(groups) / sizeof(groups[0])));
+    EXPECT_TRUE(index_.isValid);
+
+    uint8_t bytes[] = { 0x04, 0x05, 0x9A, 0x11 };
+    BroadcastPayload payload = BuildPayload(BC_DATA_TYPE_SERVICE, SERVICE_UUID, bytes, sizeof(bytes));
+    EXPECT_EQ(1U << 1, MatchBcScanFilterIndex(&index_, &payload));
+
+    payload.payloadLen = FILTER_DATA_LEN - 1;
+    EXPECT_EQ(0U, MatchBcScanFilterIndex(&index_, &payload));
+
+    payload = BuildPayload(BC_DATA_TYPE_SERVICE, OTHER_SERVICE_UUID, bytes, sizeof(bytes));
+    EXPECT_EQ(0U, MatchBcScanFilterIndex(&index_, &payload));
+
+    payload = BuildPayload(BC_DATA_TYPE_MANUFACTURER, SERVICE_UUID, bytes, sizeof(bytes));
+    EXPECT_EQ(0U, MatchBcScanFilterIndex(&index_, &payload));
+
+    bytes[1] = 0x06;
+    payload = BuildPayload(BC_DATA_TYPE_SERVICE, SERVICE_UUID, bytes, sizeof(bytes));
+    EXPECT_EQ(0U, MatchBcScanFilterIndex(&index_, &payload));
+    DISC_LOGI(DISC_TEST, "SoftbusBroadcastFilterIndexMatch001 end ----");
+}
+
+/*
+ * @tc.name: SoftbusBroadcastFilterIndexMatch002
+ * @tc.desc: The same filter registered by several groups is reported for all of them.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SoftbusBroadcastFilterIndexTest, SoftbusBroadcastFilterIndexMatch002, TestSize.Level1)
+{
+    DISC_LOGI(DISC_TEST, "SoftbusBroadcastFilterIndexMatch002 begin ----");
+    uint8_t data[FILTER_DATA_LEN] = { 0x04, 0x05, 0x90 };
+    uint8_t mask[FILTER_DATA_LEN] = { 0xFF, 0x00, 0x00 };
+    BcScanFilter left = BuildServiceFilter(SERVICE_UUID, data, mask, FILTER_DATA_LEN);
+    BcScanFilter right = BuildServiceFilter(SERVICE_UUID, data, mask, FILTER_DATA_LEN);
+    BcScanFilter manufacture = {};
+    manufacture.manufactureId = MANUFACTURE_COMPANY_ID;
+    manufacture.serviceUuid = OTHER_SERVICE_UUID;
+    manufacture.serviceDataLength = RANDOM_DATA_MAX_LEN * RANDOM_DATA_MAX_LEN;
+    BcScanFilterGroup groups[] = { { &left, 1 }, { &manufacture, 1 }, { &right, 1 } };
+    EXPECT_EQ(SOFTBUS_OK, BuildBcScanFilterIndex(&index_, groups, sizeof(groups) / sizeof(groups[0])));
+    // left and right share one service entry, the oversized service filter is dropped
+    EXPECT_EQ(3U, index_.entryNum);
+
+    uint8_t bytes[FILTER_DATA_LEN] = { 0x04 };
+    BroadcastPayload payload = BuildPayload(BC_DATA_TYPE_SERVICE, SERVICE_UUID, bytes, sizeof(bytes));
+    EXPECT_EQ((1U << 0) | (1U << 2), MatchBcScanFilterIndex(&index_, &payload));
+
+    payload = BuildPayload(BC_DATA_TYPE_MANUFACTURER, MANUFACTURE_COMPANY_ID, bytes, 0);
+    EXPECT_EQ(1U << 1, MatchBcScanFilterIndex(&index_, &payload));
+
+    payload = BuildPayload(BC_DATA_TYPE_SERVICE, OTHER_SERVICE_UUID, bytes, sizeof(bytes));
+    EXPECT_EQ(0U, MatchBcScanFilterIndex(&index_, &payload));
+    DISC_LOGI(DISC_TEST, "SoftbusBroadcastFilterIndexMatch002 end ----");
+}
+
+/*
+ * @tc.name: SoftbusBroadcastFilterIndexMatch003
+ * @tc.desc: Random filters and payloads are matched exactly like the linear match.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SoftbusBroadcastFilterIndexTest, SoftbusBroadcastFilterIndexMatch003, TestSize.Level1)
+{
+    DISC_LOGI(DISC_TEST, "SoftbusBroadcastFilterIndexMatch003 begin ----");
+    const uint16_t ids[RANDOM_ID_NUM] = { SERVICE_UUID, OTHER_SERVICE_UUID, MANUFACTURE_COMPANY_ID };
+    uint8_t bytes[RANDOM_FILTER_NUM][RANDOM_BYTES_NUM][RANDOM_DATA_MAX_LEN] = {};
+    BcScanFilter filters[RANDOM_FILTER_NUM] = {};
+    unsigned int seed = 1;
+    for (uint32_t i = 0; i < RANDOM_FILTER_NUM; i++) {
+        for (uint32_t j = 0; j < RANDOM_DATA_MAX_LEN; j++) {
+            bytes[i][0][j] = (uint8_t)rand_r(&seed);
+            bytes[i][1][j] = (rand_r(&seed) % 2 == 0) ? 0xFF : 0xF0;
+            bytes[i][2][j] = (uint8_t)rand_r(&seed);
+            bytes[i][3][j] = (rand_r(&seed) % 2 == 0) ? 0x0F : 0x00;
+        }
+        filters[i].serviceUuid = ids[rand_r(&seed) % RANDOM_ID_NUM];
+        filters[i].serviceData = bytes[i][0];
+        filters[i].serviceDataMask = bytes[i][1];
+        filters[i].serviceDataLength = rand_r(&seed) % 3;
+        filters[i].manufactureId = ids[rand_r(&seed) % RANDOM_ID_NUM];
+        filters[i].manufactureData = bytes[i][2];
+        filters[i].manufactureDataMask = bytes[i][3];
+        filters[i].manufactureDataLength = rand_r(&seed) % RANDOM_DATA_MAX_LEN;
+    }
+    BcScanFilterGroup groups[] = { { &filters[0], 3 }, { &filters[3], 1 }, { &filters[4], 4 } };
+    uint32_t groupNum = sizeof(groups) / sizeof(groups[0]);
+    EXPECT_EQ(SOFTBUS_OK, BuildBcScanFilterIndex(&index_, groups, groupNum));
+
+    for (uint32_t i = 0; i < RANDOM_PAYLOAD_NUM; i++) {
+        uint8_t data[RANDOM_DATA_MAX_LEN] = {};
+        const BcScanFilter *filter = &filters[rand_r(&seed) % RANDOM_FILTER_NUM];
+        bool isService = rand_r(&seed) % 2 == 0;
+        for (uint32_t j = 0; j < RANDOM_DATA_MAX_LEN; j++) {
+            // mostly start from a filter so that the matching branch is exercised too
+            data[j] = isService ? filter->serviceData[j] : filter->manufactureData[j];
+            data[j] ^= (rand_r(&seed) % 4 == 0) ? (uint8_t)rand_r(&seed) : 0;
+        }
+        BroadcastPayload payload = BuildPayload(isService ? BC_DATA_TYPE_SERVICE : BC_DATA_TYPE_MANUFACTURER,
+            ids[rand_r(&seed) % RANDOM_ID_NUM], data, rand_r(&seed) % (RANDOM_DATA_MAX_LEN + 1));
+        EXPECT_EQ(MatchLinear(groups, groupNum, &payload), MatchBcScanFilterIndex(&index_, &payload));
+    }
+    DISC_LOGI(DISC_TEST, "SoftbusBroadcastFilterIndexMatch003 end ----");
+}
+
+/*
+ * @tc.name: SoftbusBroadcastFilterIndexBuild001
+ * @tc.desc: Rebuilding the index drops the filters of the previous build, bad params leave it invalid.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SoftbusBroadcastFilterIndexTest, SoftbusBroadcastFilterIndexBuild001, TestSize.Level1)
+{
+    DISC_LOGI(DISC_TEST, "SoftbusBroadcastFilterIndexBuild001 begin ----");
+    uint8_t data[FILTER_DATA_LEN] = { 0x04, 0x05, 0x90 };
+    uint8_t mask[FILTER_DATA_LEN] = { 0xFF, 0xFF, 0xFF };
+    BcScanFilter filter = BuildServiceFilter(SERVICE_UUID, data, mask, FILTER_DATA_LEN);
+    BcScanFilterGroup groups[] = { { &filter, 1 } };
+    EXPECT_EQ(SOFTBUS_OK, BuildBcScanFilterIndex(&index_, groups, 1));
+    BroadcastPayload payload = BuildPayload(BC_DATA_TYPE_SERVICE, SERVICE_UUID, data, sizeof(data));
+    EXPECT_EQ(1U, MatchBcScanFilterIndex(&index_, &payload));
+
+    groups[0].filterSize = 0;
+    EXPECT_EQ(SOFTBUS_OK, BuildBcScanFilterIndex(&index_, groups, 1));
+    EXPECT_TRUE(index_.isValid);
+    EXPECT_EQ(0U, MatchBcScanFilterIndex(&index_, &payload));
+
+    EXPECT_EQ(SOFTBUS_INVALID_PARAM, BuildBcScanFilterIndex(&index_, groups, BC_FILTER_INDEX_GROUP_MAX + 1));
+    EXPECT_FALSE(index_.isValid);
+    EXPECT_EQ(SOFTBUS_INVALID_PARAM, BuildBcScanFilterIndex(nullptr, groups, 1));
+    EXPECT_EQ(0U, MatchBcScanFilterIndex(nullptr, &payload));
+    DISC_LOGI(DISC_TEST, "SoftbusBroadcastFilterIndexBuild001 end ----");
+}
+} // namespace OHOS
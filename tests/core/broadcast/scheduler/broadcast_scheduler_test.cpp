@@ -0,0 +1,552 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <securec.h>
+
+#include "broadcast_scheduler.c"
+#include "softbus_error_code.h"
+
+namespace OHOS {
+using namespace testing::ext;
+
+constexpr uint32_t HW_SLOT_NUM = 2;
+constexpr uint64_t START_TIME_MS = 10000;
+constexpr uint64_t SIMULATE_TIME_MS = 20000;
+constexpr uint64_t STEP_TIME_MS = 50;
+constexpr uint8_t PAYLOAD_LEN = 4;
+constexpr uint16_t PAYLOAD_ID = 0xFDEE;
+
+/* fake broadcast manager owning HW_SLOT_NUM advertising sets, driven by a virtual clock */
+struct FakeBroadcastMgr {
+    const BroadcastCallback *cb[BC_NUM_MAX];
+    bool onAir[BC_NUM_MAX];
+    uint8_t payloadTag[BC_NUM_MAX];
+    uint32_t startCnt;
+    uint32_t stopCnt;
+    int32_t nextBcId;
+};
+
+struct ServiceRecord {
+    uint32_t startCbCnt;
+    uint32_t stopCbCnt;
+    uint32_t updateCbCnt;
+    uint32_t setDataCbCnt;
+    uint32_t setParamCbCnt;
+    uint32_t lockedCbCnt;
+};
+
+static FakeBroadcastMgr g_fakeMgr;
+static ServiceRecord g_srvRecord[BC_NUM_MAX];
+static uint64_t g_virtualNow = START_TIME_MS;
+static uint64_t g_nextFire = 0;
+
+static uint32_t FakeOnAirNum()
+{
+    uint32_t num = 0;
+    for (int32_t i = 0; i < BC_NUM_MAX; ++i) {
+        num += g_fakeMgr.onAir[i] ? 1 : 0;
+    }
+    return num;
+}
+
+extern "C" {
+int32_t InitBroadcastMgr(void)
+{
+    return SOFTBUS_OK;
+}
+
+int32_t DeInitBroadcastMgr(void)
+{
+    return SOFTBUS_OK;
+}
+
+int32_t RegisterBroadcaster(BaseServiceType type, int32_t *bcId, const BroadcastCallback *cb)
+{
+    (void)type;
+    *bcId = g_fakeMgr.nextBcId++;
+    g_fakeMgr.cb[*bcId] = cb;
+    return SOFTBUS_OK;
+}
+
+int32_t UnRegisterBroadcaster(int32_t bcId)
+{
+    g_fakeMgr.cb[bcId] = nullptr;
+    g_fakeMgr.onAir[bcId] = false;
+    return SOFTBUS_OK;
+}
+
+int32_t StartBroadcasting(int32_t bcId, const BroadcastParam *param, const BroadcastPacket *packet)
+{
+    (void)param;
+    if (!g_fakeMgr.onAir[bcId] && FakeOnAirNum() >= HW_SLOT_NUM) {
+        g_fakeMgr.cb[bcId]->OnStartBroadcastingCallback(bcId, (int32_t)SOFTBUS_BC_STATUS_FAIL);
+        return SOFTBUS_BC_ADAPTER_START_ADV_FAIL;
+    }
+    g_fakeMgr.onAir[bcId] = true;
+    g_fakeMgr.payloadTag[bcId] = packet->bcData.payload[0];
+    g_fakeMgr.startCnt++;
+    g_fakeMgr.cb[bcId]->OnStartBroadcastingCallback(bcId, (int32_t)SOFTBUS_BC_STATUS_SUCCESS);
+    return SOFTBUS_OK;
+}
+
+int32_t UpdateBroadcasting(int32_t bcId, const BroadcastParam *param, const BroadcastPacket *packet)
+{
+    (void)param;
+    g_fakeMgr.payloadTag[bcId] = packet->bcData.payload[0];
+    return SOFTBUS_OK;
+}
+
+int32_t SetBroadcastingData(int32_t bcId, const BroadcastPacket *packet)
+{
+    g_fakeMgr.payloadTag[bcId] = packet->bcData.payload[0];
+    return SOFTBUS_OK;
+}
+
+int32_t SetBroadcastingParam(int32_t bcId, const BroadcastParam *param)
+{
+    (void)bcId;
+    (void)param;
+    return SOFTBUS_OK;
+}
+
+int32_t StopBroadcasting(int32_t bcId)
+{
+    if (!g_fakeMgr.onAir[bcId]) {
+        return SOFTBUS_BC_MGR_NOT_BROADCASTING;
+    }
+    g_fakeMgr.onAir[bcId] = false;
+    g_fakeMgr.stopCnt++;
+    g_fakeMgr.cb[bcId]->OnStopBroadcastingCallback(bcId, (int32_t)SOFTBUS_BC_STATUS_SUCCESS);
+    return SOFTBUS_OK;
+}
+
+int32_t RegisterScanListener(BaseServiceType type, int32_t *listenerId, const ScanCallback *cb)
+{
+    (void)type;
+    (void)listenerId;
+    (void)cb;
+    return SOFTBUS_OK;
+}
+
+int32_t UnRegisterScanListener(int32_t listenerId)
+{
+    (void)listenerId;
+    return SOFTBUS_OK;
+}
+
+int32_t StartScan(int32_t listenerId, const BcScanParams *param)
+{
+    (void)listenerId;
+    (void)param;
+    return SOFTBUS_OK;
+}
+
+int32_t StopScan(int32_t listenerId)
+{
+    (void)listenerId;
+    return SOFTBUS_OK;
+}
+
+int32_t SetScanFilter(int32_t listenerId, const BcScanFilter *scanFilter, uint8_t filterNum)
+{
+    (void)listenerId;
+    (void)scanFilter;
+    (void)filterNum;
+    return SOFTBUS_OK;
+}
+
+int32_t GetScanFilter(int32_t listenerId, BcScanFilter **scanFilter, uint8_t *filterNum)
+{
+    (void)listenerId;
+    (void)scanFilter;
+    (void)filterNum;
+    return SOFTBUS_OK;
+}
+
+int32_t QueryBroadcastStatus(int32_t bcId, int32_t *status)
+{
+    (void)bcId;
+    (void)status;
+    return SOFTBUS_OK;
+}
+
+bool BroadcastIsLpDeviceAvailable(void)
+{
+    return false;
+}
+
+bool BroadcastSetAdvDeviceParam(LpServerType type, const LpBroadcastParam *bcParam, const LpScanParam *scanParam)
+{
+    (void)type;
+    (void)bcParam;
+    (void)scanParam;
+    return false;
+}
+
+int32_t BroadcastGetBroadcastHandle(int32_t bcId, int32_t *bcHandle)
+{
+    (void)bcId;
+    (void)bcHandle;
+    return SOFTBUS_OK;
+}
+
+int32_t BroadcastEnableSyncDataToLpDevice(void)
+{
+    return SOFTBUS_OK;
+}
+
+int32_t BroadcastDisableSyncDataToLpDevice(void)
+{
+    return SOFTBUS_OK;
+}
+
+int32_t BroadcastSetScanReportChannelToLpDevice(int32_t listenerId, bool enable)
+{
+    (void)listenerId;
+    (void)enable;
+    return SOFTBUS_OK;
+}
+
+int32_t BroadcastSetLpAdvParam(int32_t duration, int32_t maxExtAdvEvents, int32_t window, int32_t interval,
+    int32_t bcHandle)
+{
+    (void)duration;
+    (void)maxExtAdvEvents;
+    (void)window;
+    (void)interval;
+    (void)bcHandle;
+    return SOFTBUS_OK;
+}
+}
+
+static uint64_t VirtualGetTime(void)
+{
+    return g_virtualNow;
+}
+
+static void VirtualArmTimer(uint64_t delayMs)
+{
+    g_nextFire = g_virtualNow + delayMs;
+}
+
+static void OnServiceStart(int32_t bcId, int32_t status)
+{
+    if (status == (int32_t)SOFTBUS_BC_STATUS_SUCCESS) {
+        g_srvRecord[bcId].startCbCnt++;
+    }
+}
+
+static void OnServiceStop(int32_t bcId, int32_t status)
+{
+    if (status == (int32_t)SOFTBUS_BC_STATUS_SUCCESS) {
+        g_srvRecord[bcId].stopCbCnt++;
+    }
+}
+
+static BroadcastCallback g_serviceCb = {
+    .OnStartBroadcastingCallback = OnServiceStart,
+    .OnStopBroadcastingCallback = OnServiceStop,
+};
+
+/* the fake manager calls back synchronously, so only callbacks the scheduler raises itself are probed */
+static bool IsOpLockHeld(void)
+{
+    pthread_mutex_t *mutex = reinterpret_cast<pthread_mutex_t *>(g_schedOpLock);
+    if (pthread_mutex_trylock(mutex) != 0) {
+        return true;
+    }
+    (void)pthread_mutex_unlock(mutex);
+    return false;
+}
+
+static void ProbeLock(int32_t bcId)
+{
+    if (IsOpLockHeld()) {
+        g_srvRecord[bcId].lockedCbCnt++;
+    }
+}
+
+static void OnProbedStart(int32_t bcId, int32_t status)
+{
+    ProbeLock(bcId);
+    OnServiceStart(bcId, status);
+}
+
+static void OnProbedStop(int32_t bcId, int32_t status)
+{
+    ProbeLock(bcId);
+    OnServiceStop(bcId, status);
+}
+
+static void OnProbedUpdate(int32_t bcId, int32_t status)
+{
+    (void)status;
+    ProbeLock(bcId);
+    g_srvRecord[bcId].updateCbCnt++;
+}
+
+static void OnProbedSetData(int32_t bcId, int32_t status)
+{
+    (void)status;
+    ProbeLock(bcId);
+    g_srvRecord[bcId].setDataCbCnt++;
+}
+
+static void OnProbedSetParam(int32_t bcId, int32_t status)
+{
+    (void)status;
+    ProbeLock(bcId);
+    g_srvRecord[bcId].setParamCbCnt++;
+}
+
+static BroadcastCallback g_probedCb = {
+    .OnStartBroadcastingCallback = OnProbedStart,
+    .OnStopBroadcastingCallback = OnProbedStop,
+    .OnUpdateBroadcastingCallback = OnProbedUpdate,
+    .OnSetBroadcastingCallback = OnProbedSetData,
+    .OnSetBroadcastingParamCallback = OnProbedSetParam,
+};
+
+class BroadcastSchedulerTest : public testing::Test {
+public:
+    static void SetUpTestCase() { }
+    static void TearDownTestCase() { }
+    void SetUp() override;
+    void TearDown() override;
+
+    int32_t StartService(BaseServiceType type, uint8_t tag, const BroadcastCallback *cb = &g_serviceCb);
+    static void AdvanceTo(uint64_t target);
+    static bool IsOnAir(int32_t bcId)
+    {
+        return g_fakeMgr.onAir[bcId];
+    }
+
+    uint8_t payload_[BC_NUM_MAX][PAYLOAD_LEN];
+    BroadcastParam param_;
+};
+
+void BroadcastSchedulerTest::SetUp()
+{
+    (void)memset_s(&g_fakeMgr, sizeof(g_fakeMgr), 0, sizeof(g_fakeMgr));
+    (void)memset_s(g_srvRecord, sizeof(g_srvRecord), 0, sizeof(g_srvRecord));
+    (void)memset_s(&param_, sizeof(param_), 0, sizeof(param_));
+    g_virtualNow = START_TIME_MS;
+    g_nextFire = 0;
+    g_schedClock.getTime = VirtualGetTime;
+    g_schedClock.armTimer = VirtualArmTimer;
+    g_schedSlotNum = HW_SLOT_NUM;
+    ASSERT_EQ(SchedulerInitBroadcast(), SOFTBUS_OK);
+}
+
+void BroadcastSchedulerTest::TearDown()
+{
+    EXPECT_EQ(SchedulerDeinitBroadcast(), SOFTBUS_OK);
+}
+
+int32_t BroadcastSchedulerTest::StartService(BaseServiceType type, uint8_t tag, const BroadcastCallback *cb)
+{
+    int32_t bcId = -1;
+    EXPECT_EQ(SchedulerRegisterBroadcaster(type, &bcId, cb), SOFTBUS_OK);
+    (void)memset_s(payload_[bcId], PAYLOAD_LEN, tag, PAYLOAD_LEN);
+    BroadcastPacket packet = {
+        .bcData = { .id = PAYLOAD_ID, .payloadLen = PAYLOAD_LEN, .type = BC_DATA_TYPE_SERVICE,
+            .payload = payload_[bcId] },
+    };
+    EXPECT_EQ(SchedulerStartBroadcast(bcId, BC_TYPE_DISTRIB_NON, &param_, &packet), SOFTBUS_OK);
+    return bcId;
+}
+
+void BroadcastSchedulerTest::AdvanceTo(uint64_t target)
+{
+    while (g_nextFire != 0 && g_nextFire <= target) {
+        g_virtualNow = g_nextFire;
+        g_nextFire = 0;
+        SchedulerRotate();
+    }
+    g_virtualNow = target;
+}
+
+/*
+ * @tc.name: SchedulerPassThroughTest001
+ * @tc.desc: advertisements within the hardware capacity start at once and arm no rotation
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(BroadcastSchedulerTest, SchedulerPassThroughTest001, TestSize.Level1)
+{
+    int32_t first = StartService(SRV_TYPE_DIS, 1);
+    int32_t second = StartService(SRV_TYPE_SHARE, 2);
+    EXPECT_TRUE(IsOnAir(first));
+    EXPECT_TRUE(IsOnAir(second));
+    EXPECT_EQ(g_srvRecord[first].startCbCnt, 1U);
+    EXPECT_EQ(g_srvRecord[second].startCbCnt, 1U);
+    EXPECT_EQ(g_nextFire, 0U);
+
+    EXPECT_EQ(SchedulerStopBroadcast(first), SOFTBUS_OK);
+    EXPECT_FALSE(IsOnAir(first));
+    EXPECT_EQ(g_srvRecord[first].stopCbCnt, 1U);
+}
+
+/*
+ * @tc.name: SchedulerRotateTest001
+ * @tc.desc: more advertisements than hardware sets rotate and each meets its latency target
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(BroadcastSchedulerTest, SchedulerRotateTest001, TestSize.Level1)
+{
+    int32_t ids[] = { StartService(SRV_TYPE_DIS, 1), StartService(SRV_TYPE_DIS, 2), StartService(SRV_TYPE_DIS, 3) };
+    EXPECT_FALSE(IsOnAir(ids[2]));
+    EXPECT_EQ(g_srvRecord[ids[2]].startCbCnt, 0U);
+    EXPECT_NE(g_nextFire, 0U);
+
+    uint64_t lastOnAir[BC_NUM_MAX] = { 0 };
+    uint64_t maxOffAir = 0;
+    for (int32_t id : ids) {
+        lastOnAir[id] = g_virtualNow;
+    }
+    for (uint64_t t = START_TIME_MS; t <= START_TIME_MS + SIMULATE_TIME_MS; t += STEP_TIME_MS) {
+        AdvanceTo(t);
+        EXPECT_LE(FakeOnAirNum(), HW_SLOT_NUM);
+        for (int32_t id : ids) {
+            if (IsOnAir(id)) {
+                lastOnAir[id] = t;
+            }
+            maxOffAir = (t - lastOnAir[id] > maxOffAir) ? t - lastOnAir[id] : maxOffAir;
+        }
+    }
+    EXPECT_LE(maxOffAir, GetSrvPolicy(SRV_TYPE_DIS)->latencyMs + STEP_TIME_MS);
+    for (int32_t id : ids) {
+        EXPECT_EQ(g_srvRecord[id].startCbCnt, 1U);
+        EXPECT_EQ(g_srvRecord[id].stopCbCnt, 0U);
+    }
+    EXPECT_GT(g_fakeMgr.stopCnt, 0U);
+}
+
+/*
+ * @tc.name: SchedulerPriorityTest001
+ * @tc.desc: heartbeat takes a set after the dwell time and keeps it against discovery
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(BroadcastSchedulerTest, SchedulerPriorityTest001, TestSize.Level1)
+{
+    int32_t dis1 = StartService(SRV_TYPE_DIS, 1);
+    int32_t dis2 = StartService(SRV_TYPE_DIS, 2);
+    int32_t hb = StartService(SRV_TYPE_HB, 3);
+    EXPECT_FALSE(IsOnAir(hb));
+    AdvanceTo(START_TIME_MS + GetSrvPolicy(SRV_TYPE_DIS)->dwellMs);
+    EXPECT_TRUE(IsOnAir(hb));
+    EXPECT_TRUE(IsOnAir(dis1) != IsOnAir(dis2));
+    for (uint64_t t = g_virtualNow; t <= START_TIME_MS + SIMULATE_TIME_MS; t += STEP_TIME_MS) {
+        AdvanceTo(t);
+        EXPECT_TRUE(IsOnAir(hb));
+    }
+}
+
+/*
+ * @tc.name: SchedulerMergeTest001
+ * @tc.desc: identical advertisements share one hardware set
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(BroadcastSchedulerTest, SchedulerMergeTest001, TestSize.Level1)
+{
+    int32_t host = StartService(SRV_TYPE_DIS, 1);
+    int32_t guest = StartService(SRV_TYPE_SHARE, 1);
+    EXPECT_TRUE(IsOnAir(host));
+    EXPECT_FALSE(IsOnAir(guest));
+    EXPECT_EQ(g_fakeMgr.startCnt, 1U);
+    EXPECT_EQ(g_srvRecord[guest].startCbCnt, 1U);
+
+    int32_t other = StartService(SRV_TYPE_DIS, 2);
+    EXPECT_TRUE(IsOnAir(other));
+    EXPECT_EQ(g_nextFire, 0U);
+
+    EXPECT_EQ(SchedulerStopBroadcast(host), SOFTBUS_OK);
+    EXPECT_TRUE(IsOnAir(guest));
+    EXPECT_EQ(g_srvRecord[guest].startCbCnt, 1U);
+    EXPECT_EQ(g_srvRecord[host].stopCbCnt, 1U);
+}
+
+/*
+ * @tc.name: SchedulerDeferredTest001
+ * @tc.desc: a waiting advertisement is stopped and updated without touching the hardware
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(BroadcastSchedulerTest, SchedulerDeferredTest001, TestSize.Level1)
+{
+    (void)StartService(SRV_TYPE_DIS, 1);
+    (void)StartService(SRV_TYPE_DIS, 2);
+    int32_t waiting = StartService(SRV_TYPE_DIS, 3);
+    EXPECT_FALSE(IsOnAir(waiting));
+
+    uint8_t newPayload[PAYLOAD_LEN] = { 9, 9, 9, 9 };
+    BroadcastPacket packet = {
+        .bcData = { .id = PAYLOAD_ID, .payloadLen = PAYLOAD_LEN, .type = BC_DATA_TYPE_SERVICE,
+            .payload = newPayload },
+    };
+    EXPECT_EQ(SchedulerSetBroadcastData(waiting, &packet), SOFTBUS_OK);
+    AdvanceTo(START_TIME_MS + GetSrvPolicy(SRV_TYPE_DIS)->dwellMs);
+    EXPECT_TRUE(IsOnAir(waiting));
+    EXPECT_EQ(g_fakeMgr.payloadTag[waiting], newPayload[0]);
+
+    int32_t late = StartService(SRV_TYPE_DIS, 4);
+    EXPECT_FALSE(IsOnAir(late));
+    uint32_t stopCnt = g_fakeMgr.stopCnt;
+    EXPECT_EQ(SchedulerStopBroadcast(late), SOFTBUS_OK);
+    EXPECT_EQ(g_fakeMgr.stopCnt, stopCnt);
+    EXPECT_EQ(g_srvRecord[late].stopCbCnt, 1U);
+}
+
+/*
+ * @tc.name: SchedulerCallbackTest001
+ * @tc.desc: callbacks raised by the scheduler itself run without the op lock and cover waiting advertisements
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(BroadcastSchedulerTest, SchedulerCallbackTest001, TestSize.Level1)
+{
+    (void)StartService(SRV_TYPE_DIS, 1);
+    int32_t guest = StartService(SRV_TYPE_SHARE, 1, &g_probedCb);
+    EXPECT_FALSE(IsOnAir(guest));
+    EXPECT_EQ(g_srvRecord[guest].startCbCnt, 1U);
+
+    (void)StartService(SRV_TYPE_DIS, 2);
+    int32_t waiting = StartService(SRV_TYPE_DIS, 3, &g_probedCb);
+    EXPECT_FALSE(IsOnAir(waiting));
+
+    uint8_t newPayload[PAYLOAD_LEN] = { 9, 9, 9, 9 };
+    BroadcastPacket packet = {
+        .bcData = { .id = PAYLOAD_ID, .payloadLen = PAYLOAD_LEN, .type = BC_DATA_TYPE_SERVICE,
+            .payload = newPayload },
+    };
+    EXPECT_EQ(SchedulerSetBroadcastData(waiting, &packet), SOFTBUS_OK);
+    EXPECT_EQ(SchedulerSetBroadcastParam(waiting, &param_), SOFTBUS_OK);
+    EXPECT_EQ(SchedulerUpdateBroadcast(waiting, &param_, &packet), SOFTBUS_OK);
+    EXPECT_FALSE(IsOnAir(waiting));
+    EXPECT_EQ(g_srvRecord[waiting].setDataCbCnt, 1U);
+    EXPECT_EQ(g_srvRecord[waiting].setParamCbCnt, 1U);
+    EXPECT_EQ(g_srvRecord[waiting].updateCbCnt, 1U);
+
+    EXPECT_EQ(SchedulerStopBroadcast(waiting), SOFTBUS_OK);
+    EXPECT_EQ(g_srvRecord[waiting].stopCbCnt, 1U);
+    EXPECT_EQ(g_srvRecord[guest].lockedCbCnt, 0U);
+    EXPECT_EQ(g_srvRecord[waiting].lockedCbCnt, 0U);
+}
+} // namespace OHOS
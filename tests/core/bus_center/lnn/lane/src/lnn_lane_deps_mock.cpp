@@ -402,9 +402,9 @@ int32_t QueryLaneResource(const LaneQueryInfo *queryInfo, const QosInfo *qosInfo
     return GetLaneDepsInterface()->QueryLaneResource(queryInfo, qosInfo);
 }
 
-ssize_t ConnSendSocketData(int32_t fd, const char *buf, size_t len, int32_t timeout)
+int32_t ConnGetSocketError(int32_t fd)
 {
-    return GetLaneDepsInterface()->ConnSendSocketData(fd, buf, len, timeout);
+    return GetLaneDepsInterface()->ConnGetSocketError(fd);
 }
 
 struct WifiDirectManager* GetWifiDirectManager(void)
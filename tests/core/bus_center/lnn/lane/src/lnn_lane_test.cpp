@@ -35,7 +35,9 @@
 #include "softbus_adapter_mem.h"
 #include "softbus_adapter_thread.h"
 #include "softbus_error_code.h"
+#include "softbus_feature_config.h"
 #include "softbus_wifi_api_adapter.h"
+#include "trans_network_statistics.h"
 #include "lnn_lane_reliability.h"
 #include "lnn_lane_reliability.c"
 #include "wifi_direct_error_code.h"
@@ -61,11 +63,15 @@ constexpr uint32_t PORT_B = 25;
 constexpr uint32_t FD = 888;
 constexpr uint32_t SLEEP_FOR_LOOP_COMPLETION_MS = 50;
 constexpr uint32_t NET_CAP = 63;
+constexpr uint32_t DETECT_EVIDENCE_TIME = 5000;
+constexpr uint32_t DETECT_LIVE_LINK_TIME = 30000;
+constexpr int32_t STATISTICS_CHANNEL_ID = 1001;
 
 static SoftBusCond g_cond = {0};
 static SoftBusMutex g_lock = {0};
 static int32_t g_errCode = 0;
 static bool g_isNeedCondWait = true;
+static std::thread::id g_detectNotifyThreadId;
 
 static void OnLaneAllocSuccess(uint32_t laneHandle, const LaneConnInfo *info);
 static void OnLaneAllocFail(uint32_t laneHandle, int32_t errCode);
@@ -256,6 +262,16 @@ static void OnLaneLinkSuccessForDetect(uint32_t reqId, LaneLinkType linkType, co
     EXPECT_EQ(linkType, LANE_WLAN_5G);
 }
 
+static void OnLaneLinkSuccessForEvidence(uint32_t reqId, LaneLinkType linkType, const LaneLinkInfo *linkInfo)
+{
+    (void)reqId;
+    (void)linkInfo;
+    GTEST_LOG_(INFO) << "on laneLink success by detect evidence";
+    EXPECT_EQ(linkType, LANE_WLAN_5G);
+    g_detectNotifyThreadId = std::this_thread::get_id();
+    CondSignal();
+}
+
 static void OnLaneLinkFailForDetect(uint32_t reqId, int32_t reason, LaneLinkType linkType)
 {
     (void)reqId;
@@ -265,6 +281,14 @@ static void OnLaneLinkFailForDetect(uint32_t reqId, int32_t reason, LaneLinkType
     CondSignal();
 }
 
+static void SetDetectFreshTime(uint32_t evidenceTime, uint32_t liveLinkTime)
+{
+    (void)SoftbusSetConfig(SOFTBUS_INT_LANE_DETECT_EVIDENCE_TIME,
+        reinterpret_cast<const unsigned char *>(&evidenceTime), sizeof(evidenceTime));
+    (void)SoftbusSetConfig(SOFTBUS_INT_LANE_DETECT_LIVE_LINK_TIME,
+        reinterpret_cast<const unsigned char *>(&liveLinkTime), sizeof(liveLinkTime));
+}
+
 static void OnLaneAllocSuccessForHml(uint32_t laneHandle, const LaneConnInfo *info)
 {
     (void)laneHandle;
@@ -467,8 +491,7 @@ HWTEST_F(LNNLaneMockTest, LANE_ALLOC_Test_001, TestSize.Level1)
     mock.SetDefaultResult(reinterpret_cast<NodeInfo *>(&g_NodeInfo));
     mock.SetDefaultResultForAlloc(1 << BIT_WIFI_5G, 1 << BIT_WIFI_5G, 0, 0);
     EXPECT_CALL(mock, AddTrigger).WillRepeatedly(LaneDepsInterfaceMock::ActionOfAddTrigger);
-    char buf[] = "lanedetect";
-    EXPECT_CALL(mock, ConnSendSocketData).WillRepeatedly(Return(sizeof(buf)));
+    EXPECT_CALL(mock, ConnGetSocketError).WillRepeatedly(Return(SOFTBUS_OK));
     EXPECT_CALL(mock, DeleteNetworkResourceByLaneId).WillRepeatedly(Return());
     NiceMock<LnnWifiAdpterInterfaceMock> wifiMock;
     wifiMock.SetDefaultResult();
@@ -709,8 +732,7 @@ HWTEST_F(LNNLaneMockTest, LANE_ALLOC_Test_008, TestSize.Level1)
     mock.SetDefaultResult(reinterpret_cast<NodeInfo *>(&g_NodeInfo));
     mock.SetDefaultResultForAlloc(1 << BIT_WIFI_5G, 1 << BIT_WIFI_5G, 0, 0);
     EXPECT_CALL(mock, AddTrigger).WillRepeatedly(LaneDepsInterfaceMock::ActionOfAddTrigger);
-    char buf[] = "lanedetect";
-    EXPECT_CALL(mock, ConnSendSocketData).WillRepeatedly(Return(sizeof(buf)));
+    EXPECT_CALL(mock, ConnGetSocketError).WillRepeatedly(Return(SOFTBUS_OK));
     EXPECT_CALL(mock, DeleteNetworkResourceByLaneId).WillRepeatedly(Return());
     NiceMock<LnnWifiAdpterInterfaceMock> wifiMock;
     wifiMock.SetDefaultResult();
@@ -750,8 +772,7 @@ HWTEST_F(LNNLaneMockTest, LANE_ALLOC_Test_009, TestSize.Level1)
     mock.SetDefaultResult(reinterpret_cast<NodeInfo *>(&g_NodeInfo));
     mock.SetDefaultResultForAlloc(1 << BIT_WIFI_5G, 1 << BIT_WIFI_5G, 0, 0);
     EXPECT_CALL(mock, AddTrigger).WillRepeatedly(LaneDepsInterfaceMock::ActionOfAddTrigger);
-    char buf[] = "lanedetect";
-    EXPECT_CALL(mock, ConnSendSocketData).WillRepeatedly(Return(sizeof(buf)));
+    EXPECT_CALL(mock, ConnGetSocketError).WillRepeatedly(Return(SOFTBUS_OK));
     EXPECT_CALL(mock, DeleteNetworkResourceByLaneId).WillRepeatedly(Return());
     NiceMock<LnnWifiAdpterInterfaceMock> wifiMock;
     wifiMock.SetDefaultResult();
@@ -1148,8 +1169,7 @@ HWTEST_F(LNNLaneMockTest, LANE_RE_ALLOC_Test_003, TestSize.Level1)
     mock.SetDefaultResultForAlloc(63, 63, 1 << BIT_WIFI_DIRECT_ENHANCE_CAPABILITY,
         1 << BIT_WIFI_DIRECT_ENHANCE_CAPABILITY);
     EXPECT_CALL(mock, AddTrigger).WillRepeatedly(LaneDepsInterfaceMock::ActionOfAddTrigger);
-    char buf[] = "lanedetect";
-    EXPECT_CALL(mock, ConnSendSocketData).WillRepeatedly(Return(sizeof(buf)));
+    EXPECT_CALL(mock, ConnGetSocketError).WillRepeatedly(Return(SOFTBUS_OK));
     EXPECT_CALL(mock, DeleteNetworkResourceByLaneId).WillRepeatedly(Return());
     EXPECT_CALL(mock, GetWifiDirectManager).WillRepeatedly(Return(&g_manager));
     int32_t ret = AddLaneResourceForAllocTest(LANE_HML);
@@ -1963,8 +1983,7 @@ HWTEST_F(LNNLaneMockTest, LANE_DETECT_RELIABILITY_004, TestSize.Level1)
         .WillRepeatedly(Return(SOFTBUS_OK));
     EXPECT_CALL(mock, AddTrigger).WillOnce(Return(SOFTBUS_CONN_FAIL))
         .WillRepeatedly(LaneDepsInterfaceMock::ActionOfAddTrigger);
-    char buf[] = "lanedetect";
-    EXPECT_CALL(mock, ConnSendSocketData).WillRepeatedly(Return(sizeof(buf)));
+    EXPECT_CALL(mock, ConnGetSocketError).WillRepeatedly(Return(SOFTBUS_OK));
 
     int32_t ret = LaneDetectReliability(laneReqId, &linkInfo, &cb);
     EXPECT_EQ(ret, SOFTBUS_TCPCONNECTION_SOCKET_ERR);
@@ -1999,14 +2018,15 @@ HWTEST_F(LNNLaneMockTest, LANE_DETECT_RELIABILITY_005, TestSize.Level1)
     int32_t laneReqId = laneManager->lnnGetLaneHandle(laneType);
     EXPECT_TRUE(laneReqId != INVALID_LANE_REQ_ID);
     LaneDepsInterfaceMock::socketEvent = SOFTBUS_SOCKET_EXCEPTION;
+    SetDetectFreshTime(0, 0);
     NiceMock<LaneDepsInterfaceMock> mock;
     EXPECT_CALL(mock, ConnOpenClientSocket).WillRepeatedly(Return(SOFTBUS_OK));
     EXPECT_CALL(mock, AddTrigger).WillRepeatedly(LaneDepsInterfaceMock::ActionOfAddTrigger);
-    char buf[] = "lanedetect";
-    EXPECT_CALL(mock, ConnSendSocketData).WillRepeatedly(Return(sizeof(buf)));
+    EXPECT_CALL(mock, ConnGetSocketError).WillRepeatedly(Return(SOFTBUS_OK));
 
     int32_t ret = LaneDetectReliability(laneReqId, &linkInfo, &cb);
     EXPECT_EQ(ret, SOFTBUS_OK);
+    SetDetectFreshTime(DETECT_EVIDENCE_TIME, DETECT_LIVE_LINK_TIME);
 }
 
 /*
@@ -2035,12 +2055,184 @@ HWTEST_F(LNNLaneMockTest, LANE_DETECT_RELIABILITY_006, TestSize.Level1)
     NiceMock<LaneDepsInterfaceMock> mock;
     EXPECT_CALL(mock, ConnOpenClientSocket).WillRepeatedly(Return(SOFTBUS_OK));
     EXPECT_CALL(mock, AddTrigger).WillRepeatedly(Return(SOFTBUS_OK));
-    char buf[] = "lanedetect";
-    EXPECT_CALL(mock, ConnSendSocketData).WillRepeatedly(Return(sizeof(buf)));
+    EXPECT_CALL(mock, ConnGetSocketError).WillRepeatedly(Return(SOFTBUS_OK));
+    SetDetectFreshTime(0, 0);
     SetIsNeedCondWait();
     int32_t ret = LaneDetectReliability(laneReqId, &linkInfo, &cb);
     EXPECT_EQ(ret, SOFTBUS_OK);
     CondWait();
+    SetDetectFreshTime(DETECT_EVIDENCE_TIME, DETECT_LIVE_LINK_TIME);
+}
+
+/*
+* @tc.name: LANE_DETECT_RELIABILITY_007
+* @tc.desc: WLAN LANE DETECT RELIABILITY, reuse fresh detect evidence
+* @tc.type: FUNC
+* @tc.require:
+*/
+HWTEST_F(LNNLaneMockTest, LANE_DETECT_RELIABILITY_007, TestSize.Level1)
+{
+    const char *ipAddr = "127.0.0.2";
+    LaneLinkCb cb = {
+        .onLaneLinkSuccess = OnLaneLinkSuccessForDetect,
+        .onLaneLinkFail = OnLaneLinkFailForDetect,
+    };
+
+    LaneLinkInfo linkInfo;
+    linkInfo.type = LANE_WLAN_5G;
+    linkInfo.linkInfo.wlan.connInfo.port = PORT_A;
+    EXPECT_EQ(strcpy_s(linkInfo.linkInfo.wlan.connInfo.addr, MAX_SOCKET_ADDR_LEN, ipAddr), EOK);
+    const LnnLaneManager *laneManager = GetLaneManager();
+    LaneType laneType = LANE_TYPE_TRANS;
+    int32_t laneReqId = laneManager->lnnGetLaneHandle(laneType);
+    EXPECT_TRUE(laneReqId != INVALID_LANE_REQ_ID);
+    LaneDepsInterfaceMock::socketEvent = SOFTBUS_SOCKET_OUT;
+    NiceMock<LaneDepsInterfaceMock> mock;
+    EXPECT_CALL(mock, ConnOpenClientSocket).Times(1).WillRepeatedly(Return(SOFTBUS_OK));
+    EXPECT_CALL(mock, AddTrigger).WillRepeatedly(LaneDepsInterfaceMock::ActionOfAddTrigger);
+    EXPECT_CALL(mock, ConnGetSocketError).WillRepeatedly(Return(SOFTBUS_OK));
+
+    int32_t ret = LaneDetectReliability(laneReqId, &linkInfo, &cb);
+    EXPECT_EQ(ret, SOFTBUS_OK);
+    ret = LaneDetectReliability(laneReqId, &linkInfo, &cb);
+    EXPECT_EQ(ret, SOFTBUS_OK);
+}
+
+/*
+* @tc.name: LANE_DETECT_RELIABILITY_008
+* @tc.desc: WLAN LANE DETECT RELIABILITY, failed probe records no evidence
+* @tc.type: FUNC
+* @tc.require:
+*/
+HWTEST_F(LNNLaneMockTest, LANE_DETECT_RELIABILITY_008, TestSize.Level1)
+{
+    const char *ipAddr = "127.0.0.3";
+    LaneLinkCb cb = {
+        .onLaneLinkSuccess = OnLaneLinkSuccessForDetect,
+        .onLaneLinkFail = OnLaneLinkFail,
+    };
+
+    LaneLinkInfo linkInfo;
+    linkInfo.type = LANE_WLAN_5G;
+    linkInfo.linkInfo.wlan.connInfo.port = PORT_A;
+    EXPECT_EQ(strcpy_s(linkInfo.linkInfo.wlan.connInfo.addr, MAX_SOCKET_ADDR_LEN, ipAddr), EOK);
+    const LnnLaneManager *laneManager = GetLaneManager();
+    LaneType laneType = LANE_TYPE_TRANS;
+    int32_t laneReqId = laneManager->lnnGetLaneHandle(laneType);
+    EXPECT_TRUE(laneReqId != INVALID_LANE_REQ_ID);
+    LaneDepsInterfaceMock::socketEvent = SOFTBUS_SOCKET_OUT;
+    NiceMock<LaneDepsInterfaceMock> mock;
+    EXPECT_CALL(mock, ConnOpenClientSocket).Times(2).WillRepeatedly(Return(SOFTBUS_OK));
+    EXPECT_CALL(mock, AddTrigger).WillRepeatedly(LaneDepsInterfaceMock::ActionOfAddTrigger);
+    EXPECT_CALL(mock, ConnGetSocketError).WillRepeatedly(Return(SOFTBUS_TCPCONNECTION_SOCKET_ERR));
+
+    int32_t ret = LaneDetectReliability(laneReqId, &linkInfo, &cb);
+    EXPECT_EQ(ret, SOFTBUS_OK);
+    EXPECT_FALSE(IsWlanDetectEvidenceFresh(&linkInfo));
+    ret = LaneDetectReliability(laneReqId, &linkInfo, &cb);
+    EXPECT_EQ(ret, SOFTBUS_OK);
+}
+
+/*
+* @tc.name: LANE_DETECT_RELIABILITY_009
+* @tc.desc: WLAN LANE DETECT RELIABILITY, stale evidence kept alive by an in-use lane
+* @tc.type: FUNC
+* @tc.require:
+*/
+HWTEST_F(LNNLaneMockTest, LANE_DETECT_RELIABILITY_009, TestSize.Level1)
+{
+    const char *ipAddr = "127.0.0.4";
+    LaneLinkCb cb = {
+        .onLaneLinkSuccess = OnLaneLinkSuccessForDetect,
+        .onLaneLinkFail = OnLaneLinkFailForDetect,
+    };
+
+    LaneLinkInfo linkInfo;
+    linkInfo.type = LANE_WLAN_5G;
+    linkInfo.linkInfo.wlan.connInfo.port = PORT_A;
+    EXPECT_EQ(strcpy_s(linkInfo.linkInfo.wlan.connInfo.addr, MAX_SOCKET_ADDR_LEN, ipAddr), EOK);
+    const LnnLaneManager *laneManager = GetLaneManager();
+    LaneType laneType = LANE_TYPE_TRANS;
+    int32_t laneReqId = laneManager->lnnGetLaneHandle(laneType);
+    EXPECT_TRUE(laneReqId != INVALID_LANE_REQ_ID);
+    LaneDepsInterfaceMock::socketEvent = SOFTBUS_SOCKET_OUT;
+    SetDetectFreshTime(0, DETECT_LIVE_LINK_TIME);
+    NiceMock<LaneDepsInterfaceMock> mock;
+    EXPECT_CALL(mock, ConnOpenClientSocket).Times(2).WillRepeatedly(Return(SOFTBUS_OK));
+    EXPECT_CALL(mock, AddTrigger).WillRepeatedly(LaneDepsInterfaceMock::ActionOfAddTrigger);
+    EXPECT_CALL(mock, ConnGetSocketError).WillRepeatedly(Return(SOFTBUS_OK));
+
+    int32_t ret = LaneDetectReliability(laneReqId, &linkInfo, &cb);
+    EXPECT_EQ(ret, SOFTBUS_OK);
+    EXPECT_FALSE(IsWlanDetectEvidenceFresh(&linkInfo));
+
+    uint64_t laneId = LANE_ID_BASE + 1;
+    ret = AddLaneResourceToPool(&linkInfo, laneId, false);
+    EXPECT_EQ(ret, SOFTBUS_OK);
+    EXPECT_TRUE(IsWlanDetectEvidenceFresh(&linkInfo));
+    ret = LaneDetectReliability(laneReqId, &linkInfo, &cb);
+    EXPECT_EQ(ret, SOFTBUS_OK);
+
+    ret = DelLaneResourceByLaneId(laneId, false);
+    EXPECT_EQ(ret, SOFTBUS_OK);
+    ret = LaneDetectReliability(laneReqId, &linkInfo, &cb);
+    EXPECT_EQ(ret, SOFTBUS_OK);
+    SetDetectFreshTime(DETECT_EVIDENCE_TIME, DETECT_LIVE_LINK_TIME);
+}
+
+/*
+* @tc.name: LANE_DETECT_RELIABILITY_010
+* @tc.desc: WLAN LANE DETECT RELIABILITY, traffic reported by trans network statistics skips the probe
+* @tc.type: FUNC
+* @tc.require:
+*/
+HWTEST_F(LNNLaneMockTest, LANE_DETECT_RELIABILITY_010, TestSize.Level1)
+{
+    const char *ipAddr = "127.0.0.5";
+    LaneLinkCb cb = {
+        .onLaneLinkSuccess = OnLaneLinkSuccessForEvidence,
+        .onLaneLinkFail = OnLaneLinkFailForDetect,
+    };
+
+    LaneLinkInfo linkInfo;
+    (void)memset_s(&linkInfo, sizeof(LaneLinkInfo), 0, sizeof(LaneLinkInfo));
+    linkInfo.type = LANE_WLAN_5G;
+    linkInfo.linkInfo.wlan.connInfo.port = PORT_A;
+    EXPECT_EQ(strcpy_s(linkInfo.linkInfo.wlan.connInfo.addr, MAX_SOCKET_ADDR_LEN, ipAddr), EOK);
+    const LnnLaneManager *laneManager = GetLaneManager();
+    LaneType laneType = LANE_TYPE_TRANS;
+    int32_t laneReqId = laneManager->lnnGetLaneHandle(laneType);
+    EXPECT_TRUE(laneReqId != INVALID_LANE_REQ_ID);
+    uint64_t laneId = LANE_ID_BASE + 2;
+    int32_t ret = AddLaneResourceToPool(&linkInfo, laneId, false);
+    EXPECT_EQ(ret, SOFTBUS_OK);
+
+    EXPECT_EQ(TransNetworkStatisticsInit(), SOFTBUS_OK);
+    NetworkResource resource = {
+        .laneId = laneId,
+        .laneLinkType = LANE_WLAN_5G,
+    };
+    AddNetworkResource(&resource);
+    AddChannelStatisticsInfo(STATISTICS_CHANNEL_ID, CHANNEL_TYPE_TCP_DIRECT);
+    const char *channelStatistics = "{\"traffic\":1024,\"startTime\":1000,\"endTime\":2000}";
+    UpdateNetworkResourceByLaneId(STATISTICS_CHANNEL_ID, CHANNEL_TYPE_TCP_DIRECT, laneId, channelStatistics,
+        strlen(channelStatistics));
+    EXPECT_TRUE(IsWlanDetectEvidenceFresh(&linkInfo));
+
+    NiceMock<LaneDepsInterfaceMock> mock;
+    EXPECT_CALL(mock, ConnOpenClientSocket).Times(0);
+    g_detectNotifyThreadId = std::thread::id();
+    SetIsNeedCondWait();
+    ret = LaneDetectReliability(laneReqId, &linkInfo, &cb);
+    EXPECT_EQ(ret, SOFTBUS_OK);
+    CondWait();
+    EXPECT_NE(g_detectNotifyThreadId, std::thread::id());
+    EXPECT_NE(g_detectNotifyThreadId, std::this_thread::get_id());
+
+    DeleteNetworkResourceByLaneId(laneId);
+    TransNetworkStatisticsDeinit();
+    ret = DelLaneResourceByLaneId(laneId, false);
+    EXPECT_EQ(ret, SOFTBUS_OK);
 }
 
 /*
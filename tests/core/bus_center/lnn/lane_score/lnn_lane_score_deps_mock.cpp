@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "lnn_lane_score_deps_mock.h"
+
+using namespace testing::ext;
+using namespace testing;
+
+namespace OHOS {
+void *g_laneScoreDepsInterface;
+LaneScoreDepsInterfaceMock::LaneScoreDepsInterfaceMock()
+{
+    g_laneScoreDepsInterface = reinterpret_cast<void *>(this);
+}
+
+LaneScoreDepsInterfaceMock::~LaneScoreDepsInterfaceMock()
+{
+    g_laneScoreDepsInterface = nullptr;
+}
+
+static LaneScoreDepsInterface *GetLaneScoreDepsInterface()
+{
+    return reinterpret_cast<LaneScoreDepsInterface *>(g_laneScoreDepsInterface);
+}
+
+extern "C" {
+int32_t LnnGetRemoteStrInfo(const char *networkId, InfoKey key, char *info, uint32_t len)
+{
+    return GetLaneScoreDepsInterface()->LnnGetRemoteStrInfo(networkId, key, info, len);
+}
+
+int32_t FindLaneResourceByLaneId(uint64_t laneId, LaneResource *resource)
+{
+    return GetLaneScoreDepsInterface()->FindLaneResourceByLaneId(laneId, resource);
+}
+
+int32_t SoftBusGetLinkedInfo(SoftBusWifiLinkedInfo *info)
+{
+    return GetLaneScoreDepsInterface()->SoftBusGetLinkedInfo(info);
+}
+
+uint64_t SoftBusGetSysTimeMs(void)
+{
+    return GetLaneScoreDepsInterface()->SoftBusGetSysTimeMs();
+}
+
+int32_t LnnAsyncCallbackDelayHelper(SoftBusLooper *looper, LnnAsyncCallbackFunc callback,
+    void *para, uint64_t delayMillis)
+{
+    return GetLaneScoreDepsInterface()->LnnAsyncCallbackDelayHelper(looper, callback, para, delayMillis);
+}
+
+SoftBusLooper *GetLooper(int looper)
+{
+    return GetLaneScoreDepsInterface()->GetLooper(looper);
+}
+
+int32_t RegisterNetworkStatisticsListener(NetworkStatisticsListener listener)
+{
+    return GetLaneScoreDepsInterface()->RegisterNetworkStatisticsListener(listener);
+}
+
+void UnregisterNetworkStatisticsListener(NetworkStatisticsListener listener)
+{
+    GetLaneScoreDepsInterface()->UnregisterNetworkStatisticsListener(listener);
+}
+}
+} // namespace OHOS
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LNN_LANE_SCORE_DEPS_MOCK_H
+#define LNN_LANE_SCORE_DEPS_MOCK_H
+
+#include <gmock/gmock.h>
+
+#include "bus_center_manager.h"
+#include "lnn_async_callback_utils.h"
+#include "lnn_lane_link.h"
+#include "message_handler.h"
+#include "softbus_wifi_api_adapter.h"
+#include "trans_network_statistics.h"
+
+namespace OHOS {
+class LaneScoreDepsInterface {
+public:
+    LaneScoreDepsInterface() {};
+    virtual ~LaneScoreDepsInterface() {};
+    virtual int32_t LnnGetRemoteStrInfo(const char *networkId, InfoKey key, char *info, uint32_t len) = 0;
+    virtual int32_t FindLaneResourceByLaneId(uint64_t laneId, LaneResource *resource) = 0;
+    virtual int32_t SoftBusGetLinkedInfo(SoftBusWifiLinkedInfo *info) = 0;
+    virtual uint64_t SoftBusGetSysTimeMs(void) = 0;
+    virtual int32_t LnnAsyncCallbackDelayHelper(SoftBusLooper *looper, LnnAsyncCallbackFunc callback,
+        void *para, uint64_t delayMillis) = 0;
+    virtual SoftBusLooper *GetLooper(int looper) = 0;
+    virtual int32_t RegisterNetworkStatisticsListener(NetworkStatisticsListener listener) = 0;
+    virtual void UnregisterNetworkStatisticsListener(NetworkStatisticsListener listener) = 0;
+};
+
+class LaneScoreDepsInterfaceMock : public LaneScoreDepsInterface {
+public:
+    LaneScoreDepsInterfaceMock();
+    ~LaneScoreDepsInterfaceMock() override;
+
+    MOCK_METHOD4(LnnGetRemoteStrInfo, int32_t (const char *networkId, InfoKey key, char *info, uint32_t len));
+    MOCK_METHOD2(FindLaneResourceByLaneId, int32_t (uint64_t laneId, LaneResource *resource));
+    MOCK_METHOD1(SoftBusGetLinkedInfo, int32_t (SoftBusWifiLinkedInfo *info));
+    MOCK_METHOD0(SoftBusGetSysTimeMs, uint64_t (void));
+    MOCK_METHOD4(LnnAsyncCallbackDelayHelper, int32_t (SoftBusLooper *looper, LnnAsyncCallbackFunc callback,
+        void *para, uint64_t delayMillis));
+    MOCK_METHOD1(GetLooper, SoftBusLooper * (int looper));
+    MOCK_METHOD1(RegisterNetworkStatisticsListener, int32_t (NetworkStatisticsListener listener));
+    MOCK_METHOD1(UnregisterNetworkStatisticsListener, void (NetworkStatisticsListener listener));
+};
+} // namespace OHOS
+#endif // LNN_LANE_SCORE_DEPS_MOCK_H
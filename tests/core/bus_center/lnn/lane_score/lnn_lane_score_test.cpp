@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <securec.h>
+#include <string>
+
+#include "lnn_lane_score.h"
+#include "lnn_lane_score_deps_mock.h"
+#include "lnn_select_rule.h"
+#include "softbus_adapter_mem.h"
+#include "softbus_error_code.h"
+
+namespace OHOS {
+using namespace testing::ext;
+using namespace testing;
+
+constexpr char PEER_UDID[] = "111122223333abcdef";
+constexpr char PEER_UDID_OTHER[] = "444455556666abcdef";
+constexpr uint64_t BASE_TIME = 1000000;
+constexpr uint64_t SAMPLE_INTERVAL = 100;
+constexpr uint64_t HALF_LIFE = 60 * 1000;
+constexpr uint64_t EXPIRE_TIME = 30 * 60 * 1000;
+constexpr uint32_t SAMPLE_NUM = 50;
+constexpr uint32_t MAX_LINK_SCORE_NUM = 64;
+constexpr uint32_t GOOD_RTT = 10;
+constexpr uint32_t BAD_RTT = 800;
+constexpr uint32_t LOSS_HALF = 500;
+constexpr int32_t WLAN_5G_CHANNEL = 36;
+constexpr int32_t WLAN_2G_CHANNEL = 6;
+constexpr int32_t GOOD_SCORE = 90;
+constexpr int32_t DEFAULT_SCORE = 60;
+constexpr int32_t SCORE_TOLERANCE = 5;
+constexpr uint64_t LANE_ID = 0x1234567887654321;
+constexpr int64_t TRAFFIC = 100 * 1024 * 1024;
+constexpr int64_t DURATION = 5000;
+constexpr int32_t SCORING_INTERVAL = 300;
+constexpr uint32_t CHANNEL_SCORE_NUM = 2;
+
+class LNNLaneScoreTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void LNNLaneScoreTest::SetUpTestCase()
+{
+    GTEST_LOG_(INFO) << "LNNLaneScoreTest start";
+}
+
+void LNNLaneScoreTest::TearDownTestCase()
+{
+    GTEST_LOG_(INFO) << "LNNLaneScoreTest end";
+}
+
+void LNNLaneScoreTest::SetUp()
+{
+}
+
+void LNNLaneScoreTest::TearDown()
+{
+}
+
+static int32_t ActionOfGetRemoteUdid(const char *networkId, InfoKey key, char *info, uint32_t len)
+{
+    (void)key;
+    if (strcpy_s(info, len, networkId) != EOK) {
+        return SOFTBUS_STRCPY_ERR;
+    }
+    return SOFTBUS_OK;
+}
+
+static void InitScoreWithMock(NiceMock<LaneScoreDepsInterfaceMock> &mock)
+{
+    ON_CALL(mock, LnnGetRemoteStrInfo).WillByDefault(ActionOfGetRemoteUdid);
+    ON_CALL(mock, SoftBusGetSysTimeMs).WillByDefault(Return(BASE_TIME));
+    EXPECT_EQ(LnnInitScore(), SOFTBUS_OK);
+}
+
+static LnnLinkQualitySample BuildSample(const char *peerUdid, LaneLinkType linkType, uint32_t mask)
+{
+    LnnLinkQualitySample sample;
+    (void)memset_s(&sample, sizeof(LnnLinkQualitySample), 0, sizeof(LnnLinkQualitySample));
+    if (peerUdid != nullptr) {
+        (void)strcpy_s(sample.peerUdid, UDID_BUF_LEN, peerUdid);
+    }
+    sample.linkType = linkType;
+    sample.channelId = LNN_SCORE_INVALID_CHANNEL;
+    sample.sampleMask = mask;
+    return sample;
+}
+
+/* feeds a synthetic stream of samples spaced SAMPLE_INTERVAL apart, returns the time of the last one */
+static uint64_t FeedSampleStream(LnnLinkQualitySample &sample, uint64_t startTime, uint32_t num)
+{
+    uint64_t time = startTime;
+    for (uint32_t i = 0; i < num; i++) {
+        sample.timestamp = time;
+        EXPECT_EQ(LnnAddLinkQualitySample(&sample), SOFTBUS_OK);
+        time += SAMPLE_INTERVAL;
+    }
+    return time - SAMPLE_INTERVAL;
+}
+
+/*
+* @tc.name: LNN_ADD_LINK_QUALITY_SAMPLE_001
+* @tc.desc: LnnAddLinkQualitySample invalid param and no init test
+* @tc.type: FUNC
+* @tc.require:
+*/
+HWTEST_F(LNNLaneScoreTest, LNN_ADD_LINK_QUALITY_SAMPLE_001, TestSize.Level1)
+{
+    LnnLinkQualitySample sample = BuildSample(PEER_UDID, LANE_HML, LNN_QUALITY_SAMPLE_RTT);
+    EXPECT_EQ(LnnAddLinkQualitySample(&sample), SOFTBUS_NO_INIT);
+
+    NiceMock<LaneScoreDepsInterfaceMock> mock;
+    InitScoreWithMock(mock);
+    EXPECT_EQ(LnnAddLinkQualitySample(nullptr), SOFTBUS_INVALID_PARAM);
+    sample.linkType = LANE_LINK_TYPE_BUTT;
+    EXPECT_EQ(LnnAddLinkQualitySample(&sample), SOFTBUS_INVALID_PARAM);
+    sample.linkType = LANE_HML;
+    sample.sampleMask = 0;
+    EXPECT_EQ(LnnAddLinkQualitySample(&sample), SOFTBUS_INVALID_PARAM);
+    EXPECT_EQ(LnnGetLinkScore(nullptr, LANE_HML), LNN_LINK_SCORE_UNKNOWN);
+    EXPECT_EQ(LnnGetLinkScore(PEER_UDID, LANE_HML), LNN_LINK_SCORE_UNKNOWN);
+    LnnDeinitScore();
+}
+
+/*
+* @tc.name: LNN_GET_LINK_SCORE_001
+* @tc.desc: good and bad rtt sample streams are scored apart
+* @tc.type: FUNC
+* @tc.require:
+*/
+HWTEST_F(LNNLaneScoreTest, LNN_GET_LINK_SCORE_001, TestSize.Level1)
+{
+    NiceMock<LaneScoreDepsInterfaceMock> mock;
+    InitScoreWithMock(mock);
+    LnnLinkQualitySample good = BuildSample(PEER_UDID, LANE_HML, LNN_QUALITY_SAMPLE_RTT | LNN_QUALITY_SAMPLE_LOSS);
+    good.rttMs = GOOD_RTT;
+    uint64_t lastTime = FeedSampleStream(good, BASE_TIME, SAMPLE_NUM);
+    LnnLinkQualitySample bad = BuildSample(PEER_UDID_OTHER, LANE_HML,
+        LNN_QUALITY_SAMPLE_RTT | LNN_QUALITY_SAMPLE_LOSS);
+    bad.rttMs = BAD_RTT;
+    bad.lossPermille = LOSS_HALF;
+    (void)FeedSampleStream(bad, BASE_TIME, SAMPLE_NUM);
+
+    EXPECT_CALL(mock, SoftBusGetSysTimeMs).WillRepeatedly(Return(lastTime));
+    EXPECT_GE(LnnGetLinkScore(PEER_UDID, LANE_HML), GOOD_SCORE);
+    int32_t badScore = LnnGetLinkScore(PEER_UDID_OTHER, LANE_HML);
+    EXPECT_GT(badScore, LNN_LINK_SCORE_UNKNOWN);
+    EXPECT_LT(badScore, UNACCEPT_SCORE);
+    EXPECT_EQ(LnnGetLinkScore(PEER_UDID, LANE_P2P), LNN_LINK_SCORE_UNKNOWN);
+    LnnDeinitScore();
+}
+
+/*
+* @tc.name: LNN_GET_LINK_SCORE_002
+* @tc.desc: a degrading link follows the sample stream down
+* @tc.type: FUNC
+* @tc.require:
+*/
+HWTEST_F(LNNLaneScoreTest, LNN_GET_LINK_SCORE_002, TestSize.Level1)
+{
+    NiceMock<LaneScoreDepsInterfaceMock> mock;
+    InitScoreWithMock(mock);
+    LnnLinkQualitySample sample = BuildSample(PEER_UDID, LANE_P2P, LNN_QUALITY_SAMPLE_RTT);
+    sample.rttMs = GOOD_RTT;
+    uint64_t lastTime = FeedSampleStream(sample, BASE_TIME, SAMPLE_NUM);
+    EXPECT_CALL(mock, SoftBusGetSysTimeMs).WillRepeatedly(Return(lastTime));
+    int32_t before = LnnGetLinkScore(PEER_UDID, LANE_P2P);
+
+    sample.rttMs = BAD_RTT;
+    lastTime = FeedSampleStream(sample, lastTime + SAMPLE_INTERVAL, SAMPLE_NUM);
+    EXPECT_CALL(mock, SoftBusGetSysTimeMs).WillRepeatedly(Return(lastTime));
+    int32_t after = LnnGetLinkScore(PEER_UDID, LANE_P2P);
+    EXPECT_GT(before, after);
+    EXPECT_LT(after, UNACCEPT_SCORE);
+    LnnDeinitScore();
+}
+
+/*
+* @tc.name: LNN_GET_LINK_SCORE_003
+* @tc.desc: scores decay towards default and expire without new samples
+* @tc.type: FUNC
+* @tc.require:
+*/
+HWTEST_F(LNNLaneScoreTest, LNN_GET_LINK_SCORE_003, TestSize.Level1)
+{
+    NiceMock<LaneScoreDepsInterfaceMock> mock;
+    InitScoreWithMock(mock);
+    LnnLinkQualitySample sample = BuildSample(PEER_UDID, LANE_BR, LNN_QUALITY_SAMPLE_LOSS);
+    sample.lossPermille = LOSS_HALF;
+    uint64_t lastTime = FeedSampleStream(sample, BASE_TIME, SAMPLE_NUM);
+
+    EXPECT_CALL(mock, SoftBusGetSysTimeMs).WillRepeatedly(Return(lastTime));
+    int32_t fresh = LnnGetLinkScore(PEER_UDID, LANE_BR);
+    EXPECT_CALL(mock, SoftBusGetSysTimeMs).WillRepeatedly(Return(lastTime + HALF_LIFE));
+    int32_t halfDecayed = LnnGetLinkScore(PEER_UDID, LANE_BR);
+    EXPECT_CALL(mock, SoftBusGetSysTimeMs).WillRepeatedly(Return(lastTime + HALF_LIFE * SCORE_TOLERANCE));
+    int32_t decayed = LnnGetLinkScore(PEER_UDID, LANE_BR);
+    EXPECT_LT(fresh, halfDecayed);
+    EXPECT_LT(halfDecayed, decayed);
+    EXPECT_NEAR(decayed, DEFAULT_SCORE, SCORE_TOLERANCE);
+    EXPECT_CALL(mock, SoftBusGetSysTimeMs).WillRepeatedly(Return(lastTime + EXPIRE_TIME));
+    EXPECT_EQ(LnnGetLinkScore(PEER_UDID, LANE_BR), LNN_LINK_SCORE_UNKNOWN);
+    LnnDeinitScore();
+}
+
+/*
+* @tc.name: LNN_GET_CHANNEL_SCORE_001
+* @tc.desc: channel samples feed LnnGetCurrChannelScore and LnnGetAllChannelScore
+* @tc.type: FUNC
+* @tc.require:
+*/
+HWTEST_F(LNNLaneScoreTest, LNN_GET_CHANNEL_SCORE_001, TestSize.Level1)
+{
+    NiceMock<LaneScoreDepsInterfaceMock> mock;
+    InitScoreWithMock(mock);
+    EXPECT_EQ(LnnGetCurrChannelScore(0), DEFAULT_SCORE);
+    EXPECT_EQ(LnnGetCurrChannelScore(WLAN_5G_CHANNEL), DEFAULT_SCORE);
+
+    LnnLinkQualitySample good = BuildSample(nullptr, LANE_WLAN_5G, LNN_QUALITY_SAMPLE_RTT);
+    good.channelId = WLAN_5G_CHANNEL;
+    good.rttMs = GOOD_RTT;
+    (void)FeedSampleStream(good, BASE_TIME, SAMPLE_NUM);
+    LnnLinkQualitySample congested = BuildSample(PEER_UDID, LANE_WLAN_2P4G, LNN_QUALITY_SAMPLE_RTT);
+    congested.channelId = WLAN_2G_CHANNEL;
+    congested.rttMs = BAD_RTT;
+    uint64_t lastTime = FeedSampleStream(congested, BASE_TIME, SAMPLE_NUM);
+    LnnLinkQualitySample bleSample = BuildSample(PEER_UDID, LANE_BLE, LNN_QUALITY_SAMPLE_RTT);
+    bleSample.channelId = WLAN_2G_CHANNEL + 1;
+    bleSample.rttMs = GOOD_RTT;
+    (void)FeedSampleStream(bleSample, BASE_TIME, SAMPLE_NUM);
+
+    EXPECT_CALL(mock, SoftBusGetSysTimeMs).WillRepeatedly(Return(lastTime));
+    EXPECT_GE(LnnGetCurrChannelScore(WLAN_5G_CHANNEL), GOOD_SCORE);
+    EXPECT_LT(LnnGetCurrChannelScore(WLAN_2G_CHANNEL), UNACCEPT_SCORE);
+    LnnChannelScore *scoreList = nullptr;
+    uint32_t listSize = 0;
+    EXPECT_EQ(LnnGetAllChannelScore(nullptr, &listSize), SOFTBUS_INVALID_PARAM);
+    EXPECT_EQ(LnnGetAllChannelScore(&scoreList, &listSize), SOFTBUS_OK);
+    ASSERT_NE(scoreList, nullptr);
+    EXPECT_EQ(listSize, CHANNEL_SCORE_NUM);
+    EXPECT_EQ(scoreList[0].channelId, WLAN_2G_CHANNEL);
+    EXPECT_EQ(scoreList[1].channelId, WLAN_5G_CHANNEL);
+    SoftBusFree(scoreList);
+    LnnDeinitScore();
+}
+
+/*
+* @tc.name: LNN_NETWORK_STATISTICS_001
+* @tc.desc: channel statistics reported by transmission become throughput samples
+* @tc.type: FUNC
+* @tc.require:
+*/
+HWTEST_F(LNNLaneScoreTest, LNN_NETWORK_STATISTICS_001, TestSize.Level1)
+{
+    NiceMock<LaneScoreDepsInterfaceMock> mock;
+    NetworkStatisticsListener listener = nullptr;
+    EXPECT_CALL(mock, RegisterNetworkStatisticsListener)
+        .WillOnce(DoAll(SaveArg<0>(&listener), Return(SOFTBUS_OK)));
+    EXPECT_CALL(mock, UnregisterNetworkStatisticsListener).Times(1);
+    InitScoreWithMock(mock);
+    ASSERT_NE(listener, nullptr);
+
+    LaneResource resource;
+    (void)memset_s(&resource, sizeof(LaneResource), 0, sizeof(LaneResource));
+    (void)strcpy_s(resource.link.peerUdid, UDID_BUF_LEN, PEER_UDID);
+    resource.link.type = LANE_HML;
+    resource.link.linkInfo.p2p.channel = WLAN_5G_CHANNEL;
+    resource.laneId = LANE_ID;
+    EXPECT_CALL(mock, FindLaneResourceByLaneId(LANE_ID, _))
+        .WillRepeatedly(DoAll(SetArgPointee<1>(resource), Return(SOFTBUS_OK)));
+
+    listener(LANE_ID, LANE_HML, 1, DURATION);
+    EXPECT_EQ(LnnGetLinkScore(PEER_UDID, LANE_HML), LNN_LINK_SCORE_UNKNOWN);
+    listener(LANE_ID, LANE_HML, TRAFFIC, DURATION);
+    EXPECT_GE(LnnGetLinkScore(PEER_UDID, LANE_HML), UNACCEPT_SCORE);
+    EXPECT_NE(LnnGetCurrChannelScore(WLAN_5G_CHANNEL), DEFAULT_SCORE);
+    LnnDeinitScore();
+}
+
+/*
+* @tc.name: LNN_LINK_SCORE_CAPACITY_001
+* @tc.desc: the least recently updated peer is evicted when the table is full
+* @tc.type: FUNC
+* @tc.require:
+*/
+HWTEST_F(LNNLaneScoreTest, LNN_LINK_SCORE_CAPACITY_001, TestSize.Level1)
+{
+    NiceMock<LaneScoreDepsInterfaceMock> mock;
+    InitScoreWithMock(mock);
+    uint64_t time = BASE_TIME;
+    for (uint32_t i = 0; i <= MAX_LINK_SCORE_NUM; i++) {
+        std::string udid = std::string(PEER_UDID) + std::to_string(i);
+        LnnLinkQualitySample sample = BuildSample(udid.c_str(), LANE_HML, LNN_QUALITY_SAMPLE_RTT);
+        sample.rttMs = GOOD_RTT;
+        sample.timestamp = time++;
+        EXPECT_EQ(LnnAddLinkQualitySample(&sample), SOFTBUS_OK);
+    }
+    EXPECT_CALL(mock, SoftBusGetSysTimeMs).WillRepeatedly(Return(time));
+    std::string first = std::string(PEER_UDID) + std::to_string(0);
+    std::string last = std::string(PEER_UDID) + std::to_string(MAX_LINK_SCORE_NUM);
+    EXPECT_EQ(LnnGetLinkScore(first.c_str(), LANE_HML), LNN_LINK_SCORE_UNKNOWN);
+    EXPECT_GE(LnnGetLinkScore(last.c_str(), LANE_HML), GOOD_SCORE);
+    LnnDeinitScore();
+}
+
+/*
+* @tc.name: LNN_START_SCORING_001
+* @tc.desc: LnnStartScoring and LnnStopScoring test
+* @tc.type: FUNC
+* @tc.require:
+*/
+HWTEST_F(LNNLaneScoreTest, LNN_START_SCORING_001, TestSize.Level1)
+{
+    NiceMock<LaneScoreDepsInterfaceMock> mock;
+    EXPECT_EQ(LnnStartScoring(SCORING_INTERVAL), SOFTBUS_NO_INIT);
+    InitScoreWithMock(mock);
+    EXPECT_EQ(LnnStartScoring(0), SOFTBUS_INVALID_PARAM);
+    EXPECT_CALL(mock, LnnAsyncCallbackDelayHelper).WillOnce(Return(SOFTBUS_OK));
+    EXPECT_EQ(LnnStartScoring(SCORING_INTERVAL), SOFTBUS_OK);
+    EXPECT_EQ(LnnStopScoring(), SOFTBUS_OK);
+    LnnDeinitScore();
+}
+
+/*
+* @tc.name: LNN_GET_WLAN_LINKED_INFO_001
+* @tc.desc: LnnGetWlanLinkedInfo test
+* @tc.type: FUNC
+* @tc.require:
+*/
+HWTEST_F(LNNLaneScoreTest, LNN_GET_WLAN_LINKED_INFO_001, TestSize.Level1)
+{
+    NiceMock<LaneScoreDepsInterfaceMock> mock;
+    LnnWlanLinkedInfo info;
+    (void)memset_s(&info, sizeof(LnnWlanLinkedInfo), 0, sizeof(LnnWlanLinkedInfo));
+    EXPECT_EQ(LnnGetWlanLinkedInfo(nullptr), SOFTBUS_INVALID_PARAM);
+    EXPECT_CALL(mock, SoftBusGetLinkedInfo).WillOnce(Return(SOFTBUS_INVALID_PARAM));
+    EXPECT_EQ(LnnGetWlanLinkedInfo(&info), SOFTBUS_LANE_SELECT_FAIL);
+    SoftBusWifiLinkedInfo linkedInfo;
+    (void)memset_s(&linkedInfo, sizeof(SoftBusWifiLinkedInfo), 0, sizeof(SoftBusWifiLinkedInfo));
+    linkedInfo.frequency = 5180;
+    linkedInfo.connState = SOFTBUS_API_WIFI_CONNECTED;
+    EXPECT_CALL(mock, SoftBusGetLinkedInfo).WillOnce(DoAll(SetArgPointee<0>(linkedInfo), Return(SOFTBUS_OK)));
+    EXPECT_EQ(LnnGetWlanLinkedInfo(&info), SOFTBUS_OK);
+    EXPECT_EQ(info.frequency, 5180);
+    EXPECT_TRUE(info.isConnected);
+}
+} // namespace OHOS
@@ -18,7 +18,9 @@
 
 #include "lnn_battery_info.c"
 #include "lnn_battery_info.h"
+#include "lnn_delta_sync.h"
 #include "lnn_net_ledger_mock.h"
+#include "lnn_service_mock.h"
 #include "lnn_sync_info_mock.h"
 #include "softbus_error_code.h"
 
@@ -26,6 +28,7 @@
 #define TEST_VALID_UDID_LEN       32
 
 constexpr int32_t LEVEL = 10;
+constexpr int32_t LEVEL2 = 20;
 constexpr char UDID1[] = "123456789AB";
 constexpr uint8_t MSG1[] = "{\"BatteryLeavel\":123,\"IsCharging\":true}";
 constexpr uint8_t MSG2[] = "{\"IsCharging\":true}";
@@ -95,4 +98,91 @@ HWTEST_F(LNNBatteryInfoTest, ON_RECEIVE_BATTERY_INFO_TEST_001, TestSize.Level1)
     OnReceiveBatteryInfo(LNN_INFO_TYPE_BATTERY_INFO, networkId, MSG3, 0);
     EXPECT_NE(nodeInfo.batteryInfo.isCharging, true);
 }
+
+/*
+ * @tc.name: ON_BATTERY_STATE_CHANGED_TEST_001
+ * @tc.desc: a battery change is synced when charging flips or the level moves by a whole step
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LNNBatteryInfoTest, ON_BATTERY_STATE_CHANGED_TEST_001, TestSize.Level1)
+{
+    NiceMock<LnnNetLedgertInterfaceMock> ledgerMock;
+    EXPECT_CALL(ledgerMock, LnnGetAllOnlineNodeInfo)
+        .WillRepeatedly(LnnNetLedgertInterfaceMock::ActionOfLnnGetAllOnlineNodeInfo);
+    EXPECT_CALL(ledgerMock, LnnIsLSANode).WillRepeatedly(Return(false));
+    NiceMock<LnnSyncInfoInterfaceMock> syncInfoMock;
+    EXPECT_CALL(syncInfoMock, LnnSendSyncInfoMsg(LNN_INFO_TYPE_BATTERY_INFO, _, _, _, _))
+        .Times(3)
+        .WillRepeatedly(Return(SOFTBUS_OK));
+
+    LnnMonitorBatteryStateChangedEvent event;
+    (void)memset_s(&event, sizeof(event), 0, sizeof(event));
+    event.basic.event = LNN_EVENT_BATTERY_STATE_CHANGED;
+    event.level = LEVEL;
+    event.isCharging = true;
+    OnBatteryStateChanged(nullptr);
+    OnBatteryStateChanged(reinterpret_cast<const LnnEventBasicInfo *>(&event));
+    OnBatteryStateChanged(reinterpret_cast<const LnnEventBasicInfo *>(&event));
+    event.level = LEVEL + 1;
+    OnBatteryStateChanged(reinterpret_cast<const LnnEventBasicInfo *>(&event));
+    event.isCharging = false;
+    OnBatteryStateChanged(reinterpret_cast<const LnnEventBasicInfo *>(&event));
+    event.level = LEVEL2;
+    OnBatteryStateChanged(reinterpret_cast<const LnnEventBasicInfo *>(&event));
+}
+
+/*
+ * @tc.name: SYNC_BATTERY_INFO_DELTA_TEST_001
+ * @tc.desc: a peer with delta sync only gets the delta message, any other peer only the legacy one
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LNNBatteryInfoTest, SYNC_BATTERY_INFO_DELTA_TEST_001, TestSize.Level1)
+{
+    NiceMock<LnnNetLedgertInterfaceMock> ledgerMock;
+    NiceMock<LnnServicetInterfaceMock> serviceMock;
+    NiceMock<LnnSyncInfoInterfaceMock> syncInfoMock;
+    EXPECT_CALL(syncInfoMock, LnnRegSyncInfoHandler).WillRepeatedly(Return(SOFTBUS_OK));
+    ASSERT_EQ(LnnInitDeltaSync(), SOFTBUS_OK);
+
+    EXPECT_CALL(serviceMock, IsFeatureSupport).WillRepeatedly(Return(false));
+    EXPECT_CALL(syncInfoMock, LnnSendSyncInfoMsg(LNN_INFO_TYPE_BATTERY_INFO, _, _, _, _))
+        .WillOnce(Return(SOFTBUS_OK));
+    EXPECT_CALL(syncInfoMock, LnnSendSyncInfoMsg(LNN_INFO_TYPE_DELTA_INFO, _, _, _, _)).Times(0);
+    EXPECT_EQ(SyncBatteryInfoByNetworkId(NETWORKID, LEVEL, true), SOFTBUS_OK);
+
+    EXPECT_CALL(serviceMock, IsFeatureSupport).WillRepeatedly(Return(true));
+    EXPECT_CALL(syncInfoMock, LnnSendSyncInfoMsg(LNN_INFO_TYPE_BATTERY_INFO, _, _, _, _)).Times(0);
+    EXPECT_CALL(syncInfoMock, LnnSendSyncInfoMsg(LNN_INFO_TYPE_DELTA_INFO, _, _, _, _))
+        .WillOnce(Return(SOFTBUS_OK));
+    EXPECT_EQ(SyncBatteryInfoByNetworkId(NETWORKID, LEVEL2, true), SOFTBUS_OK);
+    LnnDeinitDeltaSync();
+}
+
+/*
+ * @tc.name: LNN_INIT_BATTERY_INFO_TEST_001
+ * @tc.desc: init registers the battery handlers and deinit removes them
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LNNBatteryInfoTest, LNN_INIT_BATTERY_INFO_TEST_001, TestSize.Level1)
+{
+    NiceMock<LnnSyncInfoInterfaceMock> syncInfoMock;
+    EXPECT_CALL(syncInfoMock, LnnRegSyncInfoHandler).WillRepeatedly(Return(SOFTBUS_OK));
+    NiceMock<LnnServicetInterfaceMock> serviceMock;
+    EXPECT_CALL(serviceMock, LnnRegisterEventHandler).WillRepeatedly(Return(SOFTBUS_OK));
+    EXPECT_CALL(serviceMock, LnnUnregisterEventHandler).WillRepeatedly(Return());
+    EXPECT_CALL(serviceMock, LnnRegisterEventHandler(LNN_EVENT_BATTERY_STATE_CHANGED, _))
+        .WillOnce(Return(SOFTBUS_OK));
+    EXPECT_CALL(serviceMock, LnnUnregisterEventHandler(LNN_EVENT_BATTERY_STATE_CHANGED, _)).Times(1);
+    EXPECT_EQ(LnnInitBatteryInfo(), SOFTBUS_NETWORK_REG_EVENT_HANDLER_ERR);
+    ASSERT_EQ(LnnInitDeltaSync(), SOFTBUS_OK);
+    EXPECT_EQ(LnnInitBatteryInfo(), SOFTBUS_OK);
+    EXPECT_EQ(LnnRegDeltaSyncFieldHandler(DELTA_FIELD_BATTERY_CHARGING, OnReceiveBatteryDeltaInfo),
+        SOFTBUS_INVALID_PARAM);
+    LnnDeinitBatteryInfo();
+    EXPECT_EQ(LnnRegDeltaSyncFieldHandler(DELTA_FIELD_BATTERY_CHARGING, OnReceiveBatteryDeltaInfo), SOFTBUS_OK);
+    LnnDeinitDeltaSync();
+}
 } // namespace OHOS
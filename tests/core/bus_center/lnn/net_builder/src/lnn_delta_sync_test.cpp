@@ -0,0 +1,481 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <deque>
+#include <gtest/gtest.h>
+#include <securec.h>
+#include <string>
+#include <vector>
+
+#include "lnn_delta_sync.c"
+#include "lnn_delta_sync.h"
+#include "lnn_net_ledger_mock.h"
+#include "lnn_service_mock.h"
+#include "lnn_sync_info_mock.h"
+#include "softbus_error_code.h"
+
+namespace OHOS {
+using namespace testing;
+using namespace testing::ext;
+
+constexpr char NETWORKID_A[] = "networkIdA";
+constexpr char NETWORKID_B[] = "networkIdB";
+constexpr uint32_t EPOCH_A = 0x1001;
+constexpr uint32_t EPOCH_B = 0x2001;
+constexpr uint32_t EPOCH_B_RESTART = 0x2003;
+constexpr int32_t LEVEL1 = 50;
+constexpr int32_t LEVEL2 = 30;
+constexpr int32_t NET_CAPABILITY = 0x3F;
+constexpr uint32_t MAX_MSG_LEN = DELTA_MSG_HEAD_LEN + DELTA_MSG_FIELD_LEN * DELTA_FIELD_BUTT;
+constexpr uint32_t ONE_FIELD_MSG_LEN = DELTA_MSG_HEAD_LEN + DELTA_MSG_FIELD_LEN;
+constexpr uint32_t TWO_FIELD_MSG_LEN = DELTA_MSG_HEAD_LEN + DELTA_MSG_FIELD_LEN * 2;
+
+struct LoopbackMsg {
+    std::string from;
+    std::string to;
+    std::vector<uint8_t> data;
+};
+
+struct LoopbackEndpoint;
+
+/* two in-process ledgers exchanging delta sync messages through an ordered loopback channel */
+struct Loopback {
+    std::deque<LoopbackMsg> queue;
+    LoopbackEndpoint *endpoints[2];
+};
+
+struct LoopbackEndpoint {
+    std::string networkId;
+    DeltaSyncCtx *ctx;
+    Loopback *channel;
+    int32_t ledger[DELTA_FIELD_BUTT];
+    uint32_t applyCnt;
+    uint32_t lastMask;
+    std::vector<uint32_t> sentLen;
+};
+
+static int32_t LoopbackSend(void *owner, const char *networkId, const uint8_t *msg, uint32_t len)
+{
+    LoopbackEndpoint *self = static_cast<LoopbackEndpoint *>(owner);
+    self->sentLen.push_back(len);
+    self->channel->queue.push_back({ self->networkId, networkId, std::vector<uint8_t>(msg, msg + len) });
+    return SOFTBUS_OK;
+}
+
+static void LoopbackApply(void *owner, const char *networkId, const int32_t *values, uint32_t changedMask)
+{
+    (void)networkId;
+    LoopbackEndpoint *self = static_cast<LoopbackEndpoint *>(owner);
+    for (uint32_t i = 0; i < DELTA_FIELD_BUTT; ++i) {
+        if ((changedMask & DELTA_FIELD_MASK(i)) != 0) {
+            self->ledger[i] = values[i];
+        }
+    }
+    self->applyCnt++;
+    self->lastMask = changedMask;
+}
+
+class LNNDeltaSyncTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+
+    void InitEndpoint(LoopbackEndpoint &endpoint, const char *networkId, uint32_t epoch);
+    void Pump();
+    bool DeliverFront();
+
+    Loopback channel_;
+    LoopbackEndpoint endpointA_;
+    LoopbackEndpoint endpointB_;
+};
+
+void LNNDeltaSyncTest::SetUpTestCase() { }
+
+void LNNDeltaSyncTest::TearDownTestCase() { }
+
+void LNNDeltaSyncTest::SetUp()
+{
+    channel_.queue.clear();
+    channel_.endpoints[0] = &endpointA_;
+    channel_.endpoints[1] = &endpointB_;
+    InitEndpoint(endpointA_, NETWORKID_A, EPOCH_A);
+    InitEndpoint(endpointB_, NETWORKID_B, EPOCH_B);
+}
+
+void LNNDeltaSyncTest::TearDown()
+{
+    LnnDestroyDeltaSyncCtx(endpointA_.ctx);
+    LnnDestroyDeltaSyncCtx(endpointB_.ctx);
+    endpointA_.ctx = nullptr;
+    endpointB_.ctx = nullptr;
+}
+
+void LNNDeltaSyncTest::InitEndpoint(LoopbackEndpoint &endpoint, const char *networkId, uint32_t epoch)
+{
+    endpoint.networkId = networkId;
+    endpoint.channel = &channel_;
+    (void)memset_s(endpoint.ledger, sizeof(endpoint.ledger), 0, sizeof(endpoint.ledger));
+    endpoint.applyCnt = 0;
+    endpoint.lastMask = 0;
+    endpoint.sentLen.clear();
+    DeltaSyncTransport transport = {
+        .sendMsg = LoopbackSend,
+        .applyFields = LoopbackApply,
+        .owner = &endpoint,
+    };
+    endpoint.ctx = LnnCreateDeltaSyncCtx(&transport, epoch);
+    ASSERT_NE(endpoint.ctx, nullptr);
+}
+
+bool LNNDeltaSyncTest::DeliverFront()
+{
+    if (channel_.queue.empty()) {
+        return false;
+    }
+    LoopbackMsg msg = channel_.queue.front();
+    channel_.queue.pop_front();
+    LoopbackEndpoint *target = (msg.to == endpointA_.networkId) ? &endpointA_ : &endpointB_;
+    EXPECT_EQ(LnnDeltaSyncOnRecv(target->ctx, msg.from.c_str(), msg.data.data(), msg.data.size()), SOFTBUS_OK);
+    return true;
+}
+
+void LNNDeltaSyncTest::Pump()
+{
+    while (DeliverFront()) { }
+}
+
+/*
+ * @tc.name: DELTA_SYNC_FULL_THEN_DELTA_TEST_001
+ * @tc.desc: first sync carries the full table, later changes only carry changed fields
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LNNDeltaSyncTest, DELTA_SYNC_FULL_THEN_DELTA_TEST_001, TestSize.Level1)
+{
+    EXPECT_EQ(LnnDeltaSyncSetField(endpointA_.ctx, DELTA_FIELD_BATTERY_LEVEL, LEVEL1), SOFTBUS_OK);
+    EXPECT_EQ(LnnDeltaSyncSetField(endpointA_.ctx, DELTA_FIELD_BATTERY_CHARGING, 0), SOFTBUS_OK);
+    EXPECT_FALSE(LnnDeltaSyncIsPeerCapable(endpointA_.ctx, NETWORKID_B));
+    EXPECT_EQ(LnnDeltaSyncFlush(endpointA_.ctx, NETWORKID_B), SOFTBUS_OK);
+    Pump();
+    ASSERT_EQ(endpointA_.sentLen.size(), 1U);
+    EXPECT_EQ(endpointA_.sentLen[0], TWO_FIELD_MSG_LEN);
+    EXPECT_EQ(endpointB_.ledger[DELTA_FIELD_BATTERY_LEVEL], LEVEL1);
+    EXPECT_EQ(endpointB_.ledger[DELTA_FIELD_BATTERY_CHARGING], 0);
+    EXPECT_TRUE(LnnDeltaSyncIsPeerCapable(endpointA_.ctx, NETWORKID_B));
+
+    EXPECT_EQ(LnnDeltaSyncSetField(endpointA_.ctx, DELTA_FIELD_BATTERY_CHARGING, 1), SOFTBUS_OK);
+    EXPECT_EQ(LnnDeltaSyncFlush(endpointA_.ctx, NETWORKID_B), SOFTBUS_OK);
+    Pump();
+    ASSERT_EQ(endpointA_.sentLen.size(), 2U);
+    EXPECT_EQ(endpointA_.sentLen[1], ONE_FIELD_MSG_LEN);
+    EXPECT_EQ(endpointB_.ledger[DELTA_FIELD_BATTERY_CHARGING], 1);
+    EXPECT_EQ(endpointB_.lastMask, DELTA_FIELD_MASK(DELTA_FIELD_BATTERY_CHARGING));
+
+    EXPECT_EQ(LnnDeltaSyncSetField(endpointA_.ctx, DELTA_FIELD_BATTERY_CHARGING, 1), SOFTBUS_OK);
+    EXPECT_EQ(LnnDeltaSyncFlush(endpointA_.ctx, NETWORKID_B), SOFTBUS_OK);
+    EXPECT_TRUE(channel_.queue.empty());
+    EXPECT_EQ(endpointA_.sentLen.size(), 2U);
+}
+
+/*
+ * @tc.name: DELTA_SYNC_LOST_AND_DUPLICATE_TEST_001
+ * @tc.desc: deltas are cumulative from the acked version, a lost delta is covered by the next one
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LNNDeltaSyncTest, DELTA_SYNC_LOST_AND_DUPLICATE_TEST_001, TestSize.Level1)
+{
+    EXPECT_EQ(LnnDeltaSyncSetField(endpointA_.ctx, DELTA_FIELD_BATTERY_LEVEL, LEVEL1), SOFTBUS_OK);
+    EXPECT_EQ(LnnDeltaSyncFlush(endpointA_.ctx, NETWORKID_B), SOFTBUS_OK);
+    Pump();
+
+    EXPECT_EQ(LnnDeltaSyncSetField(endpointA_.ctx, DELTA_FIELD_BATTERY_LEVEL, LEVEL2), SOFTBUS_OK);
+    EXPECT_EQ(LnnDeltaSyncFlush(endpointA_.ctx, NETWORKID_B), SOFTBUS_OK);
+    ASSERT_EQ(channel_.queue.size(), 1U);
+    channel_.queue.pop_front();
+
+    EXPECT_EQ(LnnDeltaSyncSetField(endpointA_.ctx, DELTA_FIELD_BATTERY_CHARGING, 1), SOFTBUS_OK);
+    EXPECT_EQ(LnnDeltaSyncFlush(endpointA_.ctx, NETWORKID_B), SOFTBUS_OK);
+    ASSERT_EQ(channel_.queue.size(), 1U);
+    LoopbackMsg duplicate = channel_.queue.front();
+    Pump();
+    EXPECT_EQ(endpointA_.sentLen.back(), TWO_FIELD_MSG_LEN);
+    EXPECT_EQ(endpointB_.ledger[DELTA_FIELD_BATTERY_LEVEL], LEVEL2);
+    EXPECT_EQ(endpointB_.ledger[DELTA_FIELD_BATTERY_CHARGING], 1);
+
+    uint32_t applyCnt = endpointB_.applyCnt;
+    channel_.queue.push_back(duplicate);
+    Pump();
+    EXPECT_EQ(endpointB_.applyCnt, applyCnt);
+    EXPECT_EQ(endpointB_.ledger[DELTA_FIELD_BATTERY_LEVEL], LEVEL2);
+}
+
+/*
+ * @tc.name: DELTA_SYNC_VERSION_MISMATCH_TEST_001
+ * @tc.desc: a restarted peer rejects the delta and gets a full sync instead
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LNNDeltaSyncTest, DELTA_SYNC_VERSION_MISMATCH_TEST_001, TestSize.Level1)
+{
+    EXPECT_EQ(LnnDeltaSyncSetField(endpointA_.ctx, DELTA_FIELD_BATTERY_LEVEL, LEVEL1), SOFTBUS_OK);
+    EXPECT_EQ(LnnDeltaSyncSetField(endpointA_.ctx, DELTA_FIELD_BATTERY_CHARGING, 1), SOFTBUS_OK);
+    EXPECT_EQ(LnnDeltaSyncFlush(endpointA_.ctx, NETWORKID_B), SOFTBUS_OK);
+    Pump();
+
+    LnnDestroyDeltaSyncCtx(endpointB_.ctx);
+    InitEndpoint(endpointB_, NETWORKID_B, EPOCH_B_RESTART);
+    EXPECT_EQ(LnnDeltaSyncSetField(endpointA_.ctx, DELTA_FIELD_BATTERY_LEVEL, LEVEL2), SOFTBUS_OK);
+    EXPECT_EQ(LnnDeltaSyncFlush(endpointA_.ctx, NETWORKID_B), SOFTBUS_OK);
+    Pump();
+    ASSERT_GE(endpointA_.sentLen.size(), 3U);
+    EXPECT_EQ(endpointA_.sentLen[1], ONE_FIELD_MSG_LEN);
+    EXPECT_EQ(endpointA_.sentLen[2], TWO_FIELD_MSG_LEN);
+    EXPECT_EQ(endpointB_.ledger[DELTA_FIELD_BATTERY_LEVEL], LEVEL2);
+    EXPECT_EQ(endpointB_.ledger[DELTA_FIELD_BATTERY_CHARGING], 1);
+    EXPECT_TRUE(LnnDeltaSyncIsPeerCapable(endpointA_.ctx, NETWORKID_B));
+}
+
+/*
+ * @tc.name: DELTA_SYNC_STALE_FULL_TEST_001
+ * @tc.desc: a full table older than the last applied version does not roll the peer fields back
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LNNDeltaSyncTest, DELTA_SYNC_STALE_FULL_TEST_001, TestSize.Level1)
+{
+    EXPECT_EQ(LnnDeltaSyncSetField(endpointA_.ctx, DELTA_FIELD_BATTERY_LEVEL, LEVEL1), SOFTBUS_OK);
+    EXPECT_EQ(LnnDeltaSyncFlush(endpointA_.ctx, NETWORKID_B), SOFTBUS_OK);
+    ASSERT_FALSE(channel_.queue.empty());
+    LoopbackMsg staleFull = channel_.queue.front();
+    Pump();
+    EXPECT_EQ(LnnDeltaSyncSetField(endpointA_.ctx, DELTA_FIELD_BATTERY_LEVEL, LEVEL2), SOFTBUS_OK);
+    EXPECT_EQ(LnnDeltaSyncFlush(endpointA_.ctx, NETWORKID_B), SOFTBUS_OK);
+    Pump();
+    EXPECT_EQ(endpointB_.ledger[DELTA_FIELD_BATTERY_LEVEL], LEVEL2);
+    uint32_t applyCnt = endpointB_.applyCnt;
+
+    EXPECT_EQ(LnnDeltaSyncOnRecv(endpointB_.ctx, NETWORKID_A, staleFull.data.data(), staleFull.data.size()),
+        SOFTBUS_OK);
+    Pump();
+    EXPECT_EQ(endpointB_.ledger[DELTA_FIELD_BATTERY_LEVEL], LEVEL2);
+    EXPECT_EQ(endpointB_.applyCnt, applyCnt);
+}
+
+/*
+ * @tc.name: DELTA_SYNC_BIDIRECTIONAL_TEST_001
+ * @tc.desc: both ledgers sync their own fields over the same channel
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LNNDeltaSyncTest, DELTA_SYNC_BIDIRECTIONAL_TEST_001, TestSize.Level1)
+{
+    EXPECT_EQ(LnnDeltaSyncSetField(endpointA_.ctx, DELTA_FIELD_BATTERY_LEVEL, LEVEL1), SOFTBUS_OK);
+    EXPECT_EQ(LnnDeltaSyncSetField(endpointB_.ctx, DELTA_FIELD_BATTERY_LEVEL, LEVEL2), SOFTBUS_OK);
+    EXPECT_EQ(LnnDeltaSyncFlush(endpointA_.ctx, NETWORKID_B), SOFTBUS_OK);
+    EXPECT_EQ(LnnDeltaSyncFlush(endpointB_.ctx, NETWORKID_A), SOFTBUS_OK);
+    Pump();
+    EXPECT_EQ(endpointA_.ledger[DELTA_FIELD_BATTERY_LEVEL], LEVEL2);
+    EXPECT_EQ(endpointB_.ledger[DELTA_FIELD_BATTERY_LEVEL], LEVEL1);
+
+    LnnDeltaSyncRemovePeer(endpointA_.ctx, NETWORKID_B);
+    EXPECT_FALSE(LnnDeltaSyncIsPeerCapable(endpointA_.ctx, NETWORKID_B));
+    EXPECT_TRUE(LnnDeltaSyncIsPeerCapable(endpointB_.ctx, NETWORKID_A));
+}
+
+/*
+ * @tc.name: DELTA_SYNC_INVALID_MSG_TEST_001
+ * @tc.desc: truncated or malformed messages are rejected
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LNNDeltaSyncTest, DELTA_SYNC_INVALID_MSG_TEST_001, TestSize.Level1)
+{
+    uint8_t msg[MAX_MSG_LEN] = { 0 };
+    EXPECT_EQ(LnnDeltaSyncOnRecv(nullptr, NETWORKID_A, msg, sizeof(msg)), SOFTBUS_INVALID_PARAM);
+    EXPECT_EQ(LnnDeltaSyncOnRecv(endpointB_.ctx, NETWORKID_A, msg, DELTA_MSG_HEAD_LEN - 1),
+        SOFTBUS_INVALID_DATA_HEAD);
+    msg[0] = DELTA_MSG_BUTT;
+    EXPECT_EQ(LnnDeltaSyncOnRecv(endpointB_.ctx, NETWORKID_A, msg, sizeof(msg)), SOFTBUS_INVALID_DATA_HEAD);
+    msg[0] = DELTA_MSG_FULL;
+    msg[1] = DELTA_FIELD_BUTT;
+    EXPECT_EQ(LnnDeltaSyncOnRecv(endpointB_.ctx, NETWORKID_A, msg, DELTA_MSG_HEAD_LEN), SOFTBUS_INVALID_DATA_HEAD);
+    EXPECT_EQ(LnnDeltaSyncSetField(endpointA_.ctx, DELTA_FIELD_BUTT, 0), SOFTBUS_INVALID_PARAM);
+    EXPECT_EQ(LnnCreateDeltaSyncCtx(nullptr, EPOCH_A), nullptr);
+}
+
+/*
+ * @tc.name: DELTA_SYNC_UNSET_FIELD_TEST_001
+ * @tc.desc: a full table only carries the fields that were set, unset fields are left alone on the peer
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LNNDeltaSyncTest, DELTA_SYNC_UNSET_FIELD_TEST_001, TestSize.Level1)
+{
+    endpointB_.ledger[DELTA_FIELD_NET_CAPABILITY] = NET_CAPABILITY;
+    EXPECT_EQ(LnnDeltaSyncSetField(endpointA_.ctx, DELTA_FIELD_BATTERY_LEVEL, LEVEL1), SOFTBUS_OK);
+    EXPECT_EQ(LnnDeltaSyncFlush(endpointA_.ctx, NETWORKID_B), SOFTBUS_OK);
+    Pump();
+    ASSERT_EQ(endpointA_.sentLen.size(), 1U);
+    EXPECT_EQ(endpointA_.sentLen[0], ONE_FIELD_MSG_LEN);
+    EXPECT_EQ(endpointB_.lastMask, DELTA_FIELD_MASK(DELTA_FIELD_BATTERY_LEVEL));
+    EXPECT_EQ(endpointB_.ledger[DELTA_FIELD_NET_CAPABILITY], NET_CAPABILITY);
+}
+
+static uint32_t g_batteryHandlerCnt = 0;
+static uint32_t g_capabilityHandlerCnt = 0;
+static int32_t g_lastCapability = 0;
+
+static void BatteryFieldHandler(const char *networkId, const int32_t *values, uint32_t changedMask)
+{
+    (void)networkId;
+    (void)values;
+    (void)changedMask;
+    g_batteryHandlerCnt++;
+}
+
+static void CapabilityFieldHandler(const char *networkId, const int32_t *values, uint32_t changedMask)
+{
+    (void)networkId;
+    (void)changedMask;
+    g_capabilityHandlerCnt++;
+    g_lastCapability = values[DELTA_FIELD_NET_CAPABILITY];
+}
+
+/*
+ * @tc.name: DELTA_SYNC_LOCAL_FIELDS_TEST_001
+ * @tc.desc: a peer without the delta sync feature gets nothing from delta sync, the caller sends legacy instead
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LNNDeltaSyncTest, DELTA_SYNC_LOCAL_FIELDS_TEST_001, TestSize.Level1)
+{
+    NiceMock<LnnSyncInfoInterfaceMock> syncInfoMock;
+    NiceMock<LnnNetLedgertInterfaceMock> ledgerMock;
+    NiceMock<LnnServicetInterfaceMock> serviceMock;
+    DeltaSyncField fields[] = { DELTA_FIELD_BATTERY_LEVEL, DELTA_FIELD_BATTERY_CHARGING };
+    int32_t values[] = { LEVEL1, 1 };
+    EXPECT_EQ(LnnDeltaSyncLocalFields(NETWORKID_B, fields, values, 2), SOFTBUS_FUNC_NOT_SUPPORT);
+    EXPECT_CALL(syncInfoMock, LnnRegSyncInfoHandler(LNN_INFO_TYPE_DELTA_INFO, _)).WillOnce(Return(SOFTBUS_OK));
+    ASSERT_EQ(LnnInitDeltaSync(), SOFTBUS_OK);
+
+    EXPECT_CALL(ledgerMock, LnnGetLocalNumU64Info).WillRepeatedly(Return(SOFTBUS_OK));
+    EXPECT_CALL(ledgerMock, LnnGetRemoteNodeInfoById).WillRepeatedly(Return(SOFTBUS_OK));
+    EXPECT_CALL(serviceMock, IsFeatureSupport).WillRepeatedly(Return(false));
+    EXPECT_CALL(syncInfoMock, LnnSendSyncInfoMsg(LNN_INFO_TYPE_DELTA_INFO, _, _, _, _)).Times(0);
+    EXPECT_EQ(LnnDeltaSyncLocalFields(NETWORKID_B, fields, values, 2), SOFTBUS_FUNC_NOT_SUPPORT);
+    EXPECT_EQ(g_deltaSyncCtx->peerNum, 0U);
+
+    EXPECT_CALL(serviceMock, IsFeatureSupport).WillRepeatedly(Return(true));
+    std::vector<uint32_t> sentLen;
+    EXPECT_CALL(syncInfoMock, LnnSendSyncInfoMsg(LNN_INFO_TYPE_DELTA_INFO, _, _, _, _))
+        .Times(2)
+        .WillRepeatedly([&sentLen](LnnSyncInfoType, const char *, const uint8_t *, uint32_t len,
+            LnnSyncInfoMsgComplete) {
+            sentLen.push_back(len);
+            return SOFTBUS_OK;
+        });
+    EXPECT_EQ(LnnDeltaSyncLocalFields(NETWORKID_B, fields, values, 2), SOFTBUS_OK);
+    DeltaMsgBuf ack;
+    DeltaMsgHead head = { .type = DELTA_MSG_ACK, .epoch = g_deltaSyncCtx->epoch, .version = g_deltaSyncCtx->version };
+    PackMsg(&ack, &head, nullptr, 0);
+    OnReceiveDeltaInfo(LNN_INFO_TYPE_DELTA_INFO, NETWORKID_B, ack.buf, ack.len);
+    values[0] = LEVEL2;
+    EXPECT_EQ(LnnDeltaSyncLocalFields(NETWORKID_B, fields, values, 2), SOFTBUS_OK);
+    ASSERT_EQ(sentLen.size(), 2U);
+    EXPECT_EQ(sentLen[0], TWO_FIELD_MSG_LEN);
+    EXPECT_EQ(sentLen[1], ONE_FIELD_MSG_LEN);
+    LnnDeinitDeltaSync();
+}
+
+/*
+ * @tc.name: DELTA_SYNC_FIELD_HANDLER_TEST_001
+ * @tc.desc: received fields reach the handler registered for them, once per message
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LNNDeltaSyncTest, DELTA_SYNC_FIELD_HANDLER_TEST_001, TestSize.Level1)
+{
+    NiceMock<LnnSyncInfoInterfaceMock> syncInfoMock;
+    NiceMock<LnnServicetInterfaceMock> serviceMock;
+    EXPECT_EQ(LnnRegDeltaSyncFieldHandler(DELTA_FIELD_BATTERY_LEVEL, BatteryFieldHandler), SOFTBUS_NO_INIT);
+    EXPECT_CALL(syncInfoMock, LnnRegSyncInfoHandler(LNN_INFO_TYPE_DELTA_INFO, _)).WillOnce(Return(SOFTBUS_OK));
+    ASSERT_EQ(LnnInitDeltaSync(), SOFTBUS_OK);
+    EXPECT_EQ(LnnRegDeltaSyncFieldHandler(DELTA_FIELD_BUTT, BatteryFieldHandler), SOFTBUS_INVALID_PARAM);
+    EXPECT_EQ(LnnRegDeltaSyncFieldHandler(DELTA_FIELD_BATTERY_LEVEL, BatteryFieldHandler), SOFTBUS_OK);
+    EXPECT_EQ(LnnRegDeltaSyncFieldHandler(DELTA_FIELD_BATTERY_CHARGING, BatteryFieldHandler), SOFTBUS_OK);
+    EXPECT_EQ(LnnRegDeltaSyncFieldHandler(DELTA_FIELD_NET_CAPABILITY, CapabilityFieldHandler), SOFTBUS_OK);
+    EXPECT_EQ(LnnRegDeltaSyncFieldHandler(DELTA_FIELD_NET_CAPABILITY, BatteryFieldHandler), SOFTBUS_INVALID_PARAM);
+
+    g_batteryHandlerCnt = 0;
+    g_capabilityHandlerCnt = 0;
+    int32_t values[DELTA_FIELD_BUTT] = { LEVEL2, 1, NET_CAPABILITY };
+    ApplyDeltaSyncFields(g_deltaSyncCtx, NETWORKID_B, values,
+        DELTA_FIELD_MASK(DELTA_FIELD_BATTERY_LEVEL) | DELTA_FIELD_MASK(DELTA_FIELD_BATTERY_CHARGING));
+    EXPECT_EQ(g_batteryHandlerCnt, 1U);
+    EXPECT_EQ(g_capabilityHandlerCnt, 0U);
+    ApplyDeltaSyncFields(g_deltaSyncCtx, NETWORKID_B, values, DELTA_FIELD_MASK(DELTA_FIELD_NET_CAPABILITY));
+    EXPECT_EQ(g_batteryHandlerCnt, 1U);
+    EXPECT_EQ(g_capabilityHandlerCnt, 1U);
+    EXPECT_EQ(g_lastCapability, NET_CAPABILITY);
+
+    LnnUnregDeltaSyncFieldHandler(DELTA_FIELD_NET_CAPABILITY, CapabilityFieldHandler);
+    ApplyDeltaSyncFields(g_deltaSyncCtx, NETWORKID_B, values, DELTA_FIELD_MASK(DELTA_FIELD_NET_CAPABILITY));
+    EXPECT_EQ(g_capabilityHandlerCnt, 1U);
+    LnnDeinitDeltaSync();
+}
+
+/*
+ * @tc.name: DELTA_SYNC_PEER_OFFLINE_TEST_001
+ * @tc.desc: an offline node loses its delta state and gets a full table again
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LNNDeltaSyncTest, DELTA_SYNC_PEER_OFFLINE_TEST_001, TestSize.Level1)
+{
+    NiceMock<LnnSyncInfoInterfaceMock> syncInfoMock;
+    NiceMock<LnnNetLedgertInterfaceMock> ledgerMock;
+    NiceMock<LnnServicetInterfaceMock> serviceMock;
+    EXPECT_CALL(syncInfoMock, LnnRegSyncInfoHandler(LNN_INFO_TYPE_DELTA_INFO, _)).WillOnce(Return(SOFTBUS_OK));
+    EXPECT_CALL(serviceMock, LnnRegisterEventHandler(LNN_EVENT_NODE_ONLINE_STATE_CHANGED, _))
+        .WillOnce(Return(SOFTBUS_OK));
+    EXPECT_CALL(serviceMock, IsFeatureSupport).WillRepeatedly(Return(true));
+    EXPECT_CALL(syncInfoMock, LnnSendSyncInfoMsg(LNN_INFO_TYPE_DELTA_INFO, _, _, _, _))
+        .WillRepeatedly(Return(SOFTBUS_OK));
+    ASSERT_EQ(LnnInitDeltaSync(), SOFTBUS_OK);
+    DeltaSyncField field = DELTA_FIELD_BATTERY_LEVEL;
+    EXPECT_EQ(LnnDeltaSyncLocalFields(NETWORKID_B, &field, &LEVEL1, 1), SOFTBUS_OK);
+    DeltaMsgBuf ack;
+    DeltaMsgHead head = { .type = DELTA_MSG_ACK, .epoch = g_deltaSyncCtx->epoch, .version = g_deltaSyncCtx->version };
+    PackMsg(&ack, &head, nullptr, 0);
+    OnReceiveDeltaInfo(LNN_INFO_TYPE_DELTA_INFO, NETWORKID_B, ack.buf, ack.len);
+    EXPECT_TRUE(LnnDeltaSyncIsPeerCapable(g_deltaSyncCtx, NETWORKID_B));
+
+    LnnOnlineStateEventInfo stateInfo;
+    (void)memset_s(&stateInfo, sizeof(stateInfo), 0, sizeof(stateInfo));
+    stateInfo.basic.event = LNN_EVENT_NODE_ONLINE_STATE_CHANGED;
+    stateInfo.isOnline = true;
+    stateInfo.networkId = NETWORKID_B;
+    OnDeltaSyncOnlineStateChange(reinterpret_cast<const LnnEventBasicInfo *>(&stateInfo));
+    EXPECT_TRUE(LnnDeltaSyncIsPeerCapable(g_deltaSyncCtx, NETWORKID_B));
+    stateInfo.isOnline = false;
+    OnDeltaSyncOnlineStateChange(reinterpret_cast<const LnnEventBasicInfo *>(&stateInfo));
+    EXPECT_FALSE(LnnDeltaSyncIsPeerCapable(g_deltaSyncCtx, NETWORKID_B));
+    EXPECT_EQ(g_deltaSyncCtx->peerNum, 0U);
+    LnnDeinitDeltaSync();
+}
+} // namespace OHOS
@@ -16,6 +16,7 @@
 #include <gtest/gtest.h>
 #include <securec.h>
 
+#include "lnn_delta_sync.h"
 #include "lnn_net_builder_mock.h"
 #include "lnn_net_ledger_mock.h"
 #include "lnn_network_info.c"
@@ -80,6 +81,8 @@ int32_t TestLnnRequestLeaveSpecific(const char *networkId, ConnectionAddrType ad
 HWTEST_F(LNNNetworkInfoTest, LNN_INIT_NETWORK_INFO_TEST_001, TestSize.Level1)
 {
     NiceMock<LnnServicetInterfaceMock> serviceMock;
+    NiceMock<LnnSyncInfoInterfaceMock> syncInfoMock;
+    ASSERT_EQ(LnnInitDeltaSync(), SOFTBUS_OK);
     EXPECT_CALL(serviceMock, SoftBusHasWifiDirectCapability).WillRepeatedly(Return(true));
     EXPECT_CALL(serviceMock, SoftBusGetWifiInterfaceCoexistCap).WillRepeatedly(Return(nullptr));
     EXPECT_CALL(serviceMock, LnnRegisterEventHandler)
@@ -87,7 +90,6 @@ HWTEST_F(LNNNetworkInfoTest, LNN_INIT_NETWORK_INFO_TEST_001, TestSize.Level1)
         .WillOnce(Return(SOFTBUS_OK))
         .WillOnce(Return(SOFTBUS_INVALID_PARAM))
         .WillRepeatedly(Return(SOFTBUS_OK));
-    NiceMock<LnnSyncInfoInterfaceMock> syncInfoMock;
     EXPECT_CALL(syncInfoMock, LnnRegSyncInfoHandler)
         .WillOnce(Return(SOFTBUS_INVALID_PARAM))
         .WillRepeatedly(Return(SOFTBUS_OK));
@@ -122,6 +124,8 @@ HWTEST_F(LNNNetworkInfoTest, LNN_INIT_NETWORK_INFO_TEST_001, TestSize.Level1)
     EXPECT_EQ(LnnInitNetworkInfo(), SOFTBUS_INVALID_PARAM);
     EXPECT_EQ(LnnInitNetworkInfo(), SOFTBUS_INVALID_PARAM);
     EXPECT_EQ(LnnInitNetworkInfo(), SOFTBUS_OK);
+    LnnDeinitNetworkInfo();
+    LnnDeinitDeltaSync();
 }
 
 /*
@@ -119,6 +119,16 @@ int32_t LnnIpcNotifyBasicInfoChanged(void *info, uint32_t infoTypeLen, int32_t t
     return GetBusCenterEventDepsInterface()->LnnIpcNotifyBasicInfoChanged(info, infoTypeLen, type);
 }
 
+int32_t LnnIpcNotifyNodeStateBatch(const NodeStateBatchItem *items, uint32_t num)
+{
+    return GetBusCenterEventDepsInterface()->LnnIpcNotifyNodeStateBatch(items, num);
+}
+
+int32_t LnnIpcNotifyNodeStateNoBatch(const NodeStateBatchItem *item)
+{
+    return GetBusCenterEventDepsInterface()->LnnIpcNotifyNodeStateNoBatch(item);
+}
+
 int32_t LnnGenLocalNetworkId(char *networkId, uint32_t len)
 {
     return GetBusCenterEventDepsInterface()->LnnGenLocalNetworkId(networkId, len);
@@ -22,6 +22,7 @@
 #include "lnn_distributed_net_ledger.h"
 #include "lnn_node_info.h"
 #include "message_handler.h"
+#include "node_state_batch_inner.h"
 #include "softbus_common.h"
 #include "softbus_utils.h"
 
@@ -49,6 +50,8 @@ public:
     virtual int32_t LnnIpcNotifyOnlineState(bool isOnline, void *info, uint32_t infoTypeLen);
     virtual void LnnDCProcessOnlineState(bool isOnline, const NodeBasicInfo *info);
     virtual int32_t LnnIpcNotifyBasicInfoChanged(void *info, uint32_t infoTypeLen, int32_t type);
+    virtual int32_t LnnIpcNotifyNodeStateBatch(const NodeStateBatchItem *items, uint32_t num);
+    virtual int32_t LnnIpcNotifyNodeStateNoBatch(const NodeStateBatchItem *item);
     virtual int32_t LnnGenLocalNetworkId(char *networkId, uint32_t len);
     virtual int32_t LnnIpcLocalNetworkIdChanged(void);
     virtual int32_t LnnSetLocalStrInfo(InfoKey key, const char *info);
@@ -76,6 +79,8 @@ public:
     MOCK_METHOD3(LnnIpcNotifyOnlineState, int32_t (bool, void *, uint32_t));
     MOCK_METHOD2(LnnDCProcessOnlineState, void (bool, const NodeBasicInfo *));
     MOCK_METHOD3(LnnIpcNotifyBasicInfoChanged, int32_t (void *, uint32_t, int32_t));
+    MOCK_METHOD2(LnnIpcNotifyNodeStateBatch, int32_t (const NodeStateBatchItem *, uint32_t));
+    MOCK_METHOD1(LnnIpcNotifyNodeStateNoBatch, int32_t (const NodeStateBatchItem *));
     MOCK_METHOD2(LnnGenLocalNetworkId, int32_t (char *, uint32_t));
     MOCK_METHOD0(LnnIpcLocalNetworkIdChanged, int32_t (void));
     MOCK_METHOD2(LnnSetLocalStrInfo, int32_t (InfoKey, const char *));
@@ -18,6 +18,7 @@
 #include <securec.h>
 #include <cstdbool>
 #include <cstdint>
+#include <vector>
 
 #include "anonymizer.h"
 #include "bus_center_event.h"
@@ -40,12 +41,18 @@
 #include "softbus_def.h"
 #include "softbus_common.h"
 #include "softbus_error_code.h"
+#include "softbus_feature_config.h"
 #include "softbus_qos.h"
 #include "softbus_bus_center.h"
 
 using namespace testing;
 using namespace testing::ext;
 constexpr char NODE1_NETWORK_ID[] = "235689BNHFCF";
+constexpr uint32_t NOTIFY_BATCH_WINDOW = 50;
+constexpr uint32_t STORM_NODE_NUM = 40;
+constexpr uint32_t STORM_INFO_CHANGED_NUM = 10;
+constexpr uint32_t STORM_OFFLINE_NUM = 10;
+constexpr uint32_t OVERFLOW_NODE_NUM = 100;
 
 typedef enum {
     NOTIFY_ONLINE_STATE_CHANGED = 0,
@@ -53,6 +60,9 @@ typedef enum {
     NOTIFY_NODE_STATUS_CHANGED,
     NOTIFY_NETWORKID_UPDATE,
     NOTIFY_LOCAL_NETWORKID_UPDATE,
+    NOTIFY_DEVICE_TRUSTED_CHANGED,
+    NOTIFY_STATE_SESSION,
+    NOTIFY_NODE_STATE_BATCH_FLUSH,
 } NotifyType;
 
 namespace OHOS {
@@ -793,4 +803,242 @@ HWTEST_F(BusCenterEventTest, BusCenterEventTest037, TestSize.Level1)
     EXPECT_NO_FATAL_FAILURE(LnnNotifyOnlineState(isOnline, &info));
 }
 
+static std::vector<SoftBusMessage *> g_fakeLooperMsgs;
+
+static void FakeLooperPostMessage(const SoftBusLooper *looper, SoftBusMessage *msg)
+{
+    (void)looper;
+    g_fakeLooperMsgs.push_back(msg);
+}
+
+static void FakeLooperPostMessageDelay(const SoftBusLooper *looper, SoftBusMessage *msg, uint64_t delayMillis)
+{
+    (void)looper;
+    (void)delayMillis;
+    g_fakeLooperMsgs.push_back(msg);
+}
+
+static void FakeLooperRemoveMessage(const SoftBusLooper *looper, const SoftBusHandler *handler, int32_t what)
+{
+    (void)looper;
+    for (auto it = g_fakeLooperMsgs.begin(); it != g_fakeLooperMsgs.end();) {
+        if ((*it)->handler == handler && (*it)->what == what) {
+            (*it)->FreeMessage(*it);
+            it = g_fakeLooperMsgs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/* the fake looper is released by LnnDeinitBusCenterEvent through DestroyLooper */
+static SoftBusLooper *CreateFakeLooper(void)
+{
+    SoftBusLooper *looper = static_cast<SoftBusLooper *>(SoftBusCalloc(sizeof(SoftBusLooper)));
+    if (looper == nullptr) {
+        return nullptr;
+    }
+    looper->PostMessage = FakeLooperPostMessage;
+    looper->PostMessageDelay = FakeLooperPostMessageDelay;
+    looper->RemoveMessage = FakeLooperRemoveMessage;
+    return looper;
+}
+
+/* delayed messages are handled in post order, so a window always expires after the events posted before it */
+static void RunFakeLooper(void)
+{
+    while (!g_fakeLooperMsgs.empty()) {
+        SoftBusMessage *msg = g_fakeLooperMsgs.front();
+        g_fakeLooperMsgs.erase(g_fakeLooperMsgs.begin());
+        msg->handler->HandleMessage(msg);
+        msg->FreeMessage(msg);
+    }
+}
+
+static void SetNotifyBatchWindow(uint32_t window)
+{
+    (void)SoftbusSetConfig(SOFTBUS_INT_LNN_NOTIFY_BATCH_WINDOW, (const unsigned char *)&window, sizeof(window));
+}
+
+static void GenStormNodeInfo(uint32_t index, NodeBasicInfo *info)
+{
+    (void)memset_s(info, sizeof(NodeBasicInfo), 0, sizeof(NodeBasicInfo));
+    (void)sprintf_s(info->networkId, sizeof(info->networkId), "stormNetworkId%u", index);
+    (void)sprintf_s(info->deviceName, sizeof(info->deviceName), "stormDevice%u", index);
+    info->deviceTypeId = 1;
+}
+
+/*
+ * @tc.name: BusCenterEventTest038
+ * @tc.desc: Test node state changes of a join storm are coalesced into one batch notification.
+ * @tc.type: FUNC
+ * @tc.require: 1
+ */
+HWTEST_F(BusCenterEventTest, BusCenterEventTest038, TestSize.Level1)
+{
+    NiceMock<BusCenterEventDepsInterfaceMock> BusCenterEventMock;
+    std::vector<NodeStateBatchItem> notified;
+    uint32_t batchCnt = 0;
+    uint32_t noBatchCnt = 0;
+    EXPECT_CALL(BusCenterEventMock, CreateNewLooper(_)).WillOnce(Return(CreateFakeLooper()));
+    EXPECT_CALL(BusCenterEventMock, LnnGetAllOnlineNodeNum(_)).WillRepeatedly(Return(SOFTBUS_INVALID_PARAM));
+    EXPECT_CALL(BusCenterEventMock, LnnIpcNotifyOnlineState(_, _, _)).Times(0);
+    EXPECT_CALL(BusCenterEventMock, LnnIpcNotifyBasicInfoChanged(_, _, _)).Times(0);
+    EXPECT_CALL(BusCenterEventMock, LnnIpcNotifyNodeStateNoBatch(_))
+        .WillRepeatedly(Invoke([&noBatchCnt, &batchCnt](const NodeStateBatchItem *item) {
+            (void)item;
+            // clients without batches are notified on every change, before the window expires
+            EXPECT_EQ(batchCnt, 0U);
+            noBatchCnt++;
+            return SOFTBUS_OK;
+        }));
+    EXPECT_CALL(BusCenterEventMock, LnnIpcNotifyNodeStateBatch(_, _))
+        .WillRepeatedly(Invoke([&notified, &batchCnt](const NodeStateBatchItem *items, uint32_t num) {
+            notified.insert(notified.end(), items, items + num);
+            batchCnt++;
+            return SOFTBUS_OK;
+        }));
+    ASSERT_EQ(LnnInitBusCenterEvent(), SOFTBUS_OK);
+    SetNotifyBatchWindow(NOTIFY_BATCH_WINDOW);
+
+    NodeBasicInfo info;
+    for (uint32_t i = 0; i < STORM_NODE_NUM; ++i) {
+        GenStormNodeInfo(i, &info);
+        LnnNotifyOnlineState(true, &info);
+    }
+    for (uint32_t i = 0; i < STORM_INFO_CHANGED_NUM; ++i) {
+        GenStormNodeInfo(i, &info);
+        LnnNotifyBasicInfoChanged(&info, TYPE_DEVICE_NAME);
+        LnnNotifyBasicInfoChanged(&info, TYPE_DEVICE_NAME);
+    }
+    for (uint32_t i = STORM_NODE_NUM - STORM_OFFLINE_NUM; i < STORM_NODE_NUM; ++i) {
+        GenStormNodeInfo(i, &info);
+        LnnNotifyOnlineState(false, &info);
+    }
+    RunFakeLooper();
+
+    EXPECT_EQ(batchCnt, 1U);
+    EXPECT_EQ(noBatchCnt, STORM_NODE_NUM + STORM_INFO_CHANGED_NUM * 2 + STORM_OFFLINE_NUM);
+    EXPECT_EQ(notified.size(), STORM_NODE_NUM + STORM_INFO_CHANGED_NUM + STORM_OFFLINE_NUM);
+    uint32_t onlineCnt = 0;
+    uint32_t offlineCnt = 0;
+    uint32_t infoChangedCnt = 0;
+    for (const auto &item : notified) {
+        if (item.event == NODE_STATE_BATCH_ONLINE) {
+            onlineCnt++;
+        } else if (item.event == NODE_STATE_BATCH_OFFLINE) {
+            offlineCnt++;
+        } else if (item.event == NODE_STATE_BATCH_BASIC_INFO_CHANGED) {
+            EXPECT_EQ(item.type, TYPE_DEVICE_NAME);
+            infoChangedCnt++;
+        }
+    }
+    EXPECT_EQ(onlineCnt, STORM_NODE_NUM);
+    EXPECT_EQ(offlineCnt, STORM_OFFLINE_NUM);
+    EXPECT_EQ(infoChangedCnt, STORM_INFO_CHANGED_NUM);
+    LnnDeinitBusCenterEvent();
+}
+
+/*
+ * @tc.name: BusCenterEventTest039
+ * @tc.desc: Test a join storm larger than one batch is split at NODE_STATE_BATCH_MAX_NUM.
+ * @tc.type: FUNC
+ * @tc.require: 1
+ */
+HWTEST_F(BusCenterEventTest, BusCenterEventTest039, TestSize.Level1)
+{
+    NiceMock<BusCenterEventDepsInterfaceMock> BusCenterEventMock;
+    std::vector<uint32_t> batchSizes;
+    EXPECT_CALL(BusCenterEventMock, CreateNewLooper(_)).WillOnce(Return(CreateFakeLooper()));
+    EXPECT_CALL(BusCenterEventMock, LnnGetAllOnlineNodeNum(_)).WillRepeatedly(Return(SOFTBUS_INVALID_PARAM));
+    EXPECT_CALL(BusCenterEventMock, LnnIpcNotifyOnlineState(_, _, _)).Times(0);
+    EXPECT_CALL(BusCenterEventMock, LnnIpcNotifyNodeStateBatch(_, _))
+        .WillRepeatedly(Invoke([&batchSizes](const NodeStateBatchItem *items, uint32_t num) {
+            (void)items;
+            batchSizes.push_back(num);
+            return SOFTBUS_OK;
+        }));
+    ASSERT_EQ(LnnInitBusCenterEvent(), SOFTBUS_OK);
+    SetNotifyBatchWindow(NOTIFY_BATCH_WINDOW);
+
+    NodeBasicInfo info;
+    for (uint32_t i = 0; i < OVERFLOW_NODE_NUM; ++i) {
+        GenStormNodeInfo(i, &info);
+        LnnNotifyOnlineState(true, &info);
+    }
+    RunFakeLooper();
+
+    ASSERT_EQ(batchSizes.size(), 2U);
+    EXPECT_EQ(batchSizes[0], static_cast<uint32_t>(NODE_STATE_BATCH_MAX_NUM));
+    EXPECT_EQ(batchSizes[1], OVERFLOW_NODE_NUM - static_cast<uint32_t>(NODE_STATE_BATCH_MAX_NUM));
+    LnnDeinitBusCenterEvent();
+}
+
+/*
+ * @tc.name: BusCenterEventTest040
+ * @tc.desc: Test a zero batch window keeps notifying every node state change on its own.
+ * @tc.type: FUNC
+ * @tc.require: 1
+ */
+HWTEST_F(BusCenterEventTest, BusCenterEventTest040, TestSize.Level1)
+{
+    NiceMock<BusCenterEventDepsInterfaceMock> BusCenterEventMock;
+    EXPECT_CALL(BusCenterEventMock, CreateNewLooper(_)).WillOnce(Return(CreateFakeLooper()));
+    EXPECT_CALL(BusCenterEventMock, LnnGetAllOnlineNodeNum(_)).WillRepeatedly(Return(SOFTBUS_INVALID_PARAM));
+    EXPECT_CALL(BusCenterEventMock, LnnIpcNotifyOnlineState(_, _, _)).Times(STORM_NODE_NUM);
+    EXPECT_CALL(BusCenterEventMock, LnnIpcNotifyNodeStateBatch(_, _)).Times(0);
+    EXPECT_CALL(BusCenterEventMock, LnnIpcNotifyNodeStateNoBatch(_)).Times(0);
+    ASSERT_EQ(LnnInitBusCenterEvent(), SOFTBUS_OK);
+    SetNotifyBatchWindow(0);
+
+    NodeBasicInfo info;
+    for (uint32_t i = 0; i < STORM_NODE_NUM; ++i) {
+        GenStormNodeInfo(i, &info);
+        LnnNotifyOnlineState(true, &info);
+    }
+    RunFakeLooper();
+
+    SetNotifyBatchWindow(NOTIFY_BATCH_WINDOW);
+    LnnDeinitBusCenterEvent();
+}
+
+/*
+ * @tc.name: BusCenterEventTest041
+ * @tc.desc: Test an offline followed by an online within one window keeps both events in order,
+ *           only repeats of the same state are coalesced.
+ * @tc.type: FUNC
+ * @tc.require: 1
+ */
+HWTEST_F(BusCenterEventTest, BusCenterEventTest041, TestSize.Level1)
+{
+    NiceMock<BusCenterEventDepsInterfaceMock> BusCenterEventMock;
+    std::vector<NodeStateBatchItem> notified;
+    EXPECT_CALL(BusCenterEventMock, CreateNewLooper(_)).WillOnce(Return(CreateFakeLooper()));
+    EXPECT_CALL(BusCenterEventMock, LnnGetAllOnlineNodeNum(_)).WillRepeatedly(Return(SOFTBUS_INVALID_PARAM));
+    EXPECT_CALL(BusCenterEventMock, LnnIpcNotifyNodeStateBatch(_, _))
+        .WillRepeatedly(Invoke([&notified](const NodeStateBatchItem *items, uint32_t num) {
+            notified.insert(notified.end(), items, items + num);
+            return SOFTBUS_OK;
+        }));
+    ASSERT_EQ(LnnInitBusCenterEvent(), SOFTBUS_OK);
+    SetNotifyBatchWindow(NOTIFY_BATCH_WINDOW);
+
+    NodeBasicInfo info;
+    GenStormNodeInfo(0, &info);
+    LnnNotifyOnlineState(false, &info);
+    LnnNotifyOnlineState(false, &info);
+    LnnNotifyOnlineState(true, &info);
+    LnnNotifyBasicInfoChanged(&info, TYPE_DEVICE_NAME);
+    (void)strcpy_s(info.deviceName, sizeof(info.deviceName), "renamedDevice");
+    LnnNotifyOnlineState(true, &info);
+    RunFakeLooper();
+
+    ASSERT_EQ(notified.size(), 3U);
+    EXPECT_EQ(notified[0].event, NODE_STATE_BATCH_OFFLINE);
+    EXPECT_EQ(notified[1].event, NODE_STATE_BATCH_ONLINE);
+    EXPECT_STREQ(notified[1].info.deviceName, "renamedDevice");
+    EXPECT_EQ(notified[2].event, NODE_STATE_BATCH_BASIC_INFO_CHANGED);
+    LnnDeinitBusCenterEvent();
+}
+
 }
@@ -59,6 +59,9 @@ public:
         const char *pkgName, int32_t pid, const char *networkId, int32_t retCode) = 0;
     virtual int32_t ClinetOnNodeOnlineStateChanged(bool isOnline, void *info, uint32_t infoTypeLen) = 0;
     virtual int32_t ClinetOnNodeBasicInfoChanged(void *info, uint32_t infoTypeLen, int32_t type) = 0;
+    virtual int32_t ClientOnNodeStateBatch(
+        const NodeStateBatchItem *items, uint32_t num, IsNodeStateBatchPkgFunc isBatchPkg) = 0;
+    virtual int32_t ClientOnNodeStateNoBatch(const NodeStateBatchItem *item, IsNodeStateBatchPkgFunc isBatchPkg) = 0;
     virtual int32_t ClientOnTimeSyncResult(
         const char *pkgName, int32_t pid, const void *info, uint32_t infoTypeLen, int32_t retCode) = 0;
     virtual int32_t ClientOnPublishLNNResult(const char *pkgName, int32_t pid, int32_t publishId, int32_t reason) = 0;
@@ -94,6 +97,8 @@ public:
     MOCK_METHOD4(ClientOnLeaveLNNResult, int32_t(const char *, int32_t, const char *, int32_t));
     MOCK_METHOD3(ClinetOnNodeOnlineStateChanged, int32_t(bool, void *, uint32_t));
     MOCK_METHOD3(ClinetOnNodeBasicInfoChanged, int32_t(void *, uint32_t, int32_t));
+    MOCK_METHOD3(ClientOnNodeStateBatch, int32_t(const NodeStateBatchItem *, uint32_t, IsNodeStateBatchPkgFunc));
+    MOCK_METHOD2(ClientOnNodeStateNoBatch, int32_t(const NodeStateBatchItem *, IsNodeStateBatchPkgFunc));
     MOCK_METHOD5(ClientOnTimeSyncResult, int32_t(const char *, int32_t, const void *, uint32_t, int32_t));
     MOCK_METHOD4(ClientOnPublishLNNResult, int32_t(const char *, int32_t, int32_t, int32_t));
     MOCK_METHOD4(ClientOnRefreshLNNResult, int32_t(const char *, int32_t, int32_t, int32_t));
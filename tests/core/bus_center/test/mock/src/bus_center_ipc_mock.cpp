@@ -146,6 +146,16 @@ int32_t ClinetOnNodeBasicInfoChanged(void *info, uint32_t infoTypeLen, int32_t t
     return BusCenterIpcInterfaceInstance()->ClinetOnNodeBasicInfoChanged(info, infoTypeLen, type);
 }
 
+int32_t ClientOnNodeStateBatch(const NodeStateBatchItem *items, uint32_t num, IsNodeStateBatchPkgFunc isBatchPkg)
+{
+    return BusCenterIpcInterfaceInstance()->ClientOnNodeStateBatch(items, num, isBatchPkg);
+}
+
+int32_t ClientOnNodeStateNoBatch(const NodeStateBatchItem *item, IsNodeStateBatchPkgFunc isBatchPkg)
+{
+    return BusCenterIpcInterfaceInstance()->ClientOnNodeStateNoBatch(item, isBatchPkg);
+}
+
 int32_t ClientOnTimeSyncResult(
     const char *pkgName, int32_t pid, const void *info, uint32_t infoTypeLen, int32_t retCode)
 {
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "data/negotiate_message.h"
+#include "protocol/wifi_direct_protocol_factory.h"
+#include "softbus_error_code.h"
+
+namespace OHOS::SoftBus {
+static constexpr int INTERFACE_NUM = 2;
+static constexpr int SESSION_ID = 10086;
+static constexpr int BAND_WIDTH = 160;
+static constexpr int CENTER_20M = 5180;
+static constexpr int AUTH_PORT = 43521;
+static constexpr int PHYSICAL_RATE = 2400;
+static constexpr uint32_t CHALLENGE_CODE = 0x5a5a5a5a;
+
+static LinkInfo BuildLinkInfo()
+{
+    LinkInfo linkInfo;
+    linkInfo.SetLocalInterface("chba0");
+    linkInfo.SetRemoteInterface("chba0");
+    linkInfo.SetLocalLinkMode(LinkInfo::LinkMode::HML);
+    linkInfo.SetRemoteLinkMode(LinkInfo::LinkMode::HML);
+    linkInfo.SetCenter20M(CENTER_20M);
+    linkInfo.SetCenterFrequency1(CENTER_20M);
+    linkInfo.SetBandWidth(BAND_WIDTH);
+    linkInfo.SetSsid("OHOS-HML-1234");
+    linkInfo.SetBssid("0a:1b:2c:3d:4e:5f");
+    linkInfo.SetPsk("0123456789abcdef0123456789abcdef");
+    linkInfo.SetIsDhcp(false);
+    linkInfo.SetLocalIpv4Info(Ipv4Info("172.30.1.1"));
+    linkInfo.SetRemoteIpv4Info(Ipv4Info("172.30.1.2"));
+    linkInfo.SetAuthPort(AUTH_PORT);
+    linkInfo.SetMaxPhysicalRate(PHYSICAL_RATE);
+    linkInfo.SetLocalBaseMac("0a:1b:2c:3d:4e:01");
+    linkInfo.SetRemoteBaseMac("0a:1b:2c:3d:4e:02");
+    linkInfo.SetIsClient(false);
+    return linkInfo;
+}
+
+static std::vector<InterfaceInfo> BuildInterfaceInfoArray()
+{
+    std::vector<InterfaceInfo> interfaceArray;
+    for (int i = 0; i < INTERFACE_NUM; i++) {
+        InterfaceInfo info;
+        info.SetName(i == 0 ? "p2p0" : "chba0");
+        info.SetIpString(Ipv4Info(i == 0 ? "192.168.49.1" : "172.30.1.1"));
+        info.SetRole(i == 0 ? LinkInfo::LinkMode::GO : LinkInfo::LinkMode::HML);
+        info.SetSsid("OHOS-1234");
+        info.SetDynamicMac("0a:1b:2c:3d:4e:0" + std::to_string(i));
+        info.SetBaseMac("0a:1b:2c:3d:5e:0" + std::to_string(i));
+        info.SetPsk("0123456789abcdef");
+        info.SetCenter20M(CENTER_20M);
+        info.SetBandWidth(BAND_WIDTH);
+        info.SetIsEnable(true);
+        info.SetConnectedDeviceCount(1);
+        info.SetCapability(1);
+        info.SetReuseCount(1);
+        info.SetIsAvailable(true);
+        info.SetPhysicalRate(PHYSICAL_RATE);
+        interfaceArray.push_back(info);
+    }
+    return interfaceArray;
+}
+
+// every field a v2 connect request carries over the auth channel
+static NegotiateMessage BuildFullMessage()
+{
+    NegotiateMessage msg(NegotiateMessageType::CMD_CONN_V2_REQ_1);
+    msg.SetSessionId(SESSION_ID);
+    msg.SetWifiConfigInfo(std::vector<uint8_t>(64, 0x5a));
+    msg.SetIpv4InfoArray({ Ipv4Info("172.30.1.1"), Ipv4Info("172.30.2.1"), Ipv4Info("172.30.3.1") });
+    msg.SetPreferLinkMode(LinkInfo::LinkMode::HML);
+    msg.SetIsModeStrict(true);
+    msg.SetPreferLinkBandWidth(BAND_WIDTH);
+    msg.SetIsBridgeSupported(true);
+    msg.SetLinkInfo(BuildLinkInfo());
+    msg.SetResultCode(SOFTBUS_OK);
+    msg.SetInterfaceInfoArray(BuildInterfaceInfoArray());
+    msg.SetRemoteDeviceId(std::string(64, 'a'));
+    msg.SetRemoteNetworkId(std::string(64, 'b'));
+    msg.SetExtraData(std::vector<uint8_t>(32, 0xa5));
+    msg.SetIsProxyEnable(true);
+    msg.Set5GChannelList("36##40##44##48##149##153##157##161");
+    msg.Set5GChannelScore("36:80##40:80##44:70##48:70##149:100##153:90##157:90##161:80");
+    msg.SetChallengeCode(CHALLENGE_CODE);
+    msg.SetNewPtkFrame(true);
+    return msg;
+}
+
+static std::shared_ptr<WifiDirectProtocol> CreateTlvProtocol()
+{
+    auto protocol = WifiDirectProtocolFactory::CreateProtocol(ProtocolType::TLV);
+    protocol->SetFormat({ TlvProtocol::TLV_TAG_SIZE, TlvProtocol::TLV_LENGTH_SIZE2 });
+    return protocol;
+}
+
+class NegotiateMessageMarshalTest : public benchmark::Fixture {
+public:
+    NegotiateMessageMarshalTest()
+    {
+        Iterations(iterations);
+        Repetitions(repetitions);
+        ReportAggregatesOnly();
+    }
+    ~NegotiateMessageMarshalTest() override = default;
+    void SetUp(const ::benchmark::State &state) override
+    {
+        message_ = BuildFullMessage();
+        output_.clear();
+        message_.Marshalling(*CreateTlvProtocol(), output_);
+    }
+    void TearDown(const ::benchmark::State &state) override { }
+
+protected:
+    const int32_t repetitions = 3;
+    const int32_t iterations = 10000;
+    NegotiateMessage message_;
+    std::vector<uint8_t> output_;
+};
+
+/**
+ * @tc.name: MarshallingTestCase
+ * @tc.desc: Marshal a negotiate message carrying every v2 field into tlv
+ * @tc.type: PERF
+ * @tc.require: NegotiateMessage::Marshalling normal operation
+ */
+BENCHMARK_F(NegotiateMessageMarshalTest, MarshallingTestCase)(benchmark::State &state)
+{
+    while (state.KeepRunning()) {
+        std::vector<uint8_t> output;
+        message_.Marshalling(*CreateTlvProtocol(), output);
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetBytesProcessed(state.iterations() * output_.size());
+}
+BENCHMARK_REGISTER_F(NegotiateMessageMarshalTest, MarshallingTestCase);
+
+/**
+ * @tc.name: UnmarshallingTestCase
+ * @tc.desc: Unmarshal a tlv negotiate message carrying every v2 field
+ * @tc.type: PERF
+ * @tc.require: the unmarshalled message reads the same session and link info as the marshalled one
+ */
+BENCHMARK_F(NegotiateMessageMarshalTest, UnmarshallingTestCase)(benchmark::State &state)
+{
+    NegotiateMessage check;
+    check.Unmarshalling(*CreateTlvProtocol(), output_);
+    if (check.GetSessionId() != message_.GetSessionId() ||
+        check.GetLinkInfo().GetPsk() != message_.GetLinkInfo().GetPsk() ||
+        check.GetInterfaceInfoArray().size() != INTERFACE_NUM) {
+        state.SkipWithError("Unmarshalling mismatch.");
+    }
+    while (state.KeepRunning()) {
+        NegotiateMessage msg;
+        msg.Unmarshalling(*CreateTlvProtocol(), output_);
+        benchmark::DoNotOptimize(msg);
+    }
+    state.SetBytesProcessed(state.iterations() * output_.size());
+}
+BENCHMARK_REGISTER_F(NegotiateMessageMarshalTest, UnmarshallingTestCase);
+
+/**
+ * @tc.name: CopyTestCase
+ * @tc.desc: Copy a negotiate message carrying every v2 field, as done when a command keeps the received message
+ * @tc.type: PERF
+ * @tc.require: NegotiateMessage copy normal operation
+ */
+BENCHMARK_F(NegotiateMessageMarshalTest, CopyTestCase)(benchmark::State &state)
+{
+    while (state.KeepRunning()) {
+        NegotiateMessage msg = message_;
+        benchmark::DoNotOptimize(msg);
+    }
+}
+BENCHMARK_REGISTER_F(NegotiateMessageMarshalTest, CopyTestCase);
+}
+
+// Run the benchmark
+BENCHMARK_MAIN();
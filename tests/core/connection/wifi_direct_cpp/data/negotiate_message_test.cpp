@@ -401,4 +401,54 @@ HWTEST_F(NegotiateMessageTest, MessageTypeToString, TestSize.Level1)
     msg.SetMessageType(NegotiateMessageType::CMD_INVALID);
     EXPECT_EQ(str, "CMD_INVALID");
 }
-} // namespace OHOS::SoftBus
\ No newline at end of file
+/*
+ * @tc.name: CopyAndUnknownKey
+ * @tc.desc: copies keep new and old p2p keys apart and a tlv key outside both ranges is dropped
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(NegotiateMessageTest, CopyAndUnknownKey, TestSize.Level1)
+{
+    NegotiateMessage msg1(NegotiateMessageType::CMD_CONN_V2_REQ_1);
+    msg1.SetSessionId(1);
+    msg1.SetRemoteNetworkId("network");
+    msg1.SetLegacyP2pGcChannelList("36##40");
+    msg1.SetLegacyInterfaceName("chba0");
+    LinkInfo linkInfo;
+    linkInfo.SetCenter20M(5180);
+    msg1.SetLinkInfo(linkInfo);
+
+    NegotiateMessage msg2 = msg1;
+    msg1.SetLegacyInterfaceName("p2p0");
+    msg1.SetLinkInfo(LinkInfo());
+    EXPECT_EQ(msg2.GetSessionId(), 1);
+    EXPECT_EQ(msg2.GetRemoteNetworkId(), "network");
+    EXPECT_EQ(msg2.GetLegacyP2pGcChannelList(), "36##40");
+    EXPECT_EQ(msg2.GetLegacyInterfaceName(), "chba0");
+    EXPECT_EQ(msg2.GetLinkInfo().GetCenter20M(), 5180);
+    EXPECT_EQ(msg2.GetLegacyP2pStationFrequency(), 0);
+
+    auto protocol1 = WifiDirectProtocolFactory::CreateProtocol(ProtocolType::TLV);
+    protocol1->SetFormat({ TlvProtocol::TLV_TAG_SIZE, TlvProtocol::TLV_LENGTH_SIZE2 });
+    std::vector<uint8_t> output;
+    msg2.Marshalling(*protocol1, output);
+    // key 100 is in neither the new nor the old p2p range
+    std::vector<uint8_t> unknown = { 100, 4, 0, 1, 2, 3, 4 };
+    output.insert(output.end(), unknown.begin(), unknown.end());
+
+    NegotiateMessage msg3;
+    auto protocol2 = WifiDirectProtocolFactory::CreateProtocol(ProtocolType::TLV);
+    protocol2->SetFormat({ TlvProtocol::TLV_TAG_SIZE, TlvProtocol::TLV_LENGTH_SIZE2 });
+    msg3.Unmarshalling(*protocol2, output);
+    EXPECT_EQ(msg3.GetSessionId(), 1);
+    EXPECT_EQ(msg3.GetRemoteNetworkId(), "network");
+    EXPECT_EQ(msg3.GetLinkInfo().GetCenter20M(), 5180);
+
+    auto protocol3 = WifiDirectProtocolFactory::CreateProtocol(ProtocolType::TLV);
+    protocol3->SetFormat({ TlvProtocol::TLV_TAG_SIZE, TlvProtocol::TLV_LENGTH_SIZE2 });
+    std::vector<uint8_t> output3;
+    msg3.Marshalling(*protocol3, output3);
+    output.resize(output.size() - unknown.size());
+    EXPECT_EQ(output3, output);
+}
+} // namespace OHOS::SoftBus
@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "wifi_direct_executor_pool.h"
+#include "wifi_direct_mock.h"
+#include "wifi_direct_scheduler.h"
+
+using namespace testing::ext;
+using testing::NiceMock;
+
+namespace OHOS::SoftBus {
+namespace {
+constexpr uint32_t STEP_NUM = 16;
+constexpr uint32_t DEVICE_NUM = 32;
+constexpr uint32_t ROUND_NUM = 3;
+constexpr size_t MAX_WORKER_NUM = 8;
+constexpr auto WAIT_TIMEOUT = std::chrono::seconds(10);
+
+struct TestStepEvent {
+    uint32_t step;
+};
+
+// what the simulated negotiations saw, shared by every processor of a test
+class NegotiationRecorder {
+public:
+    void OnStart(const std::string &remoteDeviceId)
+    {
+        std::lock_guard lock(lock_);
+        started_.insert(remoteDeviceId);
+        threads_.insert(std::this_thread::get_id());
+        runningNum_++;
+        maxRunningNum_ = std::max(maxRunningNum_, runningNum_);
+        cv_.notify_all();
+    }
+
+    void OnFinish(const std::string &remoteDeviceId, uint32_t disorderNum)
+    {
+        std::lock_guard lock(lock_);
+        finished_.insert(remoteDeviceId);
+        disorderNum_ += disorderNum;
+        runningNum_--;
+        cv_.notify_all();
+    }
+
+    bool WaitStarted(const std::string &remoteDeviceId)
+    {
+        std::unique_lock lock(lock_);
+        return cv_.wait_for(lock, WAIT_TIMEOUT, [&]() { return started_.count(remoteDeviceId) != 0; });
+    }
+
+    bool WaitFinished(const std::string &remoteDeviceId)
+    {
+        std::unique_lock lock(lock_);
+        return cv_.wait_for(lock, WAIT_TIMEOUT, [&]() { return finished_.count(remoteDeviceId) != 0; });
+    }
+
+    size_t GetFinishedNum()
+    {
+        std::lock_guard lock(lock_);
+        return finished_.size();
+    }
+    size_t GetThreadNum()
+    {
+        std::lock_guard lock(lock_);
+        return threads_.size();
+    }
+    size_t GetMaxRunningNum()
+    {
+        std::lock_guard lock(lock_);
+        return maxRunningNum_;
+    }
+    uint32_t GetDisorderNum()
+    {
+        std::lock_guard lock(lock_);
+        return disorderNum_;
+    }
+
+private:
+    std::mutex lock_;
+    std::condition_variable cv_;
+    std::set<std::string> started_;
+    std::set<std::string> finished_;
+    std::set<std::thread::id> threads_;
+    size_t runningNum_ = 0;
+    size_t maxRunningNum_ = 0;
+    uint32_t disorderNum_ = 0;
+};
+
+// a negotiation that completes after STEP_NUM events from its peer
+class TestProcessor : public WifiDirectProcessor {
+public:
+    TestProcessor(const std::string &remoteDeviceId, NegotiationRecorder &recorder)
+        : WifiDirectProcessor(remoteDeviceId), recorder_(recorder) {}
+
+    void Run() override
+    {
+        recorder_.OnStart(remoteDeviceId_);
+        uint32_t expected = 0;
+        uint32_t disorderNum = 0;
+        while (expected < STEP_NUM) {
+            executor_->WaitEvent().Handle<std::shared_ptr<TestStepEvent>>(
+                [&expected, &disorderNum](std::shared_ptr<TestStepEvent> &event) {
+                    disorderNum += (event->step == expected) ? 0 : 1;
+                    expected++;
+                });
+        }
+        recorder_.OnFinish(remoteDeviceId_, disorderNum);
+    }
+
+    bool CanAcceptNegotiateDataAtState(WifiDirectCommand &command) override
+    {
+        return false;
+    }
+    void HandleCommandAfterTerminate(WifiDirectCommand &command) override {}
+    std::string GetProcessorName() const override
+    {
+        return "TestProcessor";
+    }
+    std::string GetState() const override
+    {
+        return "Running";
+    }
+
+private:
+    NegotiationRecorder &recorder_;
+};
+
+class TestCommand : public WifiDirectCommand {
+public:
+    TestCommand(const std::string &remoteDeviceId, NegotiationRecorder &recorder)
+        : remoteDeviceId_(remoteDeviceId), processor_(std::make_shared<TestProcessor>(remoteDeviceId, recorder)) {}
+
+    std::string GetRemoteDeviceId() const override
+    {
+        return remoteDeviceId_;
+    }
+    std::shared_ptr<WifiDirectProcessor> GetProcessor() override
+    {
+        return processor_;
+    }
+
+private:
+    std::string remoteDeviceId_;
+    std::shared_ptr<WifiDirectProcessor> processor_;
+};
+
+class TestScheduler : public WifiDirectScheduler {
+public:
+    size_t GetWorkerNum()
+    {
+        return executorPool_.GetWorkerNum();
+    }
+    void StopExecutorPool()
+    {
+        executorPool_.Stop();
+    }
+};
+
+// lets a pool task block until the test releases it, shared so it outlives the test body
+struct TaskGate {
+    std::mutex lock;
+    std::condition_variable cv;
+    bool started = false;
+    bool released = false;
+    bool done = false;
+};
+
+std::string MakeDeviceId(uint32_t round, uint32_t index)
+{
+    std::string suffix = std::to_string(round) + "_" + std::to_string(index);
+    return std::string(UUID_BUF_LEN - 1 - suffix.length(), '0') + suffix;
+}
+} // namespace
+
+class WifiDirectSchedulerTest : public testing::Test {
+public:
+    static void SetUpTestCase() { }
+    static void TearDownTestCase() { }
+    void SetUp() override { }
+    void TearDown() override { }
+};
+
+/*
+ * @tc.name: ExecutorPoolTest
+ * @tc.desc: the pool never grows past its limit, runs every task and joins its workers on stop
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(WifiDirectSchedulerTest, ExecutorPoolTest, TestSize.Level1)
+{
+    constexpr size_t workerNum = 4;
+    constexpr uint32_t taskNum = 100;
+    WifiDirectExecutorPool pool(workerNum);
+    std::atomic<uint32_t> doneNum = 0;
+    for (uint32_t i = 0; i < taskNum; i++) {
+        EXPECT_TRUE(pool.Submit([&doneNum]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            doneNum++;
+        }));
+    }
+    EXPECT_LE(pool.GetWorkerNum(), workerNum);
+    pool.Stop();
+    EXPECT_EQ(doneNum.load(), taskNum);
+    EXPECT_EQ(pool.GetWorkerNum(), 0U);
+    EXPECT_FALSE(pool.Submit([]() {}));
+}
+
+/*
+ * @tc.name: ExecutorPoolDestroyBusyTest
+ * @tc.desc: destroying the pool while a task blocks detaches its worker, which finishes the task and drops the
+ *           queued ones
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(WifiDirectSchedulerTest, ExecutorPoolDestroyBusyTest, TestSize.Level1)
+{
+    auto gate = std::make_shared<TaskGate>();
+    auto queuedRun = std::make_shared<std::atomic<bool>>(false);
+    auto pool = std::make_unique<WifiDirectExecutorPool>(1);
+    EXPECT_TRUE(pool->Submit([gate]() {
+        std::unique_lock lock(gate->lock);
+        gate->started = true;
+        gate->cv.notify_all();
+        gate->cv.wait(lock, [gate]() { return gate->released; });
+        gate->done = true;
+        gate->cv.notify_all();
+    }));
+    EXPECT_TRUE(pool->Submit([queuedRun]() { *queuedRun = true; }));
+    {
+        std::unique_lock lock(gate->lock);
+        EXPECT_TRUE(gate->cv.wait_for(lock, WAIT_TIMEOUT, [gate]() { return gate->started; }));
+    }
+    pool = nullptr;
+
+    std::unique_lock lock(gate->lock);
+    gate->released = true;
+    gate->cv.notify_all();
+    EXPECT_TRUE(gate->cv.wait_for(lock, WAIT_TIMEOUT, [gate]() { return gate->done; }));
+    lock.unlock();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_FALSE(queuedRun->load());
+}
+
+/*
+ * @tc.name: ExecutorStartFailedTest
+ * @tc.desc: an executor that cannot get a worker is not kept by the scheduler
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(WifiDirectSchedulerTest, ExecutorStartFailedTest, TestSize.Level1)
+{
+    NiceMock<WifiDirectInterfaceMock> mock;
+    NegotiationRecorder recorder;
+    TestScheduler scheduler;
+    scheduler.StopExecutorPool();
+
+    std::string remoteDeviceId = MakeDeviceId(0, 0);
+    TestCommand command(remoteDeviceId, recorder);
+    scheduler.ProcessNegotiateData(remoteDeviceId, command);
+    EXPECT_FALSE(scheduler.CheckExecutorRunning(remoteDeviceId));
+}
+
+/*
+ * @tc.name: ConcurrentNegotiationTest
+ * @tc.desc: many simulated negotiations share the executor workers, each one sees its events in order
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(WifiDirectSchedulerTest, ConcurrentNegotiationTest, TestSize.Level1)
+{
+    NiceMock<WifiDirectInterfaceMock> mock;
+    NegotiationRecorder recorder;
+    auto scheduler = std::make_shared<TestScheduler>();
+
+    for (uint32_t round = 0; round < ROUND_NUM; round++) {
+        std::vector<std::thread> peers;
+        std::atomic<uint32_t> lostNum = 0;
+        for (uint32_t i = 0; i < DEVICE_NUM; i++) {
+            peers.emplace_back([&, round, i]() {
+                std::string remoteDeviceId = MakeDeviceId(round, i);
+                TestCommand command(remoteDeviceId, recorder);
+                scheduler->ProcessNegotiateData(remoteDeviceId, command);
+                if (!recorder.WaitStarted(remoteDeviceId)) {
+                    lostNum++;
+                    return;
+                }
+                for (uint32_t step = 0; step < STEP_NUM; step++) {
+                    scheduler->ProcessEvent(remoteDeviceId, TestStepEvent { step });
+                }
+                lostNum += recorder.WaitFinished(remoteDeviceId) ? 0 : 1;
+            });
+        }
+        for (auto &peer : peers) {
+            peer.join();
+        }
+        EXPECT_EQ(lostNum.load(), 0U);
+    }
+
+    EXPECT_EQ(recorder.GetFinishedNum(), DEVICE_NUM * ROUND_NUM);
+    EXPECT_EQ(recorder.GetDisorderNum(), 0U);
+    EXPECT_LE(recorder.GetMaxRunningNum(), MAX_WORKER_NUM);
+    // the workers of the first round ran every later one
+    EXPECT_LE(recorder.GetThreadNum(), MAX_WORKER_NUM);
+    EXPECT_LE(scheduler->GetWorkerNum(), MAX_WORKER_NUM);
+    scheduler = nullptr;
+}
+} // namespace OHOS::SoftBus
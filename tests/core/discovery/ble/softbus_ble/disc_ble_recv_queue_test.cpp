@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <securec.h>
+#include <thread>
+
+#include "disc_ble_recv_queue.h"
+#include "disc_log.h"
+#include "softbus_error_code.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+constexpr uint32_t TEST_SLOT_NUM = 16;
+constexpr uint32_t ADV_LEN = 24;
+constexpr uint32_t RSP_LEN = 27;
+constexpr uint32_t FEED_ROUNDS = 4000;
+constexpr uint32_t REPEATS_PER_ROUND = 7;
+constexpr uint32_t KNOWN_DEVICE_NUM = 8;
+constexpr auto HEAVY_PROCESS_TIME = std::chrono::microseconds(500);
+// a push must never come close to the cost of handling the report itself
+constexpr auto PUSH_TIME_BOUND = std::chrono::milliseconds(10);
+
+struct SyntheticAdv {
+    uint8_t adv[ADV_LEN];
+    uint8_t rsp[RSP_LEN];
+    BroadcastReportInfo reportInfo;
+};
+
+void MakeAdv(uint32_t device, SyntheticAdv *adv)
+{
+    (void)memset_s(adv, sizeof(SyntheticAdv), 0, sizeof(SyntheticAdv));
+    for (uint32_t i = 0; i < sizeof(device); i++) {
+        adv->reportInfo.addr.addr[i] = static_cast<uint8_t>(device >> (i * 8U));
+        adv->adv[i] = adv->reportInfo.addr.addr[i];
+    }
+    adv->reportInfo.packet.bcData.payload = adv->adv;
+    adv->reportInfo.packet.bcData.payloadLen = ADV_LEN;
+    adv->reportInfo.packet.rspData.payload = adv->rsp;
+    adv->reportInfo.packet.rspData.payloadLen = RSP_LEN;
+}
+
+std::atomic<uint32_t> g_handled { 0 };
+std::atomic<uint32_t> g_lastDevice { 0 };
+
+void CountingHandler(const BroadcastReportInfo *reportInfo)
+{
+    g_lastDevice = reportInfo->packet.bcData.payload[0];
+    g_handled++;
+}
+
+void HeavyHandler(const BroadcastReportInfo *reportInfo)
+{
+    (void)reportInfo;
+    std::this_thread::sleep_for(HEAVY_PROCESS_TIME);
+    g_handled++;
+}
+} // namespace
+
+class DiscBleRecvQueueTest : public testing::Test {
+public:
+    DiscBleRecvQueueTest() { }
+    ~DiscBleRecvQueueTest() { }
+    static void SetUpTestCase(void) { }
+    static void TearDownTestCase(void) { }
+    void SetUp() override
+    {
+        g_handled = 0;
+        queue_ = DiscBleCreateRecvQueue(TEST_SLOT_NUM);
+        ASSERT_NE(queue_, nullptr);
+    }
+    void TearDown() override
+    {
+        DiscBleDestroyRecvQueue(queue_);
+    }
+
+    DiscBleRecvQueue *queue_ = nullptr;
+};
+
+/*
+ * @tc.name: CreateRecvQueue001
+ * @tc.desc: the slot count has to be a power of 2
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DiscBleRecvQueueTest, CreateRecvQueue001, TestSize.Level1)
+{
+    EXPECT_EQ(DiscBleCreateRecvQueue(0), nullptr);
+    EXPECT_EQ(DiscBleCreateRecvQueue(TEST_SLOT_NUM + 1), nullptr);
+    bool needWake = false;
+    SyntheticAdv adv;
+    MakeAdv(1, &adv);
+    EXPECT_EQ(DiscBleRecvQueuePush(nullptr, &adv.reportInfo, &needWake), SOFTBUS_INVALID_PARAM);
+    EXPECT_EQ(DiscBleRecvQueuePush(queue_, nullptr, &needWake), SOFTBUS_INVALID_PARAM);
+    EXPECT_EQ(DiscBleRecvQueueDrain(queue_, nullptr), 0U);
+}
+
+/*
+ * @tc.name: PushDrain001
+ * @tc.desc: reports are copied on push, the worker is woken once per batch
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DiscBleRecvQueueTest, PushDrain001, TestSize.Level1)
+{
+    SyntheticAdv adv;
+    MakeAdv(1, &adv);
+    bool needWake = false;
+    EXPECT_EQ(DiscBleRecvQueuePush(queue_, &adv.reportInfo, &needWake), SOFTBUS_OK);
+    EXPECT_TRUE(needWake);
+    // the caller's buffers are gone once the callback returns
+    MakeAdv(2, &adv);
+    EXPECT_EQ(DiscBleRecvQueuePush(queue_, &adv.reportInfo, &needWake), SOFTBUS_OK);
+    EXPECT_FALSE(needWake);
+    (void)memset_s(adv.adv, sizeof(adv.adv), 0xFF, sizeof(adv.adv));
+
+    EXPECT_EQ(DiscBleRecvQueueDrain(queue_, CountingHandler), 2U);
+    EXPECT_EQ(g_lastDevice.load(), 2U);
+    EXPECT_EQ(DiscBleRecvQueuePush(queue_, &adv.reportInfo, &needWake), SOFTBUS_OK);
+    EXPECT_TRUE(needWake);
+
+    adv.reportInfo.packet.rspData.payloadLen = DISC_BLE_RECV_PAYLOAD_MAX_LEN + 1;
+    EXPECT_EQ(DiscBleRecvQueuePush(queue_, &adv.reportInfo, &needWake), SOFTBUS_INVALID_PARAM);
+    DiscBleRecvQueueStats stats;
+    DiscBleRecvQueueGetStats(queue_, &stats);
+    EXPECT_EQ(stats.pushed, 3U);
+    EXPECT_EQ(stats.processed, 2U);
+    EXPECT_EQ(stats.droppedInvalid, 1U);
+}
+
+/*
+ * @tc.name: Shedding001
+ * @tc.desc: past half full repeated advertisements are dropped, new ones still get in until the queue is full
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DiscBleRecvQueueTest, Shedding001, TestSize.Level1)
+{
+    SyntheticAdv adv;
+    bool needWake = false;
+    uint32_t device = 0;
+    for (; device < TEST_SLOT_NUM / 2; device++) {
+        MakeAdv(device, &adv);
+        EXPECT_EQ(DiscBleRecvQueuePush(queue_, &adv.reportInfo, &needWake), SOFTBUS_OK);
+    }
+    MakeAdv(0, &adv);
+    EXPECT_EQ(DiscBleRecvQueuePush(queue_, &adv.reportInfo, &needWake), SOFTBUS_DISCOVER_BLE_RECV_QUEUE_FULL);
+    for (; device < TEST_SLOT_NUM; device++) {
+        MakeAdv(device, &adv);
+        EXPECT_EQ(DiscBleRecvQueuePush(queue_, &adv.reportInfo, &needWake), SOFTBUS_OK);
+    }
+    MakeAdv(device, &adv);
+    EXPECT_EQ(DiscBleRecvQueuePush(queue_, &adv.reportInfo, &needWake), SOFTBUS_DISCOVER_BLE_RECV_QUEUE_FULL);
+
+    DiscBleRecvQueueStats stats;
+    DiscBleRecvQueueGetStats(queue_, &stats);
+    EXPECT_EQ(stats.droppedDuplicate, 1U);
+    EXPECT_EQ(stats.droppedFull, 1U);
+    EXPECT_EQ(DiscBleRecvQueueDrain(queue_, CountingHandler), TEST_SLOT_NUM);
+
+    // with room again the same advertisement is accepted
+    MakeAdv(0, &adv);
+    EXPECT_EQ(DiscBleRecvQueuePush(queue_, &adv.reportInfo, &needWake), SOFTBUS_OK);
+}
+
+/*
+ * @tc.name: HighRateFeed001
+ * @tc.desc: a synthetic feed far faster than the worker, no push may block on processing and
+ *           every report is either handled or counted as dropped, duplicates before new devices
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DiscBleRecvQueueTest, HighRateFeed001, TestSize.Level1)
+{
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool wake = false;
+    std::atomic<bool> stop { false };
+    std::thread worker([&]() {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait(lock, [&]() { return wake || stop.load(); });
+                wake = false;
+            }
+            (void)DiscBleRecvQueueDrain(queue_, HeavyHandler);
+            if (stop.load()) {
+                break;
+            }
+        }
+    });
+
+    SyntheticAdv adv;
+    std::chrono::nanoseconds maxPushTime(0);
+    uint32_t total = 0;
+    for (uint32_t round = 0; round < FEED_ROUNDS; round++) {
+        for (uint32_t i = 0; i <= REPEATS_PER_ROUND; i++) {
+            // one new device per round among advertisements of devices already around
+            uint32_t device = (i == 0) ? KNOWN_DEVICE_NUM + round : i % KNOWN_DEVICE_NUM;
+            MakeAdv(device, &adv);
+            bool needWake = false;
+            auto begin = std::chrono::steady_clock::now();
+            (void)DiscBleRecvQueuePush(queue_, &adv.reportInfo, &needWake);
+            auto cost = std::chrono::steady_clock::now() - begin;
+            maxPushTime = (cost > maxPushTime) ? cost : maxPushTime;
+            total++;
+            if (needWake) {
+                std::lock_guard<std::mutex> lock(mutex);
+                wake = true;
+                cond.notify_one();
+            }
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+        cond.notify_one();
+    }
+    worker.join();
+
+    DiscBleRecvQueueStats stats;
+    DiscBleRecvQueueGetStats(queue_, &stats);
+    DISC_LOGI(DISC_TEST, "total=%{public}u, pushed=%{public}u, processed=%{public}u, dup=%{public}u, full=%{public}u, "
+        "maxPushUs=%{public}lld", total, stats.pushed, stats.processed, stats.droppedDuplicate, stats.droppedFull,
+        static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(maxPushTime).count()));
+    EXPECT_LT(maxPushTime, PUSH_TIME_BOUND);
+    EXPECT_EQ(stats.pushed + stats.droppedDuplicate + stats.droppedFull, total);
+    EXPECT_EQ(stats.processed, stats.pushed);
+    EXPECT_EQ(g_handled.load(), stats.processed);
+    EXPECT_GT(stats.droppedDuplicate, stats.droppedFull);
+}
+} // namespace OHOS
@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <securec.h>
+#include <vector>
+
+#include "disc_ble_scan_policy.h"
+#include "disc_log.h"
+#include "softbus_broadcast_type.h"
+#include "softbus_common.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+constexpr uint32_t MAC_LEN = 6;
+constexpr uint32_t PERMILLE = 1000;
+
+struct ScanDuty {
+    uint32_t window;
+    uint32_t interval;
+};
+
+constexpr ScanDuty SCAN_DUTY_TABLE[FREQ_BUTT] = {
+    { SOFTBUS_BC_SCAN_WINDOW_P2, SOFTBUS_BC_SCAN_INTERVAL_P2 },
+    { SOFTBUS_BC_SCAN_WINDOW_P10, SOFTBUS_BC_SCAN_INTERVAL_P10 },
+    { SOFTBUS_BC_SCAN_WINDOW_P25, SOFTBUS_BC_SCAN_INTERVAL_P25 },
+    { SOFTBUS_BC_SCAN_WINDOW_P75, SOFTBUS_BC_SCAN_INTERVAL_P75 },
+    { SOFTBUS_BC_SCAN_WINDOW_P100, SOFTBUS_BC_SCAN_INTERVAL_P100 },
+};
+
+// stands in for the broadcast scheduler, remembers the parameters the policy asked for
+class FakeScanner {
+public:
+    void Apply(int32_t freq)
+    {
+        freq_ = freq;
+        applyCount_++;
+    }
+
+    // scan time of one epoch at the current parameters, in permille of the epoch
+    uint32_t DutyPermille() const
+    {
+        return SCAN_DUTY_TABLE[freq_].window * PERMILLE / SCAN_DUTY_TABLE[freq_].interval;
+    }
+
+    int32_t freq_ = LOW;
+    uint32_t applyCount_ = 0;
+};
+
+struct TraceEpoch {
+    uint32_t firstDevice;
+    uint32_t deviceNum;
+};
+
+void MakeMac(uint32_t device, uint8_t *mac)
+{
+    (void)memset_s(mac, MAC_LEN, 0, MAC_LEN);
+    for (uint32_t i = 0; i < sizeof(device); i++) {
+        mac[i] = static_cast<uint8_t>(device >> (i * 8U));
+    }
+}
+
+void ReportDevices(DiscBleScanPolicy *policy, uint32_t firstDevice, uint32_t deviceNum)
+{
+    uint8_t mac[MAC_LEN] = { 0 };
+    for (uint32_t device = firstDevice; device < firstDevice + deviceNum; device++) {
+        MakeMac(device, mac);
+        DiscBleScanPolicyOnResult(policy, mac, MAC_LEN);
+    }
+}
+
+// replays one scan result trace through the policy, one entry per epoch, and records the applied levels
+std::vector<int32_t> ReplayTrace(DiscBleScanPolicy *policy, FakeScanner *scanner,
+    const std::vector<TraceEpoch> &trace, uint32_t *totalDuty)
+{
+    std::vector<int32_t> levels;
+    *totalDuty = 0;
+    for (const TraceEpoch &epoch : trace) {
+        *totalDuty += scanner->DutyPermille();
+        ReportDevices(policy, epoch.firstDevice, epoch.deviceNum);
+        if (DiscBleScanPolicyOnEpoch(policy)) {
+            scanner->Apply(DiscBleScanPolicyGetFreq(policy));
+        }
+        levels.push_back(scanner->freq_);
+    }
+    return levels;
+}
+
+uint32_t QuietEpochsToDecay(uint32_t subscriberCnt)
+{
+    uint32_t extra = (subscriberCnt > SCAN_POLICY_MAX_EXTRA_HOLD) ? SCAN_POLICY_MAX_EXTRA_HOLD : subscriberCnt;
+    return SCAN_POLICY_HOLD_EPOCHS + extra;
+}
+} // namespace
+
+class DiscBleScanPolicyTest : public testing::Test {
+public:
+    DiscBleScanPolicyTest() { }
+    ~DiscBleScanPolicyTest() { }
+    static void SetUpTestCase(void) { }
+    static void TearDownTestCase(void) { }
+    void SetUp() override
+    {
+        DiscBleScanPolicyInit(&policy_);
+    }
+    void TearDown() override { }
+
+    DiscBleScanPolicy policy_;
+    FakeScanner scanner_;
+};
+
+/*
+ * @tc.name: SetBound001
+ * @tc.desc: a new subscriber starts scanning at the top of its bound
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DiscBleScanPolicyTest, SetBound001, TestSize.Level1)
+{
+    ScanFreqBound bound = { .minFreq = MID, .maxFreq = SUPER_HIGH };
+    EXPECT_TRUE(DiscBleScanPolicySetBound(&policy_, &bound, 1));
+    EXPECT_EQ(DiscBleScanPolicyGetFreq(&policy_), SUPER_HIGH);
+
+    // same subscribers and bound again, nothing to apply
+    EXPECT_FALSE(DiscBleScanPolicySetBound(&policy_, &bound, 1));
+
+    // a lower bound pulls the running level into range
+    ScanFreqBound lower = { .minFreq = LOW, .maxFreq = MID };
+    EXPECT_TRUE(DiscBleScanPolicySetBound(&policy_, &lower, 1));
+    EXPECT_EQ(DiscBleScanPolicyGetFreq(&policy_), MID);
+
+    // out of range values are clamped
+    ScanFreqBound invalid = { .minFreq = FREQ_BUTT, .maxFreq = FREQ_BUTT + 1 };
+    EXPECT_TRUE(DiscBleScanPolicySetBound(&policy_, &invalid, 1));
+    EXPECT_EQ(DiscBleScanPolicyGetFreq(&policy_), EXTREME_HIGH);
+    EXPECT_EQ(policy_.bound.minFreq, EXTREME_HIGH);
+
+    EXPECT_FALSE(DiscBleScanPolicySetBound(nullptr, &bound, 1));
+    EXPECT_FALSE(DiscBleScanPolicySetBound(&policy_, nullptr, 1));
+    EXPECT_EQ(DiscBleScanPolicyGetFreq(nullptr), LOW);
+}
+
+/*
+ * @tc.name: Decay001
+ * @tc.desc: silence lowers the level one step at a time down to the floor and never below it
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DiscBleScanPolicyTest, Decay001, TestSize.Level1)
+{
+    ScanFreqBound bound = { .minFreq = MID, .maxFreq = SUPER_HIGH };
+    (void)DiscBleScanPolicySetBound(&policy_, &bound, 0);
+    scanner_.Apply(DiscBleScanPolicyGetFreq(&policy_));
+
+    std::vector<TraceEpoch> silence(SCAN_POLICY_HOLD_EPOCHS * FREQ_BUTT, { 0, 0 });
+    uint32_t totalDuty = 0;
+    std::vector<int32_t> levels = ReplayTrace(&policy_, &scanner_, silence, &totalDuty);
+    EXPECT_EQ(levels.back(), MID);
+    for (size_t i = 1; i < levels.size(); i++) {
+        EXPECT_LE(levels[i], levels[i - 1]);
+        EXPECT_LE(levels[i - 1] - levels[i], 1);
+    }
+    EXPECT_EQ(scanner_.applyCount_, 1U + (SUPER_HIGH - MID));
+}
+
+/*
+ * @tc.name: Decay002
+ * @tc.desc: known devices still answering and more subscribers both hold the level longer
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DiscBleScanPolicyTest, Decay002, TestSize.Level1)
+{
+    ScanFreqBound bound = { .minFreq = LOW, .maxFreq = HIGH };
+    (void)DiscBleScanPolicySetBound(&policy_, &bound, 0);
+    ReportDevices(&policy_, 0, 1);
+    (void)DiscBleScanPolicyOnEpoch(&policy_);
+
+    // the same device every epoch is not new, it only slowly wears the level down
+    uint32_t epochs = 0;
+    do {
+        ReportDevices(&policy_, 0, 1);
+        epochs++;
+    } while (!DiscBleScanPolicyOnEpoch(&policy_));
+    EXPECT_EQ(epochs, QuietEpochsToDecay(0));
+
+    DiscBleScanPolicyInit(&policy_);
+    constexpr uint32_t subscriberCnt = 2;
+    (void)DiscBleScanPolicySetBound(&policy_, &bound, subscriberCnt);
+    epochs = 0;
+    do {
+        epochs++;
+    } while (!DiscBleScanPolicyOnEpoch(&policy_));
+    // silence counts double
+    EXPECT_EQ(epochs, (QuietEpochsToDecay(subscriberCnt) + 1) / 2);
+}
+
+/*
+ * @tc.name: Raise001
+ * @tc.desc: a single new device raises the level one step, a burst jumps to the upper bound
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DiscBleScanPolicyTest, Raise001, TestSize.Level1)
+{
+    ScanFreqBound bound = { .minFreq = LOW, .maxFreq = SUPER_HIGH };
+    (void)DiscBleScanPolicySetBound(&policy_, &bound, 0);
+    ScanFreqBound low = { .minFreq = LOW, .maxFreq = LOW };
+    (void)DiscBleScanPolicySetBound(&policy_, &low, 0);
+    (void)DiscBleScanPolicySetBound(&policy_, &bound, 0);
+    EXPECT_EQ(DiscBleScanPolicyGetFreq(&policy_), SUPER_HIGH);
+
+    // start from the bottom of the bound
+    DiscBleScanPolicyInit(&policy_);
+    policy_.bound = bound;
+    policy_.curFreq = LOW;
+    ReportDevices(&policy_, 1, 1);
+    EXPECT_TRUE(DiscBleScanPolicyOnEpoch(&policy_));
+    EXPECT_EQ(DiscBleScanPolicyGetFreq(&policy_), MID);
+
+    // devices already seen are no news
+    ReportDevices(&policy_, 1, 1);
+    EXPECT_FALSE(DiscBleScanPolicyOnEpoch(&policy_));
+
+    ReportDevices(&policy_, 2, SCAN_POLICY_BURST_NEW_DEVICES);
+    EXPECT_TRUE(DiscBleScanPolicyOnEpoch(&policy_));
+    EXPECT_EQ(DiscBleScanPolicyGetFreq(&policy_), SUPER_HIGH);
+}
+
+/*
+ * @tc.name: ReplayTrace001
+ * @tc.desc: replay an advertisement trace of arrivals, a quiet phase and a second crowd, the
+ *           policy reacts to each crowd within one epoch and scans less than a fixed duty cycle
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DiscBleScanPolicyTest, ReplayTrace001, TestSize.Level1)
+{
+    DISC_LOGI(DISC_TEST, "ReplayTrace001 start");
+    constexpr uint32_t quietEpochs = 30;
+    constexpr uint32_t secondCrowd = 100;
+    std::vector<TraceEpoch> trace;
+    // a few devices show up, then keep advertising
+    trace.push_back({ 0, 4 });
+    trace.push_back({ 0, 5 });
+    for (uint32_t i = 0; i < quietEpochs; i++) {
+        trace.push_back({ 0, 5 });
+    }
+    // nobody around
+    for (uint32_t i = 0; i < quietEpochs; i++) {
+        trace.push_back({ 0, 0 });
+    }
+    // a second crowd walks in
+    size_t crowdEpoch = trace.size();
+    trace.push_back({ secondCrowd, 6 });
+    trace.push_back({ secondCrowd, 6 });
+
+    ScanFreqBound bound = { .minFreq = LOW, .maxFreq = HIGH };
+    (void)DiscBleScanPolicySetBound(&policy_, &bound, 1);
+    scanner_.Apply(DiscBleScanPolicyGetFreq(&policy_));
+    uint32_t adaptiveDuty = 0;
+    std::vector<int32_t> levels = ReplayTrace(&policy_, &scanner_, trace, &adaptiveDuty);
+
+    EXPECT_EQ(levels[0], HIGH);
+    EXPECT_EQ(levels[crowdEpoch - 1], LOW);
+    EXPECT_EQ(levels[crowdEpoch], HIGH);
+
+    FakeScanner fixed;
+    fixed.Apply(HIGH);
+    uint32_t fixedDuty = fixed.DutyPermille() * static_cast<uint32_t>(trace.size());
+    EXPECT_LT(adaptiveDuty, fixedDuty);
+    DISC_LOGI(DISC_TEST, "adaptive duty=%{public}u, fixed duty=%{public}u", adaptiveDuty, fixedDuty);
+}
+} // namespace OHOS
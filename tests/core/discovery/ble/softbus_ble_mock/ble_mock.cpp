@@ -432,6 +432,8 @@ void BleMock::InjectPassiveNonPacket()
         reportInfo.packet.rspData.payload = &passivePublishRspData[0];
         reportInfo.packet.rspData.payloadLen = rspLen;
         scanListener->OnReportScanDataCallback(SCAN_LISTENER_ID, &reportInfo);
+        // scan results are handled on the receive looper
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_RECV_LOOPER_DONE_MS));
     }
 }
 
@@ -450,6 +452,8 @@ void BleMock::InjectActiveNonPacket()
         reportInfo.packet.rspData.payload = &activePublishRspData[0];
         reportInfo.packet.rspData.payloadLen = rspLen;
         scanListener->OnReportScanDataCallback(SCAN_LISTENER_ID, &reportInfo);
+        // scan results are handled on the receive looper
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_RECV_LOOPER_DONE_MS));
     }
 }
 
@@ -468,6 +472,8 @@ void BleMock::InjectPassiveNonPacketOfCust()
         reportInfo.packet.rspData.payload = &passivePublishRspDataOfCust[0];
         reportInfo.packet.rspData.payloadLen = rspLen;
         scanListener->OnReportScanDataCallback(SCAN_LISTENER_ID, &reportInfo);
+        // scan results are handled on the receive looper
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_RECV_LOOPER_DONE_MS));
     }
 }
 
@@ -486,6 +492,8 @@ void BleMock::InjectActiveConPacket()
         reportInfo.packet.rspData.payload = &activeDiscoveryRspData[0];
         reportInfo.packet.rspData.payloadLen = rspLen;
         scanListener->OnReportScanDataCallback(SCAN_LISTENER_ID, &reportInfo);
+        // scan results are handled on the receive looper
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_RECV_LOOPER_DONE_MS));
     }
 }
 
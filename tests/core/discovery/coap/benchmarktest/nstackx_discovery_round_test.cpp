@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "nstackx_error.h"
+#include "nstackx_loopback_peers.h"
+
+namespace OHOS {
+// every peer of the loopback network answers every discovery round
+static constexpr uint32_t PEER_NUM = 384;
+
+class NstackxDiscoveryRoundTest : public benchmark::Fixture {
+public:
+    NstackxDiscoveryRoundTest()
+    {
+        Iterations(iterations);
+        Repetitions(repetitions);
+        ReportAggregatesOnly();
+    }
+    ~NstackxDiscoveryRoundTest() override = default;
+    void SetUp(const ::benchmark::State &state) override
+    {
+        isReady_ = LoopbackPeersInit(PEER_NUM) == NSTACKX_EOK;
+    }
+    void TearDown(const ::benchmark::State &state) override
+    {
+        LoopbackPeersDeinit();
+    }
+
+protected:
+    const int32_t repetitions = 3;
+    const int32_t iterations = 100;
+    bool isReady_ = false;
+};
+
+/**
+ * @tc.name: RemoteDeviceUpdateTestCase
+ * @tc.desc: Every loopback peer sends a discover message, the remote device table is updated for each of them
+ * @tc.type: PERF
+ * @tc.require: UpdateRemoteNodeByDeviceInfo normal operation
+ */
+BENCHMARK_F(NstackxDiscoveryRoundTest, RemoteDeviceUpdateTestCase)(benchmark::State &state)
+{
+    if (!isReady_ || LoopbackPeersDiscoveryRound() != NSTACKX_EOK || LoopbackPeersGetNodeCount() != PEER_NUM) {
+        state.SkipWithError("LoopbackPeersInit or LoopbackPeersDiscoveryRound failed.");
+    }
+    while (state.KeepRunning()) {
+        if (LoopbackPeersDiscoveryRound() != NSTACKX_EOK) {
+            state.SkipWithError("LoopbackPeersDiscoveryRound failed.");
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * PEER_NUM);
+}
+BENCHMARK_REGISTER_F(NstackxDiscoveryRoundTest, RemoteDeviceUpdateTestCase);
+
+/**
+ * @tc.name: RemoteDeviceIpTestCase
+ * @tc.desc: Look up the address of every loopback peer by its device id
+ * @tc.type: PERF
+ * @tc.require: GetRemoteDeviceIp normal operation
+ */
+BENCHMARK_F(NstackxDiscoveryRoundTest, RemoteDeviceIpTestCase)(benchmark::State &state)
+{
+    if (!isReady_ || LoopbackPeersDiscoveryRound() != NSTACKX_EOK) {
+        state.SkipWithError("LoopbackPeersInit or LoopbackPeersDiscoveryRound failed.");
+    }
+    while (state.KeepRunning()) {
+        if (LoopbackPeersLookupIp() != NSTACKX_EOK) {
+            state.SkipWithError("LoopbackPeersLookupIp failed.");
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * PEER_NUM);
+}
+BENCHMARK_REGISTER_F(NstackxDiscoveryRoundTest, RemoteDeviceIpTestCase);
+
+/**
+ * @tc.name: ResponsePayloadTestCase
+ * @tc.desc: Prepare the unicast response for every loopback peer of a discovery round
+ * @tc.type: PERF
+ * @tc.require: PrepareServiceDiscover normal operation
+ */
+BENCHMARK_F(NstackxDiscoveryRoundTest, ResponsePayloadTestCase)(benchmark::State &state)
+{
+    if (!isReady_) {
+        state.SkipWithError("LoopbackPeersInit failed.");
+    }
+    while (state.KeepRunning()) {
+        if (LoopbackPeersPrepareResponses() != NSTACKX_EOK) {
+            state.SkipWithError("LoopbackPeersPrepareResponses failed.");
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * PEER_NUM);
+}
+BENCHMARK_REGISTER_F(NstackxDiscoveryRoundTest, ResponsePayloadTestCase);
+
+/**
+ * @tc.name: JsonParseTestCase
+ * @tc.desc: Parse the json unicast response of every loopback peer of a discovery round
+ * @tc.type: PERF
+ * @tc.require: GetServiceDiscoverInfo normal operation
+ */
+BENCHMARK_F(NstackxDiscoveryRoundTest, JsonParseTestCase)(benchmark::State &state)
+{
+    if (!isReady_) {
+        state.SkipWithError("LoopbackPeersInit failed.");
+    }
+    while (state.KeepRunning()) {
+        if (LoopbackPeersParseResponses(false) != NSTACKX_EOK) {
+            state.SkipWithError("LoopbackPeersParseResponses failed.");
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * PEER_NUM);
+}
+BENCHMARK_REGISTER_F(NstackxDiscoveryRoundTest, JsonParseTestCase);
+
+/**
+ * @tc.name: CompactParseTestCase
+ * @tc.desc: Parse the compact unicast response of every loopback peer of a discovery round
+ * @tc.type: PERF
+ * @tc.require: GetServiceDiscoverInfo normal operation
+ */
+BENCHMARK_F(NstackxDiscoveryRoundTest, CompactParseTestCase)(benchmark::State &state)
+{
+    if (!isReady_) {
+        state.SkipWithError("LoopbackPeersInit failed.");
+    }
+    while (state.KeepRunning()) {
+        if (LoopbackPeersParseResponses(true) != NSTACKX_EOK) {
+            state.SkipWithError("LoopbackPeersParseResponses failed.");
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * PEER_NUM);
+}
+BENCHMARK_REGISTER_F(NstackxDiscoveryRoundTest, CompactParseTestCase);
+}
+
+// Run the benchmark
+BENCHMARK_MAIN();
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nstackx_loopback_peers.h"
+
+#include <arpa/inet.h>
+#include <securec.h>
+#include <stdlib.h>
+
+#include "compact_payload.h"
+#include "json_payload.h"
+#include "nstackx_common.h"
+#include "nstackx_device.h"
+#include "nstackx_device_local.h"
+#include "nstackx_device_remote.h"
+#include "nstackx_error.h"
+
+#define PEER_PER_SUBNET 250
+#define LOOPBACK_NET 0x7F000000U
+#define SUBNET_SHIFT 8
+#define PEER_HOST_BASE 2 /* 127.0.0.1 is the local device */
+#define PEER_BUSINESS_TYPE 1
+#define LOCAL_IFACE_NAME "lo"
+#define LOCAL_IFACE_IP "127.0.0.1"
+#define LOCAL_DEVICE_NAME "loopback benchmark"
+#define LOCAL_DEVICE_ID "{\"UDID\":\"0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF\"}"
+#define LOCAL_DEVICE_HASH 1234567890123ULL
+#define LOCAL_CAPABILITY 0x1FF
+#define LOCAL_SERVICE_DATA "port:49152,"
+
+static DeviceInfo *g_peers = NULL;
+static uint32_t g_peerNum = 0;
+static NSTACKX_InterfaceInfo g_localIface;
+
+static void BuildPeer(DeviceInfo *peer, uint32_t index)
+{
+    (void)sprintf_s(peer->deviceId, sizeof(peer->deviceId), "{\"UDID\":\"loopback-peer-%04u\"}", index);
+    (void)sprintf_s(peer->deviceName, sizeof(peer->deviceName), "peer %u", index);
+    peer->netChannelInfo.wifiApInfo.af = AF_INET;
+    peer->netChannelInfo.wifiApInfo.addr.in.s_addr = htonl(LOOPBACK_NET |
+        ((index / PEER_PER_SUBNET) << SUBNET_SHIFT) | (index % PEER_PER_SUBNET + PEER_HOST_BASE));
+    peer->capabilityBitmapNum = 1;
+    peer->capabilityBitmap[0] = index;
+    peer->mode = DEFAULT_MODE;
+    peer->businessType = PEER_BUSINESS_TYPE;
+    peer->discoveryType = NSTACKX_DISCOVERY_TYPE_PASSIVE;
+    peer->seq.dealBcast = NSTACKX_TRUE;
+}
+
+int32_t LoopbackPeersInit(uint32_t peerNum)
+{
+    if (peerNum == 0 || peerNum > NSTACKX_MAX_DEVICE_NUM) {
+        return NSTACKX_EINVAL;
+    }
+    g_peers = (DeviceInfo *)calloc(peerNum, sizeof(DeviceInfo));
+    if (g_peers == NULL) {
+        return NSTACKX_ENOMEM;
+    }
+    g_peerNum = peerNum;
+    for (uint32_t i = 0; i < peerNum; i++) {
+        BuildPeer(&g_peers[i], i);
+    }
+    (void)strcpy_s(g_localIface.networkName, sizeof(g_localIface.networkName), LOCAL_IFACE_NAME);
+    (void)strcpy_s(g_localIface.networkIpAddr, sizeof(g_localIface.networkIpAddr), LOCAL_IFACE_IP);
+
+    SetMaxDeviceNum(NSTACKX_MAX_DEVICE_NUM);
+    SetDeviceListAgingTime(NSTACKX_MAX_AGING_TIME);
+    (void)strcpy_s(GetLocalDeviceInfo()->deviceId, sizeof(GetLocalDeviceInfo()->deviceId), LOCAL_DEVICE_ID);
+    ConfigureLocalDeviceName(LOCAL_DEVICE_NAME);
+    SetLocalDeviceHash(LOCAL_DEVICE_HASH);
+    uint32_t capability = LOCAL_CAPABILITY;
+    (void)SetLocalDeviceCapability(1, &capability);
+    (void)SetLocalDeviceServiceData(LOCAL_SERVICE_DATA);
+    if (RemoteDeviceListInit() != NSTACKX_EOK) {
+        LoopbackPeersDeinit();
+        return NSTACKX_EFAILED;
+    }
+    return NSTACKX_EOK;
+}
+
+void LoopbackPeersDeinit(void)
+{
+    RemoteDeviceListDeinit();
+    ClearServiceDiscoverPayloadCache();
+    free(g_peers);
+    g_peers = NULL;
+    g_peerNum = 0;
+}
+
+uint32_t LoopbackPeersGetNodeCount(void)
+{
+    return GetRemoteNodeCount();
+}
+
+int32_t LoopbackPeersDiscoveryRound(void)
+{
+    for (uint32_t i = 0; i < g_peerNum; i++) {
+        int8_t updated = NSTACKX_FALSE;
+        g_peers[i].seq.seqBcast++;
+        int32_t ret = UpdateRemoteNodeByDeviceInfo(g_peers[i].deviceId, &g_localIface, &g_peers[i], &updated);
+        if (ret != NSTACKX_EOK) {
+            return ret;
+        }
+    }
+    return NSTACKX_EOK;
+}
+
+int32_t LoopbackPeersLookupIp(void)
+{
+    for (uint32_t i = 0; i < g_peerNum; i++) {
+        const struct in_addr *ip = GetRemoteDeviceIp(g_peers[i].deviceId);
+        if (ip == NULL || ip->s_addr != g_peers[i].netChannelInfo.wifiApInfo.addr.in.s_addr) {
+            return NSTACKX_EFAILED;
+        }
+    }
+    return NSTACKX_EOK;
+}
+
+int32_t LoopbackPeersPrepareResponses(void)
+{
+    for (uint32_t i = 0; i < g_peerNum; i++) {
+        char *data = PrepareServiceDiscover(AF_INET, LOCAL_IFACE_IP, NSTACKX_FALSE, PEER_BUSINESS_TYPE, NULL);
+        if (data == NULL) {
+            return NSTACKX_EFAILED;
+        }
+        free(data);
+    }
+    return NSTACKX_EOK;
+}
+
+int32_t LoopbackPeersParseResponses(bool compact)
+{
+    size_t len = 0;
+    char *data = compact ? PrepareCompactServiceDiscover(LOCAL_IFACE_IP, PEER_BUSINESS_TYPE, NULL, &len) :
+        PrepareServiceDiscover(AF_INET, LOCAL_IFACE_IP, NSTACKX_FALSE, PEER_BUSINESS_TYPE, NULL);
+    if (data == NULL) {
+        return NSTACKX_EFAILED;
+    }
+    len = compact ? len : strlen(data) + 1;
+    DeviceInfo *deviceInfo = (DeviceInfo *)malloc(sizeof(DeviceInfo));
+    if (deviceInfo == NULL) {
+        free(data);
+        return NSTACKX_ENOMEM;
+    }
+    int32_t ret = NSTACKX_EOK;
+    for (uint32_t i = 0; i < g_peerNum && ret == NSTACKX_EOK; i++) {
+        char *remoteUrl = NULL;
+        (void)memset_s(deviceInfo, sizeof(DeviceInfo), 0, sizeof(DeviceInfo));
+        ret = GetServiceDiscoverInfo((const uint8_t *)data, len, deviceInfo, &remoteUrl);
+        free(remoteUrl);
+    }
+    free(deviceInfo);
+    free(data);
+    return ret;
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NSTACKX_LOOPBACK_PEERS_H
+#define NSTACKX_LOOPBACK_PEERS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// peers live on 127.0.x.y and are seen through the local "lo" iface
+int32_t LoopbackPeersInit(uint32_t peerNum);
+void LoopbackPeersDeinit(void);
+uint32_t LoopbackPeersGetNodeCount(void);
+// every peer sends one discover message and the remote device table is updated
+int32_t LoopbackPeersDiscoveryRound(void);
+int32_t LoopbackPeersLookupIp(void);
+// the local device prepares one unicast response for every peer
+int32_t LoopbackPeersPrepareResponses(void);
+// the local device parses the response of every peer, sent as json or in the compact format
+int32_t LoopbackPeersParseResponses(bool compact);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* NSTACKX_LOOPBACK_PEERS_H */
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "compactpayload_fuzzer.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <securec.h>
+
+extern "C" {
+#include "compact_payload.h"
+#include "nstackx_common.h"
+#include "nstackx_device.h"
+}
+
+namespace OHOS {
+static constexpr size_t MSG_BUFF_MAX_LEN = 1000;
+
+static void DoParseFuzz(const uint8_t *data, size_t size)
+{
+    DeviceInfo deviceInfo;
+    (void)memset_s(&deviceInfo, sizeof(deviceInfo), 0, sizeof(deviceInfo));
+    char *remoteUrl = nullptr;
+    (void)ParseCompactServiceDiscover(data, size, &deviceInfo, &remoteUrl);
+    free(remoteUrl);
+}
+
+static void DoDispatchFuzz(const uint8_t *data, size_t size)
+{
+    DeviceInfo deviceInfo;
+    (void)memset_s(&deviceInfo, sizeof(deviceInfo), 0, sizeof(deviceInfo));
+    char *remoteUrl = nullptr;
+    (void)GetServiceDiscoverInfo(data, size, &deviceInfo, &remoteUrl);
+    free(remoteUrl);
+}
+} // namespace OHOS
+
+/* Fuzzer entry point */
+extern "C" int32_t LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    if (data == nullptr || size == 0 || size > OHOS::MSG_BUFF_MAX_LEN) {
+        return 0;
+    }
+
+    // the raw input goes through the receive path, which picks json or compact by the first byte
+    OHOS::DoDispatchFuzz(data, size);
+
+    // behind a valid header the input is always walked as compact records
+    uint8_t buffer[COMPACT_PAYLOAD_HEADER_LEN + OHOS::MSG_BUFF_MAX_LEN] = {
+        COMPACT_PAYLOAD_MAGIC, COMPACT_PAYLOAD_VERSION
+    };
+    if (memcpy_s(buffer + COMPACT_PAYLOAD_HEADER_LEN, OHOS::MSG_BUFF_MAX_LEN, data, size) != EOK) {
+        return 0;
+    }
+    OHOS::DoParseFuzz(buffer, COMPACT_PAYLOAD_HEADER_LEN + size);
+    return 0;
+}
@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <arpa/inet.h>
+#include <cstdlib>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <securec.h>
+#include <vector>
+
+extern "C" {
+#include "compact_payload.h"
+#include "json_payload.h"
+#include "nstackx_common.h"
+#include "nstackx_device.h"
+#include "nstackx_device_local.h"
+#include "nstackx_error.h"
+}
+
+using namespace testing::ext;
+namespace OHOS {
+static constexpr char LOCAL_DEVICE_ID[] = "{\"UDID\":\"0123456789ABCDEF0123456789ABCDEF\"}";
+static constexpr char LOCAL_DEVICE_NAME[] = "OpenHarmony compact";
+static constexpr char LOCAL_IP[] = "192.168.3.7";
+static constexpr char LOCAL_IPV6[] = "fe80::1234:5678";
+static constexpr char SERVICE_DATA[] = "port:49152,";
+static constexpr char EXTEND_SERVICE_DATA[] = "{\"castPlus\":\"C4\"}";
+static constexpr char BUSINESS_DATA[] = "{\"bData\":\"unicast\"}";
+static constexpr uint32_t LOCAL_DEVICE_TYPE = 0x1A2B3;
+static constexpr uint64_t LOCAL_DEVICE_HASH = 1234567890123ULL;
+static constexpr uint8_t BUSINESS_TYPE = 1;
+static constexpr uint32_t CAPABILITY_FIRST = 0x1FF;
+static constexpr uint32_t CAPABILITY_SECOND = 0x80000001;
+static constexpr uint8_t UNKNOWN_TYPE = 0xEE;
+
+class NstackxCompactPayloadTest : public testing::Test {
+public:
+    NstackxCompactPayloadTest() { }
+    ~NstackxCompactPayloadTest() { }
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override { }
+    void TearDown() override { }
+};
+
+void NstackxCompactPayloadTest::SetUpTestCase()
+{
+    DeviceInfo *local = GetLocalDeviceInfo();
+    (void)strcpy_s(local->deviceId, sizeof(local->deviceId), LOCAL_DEVICE_ID);
+    local->deviceType = LOCAL_DEVICE_TYPE;
+    ConfigureLocalDeviceName(LOCAL_DEVICE_NAME);
+    SetLocalDeviceHash(LOCAL_DEVICE_HASH);
+    uint32_t capability[] = { CAPABILITY_FIRST, CAPABILITY_SECOND };
+    (void)SetLocalDeviceCapability(sizeof(capability) / sizeof(capability[0]), capability);
+    (void)SetLocalDeviceServiceData(SERVICE_DATA);
+    (void)SetLocalDeviceExtendServiceData(EXTEND_SERVICE_DATA);
+    (void)SetLocalDeviceBusinessData(BUSINESS_DATA, true);
+}
+
+void NstackxCompactPayloadTest::TearDownTestCase()
+{
+    ClearServiceDiscoverPayloadCache();
+}
+
+static std::vector<uint8_t> PrepareCompact(const char *ip)
+{
+    size_t len = 0;
+    char *data = PrepareCompactServiceDiscover(ip, BUSINESS_TYPE, nullptr, &len);
+    if (data == nullptr) {
+        return {};
+    }
+    std::vector<uint8_t> payload(data, data + len);
+    free(data);
+    return payload;
+}
+
+static void AppendRecord(std::vector<uint8_t> &payload, uint8_t type, const std::vector<uint8_t> &value)
+{
+    payload.push_back(type);
+    payload.push_back(static_cast<uint8_t>(value.size() >> 8));
+    payload.push_back(static_cast<uint8_t>(value.size() & 0xFF));
+    payload.insert(payload.end(), value.begin(), value.end());
+}
+
+static std::vector<uint8_t> MinimalPayload(void)
+{
+    std::vector<uint8_t> payload = { COMPACT_PAYLOAD_MAGIC, COMPACT_PAYLOAD_VERSION };
+    AppendRecord(payload, COMPACT_TYPE_DEVICE_ID, { 'i', 'd' });
+    AppendRecord(payload, COMPACT_TYPE_DEVICE_NAME, { 'n' });
+    AppendRecord(payload, COMPACT_TYPE_DEVICE_TYPE, { 0, 0, 0, 0x0E });
+    return payload;
+}
+
+static int32_t Parse(const std::vector<uint8_t> &payload, DeviceInfo *deviceInfo)
+{
+    char *remoteUrl = nullptr;
+    (void)memset_s(deviceInfo, sizeof(DeviceInfo), 0, sizeof(DeviceInfo));
+    int32_t ret = ParseCompactServiceDiscover(payload.data(), payload.size(), deviceInfo, &remoteUrl);
+    EXPECT_EQ(remoteUrl, nullptr);
+    free(remoteUrl);
+    return ret;
+}
+
+/*
+ * @tc.name: CompactRoundTrip001
+ * @tc.desc: The compact payload of the local device parses back to the same device info
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(NstackxCompactPayloadTest, CompactRoundTrip001, TestSize.Level1)
+{
+    std::vector<uint8_t> payload = PrepareCompact(LOCAL_IP);
+    ASSERT_FALSE(payload.empty());
+    EXPECT_TRUE(IsCompactServiceDiscover(payload.data(), payload.size()));
+
+    DeviceInfo deviceInfo;
+    ASSERT_EQ(Parse(payload, &deviceInfo), NSTACKX_EOK);
+    EXPECT_STREQ(deviceInfo.deviceId, LOCAL_DEVICE_ID);
+    EXPECT_STREQ(deviceInfo.deviceName, LOCAL_DEVICE_NAME);
+    EXPECT_EQ(deviceInfo.deviceType, LOCAL_DEVICE_TYPE);
+    EXPECT_EQ(deviceInfo.mode, GetLocalDeviceInfo()->mode);
+    EXPECT_STREQ(deviceInfo.deviceHash, GetLocalDeviceInfo()->deviceHash);
+    EXPECT_STREQ(deviceInfo.serviceData, SERVICE_DATA);
+    EXPECT_STREQ(deviceInfo.extendServiceData, EXTEND_SERVICE_DATA);
+    EXPECT_STREQ(deviceInfo.businessData.businessDataUnicast, BUSINESS_DATA);
+    EXPECT_EQ(deviceInfo.businessData.isBroadcast, NSTACKX_FALSE);
+    EXPECT_EQ(deviceInfo.businessType, BUSINESS_TYPE);
+    ASSERT_EQ(deviceInfo.capabilityBitmapNum, 2U);
+    EXPECT_EQ(deviceInfo.capabilityBitmap[0], CAPABILITY_FIRST);
+    EXPECT_EQ(deviceInfo.capabilityBitmap[1], CAPABILITY_SECOND);
+    EXPECT_EQ(deviceInfo.seq.seqUcast, GetSequenceNumber(NSTACKX_FALSE));
+    EXPECT_EQ(deviceInfo.payloadVersion, COMPACT_PAYLOAD_VERSION);
+    EXPECT_EQ(deviceInfo.netChannelInfo.wifiApInfo.af, AF_INET);
+    EXPECT_EQ(deviceInfo.netChannelInfo.wifiApInfo.addr.in.s_addr, inet_addr(LOCAL_IP));
+}
+
+/*
+ * @tc.name: CompactRoundTrip002
+ * @tc.desc: An ipv6 local address survives the round trip
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(NstackxCompactPayloadTest, CompactRoundTrip002, TestSize.Level1)
+{
+    std::vector<uint8_t> payload = PrepareCompact(LOCAL_IPV6);
+    ASSERT_FALSE(payload.empty());
+
+    DeviceInfo deviceInfo;
+    ASSERT_EQ(Parse(payload, &deviceInfo), NSTACKX_EOK);
+    struct in6_addr expect;
+    ASSERT_EQ(inet_pton(AF_INET6, LOCAL_IPV6, &expect), 1);
+    EXPECT_EQ(deviceInfo.netChannelInfo.wifiApInfo.af, AF_INET6);
+    EXPECT_EQ(memcmp(&deviceInfo.netChannelInfo.wifiApInfo.addr.in6, &expect, sizeof(expect)), 0);
+}
+
+/*
+ * @tc.name: CompactMatchesJson001
+ * @tc.desc: The json and the compact unicast reply carry the same device info
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(NstackxCompactPayloadTest, CompactMatchesJson001, TestSize.Level1)
+{
+    char *json = PrepareServiceDiscover(AF_INET, LOCAL_IP, NSTACKX_FALSE, BUSINESS_TYPE, nullptr);
+    ASSERT_NE(json, nullptr);
+    DeviceInfo fromJson;
+    (void)memset_s(&fromJson, sizeof(fromJson), 0, sizeof(fromJson));
+    char *remoteUrl = nullptr;
+    int32_t ret = ParseServiceDiscover(reinterpret_cast<const uint8_t *>(json), &fromJson, &remoteUrl);
+    free(json);
+    ASSERT_EQ(ret, NSTACKX_EOK);
+    EXPECT_EQ(remoteUrl, nullptr);
+
+    DeviceInfo fromCompact;
+    ASSERT_EQ(Parse(PrepareCompact(LOCAL_IP), &fromCompact), NSTACKX_EOK);
+    EXPECT_STREQ(fromCompact.deviceId, fromJson.deviceId);
+    EXPECT_STREQ(fromCompact.deviceName, fromJson.deviceName);
+    EXPECT_EQ(fromCompact.deviceType, fromJson.deviceType);
+    EXPECT_EQ(fromCompact.mode, fromJson.mode);
+    EXPECT_STREQ(fromCompact.deviceHash, fromJson.deviceHash);
+    EXPECT_STREQ(fromCompact.serviceData, fromJson.serviceData);
+    EXPECT_STREQ(fromCompact.extendServiceData, fromJson.extendServiceData);
+    EXPECT_STREQ(fromCompact.businessData.businessDataUnicast, fromJson.businessData.businessDataUnicast);
+    EXPECT_EQ(fromCompact.businessType, fromJson.businessType);
+    EXPECT_EQ(fromCompact.capabilityBitmapNum, fromJson.capabilityBitmapNum);
+    EXPECT_EQ(memcmp(fromCompact.capabilityBitmap, fromJson.capabilityBitmap, sizeof(fromJson.capabilityBitmap)), 0);
+    EXPECT_EQ(fromCompact.netChannelInfo.wifiApInfo.addr.in.s_addr, fromJson.netChannelInfo.wifiApInfo.addr.in.s_addr);
+}
+
+/*
+ * @tc.name: PayloadVersion001
+ * @tc.desc: The json broadcast announces the compact version, legacy json is treated as json only
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(NstackxCompactPayloadTest, PayloadVersion001, TestSize.Level1)
+{
+    char *json = PrepareServiceDiscover(AF_INET, LOCAL_IP, NSTACKX_TRUE, BUSINESS_TYPE, nullptr);
+    ASSERT_NE(json, nullptr);
+    DeviceInfo deviceInfo;
+    (void)memset_s(&deviceInfo, sizeof(deviceInfo), 0, sizeof(deviceInfo));
+    char *remoteUrl = nullptr;
+    int32_t ret = ParseServiceDiscover(reinterpret_cast<const uint8_t *>(json), &deviceInfo, &remoteUrl);
+    free(json);
+    ASSERT_EQ(ret, NSTACKX_EOK);
+    EXPECT_NE(remoteUrl, nullptr);
+    free(remoteUrl);
+    EXPECT_EQ(deviceInfo.payloadVersion, COMPACT_PAYLOAD_VERSION);
+
+    const char legacy[] = "{\"deviceId\":\"legacy\",\"devicename\":\"old\",\"type\":14,"
+        "\"coapUri\":\"coap://192.168.3.8/device_discover\"}";
+    (void)memset_s(&deviceInfo, sizeof(deviceInfo), 0, sizeof(deviceInfo));
+    deviceInfo.payloadVersion = COMPACT_PAYLOAD_VERSION;
+    remoteUrl = nullptr;
+    ASSERT_EQ(ParseServiceDiscover(reinterpret_cast<const uint8_t *>(legacy), &deviceInfo, &remoteUrl), NSTACKX_EOK);
+    free(remoteUrl);
+    EXPECT_EQ(deviceInfo.payloadVersion, PAYLOAD_VERSION_JSON);
+}
+
+/*
+ * @tc.name: PayloadDispatch001
+ * @tc.desc: GetServiceDiscoverInfo takes both formats and tells them apart by the first byte
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(NstackxCompactPayloadTest, PayloadDispatch001, TestSize.Level1)
+{
+    std::vector<uint8_t> payload = PrepareCompact(LOCAL_IP);
+    ASSERT_FALSE(payload.empty());
+    DeviceInfo deviceInfo;
+    (void)memset_s(&deviceInfo, sizeof(deviceInfo), 0, sizeof(deviceInfo));
+    char *remoteUrl = nullptr;
+    EXPECT_EQ(GetServiceDiscoverInfo(payload.data(), payload.size(), &deviceInfo, &remoteUrl), NSTACKX_EOK);
+    EXPECT_STREQ(deviceInfo.deviceId, LOCAL_DEVICE_ID);
+
+    const char json[] = "{\"deviceId\":\"json\",\"devicename\":\"json\",\"type\":14}";
+    EXPECT_FALSE(IsCompactServiceDiscover(reinterpret_cast<const uint8_t *>(json), sizeof(json)));
+    (void)memset_s(&deviceInfo, sizeof(deviceInfo), 0, sizeof(deviceInfo));
+    EXPECT_EQ(GetServiceDiscoverInfo(reinterpret_cast<const uint8_t *>(json), strlen(json), &deviceInfo, &remoteUrl),
+        NSTACKX_EOK);
+    EXPECT_STREQ(deviceInfo.deviceId, "json");
+}
+
+/*
+ * @tc.name: CompactMalformed001
+ * @tc.desc: Truncated payloads and missing mandatory fields are rejected
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(NstackxCompactPayloadTest, CompactMalformed001, TestSize.Level1)
+{
+    DeviceInfo deviceInfo;
+    std::vector<uint8_t> payload = MinimalPayload();
+    ASSERT_EQ(Parse(payload, &deviceInfo), NSTACKX_EOK);
+    EXPECT_EQ(deviceInfo.businessType, NSTACKX_BUSINESS_TYPE_NULL);
+    EXPECT_EQ(deviceInfo.capabilityBitmapNum, 0U);
+
+    for (size_t len = 0; len < payload.size(); len++) {
+        std::vector<uint8_t> truncated(payload.begin(), payload.begin() + len);
+        EXPECT_NE(Parse(truncated, &deviceInfo), NSTACKX_EOK) << "len " << len;
+    }
+
+    std::vector<uint8_t> noName = { COMPACT_PAYLOAD_MAGIC, COMPACT_PAYLOAD_VERSION };
+    AppendRecord(noName, COMPACT_TYPE_DEVICE_ID, { 'i', 'd' });
+    AppendRecord(noName, COMPACT_TYPE_DEVICE_TYPE, { 0, 0, 0, 0x0E });
+    EXPECT_EQ(Parse(noName, &deviceInfo), NSTACKX_EINVAL);
+
+    std::vector<uint8_t> longId = MinimalPayload();
+    AppendRecord(longId, COMPACT_TYPE_DEVICE_ID, std::vector<uint8_t>(NSTACKX_MAX_DEVICE_ID_LEN, 'x'));
+    EXPECT_EQ(Parse(longId, &deviceInfo), NSTACKX_EINVAL);
+
+    std::vector<uint8_t> badType = MinimalPayload();
+    AppendRecord(badType, COMPACT_TYPE_DEVICE_TYPE, { 0x0E });
+    EXPECT_EQ(Parse(badType, &deviceInfo), NSTACKX_EINVAL);
+
+    std::vector<uint8_t> oldVersion = MinimalPayload();
+    oldVersion[1] = PAYLOAD_VERSION_JSON;
+    EXPECT_FALSE(IsCompactServiceDiscover(oldVersion.data(), oldVersion.size()));
+    EXPECT_EQ(Parse(oldVersion, &deviceInfo), NSTACKX_EINVAL);
+}
+
+/*
+ * @tc.name: CompactForward001
+ * @tc.desc: Records of unknown type are skipped and malformed optional fields are ignored,
+ *           a version that is not implemented is not taken as compact
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(NstackxCompactPayloadTest, CompactForward001, TestSize.Level1)
+{
+    std::vector<uint8_t> payload = MinimalPayload();
+    AppendRecord(payload, UNKNOWN_TYPE, std::vector<uint8_t>(NSTACKX_MAX_BUSINESS_DATA_LEN, 'u'));
+    AppendRecord(payload, COMPACT_TYPE_WLAN_IP, { 192, 168, 3 });
+    AppendRecord(payload, COMPACT_TYPE_CAPABILITY_BITMAP, { 0, 0, 1, 0, 0, 0 });
+    AppendRecord(payload, COMPACT_TYPE_BUSINESS_TYPE, { 1, 2 });
+    AppendRecord(payload, COMPACT_TYPE_SERVICE_DATA, std::vector<uint8_t>(NSTACKX_MAX_SERVICE_DATA_LEN, 's'));
+
+    DeviceInfo deviceInfo;
+    ASSERT_EQ(Parse(payload, &deviceInfo), NSTACKX_EOK);
+    EXPECT_STREQ(deviceInfo.deviceId, "id");
+    EXPECT_EQ(deviceInfo.deviceType, 0x0EU);
+    EXPECT_EQ(deviceInfo.payloadVersion, COMPACT_PAYLOAD_VERSION);
+    EXPECT_NE(deviceInfo.netChannelInfo.wifiApInfo.state, NET_CHANNEL_STATE_CONNETED);
+    ASSERT_EQ(deviceInfo.capabilityBitmapNum, 1U);
+    EXPECT_EQ(deviceInfo.capabilityBitmap[0], 0x100U);
+    EXPECT_EQ(deviceInfo.businessType, NSTACKX_BUSINESS_TYPE_NULL);
+    EXPECT_STREQ(deviceInfo.serviceData, "");
+
+    payload[1] = COMPACT_PAYLOAD_VERSION + 1;
+    EXPECT_FALSE(IsCompactServiceDiscover(payload.data(), payload.size()));
+    EXPECT_EQ(Parse(payload, &deviceInfo), NSTACKX_EINVAL);
+}
+} // namespace OHOS
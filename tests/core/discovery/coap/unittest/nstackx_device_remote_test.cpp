@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <arpa/inet.h>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <securec.h>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "nstackx_common.h"
+#include "nstackx_device.h"
+#include "nstackx_device_remote.h"
+#include "nstackx_error.h"
+#include "nstackx_statistics.h"
+#include "nstackx_timer.h"
+}
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+constexpr uint32_t SCALE_NODE_NUM = 10000;
+constexpr uint32_t SCALE_UPDATE_ROUNDS = 10;
+constexpr uint32_t SMALL_TABLE_NUM = 3;
+constexpr uint32_t PEER_NET = 0x0A000000U; // 10.0.0.0/8
+constexpr auto AGED_SLEEP = std::chrono::milliseconds(NSTACKX_MIN_AGING_TIME * NSTACKX_MILLI_TICKS + 100);
+// updating or evicting a node must not depend on how many nodes the table holds
+constexpr auto SCALE_TIME_BOUND = std::chrono::milliseconds(2000);
+
+uint32_t g_maxDeviceNum = NSTACKX_DEFAULT_DEVICE_NUM;
+std::vector<uint32_t> g_listedAddrs;
+} // namespace
+
+/* the remote device table is built into this test, so its capacity is not bounded by NSTACKX_MAX_DEVICE_NUM */
+extern "C" {
+uint32_t GetMaxDeviceNum(void)
+{
+    return g_maxDeviceNum;
+}
+
+uint32_t GetNotifyTimeoutMs(void)
+{
+    return NSTACKX_MILLI_TICKS;
+}
+
+void NotifyDFinderMsgRecver(DFinderMsgType msgType)
+{
+    (void)msgType;
+}
+
+void IncStatistics(StatisticsType type)
+{
+    (void)type;
+}
+
+bool MatchDeviceFilter(const DeviceInfo *deviceInfo)
+{
+    (void)deviceInfo;
+    return true;
+}
+
+bool GetIsNotifyPerDevice(void)
+{
+    return false;
+}
+
+int32_t GetNotifyDeviceInfo(NSTACKX_DeviceInfo *notifyDevice, const DeviceInfo *deviceInfo)
+{
+    (void)notifyDevice;
+    g_listedAddrs.push_back(ntohl(deviceInfo->netChannelInfo.wifiApInfo.addr.in.s_addr));
+    return NSTACKX_EOK;
+}
+}
+
+class NstackxDeviceRemoteTest : public testing::Test {
+public:
+    NstackxDeviceRemoteTest() { }
+    ~NstackxDeviceRemoteTest() { }
+    static void SetUpTestCase(void) { }
+    static void TearDownTestCase(void) { }
+    void SetUp() override
+    {
+        g_maxDeviceNum = SMALL_TABLE_NUM;
+        SetDeviceListAgingTime(NSTACKX_MIN_AGING_TIME);
+        (void)strcpy_s(iface_.networkName, sizeof(iface_.networkName), "wlan0");
+        (void)strcpy_s(iface_.networkIpAddr, sizeof(iface_.networkIpAddr), "10.255.255.1");
+        ASSERT_EQ(RemoteDeviceListInit(), NSTACKX_EOK);
+    }
+    void TearDown() override
+    {
+        RemoteDeviceListDeinit();
+    }
+
+    void BuildPeers(uint32_t num, uint32_t first = 0)
+    {
+        peers_.assign(num, DeviceInfo {});
+        for (uint32_t i = 0; i < num; i++) {
+            DeviceInfo &peer = peers_[i];
+            (void)sprintf_s(peer.deviceId, sizeof(peer.deviceId), "{\"UDID\":\"peer-%05u\"}", first + i);
+            (void)sprintf_s(peer.deviceName, sizeof(peer.deviceName), "peer %u", first + i);
+            peer.netChannelInfo.wifiApInfo.af = AF_INET;
+            peer.netChannelInfo.wifiApInfo.addr.in.s_addr = htonl(PEER_NET + first + i);
+            peer.discoveryType = NSTACKX_DISCOVERY_TYPE_PASSIVE;
+            peer.seq.dealBcast = NSTACKX_TRUE;
+        }
+    }
+
+    int32_t Receive(DeviceInfo &peer)
+    {
+        int8_t updated = NSTACKX_FALSE;
+        peer.seq.seqBcast++;
+        return UpdateRemoteNodeByDeviceInfo(peer.deviceId, &iface_, &peer, &updated);
+    }
+
+    bool IsKnown(const DeviceInfo &peer)
+    {
+        return GetRemoteDeviceIp(peer.deviceId) != nullptr;
+    }
+
+    NSTACKX_InterfaceInfo iface_ {};
+    std::vector<DeviceInfo> peers_;
+};
+
+/*
+ * @tc.name: AgingEvict001
+ * @tc.desc: a full table refuses new nodes until its nodes age, then evicts them least recently updated first
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(NstackxDeviceRemoteTest, AgingEvict001, TestSize.Level1)
+{
+    BuildPeers(SMALL_TABLE_NUM + 3);
+    for (uint32_t i = 0; i < SMALL_TABLE_NUM; i++) {
+        EXPECT_EQ(Receive(peers_[i]), NSTACKX_EOK);
+    }
+    EXPECT_EQ(Receive(peers_[SMALL_TABLE_NUM]), NSTACKX_EFAILED);
+    EXPECT_EQ(GetRemoteNodeCount(), SMALL_TABLE_NUM);
+    EXPECT_FALSE(IsKnown(peers_[SMALL_TABLE_NUM]));
+
+    std::this_thread::sleep_for(AGED_SLEEP);
+    // peer 0 is heard again, peer 1 becomes the least recently updated
+    EXPECT_EQ(Receive(peers_[0]), NSTACKX_EOK);
+    EXPECT_EQ(Receive(peers_[SMALL_TABLE_NUM]), NSTACKX_EOK);
+    EXPECT_FALSE(IsKnown(peers_[1]));
+    EXPECT_TRUE(IsKnown(peers_[0]));
+    EXPECT_TRUE(IsKnown(peers_[2]));
+    EXPECT_EQ(Receive(peers_[SMALL_TABLE_NUM + 1]), NSTACKX_EOK);
+    EXPECT_FALSE(IsKnown(peers_[2]));
+    EXPECT_TRUE(IsKnown(peers_[0]));
+    // the remaining nodes were updated just now and have not aged yet
+    EXPECT_EQ(Receive(peers_[SMALL_TABLE_NUM + 2]), NSTACKX_EFAILED);
+    EXPECT_EQ(GetRemoteNodeCount(), SMALL_TABLE_NUM);
+}
+
+/*
+ * @tc.name: RemoveOldest001
+ * @tc.desc: shrinking the table removes the least recently updated nodes and stops once the table is empty
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(NstackxDeviceRemoteTest, RemoveOldest001, TestSize.Level1)
+{
+    BuildPeers(SMALL_TABLE_NUM);
+    for (auto &peer : peers_) {
+        EXPECT_EQ(Receive(peer), NSTACKX_EOK);
+    }
+    EXPECT_EQ(Receive(peers_[0]), NSTACKX_EOK);
+    RemoveOldestNodesWithCount(2);
+    EXPECT_EQ(GetRemoteNodeCount(), 1U);
+    EXPECT_TRUE(IsKnown(peers_[0]));
+    EXPECT_FALSE(IsKnown(peers_[1]));
+    EXPECT_FALSE(IsKnown(peers_[2]));
+
+    RemoveOldestNodesWithCount(SMALL_TABLE_NUM);
+    EXPECT_EQ(GetRemoteNodeCount(), 0U);
+    EXPECT_FALSE(IsKnown(peers_[0]));
+}
+
+/*
+ * @tc.name: IfaceEvict001
+ * @tc.desc: a device seen with more addresses than an iface keeps drops the least recently updated address
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(NstackxDeviceRemoteTest, IfaceEvict001, TestSize.Level1)
+{
+    constexpr uint32_t addrNum = 5;
+    g_maxDeviceNum = addrNum;
+    BuildPeers(1);
+    DeviceInfo peer = peers_[0];
+    for (uint32_t i = 0; i < addrNum - 1; i++) {
+        peer.netChannelInfo.wifiApInfo.addr.in.s_addr = htonl(PEER_NET + i);
+        EXPECT_EQ(Receive(peer), NSTACKX_EOK);
+    }
+    peer.netChannelInfo.wifiApInfo.addr.in.s_addr = htonl(PEER_NET);
+    EXPECT_EQ(Receive(peer), NSTACKX_EOK);
+    peer.netChannelInfo.wifiApInfo.addr.in.s_addr = htonl(PEER_NET + addrNum - 1);
+    EXPECT_EQ(Receive(peer), NSTACKX_EOK);
+
+    NSTACKX_DeviceInfo deviceList[addrNum] = {};
+    uint32_t deviceNum = addrNum;
+    g_listedAddrs.clear();
+    GetDeviceList(deviceList, &deviceNum, false);
+    std::vector<uint32_t> expectAddrs = { PEER_NET, PEER_NET + 2, PEER_NET + 3, PEER_NET + 4 };
+    EXPECT_EQ(g_listedAddrs, expectAddrs);
+    EXPECT_EQ(GetRemoteNodeCount(), expectAddrs.size());
+}
+
+/*
+ * @tc.name: Backup001
+ * @tc.desc: the backup table keeps its own nodes, clearing it does not change the count of the current table
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(NstackxDeviceRemoteTest, Backup001, TestSize.Level1)
+{
+    BuildPeers(SMALL_TABLE_NUM * 2);
+    for (uint32_t i = 0; i < SMALL_TABLE_NUM; i++) {
+        EXPECT_EQ(Receive(peers_[i]), NSTACKX_EOK);
+    }
+    BackupRemoteDeviceList();
+    EXPECT_EQ(GetRemoteNodeCount(), 0U);
+    EXPECT_TRUE(IsKnown(peers_[0]));
+
+    for (uint32_t i = SMALL_TABLE_NUM; i < SMALL_TABLE_NUM * 2; i++) {
+        EXPECT_EQ(Receive(peers_[i]), NSTACKX_EOK);
+    }
+    // the current table is full, its nodes are too young to be evicted
+    EXPECT_EQ(Receive(peers_[0]), NSTACKX_EFAILED);
+    ClearRemoteDeviceListBackup();
+    EXPECT_EQ(GetRemoteNodeCount(), SMALL_TABLE_NUM);
+    EXPECT_FALSE(IsKnown(peers_[0]));
+    EXPECT_EQ(Receive(peers_[0]), NSTACKX_EFAILED);
+}
+
+/*
+ * @tc.name: AgingScale001
+ * @tc.desc: updates and aging evictions over ten thousand remote nodes keep the table consistent, and their
+ *           cost does not grow with the number of nodes
+ * @tc.type: PERF
+ * @tc.require:
+ */
+HWTEST_F(NstackxDeviceRemoteTest, AgingScale001, TestSize.Level1)
+{
+    g_maxDeviceNum = SCALE_NODE_NUM;
+    BuildPeers(SCALE_NODE_NUM);
+    for (auto &peer : peers_) {
+        ASSERT_EQ(Receive(peer), NSTACKX_EOK);
+    }
+    ASSERT_EQ(GetRemoteNodeCount(), SCALE_NODE_NUM);
+
+    auto begin = std::chrono::steady_clock::now();
+    for (uint32_t round = 0; round < SCALE_UPDATE_ROUNDS; round++) {
+        // peers answer in a different order every round
+        for (uint32_t i = 0; i < SCALE_NODE_NUM; i++) {
+            EXPECT_EQ(Receive(peers_[(i * (round * 2 + 1)) % SCALE_NODE_NUM]), NSTACKX_EOK);
+        }
+    }
+    auto updateCost = std::chrono::steady_clock::now() - begin;
+    EXPECT_LT(updateCost, SCALE_TIME_BOUND);
+
+    std::vector<DeviceInfo> agedPeers;
+    agedPeers.swap(peers_);
+    std::this_thread::sleep_for(AGED_SLEEP);
+    // the first half is heard again, the second half ages and is replaced by new peers
+    for (uint32_t i = 0; i < SCALE_NODE_NUM / 2; i++) {
+        EXPECT_EQ(Receive(agedPeers[i]), NSTACKX_EOK);
+    }
+    BuildPeers(SCALE_NODE_NUM / 2, SCALE_NODE_NUM);
+    begin = std::chrono::steady_clock::now();
+    for (auto &peer : peers_) {
+        EXPECT_EQ(Receive(peer), NSTACKX_EOK);
+    }
+    auto evictCost = std::chrono::steady_clock::now() - begin;
+    EXPECT_LT(evictCost, SCALE_TIME_BOUND);
+    printf("nodes=%u, updates=%u, updateCostUs=%lld, evictions=%u, evictCostUs=%lld\n", SCALE_NODE_NUM,
+        SCALE_NODE_NUM * SCALE_UPDATE_ROUNDS,
+        static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(updateCost).count()),
+        SCALE_NODE_NUM / 2,
+        static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(evictCost).count()));
+
+    EXPECT_EQ(GetRemoteNodeCount(), SCALE_NODE_NUM);
+    for (uint32_t i = 0; i < SCALE_NODE_NUM; i++) {
+        EXPECT_EQ(IsKnown(agedPeers[i]), i < SCALE_NODE_NUM / 2);
+    }
+    for (auto &peer : peers_) {
+        EXPECT_TRUE(IsKnown(peer));
+    }
+}
+} // namespace OHOS
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "disc_cap_index.h"
+#include "disc_log.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+constexpr uint32_t SUBSCRIPTION_NUM = 4096;
+constexpr uint32_t CHURN_ROUNDS = 100000;
+constexpr uint32_t CHURN_STEP = 7;
+// adding or removing one subscription must not depend on how many there are
+constexpr auto CHURN_TIME_BOUND = std::chrono::milliseconds(500);
+
+struct TestSubscription {
+    ListNode capNode;
+    uint32_t capBit;
+    bool isInner;
+};
+
+uint32_t CapBitmap(uint32_t capBit)
+{
+    return 1U << capBit;
+}
+
+uint32_t CountSubscribers(DiscCapIndex *index, uint32_t capBit)
+{
+    uint32_t num = 0;
+    ListNode *item = nullptr;
+    LIST_FOR_EACH(item, DiscCapIndexGetSubscribers(index, capBit)) {
+        num++;
+    }
+    return num;
+}
+} // namespace
+
+class DiscCapIndexTest : public testing::Test {
+public:
+    DiscCapIndexTest() { }
+    ~DiscCapIndexTest() { }
+    static void SetUpTestCase(void) { }
+    static void TearDownTestCase(void) { }
+    void SetUp() override
+    {
+        DiscCapIndexInit(&index_);
+    }
+    void TearDown() override { }
+
+    DiscCapIndex index_;
+};
+
+/*
+ * @tc.name: CapIndexAddRemove001
+ * @tc.desc: the aggregate bitmap follows the first and the last subscriber of each capability
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DiscCapIndexTest, CapIndexAddRemove001, TestSize.Level1)
+{
+    TestSubscription subs[3] = {};
+    EXPECT_TRUE(DiscCapIndexAdd(&index_, 1, &subs[0].capNode, false));
+    EXPECT_FALSE(DiscCapIndexAdd(&index_, 1, &subs[1].capNode, false));
+    EXPECT_TRUE(DiscCapIndexAdd(&index_, 3, &subs[2].capNode, false));
+    EXPECT_EQ(index_.allCap[0], CapBitmap(1) | CapBitmap(3));
+    EXPECT_EQ(index_.totalCnt, 3U);
+
+    uint32_t found = CapBitmap(1) | CapBitmap(3) | CapBitmap(5);
+    EXPECT_TRUE(DiscCapIndexIsMatch(&index_, &found, CAPABILITY_NUM));
+    EXPECT_EQ(DiscCapIndexGetSubscriberNum(&index_, &found, CAPABILITY_NUM), 3U);
+    uint32_t other = CapBitmap(5);
+    EXPECT_FALSE(DiscCapIndexIsMatch(&index_, &other, CAPABILITY_NUM));
+    EXPECT_EQ(DiscCapIndexGetSubscriberNum(&index_, &other, CAPABILITY_NUM), 0U);
+
+    EXPECT_FALSE(DiscCapIndexRemove(&index_, 1, &subs[0].capNode));
+    EXPECT_EQ(index_.allCap[0], CapBitmap(1) | CapBitmap(3));
+    EXPECT_TRUE(DiscCapIndexRemove(&index_, 1, &subs[1].capNode));
+    EXPECT_EQ(index_.allCap[0], CapBitmap(3));
+    EXPECT_TRUE(DiscCapIndexRemove(&index_, 3, &subs[2].capNode));
+    EXPECT_EQ(index_.allCap[0], 0U);
+    EXPECT_EQ(index_.totalCnt, 0U);
+}
+
+/*
+ * @tc.name: CapIndexAddRemove002
+ * @tc.desc: invalid params and a second removal of the same subscription leave the index untouched
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DiscCapIndexTest, CapIndexAddRemove002, TestSize.Level1)
+{
+    TestSubscription subs[2] = {};
+    EXPECT_FALSE(DiscCapIndexAdd(nullptr, 1, &subs[0].capNode, false));
+    EXPECT_FALSE(DiscCapIndexAdd(&index_, CAPABILITY_MAX_BITNUM, &subs[0].capNode, false));
+    EXPECT_FALSE(DiscCapIndexAdd(&index_, 1, nullptr, false));
+    EXPECT_EQ(DiscCapIndexGetSubscribers(&index_, CAPABILITY_MAX_BITNUM), nullptr);
+
+    EXPECT_TRUE(DiscCapIndexAdd(&index_, 2, &subs[0].capNode, false));
+    EXPECT_FALSE(DiscCapIndexAdd(&index_, 2, &subs[1].capNode, false));
+    EXPECT_FALSE(DiscCapIndexRemove(&index_, 2, &subs[0].capNode));
+    EXPECT_FALSE(DiscCapIndexRemove(&index_, 2, &subs[0].capNode));
+    EXPECT_EQ(index_.subscriberCnt[2], 1U);
+    EXPECT_EQ(index_.allCap[0], CapBitmap(2));
+    EXPECT_TRUE(DiscCapIndexRemove(&index_, 2, &subs[1].capNode));
+}
+
+/*
+ * @tc.name: CapIndexOrder001
+ * @tc.desc: priority subscribers are listed before the others
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DiscCapIndexTest, CapIndexOrder001, TestSize.Level1)
+{
+    TestSubscription subs[3] = {};
+    subs[1].isInner = true;
+    for (auto &sub : subs) {
+        (void)DiscCapIndexAdd(&index_, 0, &sub.capNode, sub.isInner);
+    }
+    TestSubscription *first = LIST_ENTRY(DiscCapIndexGetSubscribers(&index_, 0)->next, TestSubscription, capNode);
+    EXPECT_EQ(first, &subs[1]);
+    TestSubscription *last = LIST_ENTRY(DiscCapIndexGetSubscribers(&index_, 0)->prev, TestSubscription, capNode);
+    EXPECT_EQ(last, &subs[2]);
+}
+
+/*
+ * @tc.name: CapIndexChurn001
+ * @tc.desc: subscribe and unsubscribe churn over thousands of subscriptions keeps the counts, lists and
+ *           aggregate bitmap consistent, and its cost does not grow with the number of subscriptions
+ * @tc.type: PERF
+ * @tc.require:
+ */
+HWTEST_F(DiscCapIndexTest, CapIndexChurn001, TestSize.Level1)
+{
+    std::vector<TestSubscription> subs(SUBSCRIPTION_NUM);
+    std::vector<bool> isAdded(SUBSCRIPTION_NUM, false);
+    for (uint32_t i = 0; i < SUBSCRIPTION_NUM; i++) {
+        subs[i].capBit = i % CAPABILITY_MAX_BITNUM;
+        subs[i].isInner = (i % CHURN_STEP) == 0;
+        ListInit(&subs[i].capNode);
+    }
+    for (uint32_t i = 0; i < SUBSCRIPTION_NUM; i += 2) {
+        (void)DiscCapIndexAdd(&index_, subs[i].capBit, &subs[i].capNode, subs[i].isInner);
+        isAdded[i] = true;
+    }
+
+    uint32_t pos = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (uint32_t round = 0; round < CHURN_ROUNDS; round++) {
+        pos = (pos + CHURN_STEP) % SUBSCRIPTION_NUM;
+        TestSubscription &sub = subs[pos];
+        if (isAdded[pos]) {
+            (void)DiscCapIndexRemove(&index_, sub.capBit, &sub.capNode);
+        } else {
+            (void)DiscCapIndexAdd(&index_, sub.capBit, &sub.capNode, sub.isInner);
+        }
+        isAdded[pos] = !isAdded[pos];
+    }
+    auto cost = std::chrono::steady_clock::now() - begin;
+    DISC_LOGI(DISC_TEST, "churn rounds=%{public}u, subscriptions=%{public}u, costUs=%{public}lld", CHURN_ROUNDS,
+        SUBSCRIPTION_NUM, static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(cost).count()));
+    EXPECT_LT(cost, CHURN_TIME_BOUND);
+
+    uint32_t expectCnt[CAPABILITY_MAX_BITNUM] = { 0 };
+    uint32_t expectCap = 0;
+    uint32_t expectTotal = 0;
+    for (uint32_t i = 0; i < SUBSCRIPTION_NUM; i++) {
+        if (isAdded[i]) {
+            expectCnt[subs[i].capBit]++;
+            expectCap |= CapBitmap(subs[i].capBit);
+            expectTotal++;
+        }
+    }
+    for (uint32_t capBit = 0; capBit < CAPABILITY_MAX_BITNUM; capBit++) {
+        EXPECT_EQ(index_.subscriberCnt[capBit], expectCnt[capBit]);
+        EXPECT_EQ(CountSubscribers(&index_, capBit), expectCnt[capBit]);
+    }
+    EXPECT_EQ(index_.allCap[0], expectCap);
+    EXPECT_EQ(index_.totalCnt, expectTotal);
+    uint32_t allBits = 0xFFFF;
+    EXPECT_EQ(DiscCapIndexGetSubscriberNum(&index_, &allBits, CAPABILITY_NUM), expectTotal);
+
+    for (uint32_t i = 0; i < SUBSCRIPTION_NUM; i++) {
+        if (isAdded[i]) {
+            (void)DiscCapIndexRemove(&index_, subs[i].capBit, &subs[i].capNode);
+        }
+    }
+    EXPECT_EQ(index_.allCap[0], 0U);
+    EXPECT_EQ(index_.totalCnt, 0U);
+}
+} // namespace OHOS
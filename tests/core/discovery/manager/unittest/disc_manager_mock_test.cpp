@@ -23,7 +23,9 @@
 #include "disc_interface.h"
 #include "disc_log.h"
 #include "disc_manager.h"
+#include "securec.h"
 #include "softbus_error_code.h"
+#include "softbus_feature_config.h"
 #include "usb_mock.h"
 
 using namespace testing::ext;
@@ -55,6 +57,7 @@ public:
     static void OnDeviceFoundInner(const DeviceInfo *device, const InnerDeviceInfoAddtions *additions)
     {
         innerDeviceInfo_ = *device;
+        innerDeviceFoundCount_++;
     }
 
     static int32_t OnDeviceFound(const char *packageName, const DeviceInfo *device,
@@ -62,9 +65,42 @@ public:
     {
         callbackPackageName_ = packageName;
         deviceInfo_ = *device;
+        deviceFoundCount_++;
         return SOFTBUS_OK;
     }
 
+    static void SetFoundSuppressWindow(uint32_t window)
+    {
+        (void)SoftbusSetConfig(SOFTBUS_INT_DISC_FOUND_SUPPRESS_WINDOW, (const unsigned char *)&window,
+            sizeof(window));
+    }
+
+    static void StartFoundStreamDiscovery()
+    {
+        SubscribeInfo info = {
+            .subscribeId = SUBSCRIBE_ID8,
+            .mode = DISCOVER_MODE_ACTIVE,
+            .medium = BLE,
+            .freq = LOW,
+            .capability = "osdCapability",
+        };
+        EXPECT_EQ(DiscStartDiscovery(packageName_, &info, &serverCallback_, 0), SOFTBUS_OK);
+        EXPECT_EQ(DiscStartAdvertise(MODULE_LNN, &info, 0), SOFTBUS_OK);
+        EXPECT_EQ(DiscSetDiscoverCallback(MODULE_LNN, &innerCallback_), SOFTBUS_OK);
+        deviceFoundCount_ = 0;
+        innerDeviceFoundCount_ = 0;
+    }
+
+    static DeviceInfo BuildFoundDevice(const char *devId)
+    {
+        DeviceInfo device = {};
+        EXPECT_EQ(strcpy_s(device.devId, sizeof(device.devId), devId), EOK);
+        EXPECT_EQ(strcpy_s(device.devName, sizeof(device.devName), "TestDevice"), EOK);
+        device.capabilityBitmapNum = 1;
+        device.capabilityBitmap[0] = 1 << OSD_CAPABILITY_BITMAP;
+        return device;
+    }
+
     static void DiscMgrInitFuncMock()
     {
         BleMock bleMock;
@@ -91,6 +127,8 @@ public:
     static inline IServerDiscInnerCallback serverCallback_ { OnDeviceFound };
     static inline DeviceInfo innerDeviceInfo_;
     static inline DeviceInfo deviceInfo_;
+    static inline uint32_t deviceFoundCount_ = 0;
+    static inline uint32_t innerDeviceFoundCount_ = 0;
 
     static constexpr int32_t PUBLISH_ID1 = 1;
     static constexpr int32_t PUBLISH_ID2 = 2;
@@ -110,6 +148,10 @@ public:
     static constexpr int32_t SUBSCRIBE_ID7 = 7;
     static constexpr int32_t SUBSCRIBE_ID8 = 8;
 
+    static constexpr uint32_t FOUND_STREAM_NUM = 1000;
+    static constexpr uint32_t DEFAULT_FOUND_SUPPRESS_WINDOW = 1000;
+    static constexpr uint32_t SHORT_FOUND_SUPPRESS_WINDOW = 100;
+
     static inline std::string callbackPackageName_;
     static inline const char *packageName_ = "TestPackage";
     static inline const char *packageName1_ = "TestPackage1";
@@ -926,6 +968,85 @@ HWTEST_F(DiscManagerMockTest, DiscMgrDeathCallback001, TestSize.Level1)
     DISC_LOGI(DISC_TEST, "DiscMgrDeathCallback001 end ----");
 }
 
+/*
+ * @tc.name: DiscOnDeviceFoundDedup001
+ * @tc.desc: a high rate stream of the same devices reaches applications once per change
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DiscManagerMockTest, DiscOnDeviceFoundDedup001, TestSize.Level1)
+{
+    DISC_LOGI(DISC_TEST, "DiscOnDeviceFoundDedup001 begin ----");
+    SetFoundSuppressWindow(DEFAULT_FOUND_SUPPRESS_WINDOW);
+    DiscMgrInitFuncMock();
+    {
+        BleMock bleMock;
+        bleMock.SetupStub();
+        StartFoundStreamDiscovery();
+
+        DeviceInfo first = BuildFoundDevice("device1");
+        DeviceInfo second = BuildFoundDevice("device2");
+        for (uint32_t i = 0; i < FOUND_STREAM_NUM; i++) {
+            BleMock::InjectDeviceFoundEvent((i % 2 == 0) ? &first : &second);
+        }
+        EXPECT_EQ(deviceFoundCount_, 2U);
+        EXPECT_EQ(innerDeviceFoundCount_, FOUND_STREAM_NUM);
+
+        EXPECT_EQ(strcpy_s(first.devName, sizeof(first.devName), "RenamedDevice"), EOK);
+        for (uint32_t i = 0; i < FOUND_STREAM_NUM; i++) {
+            BleMock::InjectDeviceFoundEvent(&first);
+        }
+        EXPECT_EQ(deviceFoundCount_, 3U);
+        EXPECT_STREQ(deviceInfo_.devName, "RenamedDevice");
+    }
+    DiscMgrDeInitFuncMock();
+    DISC_LOGI(DISC_TEST, "DiscOnDeviceFoundDedup001 end ----");
+}
+
+/*
+ * @tc.name: DiscOnDeviceFoundDedup002
+ * @tc.desc: an unchanged device is reported again once the suppression window expires, 0 disables the suppression
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DiscManagerMockTest, DiscOnDeviceFoundDedup002, TestSize.Level1)
+{
+    DISC_LOGI(DISC_TEST, "DiscOnDeviceFoundDedup002 begin ----");
+    SetFoundSuppressWindow(SHORT_FOUND_SUPPRESS_WINDOW);
+    DiscMgrInitFuncMock();
+    {
+        BleMock bleMock;
+        bleMock.SetupStub();
+        StartFoundStreamDiscovery();
+
+        DeviceInfo device = BuildFoundDevice("device1");
+        BleMock::InjectDeviceFoundEvent(&device);
+        BleMock::InjectDeviceFoundEvent(&device);
+        EXPECT_EQ(deviceFoundCount_, 1U);
+        std::this_thread::sleep_for(std::chrono::milliseconds(SHORT_FOUND_SUPPRESS_WINDOW * 2));
+        BleMock::InjectDeviceFoundEvent(&device);
+        EXPECT_EQ(deviceFoundCount_, 2U);
+    }
+    DiscMgrDeInitFuncMock();
+
+    SetFoundSuppressWindow(0);
+    DiscMgrInitFuncMock();
+    {
+        BleMock bleMock;
+        bleMock.SetupStub();
+        StartFoundStreamDiscovery();
+
+        DeviceInfo device = BuildFoundDevice("device1");
+        for (uint32_t i = 0; i < FOUND_STREAM_NUM; i++) {
+            BleMock::InjectDeviceFoundEvent(&device);
+        }
+        EXPECT_EQ(deviceFoundCount_, FOUND_STREAM_NUM);
+    }
+    DiscMgrDeInitFuncMock();
+    SetFoundSuppressWindow(DEFAULT_FOUND_SUPPRESS_WINDOW);
+    DISC_LOGI(DISC_TEST, "DiscOnDeviceFoundDedup002 end ----");
+}
+
 /*
  * @tc.name: DiscManagerDeinit001
  * @tc.desc: discovery manager init success
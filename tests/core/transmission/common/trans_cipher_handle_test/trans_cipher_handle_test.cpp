@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include <atomic>
+#include <securec.h>
+#include <thread>
+#include <vector>
+
+#include "softbus_adapter_crypto.h"
+#include "softbus_adapter_mem.h"
+#include "softbus_error_code.h"
+#include "trans_cipher_handle.h"
+#include "trans_proxy_process_data.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+constexpr int32_t TEST_CHANNEL_ID = 1025;
+constexpr int32_t RACE_CHANNEL_NUM = 4;
+constexpr int32_t RACE_WORKER_NUM = 8;
+constexpr int32_t RACE_ROUNDS = 2000;
+constexpr uint32_t TEST_DATA_LEN = 64;
+
+void BuildKey(char *key, int32_t channelId)
+{
+    for (uint32_t i = 0; i < SESSION_KEY_LENGTH; i++) {
+        key[i] = static_cast<char>(channelId + i);
+    }
+}
+
+TransCipherHandle *CreateHandle(int32_t channelId)
+{
+    char key[SESSION_KEY_LENGTH] = { 0 };
+    BuildKey(key, channelId);
+    return TransCipherHandleCreate(key, SESSION_KEY_LENGTH);
+}
+
+// encrypt and decrypt through two separate lookups, either may miss while the channel is being torn down
+bool RoundTrip(TransCipherTable *table, int32_t channelId, int32_t seq, std::atomic<int32_t> &missed)
+{
+    uint8_t plain[TEST_DATA_LEN] = { 0 };
+    (void)memset_s(plain, sizeof(plain), seq & 0xFF, sizeof(plain));
+    uint8_t cipherText[TEST_DATA_LEN + OVERHEAD_LEN] = { 0 };
+    uint8_t decrypted[TEST_DATA_LEN + OVERHEAD_LEN] = { 0 };
+    uint32_t cipherLen = sizeof(cipherText);
+    uint32_t decryptedLen = sizeof(decrypted);
+
+    TransCipherHandle *handle = TransCipherTableAcquire(table, channelId);
+    if (handle == nullptr) {
+        missed++;
+        return true;
+    }
+    int32_t ret = TransCipherHandleEncrypt(handle, plain, sizeof(plain), cipherText, &cipherLen, seq);
+    TransCipherHandleUnref(handle);
+    if (ret != SOFTBUS_OK) {
+        return false;
+    }
+    handle = TransCipherTableAcquire(table, channelId);
+    if (handle == nullptr) {
+        missed++;
+        return true;
+    }
+    ret = TransCipherHandleDecrypt(handle, cipherText, cipherLen, decrypted, &decryptedLen, seq);
+    TransCipherHandleUnref(handle);
+    return ret == SOFTBUS_OK && decryptedLen == sizeof(plain) && memcmp(plain, decrypted, sizeof(plain)) == 0;
+}
+} // namespace
+
+class TransCipherHandleTest : public testing::Test {
+public:
+    TransCipherHandleTest()
+    {}
+    ~TransCipherHandleTest()
+    {}
+    static void SetUpTestCase(void)
+    {}
+    static void TearDownTestCase(void)
+    {}
+    void SetUp() override
+    {
+        (void)memset_s(&table_, sizeof(table_), 0, sizeof(table_));
+        ASSERT_EQ(TransCipherTableInit(&table_), SOFTBUS_OK);
+    }
+    void TearDown() override
+    {
+        TransCipherTableDeinit(&table_);
+    }
+
+    TransCipherTable table_;
+};
+
+/**
+ * @tc.name: CipherHandleCreate001
+ * @tc.desc: a handle is only created from a valid key and works with the key based proxy packing
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(TransCipherHandleTest, CipherHandleCreate001, TestSize.Level1)
+{
+    EXPECT_EQ(TransCipherHandleCreate(nullptr, SESSION_KEY_LENGTH), nullptr);
+    char key[SESSION_KEY_LENGTH] = { 0 };
+    BuildKey(key, TEST_CHANNEL_ID);
+    EXPECT_EQ(TransCipherHandleCreate(key, 0), nullptr);
+    EXPECT_EQ(TransCipherHandleCreate(key, SESSION_KEY_LENGTH + 1), nullptr);
+
+    TransCipherHandle *handle = TransCipherHandleCreate(key, SESSION_KEY_LENGTH);
+    ASSERT_NE(handle, nullptr);
+    uint8_t plain[TEST_DATA_LEN] = { 0 };
+    ProxyDataInfo dataInfo = { plain, sizeof(plain), nullptr, 0 };
+    int32_t ret = TransProxyPackBytesByCipher(TEST_CHANNEL_ID, &dataInfo, handle, TRANS_SESSION_BYTES, 1);
+    ASSERT_EQ(ret, SOFTBUS_OK);
+
+    uint8_t decrypted[TEST_DATA_LEN] = { 0 };
+    ProxyDataInfo recvInfo = { dataInfo.outData + sizeof(PacketHead),
+        static_cast<uint32_t>(dataInfo.outLen - sizeof(PacketHead)), decrypted, sizeof(decrypted) };
+    EXPECT_EQ(TransProxyDecryptPacketData(1, &recvInfo, key), SOFTBUS_OK);
+    EXPECT_EQ(recvInfo.outLen, sizeof(plain));
+    EXPECT_EQ(memcmp(plain, decrypted, sizeof(plain)), 0);
+    SoftBusFree(dataInfo.outData);
+
+    EXPECT_EQ(TransProxyPackBytesByCipher(TEST_CHANNEL_ID, &dataInfo, nullptr, TRANS_SESSION_BYTES, 1),
+        SOFTBUS_INVALID_PARAM);
+    EXPECT_EQ(TransProxyDecryptPacketDataByCipher(1, &recvInfo, nullptr), SOFTBUS_INVALID_PARAM);
+    TransCipherHandleUnref(handle);
+}
+
+/**
+ * @tc.name: CipherTableAddRemove001
+ * @tc.desc: a channel has one cipher, and a handle acquired before removal stays usable
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(TransCipherHandleTest, CipherTableAddRemove001, TestSize.Level1)
+{
+    TransCipherHandle *handle = CreateHandle(TEST_CHANNEL_ID);
+    ASSERT_NE(handle, nullptr);
+    EXPECT_EQ(TransCipherTableAdd(&table_, TEST_CHANNEL_ID, nullptr), SOFTBUS_INVALID_PARAM);
+    ASSERT_EQ(TransCipherTableAdd(&table_, TEST_CHANNEL_ID, handle), SOFTBUS_OK);
+
+    TransCipherHandle *other = CreateHandle(TEST_CHANNEL_ID);
+    ASSERT_NE(other, nullptr);
+    EXPECT_EQ(TransCipherTableAdd(&table_, TEST_CHANNEL_ID, other), SOFTBUS_ALREADY_EXISTED);
+    TransCipherHandleUnref(other);
+
+    TransCipherHandle *held = TransCipherTableAcquire(&table_, TEST_CHANNEL_ID);
+    EXPECT_EQ(held, handle);
+    EXPECT_EQ(TransCipherTableAcquire(&table_, TEST_CHANNEL_ID + TRANS_CIPHER_TABLE_BUCKET_NUM), nullptr);
+    TransCipherTableRemove(&table_, TEST_CHANNEL_ID);
+    EXPECT_EQ(TransCipherTableAcquire(&table_, TEST_CHANNEL_ID), nullptr);
+
+    uint8_t plain[TEST_DATA_LEN] = { 0 };
+    uint8_t cipherText[TEST_DATA_LEN + OVERHEAD_LEN] = { 0 };
+    uint32_t cipherLen = sizeof(cipherText);
+    EXPECT_EQ(TransCipherHandleEncrypt(held, plain, sizeof(plain), cipherText, &cipherLen, 1), SOFTBUS_OK);
+    TransCipherHandleUnref(held);
+}
+
+/**
+ * @tc.name: CipherTableRace001
+ * @tc.desc: senders and receivers keep encrypting and decrypting while the channels are closed and
+ *           reopened under them, every lookup either misses or completes a correct round trip
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(TransCipherHandleTest, CipherTableRace001, TestSize.Level1)
+{
+    for (int32_t i = 0; i < RACE_CHANNEL_NUM; i++) {
+        ASSERT_EQ(TransCipherTableAdd(&table_, TEST_CHANNEL_ID + i, CreateHandle(TEST_CHANNEL_ID + i)), SOFTBUS_OK);
+    }
+    std::atomic<bool> stop(false);
+    std::atomic<int32_t> failed(0);
+    std::atomic<int32_t> missed(0);
+    std::atomic<int32_t> reopened(0);
+
+    std::thread teardown([&]() {
+        int32_t round = 0;
+        while (!stop) {
+            int32_t channelId = TEST_CHANNEL_ID + (round++ % RACE_CHANNEL_NUM);
+            TransCipherTableRemove(&table_, channelId);
+            TransCipherHandle *handle = CreateHandle(channelId);
+            if (handle == nullptr || TransCipherTableAdd(&table_, channelId, handle) != SOFTBUS_OK) {
+                failed++;
+                TransCipherHandleUnref(handle);
+                continue;
+            }
+            reopened++;
+        }
+    });
+    std::vector<std::thread> workers;
+    for (int32_t worker = 0; worker < RACE_WORKER_NUM; worker++) {
+        workers.emplace_back([&, worker]() {
+            for (int32_t seq = 0; seq < RACE_ROUNDS; seq++) {
+                if (!RoundTrip(&table_, TEST_CHANNEL_ID + ((seq + worker) % RACE_CHANNEL_NUM), seq, missed)) {
+                    failed++;
+                }
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    stop = true;
+    teardown.join();
+
+    EXPECT_EQ(failed.load(), 0);
+    EXPECT_GT(reopened.load(), 0);
+    EXPECT_LT(missed.load(), RACE_WORKER_NUM * RACE_ROUNDS);
+}
+} // namespace OHOS
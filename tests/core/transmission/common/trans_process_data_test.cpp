@@ -14,7 +14,12 @@
  */
 
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
 #include <securec.h>
+#include <thread>
+#include <vector>
 
 #include "trans_proxy_process_data.h"
 #include "trans_proxy_process_data.c"
@@ -25,6 +30,77 @@ using namespace testing::ext;
 
 namespace OHOS {
 #define TEST_CHANNEL_ID 1124
+#define TEST_MSG_LEN (1024 * 1024 + 123)
+#define TEST_PERF_ROUNDS 64
+#define TEST_BYTES_PER_MB (1024 * 1024)
+#define TEST_SLICE_TIMEOUT_MS 10000
+
+// stands in for the peer: unpacks every slice head and reassembles the message like the receive path does
+static int32_t LoopbackSlice(SliceProcessor *processor, const uint8_t *slice, uint32_t sliceLen)
+{
+    SliceHead head = *(const SliceHead *)slice;
+    TransUnPackSliceHead(&head);
+    const char *data = (const char *)slice + sizeof(SliceHead);
+    uint32_t len = sliceLen - sizeof(SliceHead);
+    if (head.sliceSeq == 0) {
+        return TransProxyFirstSliceProcess(processor, &head, data, len, false);
+    }
+    return TransProxyNormalSliceProcess(processor, &head, data, len);
+}
+
+static void FillMessage(ProxyDataInfo *dataInfo, uint32_t len)
+{
+    dataInfo->outLen = len;
+    dataInfo->outData = (uint8_t *)SoftBusCalloc(len);
+    ASSERT_TRUE(dataInfo->outData != nullptr);
+    for (uint32_t i = 0; i < len; i++) {
+        dataInfo->outData[i] = (uint8_t)(i * 7 + i / SLICE_LEN);
+    }
+}
+
+// message of sliceNum slices whose bytes tell the message and offset apart
+static std::vector<char> BuildSlicedMessage(int32_t sliceNum, int32_t tag)
+{
+    std::vector<char> msg((sliceNum - 1) * SLICE_LEN + SLICE_LEN / 2);
+    for (size_t i = 0; i < msg.size(); i++) {
+        msg[i] = (char)(i * 13 + tag);
+    }
+    return msg;
+}
+
+// feeds one slice the way the client receive path does, a failed slice drops the message
+static int32_t FeedSlice(TransSliceTable *table, int32_t channelId, int32_t priority,
+    const std::vector<char> &msg, int32_t sliceSeq, TransSliceEntry **done)
+{
+    int32_t sliceNum = (int32_t)((msg.size() + SLICE_LEN - 1) / SLICE_LEN);
+    SliceHead head = { priority, sliceNum, sliceSeq, 0 };
+    const char *data = msg.data() + sliceSeq * SLICE_LEN;
+    uint32_t len = (uint32_t)std::min<size_t>(SLICE_LEN, msg.size() - sliceSeq * SLICE_LEN);
+    TransSliceEntry *entry = TransSliceTableGetEntry(table, channelId, priority);
+    if (entry == nullptr) {
+        return SOFTBUS_TRANS_GET_CLIENT_PROXY_NULL;
+    }
+    int32_t ret;
+    if (sliceSeq == 0) {
+        ret = TransSliceTableFirstSlice(table, entry, &head, data, len);
+    } else if (sliceSeq + 1 == sliceNum) {
+        ret = TransSliceTableLastSlice(table, entry, &head, data, len);
+    } else {
+        ret = TransSliceTableNormalSlice(table, entry, &head, data, len);
+    }
+    if (ret != SOFTBUS_OK) {
+        TransSliceTableClearEntry(table, entry);
+    } else if (sliceSeq + 1 == sliceNum && done != nullptr) {
+        *done = entry;
+    }
+    return ret;
+}
+
+static bool IsReassembled(const TransSliceEntry *entry, const std::vector<char> &msg)
+{
+    return entry->processor.dataLen == (int32_t)msg.size() &&
+        memcmp(entry->processor.data, msg.data(), msg.size()) == 0;
+}
 
 class TransProcessDataTest : public testing::Test {
 public:
@@ -35,9 +111,19 @@ public:
     static void SetUpTestCase(void);
     static void TearDownTestCase(void);
     void SetUp() override
-    {}
+    {
+        maxByteBufSize_ = g_proxyMaxByteBufSize;
+        maxMessageBufSize_ = g_proxyMaxMessageBufSize;
+    }
     void TearDown() override
-    {}
+    {
+        g_proxyMaxByteBufSize = maxByteBufSize_;
+        g_proxyMaxMessageBufSize = maxMessageBufSize_;
+    }
+
+private:
+    uint32_t maxByteBufSize_ = 0;
+    uint32_t maxMessageBufSize_ = 0;
 };
 
 void TransProcessDataTest::SetUpTestCase(void) {}
@@ -479,4 +565,240 @@ HWTEST_F(TransProcessDataTest, TransProcessDataTest015, TestSize.Level1)
     ret = TransTdcUnPackData(channelId, nullptr, nullptr, nullptr, nullptr);
     EXPECT_EQ(SOFTBUS_INVALID_PARAM, ret);
 }
+
+/**
+ * @tc.name: TransProxySliceIterTest001
+ * @tc.desc: slices framed in place by the iterator reassemble to the original message on the peer side
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(TransProcessDataTest, TransProxySliceIterTest001, TestSize.Level1)
+{
+    ProxySliceIterator iter;
+    uint32_t sliceLen = 0;
+    EXPECT_EQ(SOFTBUS_INVALID_PARAM, TransProxySliceIterInit(nullptr, nullptr, TRANS_SESSION_BYTES));
+    EXPECT_EQ(nullptr, TransProxySliceIterNext(nullptr, &sliceLen));
+
+    g_proxyMaxByteBufSize = TEST_MSG_LEN;
+    ProxyDataInfo dataInfo = { 0 };
+    FillMessage(&dataInfo, TEST_MSG_LEN);
+    std::vector<uint8_t> expected(dataInfo.outData, dataInfo.outData + TEST_MSG_LEN);
+
+    ASSERT_EQ(SOFTBUS_OK, TransProxySliceIterInit(&iter, &dataInfo, TRANS_SESSION_BYTES));
+    EXPECT_EQ(iter.sliceNum, (uint32_t)((TEST_MSG_LEN + SLICE_LEN - 1) / SLICE_LEN));
+    SliceProcessor processor = { 0 };
+    uint32_t sliceCnt = 0;
+    uint8_t *slice = nullptr;
+    while ((slice = TransProxySliceIterNext(&iter, &sliceLen)) != nullptr) {
+        EXPECT_LE(sliceLen, (uint32_t)(SLICE_LEN + sizeof(SliceHead)));
+        ASSERT_EQ(SOFTBUS_OK, LoopbackSlice(&processor, slice, sliceLen));
+        sliceCnt++;
+    }
+    EXPECT_EQ(sliceCnt, iter.sliceNum);
+    ASSERT_EQ(processor.dataLen, TEST_MSG_LEN);
+    EXPECT_EQ(0, memcmp(processor.data, expected.data(), TEST_MSG_LEN));
+
+    TransProxySliceIterDeinit(&iter);
+    TransProxyClearProcessor(&processor);
+    SoftBusFree(dataInfo.outData);
+}
+
+/**
+ * @tc.name: TransProxySliceIterTest002
+ * @tc.desc: slicing in place allocates one buffer per message, only the first slice, the cpu time
+ *           per MB against a copy per slice is logged
+ * @tc.type: PERF
+ * @tc.require:
+ */
+HWTEST_F(TransProcessDataTest, TransProxySliceIterTest002, TestSize.Level1)
+{
+    ProxyDataInfo dataInfo = { 0 };
+    FillMessage(&dataInfo, TEST_MSG_LEN);
+    uint32_t sliceNum = (TEST_MSG_LEN + SLICE_LEN - 1) / SLICE_LEN;
+    uint64_t checksum = 0;
+
+    std::clock_t begin = std::clock();
+    for (int32_t round = 0; round < TEST_PERF_ROUNDS; round++) {
+        for (uint32_t cnt = 0; cnt < sliceNum; cnt++) {
+            uint32_t dataLen = 0;
+            uint8_t *slice = TransProxyPackData(&dataInfo, sliceNum, TRANS_SESSION_BYTES, cnt, &dataLen);
+            ASSERT_TRUE(slice != nullptr);
+            checksum += slice[sizeof(SliceHead)];
+            SoftBusFree(slice);
+        }
+    }
+    std::clock_t copyCost = std::clock() - begin;
+
+    const uint8_t *msgBegin = dataInfo.outData;
+    const uint8_t *msgEnd = dataInfo.outData + dataInfo.outLen;
+    begin = std::clock();
+    for (int32_t round = 0; round < TEST_PERF_ROUNDS; round++) {
+        ProxySliceIterator iter;
+        ASSERT_EQ(SOFTBUS_OK, TransProxySliceIterInit(&iter, &dataInfo, TRANS_SESSION_BYTES));
+        uint32_t sliceLen = 0;
+        uint32_t ownBufferNum = 0;
+        uint8_t *slice = nullptr;
+        while ((slice = TransProxySliceIterNext(&iter, &sliceLen)) != nullptr) {
+            checksum += slice[sizeof(SliceHead)];
+            // a slice outside the message buffer is one the iterator had to allocate
+            if (slice < msgBegin || slice + sliceLen > msgEnd) {
+                EXPECT_EQ(slice, iter.firstSlice);
+                ownBufferNum++;
+            }
+        }
+        EXPECT_EQ(ownBufferNum, 1U);
+        TransProxySliceIterDeinit(&iter);
+    }
+    std::clock_t inPlaceCost = std::clock() - begin;
+
+    double megaBytes = (double)TEST_MSG_LEN * TEST_PERF_ROUNDS / TEST_BYTES_PER_MB;
+    double usPerSec = 1000000.0;
+    double copyUs = copyCost * usPerSec / CLOCKS_PER_SEC / megaBytes;
+    double inPlaceUs = inPlaceCost * usPerSec / CLOCKS_PER_SEC / megaBytes;
+    TRANS_LOGI(TRANS_TEST, "slicing cpu per MB: copyUs=%{public}.1f, inPlaceUs=%{public}.1f, checksum=%{public}llu",
+        copyUs, inPlaceUs, (unsigned long long)checksum);
+    SoftBusFree(dataInfo.outData);
+}
+
+/**
+ * @tc.name: TransSliceTableTest001
+ * @tc.desc: interleaved slices of several channels and priorities reassemble independently, and
+ *           buffers of finished messages are reused by the next message of the same size class
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(TransProcessDataTest, TransSliceTableTest001, TestSize.Level1)
+{
+    g_proxyMaxByteBufSize = TEST_MSG_LEN * 2;
+    g_proxyMaxMessageBufSize = TEST_MSG_LEN * 2;
+    TransSliceTable table = { 0 };
+    ASSERT_EQ(SOFTBUS_OK, TransSliceTableInit(&table, TEST_SLICE_TIMEOUT_MS));
+    // the last one is larger than the largest pooled class
+    const int32_t sliceNums[] = { 2, 5, 17, 300 };
+    const int32_t msgNum = sizeof(sliceNums) / sizeof(sliceNums[0]);
+    std::vector<std::vector<char>> msgs;
+    for (int32_t i = 0; i < msgNum; i++) {
+        msgs.push_back(BuildSlicedMessage(sliceNums[i], i));
+    }
+    for (int32_t round = 0; round < 2; round++) {
+        int32_t finished = 0;
+        std::vector<const char *> bufs(msgNum, nullptr);
+        for (int32_t seq = 0; finished < msgNum; seq++) {
+            for (int32_t i = 0; i < msgNum; i++) {
+                if (seq >= sliceNums[i]) {
+                    continue;
+                }
+                int32_t channelId = TEST_CHANNEL_ID + i / PROXY_CHANNEL_PRORITY_BUTT;
+                int32_t priority = i % PROXY_CHANNEL_PRORITY_BUTT;
+                TransSliceEntry *done = nullptr;
+                ASSERT_EQ(SOFTBUS_OK, FeedSlice(&table, channelId, priority, msgs[i], seq, &done));
+                if (done == nullptr) {
+                    continue;
+                }
+                EXPECT_TRUE(IsReassembled(done, msgs[i]));
+                bufs[i] = done->processor.data;
+                TransSliceTableClearEntry(&table, done);
+                finished++;
+            }
+        }
+        EXPECT_TRUE(IsListEmpty(&table.expiryList));
+        EXPECT_GT(table.pool.cachedBytes, 0U);
+        if (round == 0) {
+            continue;
+        }
+        // the pooled classes hand the same buffers out again
+        int32_t bufLen = 0;
+        char *buf = TransSliceBufPoolAlloc(&table.pool, sliceNums[0], &bufLen);
+        EXPECT_EQ(buf, bufs[0]);
+        TransSliceBufPoolFree(&table.pool, buf, bufLen);
+    }
+    EXPECT_EQ(table.cnt, (uint32_t)((msgNum + PROXY_CHANNEL_PRORITY_BUTT - 1) / PROXY_CHANNEL_PRORITY_BUTT));
+    TransSliceTableDeinit(&table);
+}
+
+/**
+ * @tc.name: TransSliceTableTest002
+ * @tc.desc: an out of order slice drops the message and returns its buffer, a new first slice
+ *           restarts the reassembly
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(TransProcessDataTest, TransSliceTableTest002, TestSize.Level1)
+{
+    g_proxyMaxByteBufSize = TEST_MSG_LEN;
+    TransSliceTable table = { 0 };
+    ASSERT_EQ(SOFTBUS_OK, TransSliceTableInit(&table, TEST_SLICE_TIMEOUT_MS));
+    EXPECT_EQ(nullptr, TransSliceTableGetEntry(&table, TEST_CHANNEL_ID, PROXY_CHANNEL_PRORITY_BUTT));
+    std::vector<char> msg = BuildSlicedMessage(4, 1);
+
+    ASSERT_EQ(SOFTBUS_OK, FeedSlice(&table, TEST_CHANNEL_ID, PROXY_CHANNEL_PRORITY_BYTES, msg, 0, nullptr));
+    EXPECT_EQ(SOFTBUS_TRANS_PROXY_ASSEMBLE_PACK_NO_INVALID,
+        FeedSlice(&table, TEST_CHANNEL_ID, PROXY_CHANNEL_PRORITY_BYTES, msg, 2, nullptr));
+    EXPECT_TRUE(IsListEmpty(&table.expiryList));
+    uint32_t cachedBytes = table.pool.cachedBytes;
+    EXPECT_GT(cachedBytes, 0U);
+    // the rest of the dropped message is refused slice by slice
+    EXPECT_EQ(SOFTBUS_TRANS_PROXY_ASSEMBLE_PACK_NO_INVALID,
+        FeedSlice(&table, TEST_CHANNEL_ID, PROXY_CHANNEL_PRORITY_BYTES, msg, 3, nullptr));
+
+    // a first slice in the middle of a message starts over
+    TransSliceEntry *done = nullptr;
+    ASSERT_EQ(SOFTBUS_OK, FeedSlice(&table, TEST_CHANNEL_ID, PROXY_CHANNEL_PRORITY_BYTES, msg, 0, nullptr));
+    EXPECT_EQ(table.pool.cachedBytes, 0U);
+    ASSERT_EQ(SOFTBUS_OK, FeedSlice(&table, TEST_CHANNEL_ID, PROXY_CHANNEL_PRORITY_BYTES, msg, 1, nullptr));
+    ASSERT_EQ(SOFTBUS_OK, FeedSlice(&table, TEST_CHANNEL_ID, PROXY_CHANNEL_PRORITY_BYTES, msg, 0, nullptr));
+    for (int32_t seq = 1; seq < 4; seq++) {
+        ASSERT_EQ(SOFTBUS_OK, FeedSlice(&table, TEST_CHANNEL_ID, PROXY_CHANNEL_PRORITY_BYTES, msg, seq, &done));
+    }
+    ASSERT_NE(nullptr, done);
+    EXPECT_TRUE(IsReassembled(done, msg));
+    TransSliceTableClearEntry(&table, done);
+    EXPECT_EQ(table.pool.cachedBytes, cachedBytes);
+
+    TransSliceTableDelChannel(&table, TEST_CHANNEL_ID);
+    EXPECT_FALSE(TransSliceTableHasChannel(&table, TEST_CHANNEL_ID));
+    EXPECT_EQ(table.cnt, 0U);
+    TransSliceTableDeinit(&table);
+}
+
+/**
+ * @tc.name: TransSliceTableTest003
+ * @tc.desc: each reassembly expires on its own deadline, a slice pushes the deadline back and a
+ *           closed channel leaves nothing behind to expire
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(TransProcessDataTest, TransSliceTableTest003, TestSize.Level1)
+{
+    g_proxyMaxByteBufSize = TEST_MSG_LEN;
+    g_proxyMaxMessageBufSize = TEST_MSG_LEN;
+    TransSliceTable table = { 0 };
+    ASSERT_EQ(SOFTBUS_OK, TransSliceTableInit(&table, TEST_SLICE_TIMEOUT_MS));
+    std::vector<char> msg = BuildSlicedMessage(8, 2);
+
+    ASSERT_EQ(SOFTBUS_OK, FeedSlice(&table, TEST_CHANNEL_ID, PROXY_CHANNEL_PRORITY_BYTES, msg, 0, nullptr));
+    ASSERT_EQ(SOFTBUS_OK, FeedSlice(&table, TEST_CHANNEL_ID + 1, PROXY_CHANNEL_PRORITY_MESSAGE, msg, 0, nullptr));
+    ASSERT_EQ(SOFTBUS_OK, FeedSlice(&table, TEST_CHANNEL_ID + 2, PROXY_CHANNEL_PRORITY_BYTES, msg, 0, nullptr));
+    TransSliceEntry *first = TransSliceTableGetEntry(&table, TEST_CHANNEL_ID, PROXY_CHANNEL_PRORITY_BYTES);
+    TransSliceEntry *second = TransSliceTableGetEntry(&table, TEST_CHANNEL_ID + 1, PROXY_CHANNEL_PRORITY_MESSAGE);
+    ASSERT_TRUE(first != nullptr && second != nullptr);
+    uint64_t firstDeadline = first->deadline;
+    EXPECT_EQ(0U, TransSliceTableExpire(&table, firstDeadline - 1));
+
+    // the second channel keeps receiving, only the first one runs out of time
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    ASSERT_EQ(SOFTBUS_OK, FeedSlice(&table, TEST_CHANNEL_ID + 1, PROXY_CHANNEL_PRORITY_MESSAGE, msg, 1, nullptr));
+    EXPECT_GT(second->deadline, firstDeadline);
+    TransSliceTableDelChannel(&table, TEST_CHANNEL_ID + 2);
+    EXPECT_EQ(1U, TransSliceTableExpire(&table, firstDeadline));
+    EXPECT_FALSE(first->processor.active);
+    EXPECT_TRUE(second->processor.active);
+    EXPECT_EQ(SOFTBUS_TRANS_PROXY_ASSEMBLE_PACK_NO_INVALID,
+        FeedSlice(&table, TEST_CHANNEL_ID, PROXY_CHANNEL_PRORITY_BYTES, msg, 1, nullptr));
+
+    EXPECT_EQ(1U, TransSliceTableExpire(&table, second->deadline + TEST_SLICE_TIMEOUT_MS));
+    EXPECT_TRUE(IsListEmpty(&table.expiryList));
+    EXPECT_EQ(0U, TransSliceTableExpire(&table, UINT64_MAX));
+    TransSliceTableDeinit(&table);
+}
 }
@@ -679,12 +679,12 @@ HWTEST_F(TransInnerTest, ClientTransProxyGetChannelSliceTest001, TestSize.Level1
     ASSERT_TRUE(node);
     node = ClientTransProxyGetChannelSlice(TRANS_TEST_CHANNEL_ID);
     ASSERT_TRUE(node);
-    int32_t ret = TransProxyDelSliceProcessorByChannelId(TRANS_TEST_CHANNEL_ID);
+    int32_t ret = TransInnerDelSliceProcessorByChannelId(TRANS_TEST_CHANNEL_ID);
     EXPECT_EQ(SOFTBUS_OK, ret);
-    ret = TransProxyDelSliceProcessorByChannelId(TRANS_TEST_CHANNEL_ID + 1);
+    ret = TransInnerDelSliceProcessorByChannelId(TRANS_TEST_CHANNEL_ID + 1);
     EXPECT_EQ(SOFTBUS_OK, ret);
     InnerListDeinit();
-    ret = TransProxyDelSliceProcessorByChannelId(TRANS_TEST_CHANNEL_ID);
+    ret = TransInnerDelSliceProcessorByChannelId(TRANS_TEST_CHANNEL_ID);
     EXPECT_EQ(SOFTBUS_NO_INIT, ret);
 }
 
@@ -703,7 +703,7 @@ HWTEST_F(TransInnerTest, IsValidCheckoutSliceProcessTest001, TestSize.Level1)
     EXPECT_TRUE(res);
     res = IsValidCheckoutSliceProcess(TRANS_TEST_CHANNEL_ID + 1);
     EXPECT_FALSE(res);
-    int32_t ret = TransProxyDelSliceProcessorByChannelId(TRANS_TEST_CHANNEL_ID);
+    int32_t ret = TransInnerDelSliceProcessorByChannelId(TRANS_TEST_CHANNEL_ID);
     EXPECT_EQ(SOFTBUS_OK, ret);
     InnerListDeinit();
 }
@@ -753,7 +753,7 @@ HWTEST_F(TransInnerTest, ClientTransProxySubPacketProcTest001, TestSize.Level1)
     EXPECT_CALL(TransInnerMock, TransProxyNormalSliceProcess).WillOnce(Return(SOFTBUS_OK));
     ret = ClientTransProxySubPacketProc(TRANS_TEST_CHANNEL_ID, &head, data, TEST_SEND_DATA_LEN);
     EXPECT_EQ(SOFTBUS_OK, ret);
-    ret = TransProxyDelSliceProcessorByChannelId(TRANS_TEST_CHANNEL_ID);
+    ret = TransInnerDelSliceProcessorByChannelId(TRANS_TEST_CHANNEL_ID);
     EXPECT_EQ(SOFTBUS_OK, ret);
     InnerListDeinit();
 }
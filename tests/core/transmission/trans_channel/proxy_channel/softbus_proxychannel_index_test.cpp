@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "softbus_proxychannel_index.h"
+#include "trans_log.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+constexpr int32_t CHANNEL_NUM = 4096;
+constexpr int32_t CHANNEL_PER_CONN = 8;
+constexpr uint32_t TEST_CONN_ID_BASE = 0x10000;
+constexpr int32_t LOOKUP_ROUNDS = 20;
+// a bucket holds CHANNEL_NUM / PROXY_CHANNEL_INDEX_BUCKET_NUM channels, a list scan half of all of them
+constexpr int32_t MIN_SPEEDUP = 4;
+
+void BuildChannel(ProxyChannelInfo &chan, int32_t channelId)
+{
+    chan.channelId = channelId;
+    chan.myId = static_cast<int16_t>(channelId);
+    chan.peerId = static_cast<int16_t>(CHANNEL_NUM - channelId);
+    chan.connId = TEST_CONN_ID_BASE + static_cast<uint32_t>(channelId / CHANNEL_PER_CONN);
+}
+
+ProxyChannelInfo *FindInIndexByMyId(ProxyChannelIndex *index, int16_t myId, int16_t peerId)
+{
+    ProxyChannelInfo *item = nullptr;
+    LIST_FOR_EACH_ENTRY(item, TransProxyChanIndexGetMyIdBucket(index, myId), ProxyChannelInfo, myIdNode) {
+        if (item->myId == myId && item->peerId == peerId) {
+            return item;
+        }
+    }
+    return nullptr;
+}
+
+uint32_t CountInIndexByConnId(ProxyChannelIndex *index, uint32_t connId)
+{
+    uint32_t num = 0;
+    ProxyChannelInfo *item = nullptr;
+    LIST_FOR_EACH_ENTRY(item, TransProxyChanIndexGetConnIdBucket(index, connId), ProxyChannelInfo, connIdNode) {
+        if (item->connId == connId) {
+            num++;
+        }
+    }
+    return num;
+}
+
+ProxyChannelInfo *FindInListByChanId(ListNode *list, int32_t channelId)
+{
+    ProxyChannelInfo *item = nullptr;
+    LIST_FOR_EACH_ENTRY(item, list, ProxyChannelInfo, node) {
+        if (item->channelId == channelId) {
+            return item;
+        }
+    }
+    return nullptr;
+}
+} // namespace
+
+class SoftbusProxyChannelIndexTest : public testing::Test {
+public:
+    SoftbusProxyChannelIndexTest() { }
+    ~SoftbusProxyChannelIndexTest() { }
+    static void SetUpTestCase(void) { }
+    static void TearDownTestCase(void) { }
+    void SetUp() override
+    {
+        TransProxyChanIndexInit(&index_);
+        ListInit(&list_);
+    }
+    void TearDown() override { }
+
+    void AddChannel(ProxyChannelInfo &chan)
+    {
+        ListAdd(&list_, &chan.node);
+        TransProxyChanIndexAdd(&index_, &chan);
+    }
+
+    ProxyChannelIndex index_;
+    ListNode list_;
+};
+
+/*
+ * @tc.name: ChanIndexAddRemove001
+ * @tc.desc: a channel is found by every key while it is indexed and by none after removal
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SoftbusProxyChannelIndexTest, ChanIndexAddRemove001, TestSize.Level1)
+{
+    ProxyChannelInfo chans[2] = {};
+    BuildChannel(chans[0], 1);
+    BuildChannel(chans[1], 1 + PROXY_CHANNEL_INDEX_BUCKET_NUM);
+    AddChannel(chans[0]);
+    AddChannel(chans[1]);
+
+    EXPECT_EQ(TransProxyChanIndexFindByChanId(&index_, chans[0].channelId), &chans[0]);
+    EXPECT_EQ(TransProxyChanIndexFindByChanId(&index_, chans[1].channelId), &chans[1]);
+    EXPECT_EQ(FindInIndexByMyId(&index_, chans[1].myId, chans[1].peerId), &chans[1]);
+    EXPECT_EQ(CountInIndexByConnId(&index_, chans[0].connId), 1U);
+
+    TransProxyChanIndexRemove(&chans[0]);
+    EXPECT_EQ(TransProxyChanIndexFindByChanId(&index_, chans[0].channelId), nullptr);
+    EXPECT_EQ(FindInIndexByMyId(&index_, chans[0].myId, chans[0].peerId), nullptr);
+    EXPECT_EQ(CountInIndexByConnId(&index_, chans[0].connId), 0U);
+    EXPECT_EQ(TransProxyChanIndexFindByChanId(&index_, chans[1].channelId), &chans[1]);
+    EXPECT_EQ(TransProxyChanIndexFindByChanId(nullptr, chans[1].channelId), nullptr);
+    TransProxyChanIndexRemove(&chans[1]);
+}
+
+/*
+ * @tc.name: ChanIndexSetConnId001
+ * @tc.desc: a channel handed over to another connection moves to the bucket of its new connId
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SoftbusProxyChannelIndexTest, ChanIndexSetConnId001, TestSize.Level1)
+{
+    ProxyChannelInfo chan = {};
+    BuildChannel(chan, 1);
+    AddChannel(chan);
+    uint32_t oldConnId = chan.connId;
+    uint32_t newConnId = oldConnId + 1;
+
+    TransProxyChanIndexSetConnId(&index_, &chan, newConnId);
+    EXPECT_EQ(chan.connId, newConnId);
+    EXPECT_EQ(CountInIndexByConnId(&index_, oldConnId), 0U);
+    EXPECT_EQ(CountInIndexByConnId(&index_, newConnId), 1U);
+    EXPECT_EQ(TransProxyChanIndexFindByChanId(&index_, chan.channelId), &chan);
+    TransProxyChanIndexRemove(&chan);
+}
+
+/*
+ * @tc.name: ChanIndexScale001
+ * @tc.desc: with thousands of channels every key still resolves to the right channel, removing a
+ *           connection removes exactly its channels, and a lookup costs a fraction of a list scan
+ * @tc.type: PERF
+ * @tc.require:
+ */
+HWTEST_F(SoftbusProxyChannelIndexTest, ChanIndexScale001, TestSize.Level1)
+{
+    std::vector<ProxyChannelInfo> chans(CHANNEL_NUM);
+    for (int32_t i = 0; i < CHANNEL_NUM; i++) {
+        BuildChannel(chans[i], i);
+        AddChannel(chans[i]);
+    }
+    for (int32_t i = 0; i < CHANNEL_NUM; i++) {
+        ASSERT_EQ(TransProxyChanIndexFindByChanId(&index_, i), &chans[i]);
+        ASSERT_EQ(FindInIndexByMyId(&index_, chans[i].myId, chans[i].peerId), &chans[i]);
+    }
+    EXPECT_EQ(CountInIndexByConnId(&index_, TEST_CONN_ID_BASE), static_cast<uint32_t>(CHANNEL_PER_CONN));
+
+    uint32_t found = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (int32_t round = 0; round < LOOKUP_ROUNDS; round++) {
+        for (int32_t i = 0; i < CHANNEL_NUM; i++) {
+            found += (TransProxyChanIndexFindByChanId(&index_, i) != nullptr) ? 1 : 0;
+        }
+    }
+    auto indexCost = std::chrono::steady_clock::now() - begin;
+    begin = std::chrono::steady_clock::now();
+    for (int32_t round = 0; round < LOOKUP_ROUNDS; round++) {
+        for (int32_t i = 0; i < CHANNEL_NUM; i++) {
+            found += (FindInListByChanId(&list_, i) != nullptr) ? 1 : 0;
+        }
+    }
+    auto listCost = std::chrono::steady_clock::now() - begin;
+    EXPECT_EQ(found, static_cast<uint32_t>(2 * LOOKUP_ROUNDS * CHANNEL_NUM));
+    TRANS_LOGI(TRANS_TEST, "lookups=%{public}d, channels=%{public}d, indexUs=%{public}lld, listUs=%{public}lld",
+        LOOKUP_ROUNDS * CHANNEL_NUM, CHANNEL_NUM,
+        static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(indexCost).count()),
+        static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(listCost).count()));
+    EXPECT_LT(indexCost * MIN_SPEEDUP, listCost);
+
+    uint32_t connId = TEST_CONN_ID_BASE + 1;
+    ProxyChannelInfo *item = nullptr;
+    ProxyChannelInfo *next = nullptr;
+    LIST_FOR_EACH_ENTRY_SAFE(item, next, TransProxyChanIndexGetConnIdBucket(&index_, connId), ProxyChannelInfo,
+        connIdNode) {
+        if (item->connId == connId) {
+            ListDelete(&item->node);
+            TransProxyChanIndexRemove(item);
+        }
+    }
+    EXPECT_EQ(CountInIndexByConnId(&index_, connId), 0U);
+    for (int32_t i = 0; i < CHANNEL_NUM; i++) {
+        bool isRemoved = chans[i].connId == connId;
+        EXPECT_EQ(TransProxyChanIndexFindByChanId(&index_, i), isRemoved ? nullptr : &chans[i]);
+        EXPECT_EQ(FindInListByChanId(&list_, i), isRemoved ? nullptr : &chans[i]);
+    }
+}
+} // namespace OHOS
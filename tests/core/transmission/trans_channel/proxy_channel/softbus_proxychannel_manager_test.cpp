@@ -234,6 +234,7 @@ HWTEST_F(SoftbusProxyChannelManagerTest, TransProxyOpenProxyChannelTest001, Test
 
     g_proxyChannelList = CreateSoftBusList();
     ASSERT_TRUE(nullptr != g_proxyChannelList);
+    TransProxyChanIndexInit(&g_proxyChannelIndex);
     ret = GetProxyChannelLock();
     EXPECT_EQ(SOFTBUS_OK, ret);
     ReleaseProxyChannelLock();
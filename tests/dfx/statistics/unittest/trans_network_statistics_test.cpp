@@ -273,4 +273,40 @@ HWTEST_F(TransNetworkStatisticsTest, UpdateNetworkResourceByLaneId001, TestSize.
     UpdateNetworkResourceByLaneId(channelId, channelType, laneId, dataInfo, len);
     EXPECT_NO_FATAL_FAILURE(UpdateNetworkResourceByLaneId(channelId, channelType, laneId, dataInfo, len));
 }
+
+static void TestStatisticsListener(uint64_t laneId, int32_t laneLinkType, int64_t traffic, int64_t duration)
+{
+    (void)laneId;
+    (void)laneLinkType;
+    (void)traffic;
+    (void)duration;
+}
+
+static void TestStatisticsListenerOther(uint64_t laneId, int32_t laneLinkType, int64_t traffic, int64_t duration)
+{
+    (void)laneId;
+    (void)laneLinkType;
+    (void)traffic;
+    (void)duration;
+}
+
+/* *
+ * @tc.name: RegisterNetworkStatisticsListener001
+ * @tc.desc: Test RegisterNetworkStatisticsListener with null, duplicate and distinct listeners.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(TransNetworkStatisticsTest, RegisterNetworkStatisticsListener001, TestSize.Level1)
+{
+    EXPECT_EQ(SOFTBUS_INVALID_PARAM, RegisterNetworkStatisticsListener(nullptr));
+    EXPECT_EQ(SOFTBUS_OK, RegisterNetworkStatisticsListener(TestStatisticsListener));
+    EXPECT_EQ(SOFTBUS_OK, RegisterNetworkStatisticsListener(TestStatisticsListener));
+    EXPECT_EQ(SOFTBUS_OK, RegisterNetworkStatisticsListener(TestStatisticsListenerOther));
+    EXPECT_EQ(g_networkStatisticsListener[0], TestStatisticsListener);
+    EXPECT_EQ(g_networkStatisticsListener[1], TestStatisticsListenerOther);
+    UnregisterNetworkStatisticsListener(TestStatisticsListener);
+    UnregisterNetworkStatisticsListener(TestStatisticsListenerOther);
+    EXPECT_EQ(g_networkStatisticsListener[0], nullptr);
+    EXPECT_EQ(g_networkStatisticsListener[1], nullptr);
+}
 } // namespace OHOS
\ No newline at end of file
@@ -17,6 +17,7 @@
 #include <securec.h>
 
 #include "accesstoken_kit.h"
+#include "client_bus_center_node_cache.h"
 #include "nativetoken_kit.h"
 #include "softbus_bus_center.h"
 #include "softbus_common.h"
@@ -190,6 +191,29 @@ BENCHMARK_F(BusCenterTest, GetAllNodeDeviceInfoTestCase)(benchmark::State &state
 }
 BENCHMARK_REGISTER_F(BusCenterTest, GetAllNodeDeviceInfoTestCase);
 
+/**
+ * @tc.name: GetAllNodeDeviceInfoNoCacheTestCase
+ * @tc.desc: GetAllNodeDeviceInfo Performance Testing with the sdk node info cache bypassed
+ * @tc.type: FUNC
+ * @tc.require: GetAllNodeDeviceInfo normal operation
+ */
+BENCHMARK_F(BusCenterTest, GetAllNodeDeviceInfoNoCacheTestCase)(benchmark::State &state)
+{
+    SetNodeInfoCacheBypass(true);
+    while (state.KeepRunning()) {
+        NodeBasicInfo *info = nullptr;
+        int32_t infoNum;
+
+        int32_t ret = GetAllNodeDeviceInfo(TEST_PKG_NAME, &info, &infoNum);
+        if (ret != 0) {
+            state.SkipWithError("GetAllNodeDeviceInfoNoCacheTestCase failed.");
+        }
+        FreeNodeInfo(info);
+    }
+    SetNodeInfoCacheBypass(false);
+}
+BENCHMARK_REGISTER_F(BusCenterTest, GetAllNodeDeviceInfoNoCacheTestCase);
+
 /**
  * @tc.name: GetLocalNodeDeviceInfoTestCase
  * @tc.desc: GetLocalNodeDeviceInfo Performance Testing
@@ -234,6 +258,53 @@ BENCHMARK_F(BusCenterTest, GetNodeKeyInfoTestCase)(benchmark::State &state)
 }
 BENCHMARK_REGISTER_F(BusCenterTest, GetNodeKeyInfoTestCase);
 
+static void RunGetRemoteNodeKeyInfo(benchmark::State &state)
+{
+    NodeBasicInfo *info = nullptr;
+    int32_t infoNum = 0;
+    if (GetAllNodeDeviceInfo(TEST_PKG_NAME, &info, &infoNum) != 0 || infoNum == 0) {
+        FreeNodeInfo(info);
+        state.SkipWithError("no online node.");
+        return;
+    }
+    char networkId[NETWORK_ID_BUF_LEN] = { 0 };
+    (void)strcpy_s(networkId, sizeof(networkId), info[0].networkId);
+    FreeNodeInfo(info);
+    while (state.KeepRunning()) {
+        char udid[UDID_BUF_LEN] = { 0 };
+        int32_t ret = GetNodeKeyInfo(TEST_PKG_NAME, networkId, NODE_KEY_UDID, (uint8_t *)udid, UDID_BUF_LEN);
+        if (ret != 0) {
+            state.SkipWithError("GetRemoteNodeKeyInfo failed.");
+        }
+    }
+}
+
+/**
+ * @tc.name: GetRemoteNodeKeyInfoTestCase
+ * @tc.desc: GetNodeKeyInfo of an online node Performance Testing
+ * @tc.type: FUNC
+ * @tc.require: GetNodeKeyInfo normal operation
+ */
+BENCHMARK_F(BusCenterTest, GetRemoteNodeKeyInfoTestCase)(benchmark::State &state)
+{
+    RunGetRemoteNodeKeyInfo(state);
+}
+BENCHMARK_REGISTER_F(BusCenterTest, GetRemoteNodeKeyInfoTestCase);
+
+/**
+ * @tc.name: GetRemoteNodeKeyInfoNoCacheTestCase
+ * @tc.desc: GetNodeKeyInfo of an online node Performance Testing with the sdk node info cache bypassed
+ * @tc.type: FUNC
+ * @tc.require: GetNodeKeyInfo normal operation
+ */
+BENCHMARK_F(BusCenterTest, GetRemoteNodeKeyInfoNoCacheTestCase)(benchmark::State &state)
+{
+    SetNodeInfoCacheBypass(true);
+    RunGetRemoteNodeKeyInfo(state);
+    SetNodeInfoCacheBypass(false);
+}
+BENCHMARK_REGISTER_F(BusCenterTest, GetRemoteNodeKeyInfoNoCacheTestCase);
+
 /**
  * @tc.name: PublishLNNTestCase
  * @tc.desc: PublishLNN Performance Testing
@@ -131,6 +131,11 @@ int32_t ServerIpcSetDataLevel(const DataLevel *dataLevel)
     return GetBusCenterManagerInterface()->ServerIpcSetDataLevel(dataLevel);
 }
 
+int32_t ServerIpcRegNodeStateBatch(const char *pkgName)
+{
+    return GetBusCenterManagerInterface()->ServerIpcRegNodeStateBatch(pkgName);
+}
+
 int32_t ServerIpcRegRangeCbForMsdp(const char *pkgName)
 {
     return GetBusCenterManagerInterface()->ServerIpcRegRangeCbForMsdp(pkgName);
@@ -52,6 +52,7 @@ public:
     virtual int32_t ServerIpcRegDataLevelChangeCb(const char *pkgName);
     virtual int32_t ServerIpcUnregDataLevelChangeCb(const char *pkgName);
     virtual int32_t ServerIpcSetDataLevel(const DataLevel *dataLevel);
+    virtual int32_t ServerIpcRegNodeStateBatch(const char *pkgName);
     virtual int32_t SoftBusMutexLockInner(SoftBusMutex *mutex);
     virtual int32_t SoftBusMutexUnlockInner(SoftBusMutex *mutex);
     virtual int32_t ServerIpcRegRangeCbForMsdp(const char *pkgName);
@@ -81,6 +82,7 @@ public:
     MOCK_METHOD1(ServerIpcRegDataLevelChangeCb, int32_t (const char *));
     MOCK_METHOD1(ServerIpcUnregDataLevelChangeCb, int32_t (const char *));
     MOCK_METHOD1(ServerIpcSetDataLevel, int32_t (const DataLevel *));
+    MOCK_METHOD1(ServerIpcRegNodeStateBatch, int32_t (const char *));
     MOCK_METHOD1(ServerIpcRegRangeCbForMsdp, int32_t (const char *));
     MOCK_METHOD1(ServerIpcUnregRangeCbForMsdp, int32_t (const char *));
     MOCK_METHOD2(ServerIpcTriggerRangeForMsdp, int32_t (const char *, const RangeConfig *));
@@ -50,6 +50,11 @@ constexpr int32_t TYPE = 1;
 constexpr int32_t LNN_REFRESH_ID = 0;
 constexpr int32_t RESULT_REASON = -1;
 constexpr char PKGNAME[] = "softbustest";
+constexpr char CACHE_NODE1_NETWORK_ID[] = "cacheNetworkId1";
+constexpr char CACHE_NODE2_NETWORK_ID[] = "cacheNetworkId2";
+constexpr char CACHE_NODE3_NETWORK_ID[] = "cacheNetworkId3";
+constexpr char CACHE_NODE1_UDID[] = "cacheUdid1";
+constexpr int32_t CACHE_NODE_NUM = 2;
 class ClientBusCentManagerTest : public testing::Test {
 public:
     static void SetUpTestCase();
@@ -1145,4 +1150,162 @@ HWTEST_F(ClientBusCentManagerTest, FREE_DISC_SUBSCRIBE_MSG_Test_001, TestSize.Le
     msg->info->capabilityData = nullptr;
     EXPECT_NO_FATAL_FAILURE(FreeDiscSubscribeMsg(&msg));
 }
-} // namespace OHOS
\ No newline at end of file
+
+static void GenCacheNodeInfo(const char *networkId, NodeBasicInfo *info)
+{
+    (void)memset_s(info, sizeof(NodeBasicInfo), 0, sizeof(NodeBasicInfo));
+    (void)strcpy_s(info->networkId, sizeof(info->networkId), networkId);
+    info->deviceTypeId = TYPE;
+}
+
+static int32_t GetOnlineNodesFromServer(const char *pkgName, void **info, uint32_t infoTypeLen, int32_t *infoNum)
+{
+    (void)pkgName;
+    NodeBasicInfo *nodes = static_cast<NodeBasicInfo *>(SoftBusCalloc(infoTypeLen * CACHE_NODE_NUM));
+    if (nodes == nullptr) {
+        return SOFTBUS_MALLOC_ERR;
+    }
+    GenCacheNodeInfo(CACHE_NODE1_NETWORK_ID, &nodes[0]);
+    GenCacheNodeInfo(CACHE_NODE2_NETWORK_ID, &nodes[1]);
+    *info = nodes;
+    *infoNum = CACHE_NODE_NUM;
+    return SOFTBUS_OK;
+}
+
+static int32_t GetUdidFromServer(const char *pkgName, const char *networkId, int32_t key, unsigned char *buf,
+    uint32_t len)
+{
+    (void)pkgName;
+    (void)networkId;
+    (void)key;
+    return strcpy_s(reinterpret_cast<char *>(buf), len, CACHE_NODE1_UDID) == EOK ? SOFTBUS_OK : SOFTBUS_MEM_ERR;
+}
+
+static void InitClientForNodeInfoCache(ClientBusCenterManagerInterfaceMock &busCentManagerMock)
+{
+    EXPECT_CALL(busCentManagerMock, SoftbusGetConfig(_, _, _)).WillRepeatedly(Return(SOFTBUS_OK));
+    EXPECT_CALL(busCentManagerMock, BusCenterServerProxyInit()).WillRepeatedly(Return(SOFTBUS_OK));
+    EXPECT_CALL(busCentManagerMock, BusCenterServerProxyDeInit()).WillRepeatedly(Return());
+    EXPECT_EQ(BusCenterClientInit(), SOFTBUS_OK);
+}
+
+static int32_t GetOnlineNodeNum(void)
+{
+    NodeBasicInfo *info = nullptr;
+    int32_t infoNum = 0;
+    if (GetAllNodeDeviceInfoInner(PKGNAME, &info, &infoNum) != SOFTBUS_OK) {
+        return -1;
+    }
+    SoftBusFree(info);
+    return infoNum;
+}
+
+/*
+ * @tc.name: NODE_INFO_CACHE_Test_001
+ * @tc.desc: online node list is served from the cache and follows node state changes
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ClientBusCentManagerTest, NODE_INFO_CACHE_Test_001, TestSize.Level1)
+{
+    ClientBusCenterManagerInterfaceMock busCentManagerMock;
+    InitClientForNodeInfoCache(busCentManagerMock);
+    EXPECT_CALL(busCentManagerMock, ServerIpcGetAllOnlineNodeInfo(_, _, _, _))
+        .Times(1)
+        .WillOnce(Invoke(GetOnlineNodesFromServer));
+    EXPECT_EQ(GetOnlineNodeNum(), CACHE_NODE_NUM);
+    EXPECT_EQ(GetOnlineNodeNum(), CACHE_NODE_NUM);
+
+    NodeBasicInfo info;
+    GenCacheNodeInfo(CACHE_NODE1_NETWORK_ID, &info);
+    EXPECT_EQ(LnnOnNodeOnlineStateChanged("", false, reinterpret_cast<void *>(&info)), SOFTBUS_OK);
+    EXPECT_EQ(GetOnlineNodeNum(), CACHE_NODE_NUM - 1);
+    GenCacheNodeInfo(CACHE_NODE3_NETWORK_ID, &info);
+    EXPECT_EQ(LnnOnNodeOnlineStateChanged("", true, reinterpret_cast<void *>(&info)), SOFTBUS_OK);
+    EXPECT_EQ(GetOnlineNodeNum(), CACHE_NODE_NUM);
+    BusCenterClientDeinit();
+}
+
+/*
+ * @tc.name: NODE_INFO_CACHE_Test_002
+ * @tc.desc: node key info is cached until the basic info of the node changes
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ClientBusCentManagerTest, NODE_INFO_CACHE_Test_002, TestSize.Level1)
+{
+    ClientBusCenterManagerInterfaceMock busCentManagerMock;
+    InitClientForNodeInfoCache(busCentManagerMock);
+    EXPECT_CALL(busCentManagerMock, ServerIpcGetAllOnlineNodeInfo(_, _, _, _))
+        .WillOnce(Invoke(GetOnlineNodesFromServer));
+    EXPECT_CALL(busCentManagerMock, ServerIpcGetNodeKeyInfo(_, _, _, _, _))
+        .Times(2)
+        .WillRepeatedly(Invoke(GetUdidFromServer));
+    EXPECT_EQ(GetOnlineNodeNum(), CACHE_NODE_NUM);
+
+    char udid[UDID_BUF_LEN] = {0};
+    EXPECT_EQ(GetNodeKeyInfoInner(PKGNAME, CACHE_NODE1_NETWORK_ID, NODE_KEY_UDID,
+        reinterpret_cast<uint8_t *>(udid), UDID_BUF_LEN), SOFTBUS_OK);
+    (void)memset_s(udid, sizeof(udid), 0, sizeof(udid));
+    EXPECT_EQ(GetNodeKeyInfoInner(PKGNAME, CACHE_NODE1_NETWORK_ID, NODE_KEY_UDID,
+        reinterpret_cast<uint8_t *>(udid), UDID_BUF_LEN), SOFTBUS_OK);
+    EXPECT_STREQ(udid, CACHE_NODE1_UDID);
+
+    NodeBasicInfo info;
+    GenCacheNodeInfo(CACHE_NODE1_NETWORK_ID, &info);
+    EXPECT_EQ(LnnOnNodeBasicInfoChanged("", reinterpret_cast<void *>(&info), TYPE_DEVICE_NAME), SOFTBUS_OK);
+    EXPECT_EQ(GetNodeKeyInfoInner(PKGNAME, CACHE_NODE1_NETWORK_ID, NODE_KEY_UDID,
+        reinterpret_cast<uint8_t *>(udid), UDID_BUF_LEN), SOFTBUS_OK);
+    BusCenterClientDeinit();
+}
+
+/*
+ * @tc.name: NODE_INFO_CACHE_Test_003
+ * @tc.desc: invalidation and bypass send queries to the server again
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ClientBusCentManagerTest, NODE_INFO_CACHE_Test_003, TestSize.Level1)
+{
+    ClientBusCenterManagerInterfaceMock busCentManagerMock;
+    InitClientForNodeInfoCache(busCentManagerMock);
+    EXPECT_CALL(busCentManagerMock, ServerIpcGetAllOnlineNodeInfo(_, _, _, _))
+        .Times(4)
+        .WillRepeatedly(Invoke(GetOnlineNodesFromServer));
+    EXPECT_EQ(GetOnlineNodeNum(), CACHE_NODE_NUM);
+    InvalidateNodeInfoCache();
+    EXPECT_EQ(GetOnlineNodeNum(), CACHE_NODE_NUM);
+    EXPECT_EQ(GetOnlineNodeNum(), CACHE_NODE_NUM);
+
+    SetNodeInfoCacheBypass(true);
+    EXPECT_EQ(GetOnlineNodeNum(), CACHE_NODE_NUM);
+    EXPECT_EQ(GetOnlineNodeNum(), CACHE_NODE_NUM);
+    SetNodeInfoCacheBypass(false);
+    BusCenterClientDeinit();
+}
+
+/*
+ * @tc.name: NODE_INFO_CACHE_Test_004
+ * @tc.desc: a server answer overtaken by a node state change is not cached
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ClientBusCentManagerTest, NODE_INFO_CACHE_Test_004, TestSize.Level1)
+{
+    ClientBusCenterManagerInterfaceMock busCentManagerMock;
+    InitClientForNodeInfoCache(busCentManagerMock);
+    EXPECT_CALL(busCentManagerMock, ServerIpcGetAllOnlineNodeInfo(_, _, _, _))
+        .Times(2)
+        .WillOnce(Invoke([](const char *pkgName, void **info, uint32_t infoTypeLen, int32_t *infoNum) {
+            NodeBasicInfo node;
+            GenCacheNodeInfo(CACHE_NODE3_NETWORK_ID, &node);
+            (void)LnnOnNodeOnlineStateChanged("", true, reinterpret_cast<void *>(&node));
+            return GetOnlineNodesFromServer(pkgName, info, infoTypeLen, infoNum);
+        }))
+        .WillRepeatedly(Invoke(GetOnlineNodesFromServer));
+    EXPECT_EQ(GetOnlineNodeNum(), CACHE_NODE_NUM);
+    EXPECT_EQ(GetOnlineNodeNum(), CACHE_NODE_NUM);
+    EXPECT_EQ(GetOnlineNodeNum(), CACHE_NODE_NUM);
+    BusCenterClientDeinit();
+}
+} // namespace OHOS
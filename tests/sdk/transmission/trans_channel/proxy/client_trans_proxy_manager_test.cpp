@@ -156,6 +156,24 @@ static IClientSessionCallBack g_sessionCb = {
     .OnDataReceived = OnBytesReceived,
 };
 
+int32_t OnBytesReceivedCloseChannel(int32_t channelId, int32_t channelType,
+    const void *data, uint32_t len, SessionPktType type)
+{
+    (void)channelType;
+    (void)data;
+    (void)len;
+    (void)type;
+    ClientTransProxyCloseChannel(channelId);
+    return SOFTBUS_OK;
+}
+
+static IClientSessionCallBack g_closeInCallbackSessionCb = {
+    .OnSessionOpened = TransOnSessionOpened,
+    .OnSessionClosed = TransOnSessionClosed,
+    .OnSessionOpenFailed = TransOnSessionOpenFailed,
+    .OnDataReceived = OnBytesReceivedCloseChannel,
+};
+
 class ClientTransProxyManagerTest : public testing::Test {
 public:
     ClientTransProxyManagerTest() {}
@@ -450,6 +468,41 @@ HWTEST_F(ClientTransProxyManagerTest, ClientTransProxyCloseChannelTest, TestSize
     ClientTransProxyCloseChannel(channelId);
 }
 
+/**
+ * @tc.name: ClientTransProxyCloseChannelInCallbackTest
+ * @tc.desc: the receive callback closes the channel while the last slice is delivered under the slice table lock.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ClientTransProxyManagerTest, ClientTransProxyCloseChannelInCallbackTest, TestSize.Level1)
+{
+    int32_t ret = ClientTransProxyInit(&g_closeInCallbackSessionCb);
+    EXPECT_EQ(SOFTBUS_OK, ret);
+    int32_t channelId = 1;
+    ChannelInfo channelInfo;
+    (void)memset_s(&channelInfo, sizeof(ChannelInfo), 0, sizeof(ChannelInfo));
+    channelInfo.channelId = channelId;
+    channelInfo.sessionKey = g_sessionKey;
+    channelInfo.isEncrypt = true;
+    ret = ClientTransProxyOnChannelOpened(g_proxySessionName, &channelInfo);
+    EXPECT_EQ(SOFTBUS_OK, ret);
+
+    // same locking as ClientTransProxySubPacketProc delivering an assembled message
+    ASSERT_EQ(SOFTBUS_OK, SoftBusMutexLock(&g_proxySliceTable.lock));
+    TransSliceEntry *entry = TransSliceTableGetEntry(&g_proxySliceTable, channelId, PROXY_CHANNEL_PRORITY_BYTES);
+    EXPECT_NE(nullptr, entry);
+    EXPECT_TRUE(IsValidCheckoutProcess(channelId));
+    ret = ClientTransProxyNotifySession(channelId, TRANS_SESSION_BYTES, 0, TEST_DATA, TEST_DATA_LENGTH);
+    EXPECT_EQ(SOFTBUS_OK, ret);
+    EXPECT_FALSE(IsValidCheckoutProcess(channelId));
+    (void)SoftBusMutexUnlock(&g_proxySliceTable.lock);
+
+    ProxyChannelInfoDetail info;
+    EXPECT_NE(SOFTBUS_OK, ClientTransProxyGetInfoByChannelId(channelId, &info));
+    ret = ClientTransProxyInit(&g_clientSessionCb);
+    EXPECT_EQ(SOFTBUS_OK, ret);
+}
+
 /**
  * @tc.name: TransProxyChannelSendFileTest
  * @tc.desc: trans proxy channel send file test, use the wrong parameter.
@@ -512,7 +565,47 @@ HWTEST_F(ClientTransProxyManagerTest, TransProxyPackAndSendDataTest, TestSize.Le
     EXPECT_EQ(SOFTBUS_INVALID_PARAM, ret);
     ret = ClientTransProxyPackAndSendData(channelId,
         static_cast<const void *>(data), len, &info, pktType);
-    EXPECT_EQ(SOFTBUS_TRANS_SESSION_INFO_NOT_FOUND, ret);
+    EXPECT_EQ(SOFTBUS_TRANS_PROXY_CHANNEL_NOT_FOUND, ret);
+}
+
+/**
+ * @tc.name: ClientTransProxyChannelSequenceTest
+ * @tc.desc: an encrypted channel hands out its send sequence from the cipher handle,
+ *           a plain channel gets no cipher
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ClientTransProxyManagerTest, ClientTransProxyChannelSequenceTest, TestSize.Level1)
+{
+    int32_t channelId = 1;
+    ChannelInfo channelInfo;
+    (void)memset_s(&channelInfo, sizeof(ChannelInfo), 0, sizeof(ChannelInfo));
+    channelInfo.channelId = channelId;
+    channelInfo.sessionKey = g_sessionKey;
+    channelInfo.isEncrypt = true;
+    int32_t ret = ClientTransProxyOnChannelOpened(g_proxySessionName, &channelInfo);
+    ASSERT_EQ(SOFTBUS_OK, ret);
+
+    TransCipherHandle *cipher = TransCipherTableAcquire(&g_proxyCipherTable, channelId);
+    ASSERT_NE(nullptr, cipher);
+    EXPECT_EQ(0, TransCipherHandleNextSeq(cipher));
+    ProxyChannelInfoDetail info;
+    (void)memset_s(&info, sizeof(ProxyChannelInfoDetail), 0, sizeof(ProxyChannelInfoDetail));
+    EXPECT_EQ(SOFTBUS_OK, ClientTransProxyGetInfoByChannelId(channelId, &info));
+    EXPECT_EQ(1, info.sequence);
+    EXPECT_EQ(2, TransCipherHandleNextSeq(cipher));
+    TransCipherHandleUnref(cipher);
+    ClientTransProxyCloseChannel(channelId);
+    EXPECT_EQ(nullptr, TransCipherTableAcquire(&g_proxyCipherTable, channelId));
+
+    channelInfo.isEncrypt = false;
+    channelInfo.sessionKey = nullptr;
+    ret = ClientTransProxyOnChannelOpened(g_proxySessionName, &channelInfo);
+    ASSERT_EQ(SOFTBUS_OK, ret);
+    EXPECT_EQ(nullptr, TransCipherTableAcquire(&g_proxyCipherTable, channelId));
+    EXPECT_EQ(SOFTBUS_OK, ClientTransProxyGetInfoByChannelId(channelId, &info));
+    EXPECT_EQ(0, info.isEncrypted);
+    ClientTransProxyCloseChannel(channelId);
 }
 
 /**
@@ -929,17 +1022,18 @@ HWTEST_F(ClientTransProxyManagerTest, TransProxyPackTlvBytes, TestSize.Level1)
 {
     int32_t channelId = 1;
     SessionPktType flag = TRANS_SESSION_ACK;
-    int32_t ret = ClientTransProxyPackTlvBytes(channelId, nullptr, nullptr, flag, TEST_SEQ);
+    int32_t ret = ClientTransProxyPackTlvBytes(channelId, nullptr, nullptr, 0, flag, TEST_SEQ);
     EXPECT_EQ(SOFTBUS_INVALID_PARAM, ret);
 
     ProxyDataInfo dataInfo;
-    ret = ClientTransProxyPackTlvBytes(channelId, &dataInfo, nullptr, flag, TEST_SEQ);
+    ret = ClientTransProxyPackTlvBytes(channelId, &dataInfo, nullptr, 0, flag, TEST_SEQ);
     EXPECT_EQ(SOFTBUS_INVALID_PARAM, ret);
 
-    ProxyChannelInfoDetail info;
-    (void)memset_s(&info, sizeof(ProxyChannelInfoDetail), 0, sizeof(ProxyChannelInfoDetail));
-    ret = ClientTransProxyPackTlvBytes(channelId, &dataInfo, &info, flag, TEST_SEQ);
+    TransCipherHandle *cipher = TransCipherHandleCreate(g_sessionKey, SESSION_KEY_LENGTH);
+    ASSERT_NE(nullptr, cipher);
+    ret = ClientTransProxyPackTlvBytes(channelId, &dataInfo, cipher, 0, flag, TEST_SEQ);
     EXPECT_EQ(SOFTBUS_TRANS_SESSION_INFO_NOT_FOUND, ret);
+    TransCipherHandleUnref(cipher);
 }
 
 /**
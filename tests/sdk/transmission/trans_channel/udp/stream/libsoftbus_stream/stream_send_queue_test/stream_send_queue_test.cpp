@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <condition_variable>
+#include <gtest/gtest.h>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "stream_common_data.h"
+#include "stream_send_queue.h"
+#include "trans_log.h"
+
+using namespace testing::ext;
+using namespace Communication;
+using namespace SoftBus;
+namespace OHOS {
+namespace {
+constexpr int64_t WAIT_TIMEOUT_MS = 5000;
+constexpr int32_t SMALL_FRAME_LEN = 16;
+constexpr int64_t SHORT_DEADLINE_MS = 20;
+constexpr uint32_t SMALL_CAPACITY = 4;
+// 60fps with a key frame every half second, about twice what the capped link carries
+constexpr int32_t GOP_FRAME_NUM = 30;
+constexpr int32_t CONGESTION_FRAME_NUM = 120;
+constexpr int64_t FRAME_INTERVAL_US = 16667;
+constexpr int32_t KEY_FRAME_LEN = 60 * 1024;
+constexpr int32_t DEPENDENT_FRAME_LEN = 12 * 1024;
+constexpr int64_t LINK_BYTES_PER_SEC = 400 * 1024;
+
+std::unique_ptr<IStream> MakeFrame(uint32_t seq, FrameType frameType, uint32_t level = 0,
+    int32_t len = SMALL_FRAME_LEN)
+{
+    StreamData data = { std::make_unique<char[]>(len), len, nullptr, 0 };
+    StreamFrameInfo info;
+    info.seqNum = seq;
+    info.level = level;
+    info.frameType = frameType;
+    return IStream::MakeCommonStream(data, info);
+}
+
+// a transport whose sends block while the gate is closed, or take as long as a capped link needs
+class FrameSink {
+public:
+    using Clock = StreamSendQueue::Clock;
+
+    explicit FrameSink(bool isOpen, int64_t bytesPerSec = 0) : isOpen_(isOpen), bytesPerSec_(bytesPerSec) {}
+
+    bool Send(std::unique_ptr<IStream> stream)
+    {
+        auto begin = Clock::now();
+        std::unique_lock<std::mutex> lock(lock_);
+        inFlight_++;
+        cv_.notify_all();
+        cv_.wait(lock, [this]() { return isOpen_; });
+        lock.unlock();
+        if (bytesPerSec_ > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(stream->GetBufferLen() * 1000000 / bytesPerSec_));
+        }
+        lock.lock();
+        sent_.push_back(*stream->GetStreamFrameInfo());
+        started_.push_back(begin);
+        return true;
+    }
+
+    void WaitInFlight(int32_t num)
+    {
+        std::unique_lock<std::mutex> lock(lock_);
+        cv_.wait(lock, [this, num]() { return inFlight_ >= num; });
+    }
+
+    void Open()
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        isOpen_ = true;
+        cv_.notify_all();
+    }
+
+    std::vector<uint32_t> SentSeq()
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        std::vector<uint32_t> seq;
+        for (const auto &info : sent_) {
+            seq.push_back(info.seqNum);
+        }
+        return seq;
+    }
+
+    std::vector<StreamFrameInfo> sent_;
+    std::vector<Clock::time_point> started_;
+
+private:
+    bool isOpen_;
+    int64_t bytesPerSec_;
+    int32_t inFlight_ = 0;
+    std::mutex lock_;
+    std::condition_variable cv_;
+};
+
+StreamSendQueue::SendFunc SendTo(FrameSink &sink)
+{
+    return [&sink](std::unique_ptr<IStream> stream) { return sink.Send(std::move(stream)); };
+}
+
+// a dependent frame is only decodable when every frame since the last key frame went out before it
+int32_t CountUndecodable(const std::vector<StreamFrameInfo> &sent)
+{
+    int32_t undecodable = 0;
+    bool hasKey = false;
+    uint32_t lastSeq = 0;
+    for (const auto &info : sent) {
+        if (info.frameType == VIDEO_I) {
+            hasKey = true;
+        } else if (!hasKey || info.seqNum != lastSeq + 1) {
+            undecodable++;
+            hasKey = false;
+        }
+        lastSeq = info.seqNum;
+    }
+    return undecodable;
+}
+} // namespace
+
+class StreamSendQueueTest : public testing::Test {
+public:
+    StreamSendQueueTest() { }
+    ~StreamSendQueueTest() { }
+    static void SetUpTestCase(void) { }
+    static void TearDownTestCase(void) { }
+    void SetUp() override { }
+    void TearDown() override { }
+};
+
+/**
+ * @tc.name: SendQueueKeyFrame001
+ * @tc.desc: a key frame supersedes the dependent frames still queued before it
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StreamSendQueueTest, SendQueueKeyFrame001, TestSize.Level1)
+{
+    FrameSink sink(false);
+    StreamSendQueue queue(SendTo(sink));
+    ASSERT_TRUE(queue.Push(MakeFrame(0, VIDEO_I)));
+    sink.WaitInFlight(1);
+    EXPECT_TRUE(queue.Push(MakeFrame(1, VIDEO_P)));
+    EXPECT_TRUE(queue.Push(MakeFrame(2, VIDEO_P)));
+    EXPECT_TRUE(queue.Push(MakeFrame(3, VIDEO_I)));
+    EXPECT_TRUE(queue.Push(MakeFrame(4, VIDEO_P)));
+    sink.Open();
+    ASSERT_TRUE(queue.WaitIdle(WAIT_TIMEOUT_MS));
+
+    EXPECT_EQ(sink.SentSeq(), std::vector<uint32_t>({ 0, 3, 4 }));
+    EXPECT_EQ(queue.GetStats().supersededNum, 2U);
+    EXPECT_EQ(CountUndecodable(sink.sent_), 0);
+    EXPECT_FALSE(queue.Push(nullptr));
+}
+
+/**
+ * @tc.name: SendQueueOverflow001
+ * @tc.desc: a full queue drops the newest frame of the highest level, and refuses frames referencing
+ *           it until the next key frame
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StreamSendQueueTest, SendQueueOverflow001, TestSize.Level1)
+{
+    FrameSink sink(false);
+    StreamSendQueue queue(SendTo(sink), SMALL_CAPACITY);
+    ASSERT_TRUE(queue.Push(MakeFrame(0, VIDEO_I)));
+    sink.WaitInFlight(1);
+    EXPECT_TRUE(queue.Push(MakeFrame(1, VIDEO_P, 0)));
+    EXPECT_TRUE(queue.Push(MakeFrame(2, VIDEO_P, 1)));
+    EXPECT_TRUE(queue.Push(MakeFrame(3, VIDEO_P, 0)));
+    EXPECT_TRUE(queue.Push(MakeFrame(4, VIDEO_P, 1)));
+    EXPECT_FALSE(queue.Push(MakeFrame(5, VIDEO_P, 1)));
+    EXPECT_TRUE(queue.Push(MakeFrame(6, VIDEO_P, 0)));
+    EXPECT_FALSE(queue.Push(MakeFrame(7, VIDEO_P, 1)));
+    sink.Open();
+    ASSERT_TRUE(queue.WaitIdle(WAIT_TIMEOUT_MS));
+    EXPECT_EQ(sink.SentSeq(), std::vector<uint32_t>({ 0, 1, 2, 3, 6 }));
+
+    EXPECT_TRUE(queue.Push(MakeFrame(8, VIDEO_I)));
+    EXPECT_TRUE(queue.Push(MakeFrame(9, VIDEO_P, 1)));
+    ASSERT_TRUE(queue.WaitIdle(WAIT_TIMEOUT_MS));
+    EXPECT_EQ(sink.SentSeq(), std::vector<uint32_t>({ 0, 1, 2, 3, 6, 8, 9 }));
+    StreamSendQueueStats stats = queue.GetStats();
+    EXPECT_EQ(stats.overflowNum, 2U);
+    EXPECT_EQ(stats.brokenNum, 1U);
+    EXPECT_EQ(stats.sentNum, 7U);
+}
+
+/**
+ * @tc.name: SendQueueDeadline001
+ * @tc.desc: frames past their deadline are dropped along with the dependent frames behind them,
+ *           independent audio frames are not held back by a broken video chain
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(StreamSendQueueTest, SendQueueDeadline001, TestSize.Level1)
+{
+    FrameSink sink(false);
+    StreamSendQueue queue(SendTo(sink), StreamSendQueue::DEFAULT_CAPACITY, SHORT_DEADLINE_MS);
+    ASSERT_TRUE(queue.Push(MakeFrame(0, VIDEO_I)));
+    sink.WaitInFlight(1);
+    EXPECT_TRUE(queue.Push(MakeFrame(1, VIDEO_P)));
+    EXPECT_TRUE(queue.Push(MakeFrame(2, VIDEO_P)));
+    EXPECT_TRUE(queue.Push(MakeFrame(3, RADIO)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(SHORT_DEADLINE_MS * 2));
+    sink.Open();
+    ASSERT_TRUE(queue.WaitIdle(WAIT_TIMEOUT_MS));
+    EXPECT_EQ(sink.SentSeq(), std::vector<uint32_t>({ 0 }));
+
+    EXPECT_FALSE(queue.Push(MakeFrame(4, VIDEO_P)));
+    EXPECT_TRUE(queue.Push(MakeFrame(5, RADIO)));
+    ASSERT_TRUE(queue.WaitIdle(WAIT_TIMEOUT_MS));
+    EXPECT_EQ(sink.SentSeq(), std::vector<uint32_t>({ 0, 5 }));
+    StreamSendQueueStats stats = queue.GetStats();
+    EXPECT_EQ(stats.expiredNum, 2U);
+    EXPECT_EQ(stats.brokenNum, 2U);
+
+    queue.Stop();
+    EXPECT_FALSE(queue.Push(MakeFrame(6, VIDEO_I)));
+}
+
+/**
+ * @tc.name: SendQueueCongestion001
+ * @tc.desc: a 60fps stream over a link carrying half its bitrate, frames go out in order, every
+ *           frame sent is decodable and every frame pushed is either sent or counted as dropped. The
+ *           waits against the latency a plain fifo would build up are only logged, they depend on the
+ *           scheduling of the test host
+ * @tc.type: PERF
+ * @tc.require:
+ */
+HWTEST_F(StreamSendQueueTest, SendQueueCongestion001, TestSize.Level1)
+{
+    FrameSink sink(true, LINK_BYTES_PER_SEC);
+    StreamSendQueue queue(SendTo(sink));
+    std::map<uint32_t, FrameSink::Clock::time_point> pushed;
+    auto begin = FrameSink::Clock::now();
+    for (int32_t seq = 0; seq < CONGESTION_FRAME_NUM; seq++) {
+        std::this_thread::sleep_until(begin + std::chrono::microseconds(seq * FRAME_INTERVAL_US));
+        bool isKey = seq % GOP_FRAME_NUM == 0;
+        pushed[seq] = FrameSink::Clock::now();
+        (void)queue.Push(MakeFrame(seq, isKey ? VIDEO_I : VIDEO_P, 0, isKey ? KEY_FRAME_LEN : DEPENDENT_FRAME_LEN));
+    }
+    ASSERT_TRUE(queue.WaitIdle(WAIT_TIMEOUT_MS));
+
+    int32_t keySent = 0;
+    std::vector<int64_t> waitMs;
+    for (size_t i = 0; i < sink.sent_.size(); i++) {
+        const StreamFrameInfo &info = sink.sent_[i];
+        keySent += (info.frameType == VIDEO_I) ? 1 : 0;
+        if (i > 0) {
+            EXPECT_GT(info.seqNum, sink.sent_[i - 1].seqNum);
+        }
+        waitMs.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(
+            sink.started_[i] - pushed[info.seqNum]).count());
+    }
+    EXPECT_EQ(CountUndecodable(sink.sent_), 0);
+    ASSERT_FALSE(waitMs.empty());
+    StreamSendQueueStats stats = queue.GetStats();
+    EXPECT_EQ(stats.sentNum, sink.sent_.size());
+    EXPECT_EQ(stats.failedNum, 0U);
+    EXPECT_EQ(stats.sentNum + stats.supersededNum + stats.brokenNum + stats.expiredNum + stats.overflowNum,
+        static_cast<uint64_t>(CONGESTION_FRAME_NUM));
+
+    // the same frames through a fifo without dropping, the link time of every frame adds up
+    int64_t fifoFreeUs = 0;
+    int64_t fifoMaxWaitUs = 0;
+    for (int32_t seq = 0; seq < CONGESTION_FRAME_NUM; seq++) {
+        int64_t arrivalUs = seq * FRAME_INTERVAL_US;
+        int64_t len = (seq % GOP_FRAME_NUM == 0) ? KEY_FRAME_LEN : DEPENDENT_FRAME_LEN;
+        int64_t startUs = std::max(arrivalUs, fifoFreeUs);
+        fifoMaxWaitUs = std::max(fifoMaxWaitUs, startUs - arrivalUs);
+        fifoFreeUs = startUs + len * 1000000 / LINK_BYTES_PER_SEC;
+    }
+    std::sort(waitMs.begin(), waitMs.end());
+    TRANS_LOGI(TRANS_TEST, "sent=%{public}zu/%{public}d, keySent=%{public}d, p50WaitMs=%{public}lld, "
+        "p99WaitMs=%{public}lld, fifoMaxWaitMs=%{public}lld, superseded=%{public}llu, broken=%{public}llu, "
+        "expired=%{public}llu, overflow=%{public}llu", sink.sent_.size(), CONGESTION_FRAME_NUM, keySent,
+        static_cast<long long>(waitMs[waitMs.size() / 2]), static_cast<long long>(waitMs[waitMs.size() * 99 / 100]),
+        static_cast<long long>(fifoMaxWaitUs / 1000), static_cast<unsigned long long>(stats.supersededNum),
+        static_cast<unsigned long long>(stats.brokenNum), static_cast<unsigned long long>(stats.expiredNum),
+        static_cast<unsigned long long>(stats.overflowNum));
+}
+} // namespace OHOS
@@ -66,6 +66,11 @@ FILLP_INT FtSend(FILLP_INT fd, FILLP_CONST void *data, size_t size, FILLP_INT fl
     return GetSoftBusStreamTestInterface()->FtSend(fd, data, size, flag);
 }
 
+FILLP_INT FtRecv(FILLP_INT fd, void *mem, size_t len, FILLP_INT flag)
+{
+    return GetSoftBusStreamTestInterface()->FtRecv(fd, mem, len, flag);
+}
+
 FILLP_INT FtFillpStatsGet(IN FILLP_INT fd, OUT struct FillpStatisticsPcb *outStats)
 {
     return GetSoftBusStreamTestInterface()->FtFillpStatsGet(fd, outStats);
@@ -92,6 +97,11 @@ FILLP_INT FtListen(FILLP_INT fd, FILLP_INT backLog)
     return GetSoftBusStreamTestInterface()->FtListen(fd, backLog);
 }
 
+FILLP_INT FtShutDown(FILLP_INT fd, FILLP_INT how)
+{
+    return GetSoftBusStreamTestInterface()->FtShutDown(fd, how);
+}
+
 int32_t SoftBusGetTime(SoftBusSysTime *sysTime)
 {
     return GetSoftBusStreamTestInterface()->SoftBusGetTime(sysTime);
@@ -37,12 +37,14 @@ public:
     virtual FILLP_INT32 FtConfigGet(IN FILLP_UINT32 name, IO void *value, IN FILLP_CONST void *param) = 0;
     virtual FILLP_INT32 FtConfigSet(IN FILLP_UINT32 name, IN FILLP_CONST void *value, IN FILLP_CONST void *param) = 0;
     virtual FILLP_INT FtSend(FILLP_INT fd, FILLP_CONST void *data, size_t size, FILLP_INT flag) = 0;
+    virtual FILLP_INT FtRecv(FILLP_INT fd, void *mem, size_t len, FILLP_INT flag) = 0;
     virtual FILLP_INT FtFillpStatsGet(IN FILLP_INT fd, OUT struct FillpStatisticsPcb *outStats) = 0;
     virtual FILLP_INT FtConnect(FILLP_INT fd, FILLP_CONST FILLP_SOCKADDR *name, socklen_t nameLen) = 0;
     virtual FILLP_INT FtEpollCreate(void) = 0;
     virtual FILLP_INT FtSendFrame(FILLP_INT fd, FILLP_CONST void *data, size_t size, FILLP_INT flag,
         FILLP_CONST struct FrameInfo *frame) = 0;
     virtual FILLP_INT FtListen(FILLP_INT fd, FILLP_INT backLog) = 0;
+    virtual FILLP_INT FtShutDown(FILLP_INT fd, FILLP_INT how) = 0;
     virtual int32_t SoftBusGetTime(SoftBusSysTime *sysTime) = 0;
     virtual bool Connect(const Communication::SoftBus::IpAndPort &remote) = 0;
     virtual std::unique_ptr<char[]> PacketizeStream() = 0;
@@ -65,6 +67,7 @@ public:
     MOCK_METHOD3(FtConfigSet, FILLP_INT32 (IN FILLP_UINT32 name, IN FILLP_CONST void *value,
         IN FILLP_CONST void *param));
     MOCK_METHOD4(FtSend, FILLP_INT (FILLP_INT fd, FILLP_CONST void *data, size_t size, FILLP_INT flag));
+    MOCK_METHOD4(FtRecv, FILLP_INT (FILLP_INT fd, void *mem, size_t len, FILLP_INT flag));
     MOCK_METHOD2(FtFillpStatsGet, FILLP_INT (IN FILLP_INT fd, OUT struct FillpStatisticsPcb *outStats));
     MOCK_METHOD3(FtConnect, FILLP_INT (FILLP_INT fd, FILLP_CONST FILLP_SOCKADDR *name, socklen_t nameLen));
     MOCK_METHOD0(FtEpollCreate, FILLP_INT (void));
@@ -73,6 +76,7 @@ public:
     MOCK_METHOD1(SoftBusGetTime, int32_t (SoftBusSysTime *sysTime));
     MOCK_METHOD1(Connect, bool (const Communication::SoftBus::IpAndPort &remote));
     MOCK_METHOD2(FtListen, FILLP_INT (FILLP_INT fd, FILLP_INT backLog));
+    MOCK_METHOD2(FtShutDown, FILLP_INT (FILLP_INT fd, FILLP_INT how));
     MOCK_METHOD0(PacketizeStream, std::unique_ptr<char[]> ());
     MOCK_METHOD0(GetPacketLen, ssize_t ());
     MOCK_METHOD1(SetSocketEpollMode, int (int fd));
@@ -12,8 +12,15 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <gtest/gtest.h>
 #include <securec.h>
+#include <set>
+#include <thread>
+#include <vector>
 
 #include "softbus_adapter_mem.h"
 #include "softbus_error_code.h"
@@ -60,6 +67,149 @@ Communication::SoftBus::StreamFrameInfo frameInfo = {
     .bitrate = 0,
 };
 
+#define LOOPBACK_FRAME_LEN (64 * 1024)
+#define LOOPBACK_FRAME_NUM 200
+#define LOOPBACK_WAIT_MS 5000
+
+static std::unique_ptr<IStream> MakeLoopbackFrame(int32_t seq)
+{
+    Communication::SoftBus::StreamData data = {
+        .buffer = std::make_unique<char[]>(LOOPBACK_FRAME_LEN),
+        .bufLen = LOOPBACK_FRAME_LEN,
+        .extBuffer = nullptr,
+        .extLen = 0,
+    };
+    for (int32_t i = 0; i < LOOPBACK_FRAME_LEN; i++) {
+        data.buffer[i] = static_cast<char>(i + seq);
+    }
+    Communication::SoftBus::StreamFrameInfo info = frameInfo;
+    info.seqNum = seq;
+    return IStream::MakeCommonStream(data, info);
+}
+
+static std::shared_ptr<Communication::SoftBus::VtpStreamSocket> MakeLoopbackSocket()
+{
+    auto vtpStreamSocket = std::make_shared<Communication::SoftBus::VtpStreamSocket>();
+    vtpStreamSocket->isBlocked_ = true;
+    vtpStreamSocket->streamType_ = Communication::SoftBus::COMMON_VIDEO_STREAM;
+    vtpStreamSocket->sessionKey_.first = new uint8_t[SESSION_KEY_LENGTH];
+    vtpStreamSocket->sessionKey_.second = SESSION_KEY_LENGTH;
+    for (uint32_t i = 0; i < SESSION_KEY_LENGTH; i++) {
+        vtpStreamSocket->sessionKey_.first[i] = static_cast<uint8_t>(i);
+    }
+    return vtpStreamSocket;
+}
+
+class LoopbackListener : public IStreamSocketListener {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit LoopbackListener(int32_t frameNum) : arrival_(frameNum), delivery_(frameNum) {}
+    ~LoopbackListener() override = default;
+
+    void OnStreamReceived(std::unique_ptr<IStream> stream) override
+    {
+        auto now = Clock::now();
+        int32_t seq = stream->GetSeqNum();
+        auto buffer = stream->GetBuffer();
+        bool isIntact = stream->GetBufferLen() == LOOPBACK_FRAME_LEN;
+        for (int32_t i = 0; isIntact && i < LOOPBACK_FRAME_LEN; i++) {
+            isIntact = buffer[i] == static_cast<char>(i + seq);
+        }
+        std::lock_guard<std::mutex> lock(lock_);
+        if (!isIntact || seq != received_ || seq >= static_cast<int32_t>(delivery_.size())) {
+            broken_++;
+        } else {
+            delivery_[seq] = now;
+        }
+        received_++;
+        cv_.notify_all();
+    }
+    void OnStreamStatus(int status) override {}
+    int OnStreamHdrReceived(std::unique_ptr<char[]> header, int size) override
+    {
+        return 0;
+    }
+    void OnQosEvent(int32_t eventId, int32_t tvCount, const QosTv *tvList) const override {}
+    void OnFrameStats(const StreamSendStats *data) override {}
+    void OnRippleStats(const TrafficStats *data) override {}
+
+    void WaitFor(int32_t frameNum)
+    {
+        std::unique_lock<std::mutex> lock(lock_);
+        cv_.wait(lock, [this, frameNum]() { return received_ >= frameNum; });
+    }
+
+    std::vector<Clock::time_point> arrival_;
+    std::vector<Clock::time_point> delivery_;
+    int32_t received_ = 0;
+    int32_t broken_ = 0;
+    std::mutex lock_;
+    std::condition_variable cv_;
+};
+
+// frames as they come out of FtSendFrame, length header included
+static std::vector<std::vector<char>> MakeLoopbackWire(
+    std::shared_ptr<Communication::SoftBus::VtpStreamSocket> &vtpStreamSocket, int32_t frameNum)
+{
+    std::vector<std::vector<char>> wire;
+    SoftBusStreamTestInterfaceMock streamMock;
+    EXPECT_CALL(streamMock, FtSendFrame).WillRepeatedly(testing::Invoke(
+        [&wire](FILLP_INT fd, FILLP_CONST void *data, size_t size, FILLP_INT flag,
+            FILLP_CONST struct FrameInfo *frame) {
+            wire.emplace_back(static_cast<const char *>(data), static_cast<const char *>(data) + size);
+            return static_cast<FILLP_INT>(size);
+        }));
+    for (int32_t seq = 0; seq < frameNum; seq++) {
+        EXPECT_TRUE(vtpStreamSocket->Send(MakeLoopbackFrame(seq)));
+        EXPECT_TRUE(vtpStreamSocket->sendQueue_.WaitIdle(LOOPBACK_WAIT_MS));
+    }
+    return wire;
+}
+
+// runs DoStreamRecv with FtRecv reading the captured frames back, the receive thread exits once they run out
+static void RecvLoopbackWire(std::shared_ptr<Communication::SoftBus::VtpStreamSocket> &vtpStreamSocket,
+    const std::vector<std::vector<char>> &wire, LoopbackListener &listener, std::set<const void *> &recvBuffers)
+{
+    SoftBusStreamTestInterfaceMock streamMock;
+    FILLP_INT streamFd = vtpStreamSocket->streamFd_;
+    size_t seq = 0;
+    size_t offset = 0;
+    EXPECT_CALL(streamMock, FtEpollWait).WillRepeatedly(testing::Invoke(
+        [streamFd, &wire, &seq](FILLP_INT epFd, struct SpungeEpollEvent *events, FILLP_INT maxEvents,
+            FILLP_INT timeout) {
+            if (seq >= wire.size()) {
+                return -1;
+            }
+            events[0].data.fd = streamFd;
+            events[0].events = SPUNGE_EPOLLIN;
+            return 1;
+        }));
+    EXPECT_CALL(streamMock, FtRecv).WillRepeatedly(testing::Invoke(
+        [&wire, &seq, &offset, &listener, &recvBuffers](FILLP_INT fd, void *mem, size_t len, FILLP_INT flag) {
+            if (seq >= wire.size()) {
+                return 0;
+            }
+            if (offset == 0) {
+                listener.arrival_[seq] = LoopbackListener::Clock::now();
+            } else {
+                recvBuffers.insert(mem);
+            }
+            size_t copyLen = std::min(len, wire[seq].size() - offset);
+            if (memcpy_s(mem, len, wire[seq].data() + offset, copyLen) != EOK) {
+                return -1;
+            }
+            offset += copyLen;
+            if (offset == wire[seq].size()) {
+                seq++;
+                offset = 0;
+            }
+            return static_cast<FILLP_INT>(copyLen);
+        }));
+    vtpStreamSocket->DoStreamRecv();
+    EXPECT_EQ(wire.size(), seq);
+}
+
 class VtpStreamSocketTest : public testing::Test {
 public:
     VtpStreamSocketTest()
@@ -175,6 +325,7 @@ HWTEST_F(VtpStreamSocketTest, CreateServer001, TestSize.Level1)
     vtpStreamSocket->isDestroyed_ = true;
     vtpStreamSocket->DestroyStreamSocket();
 
+    testing::NiceMock<SoftBusStreamTestInterfaceMock> streamMock;
     vtpStreamSocket->isDestroyed_ = false;
     vtpStreamSocket->listenFd_ = 2;
     vtpStreamSocket->streamFd_ = 2;
@@ -1468,6 +1619,7 @@ HWTEST_F(VtpStreamSocketTest, RecvStream001, TestSize.Level1)
         std::make_shared<Communication::SoftBus::VtpStreamSocket>();
     int32_t dataLength = 1;
     SoftBusStreamTestInterfaceMock streamMock;
+    EXPECT_CALL(streamMock, FtRecv).WillRepeatedly(testing::Return(-1));
     std::unique_ptr<char[]> dataBuffer = vtpStreamSocket->RecvStream(dataLength);
     EXPECT_EQ(nullptr, dataBuffer);
 }
@@ -1501,4 +1653,268 @@ HWTEST_F(VtpStreamSocketTest, CreateClientProcessThread001, TestSize.Level1)
     SoftBusStreamTestInterfaceMock streamMock;
     EXPECT_NO_FATAL_FAILURE(vtpStreamSocket->CreateClientProcessThread());
 }
+
+/**
+ * @tc.name: SendLoopback001
+ * @tc.desc: common stream frames sent from one reused buffer come back intact through the receive path
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(VtpStreamSocketTest, SendLoopback001, TestSize.Level1)
+{
+    auto vtpStreamSocket = MakeLoopbackSocket();
+    std::vector<char> sent;
+    std::set<const void *> sendBuffers;
+    SoftBusStreamTestInterfaceMock streamMock;
+    EXPECT_CALL(streamMock, FtSendFrame).WillRepeatedly(testing::Invoke(
+        [&sent, &sendBuffers](FILLP_INT fd, FILLP_CONST void *data, size_t size, FILLP_INT flag,
+            FILLP_CONST struct FrameInfo *frame) {
+            sendBuffers.insert(data);
+            sent.assign(static_cast<const char *>(data), static_cast<const char *>(data) + size);
+            return static_cast<FILLP_INT>(size);
+        }));
+
+    for (int32_t seq = 0; seq < LOOPBACK_FRAME_NUM / 10; seq++) {
+        ASSERT_TRUE(vtpStreamSocket->Send(MakeLoopbackFrame(seq)));
+        ASSERT_TRUE(vtpStreamSocket->sendQueue_.WaitIdle(LOOPBACK_WAIT_MS));
+        ASSERT_GT(sent.size(), static_cast<size_t>(FRAME_HEADER_LEN));
+        int32_t dataLength = static_cast<int32_t>(sent.size()) - FRAME_HEADER_LEN;
+        auto dataBuffer = std::make_unique<char[]>(dataLength);
+        ASSERT_EQ(EOK, memcpy_s(dataBuffer.get(), dataLength, sent.data() + FRAME_HEADER_LEN, dataLength));
+        std::unique_ptr<char[]> extBuffer = nullptr;
+        int32_t extLen = 0;
+        Communication::SoftBus::StreamFrameInfo info = {};
+        ASSERT_TRUE(vtpStreamSocket->ProcessCommonDataStream(dataBuffer, dataLength, extBuffer, extLen, info));
+        ASSERT_EQ(LOOPBACK_FRAME_LEN, dataLength);
+        EXPECT_EQ(seq, static_cast<int32_t>(info.seqNum));
+        for (int32_t i = 0; i < LOOPBACK_FRAME_LEN; i++) {
+            ASSERT_EQ(static_cast<char>(i + seq), dataBuffer[i]);
+        }
+    }
+    EXPECT_EQ(1U, sendBuffers.size());
+}
+
+/**
+ * @tc.name: SendQueueError001
+ * @tc.desc: a frame the send queue fails to hand to FillP is reported by the next Send, which still
+ *           queues its own frame, and a broken connection refuses the frames after it
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(VtpStreamSocketTest, SendQueueError001, TestSize.Level1)
+{
+    auto vtpStreamSocket = MakeLoopbackSocket();
+    SoftBusStreamTestInterfaceMock streamMock;
+    std::atomic<int32_t> sendNum { 0 };
+    EXPECT_CALL(streamMock, FtSendFrame).WillRepeatedly(testing::Invoke([&sendNum](FILLP_INT fd,
+        FILLP_CONST void *data, size_t size, FILLP_INT flag, FILLP_CONST struct FrameInfo *frame) {
+        int32_t num = ++sendNum;
+        if (num == 1 || num == 3) {
+            errno = (num == 1) ? FILLP_ENOBUFS : FILLP_ECONNRESET;
+            return -1;
+        }
+        return static_cast<FILLP_INT>(size);
+    }));
+
+    EXPECT_TRUE(vtpStreamSocket->Send(MakeLoopbackFrame(0)));
+    ASSERT_TRUE(vtpStreamSocket->sendQueue_.WaitIdle(LOOPBACK_WAIT_MS));
+    EXPECT_TRUE(vtpStreamSocket->Send(MakeLoopbackFrame(1)));
+    ASSERT_TRUE(vtpStreamSocket->sendQueue_.WaitIdle(LOOPBACK_WAIT_MS));
+    EXPECT_EQ(sendNum.load(), 2);
+    EXPECT_TRUE(vtpStreamSocket->Send(MakeLoopbackFrame(2)));
+    ASSERT_TRUE(vtpStreamSocket->sendQueue_.WaitIdle(LOOPBACK_WAIT_MS));
+    EXPECT_FALSE(vtpStreamSocket->Send(MakeLoopbackFrame(3)));
+    ASSERT_TRUE(vtpStreamSocket->sendQueue_.WaitIdle(LOOPBACK_WAIT_MS));
+    EXPECT_EQ(sendNum.load(), 3);
+}
+
+/**
+ * @tc.name: DestroyBlockedSend001
+ * @tc.desc: destroying the socket while the send queue is blocked in FillP shuts the fd down to wake the
+ *           send instead of waiting for it
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(VtpStreamSocketTest, DestroyBlockedSend001, TestSize.Level1)
+{
+    auto vtpStreamSocket = MakeLoopbackSocket();
+    vtpStreamSocket->streamFd_ = 1;
+    SoftBusStreamTestInterfaceMock streamMock;
+    std::mutex lock;
+    std::condition_variable cv;
+    bool isInFlight = false;
+    bool isShutDown = false;
+    bool isWokenByShutDown = false;
+    EXPECT_CALL(streamMock, FtSendFrame).WillOnce(testing::Invoke([&](FILLP_INT fd, FILLP_CONST void *data,
+        size_t size, FILLP_INT flag, FILLP_CONST struct FrameInfo *frame) {
+        std::unique_lock<std::mutex> guard(lock);
+        isInFlight = true;
+        cv.notify_all();
+        isWokenByShutDown = cv.wait_for(guard, std::chrono::milliseconds(LOOPBACK_WAIT_MS),
+            [&isShutDown]() { return isShutDown; });
+        errno = FILLP_ENOTCONN;
+        return -1;
+    }));
+    EXPECT_CALL(streamMock, FtShutDown).WillOnce(testing::Invoke([&](FILLP_INT fd, FILLP_INT how) {
+        std::lock_guard<std::mutex> guard(lock);
+        isShutDown = true;
+        cv.notify_all();
+        return 0;
+    }));
+
+    EXPECT_TRUE(vtpStreamSocket->Send(MakeLoopbackFrame(0)));
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        ASSERT_TRUE(cv.wait_for(guard, std::chrono::milliseconds(LOOPBACK_WAIT_MS), [&isInFlight]() {
+            return isInFlight;
+        }));
+    }
+    vtpStreamSocket->DestroyStreamSocket();
+    EXPECT_TRUE(isWokenByShutDown);
+    EXPECT_TRUE(vtpStreamSocket->isDestroyed_);
+}
+
+/**
+ * @tc.name: SendLoopback002
+ * @tc.desc: frames per second and send buffer allocations per frame of the in place send path,
+ *           against packetizing and encrypting into two buffers of their own
+ * @tc.type: PERF
+ * @tc.require:
+ */
+HWTEST_F(VtpStreamSocketTest, SendLoopback002, TestSize.Level1)
+{
+    auto vtpStreamSocket = MakeLoopbackSocket();
+    std::set<const void *> sendBuffers;
+    SoftBusStreamTestInterfaceMock streamMock;
+    EXPECT_CALL(streamMock, FtSendFrame).WillRepeatedly(testing::Invoke(
+        [&sendBuffers](FILLP_INT fd, FILLP_CONST void *data, size_t size, FILLP_INT flag,
+            FILLP_CONST struct FrameInfo *frame) {
+            sendBuffers.insert(data);
+            return static_cast<FILLP_INT>(size);
+        }));
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int32_t seq = 0; seq < LOOPBACK_FRAME_NUM; seq++) {
+        ASSERT_TRUE(vtpStreamSocket->SendCommonFrame(MakeLoopbackFrame(seq)));
+    }
+    auto inPlaceCost = std::chrono::steady_clock::now() - begin;
+
+    begin = std::chrono::steady_clock::now();
+    for (int32_t seq = 0; seq < LOOPBACK_FRAME_NUM; seq++) {
+        StreamPacketizer packet(vtpStreamSocket->streamType_, MakeLoopbackFrame(seq));
+        auto plainData = packet.PacketizeStream();
+        ASSERT_TRUE(plainData != nullptr);
+        ssize_t len = packet.GetPacketLen() + vtpStreamSocket->GetEncryptOverhead();
+        auto data = std::make_unique<char[]>(len + FRAME_HEADER_LEN);
+        ASSERT_EQ(len, vtpStreamSocket->Encrypt(plainData.get(), packet.GetPacketLen(), data.get() + FRAME_HEADER_LEN,
+            len));
+    }
+    auto twoBufferCost = std::chrono::steady_clock::now() - begin;
+
+    double usPerSec = 1000000.0;
+    auto inPlaceUs = std::chrono::duration_cast<std::chrono::microseconds>(inPlaceCost).count() + 1;
+    auto twoBufferUs = std::chrono::duration_cast<std::chrono::microseconds>(twoBufferCost).count() + 1;
+    TRANS_LOGI(TRANS_TEST, "frameLen=%{public}d, inPlaceFps=%{public}.1f, twoBufferFps=%{public}.1f, "
+        "sendBufAllocsPerFrame=%{public}.3f, twoBufferAllocsPerFrame=2",
+        LOOPBACK_FRAME_LEN, LOOPBACK_FRAME_NUM * usPerSec / inPlaceUs, LOOPBACK_FRAME_NUM * usPerSec / twoBufferUs,
+        static_cast<double>(sendBuffers.size()) / LOOPBACK_FRAME_NUM);
+    EXPECT_EQ(1U, sendBuffers.size());
+}
+
+/**
+ * @tc.name: RecvLoopback001
+ * @tc.desc: common stream frames decrypted in one reused receive buffer reach the listener intact and in order
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(VtpStreamSocketTest, RecvLoopback001, TestSize.Level1)
+{
+    auto vtpStreamSocket = MakeLoopbackSocket();
+    int32_t frameNum = LOOPBACK_FRAME_NUM / 10;
+    auto wire = MakeLoopbackWire(vtpStreamSocket, frameNum);
+    ASSERT_EQ(static_cast<size_t>(frameNum), wire.size());
+    auto listener = std::make_shared<LoopbackListener>(frameNum);
+    vtpStreamSocket->streamReceiver_ = listener;
+    vtpStreamSocket->isStreamRecv_ = true;
+
+    std::set<const void *> recvBuffers;
+    RecvLoopbackWire(vtpStreamSocket, wire, *listener, recvBuffers);
+    std::thread notifier([&vtpStreamSocket]() { vtpStreamSocket->NotifyStreamListener(); });
+    listener->WaitFor(frameNum);
+    vtpStreamSocket->QuitStreamBuffer();
+    notifier.join();
+
+    EXPECT_EQ(frameNum, listener->received_);
+    EXPECT_EQ(0, listener->broken_);
+    EXPECT_EQ(1U, recvBuffers.size());
+    EXPECT_EQ(0, vtpStreamSocket->GetStreamNum());
+}
+
+/**
+ * @tc.name: RecvLoopback002
+ * @tc.desc: end to end latency percentiles of frames from arrival in the receive buffer to the listener,
+ *           with the receive and listener threads running side by side
+ * @tc.type: PERF
+ * @tc.require:
+ */
+HWTEST_F(VtpStreamSocketTest, RecvLoopback002, TestSize.Level1)
+{
+    auto vtpStreamSocket = MakeLoopbackSocket();
+    auto wire = MakeLoopbackWire(vtpStreamSocket, LOOPBACK_FRAME_NUM);
+    ASSERT_EQ(static_cast<size_t>(LOOPBACK_FRAME_NUM), wire.size());
+    auto listener = std::make_shared<LoopbackListener>(LOOPBACK_FRAME_NUM);
+    vtpStreamSocket->streamReceiver_ = listener;
+    vtpStreamSocket->isStreamRecv_ = true;
+
+    std::set<const void *> recvBuffers;
+    std::thread notifier([&vtpStreamSocket]() { vtpStreamSocket->NotifyStreamListener(); });
+    auto begin = LoopbackListener::Clock::now();
+    RecvLoopbackWire(vtpStreamSocket, wire, *listener, recvBuffers);
+    listener->WaitFor(LOOPBACK_FRAME_NUM);
+    auto cost = LoopbackListener::Clock::now() - begin;
+    vtpStreamSocket->QuitStreamBuffer();
+    notifier.join();
+    ASSERT_EQ(0, listener->broken_);
+
+    std::vector<int64_t> latencyUs;
+    for (int32_t seq = 0; seq < LOOPBACK_FRAME_NUM; seq++) {
+        latencyUs.push_back(std::chrono::duration_cast<std::chrono::microseconds>(
+            listener->delivery_[seq] - listener->arrival_[seq]).count());
+    }
+    std::sort(latencyUs.begin(), latencyUs.end());
+    auto percentile = [&latencyUs](int32_t pct) {
+        return static_cast<long long>(latencyUs[(latencyUs.size() - 1) * pct / 100]);
+    };
+    double usPerSec = 1000000.0;
+    auto costUs = std::chrono::duration_cast<std::chrono::microseconds>(cost).count() + 1;
+    TRANS_LOGI(TRANS_TEST, "frameLen=%{public}d, fps=%{public}.1f, p50Us=%{public}lld, p90Us=%{public}lld, "
+        "p99Us=%{public}lld, maxUs=%{public}lld, recvBufAllocsPerFrame=%{public}.3f",
+        LOOPBACK_FRAME_LEN, LOOPBACK_FRAME_NUM * usPerSec / costUs, percentile(50), percentile(90), percentile(99),
+        percentile(100), static_cast<double>(recvBuffers.size()) / LOOPBACK_FRAME_NUM);
+    EXPECT_EQ(1U, recvBuffers.size());
+}
+
+/**
+ * @tc.name: GetFrameBuffer001
+ * @tc.desc: a frame buffer grown by one large frame shrinks back once a whole window of frames stays small
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(VtpStreamSocketTest, GetFrameBuffer001, TestSize.Level1)
+{
+    auto vtpStreamSocket = std::make_shared<Communication::SoftBus::VtpStreamSocket>();
+    ssize_t largeLen = FRAME_BUFFER_STEP * 16;
+    ssize_t smallLen = FRAME_BUFFER_STEP / 16;
+    EXPECT_NE(nullptr, vtpStreamSocket->GetRecvBuffer(largeLen));
+    for (uint32_t i = 1; i < FRAME_BUFFER_SHRINK_WINDOW; i++) {
+        EXPECT_NE(nullptr, vtpStreamSocket->GetRecvBuffer(smallLen));
+    }
+    EXPECT_EQ(largeLen, vtpStreamSocket->recvBuffer_.len);
+    for (uint32_t i = 0; i < FRAME_BUFFER_SHRINK_WINDOW; i++) {
+        EXPECT_NE(nullptr, vtpStreamSocket->GetRecvBuffer(smallLen));
+    }
+    EXPECT_EQ(FRAME_BUFFER_STEP, vtpStreamSocket->recvBuffer_.len);
+    EXPECT_NE(nullptr, vtpStreamSocket->GetRecvBuffer(largeLen));
+    EXPECT_EQ(largeLen, vtpStreamSocket->recvBuffer_.len);
+}
 } // OHOS